@@ -39,8 +39,6 @@
 #define DEBUG                       0
 #define TEST                        0
 
-#define TEMPFILE_NAME_TEMPLATE      "/tmp/configtoolsXXXXXX"
-
 #define MAX_ERROR_TEXT_LENGTH       200
 
 
@@ -198,6 +196,73 @@ int FileContent_GetLineByNr(char * szFileContent,
 
 
 
+static char *StreamContent_Get(FILE * fStream)
+//
+// Read a stream until its end into a new allocated, zero terminated buffer.
+//
+{
+  size_t  bufferSize      = 1024;
+  size_t  contentLength   = 0;
+  char*   szOutputBuffer  = (char*)malloc(bufferSize);
+
+  while(szOutputBuffer != NULL)
+  {
+    contentLength += fread(szOutputBuffer + contentLength, 1, bufferSize - contentLength - 1, fStream);
+    if(contentLength < (bufferSize - 1))
+    {
+      break;
+    }
+
+    // buffer is full, there may be more to read
+    char* szGrownBuffer = (char*)realloc(szOutputBuffer, bufferSize * 2);
+    if(szGrownBuffer == NULL)
+    {
+      free(szOutputBuffer);
+      szOutputBuffer = NULL;
+    }
+    else
+    {
+      szOutputBuffer = szGrownBuffer;
+      bufferSize    *= 2;
+    }
+  }
+
+  if(szOutputBuffer != NULL)
+  {
+    szOutputBuffer[contentLength] = '\0';
+  }
+
+  return(szOutputBuffer);
+}
+
+
+char *ProcFileContent_Get(char const * szFilename)
+//
+// Read a file whose size is not known in advance (e.g. /proc/cpuinfo always reports 0) to an allocated buffer.
+// The buffer has to be freed with FileContent_Destruct.
+//
+{
+  char* szOutputBuffer  = NULL;
+  FILE* fFile           = fopen(szFilename, "r");
+
+  if(fFile != NULL)
+  {
+    szOutputBuffer = StreamContent_Get(fFile);
+    fclose(fFile);
+  }
+
+  return(szOutputBuffer);
+}
+
+
+static tSystemCallHandler g_systemCallHandler = NULL;
+
+void SystemCall_SetHandler(tSystemCallHandler handler)
+{
+  g_systemCallHandler = handler;
+}
+
+
 char *SystemCall_GetOutput(char const * szSystemCallString)
 //
 // Make a system-call and return it's outputs to stdout in a new allocated buffer.
@@ -205,6 +270,10 @@ char *SystemCall_GetOutput(char const * szSystemCallString)
 // !!! It is absolutly necessairy to call the function DestructSystemCallOutput after handling
 // the outputs to free the allocated memory !!!
 //
+// A handler registered with SystemCall_SetHandler gets the chance to answer the call first
+// (used by the resident config tool server to run other config tools in-process).
+// Otherwise the output of the shell is read from a pipe, no temporary file is involved.
+//
 // Input:  string with the system-call
 // Return: pointer to the buffer with the systemcall-outputs to stdout
 //         NULL if an error occured
@@ -212,30 +281,27 @@ char *SystemCall_GetOutput(char const * szSystemCallString)
 {
   char* pOutputBuffer = NULL;
 
-  char  completeSystemCallString[MAX_LENGTH_SYSTEM_CALL]  = "";
-  char  filename[]                                        = TEMPFILE_NAME_TEMPLATE;
-
-  // use mkstemp to immediately create the temporary file to avoid name clashes with other processes
-  int hdl = mkstemp(filename);
-  // a name for tempfile was found -> do systemcall, redirect its outputs to tempfile
-  if (hdl > -1)
+  if(g_systemCallHandler != NULL)
   {
-    // Close the file again as we only need its name.
-    // The file itself will be kept to avoid subsequent calls from using the same name
-    close(hdl);
-
-    // add redirection from sytemcall-outputs to the commandline
-    snprintf(completeSystemCallString, MAX_LENGTH_SYSTEM_CALL, "%s > %s", szSystemCallString, filename);
-    system(completeSystemCallString);
+    bool handled = false;
+    pOutputBuffer = g_systemCallHandler(szSystemCallString, &handled);
+    if(handled)
+    {
+      return(pOutputBuffer);
+    }
+  }
 
-    #if DEBUG
-    printf("completeSystemCallString:%s\n", completeSystemCallString);
-    #endif
+  #if DEBUG
+  printf("szSystemCallString:%s\n", szSystemCallString);
+  #endif
 
-    // read the content of tempfile to an allocated buffer and afterwards delete it
-    pOutputBuffer = FileContent_Get(filename);
-    remove(filename);
+  FILE* fPipe = popen(szSystemCallString, "r");
+  if(fPipe != NULL)
+  {
+    pOutputBuffer = StreamContent_Get(fPipe);
+    (void)pclose(fPipe);
   }
+
   return(pOutputBuffer);
 }
 
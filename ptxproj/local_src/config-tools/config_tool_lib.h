@@ -36,6 +36,7 @@ extern "C" {
 //#define FALSE                            0
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 }
@@ -138,10 +139,20 @@ char *FileContent_Get(char const * szFilename);
 
 void  FileContent_Destruct(char * * pszOutputBuffer);
 
+// Read a file without a valid size (e.g. in /proc), free with FileContent_Destruct
+char *ProcFileContent_Get(char const * szFilename);
+
 int FileContent_GetLineByNr(char * szFileContent,
                             int    requestedLineNr,
                             char * szLineString);
 
+// Handler which may answer a system-call without spawning a shell. It sets *pHandled to true
+// if it took care of the call, the returned buffer (or NULL on error) is then the call output.
+typedef char *(*tSystemCallHandler)(char const * szSystemCallString, bool * pHandled);
+
+// Install a handler which is asked first by SystemCall_GetOutput, NULL removes it
+void SystemCall_SetHandler(tSystemCallHandler handler);
+
 // Make a system-call and return it's outputs to stdout in a new allocated buffer.
 char *SystemCall_GetOutput(char const * szSystemCallString);
 
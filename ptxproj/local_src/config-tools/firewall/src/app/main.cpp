@@ -29,11 +29,15 @@
 #include "process.hpp"
 #include "libxml/parser.h"
 #include "rule_file_editor.hpp"
+#include "rule_set.hpp"
 
 #include <syslog.h>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <cassert>
+#include <cstdio>
 #include <fstream>
+#include <functional>
 #include <sstream>
 
 
@@ -61,6 +65,11 @@ namespace {
   const std::string  FW_XST = "/usr/bin/xmlstarlet";
   const std::string  GENERAL_CONF = "/etc/firewall/firewall.conf";
   const std::string  FIREWALL_INIT = "/etc/init.d/firewall";
+  // Rule sets of the services and the general iptables rules as last applied, removed by ipfirewall.sh
+  // whenever the tables are restored completely.
+  const std::string  RUN_DIR = "/var/run/firewall";
+  const std::string  APPLIED_DIR = RUN_DIR + "/services";
+  const std::string  IP_RULES_APPLIED = RUN_DIR + "/ipcmn.rls";
 
   const FileAccessor file_accessor;
 //------------------------------------------------------------------------------
@@ -160,6 +169,10 @@ Usage: firewall -h|--help\n\
   --rem-host INDEX          remove an existing whitelist entry\n\
 \n\
  CONF: iptables:\n\
+  --apply-rules FILE        applies the general iptables rules of FILE, only the\n\
+                            chains changed since the last call are restored.\n\
+                            Used by ipfirewall.sh.\n\
+\n\
   --set-climits TOTAL|- LIMIT|- BURST|- TCP|- UDP|-\n\
                             sets limitations on incoming connections\n\
 \n\
@@ -314,8 +327,9 @@ void transform_xmldoc (const std::string& xmlshema,
 //------------------------------------------------------------------------------
 /// Processes applying of iptables rule.
 /// \param rule name of iptables rule to be applied
+/// \return true if iptables-restore succeeded
 //------------------------------------------------------------------------------
-void apply_rule (const std::string& rule)
+bool apply_rule (const std::string& rule)
 {
     if (file_accessor.check_file(rule) && file_accessor.check_file(FW_IPR))
     {
@@ -333,6 +347,7 @@ void apply_rule (const std::string& rule)
 #ifdef SHOW_ERRORS
         syslog(LOG_ERR, "Execute command: %s  status: %i", oss.str().c_str(), ret);
 #endif
+        return ret == 0;
     }
     else
     {
@@ -340,6 +355,122 @@ void apply_rule (const std::string& rule)
     }
 }
 
+//----
+//------------------------------------------------------------------------------
+/// Applies an iptables-restore transaction without flushing the tables.
+/// \param transaction rules to be applied, all tables are committed at once
+/// \param file temporary input file of iptables-restore
+/// \return true if iptables-restore succeeded
+//------------------------------------------------------------------------------
+bool apply_transaction (const std::string& transaction, const std::string& file)
+{
+    {
+        std::ofstream out(file, std::ofstream::trunc);
+        out << transaction;
+        out.close();
+        if (out.fail())
+        {
+            throw file_write_error(file);
+        }
+    }
+
+    int ret = 0;
+    (void)exe_cmd(FW_IPR + " --wait -n >/dev/null 2>&1 < " + file, ret);
+#ifdef SHOW_ERRORS
+    syslog(LOG_ERR, "Apply transaction: %s  status: %i", transaction.c_str(), ret);
+#endif
+    (void)std::remove(file.c_str());
+    return ret == 0;
+}
+
+//----
+//------------------------------------------------------------------------------
+/// Applies a rule set incrementally, see apply_rule_set.
+/// \param target rule set to be applied
+/// \param applied_file rule set as applied last
+/// \param apply_completely applies the rule set without a known applied state
+/// \return true if the rule set was applied
+//------------------------------------------------------------------------------
+bool apply_incremental(const RuleSet& target,
+                       const std::string& applied_file,
+                       const std::function<bool()>& apply_completely)
+{
+    (void)mkdir(RUN_DIR.c_str(), 0755);
+    (void)mkdir(APPLIED_DIR.c_str(), 0755);
+
+    return apply_rule_set(target, applied_file,
+                          [&applied_file](const std::string& transaction) {
+                              return apply_transaction(transaction, applied_file + ".trn");
+                          },
+                          apply_completely);
+}
+
+//----
+//------------------------------------------------------------------------------
+/// Applies the rules of a service. Only the chains which differ from the
+/// last applied rule set are changed, in a single iptables-restore call.
+/// Otherwise the service rules are removed and applied completely, as the
+/// tables may contain them from an earlier call.
+/// \param conf name of the service
+/// \param updown (up|down) application or removal of the service rules
+//------------------------------------------------------------------------------
+void apply_service(const std::string& conf, const std::string& updown)
+{
+    const std::string xmldoc = "/etc/firewall/services/" + conf + ".xml";
+    const std::string up_rule = "/etc/firewall/services/"+ conf + "_up.rls";
+    const std::string applied_file = APPLIED_DIR + "/" + conf + ".rls";
+
+    RuleSet target;
+    if (updown == "up")
+    {
+        const std::string shema = "/etc/firewall/services/service_up.xsl";
+        transform_xmldoc (shema, xmldoc, up_rule);
+        target = RuleSet::load(up_rule);
+    }
+    else if (updown != "down")
+    {
+        throw invalid_param_error( "apply_conf failed:", updown.c_str());
+    }
+
+    (void)apply_incremental(target, applied_file, [&]() {
+        const std::string shema_down = "/etc/firewall/services/service_down.xsl";
+        const std::string rule_down = "/etc/firewall/services/" + conf + "_down.rls";
+        transform_xmldoc (shema_down, xmldoc, rule_down);
+
+        // removal fails if the service rules are not applied
+        (void)apply_rule (rule_down);
+        return updown == "down" || apply_rule (up_rule);
+    });
+}
+
+//----
+//------------------------------------------------------------------------------
+/// Applies the general iptables rules (ipcmn.rls) generated by ipfirewall.sh,
+/// i.e. the user filter, connection limits, echo and IPsec rules. The file
+/// flushes all chains it fills, so it can always be applied completely.
+/// \param rule name of the rule file
+//------------------------------------------------------------------------------
+void apply_ip_rules(const std::string& rule)
+{
+    bool applied = false;
+    try
+    {
+        applied = apply_incremental(RuleSet::load(rule), IP_RULES_APPLIED,
+                                    [&rule]() { return apply_rule (rule); });
+    }
+    catch (const invalid_param_error&)
+    {
+        // not supported by the model, no incremental application
+        (void)std::remove(IP_RULES_APPLIED.c_str());
+        applied = apply_rule (rule);
+    }
+
+    if (!applied)
+    {
+        throw unknown_error("apply_ip_rules: iptables-restore failed");
+    }
+}
+
 //----
 //------------------------------------------------------------------------------
 /// Processes configuration change request.
@@ -391,29 +522,7 @@ void apply_conf(const std::string& conf, const std::string& updown)
     else
     {
         // process services
-        const std::string shema_down = "/etc/firewall/services/service_down.xsl";
-        const std::string xmldoc_down = "/etc/firewall/services/" + conf + ".xml";
-        const std::string rule_down = "/etc/firewall/services/" + conf + "_down.rls";
-        transform_xmldoc (shema_down, xmldoc_down, rule_down);
-
-        if (updown == "up")
-        {
-            const std::string shema = "/etc/firewall/services/service_up.xsl";
-            const std::string xmldoc = "/etc/firewall/services/" + conf +".xml";
-            const std::string up_rule = "/etc/firewall/services/"+ conf + "_up.rls";
-            transform_xmldoc (shema, xmldoc, up_rule);
-
-            apply_rule (rule_down);
-            apply_rule (up_rule);
-        }
-        else if (updown == "down")
-        {
-            apply_rule (rule_down);
-        }
-        else
-        {
-            throw invalid_param_error( "apply_conf failed:", updown.c_str());
-        }
+        apply_service(conf, updown);
     }
 }
 
@@ -598,6 +707,13 @@ void execute(int argc, char** argv)
 
             file_accessor.print_file_ng(file_accessor.get_config_fname(conf));
         }
+        else if ("--apply-rules" == cmd && "iptables" == conf)
+        {
+            if (4 != argc)
+                throw invalid_param_error("Invalid number of arguments.");
+
+            apply_ip_rules(argv[3]);
+        }
         else if ("--apply" == cmd)
         {
             if (4 < argc)
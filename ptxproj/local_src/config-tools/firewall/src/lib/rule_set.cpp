@@ -0,0 +1,327 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use, and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+/// \file rule_set.cpp
+///
+/// \brief In-memory model of an iptables-restore rule file, used to apply
+///        only the chains which changed since the last application.
+///
+/// \author WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+#include "rule_set.hpp"
+#include "error.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace wago {
+namespace firewall {
+
+namespace {
+
+::std::string trim(const ::std::string& line) {
+  auto const first = line.find_first_not_of(" \t\r");
+  if (first == ::std::string::npos) {
+    return ::std::string();
+  }
+  auto const last = line.find_last_not_of(" \t\r");
+  return line.substr(first, last - first + 1);
+}
+
+// Splits "-X chain rest" into chain name and rest.
+void split_command(const ::std::string& line, ::std::string& chain, ::std::string& spec) {
+  auto const chain_start = line.find_first_not_of(' ', 2);
+  if (chain_start == ::std::string::npos) {
+    throw invalid_param_error("missing chain: " + line);
+  }
+  auto const chain_end = line.find(' ', chain_start);
+  chain = line.substr(chain_start, chain_end - chain_start);
+  spec = (chain_end == ::std::string::npos) ? ::std::string() : trim(line.substr(chain_end));
+}
+
+bool contains(const ::std::vector<::std::string>& rules, const ::std::string& rule) {
+  return ::std::find(rules.begin(), rules.end(), rule) != rules.end();
+}
+
+} // anonymous namespace
+
+
+RuleSet::Chain& RuleSet::Table::chain(const ::std::string& chain_name) {
+  auto it = ::std::find_if(chains.begin(), chains.end(), [&chain_name](auto const& c) {
+    return c.name == chain_name;
+  });
+  if (it != chains.end()) {
+    return *it;
+  }
+  chains.emplace_back();
+  chains.back().name = chain_name;
+  return chains.back();
+}
+
+const RuleSet::Chain* RuleSet::Table::find(const ::std::string& chain_name) const {
+  auto it = ::std::find_if(chains.begin(), chains.end(), [&chain_name](auto const& c) {
+    return c.name == chain_name;
+  });
+  return (it != chains.end()) ? &(*it) : nullptr;
+}
+
+RuleSet::Table& RuleSet::table(const ::std::string& table_name) {
+  auto it = ::std::find_if(tables_.begin(), tables_.end(), [&table_name](auto const& t) {
+    return t.name == table_name;
+  });
+  if (it != tables_.end()) {
+    return *it;
+  }
+  tables_.emplace_back();
+  tables_.back().name = table_name;
+  return tables_.back();
+}
+
+const RuleSet::Table* RuleSet::find(const ::std::string& table_name) const {
+  auto it = ::std::find_if(tables_.begin(), tables_.end(), [&table_name](auto const& t) {
+    return t.name == table_name;
+  });
+  return (it != tables_.end()) ? &(*it) : nullptr;
+}
+
+RuleSet RuleSet::parse(const ::std::string& rules) {
+  RuleSet rule_set;
+  Table* current = nullptr;
+
+  ::std::istringstream stream(rules);
+  ::std::string line;
+  while (::std::getline(stream, line)) {
+    line = trim(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    if (line[0] == '*') {
+      current = &rule_set.table(line.substr(1));
+      continue;
+    }
+    if (nullptr == current) {
+      throw invalid_param_error("rule outside of a table: " + line);
+    }
+
+    if (line == "COMMIT") {
+      current = nullptr;
+    } else if (line[0] == ':') {
+      auto const name_end = line.find(' ');
+      Chain& chain = current->chain(line.substr(1, name_end - 1));
+      chain.declaration = line;
+    } else if (line.compare(0, 3, "-F ") == 0 || line.compare(0, 3, "-A ") == 0) {
+      ::std::string chain_name;
+      ::std::string spec;
+      split_command(line, chain_name, spec);
+      Chain& chain = current->chain(chain_name);
+      if (line[1] == 'F') {
+        chain.flushed = true;
+      } else if (!contains(chain.rules, spec)) {
+        chain.rules.push_back(spec);
+      }
+    } else {
+      throw invalid_param_error("unsupported rule: " + line);
+    }
+  }
+
+  return rule_set;
+}
+
+RuleSet RuleSet::load(const ::std::string& file_path) {
+  ::std::ifstream stream(file_path);
+  if (!stream.good()) {
+    throw file_open_error(file_path);
+  }
+  ::std::stringstream data;
+  data << stream.rdbuf();
+  return parse(data.str());
+}
+
+void RuleSet::store(const ::std::string& file_path) const {
+  auto const file_path_tmp = file_path + ".tmp";
+  ::std::ofstream stream(file_path_tmp, ::std::ios::trunc);
+  if (!stream.good()) {
+    throw file_write_error(file_path);
+  }
+
+  stream << to_string();
+  stream.close();
+  if (stream.fail() || 0 != ::std::rename(file_path_tmp.c_str(), file_path.c_str())) {
+    ::std::remove(file_path_tmp.c_str());
+    throw file_write_error(file_path);
+  }
+}
+
+::std::string RuleSet::to_string() const {
+  ::std::ostringstream out;
+
+  for (auto const& table : tables_) {
+    out << "*" << table.name << "\n";
+    for (auto const& chain : table.chains) {
+      if (!chain.declaration.empty()) {
+        out << chain.declaration << "\n";
+      }
+    }
+    for (auto const& chain : table.chains) {
+      if (chain.flushed && chain.declaration.empty()) {
+        out << "-F " << chain.name << "\n";
+      }
+    }
+    for (auto const& chain : table.chains) {
+      for (auto const& rule : chain.rules) {
+        out << "-A " << chain.name << " " << rule << "\n";
+      }
+    }
+    out << "COMMIT\n";
+  }
+
+  return out.str();
+}
+
+::std::string RuleSet::transaction(const RuleSet& target) const {
+  ::std::ostringstream out;
+
+  ::std::vector<::std::string> table_names;
+  for (auto const& table : target.tables_) {
+    table_names.push_back(table.name);
+  }
+  for (auto const& table : tables_) {
+    if (!contains(table_names, table.name)) {
+      table_names.push_back(table.name);
+    }
+  }
+
+  static const Table no_table;
+  for (auto const& table_name : table_names) {
+    const Table* applied = find(table_name);
+    const Table* wanted = target.find(table_name);
+    applied = (nullptr != applied) ? applied : &no_table;
+    wanted = (nullptr != wanted) ? wanted : &no_table;
+
+    // iptables-restore processes the commands in order: chains have to exist
+    // before jumps into them are added and must not be referenced anymore
+    // when they are deleted
+    ::std::vector<::std::string> declarations;
+    ::std::vector<::std::string> flushes;
+    ::std::vector<::std::string> deletions;
+    ::std::vector<::std::string> appends;
+    ::std::vector<::std::string> removals;
+
+    auto append_all = [&appends](const Chain& chain) {
+      for (auto const& rule : chain.rules) {
+        appends.push_back("-A " + chain.name + " " + rule);
+      }
+    };
+
+    for (auto const& chain : wanted->chains) {
+      const Chain* old = applied->find(chain.name);
+
+      if (chain.owned() || (nullptr != old && old->owned())) {
+        if (   nullptr != old
+            && old->declaration == chain.declaration
+            && old->flushed == chain.flushed
+            && old->rules == chain.rules) {
+          continue;
+        }
+        // a declaration of an existing chain flushes it when restoring with --noflush
+        if (!chain.declaration.empty()) {
+          declarations.push_back(chain.declaration);
+        } else {
+          flushes.push_back("-F " + chain.name);
+        }
+        append_all(chain);
+        continue;
+      }
+
+      // shared chain, only the rules of this rule set are touched
+      if (nullptr != old) {
+        for (auto const& rule : old->rules) {
+          if (!contains(chain.rules, rule)) {
+            deletions.push_back("-D " + chain.name + " " + rule);
+          }
+        }
+      }
+      for (auto const& rule : chain.rules) {
+        if (nullptr == old || !contains(old->rules, rule)) {
+          appends.push_back("-A " + chain.name + " " + rule);
+        }
+      }
+    }
+
+    for (auto const& old : applied->chains) {
+      if (nullptr != wanted->find(old.name)) {
+        continue;
+      }
+      if (old.owned()) {
+        flushes.push_back("-F " + old.name);
+        if (!old.declaration.empty()) {
+          removals.push_back("-X " + old.name);
+        }
+      } else {
+        for (auto const& rule : old.rules) {
+          deletions.push_back("-D " + old.name + " " + rule);
+        }
+      }
+    }
+
+    if (   declarations.empty() && flushes.empty() && deletions.empty()
+        && appends.empty() && removals.empty()) {
+      continue;
+    }
+
+    out << "*" << table_name << "\n";
+    for (auto const* lines : { &declarations, &flushes, &deletions, &appends, &removals }) {
+      for (auto const& line : *lines) {
+        out << line << "\n";
+      }
+    }
+    out << "COMMIT\n";
+  }
+
+  return out.str();
+}
+
+size_t RuleSet::rule_count() const {
+  size_t count = 0;
+  for (auto const& table : tables_) {
+    for (auto const& chain : table.chains) {
+      count += chain.rules.size();
+    }
+  }
+  return count;
+}
+
+bool apply_rule_set(const RuleSet& target,
+                    const ::std::string& applied_file,
+                    const ::std::function<bool(const ::std::string& transaction)>& restore,
+                    const ::std::function<bool()>& apply_completely) {
+  ::std::string transaction;
+  try {
+    transaction = RuleSet::load(applied_file).transaction(target);
+  } catch (const execution_error&) {
+    // missing or unreadable state
+  }
+
+  bool applied = !transaction.empty() && restore(transaction);
+  if (!applied) {
+    (void)::std::remove(applied_file.c_str());
+    applied = apply_completely();
+  }
+  if (applied) {
+    target.store(applied_file);
+  }
+  return applied;
+}
+
+} // namespace firewall
+} // namespace wago
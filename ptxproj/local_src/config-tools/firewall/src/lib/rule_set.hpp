@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use, and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+/// \file rule_set.hpp
+///
+/// \brief In-memory model of an iptables-restore rule file, used to apply
+///        only the chains which changed since the last application.
+///
+/// \author WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+#ifndef WAGO_FIREWALL_RULE_SET_HPP_
+#define WAGO_FIREWALL_RULE_SET_HPP_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace wago {
+namespace firewall {
+
+//------------------------------------------------------------------------------
+/// Rule set as written by the xsl transformations for iptables-restore.
+///
+/// A chain which is declared (':chain ...') or flushed ('-F chain') by the rule
+/// file is owned by it: its content is completely defined by the file. Rules
+/// appended to any other chain, e.g. the jump from 'in_services' into a service
+/// chain, are kept as single rules of a shared chain.
+//------------------------------------------------------------------------------
+class RuleSet {
+ public:
+  RuleSet() = default;
+  ~RuleSet() = default;
+
+  /// Parses iptables-restore input. Supported are table headers, chain
+  /// declarations, '-F' and '-A' commands, COMMIT lines and comments.
+  /// Duplicate rules of a chain are dropped.
+  /// \throw invalid_param_error on any other command
+  static RuleSet parse(const ::std::string& rules);
+
+  /// Reads and parses a rule file.
+  /// \throw file_open_error if the file cannot be read
+  static RuleSet load(const ::std::string& file_path);
+
+  /// Writes the rule set atomically to a file.
+  /// \throw file_write_error if the file cannot be written
+  void store(const ::std::string& file_path) const;
+
+  /// Rule set in iptables-restore format, chain declarations first.
+  ::std::string to_string() const;
+
+  /// Builds a single iptables-restore --noflush transaction which changes the
+  /// rule set from this (the applied one) into target. Unchanged chains and
+  /// tables are left out; an empty string means there is nothing to apply.
+  ::std::string transaction(const RuleSet& target) const;
+
+  size_t rule_count() const;
+
+ private:
+  struct Chain {
+    ::std::string name {};
+    // ':name policy [counters]' if declared by the rule file
+    ::std::string declaration {};
+    bool flushed = false;
+    ::std::vector<::std::string> rules {};
+
+    bool owned() const { return flushed || !declaration.empty(); }
+  };
+
+  struct Table {
+    ::std::string name {};
+    ::std::vector<Chain> chains {};
+
+    Chain& chain(const ::std::string& chain_name);
+    const Chain* find(const ::std::string& chain_name) const;
+  };
+
+  Table& table(const ::std::string& table_name);
+  const Table* find(const ::std::string& table_name) const;
+
+  ::std::vector<Table> tables_ {};
+};
+
+//------------------------------------------------------------------------------
+/// Applies a rule set based on the rule set applied last, which is kept in
+/// applied_file. The changed chains are passed to restore as one transaction.
+/// apply_completely is called instead if there is no readable applied state,
+/// if the transaction fails, or if nothing changed: the tables may have been
+/// changed since the last application, e.g. by hand. Whenever the target was
+/// applied it is stored as the new applied state, otherwise the state is removed.
+/// \return true if the rule set was applied
+//------------------------------------------------------------------------------
+bool apply_rule_set(const RuleSet& target,
+                    const ::std::string& applied_file,
+                    const ::std::function<bool(const ::std::string& transaction)>& restore,
+                    const ::std::function<bool()>& apply_completely);
+
+} // namespace firewall
+} // namespace wago
+
+#endif // WAGO_FIREWALL_RULE_SET_HPP_
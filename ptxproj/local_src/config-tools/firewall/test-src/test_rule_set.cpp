@@ -0,0 +1,278 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <rule_set.hpp>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <string>
+
+#include "error.hpp"
+#include "test_utils.hpp"
+
+using namespace wago::firewall;
+
+namespace {
+
+// Rule file as written by service_up.xsl.
+::std::string service_up(const ::std::string &name, const ::std::vector<::std::string> &ports) {
+  ::std::string rules = "*filter\n:in_" + name + " - [0:0]\n";
+  for (auto const &port : ports) {
+    rules += "-A in_" + name + " -i br0 -p tcp --dport " + port + " -j ACCEPT\n";
+  }
+  rules += "-A in_services -j in_" + name + "\nCOMMIT\n";
+  return rules;
+}
+
+// Rule file as written by ipcmn.xsl with the given number of user filter rules.
+::std::string user_filter(size_t count, size_t disabled) {
+  ::std::string rules = "*filter\n-F in_generic\n-F in_rules\n-A in_generic -p 2 -j ACCEPT\n";
+  for (size_t i = 0; i < count; ++i) {
+    if (i != disabled) {
+      rules += "-A in_rules -i br0 -p tcp -s 192.168." + ::std::to_string(i / 250) + "."
+          + ::std::to_string(i % 250) + " --dport " + ::std::to_string(1024 + i) + " -j ACCEPT\n";
+    }
+  }
+  rules += "COMMIT\n";
+  return rules;
+}
+
+size_t count_lines(const ::std::string &text) {
+  return static_cast<size_t>(::std::count(text.begin(), text.end(), '\n'));
+}
+
+void write_file(const ::std::string &file_path, const ::std::string &content) {
+  ::std::ofstream stream(file_path, ::std::ios::trunc);
+  stream << content;
+}
+
+// Records the calls of apply_rule_set instead of running iptables-restore.
+struct FakeRestore {
+  bool restore_result = true;
+  bool complete_result = true;
+  ::std::vector<::std::string> transactions {};
+  size_t complete_calls = 0;
+
+  ::std::function<bool(const ::std::string&)> restore() {
+    return [this](const ::std::string &transaction) {
+      transactions.push_back(transaction);
+      return restore_result;
+    };
+  }
+
+  ::std::function<bool()> apply_completely() {
+    return [this]() {
+      ++complete_calls;
+      return complete_result;
+    };
+  }
+};
+
+} // anonymous namespace
+
+class RuleSetTest : public ::testing::Test {
+ public:
+  std::string tempDir_;
+
+  RuleSetTest()
+      :
+      tempDir_ { "" } {
+  }
+
+  void SetUp() override
+  {
+    tempDir_ = TestUtils::create_temp_dir("firewall_test");
+  }
+
+  void TearDown() override
+  {
+    TestUtils::remove_dir(tempDir_);
+  }
+};
+
+TEST_F(RuleSetTest, ParseDropsDuplicatesAndMergesTables) {
+
+  auto rule_set = RuleSet::parse("# comment\n*filter\n:in_ftp - [0:0]\n-A in_ftp -p tcp --dport 21 -j ACCEPT\n"
+                                 "-A in_ftp -p tcp --dport 21 -j ACCEPT\nCOMMIT\n\n"
+                                 "*filter\n-A in_services -j in_ftp\nCOMMIT\n");
+
+  ASSERT_EQ(2, rule_set.rule_count());
+  ASSERT_EQ("*filter\n:in_ftp - [0:0]\n-A in_ftp -p tcp --dport 21 -j ACCEPT\n-A in_services -j in_ftp\nCOMMIT\n",
+            rule_set.to_string());
+}
+
+TEST_F(RuleSetTest, ParseRejectsUnsupportedCommands) {
+
+  ASSERT_THROW(RuleSet::parse("*filter\n-D in_services -j in_ftp\nCOMMIT\n"), invalid_param_error);
+  ASSERT_THROW(RuleSet::parse("-A in_ftp -j ACCEPT\n"), invalid_param_error);
+}
+
+TEST_F(RuleSetTest, StoreAndLoad) {
+
+  auto const file_path = tempDir_ + "/ftp.rls";
+  auto rule_set = RuleSet::parse(service_up("ftp", { "21" }));
+  rule_set.store(file_path);
+
+  ASSERT_EQ(rule_set.to_string(), RuleSet::load(file_path).to_string());
+  ASSERT_THROW(RuleSet::load(tempDir_ + "/missing.rls"), file_open_error);
+}
+
+TEST_F(RuleSetTest, TransactionUnchangedIsEmpty) {
+
+  auto applied = RuleSet::parse(service_up("ftp", { "21" }));
+
+  ASSERT_EQ("", applied.transaction(RuleSet::parse(service_up("ftp", { "21" }))));
+  ASSERT_EQ("", RuleSet().transaction(RuleSet()));
+}
+
+TEST_F(RuleSetTest, TransactionServiceUp) {
+
+  auto transaction = RuleSet().transaction(RuleSet::parse(service_up("ftp", { "21" })));
+
+  ASSERT_EQ("*filter\n:in_ftp - [0:0]\n-A in_ftp -i br0 -p tcp --dport 21 -j ACCEPT\n"
+            "-A in_services -j in_ftp\nCOMMIT\n", transaction);
+}
+
+TEST_F(RuleSetTest, TransactionServiceRuleChanged) {
+
+  auto applied = RuleSet::parse(service_up("ftp", { "21", "990" }));
+  auto transaction = applied.transaction(RuleSet::parse(service_up("ftp", { "21" })));
+
+  // the jump from in_services stays untouched
+  ASSERT_EQ("*filter\n:in_ftp - [0:0]\n-A in_ftp -i br0 -p tcp --dport 21 -j ACCEPT\nCOMMIT\n", transaction);
+}
+
+TEST_F(RuleSetTest, TransactionServiceDown) {
+
+  auto applied = RuleSet::parse(service_up("ftp", { "21" }));
+  auto transaction = applied.transaction(RuleSet());
+
+  ASSERT_EQ("*filter\n-F in_ftp\n-D in_services -j in_ftp\n-X in_ftp\nCOMMIT\n", transaction);
+}
+
+TEST_F(RuleSetTest, TransactionOnlyChangedChains) {
+
+  auto applied = RuleSet::parse(user_filter(10, 10) + "*nat\n-F postrouting_rules\nCOMMIT\n");
+  auto transaction = applied.transaction(RuleSet::parse(user_filter(10, 3) + "*nat\n-F postrouting_rules\nCOMMIT\n"));
+
+  // in_generic and the nat table are unchanged
+  ASSERT_EQ(0, transaction.find("*filter\n-F in_rules\n"));
+  ASSERT_EQ(::std::string::npos, transaction.find("in_generic"));
+  ASSERT_EQ(::std::string::npos, transaction.find("*nat"));
+  ASSERT_EQ(12, count_lines(transaction));
+}
+
+TEST_F(RuleSetTest, TransactionRemovedTable) {
+
+  auto applied = RuleSet::parse("*nat\n-F postrouting_rules\n-A postrouting_rules -o br1 -j MASQUERADE\nCOMMIT\n");
+
+  ASSERT_EQ("*nat\n-F postrouting_rules\nCOMMIT\n", applied.transaction(RuleSet()));
+}
+
+TEST_F(RuleSetTest, ApplyWithoutStateAppliesCompletely) {
+
+  auto const applied_file = tempDir_ + "/applied.rls";
+  auto const target = RuleSet::parse(service_up("ftp", { "21" }));
+  FakeRestore fake;
+
+  ASSERT_TRUE(apply_rule_set(target, applied_file, fake.restore(), fake.apply_completely()));
+  ASSERT_EQ(1, fake.complete_calls);
+  ASSERT_TRUE(fake.transactions.empty());
+  ASSERT_EQ(target.to_string(), RuleSet::load(applied_file).to_string());
+}
+
+TEST_F(RuleSetTest, ApplyChangedChainsOnly) {
+
+  auto const applied_file = tempDir_ + "/applied.rls";
+  RuleSet::parse(service_up("ftp", { "21", "990" })).store(applied_file);
+  auto const target = RuleSet::parse(service_up("ftp", { "21" }));
+  FakeRestore fake;
+
+  ASSERT_TRUE(apply_rule_set(target, applied_file, fake.restore(), fake.apply_completely()));
+  ASSERT_EQ(0, fake.complete_calls);
+  ASSERT_EQ(1, fake.transactions.size());
+  ASSERT_EQ("*filter\n:in_ftp - [0:0]\n-A in_ftp -i br0 -p tcp --dport 21 -j ACCEPT\nCOMMIT\n", fake.transactions[0]);
+  ASSERT_EQ(target.to_string(), RuleSet::load(applied_file).to_string());
+}
+
+TEST_F(RuleSetTest, ApplyUnchangedAppliesCompletely) {
+
+  // the tables may have been changed since the last application
+  auto const applied_file = tempDir_ + "/applied.rls";
+  auto const target = RuleSet::parse(service_up("ftp", { "21" }));
+  target.store(applied_file);
+  FakeRestore fake;
+
+  ASSERT_TRUE(apply_rule_set(target, applied_file, fake.restore(), fake.apply_completely()));
+  ASSERT_EQ(1, fake.complete_calls);
+  ASSERT_TRUE(fake.transactions.empty());
+  ASSERT_EQ(target.to_string(), RuleSet::load(applied_file).to_string());
+}
+
+TEST_F(RuleSetTest, ApplyFailedTransactionAppliesCompletely) {
+
+  auto const applied_file = tempDir_ + "/applied.rls";
+  RuleSet::parse(service_up("ftp", { "21", "990" })).store(applied_file);
+  auto const target = RuleSet::parse(service_up("ftp", { "21" }));
+  FakeRestore fake;
+  fake.restore_result = false;
+
+  ASSERT_TRUE(apply_rule_set(target, applied_file, fake.restore(), fake.apply_completely()));
+  ASSERT_EQ(1, fake.transactions.size());
+  ASSERT_EQ(1, fake.complete_calls);
+  ASSERT_EQ(target.to_string(), RuleSet::load(applied_file).to_string());
+}
+
+TEST_F(RuleSetTest, ApplyFailedRemovesState) {
+
+  auto const applied_file = tempDir_ + "/applied.rls";
+  RuleSet::parse(service_up("ftp", { "21", "990" })).store(applied_file);
+  FakeRestore fake;
+  fake.restore_result = false;
+  fake.complete_result = false;
+
+  ASSERT_FALSE(apply_rule_set(RuleSet::parse(service_up("ftp", { "21" })), applied_file,
+                              fake.restore(), fake.apply_completely()));
+  ASSERT_EQ(1, fake.transactions.size());
+  ASSERT_EQ(1, fake.complete_calls);
+  ASSERT_THROW(RuleSet::load(applied_file), file_open_error);
+}
+
+TEST_F(RuleSetTest, BenchmarkToggleOneOfManyRules) {
+
+  // hundreds of user filter rules as applied by 'firewall iptables --apply-rules',
+  // one of them is toggled
+  const size_t rule_count = 500;
+  auto const rule_file = tempDir_ + "/ipcmn.rls";
+  auto const applied_file = tempDir_ + "/applied_ipcmn.rls";
+  write_file(rule_file, user_filter(rule_count, rule_count));
+  FakeRestore fake;
+  ASSERT_TRUE(apply_rule_set(RuleSet::load(rule_file), applied_file, fake.restore(), fake.apply_completely()));
+  write_file(rule_file, user_filter(rule_count, rule_count / 2));
+
+  auto const start = ::std::chrono::steady_clock::now();
+  auto const target = RuleSet::load(rule_file);
+  ASSERT_TRUE(apply_rule_set(target, applied_file, fake.restore(), fake.apply_completely()));
+  auto const us = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+      ::std::chrono::steady_clock::now() - start).count();
+
+  // only the user filter chain is restored, not in_generic or the complete rule set
+  ASSERT_EQ(1, fake.complete_calls);
+  ASSERT_EQ(1, fake.transactions.size());
+  auto const &transaction = fake.transactions[0];
+  auto const full = count_lines(target.to_string());
+  ASSERT_EQ(0, transaction.find("*filter\n-F in_rules\n"));
+  ASSERT_EQ(::std::string::npos, transaction.find("in_generic"));
+  ASSERT_EQ(target.to_string(), RuleSet::load(applied_file).to_string());
+  RecordProperty("rules", static_cast<int>(target.rule_count()));
+  RecordProperty("full_lines", static_cast<int>(full));
+  RecordProperty("transaction_lines", static_cast<int>(count_lines(transaction)));
+  RecordProperty("load_diff_and_store_us", static_cast<int>(us));
+}
@@ -27,6 +27,8 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
 #include <glib.h>
 
 #ifdef __CT_WITH_TYPELABEL
@@ -377,13 +379,8 @@ int GetProcessorType(char* pProcessorTypeString)
   // initialise output-string
   *pProcessorTypeString = '\0';
 
-  char pCmdTemplate[] = "cat %s";
-  char cmd[strlen(pCmdTemplate) + strlen(g_proc_cpuinfo) + 1];
-
-  snprintf(cmd, sizeof(cmd), pCmdTemplate, g_proc_cpuinfo);
-
-  // get content of cpuinfo-file (it is not possible to read the file directly to buffer, because its size is ostensible always 0)
-  pCpuinfoContent = SystemCall_GetOutput(cmd);
+  // get content of cpuinfo-file (its size is ostensible always 0, so it has to be read until its end)
+  pCpuinfoContent = ProcFileContent_Get(g_proc_cpuinfo);
 
   if(pCpuinfoContent == NULL)
   {
@@ -798,7 +795,6 @@ int GetActualHostname(char* pHostnameString)
 //
 {
   int   status                = SUCCESS;
-  char* pEnvironmentHostname  = NULL;
 
   if(pHostnameString == NULL)
   {
@@ -808,19 +804,13 @@ int GetActualHostname(char* pHostnameString)
   // initialise output-string
   *pHostnameString = '\0';
 
-  pEnvironmentHostname = SystemCall_GetOutput("hostname");
-
-  if(pEnvironmentHostname == NULL)
+  // same as the hostname program prints, but without spawning it
+  if(gethostname(pHostnameString, MAX_LENGTH_COUPLER_DETAIL_STRING) != 0)
   {
+    *pHostnameString = '\0';
     status = FILE_READ_ERROR;
   }
-  else
-  {
-    // cut line feed and copy hostname string to output variable
-    (void)CutLine(pEnvironmentHostname, strlen(pEnvironmentHostname));
-    strncpy(pHostnameString, pEnvironmentHostname, MAX_LENGTH_COUPLER_DETAIL_STRING);
-    SystemCall_Destruct(&pEnvironmentHostname);
-  }
+  pHostnameString[MAX_LENGTH_COUPLER_DETAIL_STRING - 1] = '\0';
 
   return status;
 }
@@ -837,7 +827,7 @@ int GetActualDomainName(char *pDomainNameString)
 //
 {
   int   status = SUCCESS;
-  char* pDomainname = NULL;
+  char  hostname[MAX_LENGTH_COUPLER_DETAIL_STRING] = "";
 
   if(pDomainNameString == NULL)
   {
@@ -847,18 +837,35 @@ int GetActualDomainName(char *pDomainNameString)
   // initialise output-string
   *pDomainNameString = '\0';
 
-  pDomainname = SystemCall_GetOutput("dnsdomainname");
-
-  if(pDomainname == NULL)
+  if(gethostname(hostname, sizeof(hostname)) != 0)
   {
     status = FILE_READ_ERROR;
   }
   else
   {
-    // cut line feed and copy domainname string to output variable
-    (void)CutLine(pDomainname, strlen(pDomainname));
-    strncpy(pDomainNameString, pDomainname, MAX_LENGTH_COUPLER_DETAIL_STRING);
-    SystemCall_Destruct(&pDomainname);
+    // like dnsdomainname: resolve the canonical name of the host and take everything behind the first dot
+    struct addrinfo  hints;
+    struct addrinfo* pAddrInfo = NULL;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_flags  = AI_CANONNAME;
+
+    hostname[sizeof(hostname) - 1] = '\0';
+    if((getaddrinfo(hostname, NULL, &hints, &pAddrInfo) == 0) && (pAddrInfo != NULL))
+    {
+      char* pDomainname = (pAddrInfo->ai_canonname != NULL) ? strchr(pAddrInfo->ai_canonname, '.') : NULL;
+      if(pDomainname != NULL)
+      {
+        strncpy(pDomainNameString, pDomainname + 1, MAX_LENGTH_COUPLER_DETAIL_STRING - 1);
+        pDomainNameString[MAX_LENGTH_COUPLER_DETAIL_STRING - 1] = '\0';
+      }
+    }
+
+    if(pAddrInfo != NULL)
+    {
+      freeaddrinfo(pAddrInfo);
+    }
   }
 
   return status;
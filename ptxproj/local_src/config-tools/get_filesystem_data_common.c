@@ -27,6 +27,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
 #include <libudev.h>
 #include <assert.h>
 
@@ -602,6 +604,61 @@ static int GetDeviceStringByIndex(char *pOutputString,
   return status;
 }
 
+static int GetMountSource(char const * pPath,
+                          char       * pSource,
+                          size_t       sourceSize)
+//
+// Get the source of the mount the path is located on, read from the mount table of the process.
+//
+// output: source (device) of the mount, e.g. /dev/root or /dev/mmcblk0p7
+//
+// return: error-code
+//
+{
+  int         status        = NOT_FOUND;
+  struct stat pathAttributes;
+
+  if(stat(pPath, &pathAttributes) != 0)
+  {
+    return FILE_READ_ERROR;
+  }
+
+  FILE* fMountinfo = fopen("/proc/self/mountinfo", "r");
+  if(fMountinfo == NULL)
+  {
+    return FILE_OPEN_ERROR;
+  }
+
+  // mountinfo line: id parent major:minor root mountpoint options [optional fields] - fstype source superoptions
+  // the last matching line wins, it belongs to the mount on top
+  char* pLine     = NULL;
+  size_t lineSize = 0;
+  while(getline(&pLine, &lineSize, fMountinfo) > 0)
+  {
+    unsigned int major = 0;
+    unsigned int minor = 0;
+    char* pSeparator   = strstr(pLine, " - ");
+
+    if(   (pSeparator != NULL)
+       && (sscanf(pLine, "%*d %*d %u:%u", &major, &minor) == 2)
+       && (major == major(pathAttributes.st_dev)) && (minor == minor(pathAttributes.st_dev)))
+    {
+      char source[MAX_LENGTH_OUTPUT_LINE] = "";
+      if(sscanf(pSeparator, " - %*s %255s", source) == 1)
+      {
+        strncpy(pSource, source, sourceSize - 1);
+        pSource[sourceSize - 1] = '\0';
+        status = SUCCESS;
+      }
+    }
+  }
+
+  free(pLine);
+  fclose(fMountinfo);
+
+  return status;
+}
+
 static int GetHomeDevice(char* pOutputString,
                          int   additionalParam)
 //
@@ -620,7 +677,6 @@ static int GetHomeDevice(char* pOutputString,
 //
 {
   int   status                  = SUCCESS;
-  char* pDfContent              = NULL;
 
   UNUSED_PARAMETER(additionalParam);
 
@@ -632,43 +688,22 @@ static int GetHomeDevice(char* pOutputString,
   // initialise output-string
   *pOutputString = '\0';
 
-  // get output of df-system-call
-  pDfContent = SystemCall_GetOutput("df /home");
+  // get the device like "df /home" would print it in its first column, but without spawning df
+  char  dfLineString[MAX_LENGTH_OUTPUT_LINE]  = "";
 
-  if(pDfContent == NULL)
-  {
-    status = FILE_READ_ERROR;
-  }
-  else
-  {
-    char  dfLineString[MAX_LENGTH_OUTPUT_LINE]  = "";
-
-    // We have to look at the 2nd line (GetLineByNr starts to count with 1)
-    //
-    // df output looks like this:
-    //
-    // Filesystem           1K-blocks      Used Available Use% Mounted on
-    // /dev/root                81249     48380     28773  63% /
+  status = GetMountSource("/home", dfLineString, sizeof(dfLineString));
 
-    if(SUCCESS == SystemCall_GetLineByNr(pDfContent, 2, dfLineString))
+  if(SUCCESS == status)
+  {
+    // if /home is located within the rootfs, the mount table contains "/dev/root" instead of the real device
+    if(0 == strcmp(dfLineString, "/dev/root"))
     {
-
-      // device is directly the first string in line, so we just must cut the rest
-      CutWord(dfLineString, MAX_LENGTH_OUTPUT_LINE);
-
-      // if /home is located within the rootfs, df returns "/dev/root" instead of the real device
-      if(0 == strcmp(dfLineString, "/dev/root"))
-      {
-         status = GetActivePartition(dfLineString, 0);
-      }
-
-      strncpy(pOutputString, dfLineString, MAX_LENGTH_OUTPUT_STRING);
+       status = GetActivePartition(dfLineString, 0);
     }
 
+    strncpy(pOutputString, dfLineString, MAX_LENGTH_OUTPUT_STRING);
   }
 
-  SystemCall_Destruct(&pDfContent);
-
   return status;
 }
 
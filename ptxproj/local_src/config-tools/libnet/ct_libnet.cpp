@@ -18,6 +18,7 @@
 
 #include <BaseTypes.hpp>
 #include <BridgeConfig.hpp>
+#include <ConfigSnapshot.hpp>
 #include <IPConfig.hpp>
 #include <InterfaceConfig.hpp>
 #include <InterfaceInformationApi.hpp>
@@ -302,6 +303,8 @@ bool is_cidr_netmask(const char *netmask)
 
 ::std::optional<IPConfig> get_ip_config(const ::std::string& interface)
 {
+  // bridge and IP config in one round trip, errors are reported by the following getters
+  napi::PrefetchConfigs();
   auto bridge_name = get_bridge_name(interface);
   napi::IPConfigs ip_configs;
   auto error = napi::GetIPConfigs(ip_configs);
@@ -419,15 +422,11 @@ int ct_libnet_get_eth_port_state_from_hw(const char *port,
 
     status = port2dev_ethernet(netconf::Interface::NameFromLabel(port), dev, sizeof(dev));
 
-    // FIXME: find a better place for init/cleanup!
-    // User should be able to chain several ct_libnet_ functions without
-    // reinitializing the underlying stuff.
-
 	netlinkSession_t *nlSessionHandle = NULL;
 
     if(SUCCESS == status)
     {
-        status = ct_netlink_init(&nlSessionHandle);
+        status = ct_netlink_get_session(&nlSessionHandle);
     }
 
     if(SUCCESS == status)
@@ -447,8 +446,6 @@ int ct_libnet_get_eth_port_state_from_hw(const char *port,
         }
     }
 
-    ct_netlink_cleanup(nlSessionHandle);
-
     return status;
 }
 
@@ -467,15 +464,11 @@ int ct_libnet_get_cable_state(const char *port,
 
     status = port2dev_ethernet(netconf::Interface::NameFromLabel(port), dev, sizeof(dev));
 
-    // FIXME: find a better place for init/cleanup!
-    // User should be able to chain several ct_libnet_ functions without
-    // reinitializing the underlying stuff.
-
 	netlinkSession_t *nlSessionHandle = NULL;
 
     if(SUCCESS == status)
     {
-        status = ct_netlink_init(&nlSessionHandle);
+        status = ct_netlink_get_session(&nlSessionHandle);
     }
 
     if(SUCCESS == status)
@@ -503,8 +496,6 @@ int ct_libnet_get_cable_state(const char *port,
         }
     }
 
-    ct_netlink_cleanup(nlSessionHandle);
-
     return status;
 }
 
@@ -543,7 +534,7 @@ int ct_libnet_get_ip_addr_from_hw(const char *port,
 
     if(SUCCESS == status)
     {
-        status = ct_netlink_init(&nlSessionHandle);
+        status = ct_netlink_get_session(&nlSessionHandle);
     }
 
     if(SUCCESS == status)
@@ -560,8 +551,6 @@ int ct_libnet_get_ip_addr_from_hw(const char *port,
         }
     }
 
-    ct_netlink_cleanup(nlSessionHandle);
-
     return status;
 }
 
@@ -601,7 +590,7 @@ int ct_libnet_get_netmask_from_hw(const char *port,
 
     if(SUCCESS == status)
     {
-        status = ct_netlink_init(&nlSessionHandle);
+        status = ct_netlink_get_session(&nlSessionHandle);
     }
 
     if(SUCCESS == status)
@@ -628,8 +617,6 @@ int ct_libnet_get_netmask_from_hw(const char *port,
         }
     }
 
-    ct_netlink_cleanup(nlSessionHandle);
-
     return status;
 }
 
@@ -652,7 +639,7 @@ int ct_libnet_get_mac_addr_from_hw(const char *port,
 
     if(SUCCESS == status)
     {
-        status = ct_netlink_init(&nlSessionHandle);
+        status = ct_netlink_get_session(&nlSessionHandle);
     }
 
     if(SUCCESS == status)
@@ -660,8 +647,6 @@ int ct_libnet_get_mac_addr_from_hw(const char *port,
         status = ct_netlink_get_macaddr(dev, mac, macLen, nlSessionHandle);
     }
 
-    ct_netlink_cleanup(nlSessionHandle);
-
     return status;
 }
 
@@ -683,15 +668,13 @@ int ct_libnet_get_broadcast_from_hw(const char *port,
 
     netlinkSession_t *nlSessionHandle = NULL;
 
-	  status = ct_netlink_init(&nlSessionHandle);
+	  status = ct_netlink_get_session(&nlSessionHandle);
 
     if(SUCCESS == status)
     {
         status = ct_netlink_get_broadcast(dev, broadcast, broadcastLen, nlSessionHandle);
     }
 
-    ct_netlink_cleanup(nlSessionHandle);
-
 	return status;
 }
 
@@ -914,15 +897,13 @@ int ct_libnet_get_default_via_from_hw(const char *port, char *strDefaultVia, siz
 
 	netlinkSession_t *nlSessionHandle = NULL;
 
-    int status = ct_netlink_init(&nlSessionHandle);
+    int status = ct_netlink_get_session(&nlSessionHandle);
 
     if(SUCCESS == status)
     {
         status = ct_netlink_get_default_via("dontcare", strDefaultVia, strDefaultViaLen, nlSessionHandle);
     }
 
-    ct_netlink_cleanup(nlSessionHandle);
-
     return status;
 }
 
@@ -1244,7 +1225,7 @@ int ct_libnet_set_port_state_to_hw(const char *port,
 
 	netlinkSession_t *nlSessionHandle = NULL;
 
-    status = ct_netlink_init(&nlSessionHandle);
+    status = ct_netlink_get_session(&nlSessionHandle);
 
     if(SUCCESS == status)
     {
@@ -1265,8 +1246,6 @@ int ct_libnet_set_port_state_to_hw(const char *port,
         status = INVALID_PARAMETER;
     }
 
-    ct_netlink_cleanup(nlSessionHandle);
-
     return status;
 }
 
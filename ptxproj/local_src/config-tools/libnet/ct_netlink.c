@@ -24,8 +24,12 @@ struct netlinkSession
 	struct nl_sock *sock;
 	struct nl_cache *link_cache;
 	struct nl_cache *addr_cache;
+	struct nl_cache *route_cache;   // only set for the shared session
+	struct nl_cache_mngr *mngr;     // only set for the shared session
 };
 
+static netlinkSession_t *sharedSession = NULL;
+
 /**
  * @brief
  *
@@ -75,18 +79,18 @@ int ct_netlink_init(netlinkSession_t **pSessionHandle)
 }
 
 
-/**
- * @brief cleanup acquired internal ressources: a libnl socket, address and link caches.
- */
-
-void ct_netlink_cleanup(netlinkSession_t *sessionHandle)
+static void __free_session(netlinkSession_t *sessionHandle)
 {
 	if(NULL != sessionHandle)
 	{
+	    // Caches added to a cache manager belong to the manager
+	    if(sessionHandle->mngr) nl_cache_mngr_free(sessionHandle->mngr);
+	    else
+	    {
+	        if(sessionHandle->link_cache) nl_cache_free(sessionHandle->link_cache);
 
-	    if(sessionHandle->link_cache) nl_cache_free(sessionHandle->link_cache);
-
-    	if(sessionHandle->addr_cache) nl_cache_free(sessionHandle->addr_cache);
+	        if(sessionHandle->addr_cache) nl_cache_free(sessionHandle->addr_cache);
+	    }
 
 	    if(sessionHandle->sock) nl_socket_free(sessionHandle->sock);
 
@@ -94,6 +98,134 @@ void ct_netlink_cleanup(netlinkSession_t *sessionHandle)
 	}
 }
 
+static int __create_shared_session(netlinkSession_t **pSessionHandle)
+{
+	int ret = 0;
+	netlinkSession_t *ressources = g_malloc0(sizeof(netlinkSession_t));
+
+	if(NULL == (ressources->sock = nl_socket_alloc()))
+	{
+		ret = -NLE_NOMEM;
+	}
+	else
+	{
+		ret = nl_connect(ressources->sock, NETLINK_ROUTE);
+	}
+
+	// The manager subscribes to RTNLGRP_LINK, RTNLGRP_IPV4_IFADDR and RTNLGRP_IPV4_ROUTE (among others)
+	// and keeps the caches up to date with the notifications of the kernel.
+	if(0 == ret)
+	{
+		ret = nl_cache_mngr_alloc(NULL, NETLINK_ROUTE, 0, &(ressources->mngr));
+	}
+
+	if(0 == ret)
+	{
+		ret = nl_cache_mngr_add(ressources->mngr, "route/link", NULL, NULL, &(ressources->link_cache));
+	}
+
+	if(0 == ret)
+	{
+		ret = nl_cache_mngr_add(ressources->mngr, "route/addr", NULL, NULL, &(ressources->addr_cache));
+	}
+
+	if(0 == ret)
+	{
+		ret = nl_cache_mngr_add(ressources->mngr, "route/route", NULL, NULL, &(ressources->route_cache));
+	}
+
+	if(0 == ret)
+	{
+		*pSessionHandle = ressources;
+	}
+	else
+	{
+		__free_session(ressources);
+	}
+
+	return ret;
+}
+
+static int __sync_shared_session(netlinkSession_t *sessionHandle)
+{
+	// Apply the notifications received since the last query, never blocks
+	int ret = nl_cache_mngr_data_ready(sessionHandle->mngr);
+
+	if(ret < 0)
+	{
+		// Notifications got lost (i.e. socket buffer overrun): dump everything again
+		ret = nl_cache_refill(sessionHandle->sock, sessionHandle->link_cache);
+
+		if(0 == ret)
+		{
+			ret = nl_cache_refill(sessionHandle->sock, sessionHandle->addr_cache);
+		}
+
+		if(0 == ret)
+		{
+			ret = nl_cache_refill(sessionHandle->sock, sessionHandle->route_cache);
+		}
+	}
+
+	return (ret < 0) ? ret : 0;
+}
+
+/**
+ * @brief return the netlink session shared by all queries of the process.
+ *
+ * The session is created on first use and lives until the process exits. Its link, address and route caches are
+ * updated from kernel notifications before being returned, so queries do not have to dump the kernel tables again.
+ * Never pass the shared session to ct_netlink_cleanup. Like the rest of ct_libnet it is not thread safe.
+ *
+ * @return success/failure
+ *         Possible errors: Not enough memory
+ *                          Connection error
+ */
+int ct_netlink_get_session(netlinkSession_t **pSessionHandle)
+{
+	int ret = 0;
+
+	assert(NULL != pSessionHandle);
+
+	if(NULL == sharedSession)
+	{
+		ret = __create_shared_session(&sharedSession);
+	}
+	else if(0 != (ret = __sync_shared_session(sharedSession)))
+	{
+		// Start over on the next call
+		__free_session(sharedSession);
+		sharedSession = NULL;
+	}
+
+	*pSessionHandle = sharedSession;
+
+	return (0 == ret) ? SUCCESS : SYSTEM_CALL_ERROR;
+}
+
+/**
+ * @brief drop the shared session, the next ct_netlink_get_session creates a new one.
+ *
+ * Needed in a forked child that must not read the notifications of its parent's socket
+ * or after moving the process to another network namespace.
+ */
+void ct_netlink_release_session(void)
+{
+	__free_session(sharedSession);
+	sharedSession = NULL;
+}
+
+/**
+ * @brief cleanup acquired internal ressources: a libnl socket, address and link caches.
+ */
+
+void ct_netlink_cleanup(netlinkSession_t *sessionHandle)
+{
+	assert(sharedSession != sessionHandle || NULL == sessionHandle);
+
+	__free_session(sessionHandle);
+}
+
 // FIXME: Temporary workaround for libnl header mismatch
 extern struct nl_object *nl_cache_find(struct nl_cache *cache, struct nl_object *filter);
 
@@ -200,6 +332,8 @@ int ct_netlink_get_macaddr(const char *devStr,
         }
 
         rtnl_link_set_ifindex(filter, ival);
+        // The shared session also caches the per address family link notifications (i.e. AF_INET6)
+        rtnl_link_set_family(filter, AF_UNSPEC);
 
         if(NULL == (link = nl_cache_find(sessionHandle->link_cache, OBJ_CAST(filter))))
         {
@@ -304,7 +438,11 @@ int ct_netlink_get_default_via(const char *devStr,
     do
     {
 
-        if(SUCCESS != (status = rtnl_route_alloc_cache(sessionHandle->sock, AF_UNSPEC, 0, &route_cache)))
+        if(NULL != sessionHandle->route_cache)
+        {
+            route_cache = sessionHandle->route_cache;
+        }
+        else if(SUCCESS != (status = rtnl_route_alloc_cache(sessionHandle->sock, AF_UNSPEC, 0, &route_cache)))
         {
             break;
         }
@@ -349,7 +487,7 @@ int ct_netlink_get_default_via(const char *devStr,
         nl_object_put(viaObj);
     }
 
-    if(route_cache)
+    if(route_cache && route_cache != sessionHandle->route_cache)
     {
         nl_cache_free(route_cache);
     }
@@ -388,6 +526,8 @@ int ct_netlink_get_link_flags(const char *devStr,
         }
 
         rtnl_link_set_ifindex(filter, ival);
+        // The shared session also caches the per address family link notifications (i.e. AF_INET6)
+        rtnl_link_set_family(filter, AF_UNSPEC);
 
         if(NULL == (link = nl_cache_find(sessionHandle->link_cache, OBJ_CAST(filter))))
         {
@@ -450,6 +590,8 @@ static int __set_link_state(const char *devStr, enum ct_netlink_link_states stat
         }
 
         rtnl_link_set_ifindex(filter, ival);
+        // The shared session also caches the per address family link notifications (i.e. AF_INET6)
+        rtnl_link_set_family(filter, AF_UNSPEC);
 
         if(NULL == (link = nl_cache_find(sessionHandle->link_cache, OBJ_CAST(filter))))
         {
@@ -17,6 +17,9 @@ typedef struct netlinkSession netlinkSession_t;
 int ct_netlink_init(netlinkSession_t **pSessionHandle);
 void ct_netlink_cleanup(netlinkSession_t *sessionHandle);
 
+int ct_netlink_get_session(netlinkSession_t **pSessionHandle);
+void ct_netlink_release_session(void);
+
 int ct_netlink_get_link_flags(const char *devStr,
                               unsigned int *flags,
 							  netlinkSession_t *sessionHandle);
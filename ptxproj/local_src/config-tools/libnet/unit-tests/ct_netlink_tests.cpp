@@ -0,0 +1,206 @@
+//------------------------------------------------------------------------------
+/// Copyright (c) WAGO GmbH & Co. KG
+///
+/// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+/// manufacturing, reproduction, use, and sales rights pertaining to this
+/// subject matter are governed by the license agreement. The recipient of this
+/// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+/// \file ct_netlink_tests.cpp
+///
+/// \brief Tests of the shared netlink session and per query latency of a fresh
+///        netlink session versus the shared one.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include files
+//------------------------------------------------------------------------------
+
+#include "CppUTest/TestHarness.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <net/if.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <netlink/route/link/veth.h>
+
+#include "../ct_error_handling.h"
+
+extern "C"
+{
+#include "../libnet/ct_netlink.h"
+}
+
+static const int benchmarkQueries = 1000;
+
+// Exit codes of the child running in its own network namespace
+static const int nsChildPassed = 0;
+static const int nsChildFailed = 1;
+static const int nsChildSkipped = 77;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Typical config-tool query: MAC address and link flags of one device
+static int query_loopback(netlinkSession_t *session)
+{
+    char mac[32];
+    unsigned int flags = 0;
+    mac[0] = '\0';
+
+    int status = ct_netlink_get_macaddr("lo", mac, sizeof(mac), session);
+    if(SUCCESS == status)
+    {
+        status = ct_netlink_get_link_flags("lo", &flags, session);
+    }
+    return status;
+}
+
+TEST_GROUP(ct_netlink_session)
+{
+    void setup()
+    {
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ct_netlink_session, shared_session_is_reused)
+{
+    netlinkSession_t *first = NULL;
+    netlinkSession_t *second = NULL;
+
+    LONGS_EQUAL(SUCCESS, ct_netlink_get_session(&first));
+    LONGS_EQUAL(SUCCESS, ct_netlink_get_session(&second));
+    POINTERS_EQUAL(first, second);
+    LONGS_EQUAL(SUCCESS, query_loopback(second));
+}
+
+// A private network namespace keeps link changes of the tests away from the host.
+// Without root, a user namespace provides the capabilities inside the new network namespace.
+static bool enter_private_netns(void)
+{
+    return (0 == unshare(CLONE_NEWNET)) || (0 == unshare(CLONE_NEWUSER | CLONE_NEWNET));
+}
+
+static int add_veth(const char *name, const char *peer)
+{
+    struct nl_sock *sock = nl_socket_alloc();
+    int ret = -NLE_NOMEM;
+
+    if(NULL != sock)
+    {
+        ret = nl_connect(sock, NETLINK_ROUTE);
+        if(0 == ret)
+        {
+            ret = rtnl_link_veth_add(sock, name, peer, getpid());
+        }
+        nl_socket_free(sock);
+    }
+    return ret;
+}
+
+static bool link_is_up(const char *devStr, netlinkSession_t *session)
+{
+    unsigned int flags = 0;
+    return (SUCCESS == ct_netlink_get_link_flags(devStr, &flags, session)) && (flags & IFF_UP);
+}
+
+// Runs in the child, assertions of the test framework cannot be used here
+static int follow_link_changes_in_private_netns(void)
+{
+    netlinkSession_t *shared = NULL;
+    netlinkSession_t *other = NULL;
+
+    // The inherited session listens to the parent's namespace and socket
+    ct_netlink_release_session();
+    if(!enter_private_netns())
+    {
+        return nsChildSkipped;
+    }
+
+    // The shared session exists before the link, it has to learn about the new link as well
+    if(SUCCESS != ct_netlink_get_session(&shared))
+    {
+        return nsChildFailed;
+    }
+    if(0 != add_veth("ctnl0", "ctnl1"))
+    {
+        return nsChildSkipped;
+    }
+    if(SUCCESS != ct_netlink_init(&other))
+    {
+        return nsChildFailed;
+    }
+
+    unsigned int flags = 0;
+    bool const downAfterAdd = (SUCCESS == ct_netlink_get_session(&shared)) &&
+                              (SUCCESS == ct_netlink_get_link_flags("ctnl0", &flags, shared)) && !(flags & IFF_UP);
+
+    bool const upAfterEnable = (SUCCESS == ct_netlink_enable_link("ctnl0", other)) &&
+                               (SUCCESS == ct_netlink_get_session(&shared)) && link_is_up("ctnl0", shared);
+
+    bool const downAfterDisable = (SUCCESS == ct_netlink_disable_link("ctnl0", other)) &&
+                                  (SUCCESS == ct_netlink_get_session(&shared)) && !link_is_up("ctnl0", shared);
+
+    ct_netlink_cleanup(other);
+    ct_netlink_release_session();
+    return (downAfterAdd && upAfterEnable && downAfterDisable) ? nsChildPassed : nsChildFailed;
+}
+
+// Link changes made outside of the shared session reach its cache by notification.
+// The link is a veth pair in a network namespace of a child process, the host's links are not touched.
+TEST(ct_netlink_session, shared_session_follows_link_changes)
+{
+    fflush(NULL);
+    pid_t const child = fork();
+    CHECK(child >= 0);
+    if(0 == child)
+    {
+        _exit(follow_link_changes_in_private_netns());
+    }
+
+    int status = 0;
+    LONGS_EQUAL(child, waitpid(child, &status, 0));
+    CHECK(WIFEXITED(status));
+    if(nsChildSkipped == WEXITSTATUS(status))
+    {
+        printf("\nshared_session_follows_link_changes skipped: no private network namespace with a veth link\n");
+        return;
+    }
+    LONGS_EQUAL(nsChildPassed, WEXITSTATUS(status));
+}
+
+TEST(ct_netlink_session, benchmark_query_latency)
+{
+    double start = now_us();
+    for(int i = 0; i < benchmarkQueries; ++i)
+    {
+        netlinkSession_t *session = NULL;
+        LONGS_EQUAL(SUCCESS, ct_netlink_init(&session));
+        LONGS_EQUAL(SUCCESS, query_loopback(session));
+        ct_netlink_cleanup(session);
+    }
+    double fresh = (now_us() - start) / benchmarkQueries;
+
+    start = now_us();
+    for(int i = 0; i < benchmarkQueries; ++i)
+    {
+        netlinkSession_t *session = NULL;
+        LONGS_EQUAL(SUCCESS, ct_netlink_get_session(&session));
+        LONGS_EQUAL(SUCCESS, query_loopback(session));
+    }
+    double shared = (now_us() - start) / benchmarkQueries;
+
+    // Timing only, the numbers depend on the load of the host
+    printf("\nct_netlink query latency: %.1f us with init/cleanup, %.1f us with shared session\n", fresh, shared);
+}
@@ -18,6 +18,7 @@
 // include files
 //------------------------------------------------------------------------------
 #include <iostream>
+#include <chrono>
 #include <getopt.h>
 #include <cstdarg>
 #include <csignal>
@@ -26,6 +27,8 @@
 #include "wp_edit.hpp"
 #include "wp_parameterc.hpp"
 #include "wp_sniffer.hpp"
+#include "wp_ring.hpp"
+#include "wp_writer.hpp"
 #include "wp_debug.hpp"
 #include "wp_util.hpp"
 
@@ -43,6 +46,12 @@ extern "C"
 #define CMD_TAR_CREATE "tar cfz "
 #define CMD_TAR_FLATTEN_FLAG "--transform='s,.*/,,'"
 
+// milliseconds until the kernel hands out a partially filled block of the capture ring
+#define RING_BLOCK_TIMEOUT 100
+#define RING_POLL_TIMEOUT 100
+// milliseconds between the updates of the status output
+#define STATS_INTERVAL 1000
+
 enum class opt_actions
 {
   none = 1 << 0,
@@ -92,7 +101,7 @@ option longopts[] = {
    { nullptr,       0,                  nullptr,    0  }
 };
 
-bool RunLoop = false;
+volatile std::sig_atomic_t RunLoop = 0;
 //------------------------------------------------------------------------------
 // function implementation
 //------------------------------------------------------------------------------
@@ -123,8 +132,7 @@ bool test(opt_actions action)
 static void HandleSignal(int signal)
 {
   (void) signal;
-  PcapSniffer& sniffer = PcapSniffer::Instance();
-  RunLoop = sniffer.BreakLoop();
+  RunLoop = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -133,6 +141,7 @@ static void ShowStats(wp::info_t info, bool newLine)
   std::cout << info.lastRfshTime
             <<": packets=" << info.lastRecv
             << ", filesize=" << info.lastFSize
+            << ", drops=" << info.lastDrops
             << ", pid=" << info.lastPid;
   if(newLine) {
     std::cout << std::endl;
@@ -426,55 +435,90 @@ static int DoStart()
       }
     }
 
-    // open sniffer
+    // the kernel runs the filter on the frames of a single interface, on "any"
+    // the frames come without link layer header and the writer filters them.
+    // The writer also filters the frames whose VLAN tag was stripped by the kernel.
     PcapSniffer& sniffer = PcapSniffer::Instance();
-    sniffer.OpenLive(config.data.device, config.data.maxPacketLen);
-    sniffer.SetFilter(config.data.filter);
-    sniffer.OpenDump(config.getNewSavefile());
+    bpf_program prog = {0, nullptr};
+    int linkType = wp::linkType(config.data.device);
+    bool cooked = (LINKTYPE_LINUX_SLL == linkType);
+    std::vector<sock_filter> kernelFilter;
+    if(!config.data.filter.empty()) {
+      sniffer.CompileProgram(config.data.filter,
+                             linkType,
+                             static_cast<std::uint16_t>(config.data.maxPacketLen + (cooked ? SLL_HEADER_LEN : 0)),
+                             &prog);
+      if(!cooked) {
+        kernelFilter.assign(reinterpret_cast<sock_filter*>(prog.bf_insns),
+                            reinterpret_cast<sock_filter*>(prog.bf_insns) + prog.bf_len);
+      }
+    }
+
+    // open capture ring, it captures with the filter attached from the beginning
+    wp::RingCapture ring;
+    wp::ring_config_t ringConfig {config.data.blockSize,
+                                  config.data.blockCount,
+                                  RING_BLOCK_TIMEOUT,
+                                  config.data.maxPacketLen};
+    ring.Open(config.data.device, ringConfig, kernelFilter);
+
+    wp::writer_config_t writerConfig {config.data.maxFilesize,
+                                      config.data.rotateFiles,
+                                      config.data.compressFiles};
+    wp::CaptureWriter writer(ring, writerConfig, [&config]() { return config.getNewSavefile(); });
+    if(nullptr != prog.bf_insns) {
+      writer.SetUserFilter([&prog](const std::uint8_t * data, std::uint32_t caplen, std::uint32_t len) {
+        pcap_pkthdr header {};
+        header.caplen = caplen;
+        header.len = len;
+        return 0 != pcap_offline_filter(&prog, &header, data);
+      });
+    }
+    writer.Start(config.getNewSavefile());
 
-    // loop sniffer
-    RunLoop = true;
-    int result = 0;
-    unsigned int total = 0;
+    // loop capture, the writer thread writes and rotates the files
+    RunLoop = 1;
+    auto nextRefresh = std::chrono::steady_clock::now();
 
     while(RunLoop)
     {
-      // statistics
-      info.updateLast(total, sniffer.savefile);
-      info.data.isRunning = true;
-      info.save();
-      ShowStats(info.data, false);
-
-      // filesize exceeded or file no longer exists
-      if(info.data.lastFSize >= config.data.maxFilesize ||
-         !std::filesystem::exists(sniffer.savefile))
-      {
-        RunLoop = sniffer.BreakLoop();
+      tpacket_block_desc * pBlock = ring.Next(RING_POLL_TIMEOUT);
+      if(nullptr != pBlock) {
+        writer.Push(pBlock);
       }
 
-      RunLoop = sniffer.Dispatch(&result);
-      total += static_cast<unsigned int>(result);
-
-      // restart sniffer loop after switching file
-      if (!RunLoop &&
-          config.data.rotateFiles &&
-          info.data.lastFSize >= config.data.maxFilesize)
+      if(std::chrono::steady_clock::now() >= nextRefresh)
       {
-        Debug_Printf("Reached maximum filesize, continue with next file\n");
-        info.data.isRunning = false;
-        sniffer.Close();
-        sniffer.OpenLive(config.data.device, config.data.maxPacketLen);
-        sniffer.SetFilter(config.data.filter);
-        sniffer.OpenDump(config.getNewSavefile());
-        RunLoop = true;
-        total = 0;
+        nextRefresh = std::chrono::steady_clock::now() + std::chrono::milliseconds(STATS_INTERVAL);
+
+        // statistics
+        auto savefile = writer.Savefile();
+        wp::ring_stats_t stats = ring.Stats();
+        info.updateLast(static_cast<unsigned int>(writer.Packets()), savefile);
+        info.updateDrops(stats.drops, stats.freezes);
+        info.data.isRunning = true;
+        info.save();
+        ShowStats(info.data, false);
+
+        // filesize exceeded without rotation or file no longer exists
+        if(writer.LimitReached() ||
+           !std::filesystem::exists(savefile))
+        {
+          RunLoop = 0;
+        }
       }
     }
-    // loop sniffer
+    // loop capture
 
-    info.updateLast(total, sniffer.savefile);
+    writer.Stop();
+    wp::ring_stats_t stats = ring.Stats();
+    info.updateLast(static_cast<unsigned int>(writer.Packets()), writer.Savefile());
+    info.updateDrops(stats.drops, stats.freezes);
     info.data.isRunning = false;
-    sniffer.Close();
+    ring.Close();
+    if(nullptr != prog.bf_insns) {
+      pcap_freecode(&prog);
+    }
     ShowStats(info.data, true);
     info.save();
 
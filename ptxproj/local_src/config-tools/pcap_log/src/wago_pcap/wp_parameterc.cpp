@@ -141,6 +141,11 @@ namespace wp {
     return devices;
   }
 
+  //----------------------------------------------------------------------------
+  bool isCompressedPcapFile(const std::filesystem::path & path) {
+    return (path.extension() == ".gz") && (path.stem().extension() == ".pcap");
+  }
+
   //----------------------------------------------------------------------------
   std::set<std::filesystem::path> getPcapFilePaths(
     const std::filesystem::path & dir,
@@ -152,7 +157,8 @@ namespace wp {
       for(auto const & dir_entry : std::filesystem::directory_iterator(dir)) {
         if(std::filesystem::is_regular_file(dir_entry) &&
            (!std::filesystem::is_empty(dir_entry)) &&
-           (dir_entry.path().extension() == ".pcapng" || dir_entry.path().extension() == ".pcap" || include_all_files)) {
+           (dir_entry.path().extension() == ".pcapng" || dir_entry.path().extension() == ".pcap" ||
+            isCompressedPcapFile(dir_entry.path()) || include_all_files)) {
           file_paths.insert(dir_entry.path());
         }
       }
@@ -229,6 +235,12 @@ namespace wp {
     this->data.lastRfshTime = getTimestamp(std::time(nullptr), TIMESTAMP_FORMAT_JSON);
   }
 
+  void Info::updateDrops(std::uint64_t drops,
+                         std::uint64_t freezes) {
+    this->data.lastDrops = drops;
+    this->data.lastFreezes = freezes;
+  }
+
   //----------------------------------------------------------------------------
   Config::Config() {
     this->setPath(PATH_CONFIG);
@@ -272,6 +284,8 @@ namespace wp {
     {
       std::filesystem::path oldest_file = _file_rotation.front();
       std::filesystem::remove(oldest_file);
+      // the file may have been compressed after it was finished
+      std::filesystem::remove(oldest_file.string() + ".gz");
       _file_rotation.pop_front();
     }
     _file_rotation.emplace_back(path);
@@ -59,6 +59,9 @@ namespace wp {
   #define DFLT_ROTATE_FILES true
   #define DFLT_MAX_PART_SIZE_PERC 60
   #define DFLT_MAX_PACKET_LEN 2048
+  #define DFLT_BLOCK_SIZE (KB_TO_BYTE(256))
+  #define DFLT_BLOCK_COUNT 8
+  #define DFLT_COMPRESS_FILES false
 
   // percentage of the available memory that should be used as the partition max size
   // (upper limit)
@@ -73,6 +76,9 @@ namespace wp {
       bool rotateFiles {DFLT_ROTATE_FILES};
       std::uint8_t maxPartitionSizePct {DFLT_MAX_PART_SIZE_PERC};
       std::uint16_t maxPacketLen {DFLT_MAX_PACKET_LEN};
+      std::uint32_t blockSize {DFLT_BLOCK_SIZE};   // block size of the capture ring
+      std::uint32_t blockCount {DFLT_BLOCK_COUNT}; // blocks of the capture ring
+      bool compressFiles {DFLT_COMPRESS_FILES};    // gzip the files finished by the rotation
   };
 
   NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(config_t, // NOLINT
@@ -82,7 +88,10 @@ namespace wp {
                                                   maxFilesize,
                                                   rotateFiles,
                                                   maxPartitionSizePct,
-                                                  maxPacketLen)
+                                                  maxPacketLen,
+                                                  blockSize,
+                                                  blockCount,
+                                                  compressFiles)
 
   //----------------------------------------------------------------------------
   struct info_t{
@@ -90,6 +99,8 @@ namespace wp {
       pid_t lastPid {0};
       unsigned int lastRecv {0u};
       std::uintmax_t lastFSize {0u};
+      std::uint64_t lastDrops {0u};   // packets dropped because the capture ring was full
+      std::uint64_t lastFreezes {0u}; // times the capture ring was completely full
       std::string lastRfshTime = {DFLT_EMPTY_STR};
       std::vector<std::string> optDlPaths = {};
       std::vector<std::string> optDevices = {DFLT_DEVICE};
@@ -101,6 +112,8 @@ namespace wp {
                                                   lastPid,
                                                   lastRecv,
                                                   lastFSize,
+                                                  lastDrops,
+                                                  lastFreezes,
                                                   lastRfshTime,
                                                   optMemCard,
                                                   optDlPaths,
@@ -153,6 +166,8 @@ namespace wp {
 
   std::vector<std::string> getOptDlPaths(bool include_all_files = false);
 
+  bool isCompressedPcapFile(const std::filesystem::path & path);
+
   std::set<std::filesystem::path> getPcapFilePaths(
     const std::filesystem::path & dir,
     bool include_all_files = false);
@@ -218,6 +233,8 @@ namespace wp {
       void updateOptions(bool get_all_files = false);
       void updateLast(const unsigned int & recv,
                       const std::filesystem::path & path);
+      void updateDrops(std::uint64_t drops,
+                       std::uint64_t freezes);
   };
 
   //----------------------------------------------------------------------------
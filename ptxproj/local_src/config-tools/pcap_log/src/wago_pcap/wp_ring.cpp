@@ -0,0 +1,272 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file     wp_ring.cpp
+///
+///  \brief    Packet capture by a TPACKET_V3 ring memory-mapped from the kernel.
+///
+///  \author   <author> : WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "wp_ring.hpp"
+#include "wp_debug.hpp"
+
+//------------------------------------------------------------------------------
+namespace wp {
+  //----------------------------------------------------------------------------
+  // defines; structure, enumeration and type definitions
+  //----------------------------------------------------------------------------
+  // frames of TPACKET_V3 have a variable size, the frame size is only used by the kernel to check the ring geometry
+  #define RING_FRAME_SIZE 2048u
+
+  //----------------------------------------------------------------------------
+  // function prototypes
+  //----------------------------------------------------------------------------
+  static std::runtime_error errnoError(const std::string & what);
+
+  //----------------------------------------------------------------------------
+  // function implementation
+  //----------------------------------------------------------------------------
+  static std::runtime_error errnoError(const std::string & what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+  }
+
+  //----------------------------------------------------------------------------
+  int linkType(const std::string & devName) {
+    return (devName == "any") ? LINKTYPE_LINUX_SLL : LINKTYPE_ETHERNET;
+  }
+
+  //----------------------------------------------------------------------------
+  const sockaddr_ll & packetAddress(const tpacket3_hdr & header) {
+    return *reinterpret_cast<const sockaddr_ll*>(reinterpret_cast<const std::uint8_t*>(&header) +
+                                                 TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+  }
+
+  //----------------------------------------------------------------------------
+  RingCapture::~RingCapture() {
+    Close();
+  }
+
+  //----------------------------------------------------------------------------
+  void RingCapture::Open(const std::string & devName,
+                         const ring_config_t & ringConfig,
+                         const std::vector<sock_filter> & program) {
+    Close();
+
+    config = ringConfig;
+    cooked = (LINKTYPE_LINUX_SLL == linkType(devName));
+
+    auto pageSize = static_cast<std::uint32_t>(sysconf(_SC_PAGESIZE));
+    config.blockSize = ((config.blockSize + pageSize - 1u) / pageSize) * pageSize;
+    if((config.blockSize < RING_FRAME_SIZE) || (config.blockCount < 2u)) {
+      throw std::invalid_argument("ring needs at least two blocks of one page");
+    }
+
+    unsigned int ifIndex = 0;
+    if(!cooked) {
+      ifIndex = if_nametoindex(devName.c_str());
+      if(0 == ifIndex) {
+        throw std::invalid_argument("unknown interface " + devName);
+      }
+    }
+
+    // the protocol is set with bind() after the ring and the filter are ready,
+    // so no unfiltered packets end up in the ring
+    fd = socket(AF_PACKET, (cooked ? SOCK_DGRAM : SOCK_RAW) | SOCK_CLOEXEC, 0);
+    if(fd < 0) {
+      throw errnoError("cannot open packet socket");
+    }
+
+    int version = TPACKET_V3;
+    if(0 != setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version))) {
+      Close();
+      throw errnoError("TPACKET_V3 not supported");
+    }
+
+    tpacket_req3 req {};
+    req.tp_block_size = config.blockSize;
+    req.tp_block_nr = config.blockCount;
+    req.tp_frame_size = RING_FRAME_SIZE;
+    req.tp_frame_nr = (config.blockSize / RING_FRAME_SIZE) * config.blockCount;
+    req.tp_retire_blk_tov = config.blockTimeout;
+    req.tp_feature_req_word = 0;
+    if(0 != setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req))) {
+      Close();
+      throw errnoError("cannot create packet ring");
+    }
+
+    ringSize = static_cast<std::size_t>(config.blockSize) * config.blockCount;
+    void * pMap = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, fd, 0);
+    if(MAP_FAILED == pMap) {
+      // locking may be denied by RLIMIT_MEMLOCK, the ring works without it
+      pMap = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if(MAP_FAILED == pMap) {
+      ringSize = 0;
+      Close();
+      throw errnoError("cannot map packet ring");
+    }
+    pRing = static_cast<std::uint8_t*>(pMap);
+
+    try {
+      SetFilter(program);
+    }
+    catch(...) {
+      Close();
+      throw;
+    }
+
+    if(!cooked) {
+      packet_mreq mreq {};
+      mreq.mr_ifindex = static_cast<int>(ifIndex);
+      mreq.mr_type = PACKET_MR_PROMISC;
+      if(0 != setsockopt(fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(mreq))) {
+        Debug_Printf("cannot enable promiscuous mode: %s \n", std::strerror(errno));
+      }
+    }
+
+    sockaddr_ll addr {};
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ALL);
+    addr.sll_ifindex = static_cast<int>(ifIndex);
+    if(0 != bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))) {
+      Close();
+      throw errnoError("cannot bind packet socket to " + devName);
+    }
+
+    Debug_Printf("ring: blockSize=%u blockCount=%u blockTimeout=%u \n",
+                 config.blockSize, config.blockCount, config.blockTimeout);
+  }
+
+  //----------------------------------------------------------------------------
+  void RingCapture::SetFilter(const std::vector<sock_filter> & program) {
+    std::vector<sock_filter> insns;
+    // without filter the whole packet would be copied, cut it to the snap length right in the kernel
+    if(program.empty()) {
+      insns.push_back(sock_filter{BPF_RET | BPF_K, 0, 0, config.snapLength});
+    }
+    // the program is compiled for complete frames, a frame whose VLAN tag the kernel moved to the
+    // packet metadata would be checked at the wrong offsets: let it pass, the writer filters it
+    else {
+      insns.push_back(sock_filter{BPF_LD | BPF_B | BPF_ABS, 0, 0,
+                                  static_cast<std::uint32_t>(SKF_AD_OFF + SKF_AD_VLAN_TAG_PRESENT)});
+      insns.push_back(sock_filter{BPF_JMP | BPF_JEQ | BPF_K, 1, 0, 0});
+      insns.push_back(sock_filter{BPF_RET | BPF_K, 0, 0, config.snapLength});
+      insns.insert(insns.end(), program.begin(), program.end());
+    }
+
+    sock_fprog prog {};
+    prog.len = static_cast<unsigned short>(insns.size());
+    prog.filter = insns.data();
+    if(0 != setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog))) {
+      throw errnoError("cannot attach packet filter");
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void RingCapture::Close() {
+    if(nullptr != pRing) {
+      munmap(pRing, ringSize);
+      pRing = nullptr;
+      ringSize = 0;
+    }
+    if(fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+    current = 0;
+    inflight = 0;
+    stats = ring_stats_t {};
+  }
+
+  //----------------------------------------------------------------------------
+  int RingCapture::LinkType() const {
+    return cooked ? LINKTYPE_LINUX_SLL : LINKTYPE_ETHERNET;
+  }
+
+  //----------------------------------------------------------------------------
+  std::uint16_t RingCapture::SnapLength() const {
+    return config.snapLength;
+  }
+
+  //----------------------------------------------------------------------------
+  tpacket_block_desc * RingCapture::Block(std::uint32_t index) const {
+    return reinterpret_cast<tpacket_block_desc*>(pRing + static_cast<std::size_t>(index) * config.blockSize);
+  }
+
+  //----------------------------------------------------------------------------
+  tpacket_block_desc * RingCapture::Next(int timeout) {
+    if(nullptr == pRing) {
+      return nullptr;
+    }
+
+    // all blocks are handed out, the kernel has no room left until one is released
+    if(inflight.load(std::memory_order_acquire) >= config.blockCount) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(std::min(timeout, 1)));
+      return nullptr;
+    }
+
+    tpacket_block_desc * pBlock = Block(current);
+    if(0 == (__atomic_load_n(&pBlock->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER)) {
+      pollfd pfd {fd, POLLIN | POLLERR, 0};
+      if((poll(&pfd, 1, timeout) < 0) && (errno != EINTR)) {
+        throw errnoError("cannot poll packet socket");
+      }
+      if(0 == (__atomic_load_n(&pBlock->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER)) {
+        return nullptr;
+      }
+    }
+
+    current = (current + 1u) % config.blockCount;
+    inflight.fetch_add(1u, std::memory_order_acq_rel);
+    return pBlock;
+  }
+
+  //----------------------------------------------------------------------------
+  void RingCapture::Release(tpacket_block_desc * pBlock) {
+    __atomic_store_n(&pBlock->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    inflight.fetch_sub(1u, std::memory_order_acq_rel);
+  }
+
+  //----------------------------------------------------------------------------
+  ring_stats_t RingCapture::Stats() {
+    if(fd >= 0) {
+      // the kernel resets its counters with each read
+      tpacket_stats_v3 kernelStats {};
+      socklen_t len = sizeof(kernelStats);
+      if(0 == getsockopt(fd, SOL_PACKET, PACKET_STATISTICS, &kernelStats, &len)) {
+        stats.packets += kernelStats.tp_packets;
+        stats.drops += kernelStats.tp_drops;
+        stats.freezes += kernelStats.tp_freeze_q_cnt;
+      }
+    }
+    return stats;
+  }
+
+  //----------------------------------------------------------------------------
+} /* namespace wp */
+//---- End of source file ------------------------------------------------------
@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file     wp_ring.hpp
+///
+///  \brief    Packet capture by a TPACKET_V3 ring memory-mapped from the kernel.
+///
+///  \author   <author> : WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+#ifndef SRC_WAGO_PCAP_WP_RING_HPP_
+#define SRC_WAGO_PCAP_WP_RING_HPP_
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include <linux/filter.h>
+#include <linux/if_packet.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+namespace wp {
+  //----------------------------------------------------------------------------
+  // defines; structure, enumeration and type definitions
+  //----------------------------------------------------------------------------
+  // link types of the capture files, same values as DLT_EN10MB and DLT_LINUX_SLL
+  #define LINKTYPE_ETHERNET 1
+  #define LINKTYPE_LINUX_SLL 113
+
+  // length of the cooked header written in front of the packets captured on "any"
+  #define SLL_HEADER_LEN 16
+
+  // length of the 802.1Q header the kernel strips from the received frames
+  #define VLAN_TAG_LEN 4
+
+  //----------------------------------------------------------------------------
+  struct ring_config_t {
+      std::uint32_t blockSize;      // bytes, rounded up to a multiple of the page size
+      std::uint32_t blockCount;
+      std::uint32_t blockTimeout;   // milliseconds until the kernel hands out a partially filled block
+      std::uint16_t snapLength;
+  };
+
+  //----------------------------------------------------------------------------
+  struct ring_stats_t {
+      std::uint64_t packets {0u};   // packets accepted by the filter, including the dropped ones
+      std::uint64_t drops {0u};     // packets dropped because the ring was full
+      std::uint64_t freezes {0u};   // times the ring was completely full
+  };
+
+  //----------------------------------------------------------------------------
+  // classes
+  //----------------------------------------------------------------------------
+  /// The kernel fills the blocks of the ring, Next() hands out the filled blocks
+  /// in order and Release() gives them back. Next() and Release() may be called
+  /// from different threads, each of them from one thread only.
+  class RingCapture {
+    private:
+      int fd = -1;
+      std::uint8_t * pRing = nullptr;
+      std::size_t ringSize = 0;
+      ring_config_t config {};
+      bool cooked = false;
+      std::uint32_t current = 0;
+      std::atomic<std::uint32_t> inflight {0u};
+      ring_stats_t stats;
+
+      tpacket_block_desc * Block(std::uint32_t index) const;
+      void SetFilter(const std::vector<sock_filter> & program);
+
+    public:
+      RingCapture() = default;
+      ~RingCapture();
+      RingCapture(const RingCapture & other) = delete;
+      RingCapture & operator = (const RingCapture & other) = delete;
+
+      /// Device "any" captures on all interfaces in cooked mode (link type LINUX_SLL).
+      /// The filter program is attached before the socket starts to capture, without
+      /// program the packets are only cut to the snap length.
+      /// The program does not see the VLAN tags the kernel stripped from the frames, such frames
+      /// pass unfiltered and have to be filtered after the tag was put back, see CaptureWriter.
+      void Open(const std::string & devName,
+                const ring_config_t & ringConfig,
+                const std::vector<sock_filter> & program = {});
+      void Close();
+
+      int LinkType() const;
+      std::uint16_t SnapLength() const;
+
+      /// Wait up to timeout milliseconds for the next filled block, nullptr if there is none
+      tpacket_block_desc * Next(int timeout);
+      void Release(tpacket_block_desc * pBlock);
+
+      /// Counters since Open(), the drops are the ones of the kernel
+      ring_stats_t Stats();
+  };
+
+  //----------------------------------------------------------------------------
+  /// Call func(header, data) for each packet of a block handed out by RingCapture::Next()
+  template <class F>
+  void forEachPacket(const tpacket_block_desc * pBlock, F && func) {
+    auto pBase = reinterpret_cast<const std::uint8_t*>(pBlock);
+    auto offset = pBlock->hdr.bh1.offset_to_first_pkt;
+    for(std::uint32_t i = 0; i < pBlock->hdr.bh1.num_pkts; i++) {
+      auto pHeader = reinterpret_cast<const tpacket3_hdr*>(pBase + offset);
+      func(*pHeader, pBase + offset + pHeader->tp_mac);
+      offset += pHeader->tp_next_offset;
+    }
+  }
+
+  /// Link type the packets of a device are captured with, see RingCapture::Open()
+  int linkType(const std::string & devName);
+
+  /// The link layer information the kernel stores behind the header of each packet
+  const sockaddr_ll & packetAddress(const tpacket3_hdr & header);
+
+  //----------------------------------------------------------------------------
+} /* namespace wp */
+//------------------------------------------------------------------------------
+#endif /* SRC_WAGO_PCAP_WP_RING_HPP_ */
+//---- End of source file ------------------------------------------------------
@@ -92,6 +92,26 @@ bool PcapSniffer::CompileFilter(const std::string & filter, std::uint16_t snapLe
   return result;
 }
 
+//------------------------------------------------------------------------------
+void PcapSniffer::CompileProgram(const std::string & filter, int linkType, std::uint16_t snapLength, bpf_program * pProg)
+{
+  pcap_t * tmp_handle = pcap_open_dead(linkType, snapLength);
+  if (tmp_handle == nullptr)
+  {
+    throw std::invalid_argument("cannot compile filter");
+  }
+
+  if (pcap_compile(tmp_handle, pProg, filter.c_str(), optimize, PCAP_NETMASK_UNKNOWN) != 0)
+  {
+    std::string error = pcap_geterr(tmp_handle);
+    pcap_close(tmp_handle);
+    throw std::invalid_argument(error);
+  }
+
+  pcap_close(tmp_handle);
+}
+
+//------------------------------------------------------------------------------
 void PcapSniffer::SetFilter(const std::string & filter) {
   if((nullptr != pHandle) && (!filter.empty()))
   {
@@ -70,6 +70,8 @@ class PcapSniffer
     PcapSniffer & operator = (const PcapSniffer &&) = delete;
 
     bool CompileFilter(const std::string & filter, std::uint16_t snapLength);
+    /// Compile a filter for the capture ring, release the program with pcap_freecode()
+    void CompileProgram(const std::string & filter, int linkType, std::uint16_t snapLength, bpf_program * pProg);
 
     void OpenLive(const std::string & devName, std::uint16_t snapLength);
     void OpenDump(const std::filesystem::path & path);
@@ -0,0 +1,415 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file     wp_writer.cpp
+///
+///  \brief    Writer thread saving the blocks of the capture ring to pcap files.
+///
+///  \author   <author> : WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <stdio_ext.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "wp_writer.hpp"
+#include "wp_debug.hpp"
+#include "wp_util.hpp"
+
+//------------------------------------------------------------------------------
+namespace wp {
+  //----------------------------------------------------------------------------
+  // defines; structure, enumeration and type definitions
+  //----------------------------------------------------------------------------
+  #define PCAP_MAGIC 0xa1b2c3d4u
+  #define PCAP_VERSION_MAJOR 2u
+  #define PCAP_VERSION_MINOR 4u
+
+  // stdio buffer of the capture file, a block is flushed at once after it is written
+  #define FILE_BUFFER_SIZE (256u * 1024u)
+  #define COMPRESS_CHUNK_SIZE (64u * 1024u)
+
+  //----------------------------------------------------------------------------
+  struct pcap_file_header_t {
+      std::uint32_t magic;
+      std::uint16_t versionMajor;
+      std::uint16_t versionMinor;
+      std::int32_t thiszone;
+      std::uint32_t sigfigs;
+      std::uint32_t snaplen;
+      std::uint32_t linktype;
+  };
+
+  struct pcap_record_header_t {
+      std::uint32_t tsSec;
+      std::uint32_t tsUsec;
+      std::uint32_t inclLen;
+      std::uint32_t origLen;
+  };
+
+  struct sll_header_t {
+      std::uint16_t pkttype;
+      std::uint16_t hatype;
+      std::uint16_t halen;
+      std::uint8_t addr[8];
+      std::uint16_t protocol;
+  } __attribute__((packed));
+
+  static_assert(sizeof(sll_header_t) == SLL_HEADER_LEN, "cooked header has to match the link type");
+
+  //----------------------------------------------------------------------------
+  // function implementation
+  //----------------------------------------------------------------------------
+  bool compressFile(const std::filesystem::path & path) {
+    std::filesystem::path compressed = path;
+    compressed += COMPRESSED_EXTENSION;
+
+    std::FILE * pIn = std::fopen(path.c_str(), "rb");
+    if(nullptr == pIn) {
+      return false;
+    }
+    gzFile out = gzopen(compressed.c_str(), "wb6");
+    if(nullptr == out) {
+      std::fclose(pIn);
+      return false;
+    }
+
+    std::vector<char> chunk(COMPRESS_CHUNK_SIZE);
+    bool result = true;
+    std::size_t length;
+    while((length = std::fread(chunk.data(), 1, chunk.size(), pIn)) > 0) {
+      if(gzwrite(out, chunk.data(), static_cast<unsigned int>(length)) != static_cast<int>(length)) {
+        result = false;
+        break;
+      }
+    }
+    result = result && (0 == std::ferror(pIn));
+    std::fclose(pIn);
+    result = (Z_OK == gzclose(out)) && result;
+
+    std::error_code ec;
+    if(result) {
+      std::filesystem::permissions(compressed, get_allowed_permissions(), ec);
+      set_owner_group_webserver(compressed);
+    }
+    // the original may have been removed by the rotation meanwhile, then the compressed one is obsolete too
+    if(!result || !std::filesystem::remove(path, ec)) {
+      std::filesystem::remove(compressed, ec);
+      return false;
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  CaptureWriter::CaptureWriter(RingCapture & captureRing,
+                               const writer_config_t & writerConfig,
+                               next_file_func nextFileFunc)
+  : ring(captureRing),
+    config(writerConfig),
+    nextFile(std::move(nextFileFunc)),
+    fileBuffer(FILE_BUFFER_SIZE) {
+  }
+
+  //----------------------------------------------------------------------------
+  CaptureWriter::~CaptureWriter() {
+    Stop();
+  }
+
+  //----------------------------------------------------------------------------
+  void CaptureWriter::SetUserFilter(packet_filter_func filter) {
+    userFilter = std::move(filter);
+  }
+
+  //----------------------------------------------------------------------------
+  void CaptureWriter::OpenFile(const std::filesystem::path & path) {
+    std::FILE * pNew = std::fopen(path.c_str(), "wb");
+    if(nullptr == pNew) {
+      throw std::runtime_error("cannot create savefile " + path.string() + ": " + std::strerror(errno));
+    }
+    std::setvbuf(pNew, fileBuffer.data(), _IOFBF, fileBuffer.size());
+
+    auto cooked = (LINKTYPE_LINUX_SLL == ring.LinkType());
+    pcap_file_header_t header {};
+    header.magic = PCAP_MAGIC;
+    header.versionMajor = PCAP_VERSION_MAJOR;
+    header.versionMinor = PCAP_VERSION_MINOR;
+    header.snaplen = ring.SnapLength() + (cooked ? SLL_HEADER_LEN : 0u);
+    header.linktype = static_cast<std::uint32_t>(ring.LinkType());
+    if(1 != std::fwrite(&header, sizeof(header), 1, pNew)) {
+      std::fclose(pNew);
+      throw std::runtime_error("cannot write savefile " + path.string());
+    }
+    std::fflush(pNew);
+
+    // same permissions as the files written by libpcap before
+    std::error_code ec;
+    std::filesystem::permissions(path, get_allowed_permissions(), ec);
+    set_owner_group_webserver(path);
+
+    std::lock_guard<std::mutex> guard(lock);
+    pFile = pNew;
+    savefile = path;
+    fileSize = sizeof(header);
+    flushedSize = fileSize;
+    Debug_Printf("savefile=%s \n", savefile.c_str());
+  }
+
+  //----------------------------------------------------------------------------
+  void CaptureWriter::CloseFile() {
+    if(nullptr != pFile) {
+      std::fclose(pFile);
+      pFile = nullptr;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void CaptureWriter::DiscardUnflushed() {
+    // a partially written record would make the rest of the file unreadable, the file
+    // is cut back to the last complete block
+    __fpurge(pFile);
+    if(0 != ftruncate(fileno(pFile), static_cast<off_t>(flushedSize))) {
+      Debug_Printf("truncate savefile failed: %s \n", std::strerror(errno));
+    }
+    std::fseek(pFile, 0, SEEK_END);
+    fileSize = flushedSize;
+  }
+
+  //----------------------------------------------------------------------------
+  bool CaptureWriter::WritePacket(const tpacket3_hdr & header, const std::uint8_t * pData) {
+    auto cooked = (LINKTYPE_LINUX_SLL == ring.LinkType());
+    auto snapLength = static_cast<std::uint32_t>(ring.SnapLength());
+    auto caplen = std::min(header.tp_snaplen, snapLength);
+    auto len = header.tp_len;
+    const std::uint8_t * pPacket = pData;
+
+    // the kernel moves the 802.1Q header of received frames to the ring header, put it back in
+    // front of the ethertype (the protocol of the cooked header) like libpcap does
+    auto tagged = ((0u != header.hv1.tp_vlan_tci) || (0u != (header.tp_status & TP_STATUS_VLAN_VALID))) &&
+                  (cooked || (caplen >= 2u * ETH_ALEN));
+
+    thread_local std::vector<std::uint8_t> packet;
+    if(cooked || tagged) {
+      std::uint32_t linkHeaderLen = cooked ? SLL_HEADER_LEN : 0u;
+      packet.resize(linkHeaderLen + caplen);
+
+      // on "any" the kernel delivers the packets without link layer header, add the cooked one
+      if(cooked) {
+        const sockaddr_ll & addr = packetAddress(header);
+        sll_header_t sll {};
+        sll.pkttype = htons(addr.sll_pkttype);
+        sll.hatype = htons(addr.sll_hatype);
+        sll.halen = htons(addr.sll_halen);
+        std::memcpy(&sll.addr[0], &addr.sll_addr[0], std::min<std::size_t>(addr.sll_halen, sizeof(sll.addr)));
+        sll.protocol = addr.sll_protocol;
+        std::memcpy(packet.data(), &sll, SLL_HEADER_LEN);
+      }
+      std::memcpy(packet.data() + linkHeaderLen, pData, caplen);
+      caplen += linkHeaderLen;
+      len += linkHeaderLen;
+
+      if(tagged) {
+        auto tpid = ((0u != header.hv1.tp_vlan_tpid) || (0u != (header.tp_status & TP_STATUS_VLAN_TPID_VALID)))
+                    ? header.hv1.tp_vlan_tpid
+                    : static_cast<std::uint16_t>(ETH_P_8021Q);
+        std::uint16_t tag[2] = {htons(tpid), htons(static_cast<std::uint16_t>(header.hv1.tp_vlan_tci))};
+        auto offset = cooked ? (SLL_HEADER_LEN - sizeof(sll_header_t::protocol)) : (2u * ETH_ALEN);
+        auto pTag = reinterpret_cast<const std::uint8_t*>(&tag[0]);
+        packet.insert(packet.begin() + static_cast<std::ptrdiff_t>(offset), pTag, pTag + VLAN_TAG_LEN);
+        // the record stays within the snap length of the file
+        caplen = std::min(caplen + VLAN_TAG_LEN, snapLength + linkHeaderLen);
+        len += VLAN_TAG_LEN;
+      }
+      pPacket = packet.data();
+    }
+
+    // the kernel filtered all other packets already, see RingCapture::Open()
+    if((cooked || tagged) && userFilter && !userFilter(pPacket, caplen, len)) {
+      return false;
+    }
+
+    pcap_record_header_t record {};
+    record.tsSec = header.tp_sec;
+    record.tsUsec = header.tp_nsec / 1000u;
+    record.inclLen = caplen;
+    record.origLen = len;
+    if((1 != std::fwrite(&record, sizeof(record), 1, pFile)) ||
+       (caplen != std::fwrite(pPacket, 1, caplen, pFile))) {
+      throw std::runtime_error("cannot write savefile " + savefile.string() + ": " + std::strerror(errno));
+    }
+    fileSize += sizeof(record) + caplen;
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  void CaptureWriter::WriteBlock(const tpacket_block_desc * pBlock) {
+    if((nullptr == pFile) || limitReached) {
+      return;
+    }
+
+    // on a short write the capture stops, see WriterLoop()
+    std::uint64_t written = 0;
+    try {
+      forEachPacket(pBlock, [this, &written](const tpacket3_hdr & header, const std::uint8_t * pData) {
+        if(WritePacket(header, pData)) {
+          written++;
+        }
+      });
+      if(0 != std::fflush(pFile)) {
+        throw std::runtime_error("cannot write savefile " + savefile.string() + ": " + std::strerror(errno));
+      }
+    }
+    catch(...) {
+      DiscardUnflushed();
+      throw;
+    }
+    flushedSize = fileSize;
+    packets.fetch_add(written, std::memory_order_relaxed);
+
+    if(fileSize >= config.maxFilesize) {
+      if(config.rotateFiles) {
+        Rotate();
+      }
+      else {
+        limitReached = true;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void CaptureWriter::Rotate() {
+    Debug_Printf("Reached maximum filesize, continue with next file\n");
+    std::filesystem::path finished = savefile;
+    CloseFile();
+
+    if(config.compressFiles) {
+      std::lock_guard<std::mutex> guard(compressLock);
+      finishedFiles.push_back(finished);
+      compressReady.notify_one();
+    }
+
+    OpenFile(nextFile());
+  }
+
+  //----------------------------------------------------------------------------
+  void CaptureWriter::WriterLoop() {
+    std::unique_lock<std::mutex> guard(lock);
+    while(true) {
+      blockReady.wait(guard, [this] { return stopping || !blocks.empty(); });
+      if(blocks.empty()) {
+        break;
+      }
+
+      tpacket_block_desc * pBlock = blocks.front();
+      blocks.pop_front();
+      guard.unlock();
+
+      try {
+        WriteBlock(pBlock);
+      }
+      catch(std::exception & e) {
+        // no file to write to anymore or the file system is full, the capture loop ends by LimitReached()
+        Debug_Printf("%s \n", e.what());
+        limitReached = true;
+      }
+      ring.Release(pBlock);
+
+      guard.lock();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void CaptureWriter::CompressLoop() {
+    std::unique_lock<std::mutex> guard(compressLock);
+    while(true) {
+      compressReady.wait(guard, [this] { return compressStopping || !finishedFiles.empty(); });
+      if(finishedFiles.empty()) {
+        break;
+      }
+
+      std::filesystem::path path = finishedFiles.front();
+      finishedFiles.pop_front();
+      guard.unlock();
+
+      if(!compressFile(path)) {
+        Debug_Printf("compress %s failed \n", path.c_str());
+      }
+
+      guard.lock();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void CaptureWriter::Start(const std::filesystem::path & firstFile) {
+    OpenFile(firstFile);
+    stopping = false;
+    compressStopping = false;
+    writerThread = std::thread(&CaptureWriter::WriterLoop, this);
+    if(config.compressFiles) {
+      compressThread = std::thread(&CaptureWriter::CompressLoop, this);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void CaptureWriter::Stop() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stopping = true;
+      blockReady.notify_one();
+    }
+    if(writerThread.joinable()) {
+      writerThread.join();
+    }
+    CloseFile();
+
+    {
+      std::lock_guard<std::mutex> guard(compressLock);
+      compressStopping = true;
+      compressReady.notify_one();
+    }
+    if(compressThread.joinable()) {
+      compressThread.join();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void CaptureWriter::Push(tpacket_block_desc * pBlock) {
+    std::lock_guard<std::mutex> guard(lock);
+    blocks.push_back(pBlock);
+    blockReady.notify_one();
+  }
+
+  //----------------------------------------------------------------------------
+  std::filesystem::path CaptureWriter::Savefile() {
+    std::lock_guard<std::mutex> guard(lock);
+    return savefile;
+  }
+
+  //----------------------------------------------------------------------------
+  std::uint64_t CaptureWriter::Packets() const {
+    return packets.load(std::memory_order_relaxed);
+  }
+
+  //----------------------------------------------------------------------------
+  bool CaptureWriter::LimitReached() const {
+    return limitReached;
+  }
+
+  //----------------------------------------------------------------------------
+} /* namespace wp */
+//---- End of source file ------------------------------------------------------
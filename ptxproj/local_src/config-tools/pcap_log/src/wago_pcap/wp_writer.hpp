@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file     wp_writer.hpp
+///
+///  \brief    Writer thread saving the blocks of the capture ring to pcap files.
+///
+///  \author   <author> : WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+#ifndef SRC_WAGO_PCAP_WP_WRITER_HPP_
+#define SRC_WAGO_PCAP_WP_WRITER_HPP_
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "wp_ring.hpp"
+
+//------------------------------------------------------------------------------
+namespace wp {
+  //----------------------------------------------------------------------------
+  // defines; structure, enumeration and type definitions
+  //----------------------------------------------------------------------------
+  #define COMPRESSED_EXTENSION ".gz"
+
+  //----------------------------------------------------------------------------
+  struct writer_config_t {
+      std::uintmax_t maxFilesize;
+      bool rotateFiles;
+      bool compressFiles;
+  };
+
+  // returns the path of the next capture file, called on rotation
+  using next_file_func = std::function<std::filesystem::path()>;
+
+  // filter applied by the writer for packets the kernel could not filter: all packets on "any" and the
+  // packets with a VLAN tag stripped by the kernel, data includes the link layer header and the VLAN tag
+  using packet_filter_func = std::function<bool(const std::uint8_t * data,
+                                                std::uint32_t caplen,
+                                                std::uint32_t len)>;
+
+  //----------------------------------------------------------------------------
+  // function prototypes
+  //----------------------------------------------------------------------------
+  /// Compress a file to <path>.gz and remove it afterwards
+  bool compressFile(const std::filesystem::path & path);
+
+  //----------------------------------------------------------------------------
+  // classes
+  //----------------------------------------------------------------------------
+  /// Takes the blocks handed out by the ring, writes their packets and gives
+  /// them back to the ring. File rotation happens on the writer thread, finished
+  /// files are compressed on a helper thread, so the capture thread only polls
+  /// the ring.
+  class CaptureWriter {
+    private:
+      RingCapture & ring;
+      writer_config_t config;
+      next_file_func nextFile;
+      packet_filter_func userFilter;
+
+      std::FILE * pFile = nullptr;
+      std::vector<char> fileBuffer;
+      std::filesystem::path savefile;
+      std::uintmax_t fileSize = 0;
+      std::uintmax_t flushedSize = 0;
+
+      std::mutex lock;
+      std::condition_variable blockReady;
+      std::deque<tpacket_block_desc*> blocks;
+      bool stopping = false;
+      std::thread writerThread;
+
+      std::mutex compressLock;
+      std::condition_variable compressReady;
+      std::deque<std::filesystem::path> finishedFiles;
+      bool compressStopping = false;
+      std::thread compressThread;
+
+      std::atomic<std::uint64_t> packets {0u};
+      std::atomic<bool> limitReached {false};
+
+      void OpenFile(const std::filesystem::path & path);
+      void CloseFile();
+      void DiscardUnflushed();
+      void WriteBlock(const tpacket_block_desc * pBlock);
+      bool WritePacket(const tpacket3_hdr & header, const std::uint8_t * pData);
+      void Rotate();
+      void WriterLoop();
+      void CompressLoop();
+
+    public:
+      CaptureWriter(RingCapture & captureRing,
+                    const writer_config_t & writerConfig,
+                    next_file_func nextFileFunc);
+      ~CaptureWriter();
+      CaptureWriter(const CaptureWriter & other) = delete;
+      CaptureWriter & operator = (const CaptureWriter & other) = delete;
+
+      void SetUserFilter(packet_filter_func filter);
+
+      /// Open the first file and start the threads
+      void Start(const std::filesystem::path & firstFile);
+      /// Write the queued blocks, close the current file and stop the threads
+      void Stop();
+
+      /// Queue a block handed out by RingCapture::Next()
+      void Push(tpacket_block_desc * pBlock);
+
+      std::filesystem::path Savefile();
+      std::uint64_t Packets() const;
+      /// The file reached its maximum size and rotation is disabled, or the file cannot be written
+      bool LimitReached() const;
+  };
+
+  //----------------------------------------------------------------------------
+} /* namespace wp */
+//------------------------------------------------------------------------------
+#endif /* SRC_WAGO_PCAP_WP_WRITER_HPP_ */
+//---- End of source file ------------------------------------------------------
@@ -23,8 +23,8 @@
 //------------------------------------------------------------------------------
 // defines; structure, enumeration and type definitions
 //------------------------------------------------------------------------------
-#define TEST_JSON_CONFIG_STR R"({"device":"br0","filter":"","maxFilesize":52428800,"maxPacketLen":2048,"maxPartitionSizePct":60,"rotateFiles":true,"storage":"RAM Disk"})"
-#define TEST_JSON_INFO_STR R"({"isRunning":false,"lastFSize":0,"lastPid":0,"lastRecv":0,"lastRfshTime":"","optDevices":["br0"],"optDlPaths":[],"optMemCard":false})"
+#define TEST_JSON_CONFIG_STR R"({"blockCount":8,"blockSize":262144,"compressFiles":false,"device":"br0","filter":"","maxFilesize":52428800,"maxPacketLen":2048,"maxPartitionSizePct":60,"rotateFiles":true,"storage":"RAM Disk"})"
+#define TEST_JSON_INFO_STR R"({"isRunning":false,"lastDrops":0,"lastFSize":0,"lastFreezes":0,"lastPid":0,"lastRecv":0,"lastRfshTime":"","optDevices":["br0"],"optDlPaths":[],"optMemCard":false})"
 
 using namespace testing;
 //------------------------------------------------------------------------------
@@ -122,6 +122,9 @@ TEST_F(wp_parameter, config_parameter_data_default)
   ASSERT_EQ(DFLT_STORAGE, config.data.storage);
   ASSERT_EQ(DFLT_MAX_FILE_SIZE, config.data.maxFilesize);
   ASSERT_EQ(DFLT_ROTATE_FILES, config.data.rotateFiles);
+  ASSERT_EQ(DFLT_BLOCK_SIZE, config.data.blockSize);
+  ASSERT_EQ(DFLT_BLOCK_COUNT, config.data.blockCount);
+  ASSERT_EQ(DFLT_COMPRESS_FILES, config.data.compressFiles);
 }
 
 TEST_F(wp_parameter, info_parameter_data_default)
@@ -130,6 +133,8 @@ TEST_F(wp_parameter, info_parameter_data_default)
   ASSERT_EQ(0, info.data.lastPid);
   ASSERT_EQ(0, info.data.lastRecv);
   ASSERT_EQ(0, info.data.lastFSize);
+  ASSERT_EQ(0, info.data.lastDrops);
+  ASSERT_EQ(0, info.data.lastFreezes);
   ASSERT_TRUE(info.data.optDlPaths.empty());
   ASSERT_STREQ(DFLT_EMPTY_STR, info.data.lastRfshTime.c_str());
   ASSERT_EQ(DFLT_SD, info.data.optMemCard);
@@ -147,5 +152,12 @@ TEST_F(wp_parameter, info_parameter_json_default)
   ASSERT_STREQ(TEST_JSON_INFO_STR, info.json().dump().c_str());
 }
 
+TEST_F(wp_parameter, isCompressedPcapFile)
+{
+  ASSERT_TRUE(wp::isCompressedPcapFile("/var/tmp/pcap/log_2022-01-01_00-00-00.pcap.gz"));
+  ASSERT_FALSE(wp::isCompressedPcapFile("/var/tmp/pcap/log_2022-01-01_00-00-00.pcap"));
+  ASSERT_FALSE(wp::isCompressedPcapFile("/var/tmp/pcap/network_capture_logs.tar.gz"));
+}
+
 //---- End of source file ------------------------------------------------------
 
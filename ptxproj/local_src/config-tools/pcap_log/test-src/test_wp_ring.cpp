@@ -0,0 +1,436 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file     test_wp_ring.cpp
+///
+///  \brief    Capture ring and writer thread: filtering, write errors, throughput.
+///
+///  \author   <author> : WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <net/if.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include "wp_ring.hpp"
+#include "wp_writer.hpp"
+
+//------------------------------------------------------------------------------
+// defines; structure, enumeration and type definitions
+//------------------------------------------------------------------------------
+#define TEST_ETHERTYPE 0x88b5 // local experimental ethertypes
+#define OTHER_ETHERTYPE 0x88b6
+#define TEST_VLAN_ID 42
+#define TEST_FRAME_LEN 512
+#define TEST_FRAME_COUNT 200000
+#define TEST_SNAP_LEN 2048
+#define TEST_VETH_RX "wpcaprx"
+#define TEST_VETH_TX "wpcaptx"
+#define TEST_FILE_LIMIT (64u * 1024u)
+#define PCAP_FILE_HEADER_LEN 24u
+#define PCAP_RECORD_HEADER_LEN 16u
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// macros
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// variables' and constants' definitions
+//------------------------------------------------------------------------------
+using namespace testing;
+
+//------------------------------------------------------------------------------
+// function implementation
+//------------------------------------------------------------------------------
+class wp_ring : public ::testing::Test {
+  protected:
+    // interfaces of the private network namespace, empty if there is none
+    static std::string rxDevice;
+    static std::string txDevice;
+    std::filesystem::path dir;
+
+    static void SetUpTestSuite() {
+      // a private network namespace keeps the generated traffic away from the host
+      if((0 != geteuid()) || (0 != unshare(CLONE_NEWNET))) {
+        return;
+      }
+      if(0 == std::system("ip link add " TEST_VETH_RX " type veth peer name " TEST_VETH_TX " 2>/dev/null") &&
+         0 == std::system("ip link set " TEST_VETH_RX " up && ip link set " TEST_VETH_TX " up")) {
+        rxDevice = TEST_VETH_RX;
+        txDevice = TEST_VETH_TX;
+      }
+      // without veth support both ends are the loopback interface
+      else if(0 == std::system("ip link set lo up")) {
+        rxDevice = "lo";
+        txDevice = "lo";
+      }
+    }
+
+    void SetUp() override {
+      if(rxDevice.empty()) {
+        GTEST_SKIP() << "needs root to create a network namespace";
+      }
+      dir = std::filesystem::temp_directory_path() / ("test_wp_ring_" + std::to_string(getpid()));
+      std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override {
+      if(!dir.empty()) {
+        std::filesystem::remove_all(dir);
+      }
+    }
+
+    // send frames of the test ethertype on txDevice
+    static std::size_t Generate(std::size_t count, std::uint16_t ethertype = TEST_ETHERTYPE) {
+      int fd = socket(AF_PACKET, SOCK_RAW, 0);
+      if(fd < 0) {
+        return 0;
+      }
+      sockaddr_ll addr {};
+      addr.sll_family = AF_PACKET;
+      addr.sll_ifindex = static_cast<int>(if_nametoindex(txDevice.c_str()));
+      addr.sll_protocol = htons(ethertype);
+
+      std::uint8_t frame[TEST_FRAME_LEN] = {0};
+      std::memset(&frame[0], 0xff, 6);
+      frame[6] = 0x02;
+      frame[12] = static_cast<std::uint8_t>(ethertype >> 8);
+      frame[13] = static_cast<std::uint8_t>(ethertype & 0xff);
+
+      std::size_t sent = 0;
+      for(std::size_t i = 0; i < count; i++) {
+        std::memcpy(&frame[14], &i, sizeof(i));
+        if(sendto(fd, &frame[0], sizeof(frame), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == sizeof(frame)) {
+          sent++;
+        }
+      }
+      close(fd);
+      return sent;
+    }
+
+    // send frames of the test ethertype with an 802.1Q header on txDevice
+    static std::size_t GenerateTagged(std::size_t count) {
+      int fd = socket(AF_PACKET, SOCK_RAW, 0);
+      if(fd < 0) {
+        return 0;
+      }
+      sockaddr_ll addr {};
+      addr.sll_family = AF_PACKET;
+      addr.sll_ifindex = static_cast<int>(if_nametoindex(txDevice.c_str()));
+      addr.sll_protocol = htons(ETH_P_8021Q);
+
+      std::uint8_t frame[TEST_FRAME_LEN] = {0};
+      std::memset(&frame[0], 0xff, 6);
+      frame[6] = 0x02;
+      frame[12] = ETH_P_8021Q >> 8;
+      frame[13] = ETH_P_8021Q & 0xff;
+      frame[14] = TEST_VLAN_ID >> 8;
+      frame[15] = TEST_VLAN_ID & 0xff;
+      frame[16] = TEST_ETHERTYPE >> 8;
+      frame[17] = TEST_ETHERTYPE & 0xff;
+
+      std::size_t sent = 0;
+      for(std::size_t i = 0; i < count; i++) {
+        if(sendto(fd, &frame[0], sizeof(frame), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == sizeof(frame)) {
+          sent++;
+        }
+      }
+      close(fd);
+      return sent;
+    }
+
+    // filter for frames with an 802.1Q header, same as "vlan" compiled with pcap_open_dead()
+    static bool IsTagged(const std::uint8_t * data, std::uint32_t caplen) {
+      return (caplen >= 14u) && (ETH_P_8021Q == ((data[12] << 8) | data[13]));
+    }
+    static std::vector<sock_filter> VlanFilter() {
+      return {
+        sock_filter{BPF_LD | BPF_H | BPF_ABS, 0, 0, 12},
+        sock_filter{BPF_JMP | BPF_JEQ | BPF_K, 0, 1, ETH_P_8021Q},
+        sock_filter{BPF_RET | BPF_K, 0, 0, TEST_SNAP_LEN},
+        sock_filter{BPF_RET | BPF_K, 0, 0, 0},
+      };
+    }
+
+    // kernel filter for the test ethertype, same as "ether proto 0x88b5"
+    static std::vector<sock_filter> TestFilter() {
+      return {
+        sock_filter{BPF_LD | BPF_H | BPF_ABS, 0, 0, 12},
+        sock_filter{BPF_JMP | BPF_JEQ | BPF_K, 0, 1, TEST_ETHERTYPE},
+        sock_filter{BPF_RET | BPF_K, 0, 0, TEST_SNAP_LEN},
+        sock_filter{BPF_RET | BPF_K, 0, 0, 0},
+      };
+    }
+};
+
+std::string wp_ring::rxDevice;
+std::string wp_ring::txDevice;
+
+class wp_compress : public ::testing::Test {
+  protected:
+    std::filesystem::path dir;
+
+    void SetUp() override {
+      dir = std::filesystem::temp_directory_path() / ("test_wp_compress_" + std::to_string(getpid()));
+      std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override {
+      std::filesystem::remove_all(dir);
+    }
+};
+
+//------------------------------------------------------------------------------
+TEST_F(wp_ring, open_unknown_device)
+{
+  wp::RingCapture ring;
+  wp::ring_config_t ringConfig {64u * 1024u, 4, 10, TEST_SNAP_LEN};
+  ASSERT_THROW(ring.Open("wpcapnone", ringConfig), std::invalid_argument);
+}
+
+TEST_F(wp_ring, filter_applies_from_start)
+{
+  // frames of another ethertype are on the wire while the ring is opened
+  std::atomic<bool> generating {true};
+  std::thread generator([&generating]() {
+    while(generating) {
+      Generate(100, OTHER_ETHERTYPE);
+    }
+  });
+
+  // each ring is another chance for an unfiltered frame to slip in
+  std::array<wp::RingCapture, 8> rings;
+  wp::ring_config_t ringConfig {64u * 1024u, 4, 10, TEST_SNAP_LEN};
+  for(auto & ring : rings) {
+    ring.Open(rxDevice, ringConfig, TestFilter());
+  }
+  generating = false;
+  generator.join();
+  ASSERT_GT(Generate(10), 0u);
+
+  std::size_t matching = 0;
+  std::size_t other = 0;
+  for(auto & ring : rings) {
+    tpacket_block_desc * pBlock;
+    while(nullptr != (pBlock = ring.Next(50))) {
+      wp::forEachPacket(pBlock, [&matching, &other](const tpacket3_hdr &, const std::uint8_t * pData) {
+        if(TEST_ETHERTYPE == ((pData[12] << 8) | pData[13])) {
+          matching++;
+        }
+        else {
+          other++;
+        }
+      });
+      ring.Release(pBlock);
+    }
+    ring.Close();
+  }
+
+  EXPECT_GT(matching, 0u);
+  EXPECT_EQ(0u, other);
+}
+
+TEST_F(wp_ring, short_write_stops_capture)
+{
+  wp::RingCapture ring;
+  wp::ring_config_t ringConfig {64u * 1024u, 8, 10, TEST_SNAP_LEN};
+  ring.Open(rxDevice, ringConfig, TestFilter());
+
+  wp::writer_config_t writerConfig {4096u * 1024u, true, false};
+  wp::CaptureWriter writer(ring, writerConfig, [this]() { return dir / "next.pcap"; });
+  writer.Start(dir / "log.pcap");
+
+  // writes beyond the file size limit fail with EFBIG like on a full file system
+  rlimit oldLimit {};
+  getrlimit(RLIMIT_FSIZE, &oldLimit);
+  auto oldHandler = signal(SIGXFSZ, SIG_IGN);
+  rlimit limit {TEST_FILE_LIMIT, oldLimit.rlim_max};
+  setrlimit(RLIMIT_FSIZE, &limit);
+
+  Generate(4u * TEST_FILE_LIMIT / TEST_FRAME_LEN);
+  auto end = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while(!writer.LimitReached() && (std::chrono::steady_clock::now() < end)) {
+    tpacket_block_desc * pBlock = ring.Next(20);
+    if(nullptr != pBlock) {
+      writer.Push(pBlock);
+    }
+  }
+  writer.Stop();
+  ring.Close();
+
+  setrlimit(RLIMIT_FSIZE, &oldLimit);
+  signal(SIGXFSZ, oldHandler);
+
+  EXPECT_TRUE(writer.LimitReached());
+  EXPECT_FALSE(std::filesystem::exists(dir / "next.pcap"));
+
+  // the file ends with a complete record
+  std::ifstream file(dir / "log.pcap", std::ios::binary);
+  std::uintmax_t size = std::filesystem::file_size(dir / "log.pcap");
+  std::uintmax_t offset = PCAP_FILE_HEADER_LEN;
+  std::uint64_t records = 0;
+  while(offset < size) {
+    std::uint32_t inclLen = 0;
+    file.seekg(static_cast<std::streamoff>(offset + 8u));
+    file.read(reinterpret_cast<char*>(&inclLen), sizeof(inclLen));
+    offset += PCAP_RECORD_HEADER_LEN + inclLen;
+    records++;
+  }
+  EXPECT_EQ(size, offset);
+  EXPECT_LE(size, TEST_FILE_LIMIT);
+  EXPECT_EQ(writer.Packets(), records);
+}
+
+TEST_F(wp_ring, vlan_tag_is_written_and_filtered)
+{
+  wp::RingCapture ring;
+  wp::ring_config_t ringConfig {64u * 1024u, 4, 10, TEST_SNAP_LEN};
+  ring.Open(rxDevice, ringConfig, VlanFilter());
+
+  wp::writer_config_t writerConfig {4096u * 1024u, false, false};
+  wp::CaptureWriter writer(ring, writerConfig, [this]() { return dir / "next.pcap"; });
+  writer.SetUserFilter([](const std::uint8_t * data, std::uint32_t caplen, std::uint32_t) {
+    return IsTagged(data, caplen);
+  });
+  writer.Start(dir / "log.pcap");
+
+  auto sent = GenerateTagged(10);
+  ASSERT_GT(sent, 0u);
+  Generate(10);
+  auto end = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while((writer.Packets() < sent) && (std::chrono::steady_clock::now() < end)) {
+    tpacket_block_desc * pBlock = ring.Next(20);
+    if(nullptr != pBlock) {
+      writer.Push(pBlock);
+    }
+  }
+  writer.Stop();
+  ring.Close();
+
+  // every frame is written with its tag, untagged frames are filtered
+  ASSERT_GE(writer.Packets(), sent);
+  std::ifstream file(dir / "log.pcap", std::ios::binary);
+  std::uintmax_t size = std::filesystem::file_size(dir / "log.pcap");
+  std::uintmax_t offset = PCAP_FILE_HEADER_LEN;
+  while(offset < size) {
+    std::uint32_t lengths[2] = {0, 0};
+    std::uint8_t data[18] = {0};
+    file.seekg(static_cast<std::streamoff>(offset + 8u));
+    file.read(reinterpret_cast<char*>(&lengths[0]), sizeof(lengths));
+    file.read(reinterpret_cast<char*>(&data[0]), sizeof(data));
+    EXPECT_EQ(TEST_FRAME_LEN, lengths[0]);
+    EXPECT_EQ(TEST_FRAME_LEN, lengths[1]);
+    EXPECT_TRUE(IsTagged(&data[0], sizeof(data)));
+    EXPECT_EQ(TEST_VLAN_ID, (data[14] << 8) | data[15]);
+    EXPECT_EQ(TEST_ETHERTYPE, (data[16] << 8) | data[17]);
+    offset += PCAP_RECORD_HEADER_LEN + lengths[0];
+  }
+  EXPECT_EQ(size, offset);
+}
+
+TEST_F(wp_ring, capture_throughput)
+{
+  wp::RingCapture ring;
+  wp::ring_config_t ringConfig {256u * 1024u, 8, 10, TEST_SNAP_LEN};
+  ring.Open(rxDevice, ringConfig, TestFilter());
+  ASSERT_EQ(LINKTYPE_ETHERNET, ring.LinkType());
+
+  std::size_t files = 0;
+  wp::writer_config_t writerConfig {4096u * 1024u, true, false};
+  wp::CaptureWriter writer(ring, writerConfig, [this, &files]() {
+    return dir / ("log_" + std::to_string(++files) + ".pcap");
+  });
+  writer.Start(dir / "log_0.pcap");
+
+  std::atomic<bool> generating {true};
+  std::size_t sent = 0;
+  auto start = std::chrono::steady_clock::now();
+  std::thread generator([&sent, &generating]() {
+    sent = Generate(TEST_FRAME_COUNT);
+    generating = false;
+  });
+
+  // keep polling until the ring is drained after the generator finished
+  auto idle = 0;
+  while(generating || (idle < 5)) {
+    tpacket_block_desc * pBlock = ring.Next(20);
+    if(nullptr != pBlock) {
+      writer.Push(pBlock);
+      idle = 0;
+    }
+    else if(!generating) {
+      idle++;
+    }
+  }
+  generator.join();
+  writer.Stop();
+  auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  wp::ring_stats_t stats = ring.Stats();
+  ring.Close();
+
+  ASSERT_GT(sent, 0u);
+  // on the loopback interface every frame is seen twice, once sent and once received
+  EXPECT_GE(writer.Packets() + stats.drops, sent);
+  EXPECT_GE(files, 1u);
+  RecordProperty("device", rxDevice);
+  RecordProperty("packets_per_second", static_cast<int>(static_cast<double>(writer.Packets()) / seconds));
+  RecordProperty("drops", static_cast<int>(stats.drops));
+
+  // every file starts with the classic pcap header
+  for(auto const & entry : std::filesystem::directory_iterator(dir)) {
+    std::ifstream file(entry.path(), std::ios::binary);
+    std::uint32_t magic = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    EXPECT_EQ(0xa1b2c3d4u, magic);
+  }
+}
+
+TEST_F(wp_compress, compress_file)
+{
+  auto path = dir / "log.pcap";
+  {
+    std::ofstream file(path);
+    file << std::string(100000, 'x');
+  }
+
+  ASSERT_TRUE(wp::compressFile(path));
+  ASSERT_FALSE(std::filesystem::exists(path));
+  ASSERT_TRUE(std::filesystem::exists(dir / "log.pcap.gz"));
+  ASSERT_LT(std::filesystem::file_size(dir / "log.pcap.gz"), 100000u);
+}
+
+TEST_F(wp_compress, compress_missing_file)
+{
+  ASSERT_FALSE(wp::compressFile(dir / "missing.pcap"));
+  ASSERT_FALSE(std::filesystem::exists(dir / "missing.pcap.gz"));
+}
+
+//---- End of source file ------------------------------------------------------
@@ -47,6 +47,8 @@ struct option g_longopts[] = {
    { "read",        required_argument,  nullptr,   'r' },
    { "scan",        no_argument,        nullptr,   's' },
    { "limit",       required_argument,  nullptr,   'l' },
+   { "offset",      required_argument,  nullptr,   'o' },
+   { "rotated",     no_argument,        nullptr,   'R' },
    { "archive",     optional_argument,  nullptr,   'a' },
    // last line
    { nullptr,       no_argument,        nullptr,    0  }
@@ -57,6 +59,7 @@ const char * g_syslogPath =   "/var/log/";
 const char * g_svnRevPath =   "/etc/SVNREVISION";
 const char * g_RevPath =      "/etc/REVISIONS";
 const char * g_packagesPath = "/tmp/packages.txt";
+const char * g_indexPath =    "/var/run/print_log/";
 
 // archive list
 std::vector<std::string> g_archiveList;
@@ -109,6 +112,8 @@ int main(int    argc,
   // buffer
   int buffer_oc = 0;
   unsigned int buffer_limit = 0;
+  unsigned int buffer_offset = 0;
+  bool buffer_rotated = false;
   bool buffer_json = false;
   std::string buffer_arg;
 
@@ -121,7 +126,7 @@ int main(int    argc,
     // first check all options
     while ((oc = getopt_long(argc,
                              argv,
-                             "hjr:sl:a::",
+                             "hjr:sl:o:Ra::",
                              &g_longopts[0],
                              nullptr)) != -1) {
       switch (oc) {
@@ -135,6 +140,12 @@ int main(int    argc,
         case 'l':
           buffer_limit = strtoul (optarg, nullptr, 0);
           break;
+        case 'o':
+          buffer_offset = strtoul (optarg, nullptr, 0);
+          break;
+        case 'R':
+          buffer_rotated = true;
+          break;
         case 'a':
           archiveProlog();
           if(FolderToPathExist(g_archivePath))
@@ -188,7 +199,22 @@ int main(int    argc,
           {
             // check filename exist
             std::vector<std::string> files = GetFilenames(g_syslogPath);
-            if(std::find(files.begin(), files.end(), buffer_arg) != files.end())
+            if(std::find(files.begin(), files.end(), buffer_arg) == files.end())
+            {
+              break;
+            }
+            // pages deeper in the log or spanning the rotated files
+            if((buffer_offset > 0) || buffer_rotated)
+            {
+              status = PrintLogPage(buffer_arg,
+                                    g_syslogPath,
+                                    buffer_offset,
+                                    buffer_limit,
+                                    buffer_rotated,
+                                    g_indexPath,
+                                    std::cout);
+            }
+            else
             {
               status = PrintFileContent(buffer_arg,
                                         g_syslogPath,
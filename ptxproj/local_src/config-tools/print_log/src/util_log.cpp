@@ -116,13 +116,7 @@ unsigned int GetNumberOfLines(const boost::filesystem::path & filePath)
 {
   unsigned int number = 0;
   if(boost::filesystem::is_regular_file(filePath)) {
-    std::ifstream is(filePath.c_str());
-    std::string line;
-
-    // Count number of lines
-    while(std::getline(is, line)) {
-      number++;
-    }
+    number = CountLines(filePath);
   }
 
   return number;
@@ -133,29 +127,16 @@ unsigned int ReadFileLineByLine(const boost::filesystem::path & filePath,
                                 std::ostream & out)
 {
   unsigned int outCounter = 0;
-  unsigned int lines = GetNumberOfLines(filePath);
-
-  if(lines > 0) {
 
-    // Calculate start line
-    unsigned int startLine = 0;
-    if((limit > 0) && (limit <= lines)) {
-      startLine = lines - limit;
-    }
-
-    // Read file line by line
-    unsigned int lineCounter = 0;
-    std::ifstream is(filePath.c_str());
-    std::string line;
-    while(std::getline(is, line)) {
+  if(boost::filesystem::is_regular_file(filePath)) {
 
-      // Print out if start line reached
-      if(lineCounter >= startLine) {
-        out << line << std::endl;
-        outCounter++;
-      }
-      lineCounter++;
+    // Read the last lines from the end of the file
+    LogPage page = ReadLogPage({filePath}, 0, limit, boost::filesystem::path());
+    for(auto const & line : page.lines) {
+      out << line << '\n';
+      outCounter++;
     }
+    out.flush();
   }
 
   return outCounter;
@@ -173,6 +154,8 @@ eStatusCode PrintHelpText(std::ostream & out, const std::string & archive_dest_p
   out << "  -j [--json]                   - json output format\n";
   out << "  -r [--read]     <filename>    - read content of file\n";
   out << "  -l [--limit]    <value>       - limit read output\n";
+  out << "  -o [--offset]   <value>       - skip the newest lines of read output\n";
+  out << "  -R [--rotated]                - continue read output with the rotated files\n";
   out << "\n";
 
   return SUCCESS;
@@ -219,6 +202,36 @@ eStatusCode PrintFileContent(const std::string & filename,
   return status;
 }
 
+eStatusCode PrintLogPage(const std::string & filename,
+                         const boost::filesystem::path & folderpath,
+                         unsigned int offset,
+                         unsigned int limit,
+                         bool rotated,
+                         const boost::filesystem::path & indexFolder,
+                         std::ostream & out)
+{
+  eStatusCode status = ERROR;
+  boost::filesystem::path filePath = folderpath / filename;
+
+  if(boost::filesystem::is_regular_file(filePath))
+  {
+    std::vector<boost::filesystem::path> files = {filePath};
+    if(rotated)
+    {
+      files = GetRotatedFiles(filePath);
+    }
+    LogPage page = ReadLogPage(files, offset, limit, indexFolder);
+    for(auto const & line : page.lines)
+    {
+      out << line << '\n';
+    }
+    out.flush();
+    status = SUCCESS;
+  }
+
+  return status;
+}
+
 eStatusCode SystemCall(const std::string & cmd)
 {
   eStatusCode status = ERROR;
@@ -22,6 +22,7 @@
 #include "boost/filesystem.hpp"
 #include "config_tool_lib.h"
 #include "ct_error_handling.h"
+#include "util_log_tail.hpp"
 
 //------------------------------------------------------------------------------
 // defines; structure, enumeration and type definitions
@@ -66,6 +67,14 @@ eStatusCode PrintFileContent(const std::string & filename,
                              unsigned int limit,
                              std::ostream & out);
 
+eStatusCode PrintLogPage(const std::string & filename,
+                         const boost::filesystem::path & folderpath,
+                         unsigned int offset,
+                         unsigned int limit,
+                         bool rotated,
+                         const boost::filesystem::path & indexFolder,
+                         std::ostream & out);
+
 eStatusCode SystemCall(const std::string & cmd);
 
 eStatusCode SavePackageList(const std::string & dst);
@@ -0,0 +1,497 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file     util_log_tail.cpp
+///
+///  \brief    Read the newest lines of a log file and its rotated siblings
+///            without reading the files from the start.
+///
+///  \author   <author> : WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include "util_log_tail.hpp"
+
+#include <sys/stat.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+//------------------------------------------------------------------------------
+// defines; structure, enumeration and type definitions
+//------------------------------------------------------------------------------
+// size of the blocks read from the end of a file
+#define TAIL_BLOCK_SIZE (64u * 1024u)
+
+// the index stores the byte offset of every INDEX_INTERVAL-th line
+#define INDEX_INTERVAL 1024u
+// pages starting this many lines before the end are read via the index
+#define INDEX_MIN_SKIP 4096u
+#define INDEX_EXTENSION ".idx"
+#define INDEX_HEADER "print_log-index-1"
+
+#define COMPRESSED_EXTENSION ".gz"
+// highest rotation number looked for, logrotate counts up from 1
+#define MAX_ROTATED_FILES 16u
+
+namespace {
+
+struct FileCloser
+{
+  void operator()(std::FILE * pFile) const { std::fclose(pFile); }
+};
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+// line offset index of a plain log file, the log is only expected to grow
+struct LineIndex
+{
+  unsigned long long dev = 0;
+  unsigned long long ino = 0;
+  unsigned long long size = 0;   // indexed bytes, ends behind a newline
+  unsigned long long lines = 0;  // complete lines within the indexed bytes
+  std::vector<unsigned long long> checkpoints {0}; // offset of line n * INDEX_INTERVAL
+  unsigned long long total = 0;  // lines of the file including a last line without newline
+};
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+bool LoadIndex(const boost::filesystem::path & indexPath, LineIndex & index);
+void SaveIndex(const boost::filesystem::path & indexPath, const LineIndex & index);
+bool UpdateIndex(const boost::filesystem::path & filePath,
+                 const boost::filesystem::path & indexFolder,
+                 LineIndex & index);
+std::vector<std::string> ReadLineRange(const boost::filesystem::path & filePath,
+                                       const LineIndex & index,
+                                       unsigned long long first,
+                                       unsigned long long last);
+unsigned long long ReadCompressedTail(const boost::filesystem::path & filePath,
+                                      unsigned long long keep,
+                                      std::deque<std::string> & lines);
+bool IsCompressed(const boost::filesystem::path & filePath);
+
+//------------------------------------------------------------------------------
+// function implementation
+//------------------------------------------------------------------------------
+bool IsCompressed(const boost::filesystem::path & filePath)
+{
+  return filePath.extension() == COMPRESSED_EXTENSION;
+}
+
+bool LoadIndex(const boost::filesystem::path & indexPath, LineIndex & index)
+{
+  std::ifstream is(indexPath.c_str());
+  std::string header;
+  if(!std::getline(is, header) || (header != INDEX_HEADER))
+  {
+    return false;
+  }
+
+  LineIndex loaded;
+  loaded.checkpoints.clear();
+  if(!(is >> loaded.dev >> loaded.ino >> loaded.size >> loaded.lines))
+  {
+    return false;
+  }
+  unsigned long long checkpoint;
+  while(is >> checkpoint)
+  {
+    loaded.checkpoints.push_back(checkpoint);
+  }
+  if(loaded.checkpoints.size() != ((loaded.lines / INDEX_INTERVAL) + 1))
+  {
+    return false;
+  }
+
+  index = loaded;
+  return true;
+}
+
+void SaveIndex(const boost::filesystem::path & indexPath, const LineIndex & index)
+{
+  // written to a temporary file first, a concurrent reader never sees half an index
+  boost::filesystem::path tmpPath = indexPath;
+  tmpPath += ".tmp";
+  {
+    std::ofstream os(tmpPath.c_str(), std::ios::trunc);
+    os << INDEX_HEADER << "\n"
+       << index.dev << " " << index.ino << " " << index.size << " " << index.lines << "\n";
+    for(auto const checkpoint : index.checkpoints)
+    {
+      os << checkpoint << "\n";
+    }
+    if(!os)
+    {
+      return;
+    }
+  }
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmpPath, indexPath, ec);
+}
+
+// load the index of a file and extend it to the current end of the file
+bool UpdateIndex(const boost::filesystem::path & filePath,
+                 const boost::filesystem::path & indexFolder,
+                 LineIndex & index)
+{
+  FilePtr file(std::fopen(filePath.c_str(), "rb"));
+  struct stat st;
+  if(!file || (0 != fstat(fileno(file.get()), &st)))
+  {
+    return false;
+  }
+
+  boost::filesystem::path indexPath = indexFolder / filePath.filename();
+  indexPath += INDEX_EXTENSION;
+
+  // the index is only valid for the same file, which has grown at most;
+  // a truncated or replaced file has to be indexed again
+  bool valid = LoadIndex(indexPath, index) &&
+               (index.dev == static_cast<unsigned long long>(st.st_dev)) &&
+               (index.ino == static_cast<unsigned long long>(st.st_ino)) &&
+               (index.size <= static_cast<unsigned long long>(st.st_size));
+  if(valid && (index.size > 0))
+  {
+    valid = (0 == std::fseek(file.get(), static_cast<long>(index.size - 1), SEEK_SET)) &&
+            (std::fgetc(file.get()) == '\n');
+  }
+  if(!valid)
+  {
+    index = LineIndex();
+    index.dev = static_cast<unsigned long long>(st.st_dev);
+    index.ino = static_cast<unsigned long long>(st.st_ino);
+  }
+
+  bool changed = !valid;
+  std::vector<char> block(TAIL_BLOCK_SIZE);
+  unsigned long long pos = index.size;
+  if(0 != std::fseek(file.get(), static_cast<long>(pos), SEEK_SET))
+  {
+    return false;
+  }
+  std::size_t length;
+  while((length = std::fread(block.data(), 1, block.size(), file.get())) > 0)
+  {
+    const char * pBegin = block.data();
+    const char * pEnd = pBegin + length;
+    const char * pNewline;
+    while((pNewline = static_cast<const char *>(std::memchr(pBegin, '\n', static_cast<std::size_t>(pEnd - pBegin)))) != nullptr)
+    {
+      index.lines++;
+      index.size = pos + static_cast<unsigned long long>(pNewline - block.data()) + 1;
+      if((index.lines % INDEX_INTERVAL) == 0)
+      {
+        index.checkpoints.push_back(index.size);
+      }
+      changed = true;
+      pBegin = pNewline + 1;
+    }
+    pos += length;
+  }
+
+  index.total = index.lines + ((pos > index.size) ? 1 : 0);
+  if(changed)
+  {
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(indexFolder, ec);
+    SaveIndex(indexPath, index);
+  }
+  return true;
+}
+
+// lines [first, last) of an indexed file
+std::vector<std::string> ReadLineRange(const boost::filesystem::path & filePath,
+                                       const LineIndex & index,
+                                       unsigned long long first,
+                                       unsigned long long last)
+{
+  std::vector<std::string> lines;
+  std::ifstream is(filePath.c_str(), std::ios::binary);
+  unsigned long long number = (first / INDEX_INTERVAL) * INDEX_INTERVAL;
+  is.seekg(static_cast<std::streamoff>(index.checkpoints[first / INDEX_INTERVAL]));
+
+  std::string line;
+  lines.reserve(static_cast<std::size_t>(last - first));
+  while((number < last) && std::getline(is, line))
+  {
+    if(number >= first)
+    {
+      lines.emplace_back(line);
+    }
+    number++;
+  }
+  return lines;
+}
+
+// compressed files cannot be read backwards, keep the last lines while streaming
+unsigned long long ReadCompressedTail(const boost::filesystem::path & filePath,
+                                      unsigned long long keep,
+                                      std::deque<std::string> & lines)
+{
+  gzFile file = gzopen(filePath.c_str(), "rb");
+  if(file == nullptr)
+  {
+    return 0;
+  }
+  gzbuffer(file, TAIL_BLOCK_SIZE);
+
+  unsigned long long total = 0;
+  std::vector<char> block(TAIL_BLOCK_SIZE);
+  std::string partial;
+  int length;
+  while((length = gzread(file, block.data(), static_cast<unsigned int>(block.size()))) > 0)
+  {
+    const char * pBegin = block.data();
+    const char * pEnd = pBegin + length;
+    const char * pNewline;
+    while((pNewline = static_cast<const char *>(std::memchr(pBegin, '\n', static_cast<std::size_t>(pEnd - pBegin)))) != nullptr)
+    {
+      partial.append(pBegin, pNewline);
+      lines.emplace_back(std::move(partial));
+      partial.clear();
+      total++;
+      if(lines.size() > keep)
+      {
+        lines.pop_front();
+      }
+      pBegin = pNewline + 1;
+    }
+    partial.append(pBegin, pEnd);
+  }
+  if(!partial.empty())
+  {
+    lines.emplace_back(std::move(partial));
+    total++;
+    if(lines.size() > keep)
+    {
+      lines.pop_front();
+    }
+  }
+  gzclose(file);
+
+  return total;
+}
+
+} // namespace
+
+unsigned int CountLines(const boost::filesystem::path & filePath)
+{
+  FilePtr file(std::fopen(filePath.c_str(), "rb"));
+  if(!file)
+  {
+    return 0;
+  }
+
+  unsigned int number = 0;
+  char last = '\n';
+  std::vector<char> block(TAIL_BLOCK_SIZE);
+  std::size_t length;
+  while((length = std::fread(block.data(), 1, block.size(), file.get())) > 0)
+  {
+    const char * pBegin = block.data();
+    const char * pEnd = pBegin + length;
+    while((pBegin = static_cast<const char *>(std::memchr(pBegin, '\n', static_cast<std::size_t>(pEnd - pBegin)))) != nullptr)
+    {
+      number++;
+      pBegin++;
+    }
+    last = block[length - 1];
+  }
+
+  return number + ((last != '\n') ? 1 : 0);
+}
+
+unsigned int VisitLinesReverse(const boost::filesystem::path & filePath,
+                               const LineVisitor & visitor)
+{
+  FilePtr file(std::fopen(filePath.c_str(), "rb"));
+  if(!file || (0 != std::fseek(file.get(), 0, SEEK_END)))
+  {
+    return 0;
+  }
+  long end = std::ftell(file.get());
+  if(end <= 0)
+  {
+    return 0;
+  }
+
+  // the newline of the last line does not start another line
+  if((0 == std::fseek(file.get(), end - 1, SEEK_SET)) && (std::fgetc(file.get()) == '\n'))
+  {
+    end--;
+  }
+
+  unsigned int visited = 0;
+  std::vector<char> block(TAIL_BLOCK_SIZE);
+  std::string tail;  // start of the line continued in the following block
+  long pos = end;
+  bool proceed = true;
+  while(proceed && (pos > 0))
+  {
+    auto length = static_cast<std::size_t>(std::min<long>(pos, static_cast<long>(block.size())));
+    pos -= static_cast<long>(length);
+    if((0 != std::fseek(file.get(), pos, SEEK_SET)) ||
+       (std::fread(block.data(), 1, length, file.get()) != length))
+    {
+      break;
+    }
+
+    std::size_t lineEnd = length;
+    for(std::size_t i = length; proceed && (i > 0); i--)
+    {
+      if(block[i - 1] == '\n')
+      {
+        std::string line(block.data() + i, lineEnd - i);
+        line.append(tail);
+        tail.clear();
+        lineEnd = i - 1;
+        visited++;
+        proceed = visitor(line);
+      }
+    }
+    if(proceed)
+    {
+      tail.insert(0, block.data(), lineEnd);
+    }
+  }
+
+  // the first line of the file has no newline in front
+  if(proceed && (pos == 0))
+  {
+    visited++;
+    (void)visitor(tail);
+  }
+
+  return visited;
+}
+
+std::vector<boost::filesystem::path> GetRotatedFiles(const boost::filesystem::path & filePath)
+{
+  std::vector<boost::filesystem::path> files;
+  if(!boost::filesystem::is_regular_file(filePath))
+  {
+    return files;
+  }
+  files.emplace_back(filePath);
+
+  for(unsigned int number = 0; number <= MAX_ROTATED_FILES; number++)
+  {
+    boost::filesystem::path rotated = filePath;
+    rotated += "." + std::to_string(number);
+    boost::filesystem::path compressed = rotated;
+    compressed += COMPRESSED_EXTENSION;
+
+    if(boost::filesystem::is_regular_file(rotated))
+    {
+      files.emplace_back(rotated);
+    }
+    else if(boost::filesystem::is_regular_file(compressed))
+    {
+      files.emplace_back(compressed);
+    }
+    // logrotate starts with .1, other tools with .0
+    else if(number > 0)
+    {
+      break;
+    }
+  }
+
+  return files;
+}
+
+LogPage ReadLogPage(const std::vector<boost::filesystem::path> & files,
+                    unsigned int offset,
+                    unsigned int limit,
+                    const boost::filesystem::path & indexFolder)
+{
+  LogPage page;
+  unsigned long long skip = offset;
+  unsigned long long remaining = (limit > 0) ? limit : ULLONG_MAX;
+
+  for(std::size_t i = 0; i < files.size(); i++)
+  {
+    if(remaining == 0)
+    {
+      page.more = true;
+      break;
+    }
+    const boost::filesystem::path & filePath = files[i];
+
+    // deep pages: count and skip whole files without reading them backwards
+    LineIndex index;
+    if(IsCompressed(filePath))
+    {
+      std::deque<std::string> tailLines;
+      unsigned long long keep = (remaining == ULLONG_MAX) ? ULLONG_MAX : (skip + remaining);
+      unsigned long long total = ReadCompressedTail(filePath, keep, tailLines);
+      if(skip >= total)
+      {
+        skip -= total;
+        continue;
+      }
+      // tailLines holds the lines [total - size, total)
+      unsigned long long last = tailLines.size() - skip;
+      unsigned long long first = (remaining >= last) ? 0 : (last - remaining);
+      page.lines.insert(page.lines.begin(),
+                        std::make_move_iterator(tailLines.begin() + static_cast<long>(first)),
+                        std::make_move_iterator(tailLines.begin() + static_cast<long>(last)));
+      page.more = page.more || (first > 0) || (total > tailLines.size());
+      remaining -= last - first;
+      skip = 0;
+    }
+    else if(!indexFolder.empty() && (skip >= INDEX_MIN_SKIP) && UpdateIndex(filePath, indexFolder, index))
+    {
+      if(skip >= index.total)
+      {
+        skip -= index.total;
+        continue;
+      }
+      unsigned long long last = index.total - skip;
+      unsigned long long first = (remaining >= last) ? 0 : (last - remaining);
+      std::vector<std::string> lines = ReadLineRange(filePath, index, first, last);
+      page.lines.insert(page.lines.begin(),
+                        std::make_move_iterator(lines.begin()),
+                        std::make_move_iterator(lines.end()));
+      page.more = page.more || (first > 0);
+      remaining -= lines.size();
+      skip = 0;
+    }
+    else
+    {
+      (void)VisitLinesReverse(filePath, [&](const std::string & line) {
+        if(remaining == 0)
+        {
+          page.more = true;
+          return false;
+        }
+        if(skip > 0)
+        {
+          skip--;
+        }
+        else
+        {
+          page.lines.emplace_front(line);
+          remaining--;
+        }
+        return true;
+      });
+    }
+  }
+
+  return page;
+}
+
+//---- End of source file ------------------------------------------------------
@@ -0,0 +1,68 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file     util_log_tail.hpp
+///
+///  \brief    Read the newest lines of a log file and its rotated siblings
+///            without reading the files from the start.
+///
+///  \author   <author> : WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+#ifndef SRC_LIBUTIL_LOG_UTIL_LOG_TAIL_HPP_
+#define SRC_LIBUTIL_LOG_UTIL_LOG_TAIL_HPP_
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+#include "boost/filesystem.hpp"
+
+//------------------------------------------------------------------------------
+// defines; structure, enumeration and type definitions
+//------------------------------------------------------------------------------
+// called for each line, newest line first, return false to stop reading
+using LineVisitor = std::function<bool(const std::string & line)>;
+
+// one page of a log, lines are in file order (oldest first)
+struct LogPage
+{
+  std::deque<std::string> lines;
+  // all lines skipped or returned exist, there may be more older lines
+  bool more = false;
+};
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+/// Number of lines as std::getline() would count them, a last line without newline counts.
+unsigned int CountLines(const boost::filesystem::path & filePath);
+
+/// Visit the lines of a plain file from the end, reading it backwards in blocks.
+/// Returns the number of visited lines.
+unsigned int VisitLinesReverse(const boost::filesystem::path & filePath,
+                               const LineVisitor & visitor);
+
+/// The log file followed by its rotated siblings, newest first:
+/// name, name.0, name.0.gz, name.1, name.1.gz, ...
+std::vector<boost::filesystem::path> GetRotatedFiles(const boost::filesystem::path & filePath);
+
+/// Read a page of the log chain, skipping the offset newest lines and returning up
+/// to limit lines (0 = no limit). Older files of the chain are only opened when the
+/// newer ones have fewer lines. If indexFolder is not empty, deep pages of plain
+/// files are read via a line offset index kept in this folder.
+LogPage ReadLogPage(const std::vector<boost::filesystem::path> & files,
+                    unsigned int offset,
+                    unsigned int limit,
+                    const boost::filesystem::path & indexFolder);
+
+#endif /* SRC_LIBUTIL_LOG_UTIL_LOG_TAIL_HPP_ */
+//---- End of source file ------------------------------------------------------
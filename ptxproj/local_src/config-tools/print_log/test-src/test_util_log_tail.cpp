@@ -0,0 +1,248 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file     test_util_log_tail.cpp
+///
+///  \brief    Tests for reading log files from the end.
+///
+///  \author   <author> : WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <util_log_tail.hpp>
+
+//------------------------------------------------------------------------------
+class libutil_LogTail: public ::testing::Test {
+  protected:
+    boost::filesystem::path tempPath = "/tmp/gtest_log_tail";
+    boost::filesystem::path indexPath = "/tmp/gtest_log_tail/index";
+    boost::filesystem::path logPath = "/tmp/gtest_log_tail/messages";
+
+    void SetUp() override {
+      if(boost::filesystem::exists(tempPath)) {
+        boost::filesystem::remove_all(tempPath);
+      }
+      ASSERT_TRUE(boost::filesystem::create_directory(tempPath));
+    }
+
+    void TearDown() override {
+      boost::filesystem::remove_all(tempPath);
+    }
+
+    // lines "<prefix><first>" ... "<prefix><last - 1>"
+    static std::string Lines(const std::string & prefix, unsigned int first, unsigned int last) {
+      std::string content;
+      for(unsigned int i = first; i < last; i++) {
+        content += prefix + std::to_string(i) + "\n";
+      }
+      return content;
+    }
+
+    static void Write(const boost::filesystem::path & path, const std::string & content) {
+      std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+      file << content;
+    }
+
+    static void WriteCompressed(const boost::filesystem::path & path, const std::string & content) {
+      gzFile file = gzopen(path.c_str(), "wb");
+      ASSERT_NE(nullptr, file);
+      ASSERT_EQ(static_cast<int>(content.size()), gzwrite(file, content.data(), static_cast<unsigned int>(content.size())));
+      gzclose(file);
+    }
+
+    static std::vector<std::string> Reverse(const boost::filesystem::path & path) {
+      std::vector<std::string> lines;
+      VisitLinesReverse(path, [&lines](const std::string & line) {
+        lines.push_back(line);
+        return true;
+      });
+      return lines;
+    }
+};
+
+TEST_F(libutil_LogTail, CountLines_likeGetline) {
+  Write(logPath, "");
+  ASSERT_EQ(0, CountLines(logPath));
+  Write(logPath, "\n");
+  ASSERT_EQ(1, CountLines(logPath));
+  Write(logPath, "a\n\nb");
+  ASSERT_EQ(3, CountLines(logPath));
+  Write(logPath, Lines("line ", 0, 100000));
+  ASSERT_EQ(100000, CountLines(logPath));
+}
+
+TEST_F(libutil_LogTail, VisitLinesReverse_edges) {
+  Write(logPath, "");
+  ASSERT_TRUE(Reverse(logPath).empty());
+
+  Write(logPath, "\n");
+  ASSERT_EQ(std::vector<std::string>({""}), Reverse(logPath));
+
+  Write(logPath, "a\n\nb");
+  ASSERT_EQ(std::vector<std::string>({"b", "", "a"}), Reverse(logPath));
+
+  Write(logPath, "a\nb\n");
+  ASSERT_EQ(std::vector<std::string>({"b", "a"}), Reverse(logPath));
+}
+
+TEST_F(libutil_LogTail, VisitLinesReverse_linesAcrossBlocks) {
+  // lines longer than a block and lines split at block borders
+  std::string longLine(200000, 'x');
+  Write(logPath, Lines("line ", 0, 20000) + longLine + "\n" + Lines("end ", 0, 3));
+
+  auto lines = Reverse(logPath);
+  ASSERT_EQ(20004, lines.size());
+  ASSERT_EQ("end 2", lines[0]);
+  ASSERT_EQ(longLine, lines[3]);
+  for(unsigned int i = 0; i < 20000; i++) {
+    ASSERT_EQ("line " + std::to_string(19999 - i), lines[4 + i]);
+  }
+}
+
+TEST_F(libutil_LogTail, VisitLinesReverse_stop) {
+  Write(logPath, Lines("line ", 0, 10));
+  unsigned int count = 0;
+  auto visited = VisitLinesReverse(logPath, [&count](const std::string &) {
+    return ++count < 3;
+  });
+  ASSERT_EQ(3, visited);
+}
+
+TEST_F(libutil_LogTail, GetRotatedFiles) {
+  Write(logPath, "c\n");
+  Write(logPath.string() + ".1", "b\n");
+  WriteCompressed(logPath.string() + ".2.gz", "a\n");
+  Write(logPath.string() + ".4", "not in order\n");
+
+  auto files = GetRotatedFiles(logPath);
+  ASSERT_EQ(3, files.size());
+  ASSERT_EQ(logPath, files[0]);
+  ASSERT_EQ(logPath.string() + ".1", files[1].string());
+  ASSERT_EQ(logPath.string() + ".2.gz", files[2].string());
+}
+
+TEST_F(libutil_LogTail, ReadLogPage_tail) {
+  Write(logPath, Lines("line ", 0, 100));
+
+  auto page = ReadLogPage({logPath}, 0, 10, indexPath);
+  ASSERT_EQ(10, page.lines.size());
+  ASSERT_EQ("line 90", page.lines.front());
+  ASSERT_EQ("line 99", page.lines.back());
+  ASSERT_TRUE(page.more);
+
+  page = ReadLogPage({logPath}, 95, 10, indexPath);
+  ASSERT_EQ(5, page.lines.size());
+  ASSERT_EQ("line 0", page.lines.front());
+  ASSERT_EQ("line 4", page.lines.back());
+  ASSERT_FALSE(page.more);
+
+  page = ReadLogPage({logPath}, 0, 0, indexPath);
+  ASSERT_EQ(100, page.lines.size());
+}
+
+TEST_F(libutil_LogTail, ReadLogPage_rotatedAndCompressed) {
+  Write(logPath, Lines("line ", 20, 30));
+  Write(logPath.string() + ".1", Lines("line ", 10, 20));
+  WriteCompressed(logPath.string() + ".2.gz", Lines("line ", 0, 10));
+  auto files = GetRotatedFiles(logPath);
+
+  auto page = ReadLogPage(files, 5, 10, indexPath);
+  ASSERT_EQ(10, page.lines.size());
+  ASSERT_EQ("line 15", page.lines.front());
+  ASSERT_EQ("line 24", page.lines.back());
+  ASSERT_TRUE(page.more);
+
+  page = ReadLogPage(files, 15, 10, indexPath);
+  ASSERT_EQ(10, page.lines.size());
+  ASSERT_EQ("line 5", page.lines.front());
+  ASSERT_EQ("line 14", page.lines.back());
+  ASSERT_TRUE(page.more);
+
+  page = ReadLogPage(files, 25, 10, indexPath);
+  ASSERT_EQ(5, page.lines.size());
+  ASSERT_EQ("line 0", page.lines.front());
+  ASSERT_EQ("line 4", page.lines.back());
+  ASSERT_FALSE(page.more);
+}
+
+TEST_F(libutil_LogTail, ReadLogPage_index) {
+  Write(logPath, Lines("line ", 0, 50000));
+
+  auto page = ReadLogPage({logPath}, 30000, 100, indexPath);
+  ASSERT_EQ(100, page.lines.size());
+  ASSERT_EQ("line 19900", page.lines.front());
+  ASSERT_EQ("line 19999", page.lines.back());
+  ASSERT_TRUE(boost::filesystem::exists(indexPath / "messages.idx"));
+
+  // the index is extended when the log grows
+  std::ofstream(logPath.c_str(), std::ios::app) << Lines("line ", 50000, 60000);
+  page = ReadLogPage({logPath}, 30000, 100, indexPath);
+  ASSERT_EQ("line 29900", page.lines.front());
+  ASSERT_EQ("line 29999", page.lines.back());
+
+  // and rebuilt when the log is replaced by a shorter one
+  Write(logPath, Lines("new ", 0, 10000));
+  page = ReadLogPage({logPath}, 5000, 10, indexPath);
+  ASSERT_EQ("new 4990", page.lines.front());
+  ASSERT_EQ("new 4999", page.lines.back());
+
+  // skipping the whole file continues with the next one
+  boost::filesystem::path older = logPath.string() + ".1";
+  Write(older, Lines("old ", 0, 10));
+  page = ReadLogPage({logPath, older}, 10005, 10, indexPath);
+  ASSERT_EQ(5, page.lines.size());
+  ASSERT_EQ("old 0", page.lines.front());
+  ASSERT_EQ("old 4", page.lines.back());
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST_F(libutil_LogTail, DISABLED_Benchmark_100MB) {
+  {
+    std::ofstream file(logPath.c_str(), std::ios::binary);
+    std::string line = " print_log benchmark: some typical syslog message text with a few words\n";
+    for(unsigned int i = 0; file.tellp() < 100 * 1024 * 1024; i++) {
+      file << "Jan  1 00:00:00 PFC200V3 " << i << line;
+    }
+  }
+  unsigned int lines = 0;
+  auto measure = [&lines](const char * name, const std::function<void()> & func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << us << " us (" << lines << " lines)" << std::endl;
+  };
+
+  measure("getline from start, last 100", [&]() {
+    std::ifstream is(logPath.c_str());
+    std::string line;
+    std::deque<std::string> tail;
+    while(std::getline(is, line)) {
+      tail.emplace_back(line);
+      if(tail.size() > 100) {
+        tail.pop_front();
+      }
+    }
+    lines = static_cast<unsigned int>(tail.size());
+  });
+  measure("reverse, last 100", [&]() {
+    lines = static_cast<unsigned int>(ReadLogPage({logPath}, 0, 100, indexPath).lines.size());
+  });
+  measure("index build, page at 500000", [&]() {
+    lines = static_cast<unsigned int>(ReadLogPage({logPath}, 500000, 100, indexPath).lines.size());
+  });
+  measure("index, page at 1000000", [&]() {
+    lines = static_cast<unsigned int>(ReadLogPage({logPath}, 1000000, 100, indexPath).lines.size());
+  });
+}
+
+//---- End of source file ------------------------------------------------------
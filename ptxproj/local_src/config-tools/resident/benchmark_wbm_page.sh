@@ -0,0 +1,100 @@
+#!/bin/bash
+#-----------------------------------------------------------------------------#
+# Copyright (c) 2000 - 2022 WAGO GmbH & Co. KG
+#
+# PROPRIETARY RIGHTS of WAGO GmbH & Co. KG are involved in
+# the subject matter of this material. All manufacturing, reproduction,
+# use, and sales rights pertaining to this subject matter are governed
+# by the license agreement. The recipient of this software implicitly
+# accepts the terms of the license.
+#-----------------------------------------------------------------------------#
+#-----------------------------------------------------------------------------#
+# Script:   benchmark_wbm_page.sh
+#
+# Brief:    Replays the config tool calls of a WBM page load directly and
+#           through the resident config tool server and prints the times.
+#
+# Usage:    benchmark_wbm_page.sh [rounds] [call list file]
+#
+#           The call list contains one config tool call per line (tool name
+#           and arguments), without a list the calls of the status
+#           information page are used. config_tool_server has to be running.
+#-----------------------------------------------------------------------------#
+
+ROUNDS=${1:-20}
+CALL_LIST=${2:-}
+CT_DIR=/etc/config-tools
+CLIENT=${CLIENT:-/usr/bin/config_tool_client}
+
+STATUS_PAGE_CALLS="get_coupler_details product-description
+get_coupler_details order-number
+get_coupler_details firmware-revision
+get_coupler_details processor-type
+get_coupler_details license-information
+get_coupler_details actual-hostname
+get_coupler_details actual-domain-name
+get_coupler_details RS232-owner
+get_coupler_details default-webserver
+get_clock_data time-local
+get_clock_data date-local
+get_clock_data display-mode
+get_clock_data tz-string
+get_filesystem_data active-partition-medium
+get_filesystem_data home-device
+get_device_data name sd-card
+get_rts3scfg_value MODBUS_RTU state
+get_run_stop_switch_value
+get_typelabel_value order"
+
+if [[ -n "$CALL_LIST" ]]; then
+    CALLS="$(<"$CALL_LIST")"
+else
+    CALLS="$STATUS_PAGE_CALLS"
+fi
+
+if [[ ! -S /var/run/config_tool_server.socket ]]; then
+    echo "config_tool_server is not running" >&2
+    exit 1
+fi
+
+# run all calls of the list in all rounds, prefix is empty or the client
+function replay
+{
+    local prefix="$1"
+    local round call
+
+    for (( round = 0; round < ROUNDS; round++ )); do
+        while read -r call; do
+            [[ -z "$call" ]] && continue
+            if [[ -n "$prefix" ]]; then
+                $prefix $call > /dev/null 2>&1
+            else
+                $CT_DIR/$call > /dev/null 2>&1
+            fi
+        done <<< "$CALLS"
+    done
+}
+
+# compare the outputs once, the client has to be transparent
+while read -r call; do
+    [[ -z "$call" ]] && continue
+    direct="$($CT_DIR/$call 2>/dev/null; echo "rc=$?")"
+    resident="$($CLIENT $call 2>/dev/null; echo "rc=$?")"
+    if [[ "$direct" != "$resident" ]]; then
+        echo "output differs for \"$call\": \"$direct\" != \"$resident\"" >&2
+    fi
+done <<< "$CALLS"
+
+CALL_COUNT=$(grep -c . <<< "$CALLS")
+
+START=$(date +%s%N)
+replay ""
+DIRECT_NS=$(( $(date +%s%N) - START ))
+
+START=$(date +%s%N)
+replay "$CLIENT"
+RESIDENT_NS=$(( $(date +%s%N) - START ))
+
+echo "$CALL_COUNT calls per page, $ROUNDS rounds"
+echo "direct:   $(( DIRECT_NS / ROUNDS / 1000000 )) ms per page, $(( DIRECT_NS / ROUNDS / CALL_COUNT / 1000 )) us per call"
+echo "resident: $(( RESIDENT_NS / ROUNDS / 1000000 )) ms per page, $(( RESIDENT_NS / ROUNDS / CALL_COUNT / 1000 )) us per call"
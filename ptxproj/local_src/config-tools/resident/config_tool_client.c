@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------
+/// Copyright (c) 2000 - 2022 WAGO GmbH & Co. KG
+///
+/// PROPRIETARY RIGHTS of WAGO GmbH & Co. KG are involved in
+/// the subject matter of this material. All manufacturing, reproduction,
+/// use, and sales rights pertaining to this subject matter are governed
+/// by the license agreement. The recipient of this software implicitly
+/// accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///
+///  \file     config_tool_client.c
+///
+///  \brief    Calls a config tool by the resident config tool server.
+///
+///  Usage: config_tool_client <tool> [arguments]
+///
+///  Output and exit status are the same as for /etc/config-tools/<tool> [arguments],
+///  the tool runs with the environment and working directory of the client.
+///  If the server is not running or does not know the tool, the tool is executed directly.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include files
+//------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "../ct_error_handling.h"
+#include "config_tool_server.h"
+
+//------------------------------------------------------------------------------
+// Local functions
+//------------------------------------------------------------------------------
+
+static void ExecuteDirectly(char** argv)
+//
+// Fallback: run the tool the classic way. Does not return.
+//
+{
+  char toolPath[PATH_MAX];
+
+  snprintf(toolPath, sizeof(toolPath), "%s/%s", CT_TOOLS_DIR, argv[0]);
+  argv[0] = toolPath;
+  execv(toolPath, argv);
+
+  perror(toolPath);
+  exit(EXIT_FAILURE);
+}
+
+
+static int ConnectServer(void)
+{
+  struct sockaddr_un address;
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, CT_SERVER_SOCKET_PATH, sizeof(address.sun_path) - 1);
+
+  int connectionFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if(   (connectionFd >= 0)
+     && (connect(connectionFd, (struct sockaddr*)&address, sizeof(address)) != 0))
+  {
+    close(connectionFd);
+    connectionFd = -1;
+  }
+
+  return connectionFd;
+}
+
+
+static bool AppendStrings(char*        request,
+                          size_t*      pRequestLength,
+                          char* const* strings,
+                          uint32_t*    pCount)
+//
+// Append the zero terminated strings of a NULL terminated list to the request.
+//
+{
+  for(; strings[*pCount] != NULL; ++(*pCount))
+  {
+    size_t length = strlen(strings[*pCount]) + 1;
+    // the server keeps one byte for the termination of the request
+    if((*pRequestLength + length) >= CT_SERVER_MAX_REQUEST_LENGTH)
+    {
+      return false;
+    }
+    memcpy(request + *pRequestLength, strings[*pCount], length);
+    *pRequestLength += length;
+  }
+  return true;
+}
+
+
+static bool SendRequest(int    connectionFd,
+                        char** argv)
+{
+  static char      request[CT_SERVER_MAX_REQUEST_LENGTH];
+  size_t           requestLength = sizeof(tResidentRequest);
+  tResidentRequest header        = { 0 };
+  uint32_t         envCount      = 0;
+  int              fds[CT_SERVER_PASSED_FDS];
+  char             control[CMSG_SPACE(sizeof(fds))];
+  struct msghdr    msg;
+  struct iovec     iov;
+  bool             sent          = false;
+
+  if(   !AppendStrings(request, &requestLength, argv, &header.argc)
+     || (header.argc >= CT_SERVER_MAX_ARGS)
+     || ((environ != NULL) && !AppendStrings(request, &requestLength, environ, &envCount)))
+  {
+    return false;
+  }
+  memcpy(request, &header, sizeof(header));
+
+  // descriptors closed by the caller are replaced by /dev/null, SCM_RIGHTS only takes open ones
+  for(int fd = 0; fd < CT_SERVER_CWD_FD_INDEX; ++fd)
+  {
+    fds[fd] = fd;
+    if((fcntl(fd, F_GETFD) < 0) && ((fds[fd] = open("/dev/null", O_RDWR | O_CLOEXEC)) < 0))
+    {
+      return false;
+    }
+  }
+  // the tool resolves relative paths like a tool started by the caller
+  fds[CT_SERVER_CWD_FD_INDEX] = open(".", O_PATH | O_DIRECTORY | O_CLOEXEC);
+  if(fds[CT_SERVER_CWD_FD_INDEX] < 0)
+  {
+    return false;
+  }
+
+  iov.iov_base = request;
+  iov.iov_len  = requestLength;
+
+  memset(&msg, 0, sizeof(msg));
+  memset(control, 0, sizeof(control));
+  msg.msg_iov        = &iov;
+  msg.msg_iovlen     = 1;
+  msg.msg_control    = control;
+  msg.msg_controllen = sizeof(control);
+
+  struct cmsghdr* pCmsg = CMSG_FIRSTHDR(&msg);
+  pCmsg->cmsg_level = SOL_SOCKET;
+  pCmsg->cmsg_type  = SCM_RIGHTS;
+  pCmsg->cmsg_len   = CMSG_LEN(sizeof(fds));
+  memcpy(CMSG_DATA(pCmsg), fds, sizeof(fds));
+
+  ssize_t sentLength;
+  do
+  {
+    sentLength = sendmsg(connectionFd, &msg, MSG_NOSIGNAL);
+  } while((sentLength < 0) && (errno == EINTR));
+  sent = (sentLength == (ssize_t)requestLength);
+
+  close(fds[CT_SERVER_CWD_FD_INDEX]);
+  return sent;
+}
+
+
+static void ShowHelpText(void)
+{
+  printf("\n* Call a config tool by the resident config tool server *\n\n");
+  printf("Usage: config_tool_client <tool> [arguments]\n\n");
+  printf("Output and exit status are the same as for %s/<tool> [arguments].\n", CT_TOOLS_DIR);
+  printf("The tool is executed directly if the server is not available.\n\n");
+}
+
+
+int main(int    argc,
+         char** argv)
+{
+  if((argc < 2) || (strcmp(argv[1], "--help") == 0) || (strcmp(argv[1], "-h") == 0))
+  {
+    ShowHelpText();
+    return (argc < 2) ? MISSING_PARAMETER : SUCCESS;
+  }
+
+  char** toolArgv = &argv[1];
+  if((strchr(toolArgv[0], '/') != NULL) || (toolArgv[0][0] == '.'))
+  {
+    fprintf(stderr, "config_tool_client: invalid tool name \"%s\"\n", toolArgv[0]);
+    return INVALID_PARAMETER;
+  }
+
+  int connectionFd = ConnectServer();
+  if((connectionFd < 0) || !SendRequest(connectionFd, toolArgv))
+  {
+    ExecuteDirectly(toolArgv);
+  }
+
+  tResidentReply reply;
+  ssize_t        received;
+  do
+  {
+    received = recv(connectionFd, &reply, sizeof(reply), 0);
+  } while((received < 0) && (errno == EINTR));
+
+  close(connectionFd);
+
+  if(received != (ssize_t)sizeof(reply))
+  {
+    // the tool was started but terminated abnormally
+    return EXIT_FAILURE;
+  }
+  if(!reply.handled)
+  {
+    ExecuteDirectly(toolArgv);
+  }
+
+  return reply.exitStatus;
+}
@@ -0,0 +1,469 @@
+//------------------------------------------------------------------------------
+/// Copyright (c) 2000 - 2022 WAGO GmbH & Co. KG
+///
+/// PROPRIETARY RIGHTS of WAGO GmbH & Co. KG are involved in
+/// the subject matter of this material. All manufacturing, reproduction,
+/// use, and sales rights pertaining to this subject matter are governed
+/// by the license agreement. The recipient of this software implicitly
+/// accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///
+///  \file     config_tool_server.c
+///
+///  \brief    Resident server running the read-only config tools in-process.
+///
+///  The main functions of the config tools listed in resident_tools.h are linked
+///  into this program. For every request the server forks and calls the main
+///  function of the requested tool in the child, so neither a shell nor exec
+///  and dynamic linking are needed per call, while each call still starts with
+///  the pristine state of a freshly started tool.
+///  Config tools called by the tools themselves via SystemCall_GetOutput are
+///  run the same way if they are resident, too.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include files
+//------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "../config_tool_lib.h"
+#include "config_tool_server.h"
+
+//------------------------------------------------------------------------------
+// Local typedefs
+//------------------------------------------------------------------------------
+
+typedef int (*tToolMain)(int argc, char** argv);
+
+typedef struct
+{
+  char const * name;
+  tToolMain    main;
+} tResidentTool;
+
+//------------------------------------------------------------------------------
+// Local variables
+//------------------------------------------------------------------------------
+
+#define RESIDENT_TOOL(tool) extern int tool##_main(int argc, char** argv);
+#include "resident_tools.h"
+#undef RESIDENT_TOOL
+
+#define RESIDENT_TOOL(tool) { #tool, tool##_main },
+static const tResidentTool g_residentTools[] =
+{
+#include "resident_tools.h"
+  { NULL, NULL }
+};
+#undef RESIDENT_TOOL
+
+// connection the exit status of the running tool is sent to, -1 if there is none
+static int g_replyFd = -1;
+
+//------------------------------------------------------------------------------
+// Local functions
+//------------------------------------------------------------------------------
+
+static tToolMain GetToolMain(char const * szToolName)
+{
+  for(const tResidentTool* pTool = g_residentTools; pTool->name != NULL; ++pTool)
+  {
+    if(strcmp(pTool->name, szToolName) == 0)
+    {
+      return pTool->main;
+    }
+  }
+  return NULL;
+}
+
+
+static void SendReply(int replyFd, bool handled, int exitStatus)
+{
+  tResidentReply reply = { handled ? 1 : 0, exitStatus };
+  (void)send(replyFd, &reply, sizeof(reply), MSG_NOSIGNAL);
+}
+
+
+static void SendExitStatus(int exitStatus, void* pArg)
+//
+// on_exit handler of a tool run for a client: flush the output before the client
+// is told that the tool has finished (stdio would be flushed after this handler only).
+//
+{
+  UNUSED_PARAMETER(pArg);
+
+  if(g_replyFd >= 0)
+  {
+    (void)fflush(NULL);
+    SendReply(g_replyFd, true, exitStatus);
+    g_replyFd = -1;
+  }
+}
+
+
+static void RunTool(tToolMain toolMain,
+                    char**    argv)
+//
+// Run the main function of a resident tool like a fresh process would. Does not return.
+//
+{
+  int argc = 0;
+  while(argv[argc] != NULL)
+  {
+    ++argc;
+  }
+
+  // the tools may use getopt, start the scan from the beginning
+  optind = 1;
+
+  exit(toolMain(argc, argv));
+}
+
+
+static int SplitCommand(char* szCommand,
+                        char* argv[])
+//
+// Split a plain command line into its arguments. Returns the count of arguments
+// or -1 if the line needs a shell (quoting, redirection, pipes, variables, ...).
+//
+{
+  int argc = 0;
+
+  if(strpbrk(szCommand, "'\"\\|&;<>()$`*?[~#\n") != NULL)
+  {
+    return -1;
+  }
+
+  for(char* pSave = NULL, * pArg = strtok_r(szCommand, " \t", &pSave);
+      pArg != NULL;
+      pArg = strtok_r(NULL, " \t", &pSave))
+  {
+    if(argc >= (CT_SERVER_MAX_ARGS - 1))
+    {
+      return -1;
+    }
+    argv[argc++] = pArg;
+  }
+  argv[argc] = NULL;
+
+  return argc;
+}
+
+
+static char *RunResidentSystemCall(char const * szSystemCallString,
+                                   bool       * pHandled)
+//
+// SystemCall_GetOutput handler: config tools calling other resident config tools
+// get their output from a forked child instead of a shell.
+//
+{
+  char  command[MAX_LENGTH_SYSTEM_CALL];
+  char* argv[CT_SERVER_MAX_ARGS];
+  char* pOutputBuffer = NULL;
+
+  *pHandled = false;
+
+  if(   (strncmp(szSystemCallString, CT_TOOLS_DIR "/", sizeof(CT_TOOLS_DIR)) != 0)
+     || (strlen(szSystemCallString) >= sizeof(command)))
+  {
+    return NULL;
+  }
+
+  strcpy(command, szSystemCallString);
+  if(SplitCommand(command, argv) < 1)
+  {
+    return NULL;
+  }
+
+  tToolMain toolMain = GetToolMain(argv[0] + sizeof(CT_TOOLS_DIR));
+  if(toolMain == NULL)
+  {
+    return NULL;
+  }
+
+  int pipeFds[2];
+  if(pipe2(pipeFds, O_CLOEXEC) != 0)
+  {
+    return NULL;
+  }
+
+  // pending output of the calling tool must not be inherited by the child
+  (void)fflush(stdout);
+
+  *pHandled = true;
+
+  pid_t pid = fork();
+  if(pid == 0)
+  {
+    // the exit status of the nested tool must not be mistaken as the one of the calling tool
+    g_replyFd = -1;
+    (void)dup2(pipeFds[1], STDOUT_FILENO);
+    RunTool(toolMain, argv);
+  }
+
+  close(pipeFds[1]);
+
+  if(pid > 0)
+  {
+    size_t  bufferSize    = 1024;
+    size_t  outputLength  = 0;
+    ssize_t readLength    = 0;
+
+    pOutputBuffer = (char*)malloc(bufferSize);
+    while(pOutputBuffer != NULL)
+    {
+      readLength = read(pipeFds[0], pOutputBuffer + outputLength, bufferSize - outputLength - 1);
+      if((readLength < 0) && (errno == EINTR))
+      {
+        continue;
+      }
+      if(readLength <= 0)
+      {
+        break;
+      }
+
+      outputLength += (size_t)readLength;
+      if(outputLength == (bufferSize - 1))
+      {
+        char* pGrownBuffer = (char*)realloc(pOutputBuffer, bufferSize * 2);
+        if(pGrownBuffer == NULL)
+        {
+          free(pOutputBuffer);
+          pOutputBuffer = NULL;
+        }
+        else
+        {
+          pOutputBuffer = pGrownBuffer;
+          bufferSize   *= 2;
+        }
+      }
+    }
+
+    if(pOutputBuffer != NULL)
+    {
+      pOutputBuffer[outputLength] = '\0';
+    }
+
+    while((waitpid(pid, NULL, 0) < 0) && (errno == EINTR))
+    {
+      // retry
+    }
+  }
+
+  close(pipeFds[0]);
+
+  return pOutputBuffer;
+}
+
+
+static void HandleConnection(int connectionFd)
+//
+// Runs in the forked child: receive the request, take over the descriptors, working
+// directory and environment of the client and run the requested tool. Does not return.
+//
+{
+  static char      request[CT_SERVER_MAX_REQUEST_LENGTH];
+  char             control[CMSG_SPACE(sizeof(int) * CT_SERVER_PASSED_FDS)];
+  char*            argv[CT_SERVER_MAX_ARGS];
+  char             toolPath[PATH_MAX];
+  int              clientFds[CT_SERVER_PASSED_FDS] = { -1, -1, -1, -1 };
+  tResidentRequest header;
+  struct iovec     iov = { request, sizeof(request) - 1 };
+  struct msghdr    msg;
+  ssize_t          requestLength;
+
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov        = &iov;
+  msg.msg_iovlen     = 1;
+  msg.msg_control    = control;
+  msg.msg_controllen = sizeof(control);
+
+  do
+  {
+    requestLength = recvmsg(connectionFd, &msg, MSG_CMSG_CLOEXEC);
+  } while((requestLength < 0) && (errno == EINTR));
+
+  if(   (requestLength < (ssize_t)sizeof(header))
+     || ((msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) != 0))
+  {
+    _exit(EXIT_FAILURE);
+  }
+
+  for(struct cmsghdr* pCmsg = CMSG_FIRSTHDR(&msg); pCmsg != NULL; pCmsg = CMSG_NXTHDR(&msg, pCmsg))
+  {
+    if(   (pCmsg->cmsg_level == SOL_SOCKET) && (pCmsg->cmsg_type == SCM_RIGHTS)
+       && (pCmsg->cmsg_len == CMSG_LEN(sizeof(clientFds))))
+    {
+      memcpy(clientFds, CMSG_DATA(pCmsg), sizeof(clientFds));
+    }
+  }
+
+  // split the request into the zero terminated tool name, arguments and environment entries
+  memcpy(&header, request, sizeof(header));
+  request[requestLength] = '\0';
+  char* pArg = request + sizeof(header);
+  int   argc = 0;
+  for(; (pArg < (request + requestLength)) && (argc < (int)header.argc); pArg += strlen(pArg) + 1)
+  {
+    if(argc >= (CT_SERVER_MAX_ARGS - 1))
+    {
+      _exit(EXIT_FAILURE);
+    }
+    argv[argc++] = pArg;
+  }
+  argv[argc] = NULL;
+
+  tToolMain toolMain = (argc > 0) ? GetToolMain(argv[0]) : NULL;
+  if((toolMain == NULL) || (clientFds[CT_SERVER_PASSED_FDS - 1] < 0))
+  {
+    SendReply(connectionFd, false, 0);
+    _exit(EXIT_SUCCESS);
+  }
+
+  // the tool sees the environment of the client only, like a tool started by it
+  if(   (clearenv() != 0)
+     || (fchdir(clientFds[CT_SERVER_CWD_FD_INDEX]) != 0))
+  {
+    SendReply(connectionFd, false, 0);
+    _exit(EXIT_SUCCESS);
+  }
+  for(; pArg < (request + requestLength); pArg += strlen(pArg) + 1)
+  {
+    // the strings stay valid, this function does not return
+    if((strchr(pArg, '=') != NULL) && (putenv(pArg) != 0))
+    {
+      SendReply(connectionFd, false, 0);
+      _exit(EXIT_SUCCESS);
+    }
+  }
+  close(clientFds[CT_SERVER_CWD_FD_INDEX]);
+
+  for(int fd = 0; fd < CT_SERVER_CWD_FD_INDEX; ++fd)
+  {
+    (void)dup2(clientFds[fd], fd);
+    close(clientFds[fd]);
+  }
+
+  // tools may evaluate their program name, it is the same as for a direct call
+  snprintf(toolPath, sizeof(toolPath), "%s/%s", CT_TOOLS_DIR, argv[0]);
+  argv[0] = toolPath;
+
+  g_replyFd = connectionFd;
+  (void)on_exit(SendExitStatus, NULL);
+
+  RunTool(toolMain, argv);
+}
+
+
+static bool IsAllowedClient(int connectionFd)
+//
+// The tools run with the rights of the server, so only clients with the same user are served.
+//
+{
+  struct ucred credentials;
+  socklen_t    length = sizeof(credentials);
+
+  if(getsockopt(connectionFd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0)
+  {
+    return false;
+  }
+  return credentials.uid == geteuid();
+}
+
+
+static int OpenServerSocket(void)
+{
+  struct sockaddr_un address;
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, CT_SERVER_SOCKET_PATH, sizeof(address.sun_path) - 1);
+
+  int listenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if(listenFd < 0)
+  {
+    return -1;
+  }
+
+  (void)unlink(CT_SERVER_SOCKET_PATH);
+
+  // created with the access rights 0600 from the beginning
+  mode_t oldMask = umask(0077);
+  int result = bind(listenFd, (struct sockaddr*)&address, sizeof(address));
+  (void)umask(oldMask);
+
+  if((result != 0) || (listen(listenFd, SOMAXCONN) != 0))
+  {
+    close(listenFd);
+    return -1;
+  }
+
+  return listenFd;
+}
+
+
+int main(int    argc,
+         char** argv)
+{
+  UNUSED_PARAMETER(argc);
+  UNUSED_PARAMETER(argv);
+
+  int listenFd = OpenServerSocket();
+  if(listenFd < 0)
+  {
+    perror("config_tool_server: cannot open " CT_SERVER_SOCKET_PATH);
+    return SYSTEM_CALL_ERROR;
+  }
+
+  // children are not waited for, the client gets the exit status directly from them
+  (void)signal(SIGCHLD, SIG_IGN);
+  (void)signal(SIGPIPE, SIG_IGN);
+
+  SystemCall_SetHandler(RunResidentSystemCall);
+
+  for(;;)
+  {
+    int connectionFd = accept4(listenFd, NULL, NULL, SOCK_CLOEXEC);
+    if(connectionFd < 0)
+    {
+      continue;
+    }
+
+    if(!IsAllowedClient(connectionFd))
+    {
+      // the client executes the tool itself with its own rights
+      SendReply(connectionFd, false, 0);
+    }
+    else
+    {
+      pid_t pid = fork();
+      if(pid == 0)
+      {
+        close(listenFd);
+        // default disposition, otherwise tools waiting for their own children would not get their status
+        (void)signal(SIGCHLD, SIG_DFL);
+        (void)signal(SIGPIPE, SIG_DFL);
+        HandleConnection(connectionFd);
+      }
+    }
+
+    close(connectionFd);
+  }
+
+  return SUCCESS;
+}
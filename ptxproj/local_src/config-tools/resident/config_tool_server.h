@@ -0,0 +1,61 @@
+//------------------------------------------------------------------------------
+/// Copyright (c) 2000 - 2022 WAGO GmbH & Co. KG
+///
+/// PROPRIETARY RIGHTS of WAGO GmbH & Co. KG are involved in
+/// the subject matter of this material. All manufacturing, reproduction,
+/// use, and sales rights pertaining to this subject matter are governed
+/// by the license agreement. The recipient of this software implicitly
+/// accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///
+///  \file     config_tool_server.h
+///
+///  \brief    Protocol between the resident config tool server and its client.
+///
+///  A request is a single SOCK_SEQPACKET message: a tResidentRequest header
+///  followed by the tool name, its arguments and the environment of the caller
+///  as consecutive zero terminated strings. The stdin, stdout and stderr
+///  descriptors of the caller and its working directory are passed along as
+///  SCM_RIGHTS, so the tool runs in the context of the caller and writes
+///  directly to its output. The server answers with a tResidentReply after the
+///  tool has finished, or right away if it does not run the tool.
+//------------------------------------------------------------------------------
+
+#ifndef _config_tool_server_h_
+#define _config_tool_server_h_
+
+#include <stdint.h>
+
+#define CT_SERVER_SOCKET_PATH               "/var/run/config_tool_server.socket"
+
+#define CT_TOOLS_DIR                        "/etc/config-tools"
+
+// maximum size of a request (header, tool name, all arguments and the environment)
+#define CT_SERVER_MAX_REQUEST_LENGTH        65536
+
+// maximum number of arguments including the tool name
+#define CT_SERVER_MAX_ARGS                  64
+
+// count of descriptors passed with a request: stdin, stdout, stderr, working directory
+#define CT_SERVER_PASSED_FDS                4
+
+// index of the working directory in the passed descriptors
+#define CT_SERVER_CWD_FD_INDEX              3
+
+typedef struct
+{
+  // count of strings following the header that are the tool name and its arguments,
+  // all other strings are environment entries
+  uint32_t argc;
+} tResidentRequest;
+
+typedef struct
+{
+  // 0 if the server does not know the tool, the client has to execute it itself
+  int32_t handled;
+  // exit status of the tool
+  int32_t exitStatus;
+} tResidentReply;
+
+#endif
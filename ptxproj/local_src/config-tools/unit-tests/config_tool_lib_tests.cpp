@@ -157,3 +157,44 @@ TEST(config_tool_lib, run_udev_query)
 #endif
 }
 
+
+static char *HandleTestCall(char const * szSystemCallString, bool * pHandled)
+{
+  *pHandled = (strcmp(szSystemCallString, "handled-call") == 0);
+  return *pHandled ? strdup("handled output") : NULL;
+}
+
+TEST(config_tool_lib, system_call_get_output)
+{
+  char line[MAX_LINE_LENGTH];
+
+  // longer than the initial read buffer
+  char *output = SystemCall_GetOutput("seq 1 2000");
+  CHECK(output != NULL);
+  LONGS_EQUAL(SUCCESS, SystemCall_GetLineByNr(output, 2000, line));
+  STRCMP_EQUAL("2000", line);
+  LONGS_EQUAL(NOT_FOUND, SystemCall_GetLineByNr(output, 2001, line));
+  SystemCall_Destruct(&output);
+  POINTERS_EQUAL(NULL, output);
+
+  SystemCall_SetHandler(HandleTestCall);
+  output = SystemCall_GetOutput("handled-call");
+  STRCMP_EQUAL("handled output", output);
+  SystemCall_Destruct(&output);
+
+  output = SystemCall_GetOutput("echo not handled");
+  STRCMP_EQUAL("not handled\n", output);
+  SystemCall_Destruct(&output);
+  SystemCall_SetHandler(NULL);
+}
+
+TEST(config_tool_lib, proc_file_content_get)
+{
+  // size of files in /proc is reported as 0
+  char *content = ProcFileContent_Get("/proc/self/status");
+  CHECK(content != NULL);
+  CHECK(strstr(content, "Pid:") != NULL);
+  FileContent_Destruct(&content);
+
+  POINTERS_EQUAL(NULL, ProcFileContent_Get("/proc/not-existing"));
+}
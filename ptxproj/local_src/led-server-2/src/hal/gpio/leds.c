@@ -172,20 +172,22 @@ int8_t SetLed(uint8_t led_nr,
   //check if led has already the wanted color
   if(leds[led_nr].state != color)
   {
+    //write only the GPIOs of the colors which really change
+    uint8_t diff = leds[led_nr].state ^ color;
     //set Green LED
-    if(leds[led_nr].fd_grn >= 0)
+    if(leds[led_nr].fd_grn >= 0 && (diff & LED_GREEN))
     {
       char buf = color & LED_GREEN ? '1' : '0';
       write(leds[led_nr].fd_grn, &buf, 1);
     }
     //set Red LED
-    if(leds[led_nr].fd_red >= 0)
+    if(leds[led_nr].fd_red >= 0 && (diff & LED_RED))
     {
       char buf = color & LED_RED ? '1' : '0';
       write(leds[led_nr].fd_red, &buf, 1);
     }
     //set Blue LED
-    if(leds[led_nr].fd_blue >= 0)
+    if(leds[led_nr].fd_blue >= 0 && (diff & LED_BLUE))
     {
       char buf = color & LED_BLUE ? '1' : '0';
       write(leds[led_nr].fd_blue, &buf, 1);
@@ -250,9 +250,20 @@ int8_t SetLed(uint8_t led_nr,
   //check if led has already the wanted color
   if(leds[led_nr].state != color)
   {
-    LED_on_off(leds[led_nr].fd_grn, color & LED_GREEN);
-    LED_on_off(leds[led_nr].fd_red, color & LED_RED);
-    LED_on_off(leds[led_nr].fd_blue, color & LED_BLUE);
+    //write only the brightness files of the colors which really change
+    uint8_t diff = leds[led_nr].state ^ color;
+    if(diff & LED_GREEN)
+    {
+      LED_on_off(leds[led_nr].fd_grn, color & LED_GREEN);
+    }
+    if(diff & LED_RED)
+    {
+      LED_on_off(leds[led_nr].fd_red, color & LED_RED);
+    }
+    if(diff & LED_BLUE)
+    {
+      LED_on_off(leds[led_nr].fd_blue, color & LED_BLUE);
+    }
 
     //set status flags
     leds[led_nr].changed = true;
@@ -132,6 +132,7 @@ typedef struct stLED{
   size_t szDataBuffer;
   void * user_data;
   int  active;
+  int  queuePos;                      /* position in the timer queue or -1 */
 }tLED;
 
 
@@ -162,7 +163,7 @@ int SCHEDULE_SetLedDefaultStatebyName(char*,
                                       uint16_t,
                                       tIdInfo*);
 #endif
-void SCHEDULE_LedScheduleSignal(void);
+void SCHEDULE_LedScheduleSignal(tLedNr ledNr);
 
 void SCHEDULE_InitLeds(void);
 
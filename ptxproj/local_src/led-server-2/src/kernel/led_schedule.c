@@ -31,6 +31,8 @@
 #include <stdlib.h>
 #include <malloc.h>
 #include <string.h>
+#include <strings.h>
+#include <ctype.h>
 #include <time.h>
 #include <sys/time.h>
 #include <limits.h>
@@ -47,9 +49,22 @@
 //------------------------------------------------------------------------------
 
 
+#define LED_QUEUE_NOT_QUEUED  -1
+#define LED_NAME_EMPTY        -1
+
 //------------------------------------------------------------------------------
 // Typedefs
 //------------------------------------------------------------------------------
+typedef struct {
+    tTimeMS nextChange;
+    tLedNr  ledNr;
+}tLedQueueEntry;
+
+typedef struct {
+    uint32_t hash;
+    tLedNr   ledNr;
+    char     name[16];
+}tLedNameEntry;
 
 //------------------------------------------------------------------------------
 // Global variables
@@ -65,6 +80,15 @@ tLedColors              LedColors[]={LED_OFF,//0
 tLED                  * SCHEDULE_led = NULL;
 int                     ledScheduleRun = 0;
 
+//timer queue of the active LEDs ordered by the next change time.
+//protected by mutexLedSchedule
+static tLedQueueEntry * schedQueue = NULL;
+static int              schedQueueSize = 0;
+
+//open addressed hash table for resolving LED names to LED numbers
+static tLedNameEntry  * nameTable = NULL;
+static uint32_t         nameTableMask = 0;
+
 //-- Function: TimespecToTimeMS -----------------------------------------------------
 ///
 /// Convert a struct timespec Value to a tTimeMS value
@@ -93,6 +117,117 @@ static inline void TimeMSToTimespec(struct timespec *tsDest,const tTimeMS *msSrc
   tsDest->tv_nsec = (*msSrc % MSEC_PER_SEC) * NSEC_PER_MSEC;
 }
 
+//-- Function: _QueueSwap -------------------------------------------------------
+///
+/// Swap two entries of the timer queue and keep the queue positions of the
+/// LEDs up to date
+///
+//------------------------------------------------------------------------------
+static inline void _QueueSwap(int a, int b)
+{
+  tLedQueueEntry tmp = schedQueue[a];
+  schedQueue[a] = schedQueue[b];
+  schedQueue[b] = tmp;
+  SCHEDULE_led[schedQueue[a].ledNr].queuePos = a;
+  SCHEDULE_led[schedQueue[b].ledNr].queuePos = b;
+}
+
+static void _QueueSiftUp(int pos)
+{
+  while(pos > 0)
+  {
+    int parent = (pos - 1) / 2;
+    if(schedQueue[parent].nextChange <= schedQueue[pos].nextChange)
+    {
+      break;
+    }
+    _QueueSwap(parent, pos);
+    pos = parent;
+  }
+}
+
+static void _QueueSiftDown(int pos)
+{
+  for(;;)
+  {
+    int child = 2 * pos + 1;
+    if(child >= schedQueueSize)
+    {
+      break;
+    }
+    if(   (child + 1 < schedQueueSize)
+       && (schedQueue[child + 1].nextChange < schedQueue[child].nextChange))
+    {
+      child++;
+    }
+    if(schedQueue[pos].nextChange <= schedQueue[child].nextChange)
+    {
+      break;
+    }
+    _QueueSwap(pos, child);
+    pos = child;
+  }
+}
+
+//-- Function: _QueuePush -------------------------------------------------------
+///
+/// Insert a LED into the timer queue or move it to its new position if it is
+/// already queued. mutexLedSchedule has to be locked by the caller.
+///
+///  \param ledNr      number of the LED
+///  \param nextChange time of the next change of the LED
+///
+//------------------------------------------------------------------------------
+static void _QueuePush(tLedNr ledNr, tTimeMS nextChange)
+{
+  int pos = SCHEDULE_led[ledNr].queuePos;
+
+  if(pos == LED_QUEUE_NOT_QUEUED)
+  {
+    pos = schedQueueSize++;
+    SCHEDULE_led[ledNr].queuePos = pos;
+    schedQueue[pos].ledNr = ledNr;
+    schedQueue[pos].nextChange = nextChange;
+    _QueueSiftUp(pos);
+  }
+  else if(nextChange < schedQueue[pos].nextChange)
+  {
+    schedQueue[pos].nextChange = nextChange;
+    _QueueSiftUp(pos);
+  }
+  else
+  {
+    schedQueue[pos].nextChange = nextChange;
+    _QueueSiftDown(pos);
+  }
+}
+
+//-- Function: _QueuePop --------------------------------------------------------
+///
+/// Remove the LED with the earliest change time from the timer queue.
+/// mutexLedSchedule has to be locked by the caller.
+///
+/// \return number of the removed LED
+//------------------------------------------------------------------------------
+static tLedNr _QueuePop(void)
+{
+  tLedNr ledNr = schedQueue[0].ledNr;
+
+  schedQueueSize--;
+  if(schedQueueSize > 0)
+  {
+    _QueueSwap(0, schedQueueSize);
+    _QueueSiftDown(0);
+  }
+  SCHEDULE_led[ledNr].queuePos = LED_QUEUE_NOT_QUEUED;
+  return ledNr;
+}
+
+static inline tTimeMS _QueueNextChange(void)
+{
+  return (schedQueueSize > 0) ? schedQueue[0].nextChange : END_OF_MSECONDS_64;
+}
+
 //-- Function: LedSchedule -----------------------------------------------------
 ///
 /// The Main-Function of the Scheduler threat
@@ -105,6 +240,13 @@ void *LedSchedule(void)
 
   struct timespec aktTime;
   tTimeMS        actMSec;
+  tLedNr        *dueLeds = malloc(sizeof(tLedNr) * GetNoOfLeds());
+
+  if(dueLeds == NULL)
+  {
+    fprintf(stderr,"ERROR: could not alloc scheduler memory\n");
+    exit(EXIT_FAILURE);
+  }
 
   pthread_mutex_lock(&mutexLedSchedule);
 
@@ -114,68 +256,82 @@ void *LedSchedule(void)
   //The mainloop
   while(ledScheduleRun > 0)
   {
-    int             led_i;             //Iterator for LEDs
+    int             dueCount = 0;
+    int             due_i;             //Iterator for due LEDs
     struct timespec nextChange;
     tTimeMS        nextChangeMSec;
 
-    //set nextChange to an unrealistic Time in future
-    nextChangeMSec = END_OF_MSECONDS_64;
-    
-    //go through LEDs an do the blinking
-    for(led_i = GetNoOfLeds()-1; led_i >= 0 ;led_i--)
+    //take all due LEDs out of the queue first, so every LED changes only
+    //once per wakeup
+    while(schedQueueSize > 0 && schedQueue[0].nextChange <= actMSec)
     {
-      pthread_mutex_lock(&SCHEDULE_led[led_i].mutexBlinkSeq);
-      if(!SCHEDULE_led[led_i].active)
-      {
-    	pthread_mutex_unlock(&SCHEDULE_led[led_i].mutexBlinkSeq);
-        continue;
-      }
+      dueLeds[dueCount++] = _QueuePop();
+    }
 
-      //is it time to change for he LED?
-      if(SCHEDULE_led[led_i].nextChange <= actMSec)
-      {
-        SEQUENTIAL_LedBlinkSequential( (uint16_t)led_i, &actMSec);
-      }
-      //set next time to wake up for the thread
-      if(SCHEDULE_led[led_i].nextChange < nextChangeMSec)
+    //do the blinking only for the due LEDs
+    for(due_i = 0; due_i < dueCount; due_i++)
+    {
+      tLedNr led_i = dueLeds[due_i];
+
+      pthread_mutex_lock(&SCHEDULE_led[led_i].mutexBlinkSeq);
+      if(SCHEDULE_led[led_i].active)
       {
-        nextChangeMSec = SCHEDULE_led[led_i].nextChange;
+        //is it time to change for the LED?
+        if(SCHEDULE_led[led_i].nextChange <= actMSec)
+        {
+          SEQUENTIAL_LedBlinkSequential( (uint16_t)led_i, &actMSec);
+        }
+        //requeue the LED if it is still blinking
+        if(SCHEDULE_led[led_i].active)
+        {
+          _QueuePush(led_i, SCHEDULE_led[led_i].nextChange);
+        }
       }
       pthread_mutex_unlock(&SCHEDULE_led[led_i].mutexBlinkSeq);
-    }//for
-    
+    }
+
+    //set next time to wake up for the thread
+    nextChangeMSec = _QueueNextChange();
+
     //if nothing changed. no LED is blining and the thread can stop
     if(nextChangeMSec == END_OF_MSECONDS_64)
     {
       ledScheduleRun = -1;
     }
     else
-    {    
+    {
       int rc = 0;
-      //wait for next event
-      TimeMSToTimespec(&nextChange, (const tTimeMS*) &nextChangeMSec);
+      //wait for next event, a newly queued LED may wake us up earlier
       do {
-      rc = pthread_cond_timedwait(&condLedSchedule,
-                                  &mutexLedSchedule,
-                                  &nextChange);
-      clock_gettime(LED_SCHED_TIMER_BASE, &aktTime);
-      TimespecToTimeMS(&actMSec,(const struct timespec*) &aktTime);
+        TimeMSToTimespec(&nextChange, (const tTimeMS*) &nextChangeMSec);
+        rc = pthread_cond_timedwait(&condLedSchedule,
+                                    &mutexLedSchedule,
+                                    &nextChange);
+        clock_gettime(LED_SCHED_TIMER_BASE, &aktTime);
+        TimespecToTimeMS(&actMSec,(const struct timespec*) &aktTime);
+        nextChangeMSec = _QueueNextChange();
       }while(actMSec < nextChangeMSec && rc == 0);
     }
 
-    
+
   }//main-loop
   
   pthread_mutex_unlock(&mutexLedSchedule);
+  free(dueLeds);
   pthread_exit(NULL);
 }
 
 
-void SCHEDULE_LedScheduleSignal(void)
+//-- Function: _InitScheduleSync ----------------------------------------------
+///
+/// Initialize the mutex and the condition of the scheduler once. Has to be
+/// called before mutexLedSchedule is used for the first time.
+///
+//------------------------------------------------------------------------------
+static void _InitScheduleSync(void)
 {
   static int     first = 0;//needed for the first call of this function
 
-  DBGFUNC();
   if(!first)
   {
     pthread_condattr_t attr;
@@ -185,9 +341,32 @@ void SCHEDULE_LedScheduleSignal(void)
     pthread_cond_init(&condLedSchedule,&attr);
     pthread_mutex_init(&mutexLedSchedule,NULL);
   }
+}
+
+//-- Function: SCHEDULE_LedScheduleSignal --------------------------------------
+///
+/// Put a LED into the timer queue of the scheduler and wake up the scheduler
+/// thread or start it, if it is not running
+///
+///  \param ledNr number of the LED which got a new blink sequence
+///
+//------------------------------------------------------------------------------
+void SCHEDULE_LedScheduleSignal(tLedNr ledNr)
+{
+  tTimeMS nextChange;
+
+  DBGFUNC();
+  _InitScheduleSync();
 
   pthread_mutex_lock(&mutexLedSchedule);
 
+  //same lock order as the scheduler thread: queue first, then the LED
+  pthread_mutex_lock(&SCHEDULE_led[ledNr].mutexBlinkSeq);
+  nextChange = SCHEDULE_led[ledNr].nextChange;
+  pthread_mutex_unlock(&SCHEDULE_led[ledNr].mutexBlinkSeq);
+
+  _QueuePush(ledNr, nextChange);
+
   //if mutex does not exist, we need to start the tread
   if(ledScheduleRun <= 0)
   {
@@ -299,7 +478,7 @@ tLedReturnCode ledserver_LEDCTRL_SetLed(tLedNr ledNr, tLedStateClass status, voi
       SCHEDULE_led[ledNr].state = status;
       if(SCHEDULE_led[ledNr].active)
       {
-        SCHEDULE_LedScheduleSignal();
+        SCHEDULE_LedScheduleSignal(ledNr);
       }
     }
   }while(0);
@@ -321,6 +500,87 @@ tLedReturnCode ledserver_LEDCTRL_SetLedByName(const char * ledName, tLedStateCla
   return ret;
 }
 
+//-- Function: _HashLedName -----------------------------------------------------
+///
+/// Case insensitive FNV-1a hash of a LED name
+///
+//------------------------------------------------------------------------------
+static uint32_t _HashLedName(const char * name)
+{
+  uint32_t hash = 2166136261u;
+  while(*name)
+  {
+    hash ^= (uint8_t)tolower((unsigned char)*name++);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+//-- Function: _BuildNameTable --------------------------------------------------
+///
+/// Build the hash table for resolving LED names. The LED names are fixed after
+/// InitLed(), so the table is built only once. If the LEDs have no names
+/// (GPIO hal) no table is built.
+///
+//------------------------------------------------------------------------------
+static void _BuildNameTable(void)
+{
+  char     buffer[16];
+  uint32_t tableSize = 4;
+  tLedNr   ledNr;
+
+  if(nameTable != NULL)
+  {
+    return;
+  }
+  if(   (GetNoOfLeds() == 0)
+     || (0 != GetLedBaseName((uint8_t) 0, buffer))
+     || (!strcmp(buffer,"GPIO")))
+  {
+    return;
+  }
+  //keep the load factor below 50%
+  while(tableSize < (uint32_t)GetNoOfLeds() * 2)
+  {
+    tableSize <<= 1;
+  }
+  nameTable = malloc(sizeof(tLedNameEntry) * tableSize);
+  if(nameTable == NULL)
+  {
+    fprintf(stderr,"ERROR: could not alloc led name memory\n");
+    exit(EXIT_FAILURE);
+  }
+  nameTableMask = tableSize - 1;
+  for(ledNr = 0; ledNr < (tLedNr)tableSize; ledNr++)
+  {
+    nameTable[ledNr].ledNr = LED_NAME_EMPTY;
+  }
+  for(ledNr = 0; ledNr < GetNoOfLeds(); ledNr++)
+  {
+    uint32_t hash;
+    uint32_t slot;
+    GetLedBaseName((uint8_t) ledNr, buffer);
+    hash = _HashLedName(buffer);
+    slot = hash & nameTableMask;
+    while(nameTable[slot].ledNr != LED_NAME_EMPTY)
+    {
+      //the first LED with a name wins like in the former linear search
+      if(nameTable[slot].hash == hash && !strcasecmp(buffer, nameTable[slot].name))
+      {
+        break;
+      }
+      slot = (slot + 1) & nameTableMask;
+    }
+    if(nameTable[slot].ledNr == LED_NAME_EMPTY)
+    {
+      nameTable[slot].hash  = hash;
+      nameTable[slot].ledNr = ledNr;
+      strncpy(nameTable[slot].name, buffer, sizeof(nameTable[slot].name) - 1);
+      nameTable[slot].name[sizeof(nameTable[slot].name) - 1] = 0;
+    }
+  }
+}
+
 //-- Function: InitLeds --------------------------------------------------------
 ///
 /// Initiate LED-Structures to get defined start-values
@@ -342,11 +602,22 @@ tLedReturnCode ledserver_LEDCTRL_Init(void)
     SCHEDULE_led = malloc(sizeof(tLED) * GetNoOfLeds());
     memset(SCHEDULE_led,0,sizeof(tLED) * GetNoOfLeds());
   }
-  if(SCHEDULE_led == NULL)
+  if(schedQueue == NULL)
+  {
+    schedQueue = malloc(sizeof(tLedQueueEntry) * GetNoOfLeds());
+    schedQueueSize = 0;
+  }
+  if(SCHEDULE_led == NULL || schedQueue == NULL)
   {
     fprintf(stderr,"ERROR: could not alloc led memory\n");
     exit(EXIT_FAILURE);
   }
+  _BuildNameTable();
+
+  _InitScheduleSync();
+  pthread_mutex_lock(&mutexLedSchedule);
+  schedQueueSize = 0;
+  pthread_mutex_unlock(&mutexLedSchedule);
 
   //set all LED off
   for(lednr=0; lednr < GetNoOfLeds(); lednr++)
@@ -360,6 +631,7 @@ tLedReturnCode ledserver_LEDCTRL_Init(void)
     SCHEDULE_led[lednr].szData             = 0;
     SCHEDULE_led[lednr].szDataBuffer       = 0;
     SCHEDULE_led[lednr].user_data          = NULL;
+    SCHEDULE_led[lednr].queuePos           = LED_QUEUE_NOT_QUEUED;
     pthread_mutex_init(&SCHEDULE_led[lednr].mutexBlinkSeq,NULL);
     DelLed(lednr);
   }
@@ -481,9 +753,8 @@ tLedReturnCode ledserver_LEDCTRL_GetLedName(tLedNr ledNr, char * ledNameBuffer,s
 }
 tLedReturnCode ledserver_LEDCTRL_GetLedNumber(const char * ledName,tLedNr * pLedNr)
 {
-  tLedNr ledNr;
-  tLedReturnCode ret = LED_RETURN_ERROR_NAME;
-  char buffer[16];
+  uint32_t hash;
+  uint32_t slot;
   if(pLedNr == NULL)
   {
     return LED_RETURN_ERROR_PARAMETER;
@@ -492,23 +763,22 @@ tLedReturnCode ledserver_LEDCTRL_GetLedNumber(const char * ledName,tLedNr * pLed
   {
     return LED_RETURN_ERROR_PARAMETER;
   }
-  GetLedBaseName((uint8_t) 0, buffer);
-  if(!strcmp(buffer,"GPIO"))
+  if(nameTable == NULL)
   {
     return LED_RETURN_ERROR_NO_NAME_AVAILABLE;
   }
-  for(ledNr = 0; ledNr < GetNoOfLeds(); ledNr++)
+  hash = _HashLedName(ledName);
+  for(slot = hash & nameTableMask;
+      nameTable[slot].ledNr != LED_NAME_EMPTY;
+      slot = (slot + 1) & nameTableMask)
   {
-
-    GetLedBaseName((uint8_t) ledNr, buffer);
-    if(!strcasecmp(ledName, buffer))
+    if(nameTable[slot].hash == hash && !strcasecmp(ledName, nameTable[slot].name))
     {
-      ret = LED_RETURN_OK;
-      *pLedNr = ledNr;
-      break;
+      *pLedNr = nameTable[slot].ledNr;
+      return LED_RETURN_OK;
     }
   }
-  return ret;
+  return LED_RETURN_ERROR_NAME;
 }
 
 tLedNr ledserver_LEDCTRL_GetLedCount(void)
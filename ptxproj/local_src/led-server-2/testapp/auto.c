@@ -18,10 +18,138 @@
 //------------------------------------------------------------------------------
 
 #include "testapp.h"
+#include "ledmisc.h"
+#include <ledserver_API.h>
 
-tTestCase autoTests[] =
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#define BENCHMARK_DURATION_SEC   30
+#define BENCHMARK_LOOKUPS        1000000
+
+static double _TimevalToSec(const struct timeval * tv)
+{
+  return (double)tv->tv_sec + (double)tv->tv_usec / 1000000.0;
+}
+
+static double _GetCpuTime(void)
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return _TimevalToSec(&usage.ru_utime) + _TimevalToSec(&usage.ru_stime);
+}
+
+//set every LED into a different complex blink sequence and measure the CPU
+//time the scheduler needs while all LEDs are blinking
+static int _Benchmark_AllLedsBlinking(void)
+{
+  tLedNr ledCount = ledserver_LEDCTRL_GetLedCount();
+  tLedNr i;
+  double cpuStart;
+  double cpuUsed;
+  char   result[1024];
+
+  for(i = 0; i < ledCount; i++)
+  {
+    tLedReturnCode ret;
+    switch(i % 3)
+    {
+      case 0:
+      {
+        //750 error codes run through preamble, code and argument periods
+        tLed750 err750 = { .errorCode = (uint16_t)(1 + i % 10), .errorArg = (uint16_t)(1 + i % 7) };
+        ret = ledserver_LEDCTRL_SetLed(i, LED_STATE_750_ERR, &err750, NULL);
+        break;
+      }
+      case 1:
+      {
+        tLedRocketErr3 rocket = { .errorGroup = (uint8_t)(1 + i % 4), .errorCode = (uint8_t)(1 + i % 5), .errorAddress = (uint16_t)(1 + i) };
+        ret = ledserver_LEDCTRL_SetLed(i, LED_STATE_ROCKET_ERR3, &rocket, NULL);
+        break;
+      }
+      default:
+      {
+        tLedBlink blink = { .color1 = LED_COLOR_GREEN, .color2 = LED_COLOR_RED, .time1 = (uint16_t)(50 + 10 * i), .time2 = 50 };
+        ret = ledserver_LEDCTRL_SetLed(i, LED_STATE_BLINK, &blink, NULL);
+        break;
+      }
+    }
+    if(ret != LED_RETURN_OK)
+    {
+      sprintf(result,"Fehler: set LED %d, %s", i, GetErrorString(ret));
+      TestLogger((const char *)result);
+      return 0;
+    }
+  }
+
+  cpuStart = _GetCpuTime();
+  sleep(BENCHMARK_DURATION_SEC);
+  cpuUsed = _GetCpuTime() - cpuStart;
+
+  sprintf(result,"%d LEDs blinking for %d s: cpu time %.3f ms (%.4f%% cpu)",
+          ledCount, BENCHMARK_DURATION_SEC, cpuUsed * 1000.0,
+          cpuUsed * 100.0 / BENCHMARK_DURATION_SEC);
+  TestLogger((const char *)result);
+
+  for(i = 0; i < ledCount; i++)
+  {
+    tLedStatic off = LED_COLOR_OFF;
+    ledserver_LEDCTRL_SetLed(i, LED_STATE_STATIC, &off, NULL);
+  }
+  return 1;
+}
+
+//measure the time needed to resolve LED names
+static int _Benchmark_GetLedNumber(void)
 {
+  tLedNr ledCount = ledserver_LEDCTRL_GetLedCount();
+  struct timespec start;
+  struct timespec end;
+  char   names[64][16];
+  char   result[1024];
+  tLedNr nameCount = 0;
+  tLedNr ledNr;
+  double duration;
+  long   i;
+
+  for(ledNr = 0; ledNr < ledCount && nameCount < 64; ledNr++)
+  {
+    ledserver_LEDCTRL_GetLedName(ledNr, names[nameCount], sizeof(names[nameCount]));
+    names[nameCount][sizeof(names[nameCount]) - 1] = 0;
+    nameCount++;
+  }
+  if(nameCount == 0 || LED_RETURN_OK != ledserver_LEDCTRL_GetLedNumber(names[0], &ledNr))
+  {
+    TestLogger("LEDs have no names, skip name lookup benchmark");
+    return 1;
+  }
 
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(i = 0; i < BENCHMARK_LOOKUPS; i++)
+  {
+    if(LED_RETURN_OK != ledserver_LEDCTRL_GetLedNumber(names[i % nameCount], &ledNr))
+    {
+      sprintf(result,"Fehler: name %s not found", names[i % nameCount]);
+      TestLogger((const char *)result);
+      return 0;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  duration = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1000000000.0;
+
+  sprintf(result,"%d name lookups: %.1f ns per lookup", BENCHMARK_LOOKUPS,
+          duration * 1000000000.0 / BENCHMARK_LOOKUPS);
+  TestLogger((const char *)result);
+  return 1;
+}
+
+tTestCase autoTests[] =
+{
+ { .name="benchblink",  .help="CPU-Last messen während alle LEDs blinken" , .function=_Benchmark_AllLedsBlinking},
+ { .name="benchname",   .help="Namensauflösung der LEDs messen" ,          .function=_Benchmark_GetLedNumber},
 };
 
 size_t numberOfAutoTests = sizeof(autoTests)/sizeof(tTestCase);
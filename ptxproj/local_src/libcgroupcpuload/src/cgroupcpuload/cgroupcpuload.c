@@ -42,10 +42,18 @@
 #define SINGLECORE_THRESHOLD2 75U  // show value of most loaded core instead of average of all cores
 #define SINGLECORE_THRESHOLD1 50U  // show mix of most loaded core and average of all cores
 
+#define CGROUP_V1_CPUACCT_PATH "/sys/fs/cgroup/cpuacct"
+#define CGROUP_V2_PATH         "/sys/fs/cgroup"
+#define CPU_STAT_BUFFER_SIZE   512U
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
+static ssize_t cgroupcpuload_read_file(int fd, char * buffer, size_t size);
 static void cgroupcpuload_read_runtime(struct cgroupcpuload * cgroupcpuload);
+static void cgroupcpuload_read_runtime_v2(struct cgroupcpuload * cgroupcpuload);
+static void cgroupcpuload_parse_cpu_stat(char * buffer, struct cgroupcpuload_stat * stat);
+static int cgroupcpuload_parse_pressure(char * buffer, struct cgroupcpuload_stat * stat);
 
 //------------------------------------------------------------------------------
 // macros
@@ -69,45 +77,68 @@ DLL_DECL struct cgroupcpuload * cgroupcpuload_init(char const * const cgroup_pat
   struct cgroupcpuload *cgroupcpuload = calloc(1, sizeof(*cgroupcpuload));
   int    fd;
 
-  snprintf(path, sizeof(path), "/sys/fs/cgroup/cpuacct/%s/cpuacct.usage_percpu", cgroup_path);
-  fd = open(path, O_RDONLY | O_NOATIME);
-
-  if (fd == -1)
+  if (cgroupcpuload == NULL)
   {
-    ERROR("open (%s, ..) failed: %s", path, strerror(errno));
+    ERROR("calloc failed: %s", strerror(errno));
     return NULL;
   }
 
-  cgroupcpuload->cpuacct_usage_fd = fd;
+  cgroupcpuload->cpuacct_usage_fd = -1;
+  cgroupcpuload->cpu_stat_fd      = -1;
+  cgroupcpuload->cpu_pressure_fd  = -1;
   cgroupcpuload->cpu_cores        = 1;
   cgroupcpuload->runtime_core     = NULL;
   cgroupcpuload->runtime_core_old = NULL;
   cgroupcpuload->load_core        = NULL;
 
-  lseek(cgroupcpuload->cpuacct_usage_fd, 0, SEEK_SET);
-  ssize_t const length = read(cgroupcpuload->cpuacct_usage_fd, buffer, sizeof(buffer) - 1U);
+  snprintf(path, sizeof(path), CGROUP_V1_CPUACCT_PATH "/%s/cpuacct.usage_percpu", cgroup_path);
+  fd = open(path, O_RDONLY | O_NOATIME);
 
-  if (length > 0)
+  if (fd != -1)
   {
-	  buffer[length-1] = '\0';
-
-	  for (int i = 0; i < length; i++)
-	  {
-	    if ((buffer[i] == ' ') && (buffer[i+1] > ' '))
-	    {
-	      cgroupcpuload->cpu_cores++;
-	    }
-    }
+    cgroupcpuload->version          = CGROUPCPULOAD_V1;
+    cgroupcpuload->cpuacct_usage_fd = fd;
+
+    ssize_t const length = cgroupcpuload_read_file(fd, buffer, sizeof(buffer));
 
-    cgroupcpuload->runtime_core     = calloc(1, cgroupcpuload->cpu_cores * sizeof(uint64_t));
-    cgroupcpuload->runtime_core_old = calloc(1, cgroupcpuload->cpu_cores * sizeof(uint64_t));
-    cgroupcpuload->load_core        = calloc(1, cgroupcpuload->cpu_cores * sizeof(uint32_t));
+    for (int i = 0; i < length; i++)
+    {
+      if ((buffer[i] == ' ') && (buffer[i+1] > ' '))
+      {
+        cgroupcpuload->cpu_cores++;
+      }
+    }
+  }
+  else
+  {
+    // no cpuacct controller: cgroup v2, cpu.stat exists in every cgroup
+    snprintf(path, sizeof(path), CGROUP_V2_PATH "/%s/cpu.stat", cgroup_path);
+    fd = open(path, O_RDONLY | O_NOATIME);
 
-    if ((cgroupcpuload->runtime_core == NULL) || (cgroupcpuload->load_core == NULL) || (cgroupcpuload->runtime_core_old == NULL))
+    if (fd == -1)
     {
-      ERROR("calloc failed: %s", strerror(errno));
+      ERROR("open (%s, ..) failed: %s", path, strerror(errno));
+      free(cgroupcpuload);
       return NULL;
     }
+
+    cgroupcpuload->version     = CGROUPCPULOAD_V2;
+    cgroupcpuload->cpu_stat_fd = fd;
+
+    // missing without CONFIG_PSI or with psi=0
+    snprintf(path, sizeof(path), CGROUP_V2_PATH "/%s/cpu.pressure", cgroup_path);
+    cgroupcpuload->cpu_pressure_fd = open(path, O_RDONLY | O_NOATIME);
+  }
+
+  cgroupcpuload->runtime_core     = calloc(1, cgroupcpuload->cpu_cores * sizeof(uint64_t));
+  cgroupcpuload->runtime_core_old = calloc(1, cgroupcpuload->cpu_cores * sizeof(uint64_t));
+  cgroupcpuload->load_core        = calloc(1, cgroupcpuload->cpu_cores * sizeof(uint32_t));
+
+  if ((cgroupcpuload->runtime_core == NULL) || (cgroupcpuload->load_core == NULL) || (cgroupcpuload->runtime_core_old == NULL))
+  {
+    ERROR("calloc failed: %s", strerror(errno));
+    cgroupcpuload_destroy(cgroupcpuload);
+    return NULL;
   }
 
   cgroupcpuload_get_load(cgroupcpuload);
@@ -128,7 +159,18 @@ DLL_DECL void cgroupcpuload_destroy(struct cgroupcpuload * cgroupcpuload)
 
   if (cgroupcpuload != NULL)
   {
-     close(cgroupcpuload->cpuacct_usage_fd);
+    if (cgroupcpuload->cpuacct_usage_fd != -1)
+    {
+      close(cgroupcpuload->cpuacct_usage_fd);
+    }
+    if (cgroupcpuload->cpu_stat_fd != -1)
+    {
+      close(cgroupcpuload->cpu_stat_fd);
+    }
+    if (cgroupcpuload->cpu_pressure_fd != -1)
+    {
+      close(cgroupcpuload->cpu_pressure_fd);
+    }
     if (cgroupcpuload->runtime_core != NULL)
     {
       free(cgroupcpuload->runtime_core);
@@ -161,7 +203,14 @@ DLL_DECL uint32_t cgroupcpuload_get_load(struct cgroupcpuload * cgroupcpuload)
     return 0U;
   }
 
-  cgroupcpuload_read_runtime(cgroupcpuload);
+  if (cgroupcpuload->version == CGROUPCPULOAD_V2)
+  {
+    cgroupcpuload_read_runtime_v2(cgroupcpuload);
+  }
+  else
+  {
+    cgroupcpuload_read_runtime(cgroupcpuload);
+  }
 
   if (clock_gettime(CLOCK_MONOTONIC, &timespec) != 0)
   {
@@ -216,6 +265,53 @@ DLL_DECL uint32_t cgroupcpuload_get_load(struct cgroupcpuload * cgroupcpuload)
 }
 
 
+//------------------------------------------------------------------------------
+DLL_DECL int cgroupcpuload_get_stat(struct cgroupcpuload * cgroupcpuload,
+                                    struct cgroupcpuload_stat * stat)
+{
+  char buffer[CPU_STAT_BUFFER_SIZE];
+
+  if ((cgroupcpuload == NULL) || (stat == NULL) || (cgroupcpuload->version != CGROUPCPULOAD_V2))
+  {
+    return -1;
+  }
+
+  memset(stat, 0, sizeof(*stat));
+
+  if (cgroupcpuload_read_file(cgroupcpuload->cpu_stat_fd, buffer, sizeof(buffer)) < 0)
+  {
+    return -1;
+  }
+  cgroupcpuload_parse_cpu_stat(buffer, stat);
+
+  if (   (cgroupcpuload->cpu_pressure_fd != -1)
+      && (cgroupcpuload_read_file(cgroupcpuload->cpu_pressure_fd, buffer, sizeof(buffer)) >= 0))
+  {
+    stat->pressure_valid = cgroupcpuload_parse_pressure(buffer, stat);
+  }
+
+  return 0;
+}
+
+
+//------------------------------------------------------------------------------
+static ssize_t cgroupcpuload_read_file(int fd, char * buffer, size_t size)
+{
+  // cgroup files are regenerated on each read from offset 0, no lseek needed
+  ssize_t const length = pread(fd, buffer, size - 1U, 0);
+
+  if (length < 0)
+  {
+    ERROR("pread failed: %s", strerror(errno));
+    buffer[0] = '\0';
+    return -1;
+  }
+
+  buffer[length] = '\0';
+  return length;
+}
+
+
 //------------------------------------------------------------------------------
 static void cgroupcpuload_read_runtime(struct cgroupcpuload * cgroupcpuload)
 {
@@ -225,11 +321,9 @@ static void cgroupcpuload_read_runtime(struct cgroupcpuload * cgroupcpuload)
   uint64_t result = 0;
   const char * const uint64_format = "%" PRIu64 "\n";
 
-  lseek(cgroupcpuload->cpuacct_usage_fd, 0, SEEK_SET);
-  ssize_t const length = read(cgroupcpuload->cpuacct_usage_fd, buffer, sizeof(buffer) - 1U);
+  ssize_t const length = cgroupcpuload_read_file(cgroupcpuload->cpuacct_usage_fd, buffer, sizeof(buffer));
   if (length > 0)
   {
-    buffer[length] = '\0';
     DBG("buffer %s", buffer);
 
     for (int pos = 0; pos < length; pos++)
@@ -256,5 +350,103 @@ static void cgroupcpuload_read_runtime(struct cgroupcpuload * cgroupcpuload)
 }
 
 
+//------------------------------------------------------------------------------
+static void cgroupcpuload_read_runtime_v2(struct cgroupcpuload * cgroupcpuload)
+{
+  char buffer[CPU_STAT_BUFFER_SIZE];
+  struct cgroupcpuload_stat stat;
+
+  memset(&stat, 0, sizeof(stat));
+
+  if (cgroupcpuload_read_file(cgroupcpuload->cpu_stat_fd, buffer, sizeof(buffer)) > 0)
+  {
+    cgroupcpuload_parse_cpu_stat(buffer, &stat);
+
+    // runtime of all cores together, in nanoseconds like cpuacct
+    cgroupcpuload->runtime_core_old[0] = cgroupcpuload->runtime_core[0];
+    cgroupcpuload->runtime_core[0]     = stat.usage_usec * 1000U;
+    DBG("runtime %" PRIu64 " throttled %" PRIu64, cgroupcpuload->runtime_core[0], stat.throttled_usec);
+  }
+}
+
+
+//------------------------------------------------------------------------------
+static void cgroupcpuload_parse_cpu_stat(char * buffer, struct cgroupcpuload_stat * stat)
+{
+  char * saveptr = NULL;
+  char   key[32];
+  uint64_t value;
+
+  // "key value" lines, unknown keys are ignored
+  for (char * line = strtok_r(buffer, "\n", &saveptr); line != NULL; line = strtok_r(NULL, "\n", &saveptr))
+  {
+    if (sscanf(line, "%31s %" SCNu64, key, &value) != 2)
+    {
+      continue;
+    }
+
+    if (strcmp(key, "usage_usec") == 0)
+    {
+      stat->usage_usec = value;
+    }
+    else if (strcmp(key, "nr_periods") == 0)
+    {
+      stat->nr_periods = value;
+    }
+    else if (strcmp(key, "nr_throttled") == 0)
+    {
+      stat->nr_throttled = value;
+    }
+    else if (strcmp(key, "throttled_usec") == 0)
+    {
+      stat->throttled_usec = value;
+    }
+  }
+}
+
+
+//------------------------------------------------------------------------------
+static int cgroupcpuload_parse_pressure(char * buffer, struct cgroupcpuload_stat * stat)
+{
+  char * saveptr = NULL;
+  char   kind[8];
+  unsigned int avg[6];
+  uint64_t total;
+  int    lines = 0;
+
+  // "some avg10=0.12 avg60=0.00 avg300=0.00 total=1234", same for "full"
+  for (char * line = strtok_r(buffer, "\n", &saveptr); line != NULL; line = strtok_r(NULL, "\n", &saveptr))
+  {
+    if (sscanf(line, "%7s avg10=%u.%u avg60=%u.%u avg300=%u.%u total=%" SCNu64,
+               kind, &avg[0], &avg[1], &avg[2], &avg[3], &avg[4], &avg[5], &total) != 8)
+    {
+      continue;
+    }
+
+    struct cgroupcpuload_pressure * pressure = NULL;
+    if (strcmp(kind, "some") == 0)
+    {
+      pressure = &stat->some;
+    }
+    else if (strcmp(kind, "full") == 0)
+    {
+      pressure = &stat->full;
+    }
+
+    if (pressure != NULL)
+    {
+      // the kernel prints two decimal places
+      pressure->avg10      = (avg[0] * 100U) + avg[1];
+      pressure->avg60      = (avg[2] * 100U) + avg[3];
+      pressure->avg300     = (avg[4] * 100U) + avg[5];
+      pressure->total_usec = total;
+      lines++;
+    }
+  }
+
+  return (lines > 0) ? 1 : 0;
+}
+
+
 
 //---- End of source file ------------------------------------------------------
@@ -25,6 +25,32 @@
 // defines; structure, enumeration and type definitions
 //------------------------------------------------------------------------------
 
+enum cgroupcpuload_version
+{
+  CGROUPCPULOAD_V1 = 1,  // cpuacct controller, per core runtime
+  CGROUPCPULOAD_V2 = 2   // unified hierarchy, cpu.stat and cpu.pressure
+};
+
+// pressure stall information of one line ("some" or "full") of cpu.pressure
+struct cgroupcpuload_pressure
+{
+  uint32_t avg10;        // in hundredths of a percent
+  uint32_t avg60;        // in hundredths of a percent
+  uint32_t avg300;       // in hundredths of a percent
+  uint64_t total_usec;
+};
+
+struct cgroupcpuload_stat
+{
+  uint64_t usage_usec;
+  uint64_t nr_periods;
+  uint64_t nr_throttled;
+  uint64_t throttled_usec;
+  int      pressure_valid; // 0 if the kernel provides no pressure stall information
+  struct cgroupcpuload_pressure some;
+  struct cgroupcpuload_pressure full;
+};
+
 struct cgroupcpuload
 {
   uint64_t   timestamp;
@@ -33,6 +59,9 @@ struct cgroupcpuload
   uint32_t * load_core;
   uint16_t   cpu_cores;
   int        cpuacct_usage_fd;
+  enum cgroupcpuload_version version;
+  int        cpu_stat_fd;
+  int        cpu_pressure_fd;
 };
 
 //------------------------------------------------------------------------------
@@ -44,6 +73,14 @@ extern "C"
 #endif // __cplusplus
 
 
+  //
+  //  struct cgroupcpuload * cgroupcpuload_init(char const * cgroup_path);
+  //
+  //  Uses the cgroup v1 cpuacct controller if it is mounted, the cgroup v2
+  //  hierarchy below /sys/fs/cgroup otherwise. The files are kept open and
+  //  are read with pread on each call.
+  //
+
   struct cgroupcpuload * cgroupcpuload_init(char const * cgroup_path);
 
   void cgroupcpuload_destroy(struct cgroupcpuload * cgroupcpuload);
@@ -61,9 +98,24 @@ extern "C"
   //  2: highest core load is above 50 % > then medium value between the highest and the average value is the result
   //  3: highest core load is above 75%  > the highest core load is resulted
   //
+  //  On cgroup v2 only the runtime of all cores together is known; it is
+  //  evaluated like the load of a single core, so one fully loaded core
+  //  results in 100%.
+  //
 
   uint32_t cgroupcpuload_get_load(struct cgroupcpuload * cgroupcpuload);
 
+  //
+  //  int cgroupcpuload_get_stat(struct cgroupcpuload * cgroupcpuload,
+  //                             struct cgroupcpuload_stat * stat);
+  //
+  //  Reads the current throttling counters and pressure stall information.
+  //  Returns 0 on success, -1 on error or if the cgroup is no cgroup v2 one.
+  //
+
+  int cgroupcpuload_get_stat(struct cgroupcpuload * cgroupcpuload,
+                             struct cgroupcpuload_stat * stat);
+
 
   #ifdef __cplusplus
 } // extern "C"
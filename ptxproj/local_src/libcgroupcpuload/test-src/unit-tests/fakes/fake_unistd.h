@@ -23,6 +23,7 @@
 DECLARE_FAKE_VALUE_FUNC1(int, close, int);
 DECLARE_FAKE_VALUE_FUNC3(off_t,lseek,int,off_t,int);
 DECLARE_FAKE_VALUE_FUNC3(ssize_t,read,int,void *,size_t);
+DECLARE_FAKE_VALUE_FUNC4(ssize_t,pread,int,void *,size_t,off_t);
 
 
 #endif
@@ -20,6 +20,7 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <algorithm>
 
 #ifdef __cplusplus
 extern "C" {
@@ -58,6 +59,7 @@ DEFINE_FFF_GLOBALS;
     FAKE(close) \
     FAKE(lseek) \
     FAKE(read)  \
+    FAKE(pread) \
     FAKE(free)  \
     FAKE(clock_gettime)
 
@@ -65,6 +67,25 @@ static const char * cgrouprts = "rts";
 static uint64_t timecounter_base = 1000;
 static uint64_t timecounter_inc  = 0;
 
+// cgroup v2 fixtures as written by the kernel
+static const char * fixture_cpu_stat =
+  "usage_usec 8234567\n"
+  "user_usec 5000000\n"
+  "system_usec 3234567\n"
+  "nr_periods 1200\n"
+  "nr_throttled 37\n"
+  "throttled_usec 456789\n"
+  "nr_bursts 0\n"
+  "burst_usec 0\n";
+static const char * fixture_cpu_pressure =
+  "some avg10=1.52 avg60=0.87 avg300=0.20 total=123456\n"
+  "full avg10=0.75 avg60=10.40 avg300=0.05 total=65432\n";
+
+static const int cpu_stat_fd     = 43;
+static const int cpu_pressure_fd = 44;
+static bool      psi_available   = true;
+static bool      stat_fixture    = false;
+
 
 //------------------------------------------------------------------------------
 // custom fakes
@@ -83,7 +104,7 @@ static int open_custom_fake(const char * path, int flags, va_list mode)
 }
 
 static ssize_t read_fake_return;
-static ssize_t read_custom_fake(int file, void * buffer, size_t maxsize)
+static ssize_t read_custom_fake(int file, void * buffer, size_t maxsize, off_t offset)
 {
   sprintf((char *) buffer,"%lli %lli\n", timecounter_base * timecounter_inc,timecounter_base * timecounter_inc);
 
@@ -92,6 +113,51 @@ static ssize_t read_custom_fake(int file, void * buffer, size_t maxsize)
   return read_fake_return;
 }
 
+// cgroup v2: no cpuacct controller
+static int open_v2_custom_fake(const char * path, int flags, va_list mode)
+{
+  if (strstr(path, "/cpu.stat") != nullptr)
+  {
+    return cpu_stat_fd;
+  }
+  if ((strstr(path, "/cpu.pressure") != nullptr) && psi_available)
+  {
+    return cpu_pressure_fd;
+  }
+  return -1;
+}
+
+static int open_none_custom_fake(const char * path, int flags, va_list mode)
+{
+  return -1;
+}
+
+static ssize_t pread_fixture(const char * fixture, void * buffer, size_t maxsize)
+{
+  size_t const length = std::min(strlen(fixture), maxsize);
+  memcpy(buffer, fixture, length);
+  return (ssize_t) length;
+}
+
+// without stat_fixture the usage counter of cpu.stat grows with each read for load calculation
+static ssize_t pread_v2_custom_fake(int file, void * buffer, size_t maxsize, off_t offset)
+{
+  if (file == cpu_pressure_fd)
+  {
+    return pread_fixture(fixture_cpu_pressure, buffer, maxsize);
+  }
+  if (stat_fixture)
+  {
+    return pread_fixture(fixture_cpu_stat, buffer, maxsize);
+  }
+
+  char stat[128];
+  snprintf(stat, sizeof(stat), "usage_usec %llu\nnr_throttled 0\n",
+           (unsigned long long) (timecounter_inc * timecounter_base / 1000));
+  timecounter_inc++;
+  return pread_fixture(stat, buffer, maxsize);
+}
+
 static int clock_gettime_fake_return;
 static int clock_gettime_custom_fake(clockid_t clockid, timespec * timerval)
 {
@@ -112,6 +178,9 @@ class test_cgroupcpuload : public::testing::Test
     void SetUp() override
     {
         reset_fakes();
+        timecounter_inc = 0;
+        psi_available   = true;
+        stat_fixture    = false;
     }
 
     void TearDown() override {}
@@ -123,7 +192,7 @@ TEST_F(test_cgroupcpuload, dummy_test)
     uint32_t load ;
 
     open_fake.custom_fake          = open_custom_fake;
-    read_fake.custom_fake          = read_custom_fake;
+    pread_fake.custom_fake         = read_custom_fake;
     clock_gettime_fake.custom_fake = clock_gettime_custom_fake;
 
     cgroupcpuload = cgroupcpuload_init(cgrouprts);
@@ -144,8 +213,9 @@ TEST_F(test_cgroupcpuload, dummy_test)
 
     // calls in init
     ASSERT_EQ(fff.call_history[0], (void *)open);
-    ASSERT_EQ(fff.call_history[1], (void *)lseek);
-    ASSERT_EQ(fff.call_history[2], (void *)read);
+    ASSERT_EQ(fff.call_history[1], (void *)pread);
+    ASSERT_EQ(lseek_fake.call_count, 0);
+    ASSERT_EQ(read_fake.call_count, 0);
 
     /*
     // calls in destroy
@@ -155,3 +225,111 @@ TEST_F(test_cgroupcpuload, dummy_test)
     ASSERT_EQ(fff.call_history[6], (void *)free);
     */
 }
+
+TEST_F(test_cgroupcpuload, v1_has_no_stat)
+{
+    cgroupcpuload_stat stat;
+
+    open_fake.custom_fake          = open_custom_fake;
+    pread_fake.custom_fake         = read_custom_fake;
+    clock_gettime_fake.custom_fake = clock_gettime_custom_fake;
+
+    cgroupcpuload * cgroupcpuload = cgroupcpuload_init(cgrouprts);
+
+    ASSERT_NE(cgroupcpuload, nullptr);
+    EXPECT_EQ(cgroupcpuload->version, CGROUPCPULOAD_V1);
+    EXPECT_EQ(cgroupcpuload_get_stat(cgroupcpuload, &stat), -1);
+
+    cgroupcpuload_destroy(cgroupcpuload);
+}
+
+TEST_F(test_cgroupcpuload, v2_load)
+{
+    open_fake.custom_fake          = open_v2_custom_fake;
+    pread_fake.custom_fake         = pread_v2_custom_fake;
+    clock_gettime_fake.custom_fake = clock_gettime_custom_fake;
+
+    cgroupcpuload * cgroupcpuload = cgroupcpuload_init(cgrouprts);
+
+    ASSERT_NE(cgroupcpuload, nullptr);
+    EXPECT_EQ(cgroupcpuload->version, CGROUPCPULOAD_V2);
+    EXPECT_EQ(cgroupcpuload->cpu_cores, 1);
+
+    // usage grows by half of the elapsed time
+    EXPECT_EQ(cgroupcpuload_get_load(cgroupcpuload), 50);
+    EXPECT_EQ(cgroupcpuload_get_load(cgroupcpuload), 50);
+    EXPECT_EQ(cgroupcpuload_get_load(cgroupcpuload), 50);
+
+    cgroupcpuload_destroy(cgroupcpuload);
+
+    // cpuacct, cpu.stat and cpu.pressure are opened once, the open files are closed
+    ASSERT_EQ(open_fake.call_count, 3);
+    ASSERT_EQ(close_fake.call_count, 2);
+    ASSERT_EQ(lseek_fake.call_count, 0);
+    ASSERT_EQ(read_fake.call_count, 0);
+}
+
+TEST_F(test_cgroupcpuload, v2_stat)
+{
+    cgroupcpuload_stat stat;
+
+    open_fake.custom_fake          = open_v2_custom_fake;
+    pread_fake.custom_fake         = pread_v2_custom_fake;
+    clock_gettime_fake.custom_fake = clock_gettime_custom_fake;
+
+    cgroupcpuload * cgroupcpuload = cgroupcpuload_init(cgrouprts);
+    ASSERT_NE(cgroupcpuload, nullptr);
+
+    stat_fixture = true;
+    ASSERT_EQ(cgroupcpuload_get_stat(cgroupcpuload, &stat), 0);
+
+    EXPECT_EQ(stat.usage_usec, 8234567);
+    EXPECT_EQ(stat.nr_periods, 1200);
+    EXPECT_EQ(stat.nr_throttled, 37);
+    EXPECT_EQ(stat.throttled_usec, 456789);
+    EXPECT_EQ(stat.pressure_valid, 1);
+    EXPECT_EQ(stat.some.avg10, 152);
+    EXPECT_EQ(stat.some.avg60, 87);
+    EXPECT_EQ(stat.some.avg300, 20);
+    EXPECT_EQ(stat.some.total_usec, 123456);
+    EXPECT_EQ(stat.full.avg10, 75);
+    EXPECT_EQ(stat.full.avg60, 1040);
+    EXPECT_EQ(stat.full.avg300, 5);
+    EXPECT_EQ(stat.full.total_usec, 65432);
+
+    // the cached files are read from the start, nothing is opened again
+    EXPECT_EQ(open_fake.call_count, 3);
+    EXPECT_EQ(pread_fake.arg3_val, 0);
+
+    cgroupcpuload_destroy(cgroupcpuload);
+}
+
+TEST_F(test_cgroupcpuload, v2_without_psi)
+{
+    cgroupcpuload_stat stat;
+
+    psi_available                  = false;
+    open_fake.custom_fake          = open_v2_custom_fake;
+    pread_fake.custom_fake         = pread_v2_custom_fake;
+    clock_gettime_fake.custom_fake = clock_gettime_custom_fake;
+
+    cgroupcpuload * cgroupcpuload = cgroupcpuload_init(cgrouprts);
+    ASSERT_NE(cgroupcpuload, nullptr);
+
+    stat_fixture = true;
+    ASSERT_EQ(cgroupcpuload_get_stat(cgroupcpuload, &stat), 0);
+    EXPECT_EQ(stat.throttled_usec, 456789);
+    EXPECT_EQ(stat.pressure_valid, 0);
+    EXPECT_EQ(stat.some.avg10, 0);
+
+    cgroupcpuload_destroy(cgroupcpuload);
+    ASSERT_EQ(close_fake.call_count, 1);
+}
+
+TEST_F(test_cgroupcpuload, no_cgroup)
+{
+    open_fake.custom_fake = open_none_custom_fake;
+
+    ASSERT_EQ(cgroupcpuload_init(cgrouprts), nullptr);
+    ASSERT_EQ(free_fake.call_count, 1);
+}
@@ -17,6 +17,7 @@ status configure(const stp_config& config) {
   if (s.ok()) {
     s = write_persistence(config);
   }
+  invalidate_stp_info();
   return s;
 }
 
@@ -3,9 +3,14 @@
 
 #include "info.hpp"
 
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <string>
 
 #include "configure.hpp"
+#include "info_cache.hpp"
 #include "info_parser.hpp"
 #include "program.hpp"
 #include "setup.hpp"
@@ -14,6 +19,11 @@ namespace wago::stp::lib {
 
 constexpr auto STP_BRIDGE_INFO_CMD     = "mstpctl showbridge -f json ";
 constexpr auto STP_PORTDETAIL_INFO_CMD = "mstpctl showportdetail -f json ";
+constexpr auto STP_INFO_CACHE_PATH     = "/var/run/stp_info_cache.json";
+constexpr auto MSTPD_PROCESS_NAME      = "mstpd";
+
+// Port roles and states are dynamic, a cached info must not be older than this
+constexpr ::std::chrono::milliseconds STP_INFO_CACHE_MAX_AGE{1000};
 
 namespace {
 
@@ -27,17 +37,37 @@ status call_program(::std::string&& cmd, ::std::string& std_out) {
   return status{};
 }
 
-int get_pid_of(const ::std::string &daemon_path) {
-  ::std::string cmd_line = "/usr/bin/pidof " + daemon_path;
-  auto program           = program::execute(cmd_line);
-  if (program.get_result() == 0) {
-    return static_cast<int>(::std::strtol(program.get_stdout().c_str(), nullptr, 0));
+// Looks for the daemon in /proc instead of spawning pidof for every info request
+int get_pid_of(const ::std::string &process_name) {
+  ::std::error_code ec;
+  for (auto const &entry : ::std::filesystem::directory_iterator("/proc", ec)) {
+    auto const &pid_dir = entry.path().filename().string();
+    if (pid_dir.find_first_not_of("0123456789") != ::std::string::npos) {
+      continue;
+    }
+    ::std::ifstream comm(entry.path() / "comm");
+    ::std::string name;
+    if (::std::getline(comm, name) && name == process_name) {
+      return static_cast<int>(::std::strtol(pid_dir.c_str(), nullptr, 10));
+    }
   }
   return 0;
 }
 
-bool mstp_deamon_running() {
-  return get_pid_of("/usr/sbin/mstpd") > 0;
+status read_mstpd_info(const ::std::string &bridge, stp_info &info) {
+  ::std::string bridge_json;
+  ::std::string port_json;
+  status s = call_program(STP_BRIDGE_INFO_CMD + bridge, bridge_json);
+  if (s.ok()) {
+    s = call_program(STP_PORTDETAIL_INFO_CMD + bridge, port_json);
+  }
+  if (s.ok()) {
+    s = parse_stp_info(bridge_json, info);
+  }
+  if (s.ok()) {
+    s = parse_stp_info(port_json, info);
+  }
+  return s;
 }
 
 }  // namespace
@@ -45,27 +75,28 @@ bool mstp_deamon_running() {
 status get_stp_info(stp_info& info) {
   info = stp_info{};
   status s{};
-  if (mstp_deamon_running()) {
-    info.enabled = true;
-
+  int mstpd_pid = get_pid_of(MSTPD_PROCESS_NAME);
+  if (mstpd_pid > 0) {
     stp_config config{};
     read_persistence(config);
 
-    ::std::string json_bridge_info;
-    s = call_program(STP_BRIDGE_INFO_CMD + config.bridge, json_bridge_info);
-    if (s.ok()) {
-      s = parse_stp_info(json_bridge_info, info);
-    }
-
-    ::std::string json_port_info;
-    if (s.ok()) {
-      s = call_program(STP_PORTDETAIL_INFO_CMD + config.bridge, json_port_info);
-    }
-    if (s.ok()) {
-      s = parse_stp_info(json_port_info, info);
+    // The cache holds the parsed info, a hit neither spawns mstpctl nor parses its output
+    if (!read_info_cache(STP_INFO_CACHE_PATH, config.bridge, mstpd_pid, STP_INFO_CACHE_MAX_AGE, info).ok()) {
+      info         = stp_info{};
+      info.enabled = true;
+      s            = read_mstpd_info(config.bridge, info);
+      if (s.ok()) {
+        // A failing cache write only costs the next caller the mstpctl calls
+        write_info_cache(STP_INFO_CACHE_PATH, config.bridge, mstpd_pid, info);
+      }
     }
   }
 
   return s;
 }
-}  // namespace wago::stp::lib
\ No newline at end of file
+
+void invalidate_stp_info() {
+  invalidate_info_cache(STP_INFO_CACHE_PATH);
+}
+
+}  // namespace wago::stp::lib
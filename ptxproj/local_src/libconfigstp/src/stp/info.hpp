@@ -9,4 +9,7 @@ namespace wago::stp::lib {
 
 status get_stp_info(stp_info& info);
 
+// Has to be called when the stp configuration or the mstpd changes
+void invalidate_stp_info();
+
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+// Copyright (c) 2024 WAGO GmbH & Co. KG
+// SPDX-License-Identifier: MPL-2.0
+
+#include "info_cache.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <nlohmann/json.hpp>
+#include <string>
+
+namespace wago::stp::lib {
+
+namespace {
+
+constexpr mode_t cache_file_mode = 0644;
+
+// Milliseconds since boot, not affected by changes of the system time
+::std::int64_t now_ms() {
+  struct timespec ts {};
+  ::clock_gettime(CLOCK_BOOTTIME, &ts);
+  return static_cast<::std::int64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+}  // namespace
+
+// The protocol is stored as number, the json enum mapping of the info parser only knows the mstpctl names
+void to_json(nlohmann::json &j, const stp_port_info &port) {
+  j = {{"port", port.port},
+       {"role", port.role},
+       {"status", port.status},
+       {"priority", port.priority},
+       {"path_cost", port.path_cost},
+       {"bpdu_guard", port.bpdu_guard},
+       {"bpdu_filter", port.bpdu_filter},
+       {"edge_port", port.edge_port},
+       {"root_guard", port.root_guard}};
+}
+
+void from_json(const nlohmann::json &j, stp_port_info &port) {
+  j.at("port").get_to(port.port);
+  j.at("role").get_to(port.role);
+  j.at("status").get_to(port.status);
+  j.at("priority").get_to(port.priority);
+  j.at("path_cost").get_to(port.path_cost);
+  j.at("bpdu_guard").get_to(port.bpdu_guard);
+  j.at("bpdu_filter").get_to(port.bpdu_filter);
+  j.at("edge_port").get_to(port.edge_port);
+  j.at("root_guard").get_to(port.root_guard);
+}
+
+void to_json(nlohmann::json &j, const stp_info &info) {
+  j = {{"enabled", info.enabled},
+       {"bridge", info.bridge},
+       {"protocol", static_cast<int>(info.protocol)},
+       {"priority", info.priority},
+       {"max_age", info.max_age},
+       {"max_hops", info.max_hops},
+       {"forward_delay", info.forward_delay},
+       {"hello_time", info.hello_time},
+       {"path_cost", info.path_cost},
+       {"ports", info.ports}};
+}
+
+void from_json(const nlohmann::json &j, stp_info &info) {
+  j.at("enabled").get_to(info.enabled);
+  j.at("bridge").get_to(info.bridge);
+  info.protocol = static_cast<protocol_version>(j.at("protocol").get<int>());
+  j.at("priority").get_to(info.priority);
+  j.at("max_age").get_to(info.max_age);
+  j.at("max_hops").get_to(info.max_hops);
+  j.at("forward_delay").get_to(info.forward_delay);
+  j.at("hello_time").get_to(info.hello_time);
+  j.at("path_cost").get_to(info.path_cost);
+  j.at("ports").get_to(info.ports);
+}
+
+status read_info_cache(const ::std::string &path, const ::std::string &bridge, int mstpd_pid,
+                       ::std::chrono::milliseconds max_age, stp_info &info) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+  if (fd < 0) {
+    return status{status_code::SYSTEM_CALL_ERROR, "No info cache " + path};
+  }
+
+  // Only trust a cache written by our own user (root for the config tools) which nobody else can modify
+  struct stat file_stat {};
+  if (::fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_uid != ::geteuid() ||
+      (file_stat.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+    ::close(fd);
+    return status{status_code::SYSTEM_CALL_ERROR, "Untrusted info cache " + path};
+  }
+
+  ::std::string content;
+  ::std::array<char, 4096> buffer{};
+  ssize_t len;
+  while ((len = ::read(fd, buffer.data(), buffer.size())) > 0) {
+    content.append(buffer.data(), static_cast<::std::size_t>(len));
+  }
+  ::close(fd);
+  if (len < 0) {
+    return status{status_code::SYSTEM_CALL_ERROR, "Failed to read file " + path};
+  }
+
+  try {
+    auto j   = nlohmann::json::parse(content);
+    auto age = now_ms() - j.at("timestamp").get<::std::int64_t>();
+    if (j.at("bridge") != bridge || j.at("pid") != mstpd_pid || age < 0 || age > max_age.count()) {
+      return status{status_code::SYSTEM_CALL_ERROR, "Outdated info cache " + path};
+    }
+    j.at("info").get_to(info);
+  } catch (::std::exception const &e) {
+    return status{status_code::JSON_PARSE_ERROR, e.what()};
+  }
+  return {};
+}
+
+status write_info_cache(const ::std::string &path, const ::std::string &bridge, int mstpd_pid,
+                        const stp_info &info) {
+  nlohmann::json j = {{"bridge", bridge},
+                      {"pid", mstpd_pid},
+                      {"timestamp", now_ms()},
+                      {"info", info}};
+  auto content = j.dump();
+
+  // No sync like for the persistence, the cache is volatile anyway. The rename keeps readers from seeing partial files.
+  // mkstemp creates the temporary file exclusively, a planted file or link is never written through.
+  ::std::string path_tmp = path + ".XXXXXX";
+  int fd                 = ::mkstemp(path_tmp.data());
+  if (fd < 0) {
+    return status{status_code::SYSTEM_CALL_ERROR, "Failed to open file " + path_tmp};
+  }
+
+  bool written = ::fchmod(fd, cache_file_mode) == 0;
+  for (::std::size_t offset = 0; written && offset < content.size();) {
+    auto len = ::write(fd, content.data() + offset, content.size() - offset);
+    written  = len > 0;
+    offset += written ? static_cast<::std::size_t>(len) : 0;
+  }
+  written = (::close(fd) == 0) && written;
+
+  if (!written || ::std::rename(path_tmp.c_str(), path.c_str()) != 0) {
+    ::std::remove(path_tmp.c_str());
+    return status{status_code::SYSTEM_CALL_ERROR, "Failed to write file " + path};
+  }
+  return {};
+}
+
+void invalidate_info_cache(const ::std::string &path) {
+  ::std::remove(path.c_str());
+}
+
+}  // namespace wago::stp::lib
@@ -0,0 +1,23 @@
+// Copyright (c) 2024 WAGO GmbH & Co. KG
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "stp.hpp"
+
+namespace wago::stp::lib {
+
+// The cache holds the parsed info of one bridge and is shared by all processes, e.g. consecutive get_stp_config calls
+// of the WBM.
+// An entry is only valid for the bridge and the mstpd instance it was read from and for max_age.
+// A cache file is only read if it is a regular file of the calling user that is not writable by group or others.
+status read_info_cache(const ::std::string &path, const ::std::string &bridge, int mstpd_pid,
+                       ::std::chrono::milliseconds max_age, stp_info &info);
+status write_info_cache(const ::std::string &path, const ::std::string &bridge, int mstpd_pid,
+                        const stp_info &info);
+void invalidate_info_cache(const ::std::string &path);
+
+}  // namespace wago::stp::lib
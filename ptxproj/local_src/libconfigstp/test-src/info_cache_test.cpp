@@ -0,0 +1,129 @@
+// Copyright (c) 2024 WAGO GmbH & Co. KG
+// SPDX-License-Identifier: MPL-2.0
+
+#include "info_cache.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "stp.hpp"
+
+namespace wago::stp::lib {
+
+class info_cache_test : public testing::Test {
+ public:
+  ::std::string path = "/tmp/stp_info_cache_test." + ::std::to_string(::getpid());
+  ::std::chrono::milliseconds max_age{1000};
+  stp_info info;
+
+  void SetUp() override {
+    info.enabled  = true;
+    info.bridge   = "br0";
+    info.protocol = protocol_version::MSTP;
+    info.priority = "8.000.00:30:DE:00:00:01";
+    info.max_age  = 20;
+    info.ports    = {stp_port_info{"ethX1", "Root", "forwarding", "8.001", 20000, false, false, true, false},
+                     stp_port_info{"ethX2", "Designated", "forwarding", "8.002", 20000, true, true, false, true}};
+  }
+
+  void TearDown() override {
+    invalidate_info_cache(path);
+  }
+};
+
+TEST_F(info_cache_test, ReadWrittenInfo) {
+  ASSERT_TRUE(write_info_cache(path, "br0", 42, info).ok());
+
+  stp_info cached;
+  ASSERT_TRUE(read_info_cache(path, "br0", 42, max_age, cached).ok());
+  EXPECT_TRUE(cached.enabled);
+  EXPECT_EQ(info.bridge, cached.bridge);
+  EXPECT_EQ(protocol_version::MSTP, cached.protocol);
+  EXPECT_EQ(info.priority, cached.priority);
+  EXPECT_EQ(info.max_age, cached.max_age);
+  ASSERT_EQ(2, cached.ports.size());
+  EXPECT_EQ("ethX2", cached.ports[1].port);
+  EXPECT_EQ("Designated", cached.ports[1].role);
+  EXPECT_EQ(20000, cached.ports[1].path_cost);
+  EXPECT_TRUE(cached.ports[1].bpdu_guard);
+  EXPECT_TRUE(cached.ports[1].root_guard);
+  EXPECT_FALSE(cached.ports[1].edge_port);
+}
+
+TEST_F(info_cache_test, MissingCache) {
+  stp_info cached;
+  EXPECT_FALSE(read_info_cache(path, "br0", 42, max_age, cached).ok());
+}
+
+TEST_F(info_cache_test, OtherBridgeOrDaemonInstance) {
+  ASSERT_TRUE(write_info_cache(path, "br0", 42, info).ok());
+
+  stp_info cached;
+  EXPECT_FALSE(read_info_cache(path, "br1", 42, max_age, cached).ok());
+  EXPECT_FALSE(read_info_cache(path, "br0", 43, max_age, cached).ok());
+}
+
+TEST_F(info_cache_test, Expired) {
+  ASSERT_TRUE(write_info_cache(path, "br0", 42, info).ok());
+  ::std::this_thread::sleep_for(::std::chrono::milliseconds{20});
+
+  stp_info cached;
+  EXPECT_FALSE(read_info_cache(path, "br0", 42, ::std::chrono::milliseconds{10}, cached).ok());
+}
+
+TEST_F(info_cache_test, Invalidated) {
+  ASSERT_TRUE(write_info_cache(path, "br0", 42, info).ok());
+  invalidate_info_cache(path);
+
+  stp_info cached;
+  EXPECT_FALSE(read_info_cache(path, "br0", 42, max_age, cached).ok());
+}
+
+TEST_F(info_cache_test, KeepsUmaskAndIsReadableByOthers) {
+  auto mask = ::umask(0077);
+  ASSERT_TRUE(write_info_cache(path, "br0", 42, info).ok());
+  EXPECT_EQ(0077, ::umask(mask));
+
+  struct stat file_stat {};
+  ASSERT_EQ(0, ::stat(path.c_str(), &file_stat));
+  EXPECT_EQ(0644, file_stat.st_mode & 0777);
+}
+
+TEST_F(info_cache_test, IgnoresCacheWritableByOthers) {
+  ASSERT_TRUE(write_info_cache(path, "br0", 42, info).ok());
+  ASSERT_EQ(0, ::chmod(path.c_str(), 0666));
+
+  stp_info cached;
+  EXPECT_FALSE(read_info_cache(path, "br0", 42, max_age, cached).ok());
+}
+
+TEST_F(info_cache_test, IgnoresSymlink) {
+  auto target = path + ".target";
+  ASSERT_TRUE(write_info_cache(target, "br0", 42, info).ok());
+  ASSERT_EQ(0, ::symlink(target.c_str(), path.c_str()));
+
+  stp_info cached;
+  EXPECT_FALSE(read_info_cache(path, "br0", 42, max_age, cached).ok());
+  invalidate_info_cache(target);
+}
+
+TEST_F(info_cache_test, ReplacesPlantedSymlink) {
+  auto target = path + ".target";
+  ASSERT_EQ(0, ::symlink(target.c_str(), path.c_str()));
+
+  ASSERT_TRUE(write_info_cache(path, "br0", 42, info).ok());
+
+  EXPECT_FALSE(::std::ifstream{target}.is_open());
+  stp_info cached;
+  EXPECT_TRUE(read_info_cache(path, "br0", 42, max_age, cached).ok());
+}
+
+}  // namespace wago::stp::lib
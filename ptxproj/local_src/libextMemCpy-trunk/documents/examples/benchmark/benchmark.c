@@ -0,0 +1,364 @@
+//----------------------------------------------------------------------------------------------------------------------
+/// Copyright (c) WAGO GmbH & Co. KG
+///
+/// PROPRIETARY RIGHTS of WAGO GmbH & Co. KG are involved in
+/// the subject matter of this material. All manufacturing, reproduction,
+/// use, and sales rights pertaining to this subject matter are governed
+/// by the license agreement. The recipient of this software implicitly
+/// accepts the terms of the license.
+///
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+///
+///  \file     benchmark.c
+///
+///  \version  $Id:
+///
+///  \brief    This module contains the benchmark and the correctness fuzzer of the copy engine.
+///
+///            The benchmark cases are typical fieldbus process image mappings. Each case is copied by the optimized
+///            copy job list of the library and by a baseline job list which uses the bit by bit copy function for
+///            every rule, like the copy job generator did before the bit field copy functions were introduced.
+///            The fuzzer compares the results of random offset to offset rule lists with a bit by bit reference copy.
+///
+///            Build (host):
+///             gcc -DX86 -DLINUX -I<sysroot>/usr/include/osal -I../../../sources/extMemCpy
+///                 -I../../../sources/copyEng benchmark.c libextMemCpy.a libosal.a -lrt -lpthread -o benchmark
+///
+///  \author   WAGO GmbH & Co. KG
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "os_api.h"
+
+#include "extMemCpy_SYSI.h"
+#include "extMemCpy_API.h"
+#include "copyEng_API.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------------------------------------------
+#define BENCHMARK_PROCESS_IMAGE_SIZE    1024U
+#define BENCHMARK_MAX_NO_OF_RULES       512U
+#define BENCHMARK_MIN_DURATION_NS       200000000ULL
+#define BENCHMARK_FUZZ_ITERATIONS       2000U
+#define BENCHMARK_FUZZ_MAX_NO_OF_RULES  32U
+#define BENCHMARK_FUZZ_MAX_BIT_SIZE     200U
+#define BENCHMARK_FUZZ_SEED             0x5EEDU
+
+//----------------------------------------------------------------------------------------------------------------------
+// Typedefs
+//----------------------------------------------------------------------------------------------------------------------
+
+/// The \ref benchmarkCase_t structure describes one benchmark case.
+typedef struct
+{
+  /** name of the benchmark case */
+  const char* pcName;
+  /** copy rules of the benchmark case */
+  copyRule_t astCopyRules[BENCHMARK_MAX_NO_OF_RULES];
+  /** number of copy rules */
+  uint_t uiNoOfCopyRules;
+} benchmarkCase_t;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Global Variables
+//----------------------------------------------------------------------------------------------------------------------
+static uint8_t aucSrcData[BENCHMARK_PROCESS_IMAGE_SIZE];
+static uint8_t aucDstData[BENCHMARK_PROCESS_IMAGE_SIZE];
+static uint8_t aucRefData[BENCHMARK_PROCESS_IMAGE_SIZE];
+static copyJob_t astBaselineCopyJobs[BENCHMARK_MAX_NO_OF_RULES];
+static benchmarkCase_t stBenchmarkCase;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Function prototypes
+//----------------------------------------------------------------------------------------------------------------------
+static void     benchmark_AddRule           (copyRule_t* pastCopyRules, uint_t* puiNoOfCopyRules,
+                                             uint_t uiSrcBitOffset, uint_t uiDstBitOffset, uint_t uiBitSize);
+static void     benchmark_GenBaselineJobs   (const copyRule_t* pastCopyRules, uint_t uiNoOfCopyRules);
+static void     benchmark_RefCopy           (uint8_t* pucDstData, const uint8_t* pucSrcData,
+                                             const copyRule_t* pastCopyRules, uint_t uiNoOfCopyRules);
+static uint64_t benchmark_GetTimeNs         (void);
+static void     benchmark_Run               (const benchmarkCase_t* pstCase);
+static uint_t   benchmark_Fuzz              (void);
+
+//----------------------------------------------------------------------------------------------------------------------
+// Functions
+//----------------------------------------------------------------------------------------------------------------------
+
+//-- Function: benchmark_AddRule ---------------------------------------------------------------------------------------
+///
+///  This function appends an offset to offset copy rule to the specified rule list.
+///
+//----------------------------------------------------------------------------------------------------------------------
+static void benchmark_AddRule (copyRule_t* pastCopyRules,
+                               uint_t* puiNoOfCopyRules,
+                               uint_t uiSrcBitOffset,
+                               uint_t uiDstBitOffset,
+                               uint_t uiBitSize)
+{
+  copyRule_t* pstCopyRule = &pastCopyRules[*puiNoOfCopyRules];
+
+  memset(pstCopyRule, 0, sizeof(*pstCopyRule));
+  pstCopyRule->enmRuleTypeId = OFFSET_OFFSET_RULE;
+  pstCopyRule->unRuleTypes.stOffsetToOffsetRule.uiSrcDataBitOffset = uiSrcBitOffset;
+  pstCopyRule->unRuleTypes.stOffsetToOffsetRule.uiDstDataBitOffset = uiDstBitOffset;
+  pstCopyRule->unRuleTypes.stOffsetToOffsetRule.uiBitSize = uiBitSize;
+
+  (*puiNoOfCopyRules)++;
+}
+
+//-- Function: benchmark_GenBaselineJobs -------------------------------------------------------------------------------
+///
+///  This function generates one bit by bit copy job per rule as baseline for the benchmark.
+///
+//----------------------------------------------------------------------------------------------------------------------
+static void benchmark_GenBaselineJobs (const copyRule_t* pastCopyRules,
+                                       uint_t uiNoOfCopyRules)
+{
+  copyEngInterfaceDesc_t stCopyEngInterfaceDesc;
+  uint_t uiIdx;
+
+  copyEng_GetInterfaceDesc(&stCopyEngInterfaceDesc);
+
+  for (uiIdx = 0; uiIdx < uiNoOfCopyRules; uiIdx++)
+  {
+    const copyRuleOffsetToOffset_t* pstRule = &pastCopyRules[uiIdx].unRuleTypes.stOffsetToOffsetRule;
+    copyJob_t* pstCopyJob = &astBaselineCopyJobs[uiIdx];
+
+    memset(pstCopyJob, 0, sizeof(*pstCopyJob));
+    pstCopyJob->pfCopyJobPrepFunc   = stCopyEngInterfaceDesc.pfPrepareCopyJobOffsetToOffset;
+    pstCopyJob->pfCopyJobFunc       = stCopyEngInterfaceDesc.pfCopyBit;
+    pstCopyJob->uiSrcDataByteOffset = pstRule->uiSrcDataBitOffset >> 3;
+    pstCopyJob->uiSrcDataBitPos     = pstRule->uiSrcDataBitOffset & 0x07U;
+    pstCopyJob->uiDstDataByteOffset = pstRule->uiDstDataBitOffset >> 3;
+    pstCopyJob->uiDstDataBitPos     = pstRule->uiDstDataBitOffset & 0x07U;
+    pstCopyJob->uiNoOfElements      = pstRule->uiBitSize;
+  }
+}
+
+//-- Function: benchmark_RefCopy ---------------------------------------------------------------------------------------
+///
+///  This function copies the specified rules bit by bit as reference for the fuzzer.
+///
+//----------------------------------------------------------------------------------------------------------------------
+static void benchmark_RefCopy (uint8_t* pucDstData,
+                               const uint8_t* pucSrcData,
+                               const copyRule_t* pastCopyRules,
+                               uint_t uiNoOfCopyRules)
+{
+  uint_t uiIdx;
+  uint_t uiBit;
+
+  for (uiIdx = 0; uiIdx < uiNoOfCopyRules; uiIdx++)
+  {
+    const copyRuleOffsetToOffset_t* pstRule = &pastCopyRules[uiIdx].unRuleTypes.stOffsetToOffsetRule;
+
+    for (uiBit = 0; uiBit < pstRule->uiBitSize; uiBit++)
+    {
+      uint_t uiSrcBit = pstRule->uiSrcDataBitOffset + uiBit;
+      uint_t uiDstBit = pstRule->uiDstDataBitOffset + uiBit;
+      uint8_t ucValue = (uint8_t) ((pucSrcData[uiSrcBit >> 3] >> (uiSrcBit & 0x07U)) & 0x01U);
+
+      pucDstData[uiDstBit >> 3] = (uint8_t) ((pucDstData[uiDstBit >> 3] & ~(0x01U << (uiDstBit & 0x07U)))
+                                             | (ucValue << (uiDstBit & 0x07U)));
+    }
+  }
+}
+
+//-- Function: benchmark_GetTimeNs -------------------------------------------------------------------------------------
+///
+///  This function returns the monotonic time in nanoseconds.
+///
+//----------------------------------------------------------------------------------------------------------------------
+static uint64_t benchmark_GetTimeNs (void)
+{
+  struct timespec stTime;
+
+  (void) clock_gettime(CLOCK_MONOTONIC, &stTime);
+
+  return ((uint64_t) stTime.tv_sec * 1000000000ULL + (uint64_t) stTime.tv_nsec);
+}
+
+//-- Function: benchmark_Run -------------------------------------------------------------------------------------------
+///
+///  This function measures the specified benchmark case with the baseline and the optimized copy job list and
+///   prints the time per copy cycle.
+///
+//----------------------------------------------------------------------------------------------------------------------
+static void benchmark_Run (const benchmarkCase_t* pstCase)
+{
+  extMemCpySettings_t stSettings = {.uiMaxSuppCopyRules = BENCHMARK_MAX_NO_OF_RULES,
+                                    .enmMaxCopyOptimization = MAX_COPY_LEN_DWORD};
+  handle_t hExtMemCpy;
+  uint64_t ullIterations;
+  uint64_t ullStartTime;
+  uint64_t ullBaselineNs;
+  uint64_t ullOptimizedNs;
+
+  hExtMemCpy = extMemCpy_Initialise(&stSettings);
+  (void) extMemCpy_AddCopyRuleList((copyRule_t*) pstCase->astCopyRules, pstCase->uiNoOfCopyRules, hExtMemCpy);
+  (void) extMemCpy_RefreshCopyRuleList(hExtMemCpy);
+  benchmark_GenBaselineJobs(pstCase->astCopyRules, pstCase->uiNoOfCopyRules);
+
+  /* baseline: one bit by bit copy job per rule */
+  ullIterations = 0;
+  ullStartTime = benchmark_GetTimeNs();
+  do
+  {
+    copyEng_PrcCopyJobList(aucDstData, aucSrcData, astBaselineCopyJobs, pstCase->uiNoOfCopyRules);
+    ullIterations++;
+  } while ((benchmark_GetTimeNs() - ullStartTime) < BENCHMARK_MIN_DURATION_NS);
+  ullBaselineNs = (benchmark_GetTimeNs() - ullStartTime) / ullIterations;
+
+  printf("%-32s %10llu ns %12llu iterations\n", "  baseline",
+         (unsigned long long) ullBaselineNs, (unsigned long long) ullIterations);
+
+  /* optimized copy job list of the library */
+  ullIterations = 0;
+  ullStartTime = benchmark_GetTimeNs();
+  do
+  {
+    (void) extMemCpy_CopyData(aucDstData, aucSrcData, hExtMemCpy);
+    ullIterations++;
+  } while ((benchmark_GetTimeNs() - ullStartTime) < BENCHMARK_MIN_DURATION_NS);
+  ullOptimizedNs = (benchmark_GetTimeNs() - ullStartTime) / ullIterations;
+
+  printf("%-32s %10llu ns %12llu iterations\n", "  optimized",
+         (unsigned long long) ullOptimizedNs, (unsigned long long) ullIterations);
+
+  (void) extMemCpy_Release(hExtMemCpy);
+}
+
+//-- Function: benchmark_Fuzz ------------------------------------------------------------------------------------------
+///
+///  This function copies random rule lists with the library, the baseline jobs and the reference copy and compares
+///   the results.
+///
+///  \return  number of detected mismatches
+///
+//----------------------------------------------------------------------------------------------------------------------
+static uint_t benchmark_Fuzz (void)
+{
+  static uint8_t aucBaselineData[BENCHMARK_PROCESS_IMAGE_SIZE];
+  static copyRule_t astCopyRules[BENCHMARK_FUZZ_MAX_NO_OF_RULES];
+  extMemCpySettings_t stSettings = {.uiMaxSuppCopyRules = BENCHMARK_FUZZ_MAX_NO_OF_RULES,
+                                    .enmMaxCopyOptimization = MAX_COPY_LEN_DWORD};
+  uint_t uiMismatches = 0;
+  uint_t uiIteration;
+  uint_t uiIdx;
+
+  srand(BENCHMARK_FUZZ_SEED);
+
+  for (uiIteration = 0; uiIteration < BENCHMARK_FUZZ_ITERATIONS; uiIteration++)
+  {
+    uint_t uiNoOfCopyRules = 0;
+    uint_t uiDstBitOffset = (uint_t) rand() % 64U;
+    uint_t uiRules = 1U + ((uint_t) rand() % BENCHMARK_FUZZ_MAX_NO_OF_RULES);
+    handle_t hExtMemCpy;
+
+    /* destination areas must not overlap, source areas may */
+    for (uiIdx = 0; uiIdx < uiRules; uiIdx++)
+    {
+      uint_t uiBitSize = 1U + ((uint_t) rand() % BENCHMARK_FUZZ_MAX_BIT_SIZE);
+      uint_t uiSrcBitOffset = (uint_t) rand() % ((BENCHMARK_PROCESS_IMAGE_SIZE * 8U) - BENCHMARK_FUZZ_MAX_BIT_SIZE);
+
+      benchmark_AddRule(astCopyRules, &uiNoOfCopyRules, uiSrcBitOffset, uiDstBitOffset, uiBitSize);
+      uiDstBitOffset += uiBitSize + ((uint_t) rand() % 4U);
+    }
+
+    for (uiIdx = 0; uiIdx < BENCHMARK_PROCESS_IMAGE_SIZE; uiIdx++)
+    {
+      aucSrcData[uiIdx] = (uint8_t) rand();
+      aucDstData[uiIdx] = (uint8_t) rand();
+    }
+    memcpy(aucRefData, aucDstData, sizeof(aucRefData));
+    memcpy(aucBaselineData, aucDstData, sizeof(aucBaselineData));
+
+    hExtMemCpy = extMemCpy_Initialise(&stSettings);
+    (void) extMemCpy_AddCopyRuleList(astCopyRules, uiNoOfCopyRules, hExtMemCpy);
+    (void) extMemCpy_RefreshCopyRuleList(hExtMemCpy);
+    (void) extMemCpy_CopyData(aucDstData, aucSrcData, hExtMemCpy);
+    (void) extMemCpy_Release(hExtMemCpy);
+
+    benchmark_GenBaselineJobs(astCopyRules, uiNoOfCopyRules);
+    copyEng_PrcCopyJobList(aucBaselineData, aucSrcData, astBaselineCopyJobs, uiNoOfCopyRules);
+
+    benchmark_RefCopy(aucRefData, aucSrcData, astCopyRules, uiNoOfCopyRules);
+
+    if (   (0 != memcmp(aucDstData, aucRefData, sizeof(aucRefData)))
+        || (0 != memcmp(aucBaselineData, aucRefData, sizeof(aucRefData))))
+    {
+      printf("mismatch in fuzz iteration %u (%u rules)\n", uiIteration, uiNoOfCopyRules);
+      uiMismatches++;
+    }
+  }
+
+  return (uiMismatches);
+}
+
+//-- Function: main ----------------------------------------------------------------------------------------------------
+///
+///  This function runs the correctness fuzzer and the benchmark cases.
+///
+//----------------------------------------------------------------------------------------------------------------------
+int main (void)
+{
+  uint_t uiMismatches;
+  uint_t uiIdx;
+
+  uiMismatches = benchmark_Fuzz();
+  printf("fuzzer: %u iterations, %u mismatches\n\n", BENCHMARK_FUZZ_ITERATIONS, uiMismatches);
+
+  /* 256 digital channels, every second bit of the input image to packed output bits */
+  stBenchmarkCase.pcName = "digital IO 256 x 1 bit";
+  stBenchmarkCase.uiNoOfCopyRules = 0;
+  for (uiIdx = 0; uiIdx < 256U; uiIdx++)
+  {
+    benchmark_AddRule(stBenchmarkCase.astCopyRules, &stBenchmarkCase.uiNoOfCopyRules, uiIdx * 2U, 3U + uiIdx * 3U, 1);
+  }
+  printf("%s\n", stBenchmarkCase.pcName);
+  benchmark_Run(&stBenchmarkCase);
+
+  /* 64 analog channels with 16 bit values behind a 4 bit status nibble */
+  stBenchmarkCase.pcName = "analog IO 64 x 16 bit unaligned";
+  stBenchmarkCase.uiNoOfCopyRules = 0;
+  for (uiIdx = 0; uiIdx < 64U; uiIdx++)
+  {
+    benchmark_AddRule(stBenchmarkCase.astCopyRules, &stBenchmarkCase.uiNoOfCopyRules,
+                      4U + uiIdx * 20U, uiIdx * 24U, 16);
+  }
+  printf("%s\n", stBenchmarkCase.pcName);
+  benchmark_Run(&stBenchmarkCase);
+
+  /* mixed module configuration of bits, bytes and words */
+  stBenchmarkCase.pcName = "mixed 128 rules";
+  stBenchmarkCase.uiNoOfCopyRules = 0;
+  for (uiIdx = 0; uiIdx < 128U; uiIdx++)
+  {
+    static const uint_t auiBitSizes[] = {1, 8, 2, 16, 12, 32};
+    uint_t uiBitSize = auiBitSizes[uiIdx % (sizeof(auiBitSizes) / sizeof(auiBitSizes[0]))];
+
+    benchmark_AddRule(stBenchmarkCase.astCopyRules, &stBenchmarkCase.uiNoOfCopyRules,
+                      uiIdx * 40U + (uiIdx % 8U), uiIdx * 40U, uiBitSize);
+  }
+  printf("%s\n", stBenchmarkCase.pcName);
+  benchmark_Run(&stBenchmarkCase);
+
+  /* whole process image shifted by three bits */
+  stBenchmarkCase.pcName = "bulk 4096 bit shifted";
+  stBenchmarkCase.uiNoOfCopyRules = 0;
+  benchmark_AddRule(stBenchmarkCase.astCopyRules, &stBenchmarkCase.uiNoOfCopyRules, 3, 0, 4096);
+  printf("%s\n", stBenchmarkCase.pcName);
+  benchmark_Run(&stBenchmarkCase);
+
+  return ((0 == uiMismatches) ? 0 : 1);
+}
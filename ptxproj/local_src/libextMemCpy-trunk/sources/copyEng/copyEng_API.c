@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "os_api.h"
 
@@ -36,6 +37,9 @@
 // Defines
 //----------------------------------------------------------------------------------------------------------------------
 
+/// bits copied per step by the bit field copy function, a multiple of 8 keeps the bit positions of the next step
+#define COPYENG_BIT_FIELD_STEP_SIZE  56U
+
 //----------------------------------------------------------------------------------------------------------------------
 // Typedefs
 //----------------------------------------------------------------------------------------------------------------------
@@ -68,6 +72,12 @@ static void copyEng_CopyOneDWord                      (void* pDstData, void* con
                                                        copyJob_t* const pstCopyJob);
 static void copyEng_CopyArcSpec                       (void* pDstData, void* const pSrcData,
                                                        copyJob_t* const pstCopyJob);
+static void copyEng_CopyBitField                      (void* pDstData, void* const pSrcData,
+                                                       copyJob_t* const pstCopyJob);
+static void copyEng_CopyShortBitField                 (void* pDstData, void* const pSrcData,
+                                                       copyJob_t* const pstCopyJob);
+static inline uint64_t copyEng_LoadBytes              (const uint8_t* pucData, uint_t uiNoOfBytes);
+static inline void     copyEng_StoreBytes             (uint8_t* pucData, uint64_t ullData, uint_t uiNoOfBytes);
 
 //----------------------------------------------------------------------------------------------------------------------
 // Functions
@@ -121,6 +131,8 @@ void copyEng_GetInterfaceDesc (copyEngInterfaceDesc_t* pstCopyEngInterfaceDesc)
   pstCopyEngInterfaceDesc->pfCopyDWord                          = &copyEng_CopyDWord;
   pstCopyEngInterfaceDesc->pfCopyOneDWord                       = &copyEng_CopyOneDWord;
   pstCopyEngInterfaceDesc->pfCopyArcSpec                        = &copyEng_CopyArcSpec;
+  pstCopyEngInterfaceDesc->pfCopyBitField                       = &copyEng_CopyBitField;
+  pstCopyEngInterfaceDesc->pfCopyShortBitField                  = &copyEng_CopyShortBitField;
 }
 
 //-- Function: copyEng_PrepareCopyJobOffsetToOffset --------------------------------------------------------------------
@@ -313,7 +325,7 @@ static void copyEng_CopyBit (void* const pDstData,
     }
 
     /* calculate the byte mask for the destination data byte */
-    ucDestDataByteMask = (uint8_t) (((uint8_t) (0x01U << ulPrcBits) - 0x01U) << uiCurDstBitPos);
+    ucDestDataByteMask = (uint8_t) (((uint8_t) (0x01U << ulPrcBits) - 0x01U) << (uiCurDstBitPos & 0x07U));
     /* clear the bit in the destination data */
     pucDstData[uiCurDstBitPos >> 3] &= ~(ucDestDataByteMask);
     /* copy the bit from prepared source data to destination data */
@@ -501,4 +513,164 @@ static void copyEng_CopyArcSpec (void* pDstData,
   (void) memcpy(pDstData, pSrcData, pstCopyJob->uiNoOfElements);
 }
 
+//-- Function: copyEng_CopyBitField ------------------------------------------------------------------------------------
+///  \ingroup page_copyEng_api_functions
+///
+///  This function copies the specified number of bits from the specified source memory to the specified destination
+///   memory. The bits are copied in steps of up to 56 bits, each step loads the source bytes into one 64 bit value,
+///   shifts them to the destination bit position and merges them into the destination bytes with a mask.
+///
+///  \param pDstData          pointer to the destination data memory
+///  \param pSrcData          pointer to the source data memory
+///  \param pstCopyJob        pointer to the copy job information
+//----------------------------------------------------------------------------------------------------------------------
+static void copyEng_CopyBitField (void* pDstData,
+                                  void* const pSrcData,
+                                  copyJob_t* const pstCopyJob)
+{
+  uint8_t* pucDstData;
+  const uint8_t* pucSrcData;
+  uint_t uiSrcBitPos;
+  uint_t uiDstBitPos;
+  uint_t uiNoOfPendElem;
+  uint_t uiPrcBits;
+  uint_t uiSrcByteCnt;
+  uint_t uiDstByteCnt;
+  uint64_t ullDstBitMask;
+  uint64_t ullSrcData;
+  uint64_t ullDstData;
+
+  OS_ASSERT(NULL != pDstData);
+  OS_ASSERT(NULL != pSrcData);
+  OS_ASSERT(NULL != pstCopyJob);
+
+  pucDstData = (uint8_t*) pDstData;
+  pucSrcData = (const uint8_t*) pSrcData;
+
+  /* the bit positions stay the same for each step */
+  uiSrcBitPos = pstCopyJob->uiSrcDataBitPos;
+  uiDstBitPos = pstCopyJob->uiDstDataBitPos;
+  uiNoOfPendElem = pstCopyJob->uiNoOfElements;
+
+  while (0 != uiNoOfPendElem)
+  {
+    uiPrcBits = (uiNoOfPendElem < COPYENG_BIT_FIELD_STEP_SIZE) ? uiNoOfPendElem : COPYENG_BIT_FIELD_STEP_SIZE;
+
+    /* only the bytes covered by the bit field are accessed */
+    uiSrcByteCnt = (uiSrcBitPos + uiPrcBits + 7U) >> 3;
+    uiDstByteCnt = (uiDstBitPos + uiPrcBits + 7U) >> 3;
+    ullDstBitMask = ((((uint64_t) 1U) << uiPrcBits) - 1U) << uiDstBitPos;
+
+    ullSrcData = copyEng_LoadBytes(pucSrcData, uiSrcByteCnt);
+    ullDstData = copyEng_LoadBytes(pucDstData, uiDstByteCnt);
+
+    ullSrcData = (ullSrcData >> uiSrcBitPos) << uiDstBitPos;
+    ullDstData = (ullDstData & ~ullDstBitMask) | (ullSrcData & ullDstBitMask);
+
+    copyEng_StoreBytes(pucDstData, ullDstData, uiDstByteCnt);
+
+    /* update the processing information */
+    pucSrcData += uiPrcBits >> 3;
+    pucDstData += uiPrcBits >> 3;
+    uiNoOfPendElem -= uiPrcBits;
+  }
+}
+
+//-- Function: copyEng_CopyShortBitField -------------------------------------------------------------------------------
+///  \ingroup page_copyEng_api_functions
+///
+///  This function copies a bit field of up to \ref COPYENG_MAX_SHORT_BIT_FIELD_SIZE bits from the specified source
+///   memory to the specified destination memory. The destination bit mask and the number of covered bytes are
+///   calculated by the copy job generator.
+///
+///  \param pDstData          pointer to the destination data memory
+///  \param pSrcData          pointer to the source data memory
+///  \param pstCopyJob        pointer to the copy job information
+//----------------------------------------------------------------------------------------------------------------------
+static void copyEng_CopyShortBitField (void* pDstData,
+                                       void* const pSrcData,
+                                       copyJob_t* const pstCopyJob)
+{
+  uint64_t ullSrcData;
+  uint64_t ullDstData;
+
+  OS_ASSERT(NULL != pDstData);
+  OS_ASSERT(NULL != pSrcData);
+  OS_ASSERT(NULL != pstCopyJob);
+
+  ullSrcData = copyEng_LoadBytes((const uint8_t*) pSrcData, pstCopyJob->uiSrcByteCnt);
+  ullDstData = copyEng_LoadBytes((const uint8_t*) pDstData, pstCopyJob->uiDstByteCnt);
+
+  ullSrcData = (ullSrcData >> pstCopyJob->uiSrcDataBitPos) << pstCopyJob->uiDstDataBitPos;
+  ullDstData = (ullDstData & ~pstCopyJob->ullDstBitMask) | (ullSrcData & pstCopyJob->ullDstBitMask);
+
+  copyEng_StoreBytes((uint8_t*) pDstData, ullDstData, pstCopyJob->uiDstByteCnt);
+}
+
+//-- Function: copyEng_LoadBytes ---------------------------------------------------------------------------------------
+///  \ingroup page_copyEng_api_functions
+///
+///  This function loads up to 8 bytes as little endian value, the first byte is the least significant one. The
+///   memory does not need to be aligned.
+///
+///  \param pucData           pointer to the first byte
+///  \param uiNoOfBytes       number of bytes to be loaded (1 - 8)
+///
+///  \return  The loaded value, not loaded bytes are zero.
+//----------------------------------------------------------------------------------------------------------------------
+static inline uint64_t copyEng_LoadBytes (const uint8_t* pucData,
+                                          uint_t uiNoOfBytes)
+{
+  uint64_t ullData = 0;
+  uint_t uiIdx;
+
+  if (8U == uiNoOfBytes)
+  {
+    (void) memcpy(&ullData, pucData, sizeof(ullData));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    ullData = __builtin_bswap64(ullData);
+#endif
+  }
+  else
+  {
+    for (uiIdx = 0; uiIdx < uiNoOfBytes; uiIdx++)
+    {
+      ullData |= ((uint64_t) pucData[uiIdx]) << (uiIdx << 3);
+    }
+  }
+
+  return (ullData);
+}
+
+//-- Function: copyEng_StoreBytes --------------------------------------------------------------------------------------
+///  \ingroup page_copyEng_api_functions
+///
+///  This function stores the lower bytes of a value in little endian order. The memory does not need to be aligned.
+///
+///  \param pucData           pointer to the first byte
+///  \param ullData           value to be stored
+///  \param uiNoOfBytes       number of bytes to be stored (1 - 8)
+//----------------------------------------------------------------------------------------------------------------------
+static inline void copyEng_StoreBytes (uint8_t* pucData,
+                                       uint64_t ullData,
+                                       uint_t uiNoOfBytes)
+{
+  uint_t uiIdx;
+
+  if (8U == uiNoOfBytes)
+  {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    ullData = __builtin_bswap64(ullData);
+#endif
+    (void) memcpy(pucData, &ullData, sizeof(ullData));
+  }
+  else
+  {
+    for (uiIdx = 0; uiIdx < uiNoOfBytes; uiIdx++)
+    {
+      pucData[uiIdx] = (uint8_t) (ullData >> (uiIdx << 3));
+    }
+  }
+}
+
 //---- End of source file ----------------------------------------------------------------------------------------------
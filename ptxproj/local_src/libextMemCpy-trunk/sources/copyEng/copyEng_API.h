@@ -34,6 +34,9 @@
 // Defines
 //----------------------------------------------------------------------------------------------------------------------
 
+/// maximum bit size of a bit field which is copied with one 64 bit load and store (64 - 7 bit positions)
+#define COPYENG_MAX_SHORT_BIT_FIELD_SIZE  57U
+
 //----------------------------------------------------------------------------------------------------------------------
 // Macros
 //----------------------------------------------------------------------------------------------------------------------
@@ -95,6 +98,12 @@ struct copyJob_tag
   uint_t uiDstDataBitPos;
   /** number of elements to be copied */
   uint_t uiNoOfElements;
+  /** destination bit mask relating to the destination byte offset (bit field copy functions only) */
+  uint64_t ullDstBitMask;
+  /** number of source bytes covered by the bit field (short bit field copy function only) */
+  uint_t uiSrcByteCnt;
+  /** number of destination bytes covered by the bit field (short bit field copy function only) */
+  uint_t uiDstByteCnt;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -130,6 +139,10 @@ typedef struct
   copyJobFunc_t pfCopyOneDWord;
   /** architecture specific copy function */
   copyJobFunc_t pfCopyArcSpec;
+  /** bit field copy function, 64 bit wide shift and mask */
+  copyJobFunc_t pfCopyBitField;
+  /** bit field copy function for up to \ref COPYENG_MAX_SHORT_BIT_FIELD_SIZE bits with precalculated mask */
+  copyJobFunc_t pfCopyShortBitField;
 }copyEngInterfaceDesc_t;
 
 //----------------------------------------------------------------------------------------------------------------------
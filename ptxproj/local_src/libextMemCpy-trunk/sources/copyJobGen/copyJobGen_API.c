@@ -64,6 +64,9 @@ static status_t copyJobGen_GetOptimizedCopyFunction     (copyJob_t* pstCopyJob,
                                                          const uint_t uiBitSize,
                                                          copyEngInterfaceDesc_t* const pstCopyEngInterfaceDesc,
                                                          extMemCpyData_t* const pstObjData);
+static void     copyJobGen_SetBitFieldCopyFunction      (copyJob_t* pstCopyJob,
+                                                         const uint_t uiBitSize,
+                                                         copyEngInterfaceDesc_t* const pstCopyEngInterfaceDesc);
 
 //----------------------------------------------------------------------------------------------------------------------
 // Functions
@@ -418,9 +421,7 @@ static status_t copyJobGen_GetOptimizedCopyFunction (copyJob_t* pstCopyJob,
     switch (pstObjData->stSettings.enmMaxCopyOptimization)
     {
       case MAX_COPY_LEN_BIT:
-        pstCopyJob->uiNoOfElements = uiBitSize;
-        pstCopyJob->pfCopyJobFunc = pstCopyEngInterfaceDesc->pfCopyBit;
-        TRACE (EXT_MEM_CPY_TRACE_SRC_COPY_JOB_GEN, EXT_MEM_CPY_TRACE_SEV_INFO, "Select copy function <Bit>\n");
+        copyJobGen_SetBitFieldCopyFunction(pstCopyJob, uiBitSize, pstCopyEngInterfaceDesc);
         break;
 
       case MAX_COPY_LEN_BYTE:
@@ -513,12 +514,45 @@ static status_t copyJobGen_GetOptimizedCopyFunction (copyJob_t* pstCopyJob,
   }
   else
   {
-    pstCopyJob->uiNoOfElements = uiBitSize;
-    pstCopyJob->pfCopyJobFunc = pstCopyEngInterfaceDesc->pfCopyBit;
-    TRACE (EXT_MEM_CPY_TRACE_SRC_COPY_JOB_GEN, EXT_MEM_CPY_TRACE_SEV_INFO, "Select copy function <Bit>\n");
+    copyJobGen_SetBitFieldCopyFunction(pstCopyJob, uiBitSize, pstCopyEngInterfaceDesc);
   }
 
   return (status);
 }
 
+//-- Function: copyJobGen_SetBitFieldCopyFunction ----------------------------------------------------------------------
+///  \ingroup page_copyJobGen_api_functions
+///
+///  This function selects the bit field copy function for the specified bit size. For bit fields which fit into one
+///   64 bit value the destination bit mask and the number of covered bytes are calculated here once, so the copy
+///   function only has to load, shift, merge and store the data.
+///
+///  \param pstCopyJob                pointer to the currently processed copy job
+///  \param uiBitSize                 bit size to be copied by the copy function
+///  \param pstCopyEngInterfaceDesc   pointer to the copy engine interface description
+//----------------------------------------------------------------------------------------------------------------------
+static void copyJobGen_SetBitFieldCopyFunction (copyJob_t* pstCopyJob,
+                                                const uint_t uiBitSize,
+                                                copyEngInterfaceDesc_t* const pstCopyEngInterfaceDesc)
+{
+  OS_ASSERT (NULL != pstCopyJob);
+  OS_ASSERT (NULL != pstCopyEngInterfaceDesc);
+
+  pstCopyJob->uiNoOfElements = uiBitSize;
+
+  if (uiBitSize <= COPYENG_MAX_SHORT_BIT_FIELD_SIZE)
+  {
+    pstCopyJob->uiSrcByteCnt  = (pstCopyJob->uiSrcDataBitPos + uiBitSize + 7U) >> 3;
+    pstCopyJob->uiDstByteCnt  = (pstCopyJob->uiDstDataBitPos + uiBitSize + 7U) >> 3;
+    pstCopyJob->ullDstBitMask = ((((uint64_t) 1U) << uiBitSize) - 1U) << pstCopyJob->uiDstDataBitPos;
+    pstCopyJob->pfCopyJobFunc = pstCopyEngInterfaceDesc->pfCopyShortBitField;
+    TRACE (EXT_MEM_CPY_TRACE_SRC_COPY_JOB_GEN, EXT_MEM_CPY_TRACE_SEV_INFO, "Select copy function <ShortBitField>\n");
+  }
+  else
+  {
+    pstCopyJob->pfCopyJobFunc = pstCopyEngInterfaceDesc->pfCopyBitField;
+    TRACE (EXT_MEM_CPY_TRACE_SRC_COPY_JOB_GEN, EXT_MEM_CPY_TRACE_SEV_INFO, "Select copy function <BitField>\n");
+  }
+}
+
 //---- End of source file ----------------------------------------------------------------------------------------------
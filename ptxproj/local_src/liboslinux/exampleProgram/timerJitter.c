@@ -0,0 +1,133 @@
+/*
+ ============================================================================
+ Name        : timerJitter.c
+ Copyright   : WAGO GmbH & Co.Kg
+ Description : Measures the jitter of a 1 ms periodic OsTimer and, for
+               comparison, of a POSIX timer notifying with SIGEV_THREAD.
+               Usage: timerJitter [priority [cpu [periods]]]
+               priority is the SCHED_FIFO priority of the timer thread
+               (0: default scheduler), cpu the CPU it is pinned to (-1: none).
+ ============================================================================
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "OsTime.h"
+#include "OsTimer.h"
+
+#define PERIOD_NS 1000000
+
+typedef struct
+{
+   i64 * Stamps;
+   u32 Count;
+   u32 Periods;
+} tJitter;
+
+static i64 NowNs(void)
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (i64) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void Record(tJitter * jitter)
+{
+   if (jitter->Count < jitter->Periods)
+   {
+      jitter->Stamps[jitter->Count++] = NowNs();
+   }
+}
+
+static void OsTimerCallback(tOsTimer * timer, void * user)
+{
+   (void) timer;
+   Record(user);
+}
+
+static void SigevCallback(union sigval value)
+{
+   Record(value.sival_ptr);
+}
+
+static int CompareI64(const void * a, const void * b)
+{
+   i64 x = *(const i64 *) a;
+   i64 y = *(const i64 *) b;
+   return (x > y) - (x < y);
+}
+
+/* deviation of each period from the nominal 1 ms */
+static void Report(const char * name, tJitter * jitter)
+{
+   u32 count = jitter->Count - 1;
+   i64 * deviations = calloc(count, sizeof(*deviations));
+   i64 sum = 0;
+
+   for (u32 i = 0; i < count; i++)
+   {
+      i64 deviation = jitter->Stamps[i + 1] - jitter->Stamps[i] - PERIOD_NS;
+      deviations[i] = (deviation < 0) ? -deviation : deviation;
+      sum += deviations[i];
+   }
+   qsort(deviations, count, sizeof(*deviations), CompareI64);
+
+   printf("%-14s periods %u  jitter avg %lld us  p99 %lld us  max %lld us\n", name, count,
+          (long long) (sum / count / 1000),
+          (long long) (deviations[(count * 99) / 100] / 1000),
+          (long long) (deviations[count - 1] / 1000));
+   free(deviations);
+}
+
+static void Wait(tJitter * jitter)
+{
+   while (jitter->Count < jitter->Periods)
+   {
+      usleep(10000);
+   }
+}
+
+int main(int argc, char * argv[])
+{
+   i32 priority = (argc > 1) ? atoi(argv[1]) : 0;
+   i32 cpu = (argc > 2) ? atoi(argv[2]) : -1;
+   u32 periods = (argc > 3) ? (u32) atoi(argv[3]) : 10000;
+   tJitter jitter = { calloc(periods, sizeof(i64)), 0, periods };
+
+   /* OsTimer, dispatched by the timer thread */
+   if (OsTimer_ConfigureService(priority, cpu))
+   {
+      printf("configuring the timer thread failed\n");
+   }
+   tOsTimer * timer = OsTimer_Create(OsTimerCallback, &jitter);
+   tOsTime * interval = OsTime_CreateStack();
+   OsTime_Clear(interval);
+   OsTime_SetNanoSeconds(interval, PERIOD_NS);
+   OsTimer_StartInterval(timer, NULL, interval);
+   Wait(&jitter);
+   OsTimer_Destroy(timer);
+   Report("OsTimer", &jitter);
+
+   /* POSIX timer with a new thread for each expiration */
+   jitter.Count = 0;
+   timer_t posixTimer;
+   struct sigevent sigevt;
+   memset(&sigevt, 0, sizeof(sigevt));
+   sigevt.sigev_notify = SIGEV_THREAD;
+   sigevt.sigev_notify_function = SigevCallback;
+   sigevt.sigev_value.sival_ptr = &jitter;
+   timer_create(CLOCK_MONOTONIC, &sigevt, &posixTimer);
+   struct itimerspec timerspec = { { 0, PERIOD_NS }, { 0, PERIOD_NS } };
+   timer_settime(posixTimer, 0, &timerspec, NULL);
+   Wait(&jitter);
+   timer_delete(posixTimer);
+   Report("SIGEV_THREAD", &jitter);
+
+   free(jitter.Stamps);
+   return 0;
+}
@@ -59,5 +59,16 @@ i32 OsTimer_StartInterval(tOsTimer * self, tOsTime *first, tOsTime* interval);
 
 i32 OsTimer_Start(tOsTimer *self, tOsTime *value);
 
+i32 OsTimer_Stop(tOsTimer *self);
+
+/**
+ * Configures the thread which dispatches the callbacks of all timers.
+ * Can be called before or after the first timer is created.
+ * @param priority SCHED_FIFO priority of the thread, 0 keeps the default scheduler.
+ * @param cpu The CPU the thread is pinned to, -1 for no pinning.
+ * @return OS_S_OK on success, error code otherwise.
+ */
+i32 OsTimer_ConfigureService(i32 priority, i32 cpu);
+
 
 #endif  // D_OsTime_H
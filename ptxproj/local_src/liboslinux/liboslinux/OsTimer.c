@@ -15,9 +15,13 @@
 #include <errno.h>
 #include <assert.h>
 #include <memory.h>
+#include <pthread.h>
+#include <sched.h>
 #include <stdlib.h>
-
-#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
 
 #define __need_timespec
 #include <time.h>
@@ -28,6 +32,8 @@
 // Defines
 //------------------------------------------------------------------------------
 
+#define TIMER_SERVICE_MAX_EVENTS 16
+
 //------------------------------------------------------------------------------
 // Macros
 //------------------------------------------------------------------------------
@@ -39,11 +45,31 @@ typedef struct stOsTimer
 {
 	fnTimerCallback Callback;
 	void * UserData;
-	timer_t Timer;
+	int TimerFd;
+	u32 Slot;
 	volatile bool	IsStarted;
 	bool 			IsInterval;
+	bool 			IsDestroyed;
 } _stOsTimer;
 
+/* All timers are timerfds in one epoll set, dispatched by a single thread.
+ * The epoll events carry slot and generation of the timer, so that an event
+ * of a timer destroyed in the meantime is dropped instead of dereferenced. */
+typedef struct stOsTimerService
+{
+	pthread_mutex_t Lock;
+	pthread_cond_t Idle;
+	pthread_t Thread;
+	int EpollFd;
+	tOsTimer ** Slots;
+	u32 * Generations;
+	u32 SlotCount;
+	tOsTimer * Dispatching;
+	i32 Priority;
+	i32 Cpu;
+	bool IsRunning;
+} tOsTimerService;
+
 //------------------------------------------------------------------------------
 // Global variables
 //------------------------------------------------------------------------------
@@ -52,16 +78,218 @@ typedef struct stOsTimer
 // Local variables
 //------------------------------------------------------------------------------
 
-static void Callback(sigval_t sigval)
+static tOsTimerService sService =
+{
+	.Lock = PTHREAD_MUTEX_INITIALIZER,
+	.Idle = PTHREAD_COND_INITIALIZER,
+	.EpollFd = -1,
+	.Cpu = -1,
+};
+
+static i32 ApplyServiceParameters(void)
+{
+	i32 res = 0;
+
+	if (sService.Priority > 0)
+	{
+		struct sched_param param;
+		memset(&param, 0, sizeof(param));
+		param.sched_priority = sService.Priority;
+		res = pthread_setschedparam(sService.Thread, SCHED_FIFO, &param);
+		if (res)
+		{
+			OsTraceError("pthread_setschedparam failed: %s", strerror(res));
+			return res;
+		}
+	}
+
+	if (sService.Cpu >= 0)
+	{
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(sService.Cpu, &cpus);
+		res = pthread_setaffinity_np(sService.Thread, sizeof(cpus), &cpus);
+		if (res)
+		{
+			OsTraceError("pthread_setaffinity_np failed: %s", strerror(res));
+		}
+	}
+
+	return res;
+}
+
+static void Dispatch(u64 data)
 {
-	assert(sigval.sival_ptr != NULL);
-	tOsTimer * timer = sigval.sival_ptr;
-	timer->Callback(timer, timer->UserData );
+	u32 slot = (u32) data;
+	u32 generation = (u32) (data >> 32);
+	u64 expirations;
+
+	pthread_mutex_lock(&sService.Lock);
+
+	tOsTimer * timer = NULL;
+	if (slot < sService.SlotCount && sService.Generations[slot] == generation)
+	{
+		timer = sService.Slots[slot];
+	}
+
+	/* nothing to read if the timer was stopped or restarted meanwhile */
+	if (   timer == NULL
+	    || read(timer->TimerFd, &expirations, sizeof(expirations)) != sizeof(expirations))
+	{
+		pthread_mutex_unlock(&sService.Lock);
+		return;
+	}
 
 	if (! timer->IsInterval)
 	{
 		timer->IsStarted = false;
 	}
+	sService.Dispatching = timer;
+	pthread_mutex_unlock(&sService.Lock);
+
+	/* like SIGEV_THREAD, overruns of interval timers result in one call */
+	timer->Callback(timer, timer->UserData);
+
+	pthread_mutex_lock(&sService.Lock);
+	/* destroyed from within its own callback */
+	bool isDestroyed = timer->IsDestroyed;
+	sService.Dispatching = NULL;
+	pthread_cond_broadcast(&sService.Idle);
+	pthread_mutex_unlock(&sService.Lock);
+
+	if (isDestroyed)
+	{
+		free(timer);
+	}
+}
+
+static void * ServiceThread(void * arg)
+{
+	(void) arg;
+	struct epoll_event events[TIMER_SERVICE_MAX_EVENTS];
+
+	for (;;)
+	{
+		int count = epoll_wait(sService.EpollFd, events, TIMER_SERVICE_MAX_EVENTS, -1);
+		if (count < 0)
+		{
+			if (errno != EINTR)
+			{
+				OsTraceError("epoll_wait failed with errno = %d: %s", errno, strerror(errno));
+			}
+			continue;
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			Dispatch(events[i].data.u64);
+		}
+	}
+
+	return NULL;
+}
+
+/* called with the service lock held */
+static i32 StartService(void)
+{
+	if (sService.IsRunning)
+	{
+		return 0;
+	}
+
+	sService.EpollFd = epoll_create1(EPOLL_CLOEXEC);
+	if (sService.EpollFd < 0)
+	{
+		OsTraceError("epoll_create1 failed with errno = %d: %s", errno, strerror(errno));
+		return errno;
+	}
+
+	i32 res = pthread_create(&sService.Thread, NULL, ServiceThread, NULL);
+	if (res)
+	{
+		OsTraceError("pthread_create failed: %s", strerror(res));
+		close(sService.EpollFd);
+		sService.EpollFd = -1;
+		return res;
+	}
+
+	(void) pthread_setname_np(sService.Thread, "OsTimer");
+	sService.IsRunning = true;
+	(void) ApplyServiceParameters();
+
+	return 0;
+}
+
+/* called with the service lock held */
+static i32 AddToService(tOsTimer * self)
+{
+	u32 slot = 0;
+	while (slot < sService.SlotCount && sService.Slots[slot] != NULL)
+	{
+		slot++;
+	}
+
+	if (slot == sService.SlotCount)
+	{
+		u32 count = (sService.SlotCount == 0) ? 16 : (2 * sService.SlotCount);
+		tOsTimer ** slots = realloc(sService.Slots, count * sizeof(*slots));
+		if (slots == NULL)
+		{
+			return OS_E_NO_MEMORY;
+		}
+		sService.Slots = slots;
+
+		u32 * generations = realloc(sService.Generations, count * sizeof(*generations));
+		if (generations == NULL)
+		{
+			return OS_E_NO_MEMORY;
+		}
+		sService.Generations = generations;
+
+		for (u32 i = sService.SlotCount; i < count; i++)
+		{
+			sService.Slots[i] = NULL;
+			sService.Generations[i] = 0;
+		}
+		sService.SlotCount = count;
+	}
+
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.u64 = ((u64) sService.Generations[slot] << 32) | slot;
+
+	if (epoll_ctl(sService.EpollFd, EPOLL_CTL_ADD, self->TimerFd, &event))
+	{
+		OsTraceError("epoll_ctl failed with errno = %d: %s", errno, strerror(errno));
+		return errno;
+	}
+
+	self->Slot = slot;
+	sService.Slots[slot] = self;
+	return 0;
+}
+
+static i32 SetTime(tOsTimer * self, int flags, struct itimerspec const * timerspec)
+{
+	if (timerfd_settime(self->TimerFd, flags, timerspec, NULL))
+	{
+		return errno;
+	}
+	return 0;
+}
+
+i32 OsTimer_ConfigureService(i32 priority, i32 cpu)
+{
+	pthread_mutex_lock(&sService.Lock);
+
+	sService.Priority = priority;
+	sService.Cpu = cpu;
+
+	i32 res = sService.IsRunning ? ApplyServiceParameters() : 0;
+
+	pthread_mutex_unlock(&sService.Lock);
+	return res;
 }
 
 i32 OsTimer_StartInterval(tOsTimer * self, tOsTime *first, tOsTime* interval)
@@ -84,15 +312,14 @@ i32 OsTimer_StartInterval(tOsTimer * self, tOsTime *first, tOsTime* interval)
 
 		timerspec.it_value = *(struct timespec*) OsTime_GetOsHandle(startTime);
 
-		res = timer_settime(self->Timer, TIMER_ABSTIME,
-				&timerspec,
-				NULL);
+		res = SetTime(self, TFD_TIMER_ABSTIME, &timerspec);
 
 	}
 	else
 	{
-		res = timer_settime(self->Timer, 0,
-				&timerspec, NULL);
+		/* first expiration after one interval */
+		timerspec.it_value = timerspec.it_interval;
+		res = SetTime(self, 0, &timerspec);
 	}
 
 	return res;
@@ -115,9 +342,9 @@ i32 OsTimer_Start(tOsTimer *self, tOsTime *value)
 
 	OsTime_ConvertToMonotonic(value, time);
 
-	timerspec.it_value = *(struct timespec*) OsTime_GetOsHandle(value);
+	timerspec.it_value = *(struct timespec*) OsTime_GetOsHandle(time);
 
-	return timer_settime(self->Timer, TIMER_ABSTIME, &timerspec, NULL);
+	return SetTime(self, TFD_TIMER_ABSTIME, &timerspec);
 }
 
 
@@ -127,7 +354,8 @@ i32 OsTimer_Stop(tOsTimer *self)
    struct itimerspec timerspec;
 
    memset(&timerspec, 0, sizeof(timerspec));
-   return timer_settime(self->Timer, TIMER_ABSTIME, &timerspec, NULL);
+   self->IsStarted = false;
+   return SetTime(self, TFD_TIMER_ABSTIME, &timerspec);
 }
 
 
@@ -136,11 +364,10 @@ tOsTimer* OsTimer_Create(fnTimerCallback callback,
 {
    assert(callback != NULL);
    tOsTimer *self = calloc(1, sizeof(*self));
-
-   sigevent_t sigevt;
-   sigevt.sigev_notify = SIGEV_THREAD;
-   sigevt.sigev_notify_function = Callback;
-   sigevt.sigev_value.sival_ptr = self;
+   if (self == NULL)
+   {
+      return NULL;
+   }
 
    self->Callback = callback;
 
@@ -150,10 +377,26 @@ tOsTimer* OsTimer_Create(fnTimerCallback callback,
     */
    self->UserData = (void*) userData;
 
-   if (timer_create(CLOCK_MONOTONIC, &sigevt, &self->Timer))
+   self->TimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+   if (self->TimerFd < 0)
+   {
+      OsTraceError("timerfd_create failed with errno = %d: %s", errno, strerror(errno));
+      free(self);
+      return NULL;
+   }
+
+   pthread_mutex_lock(&sService.Lock);
+   i32 res = StartService();
+   if (res == 0)
    {
-      OsTraceError("timer_create failed with errno = %d: %s", errno, strerror(errno));
-      OsTimer_Destroy(self);
+      res = AddToService(self);
+   }
+   pthread_mutex_unlock(&sService.Lock);
+
+   if (res)
+   {
+      close(self->TimerFd);
+      free(self);
       self = NULL;
    }
 
@@ -165,8 +408,36 @@ void OsTimer_Destroy(tOsTimer * self)
 {
    if ( self != NULL)
    {
-      OsTimer_Stop(self);
-      timer_delete(self->Timer);
-      free(self);
+      pthread_mutex_lock(&sService.Lock);
+
+      (void) epoll_ctl(sService.EpollFd, EPOLL_CTL_DEL, self->TimerFd, NULL);
+      close(self->TimerFd);
+      sService.Slots[self->Slot] = NULL;
+      sService.Generations[self->Slot]++;
+
+      bool deferred = false;
+      if (sService.Dispatching == self)
+      {
+         if (pthread_equal(pthread_self(), sService.Thread))
+         {
+            /* freed by the service thread after the callback returned */
+            self->IsDestroyed = true;
+            deferred = true;
+         }
+         else
+         {
+            while (sService.Dispatching == self)
+            {
+               pthread_cond_wait(&sService.Idle, &sService.Lock);
+            }
+         }
+      }
+
+      pthread_mutex_unlock(&sService.Lock);
+
+      if (! deferred)
+      {
+         free(self);
+      }
    }
 }
@@ -0,0 +1,107 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// Copyright (c) 2018-2022 WAGO GmbH & Co. KG
+
+// pthread_create and pthread_setschedparam latency with many living threads.
+//
+// The wrapper is only active in the runtime system, so the binary has to be
+// named like it:
+//   gcc -O2 -pthread benchmark.c -o codesys3
+//   LD_PRELOAD=libpthreadcgroup.so ./codesys3 [threads]
+//
+// A large rule file for /etc/cgrules.conf is printed with
+//   ./codesys3 -g [rules]
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static pthread_barrier_t done;
+
+static void *thread_routine(void *args)
+{
+	(void)args;
+	pthread_barrier_wait(&done);
+	return NULL;
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+static void print_rules(unsigned rules)
+{
+	// filler rules for other processes in front of the runtime system rules
+	for (unsigned i = 0; i < rules; i++)
+		printf("root:bench_process%05u    cpuacct     default/other\n", i);
+	for (int policy = 0; policy <= 2; policy++)
+		for (int prio = 0; prio <= 99; prio++)
+			printf("root:cdsv3_pol%02dprio%03d        cpuacct     %s\n", policy, prio,
+			       (policy == 0) ? "rts/def" : "rts/iec");
+}
+
+int main (int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "-g") == 0)
+	{
+		print_rules((argc > 2) ? (unsigned)atoi(argv[2]) : 10000U);
+		return 0;
+	}
+
+	unsigned count = (argc > 1) ? (unsigned)atoi(argv[1]) : 4000U;
+	pthread_t *threads = calloc(count, sizeof(*threads));
+	if (threads == NULL)
+		return 1;
+
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, 64U * 1024U);
+	pthread_barrier_init(&done, NULL, count + 1U);
+
+	// all threads stay alive, so the registry grows with each thread
+	uint64_t max_ns = 0;
+	uint64_t start = now_ns();
+	for (unsigned i = 0; i < count; i++)
+	{
+		uint64_t create_start = now_ns();
+		if (pthread_create(&threads[i], &attr, thread_routine, NULL) != 0)
+		{
+			printf("pthread_create failed after %u threads\n", i);
+			return 1;
+		}
+		uint64_t create_ns = now_ns() - create_start;
+		if (create_ns > max_ns)
+			max_ns = create_ns;
+	}
+	uint64_t create_total_ns = now_ns() - start;
+
+	// applies the rule of the new priority to each thread
+	struct sched_param param = { .sched_priority = 0 };
+	start = now_ns();
+	for (unsigned i = 0; i < count; i++)
+		pthread_setschedparam(threads[i], SCHED_OTHER, &param);
+	uint64_t sched_total_ns = now_ns() - start;
+
+	pthread_barrier_wait(&done);
+	for (unsigned i = 0; i < count; i++)
+		pthread_join(threads[i], NULL);
+
+	printf("threads:               %u\n", count);
+	printf("pthread_create:        %llu ns average, %llu ns max\n",
+	       (unsigned long long)(create_total_ns / count), (unsigned long long)max_ns);
+	printf("pthread_setschedparam: %llu ns average\n", (unsigned long long)(sched_total_ns / count));
+
+	pthread_barrier_destroy(&done);
+	pthread_attr_destroy(&attr);
+	free(threads);
+	return 0;
+}
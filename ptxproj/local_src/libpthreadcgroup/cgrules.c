@@ -8,6 +8,9 @@
 #include "cgrules.h"
 
 #include <libcgroup.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "pthread_wrapper.h"
@@ -16,12 +19,50 @@
 #define CGRULES_CONF_FILE "/etc/cgrules.conf"
 #define CGCONFIG_CONF_FILE "/etc/cgconfig.conf"
 
+#define CGRULES_MAX_GROUPS   4
+#define CGRULES_MAX_POLICY   7
+#define CGRULES_MAX_PRIO     99
+
+/* rules of one process name, resolved to the destination groups */
+struct cgrules_entry
+{
+	char *name;
+	struct cgroup *groups[CGRULES_MAX_GROUPS];
+	size_t group_count;
+};
+
+/* destination groups shared by all rules with the same destination */
+struct cgrules_group
+{
+	char *controllers;
+	char *destination;
+	struct cgroup *group;
+};
+
 static struct cgroup *default_group;
 static char proc_name[4096];
 static bool isRuntimeSystem = false;
 static bool isCodesysV2 = false;
 static bool isCodesysV3= false;
 
+/*
+ * Rules of cgrules.conf compiled at load. The tables are written in
+ * cgrules_init only and read without locking afterwards. If the rule file
+ * contains rules which cannot be compiled, names
+ * without an entry are still matched by libcgroup.
+ */
+static struct cgrules_entry *rule_table;
+static size_t rule_table_size;
+static size_t rule_count;
+static struct cgrules_entry *catch_all_rule;
+static bool rules_compiled = false;
+static struct cgrules_group *rule_groups;
+static size_t rule_group_count;
+static const struct cgrules_entry *prio_rules[CGRULES_MAX_POLICY + 1][CGRULES_MAX_PRIO + 1];
+
+static void cgrules_get_task_name_by_prio(char *buffer, size_t buffer_size, int prio, int policy);
+static void cgrules_compile(void);
+
 void cgrules_init()
 {
 	FILE* f = fopen("/proc/self/comm","r");
@@ -77,6 +118,8 @@ void cgrules_init()
         WARN("cgroup_change_all_cgroups() failed: %s", cgroup_strerror(ret));
     }
 
+    cgrules_compile();
+
     default_group = cgroup_new_cgroup("/rts/def");
     ret = cgroup_get_cgroup(default_group);
     if (ret != 0)
@@ -91,6 +134,260 @@ finished:
     return;
 }
 
+static uint32_t cgrules_hash(const char *name)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U;
+	while (*name != '\0')
+	{
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
+static struct cgrules_entry *cgrules_find_slot(struct cgrules_entry *table, size_t size, const char *name)
+{
+	size_t index = cgrules_hash(name) & (size - 1U);
+	while (table[index].name != NULL && strcmp(table[index].name, name) != 0)
+		index = (index + 1U) & (size - 1U);
+	return &table[index];
+}
+
+static const struct cgrules_entry *cgrules_lookup(const char *name)
+{
+	if (rule_table != NULL)
+	{
+		const struct cgrules_entry *entry = cgrules_find_slot(rule_table, rule_table_size, name);
+		if (entry->name != NULL)
+			return entry;
+	}
+	return catch_all_rule;
+}
+
+static bool cgrules_grow_table(void)
+{
+	size_t size = (rule_table_size == 0U) ? 256U : (2U * rule_table_size);
+	struct cgrules_entry *table = calloc(size, sizeof(*table));
+	if (table == NULL)
+		return false;
+
+	for (size_t i = 0U; i < rule_table_size; i++)
+	{
+		if (rule_table[i].name != NULL)
+			*cgrules_find_slot(table, size, rule_table[i].name) = rule_table[i];
+	}
+	free(rule_table);
+	rule_table = table;
+	rule_table_size = size;
+	return true;
+}
+
+/*
+ * Sets *entry to the entry of a new process name or to NULL if an earlier rule
+ * already matches the name. Returns false if memory ran out.
+ */
+static bool cgrules_add_entry(const char *name, struct cgrules_entry **entry)
+{
+	*entry = NULL;
+
+	/* keep the load factor below one half */
+	if ((2U * (rule_count + 1U)) > rule_table_size && !cgrules_grow_table())
+		return false;
+
+	struct cgrules_entry *slot = cgrules_find_slot(rule_table, rule_table_size, name);
+	if (slot->name != NULL)
+		return true;
+
+	slot->name = strdup(name);
+	if (slot->name == NULL)
+		return false;
+	rule_count++;
+	*entry = slot;
+	return true;
+}
+
+static struct cgroup *cgrules_get_group(const char *controllers, const char *destination)
+{
+	for (size_t i = 0U; i < rule_group_count; i++)
+	{
+		if (   strcmp(rule_groups[i].controllers, controllers) == 0
+		    && strcmp(rule_groups[i].destination, destination) == 0)
+			return rule_groups[i].group;
+	}
+
+	struct cgrules_group *groups = realloc(rule_groups, (rule_group_count + 1U) * sizeof(*groups));
+	if (groups == NULL)
+		return NULL;
+	rule_groups = groups;
+
+	struct cgroup *group = cgroup_new_cgroup(destination);
+	if (group == NULL)
+		return NULL;
+
+	/* all controllers the destination exists in */
+	if (strcmp(controllers, "*") == 0)
+	{
+		if (cgroup_get_cgroup(group) != 0)
+		{
+			cgroup_free(&group);
+			return NULL;
+		}
+	}
+
+	char list[256];
+	char *saveptr = NULL;
+	snprintf(list, sizeof(list), "%s", controllers);
+	for (char *controller = strtok_r(list, ",", &saveptr);
+	     controller != NULL && strcmp(controller, "*") != 0;
+	     controller = strtok_r(NULL, ",", &saveptr))
+	{
+		if (cgroup_add_controller(group, controller) == NULL)
+		{
+			cgroup_free(&group);
+			return NULL;
+		}
+	}
+
+	rule_groups[rule_group_count].controllers = strdup(controllers);
+	rule_groups[rule_group_count].destination = strdup(destination);
+	rule_groups[rule_group_count].group = group;
+	rule_group_count++;
+	return group;
+}
+
+static bool cgrules_add_group(struct cgrules_entry *entry, const char *controllers, const char *destination)
+{
+	if (entry->group_count >= CGRULES_MAX_GROUPS)
+		return false;
+
+	struct cgroup *group = cgrules_get_group(controllers, destination);
+	if (group == NULL)
+		return false;
+
+	entry->groups[entry->group_count++] = group;
+	return true;
+}
+
+/* threads are moved with uid 0 and gid 0, see cgrules_apply_rule_by_name */
+static bool cgrules_user_matches_root(const char *user)
+{
+	return strcmp(user, "*") == 0 || strcmp(user, "root") == 0 || strcmp(user, "@root") == 0;
+}
+
+/*
+ * Compiles the rules libcgroup would match for the thread names of this
+ * process into a hash table. Like libcgroup the first matching rule wins and
+ * '%' lines add destinations to the preceding rule. Compiling stops at rules
+ * which cannot be resolved in advance (templates, unknown destinations);
+ * libcgroup handles those at run time.
+ */
+static void cgrules_compile(void)
+{
+	FILE *f = fopen(CGRULES_CONF_FILE, "r");
+	if (f == NULL)
+		return;
+
+	char line[1024];
+	struct cgrules_entry *current = NULL;
+	bool complete = true;
+
+	while (fgets(line, sizeof(line), f) != NULL)
+	{
+		char key[256];
+		char controllers[256];
+		char destination[256];
+
+		char *comment = strchr(line, '#');
+		if (comment != NULL)
+			*comment = '\0';
+		if (sscanf(line, "%255s %255s %255s", key, controllers, destination) != 3)
+			continue;
+
+		if (strcmp(key, "%") == 0)
+		{
+			if (current == NULL)
+				continue;
+			if (   strchr(destination, '%') != NULL
+			    || !cgrules_add_group(current, controllers, destination))
+			{
+				complete = false;
+				break;
+			}
+			continue;
+		}
+
+		/* no later rule can match after a rule for all processes */
+		if (catch_all_rule != NULL)
+			break;
+
+		current = NULL;
+		char *process = strchr(key, ':');
+		if (process != NULL)
+			*process++ = '\0';
+
+		/*
+		 * rules for other users never match. Names with '/' are kept:
+		 * libcgroup compares them with the whole thread name, e.g. "irq/83-eth0".
+		 */
+		if (!cgrules_user_matches_root(key))
+			continue;
+
+		/* templates depend on the matched process */
+		if (strchr(destination, '%') != NULL)
+		{
+			complete = false;
+			break;
+		}
+
+		if (process == NULL || strcmp(process, "*") == 0)
+		{
+			catch_all_rule = calloc(1, sizeof(*catch_all_rule));
+			current = catch_all_rule;
+			if (current == NULL)
+			{
+				ERROR("out of memory compiling the rule for %s", "*");
+				complete = false;
+				break;
+			}
+		}
+		else if (!cgrules_add_entry(process, &current))
+		{
+			ERROR("out of memory compiling the rule for %s", process);
+			complete = false;
+			break;
+		}
+
+		if (current != NULL && !cgrules_add_group(current, controllers, destination))
+		{
+			complete = false;
+			break;
+		}
+	}
+	fclose(f);
+
+	rules_compiled = complete;
+
+	for (int policy = 0; policy <= CGRULES_MAX_POLICY; policy++)
+	{
+		for (int prio = 0; prio <= CGRULES_MAX_PRIO; prio++)
+		{
+			char prio_name[sizeof("rtsVx::pol00prio000")];
+			cgrules_get_task_name_by_prio(prio_name, sizeof(prio_name), prio, policy);
+			prio_rules[policy][prio] = cgrules_lookup(prio_name);
+		}
+	}
+
+	DBG("compiled %zu process rules into %zu groups%s", rule_count, rule_group_count,
+	    complete ? "" : ", libcgroup matches the remaining rules");
+}
+
+static void cgrules_attach(const struct cgrules_entry *entry, pid_t tpid)
+{
+	for (size_t i = 0U; i < entry->group_count; i++)
+		cgroup_attach_task_pid(entry->groups[i], tpid);
+}
+
 static void cgrules_get_task_name_by_prio(char *buffer, size_t buffer_size, int prio, int policy)
 {
     if (isCodesysV2)
@@ -121,12 +418,29 @@ void cgrules_apply_rule_by_name(const char *name, pid_t tpid)
     if (strcmp(name, proc_name))
     {
     	DBG("cgrules_apply_rule_by_name: %s", name);
-    	cgroup_change_cgroup_flags(0, 0, name, tpid, CGFLAG_USECACHE);
+    	const struct cgrules_entry *entry = cgrules_lookup(name);
+    	if (entry != NULL)
+    		cgrules_attach(entry, tpid);
+    	else if (!rules_compiled)
+    		cgroup_change_cgroup_flags(0, 0, name, tpid, CGFLAG_USECACHE);
     }
 }
 
 void cgrules_apply_rule_by_prio(pid_t tpid, int prio, int policy)
 {
+	if (!isRuntimeSystem) return;
+	if (policy >= 0 && policy <= CGRULES_MAX_POLICY && prio >= 0 && prio <= CGRULES_MAX_PRIO)
+	{
+		const struct cgrules_entry *entry = prio_rules[policy][prio];
+		if (entry != NULL)
+		{
+			cgrules_attach(entry, tpid);
+			return;
+		}
+		if (rules_compiled)
+			return;
+	}
+
 	char prio_name[sizeof("rtsVx::pol00prio000")];
 	cgrules_get_task_name_by_prio(prio_name, sizeof(prio_name), prio, policy);
 	cgrules_apply_rule_by_name(prio_name, tpid);
@@ -12,6 +12,7 @@
 #include <signal.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -61,25 +62,47 @@ typedef struct thread_params
     void *arg;
 } thread_params;
 
-static thread_info_list first;
+/*
+ * Registry of the started threads, sharded by pthread_t so that creating and
+ * exiting threads only contend with threads of the same shard. Each shard is a
+ * list headed by a sentinel entry and protected by its own lock.
+ */
+#define THREAD_REGISTRY_SHARD_BITS 6U
+#define THREAD_REGISTRY_SHARDS     (1U << THREAD_REGISTRY_SHARD_BITS)
 
-static __thread thread_info_list self;
+struct thread_registry_shard
+{
+    pthread_mutex_t lock;
+    thread_info_list first;
+} __attribute__((aligned(64)));
 
-static pthread_mutex_t thread_info_list_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct thread_registry_shard thread_registry[THREAD_REGISTRY_SHARDS];
+
+static __thread thread_info_list self;
 
 __attribute__((constructor)) static void initialize()
 {
+    for (size_t i = 0; i < THREAD_REGISTRY_SHARDS; i++)
+        pthread_mutex_init(&thread_registry[i].lock, NULL);
+
     LOAD_REAL_FUNC(pthread_create);
     LOAD_REAL_FUNC(pthread_setschedparam);
     cgrules_init();
 }
 
-static bool add_to_thread_list(struct thread_info_list *thread_info_list)
+static struct thread_registry_shard *get_shard(pthread_t thread)
+{
+    /* pthread_t is the address of the thread descriptor, mix the upper bits in */
+    uint64_t hash = (uint64_t)(uintptr_t)thread * UINT64_C(0x9E3779B97F4A7C15);
+    return &thread_registry[hash >> (64U - THREAD_REGISTRY_SHARD_BITS)];
+}
+
+static bool add_to_thread_list(struct thread_registry_shard *shard, struct thread_info_list *thread_info_list)
 {
 	bool alreadyInList = false;
 
 	struct thread_info thread_info = thread_info_list->thread_info;
-	struct thread_info_list *current = &first;
+	struct thread_info_list *current = &shard->first;
 	while (current->next != NULL)
 	{
 		if (current->next->thread_info.pthread == thread_info.pthread)
@@ -104,9 +127,13 @@ static void register_thread()
     self.thread_info.pthread = pthread_self();
     self.next = NULL;
 
-    pthread_mutex_lock(&thread_info_list_lock);
+    struct thread_registry_shard *shard = get_shard(self.thread_info.pthread);
 
-    add_to_thread_list(&self);
+    /* the shard lock orders the rule applied here against a concurrent
+       pthread_setschedparam for this thread */
+    pthread_mutex_lock(&shard->lock);
+
+    add_to_thread_list(shard, &self);
     cgrules_move_to_default(self.thread_info.thread_pid);
 
 	int policy;
@@ -114,69 +141,55 @@ static void register_thread()
 	pthread_getschedparam(pthread_self(), &policy, &sched_param);
 	cgrules_apply_rule_by_prio(self.thread_info.thread_pid, sched_param.__sched_priority, policy);
 
-    pthread_mutex_unlock(&thread_info_list_lock);
+    pthread_mutex_unlock(&shard->lock);
 }
 
 static void unregister_thread(void*  arg)
 {
     (void)arg;
     //DBG("%s", __func__);
-    pthread_mutex_lock(&thread_info_list_lock);
+    struct thread_registry_shard *shard = get_shard(self.thread_info.pthread);
+
+    pthread_mutex_lock(&shard->lock);
 
-    thread_info_list *current = &first;
+    thread_info_list *current = &shard->first;
     while (current->next != &self)
         current = current->next;
 
     current->next = self.next;
 
-    pthread_mutex_unlock(&thread_info_list_lock);
+    pthread_mutex_unlock(&shard->lock);
 }
 
-static void add_dummy_entry_to_list(pthread_t thread)
+static pid_t get_thread_pid(pthread_t thread)
 {
-	pthread_mutex_lock(&thread_info_list_lock);
+	struct thread_registry_shard *shard = get_shard(thread);
+	pid_t thread_pid = 0;
 
-	struct thread_info_list *current = &first;
+	pthread_mutex_lock(&shard->lock);
 
-	while(current != NULL && current->thread_info.pthread != thread)
+	thread_info_list *current = &shard->first;
+	while (current->next != NULL && current->next->thread_info.pthread != thread)
 		current = current->next;
 
-	if (current == NULL)
+	if (current->next != NULL)
 	{
-		struct thread_info_list *thread_info_list = calloc(1, sizeof(*thread_info_list));
-		thread_info_list->thread_info.pthread = thread;
-
-		current = &first;
-		while(current->next != NULL)
-			current = current->next;
-
-		current->next = thread_info_list;
+		thread_pid = current->next->thread_info.thread_pid;
 	}
-
-	pthread_mutex_unlock(&thread_info_list_lock);
-}
-
-static pid_t get_thread_pid(pthread_t thread)
-{
-	pthread_mutex_lock(&thread_info_list_lock);
-
-	thread_info_list *current = &first;
-	while (current != NULL)
-		if (current->thread_info.pthread == thread)
-			break;
-		else
-			current = current->next;
-
-	pthread_mutex_unlock(&thread_info_list_lock);
-
-	// is the thread not started yet?
-	if (current == NULL)
+	else
 	{
-		add_dummy_entry_to_list(thread);
-		return get_thread_pid(thread);
+		// the thread is not started yet, remember it until it registers
+		struct thread_info_list *thread_info_list = calloc(1, sizeof(*thread_info_list));
+		if (thread_info_list != NULL)
+		{
+			thread_info_list->thread_info.pthread = thread;
+			current->next = thread_info_list;
+		}
 	}
 
-	return current->thread_info.thread_pid;
+	pthread_mutex_unlock(&shard->lock);
+
+	return thread_pid;
 }
 
 static void *start_routine2(thread_params *params)
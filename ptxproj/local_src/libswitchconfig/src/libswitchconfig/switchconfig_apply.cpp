@@ -122,12 +122,8 @@ status remove_port_mirror(const ::std::string& port_name) {
 }
 
 status apply_port_mirroring(const port_mirror port_mirror, switch_type switch_type) {
-  status status = tc_add_mirror(port_mirror.source, port_mirror.destination, "egress", switch_type);
-  if (!status.ok()) {
-    return status;
-  }
-
-  return tc_add_mirror(port_mirror.source, port_mirror.destination, "ingress", switch_type);
+  return tc_add_mirror(port_mirror.source, port_mirror.destination, ::std::vector<::std::string>{"egress", "ingress"},
+                       switch_type);
 }
 
 status apply_port_mirroring(const port_mirror& port_mirror, const ::std::vector<system_port>& system_ports, switch_type switch_type) {
@@ -0,0 +1,304 @@
+// Copyright (c) 2023 WAGO GmbH & Co. KG
+// SPDX-License-Identifier: MPL-2.0
+
+#include "rtnetlink.hpp"
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+namespace wago::libswitchconfig {
+
+namespace {
+
+constexpr ::std::size_t receive_buffer_size = 65536;
+
+status make_errno_status(const ::std::string& what, int error) {
+  return status{status_code::SYSTEM_CALL_ERROR, what + ": " + ::std::strerror(error)};
+}
+
+// Same as tc prints it: the errno text followed by the extended ack message of the kernel, if any.
+status make_nlmsgerr_status(const nlmsghdr& nlh) {
+  if (nlh.nlmsg_len < NLMSG_LENGTH(sizeof(nlmsgerr))) {
+    return status{status_code::SYSTEM_CALL_ERROR, "truncated netlink error message"};
+  }
+  auto err = static_cast<const nlmsgerr*>(NLMSG_DATA(&nlh));
+  ::std::string msg = ::std::strerror(-err->error);
+
+  if ((nlh.nlmsg_flags & NLM_F_ACK_TLVS) != 0) {
+    ::std::size_t offset = sizeof(nlmsgerr);
+    if ((nlh.nlmsg_flags & NLM_F_CAPPED) == 0) {
+      offset += err->msg.nlmsg_len - sizeof(nlmsghdr);
+    }
+    auto payload = nlh.nlmsg_len - NLMSG_HDRLEN;
+    if (offset < payload) {
+      auto first = reinterpret_cast<const rtattr*>(static_cast<const ::std::uint8_t*>(NLMSG_DATA(&nlh)) + offset);
+      rtattr_table tlvs{first, payload - offset, NLMSGERR_ATTR_MAX};
+      if (tlvs.has(NLMSGERR_ATTR_MSG)) {
+        msg = "Error: " + tlvs.get_string(NLMSGERR_ATTR_MSG) + " (" + msg + ")";
+      }
+    }
+  }
+  return status{status_code::SYSTEM_CALL_ERROR, ::std::move(msg)};
+}
+
+}  // namespace
+
+tc_request::tc_request(::std::uint16_t type, ::std::uint16_t flags, const tcmsg& tcm)
+    : buffer(NLMSG_SPACE(sizeof(tcmsg)), 0) {
+  auto nlh         = header();
+  nlh->nlmsg_len   = NLMSG_LENGTH(sizeof(tcmsg));
+  nlh->nlmsg_type  = type;
+  nlh->nlmsg_flags = flags;
+  ::std::memcpy(NLMSG_DATA(nlh), &tcm, sizeof(tcm));
+}
+
+nlmsghdr* tc_request::header() {
+  return reinterpret_cast<nlmsghdr*>(buffer.data());
+}
+
+const ::std::vector<::std::uint8_t>& tc_request::data() const {
+  return buffer;
+}
+
+void tc_request::put(::std::uint16_t type, const void* data, ::std::size_t len) {
+  auto offset = NLMSG_ALIGN(header()->nlmsg_len);
+  buffer.resize(offset + RTA_SPACE(len), 0);
+
+  auto attr      = reinterpret_cast<rtattr*>(buffer.data() + offset);
+  attr->rta_type = type;
+  attr->rta_len  = RTA_LENGTH(len);
+  if (len > 0) {
+    ::std::memcpy(RTA_DATA(attr), data, len);
+  }
+  header()->nlmsg_len = offset + RTA_SPACE(len);
+}
+
+void tc_request::put_u16(::std::uint16_t type, ::std::uint16_t value) {
+  put(type, &value, sizeof(value));
+}
+
+void tc_request::put_u32(::std::uint16_t type, ::std::uint32_t value) {
+  put(type, &value, sizeof(value));
+}
+
+void tc_request::put_u64(::std::uint16_t type, ::std::uint64_t value) {
+  put(type, &value, sizeof(value));
+}
+
+void tc_request::put_string(::std::uint16_t type, const ::std::string& value) {
+  put(type, value.c_str(), value.size() + 1);
+}
+
+::std::size_t tc_request::begin_nest(::std::uint16_t type) {
+  auto offset = NLMSG_ALIGN(header()->nlmsg_len);
+  put(type, nullptr, 0);
+  return offset;
+}
+
+void tc_request::end_nest(::std::size_t offset) {
+  auto attr     = reinterpret_cast<rtattr*>(buffer.data() + offset);
+  attr->rta_len = static_cast<unsigned short>(header()->nlmsg_len - offset);
+}
+
+rtnetlink::rtnetlink() : fd{-1}, seq{static_cast<::std::uint32_t>(::std::time(nullptr))} {
+  fd = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+  if (fd < 0) {
+    open_status = make_errno_status("cannot open netlink socket", errno);
+    return;
+  }
+
+  int on = 1;
+  // Errors are not fatal, without them the kernel just sends less details
+  (void)::setsockopt(fd, SOL_NETLINK, NETLINK_EXT_ACK, &on, sizeof(on));
+  (void)::setsockopt(fd, SOL_NETLINK, NETLINK_CAP_ACK, &on, sizeof(on));
+
+  sockaddr_nl local{};
+  local.nl_family = AF_NETLINK;
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) < 0) {
+    open_status = make_errno_status("cannot bind netlink socket", errno);
+  }
+}
+
+rtnetlink::~rtnetlink() {
+  if (fd >= 0) {
+    ::close(fd);
+  }
+}
+
+status rtnetlink::send(const ::std::vector<tc_request>& requests, ::std::uint32_t& first_seq) {
+  if (!open_status.ok()) {
+    return open_status;
+  }
+
+  first_seq = ++seq;
+  seq += static_cast<::std::uint32_t>(requests.size()) - 1;
+
+  ::std::vector<::std::uint8_t> batch;
+  auto next_seq = first_seq;
+  for (auto const& request : requests) {
+    auto offset = batch.size();
+    batch.insert(batch.end(), request.data().begin(), request.data().end());
+    auto nlh       = reinterpret_cast<nlmsghdr*>(batch.data() + offset);
+    nlh->nlmsg_seq = next_seq++;
+    nlh->nlmsg_pid = 0;
+  }
+
+  sockaddr_nl kernel{};
+  kernel.nl_family = AF_NETLINK;
+  iovec iov{batch.data(), batch.size()};
+  msghdr msg{};
+  msg.msg_name    = &kernel;
+  msg.msg_namelen = sizeof(kernel);
+  msg.msg_iov     = &iov;
+  msg.msg_iovlen  = 1;
+
+  ssize_t sent;
+  do {
+    sent = ::sendmsg(fd, &msg, 0);
+  } while (sent < 0 && errno == EINTR);
+
+  if (sent < 0) {
+    return make_errno_status("cannot send netlink message", errno);
+  }
+  return {};
+}
+
+status rtnetlink::receive(::std::uint32_t first_seq, ::std::size_t expected_acks, const message_handler& handler,
+                          ::std::vector<status>* results) {
+  ::std::vector<::std::uint8_t> buffer(receive_buffer_size);
+  status result;
+  auto last_seq = static_cast<::std::uint32_t>(first_seq + expected_acks - 1);
+  bool dump     = static_cast<bool>(handler);
+
+  while (expected_acks > 0) {
+    ssize_t len;
+    do {
+      len = ::recv(fd, buffer.data(), buffer.size(), 0);
+    } while (len < 0 && errno == EINTR);
+
+    if (len < 0) {
+      return make_errno_status("cannot receive netlink message", errno);
+    }
+
+    auto remaining = static_cast<unsigned int>(len);
+    for (auto nlh = reinterpret_cast<const nlmsghdr*>(buffer.data()); NLMSG_OK(nlh, remaining);
+         nlh      = NLMSG_NEXT(nlh, remaining)) {
+      if (nlh->nlmsg_seq < first_seq || nlh->nlmsg_seq > last_seq) {
+        continue;
+      }
+
+      if (nlh->nlmsg_type == NLMSG_ERROR) {
+        auto err = static_cast<const nlmsgerr*>(NLMSG_DATA(nlh));
+        auto request_status = err->error != 0 ? make_nlmsgerr_status(*nlh) : status{};
+        if (!request_status.ok() && result.ok()) {
+          result = request_status;
+        }
+        if (results != nullptr) {
+          results->at(nlh->nlmsg_seq - first_seq) = request_status;
+        }
+        expected_acks--;
+      } else if (nlh->nlmsg_type == NLMSG_DONE) {
+        expected_acks--;
+      } else if (dump) {
+        handler(*nlh);
+      }
+    }
+  }
+
+  return result;
+}
+
+status rtnetlink::transact(const ::std::vector<tc_request>& requests) {
+  if (requests.empty()) {
+    return {};
+  }
+
+  ::std::uint32_t first_seq = 0;
+  auto status               = send(requests, first_seq);
+  if (!status.ok()) {
+    return status;
+  }
+  return receive(first_seq, requests.size(), nullptr);
+}
+
+status rtnetlink::transact(const ::std::vector<tc_request>& requests, ::std::vector<status>& results,
+                           const message_handler& handler) {
+  results.assign(requests.size(), status{status_code::SYSTEM_CALL_ERROR, "no netlink acknowledge"});
+  if (requests.empty()) {
+    return {};
+  }
+
+  ::std::uint32_t first_seq = 0;
+  auto status               = send(requests, first_seq);
+  if (!status.ok()) {
+    return status;
+  }
+  return receive(first_seq, requests.size(), handler, &results);
+}
+
+status rtnetlink::dump(const tc_request& request, const message_handler& handler) {
+  ::std::uint32_t first_seq = 0;
+  auto status               = send({request}, first_seq);
+  if (!status.ok()) {
+    return status;
+  }
+  return receive(first_seq, 1, handler);
+}
+
+rtattr_table::rtattr_table(const rtattr* first, ::std::size_t len, ::std::uint16_t max_type)
+    : attrs(max_type + 1U, nullptr) {
+  auto remaining = static_cast<unsigned int>(len);
+  for (auto attr = first; RTA_OK(attr, remaining); attr = RTA_NEXT(attr, remaining)) {
+    auto type = static_cast<::std::uint16_t>(attr->rta_type & NLA_TYPE_MASK);
+    if (type <= max_type && attrs[type] == nullptr) {
+      attrs[type] = attr;
+    }
+  }
+}
+
+rtattr_table rtattr_table::nested(const rtattr* attr, ::std::uint16_t max_type) {
+  return rtattr_table{static_cast<const rtattr*>(RTA_DATA(attr)), RTA_PAYLOAD(attr), max_type};
+}
+
+const rtattr* rtattr_table::get(::std::uint16_t type) const {
+  return type < attrs.size() ? attrs[type] : nullptr;
+}
+
+bool rtattr_table::has(::std::uint16_t type) const {
+  return get(type) != nullptr;
+}
+
+::std::string rtattr_table::get_string(::std::uint16_t type) const {
+  auto attr = get(type);
+  if (attr == nullptr) {
+    return "";
+  }
+  auto data = static_cast<const char*>(RTA_DATA(attr));
+  return ::std::string{data, ::strnlen(data, RTA_PAYLOAD(attr))};
+}
+
+::std::uint32_t rtattr_table::get_u32(::std::uint16_t type) const {
+  ::std::uint32_t value = 0;
+  auto attr             = get(type);
+  if (attr != nullptr && RTA_PAYLOAD(attr) >= sizeof(value)) {
+    ::std::memcpy(&value, RTA_DATA(attr), sizeof(value));
+  }
+  return value;
+}
+
+::std::uint64_t rtattr_table::get_u64(::std::uint16_t type) const {
+  ::std::uint64_t value = 0;
+  auto attr             = get(type);
+  if (attr != nullptr && RTA_PAYLOAD(attr) >= sizeof(value)) {
+    ::std::memcpy(&value, RTA_DATA(attr), sizeof(value));
+  }
+  return value;
+}
+
+}  // namespace wago::libswitchconfig
@@ -0,0 +1,113 @@
+// Copyright (c) 2023 WAGO GmbH & Co. KG
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "switch_config_api.hpp"
+
+namespace wago::libswitchconfig {
+
+/**
+ * A single rtnetlink request with a traffic control header (struct tcmsg).
+ * Attributes are appended in order, nested attributes are opened with begin_nest and closed with end_nest.
+ */
+class tc_request {
+ public:
+  tc_request(::std::uint16_t type, ::std::uint16_t flags, const tcmsg& tcm);
+
+  void put(::std::uint16_t type, const void* data, ::std::size_t len);
+  void put_u16(::std::uint16_t type, ::std::uint16_t value);
+  void put_u32(::std::uint16_t type, ::std::uint32_t value);
+  void put_u64(::std::uint16_t type, ::std::uint64_t value);
+  void put_string(::std::uint16_t type, const ::std::string& value);
+
+  ::std::size_t begin_nest(::std::uint16_t type);
+  void end_nest(::std::size_t offset);
+
+  const ::std::vector<::std::uint8_t>& data() const;
+
+ private:
+  ::std::vector<::std::uint8_t> buffer;
+
+  nlmsghdr* header();
+};
+
+/**
+ * Route netlink socket used to talk to the traffic control subsystem of the kernel without spawning /usr/sbin/tc.
+ */
+class rtnetlink {
+ public:
+  using message_handler = ::std::function<void(const nlmsghdr&)>;
+
+  rtnetlink();
+  ~rtnetlink();
+  rtnetlink(const rtnetlink&)            = delete;
+  rtnetlink& operator=(const rtnetlink&) = delete;
+  rtnetlink(rtnetlink&&)                 = delete;
+  rtnetlink& operator=(rtnetlink&&)      = delete;
+
+  /**
+   * Send all requests with a single sendmsg call and wait for the acknowledge of each of them.
+   * The kernel processes the requests in order and continues after a failing one,
+   * the status of the first failing request is returned.
+   */
+  status transact(const ::std::vector<tc_request>& requests);
+
+  /**
+   * Like transact, but stores the status of each request in results and passes the messages the kernel echoes
+   * for requests with NLM_F_ECHO to the handler. Requests without an acknowledge keep an error status.
+   */
+  status transact(const ::std::vector<tc_request>& requests, ::std::vector<status>& results,
+                  const message_handler& handler);
+
+  /**
+   * Send a dump request and call the handler for each message of the answer.
+   */
+  status dump(const tc_request& request, const message_handler& handler);
+
+ private:
+  int fd;
+  ::std::uint32_t seq;
+  status open_status;
+
+  status send(const ::std::vector<tc_request>& requests, ::std::uint32_t& first_seq);
+  status receive(::std::uint32_t first_seq, ::std::size_t expected_acks, const message_handler& handler,
+                 ::std::vector<status>* results = nullptr);
+};
+
+/**
+ * Attributes of a netlink message or a nested attribute indexed by their type.
+ */
+class rtattr_table {
+ public:
+  rtattr_table(const rtattr* first, ::std::size_t len, ::std::uint16_t max_type);
+
+  const rtattr* get(::std::uint16_t type) const;
+  bool has(::std::uint16_t type) const;
+
+  ::std::string get_string(::std::uint16_t type) const;
+  ::std::uint32_t get_u32(::std::uint16_t type) const;
+  ::std::uint64_t get_u64(::std::uint16_t type) const;
+
+  template <typename T>
+  const T* get_struct(::std::uint16_t type) const {
+    auto attr = get(type);
+    return (attr != nullptr && RTA_PAYLOAD(attr) >= sizeof(T)) ? static_cast<const T*>(RTA_DATA(attr)) : nullptr;
+  }
+
+  static rtattr_table nested(const rtattr* attr, ::std::uint16_t max_type);
+
+ private:
+  ::std::vector<const rtattr*> attrs;
+};
+
+}  // namespace wago::libswitchconfig
@@ -3,13 +3,25 @@
 
 #include "tc.hpp"
 
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/pkt_cls.h>
+#include <linux/pkt_sched.h>
+#include <linux/tc_act/tc_mirred.h>
+#include <net/if.h>
+
+#include <array>
 #include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <map>
 #include <nlohmann/json.hpp>
 #include <nlohmann/json_fwd.hpp>
 #include <optional>
 #include <string>
+#include <vector>
 
-#include "program.hpp"
+#include "rtnetlink.hpp"
 #include "switch_config_api.hpp"
 
 using json = nlohmann::json;
@@ -18,57 +30,439 @@ namespace wago::libswitchconfig {
 
 namespace {
 
-::std::string build_tc_ingress_rate_cmd(const ::std::string& dst_mac, const ::std::string& rate, rate_type rt) {
-  // TODO (Team) For Bytes per second use "rate" instead of "pkts_rate".
-  //       https://man7.org/linux/man-pages/man8/tc-police.8.html
+constexpr ::std::uint32_t ingress_parent = TC_H_MAKE(TC_H_CLSACT, TC_H_MIN_INGRESS);
+constexpr ::std::uint32_t egress_parent  = TC_H_MAKE(TC_H_CLSACT, TC_H_MIN_EGRESS);
+constexpr ::std::uint32_t clsact_handle  = TC_H_MAKE(TC_H_CLSACT, 0);
+constexpr ::std::uint16_t create_flags   = NLM_F_REQUEST | NLM_F_ACK | NLM_F_EXCL | NLM_F_CREATE;
+constexpr ::std::uint16_t replace_flags  = NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE;
+constexpr ::std::uint16_t delete_flags   = NLM_F_REQUEST | NLM_F_ACK;
+constexpr ::std::uint16_t dump_flags     = NLM_F_REQUEST | NLM_F_DUMP;
+constexpr unsigned int time_units_per_sec = 1000000;
+
+struct mac_key {
+  ::std::array<::std::uint8_t, ETH_ALEN> addr{};
+  ::std::array<::std::uint8_t, ETH_ALEN> mask{};
+};
+
+status device_index(const ::std::string& port_name, int& ifindex) {
+  ifindex = static_cast<int>(::if_nametoindex(port_name.c_str()));
+  if (ifindex == 0) {
+    return status{status_code::SYSTEM_CALL_ERROR, "Cannot find device \"" + port_name + "\""};
+  }
+  return {};
+}
+
+status filter_parent(const ::std::string& direction, ::std::uint32_t& parent) {
+  if (direction == "ingress") {
+    parent = ingress_parent;
+  } else if (direction == "egress") {
+    parent = egress_parent;
+  } else {
+    return status{status_code::SYSTEM_CALL_ERROR, "TC-Tool: Invalid filter direction " + direction};
+  }
+  return {};
+}
+
+tcmsg make_tcmsg(int ifindex, ::std::uint32_t parent, ::std::uint32_t handle, ::std::uint32_t info) {
+  tcmsg tcm{};
+  tcm.tcm_family  = AF_UNSPEC;
+  tcm.tcm_ifindex = ifindex;
+  tcm.tcm_parent  = parent;
+  tcm.tcm_handle  = handle;
+  tcm.tcm_info    = info;
+  return tcm;
+}
+
+// The ticks of the packet scheduler clock per microsecond, calculated the same way as tc does.
+double tick_in_usec() {
+  static const double ticks = [] {
+    unsigned int t2us      = 0;
+    unsigned int us2t      = 0;
+    unsigned int clock_res = 0;
+    ::std::ifstream psched{"/proc/net/psched"};
+    ::std::string line;
+    if (!::std::getline(psched, line) ||
+        ::std::sscanf(line.c_str(), "%08x%08x%08x", &t2us, &us2t, &clock_res) != 3 || us2t == 0) {
+      return 1.0;
+    }
+    if (clock_res == 1000000000) {
+      t2us = us2t;
+    }
+    double clock_factor = static_cast<double>(clock_res) / time_units_per_sec;
+    return static_cast<double>(t2us) / us2t * clock_factor;
+  }();
+  return ticks;
+}
+
+::std::uint32_t calc_xmittime(::std::uint64_t rate, unsigned int size) {
+  auto time = static_cast<unsigned int>(time_units_per_sec * (static_cast<double>(size) / static_cast<double>(rate)));
+  return static_cast<::std::uint32_t>(time * tick_in_usec());
+}
 
+// Rate table of the token bucket filter, see tc_calc_rtable of iproute2
+void calc_rtable(tc_ratespec& rate, ::std::array<::std::uint32_t, TC_RTAB_SIZE / sizeof(::std::uint32_t)>& rtab) {
+  unsigned int mtu = 2047;
+  int cell_log     = 0;
+  while ((mtu >> cell_log) > 255) {
+    cell_log++;
+  }
+  for (unsigned int i = 0; i < rtab.size(); i++) {
+    auto size = ((i + 1) << cell_log);
+    if (size < rate.mpu) {
+      size = rate.mpu;
+    }
+    rtab[i] = calc_xmittime(rate.rate, size);
+  }
+  rate.cell_align = -1;
+  rate.cell_log   = static_cast<unsigned char>(cell_log);
+  rate.linklayer  = TC_LINKLAYER_ETHERNET;
+}
+
+bool parse_mac(const ::std::string& str, ::std::array<::std::uint8_t, ETH_ALEN>& mac) {
+  ::std::array<unsigned int, ETH_ALEN> bytes{};
+  char trailing = 0;
+  if (::std::sscanf(str.c_str(), "%2x:%2x:%2x:%2x:%2x:%2x%c", &bytes[0], &bytes[1], &bytes[2], &bytes[3], &bytes[4],
+                    &bytes[5], &trailing) != ETH_ALEN) {
+    return false;
+  }
+  for (::std::size_t i = 0; i < ETH_ALEN; i++) {
+    mac[i] = static_cast<::std::uint8_t>(bytes[i]);
+  }
+  return true;
+}
+
+// Accepts the dst_mac notation of tc flower: address with an optional mask given as address or prefix length.
+status parse_mac_key(const ::std::string& str, mac_key& key) {
+  auto slash = str.find('/');
+  if (!parse_mac(str.substr(0, slash), key.addr)) {
+    return status{status_code::SYSTEM_CALL_ERROR, "TC-Tool: Invalid MAC address " + str};
+  }
+  key.mask.fill(0xFF);
+  if (slash == ::std::string::npos) {
+    return {};
+  }
+
+  auto mask = str.substr(slash + 1);
+  if (parse_mac(mask, key.mask)) {
+    return {};
+  }
+  try {
+    auto bits = ::std::stoul(mask);
+    if (bits <= ETH_ALEN * 8) {
+      for (::std::size_t i = 0; i < ETH_ALEN; i++) {
+        auto byte_bits = bits > i * 8 ? ::std::min<unsigned long>(bits - i * 8, 8) : 0;
+        key.mask[i]    = static_cast<::std::uint8_t>(0xFF00U >> byte_bits);
+      }
+      return {};
+    }
+  } catch (...) {  // NOLINT(bugprone-empty-catch) reported below
+  }
+  return status{status_code::SYSTEM_CALL_ERROR, "TC-Tool: Invalid MAC mask " + str};
+}
+
+::std::string format_mac(const ::std::uint8_t* mac) {
+  ::std::array<char, 18> buffer{};
+  ::std::snprintf(buffer.data(), buffer.size(), "%02x:%02x:%02x:%02x:%02x:%02x", mac[0], mac[1], mac[2], mac[3], mac[4],
+                  mac[5]);
+  return buffer.data();
+}
+
+// Same notation as tc flower prints it, the mask is omitted if it is full and given as prefix length if possible.
+::std::string format_mac_key(const ::std::uint8_t* addr, const ::std::uint8_t* mask) {
+  auto result = format_mac(addr);
+  if (mask == nullptr) {
+    return result;
+  }
+
+  unsigned int bits = 0;
+  bool prefix       = true;
+  for (::std::size_t i = 0; i < ETH_ALEN; i++) {
+    for (int bit = 7; bit >= 0; bit--) {
+      if ((mask[i] & (1U << bit)) != 0) {
+        prefix = prefix && bits == i * 8 + (7 - bit);
+        bits++;
+      }
+    }
+  }
+
+  if (bits == ETH_ALEN * 8) {
+    return result;
+  }
+  return result + "/" + (prefix ? ::std::to_string(bits) : format_mac(mask));
+}
+
+::std::string action_control_name(int action) {
+  switch (action) {
+    case TC_ACT_UNSPEC:
+      return "continue";
+    case TC_ACT_OK:
+      return "pass";
+    case TC_ACT_RECLASSIFY:
+      return "reclassify";
+    case TC_ACT_SHOT:
+      return "drop";
+    case TC_ACT_PIPE:
+      return "pipe";
+    case TC_ACT_STOLEN:
+      return "stolen";
+    case TC_ACT_TRAP:
+      return "trap";
+    default:
+      return ::std::to_string(action);
+  }
+}
+
+::std::string handle_name(::std::uint32_t handle) {
+  ::std::array<char, 16> buffer{};
+  if (TC_H_MIN(handle) == 0) {
+    ::std::snprintf(buffer.data(), buffer.size(), "%x:", TC_H_MAJ(handle) >> 16);
+  } else {
+    ::std::snprintf(buffer.data(), buffer.size(), "%x:%x", TC_H_MAJ(handle) >> 16, TC_H_MIN(handle));
+  }
+  return buffer.data();
+}
+
+void add_police_action(tc_request& request, const ::std::string& value, rate_type rt) {
+  auto options = request.begin_nest(TCA_ACT_OPTIONS | NLA_F_NESTED);
+
+  tc_police police{};
+  police.action = TC_ACT_SHOT;
   if (rt == rate_type::PKTS_RATE) {
-    // for micrel packages per second use:
-    return " ingress flower skip_sw dst_mac " + dst_mac + " action police pkts_rate " + rate + " pkts_burst 1 drop";
-  } else if (rt == rate_type::RATE) {
-    // for marvell the rate is specified in MBits
-    return " ingress flower skip_sw dst_mac " + dst_mac + " action police rate " + rate + "mbit burst 1 drop";
+    // for micrel packages per second with a burst of 1 packet
+    ::std::uint64_t pkts_rate  = ::std::stoull(value);
+    ::std::uint64_t pkts_burst = calc_xmittime(pkts_rate, 1);
+    request.put(TCA_POLICE_TBF, &police, sizeof(police));
+    request.put_u64(TCA_POLICE_PKTRATE64, pkts_rate);
+    request.put_u64(TCA_POLICE_PKTBURST64, pkts_burst);
   } else {
+    // for marvell the rate is specified in MBits, the burst is 1 byte
+    ::std::uint64_t rate = ::std::stoull(value) * 1000000 / 8;
+    ::std::array<::std::uint32_t, TC_RTAB_SIZE / sizeof(::std::uint32_t)> rtab{};
+    police.rate.rate = static_cast<::std::uint32_t>(::std::min<::std::uint64_t>(rate, UINT32_MAX));
+    calc_rtable(police.rate, rtab);
+    police.burst = calc_xmittime(rate, 1);
+    request.put(TCA_POLICE_TBF, &police, sizeof(police));
+    request.put(TCA_POLICE_RATE, rtab.data(), TC_RTAB_SIZE);
+    if (rate >= (1ULL << 32)) {
+      request.put_u64(TCA_POLICE_RATE64, rate);
+    }
+  }
+
+  request.end_nest(options);
+}
+
+status build_ingress_rate_filter(tc_request& request, const ::std::string& value, const ::std::string& dst_mac,
+                                 rate_type rt) {
+  // TODO (Team) For Bytes per second use "rate" instead of "pkts_rate".
+  //       https://man7.org/linux/man-pages/man8/tc-police.8.html
+
+  if (rt != rate_type::PKTS_RATE && rt != rate_type::RATE) {
     assert("TC-Tool: Invalid rate type");
-    return "";
+    return status{status_code::SYSTEM_CALL_ERROR, "TC-Tool: Invalid rate type"};
   }
+
+  mac_key key;
+  auto key_status = parse_mac_key(dst_mac, key);
+  if (!key_status.ok()) {
+    return key_status;
+  }
+
+  try {
+    request.put_string(TCA_KIND, "flower");
+    auto options = request.begin_nest(TCA_OPTIONS);
+    request.put(TCA_FLOWER_KEY_ETH_DST, key.addr.data(), key.addr.size());
+    request.put(TCA_FLOWER_KEY_ETH_DST_MASK, key.mask.data(), key.mask.size());
+    request.put_u32(TCA_FLOWER_FLAGS, TCA_CLS_FLAGS_SKIP_SW);
+    auto actions = request.begin_nest(TCA_FLOWER_ACT);
+    auto police  = request.begin_nest(1);
+    request.put_string(TCA_ACT_KIND, "police");
+    add_police_action(request, value, rt);
+    request.end_nest(police);
+    request.end_nest(actions);
+    request.end_nest(options);
+  } catch (const ::std::exception&) {
+    return status{status_code::SYSTEM_CALL_ERROR, "TC-Tool: Invalid rate " + value};
+  }
+
+  return {};
+}
+
+void build_mirror_filter(tc_request& request, int dst_ifindex, switch_type switch_type) {
+  request.put_string(TCA_KIND, "matchall");
+  auto options = request.begin_nest(TCA_OPTIONS);
+  if (switch_type != switch_type::TI) {
+    request.put_u32(TCA_MATCHALL_FLAGS, TCA_CLS_FLAGS_SKIP_SW);
+  }
+  auto actions = request.begin_nest(TCA_MATCHALL_ACT);
+  auto mirred  = request.begin_nest(1);
+  request.put_string(TCA_ACT_KIND, "mirred");
+  auto mirred_options = request.begin_nest(TCA_ACT_OPTIONS | NLA_F_NESTED);
+  tc_mirred parms{};
+  parms.action  = TC_ACT_PIPE;
+  parms.eaction = TCA_EGRESS_MIRROR;
+  parms.ifindex = static_cast<::std::uint32_t>(dst_ifindex);
+  request.put(TCA_MIRRED_PARMS, &parms, sizeof(parms));
+  request.end_nest(mirred_options);
+  request.end_nest(mirred);
+  request.end_nest(actions);
+  request.end_nest(options);
 }
 
-::std::string build_tc_add_filter_cmd(const ::std::string& port_name, const ::std::string& filter_cmd) {
-  return "/usr/sbin/tc filter add dev " + port_name + " " + filter_cmd;
+json action_to_json(::std::size_t order, const rtattr_table& action) {
+  json j;
+  j["order"] = order;
+  auto kind  = action.get_string(TCA_ACT_KIND);
+  j["kind"]  = kind;
+
+  if (!action.has(TCA_ACT_OPTIONS)) {
+    return j;
+  }
+
+  if (kind == "police") {
+    auto options = rtattr_table::nested(action.get(TCA_ACT_OPTIONS), TCA_POLICE_MAX);
+    auto police  = options.get_struct<tc_police>(TCA_POLICE_TBF);
+    if (police != nullptr) {
+      j["index"]          = police->index;
+      j["control_action"] = {{"type", action_control_name(police->action)}};
+    }
+    if (options.has(TCA_POLICE_PKTRATE64)) {
+      j["pkts_rate"] = options.get_u64(TCA_POLICE_PKTRATE64);
+    }
+  } else if (kind == "mirred") {
+    auto options = rtattr_table::nested(action.get(TCA_ACT_OPTIONS), TCA_MIRRED_MAX);
+    auto mirred  = options.get_struct<tc_mirred>(TCA_MIRRED_PARMS);
+    if (mirred != nullptr) {
+      bool mirror         = mirred->eaction == TCA_EGRESS_MIRROR || mirred->eaction == TCA_INGRESS_MIRROR;
+      bool egress         = mirred->eaction == TCA_EGRESS_MIRROR || mirred->eaction == TCA_EGRESS_REDIR;
+      ::std::array<char, IF_NAMESIZE> ifname{};
+      j["mirred_action"]  = mirror ? "mirror" : "redirect";
+      j["direction"]      = egress ? "egress" : "ingress";
+      j["to_dev"]         = ::if_indextoname(mirred->ifindex, ifname.data()) != nullptr ? ifname.data() : "";
+      j["index"]          = mirred->index;
+      j["control_action"] = {{"type", action_control_name(mirred->action)}};
+    }
+  }
+  return j;
 }
 
-::std::string build_tc_del_filter_cmd(const ::std::string& port_name, const ::std::string& pref,
-                                      const ::std::string& filter) {
-  return "/usr/sbin/tc filter del dev " + port_name + " pref " + pref + " " + filter;
+json actions_to_json(const rtattr* actions_attr) {
+  json actions = json::array();
+  auto table   = rtattr_table::nested(actions_attr, TCA_ACT_MAX_PRIO);
+  for (::std::uint16_t order = 1; order <= TCA_ACT_MAX_PRIO; order++) {
+    if (table.has(order)) {
+      actions.push_back(action_to_json(order, rtattr_table::nested(table.get(order), TCA_ACT_MAX)));
+    }
+  }
+  return actions;
 }
 
-::std::string build_tc_del_filter_cmd(const ::std::string& port_name, const ::std::string& filter) {
-  return "/usr/sbin/tc filter del dev " + port_name + " " + filter;
+// Converts a filter message into the subset of the tc -json representation that is evaluated by this library.
+json filter_to_json(const nlmsghdr& nlh) {
+  auto tcm  = static_cast<const tcmsg*>(NLMSG_DATA(&nlh));
+  auto attrs = rtattr_table{TCA_RTA(tcm), nlh.nlmsg_len - NLMSG_LENGTH(sizeof(*tcm)), TCA_MAX};
+
+  json j;
+  auto protocol = ntohs(static_cast<::std::uint16_t>(TC_H_MIN(tcm->tcm_info)));
+  j["protocol"] = protocol == ETH_P_ALL ? json("all") : json(protocol);
+  j["pref"]     = TC_H_MAJ(tcm->tcm_info) >> 16;
+  auto kind     = attrs.get_string(TCA_KIND);
+  j["kind"]     = kind;
+  j["chain"]    = attrs.get_u32(TCA_CHAIN);
+
+  if (!attrs.has(TCA_OPTIONS) || tcm->tcm_handle == 0) {
+    return j;
+  }
+
+  json options;
+  options["handle"] = tcm->tcm_handle;
+  if (kind == "flower") {
+    auto flower = rtattr_table::nested(attrs.get(TCA_OPTIONS), TCA_FLOWER_MAX);
+    if (flower.has(TCA_FLOWER_KEY_ETH_DST)) {
+      auto addr = flower.get_struct<::std::array<::std::uint8_t, ETH_ALEN>>(TCA_FLOWER_KEY_ETH_DST);
+      auto mask = flower.get_struct<::std::array<::std::uint8_t, ETH_ALEN>>(TCA_FLOWER_KEY_ETH_DST_MASK);
+      if (addr != nullptr) {
+        options["keys"]["dst_mac"] = format_mac_key(addr->data(), mask != nullptr ? mask->data() : nullptr);
+      }
+    }
+    auto flags = flower.get_u32(TCA_FLOWER_FLAGS);
+    if ((flags & TCA_CLS_FLAGS_SKIP_SW) != 0) {
+      options["skip_sw"] = true;
+    }
+    if (flower.has(TCA_FLOWER_ACT)) {
+      options["actions"] = actions_to_json(flower.get(TCA_FLOWER_ACT));
+    }
+  } else if (kind == "matchall") {
+    auto matchall = rtattr_table::nested(attrs.get(TCA_OPTIONS), TCA_MATCHALL_MAX);
+    if ((matchall.get_u32(TCA_MATCHALL_FLAGS) & TCA_CLS_FLAGS_SKIP_SW) != 0) {
+      options["skip_sw"] = true;
+    }
+    if (matchall.has(TCA_MATCHALL_ACT)) {
+      options["actions"] = actions_to_json(matchall.get(TCA_MATCHALL_ACT));
+    }
+  }
+  j["options"] = options;
+  return j;
 }
 
-::std::string build_tc_change_filter_cmd(const ::std::string& port_name, const ::std::string& pref,
-                                         const ::std::string& handle, const std::string& filter_cmd) {
-  return "/usr/sbin/tc filter replace dev " + port_name + " pref " + pref + " handle " + handle + " " + filter_cmd;
+json qdisc_to_json(const nlmsghdr& nlh) {
+  auto tcm  = static_cast<const tcmsg*>(NLMSG_DATA(&nlh));
+  auto attrs = rtattr_table{TCA_RTA(tcm), nlh.nlmsg_len - NLMSG_LENGTH(sizeof(*tcm)), TCA_MAX};
+
+  json j;
+  j["kind"]   = attrs.get_string(TCA_KIND);
+  j["handle"] = handle_name(tcm->tcm_handle);
+  if (tcm->tcm_parent == TC_H_ROOT) {
+    j["root"] = true;
+  } else if (tcm->tcm_parent != 0) {
+    j["parent"] = handle_name(tcm->tcm_parent);
+  }
+  return j;
 }
 
-status get_status_from_tc_program(const program& programm) {
-  return programm.get_result() == 0 ? status{} : status{status_code::SYSTEM_CALL_ERROR, programm.get_stderr()};
+status tc_show_filter(const ::std::string& port_name, ::std::uint32_t parent, nlohmann::json& filter) {
+  int ifindex;
+  auto status = device_index(port_name, ifindex);
+  if (!status.ok()) {
+    return status;
+  }
+
+  filter = json::array();
+  rtnetlink nl;
+  return nl.dump(tc_request{RTM_GETTFILTER, dump_flags, make_tcmsg(ifindex, parent, 0, 0)},
+                 [&filter](const nlmsghdr& nlh) {
+                   if (nlh.nlmsg_type == RTM_NEWTFILTER) {
+                     filter.push_back(filter_to_json(nlh));
+                   }
+                 });
 }
 
-status tc_show_filter(const ::std::string& port_name, const ::std::string& filter, nlohmann::json& ingress_filter) {
-  auto cmd = "/usr/sbin/tc -json filter show dev " + port_name + " " + filter;
-  auto p   = program::execute(cmd);
-  if (p.get_result() == 0) {
-    ingress_filter = nlohmann::json::parse(p.get_stdout());
-    return {};
+status tc_delete_filter(const ::std::string& port_name, ::std::uint32_t parent, ::std::uint32_t pref) {
+  int ifindex;
+  auto status = device_index(port_name, ifindex);
+  if (!status.ok()) {
+    return status;
   }
 
-  return status{status_code::SYSTEM_CALL_ERROR, p.get_stderr()};
+  rtnetlink nl;
+  return nl.transact({tc_request{RTM_DELTFILTER, delete_flags, make_tcmsg(ifindex, parent, 0, TC_H_MAKE(pref << 16, 0))}});
+}
+
+status tc_qdisc_clsact(const ::std::string& port_name, ::std::uint16_t type, ::std::uint16_t flags) {
+  int ifindex;
+  auto status = device_index(port_name, ifindex);
+  if (!status.ok()) {
+    return status;
+  }
+
+  tc_request request{type, flags, make_tcmsg(ifindex, TC_H_CLSACT, clsact_handle, 0)};
+  request.put_string(TCA_KIND, "clsact");
+  rtnetlink nl;
+  return nl.transact({request});
 }
 
 }  // namespace
 
+
 ::std::optional<tc_filter_ref> get_mirror_filter_ref(const nlohmann::json& filters) {
   tc_filter_ref ref;
   for (auto const& filter : filters) {
@@ -169,28 +563,30 @@ status tc_show_filter(const ::std::string& port_name, const ::std::string& filte
 }
 
 status tc_show_qdisc(const ::std::string& port_name, nlohmann::json& qdiscs) {
-  auto cmd = "/usr/sbin/tc -json qdisc show dev " + port_name;
-  auto p   = program::execute(cmd);
-  if (p.get_result() == 0) {
-    qdiscs = nlohmann::json::parse(p.get_stdout());
-    return {};
+  int ifindex;
+  auto status = device_index(port_name, ifindex);
+  if (!status.ok()) {
+    return status;
   }
 
-  return status{status_code::SYSTEM_CALL_ERROR, p.get_stderr()};
+  qdiscs = json::array();
+  rtnetlink nl;
+  return nl.dump(tc_request{RTM_GETQDISC, dump_flags, make_tcmsg(ifindex, 0, 0, 0)},
+                 [&qdiscs, ifindex](const nlmsghdr& nlh) {
+                   auto tcm = static_cast<const tcmsg*>(NLMSG_DATA(&nlh));
+                   // The kernel dumps the qdiscs of all devices
+                   if (nlh.nlmsg_type == RTM_NEWQDISC && tcm->tcm_ifindex == ifindex) {
+                     qdiscs.push_back(qdisc_to_json(nlh));
+                   }
+                 });
 }
 
 status tc_add_qdisc_clsact(const ::std::string& port_name) {
-  auto cmd = "/usr/sbin/tc qdisc add dev " + port_name + " clsact";
-  auto p   = program::execute(cmd);
-
-  return get_status_from_tc_program(p);
+  return tc_qdisc_clsact(port_name, RTM_NEWQDISC, create_flags);
 }
 
 status tc_delete_qdisc_clsact(const ::std::string& port_name) {
-  auto cmd = "/usr/sbin/tc qdisc del dev " + port_name + " clsact";
-  auto p   = program::execute(cmd);
-
-  return get_status_from_tc_program(p);
+  return tc_qdisc_clsact(port_name, RTM_DELQDISC, delete_flags);
 }
 
 bool tc_has_qdisc_clsact(const nlohmann::json& qdiscs) {
@@ -203,70 +599,127 @@ bool tc_has_qdisc_clsact(const nlohmann::json& qdiscs) {
 }
 
 status tc_show_egress_filter(const ::std::string& port_name, nlohmann::json& ingress_filter) {
-  return tc_show_filter(port_name, "egress", ingress_filter);
+  return tc_show_filter(port_name, egress_parent, ingress_filter);
 }
 
 status tc_show_ingress_filter(const ::std::string& port_name, nlohmann::json& ingress_filter) {
-  return tc_show_filter(port_name, "ingress", ingress_filter);
+  return tc_show_filter(port_name, ingress_parent, ingress_filter);
 }
 
 status tc_change_ingress_rate_filter(const tc_filter_ref& filter_ref, const ::std::string& port_name,
                                      const ::std::string& value, const ::std::string& dst_mac, rate_type rt) {
-  auto pref   = ::std::to_string(filter_ref.pref);
-  auto handle = ::std::to_string(filter_ref.handle);
-  auto cmd    = build_tc_change_filter_cmd(port_name, pref, handle, build_tc_ingress_rate_cmd(dst_mac, value, rt));
-  auto p      = program::execute(cmd);
+  int ifindex;
+  auto status = device_index(port_name, ifindex);
+  if (!status.ok()) {
+    return status;
+  }
 
-  return get_status_from_tc_program(p);
+  auto info = TC_H_MAKE(static_cast<::std::uint32_t>(filter_ref.pref) << 16, htons(ETH_P_ALL));
+  tc_request request{RTM_NEWTFILTER, replace_flags,
+                     make_tcmsg(ifindex, ingress_parent, static_cast<::std::uint32_t>(filter_ref.handle), info)};
+  status = build_ingress_rate_filter(request, value, dst_mac, rt);
+  if (!status.ok()) {
+    return status;
+  }
+
+  rtnetlink nl;
+  return nl.transact({request});
 }
 
 status tc_add_ingress_rate_filter(const ::std::string& port_name, const ::std::string& value,
                                   const ::std::string& dst_mac, rate_type rt) {
-  auto cmd = build_tc_add_filter_cmd(port_name, build_tc_ingress_rate_cmd(dst_mac, value, rt));
-  auto p = program::execute(cmd);
+  int ifindex;
+  auto status = device_index(port_name, ifindex);
+  if (!status.ok()) {
+    return status;
+  }
+
+  tc_request request{RTM_NEWTFILTER, create_flags, make_tcmsg(ifindex, ingress_parent, 0, TC_H_MAKE(0, htons(ETH_P_ALL)))};
+  status = build_ingress_rate_filter(request, value, dst_mac, rt);
+  if (!status.ok()) {
+    return status;
+  }
 
-  return get_status_from_tc_program(p);
+  rtnetlink nl;
+  return nl.transact({request});
 }
 
 status tc_delete_ingress_filter(const ::std::string& port_name) {
-  auto cmd = build_tc_del_filter_cmd(port_name, "ingress");
-  auto p   = program::execute(cmd);
-
-  return get_status_from_tc_program(p);
+  return tc_delete_filter(port_name, ingress_parent, 0);
 }
 
 status tc_delete_egress_filter(const ::std::string& port_name) {
-  auto cmd = build_tc_del_filter_cmd(port_name, "egress");
-  auto p   = program::execute(cmd);
-
-  return get_status_from_tc_program(p);
+  return tc_delete_filter(port_name, egress_parent, 0);
 }
 
 status tc_delete_egress_filter(const tc_filter_ref& filter_ref, const ::std::string& port_name) {
-  auto cmd = build_tc_del_filter_cmd(port_name, ::std::to_string(filter_ref.pref), "egress");
-  auto p   = program::execute(cmd);
-
-  return get_status_from_tc_program(p);
+  return tc_delete_filter(port_name, egress_parent, static_cast<::std::uint32_t>(filter_ref.pref));
 }
 
 status tc_delete_ingress_filter(const tc_filter_ref& filter_ref, const ::std::string& port_name) {
-  auto cmd = build_tc_del_filter_cmd(port_name, ::std::to_string(filter_ref.pref), "ingress");
-  auto p   = program::execute(cmd);
-
-  return get_status_from_tc_program(p);
+  return tc_delete_filter(port_name, ingress_parent, static_cast<::std::uint32_t>(filter_ref.pref));
 }
 
 status tc_add_mirror(const ::std::string& src_port_name, const ::std::string& dst_port_name,
                      const ::std::string& direction, switch_type switch_type) {
-  auto skip_sw = "";
-  if (switch_type != switch_type::TI) {
-    skip_sw = "skip_sw ";
+  return tc_add_mirror(src_port_name, dst_port_name, ::std::vector<::std::string>{direction}, switch_type);
+}
+
+status tc_add_mirror(const ::std::string& src_port_name, const ::std::string& dst_port_name,
+                     const ::std::vector<::std::string>& directions, switch_type switch_type) {
+  int src_ifindex;
+  int dst_ifindex;
+  auto status = device_index(src_port_name, src_ifindex);
+  if (status.ok()) {
+    status = device_index(dst_port_name, dst_ifindex);
+  }
+  if (!status.ok()) {
+    return status;
   }
-  auto cmd =
-      build_tc_add_filter_cmd(src_port_name, direction + " matchall " + skip_sw + "action mirred egress mirror dev " + dst_port_name);
-  auto p = program::execute(cmd);
 
-  return get_status_from_tc_program(p);
+  // Validate all directions before anything is applied
+  ::std::vector<tc_request> requests;
+  ::std::vector<::std::uint32_t> parents;
+  ::std::map<::std::uint32_t, ::std::uint32_t> prefs;
+  for (auto const& direction : directions) {
+    ::std::uint32_t parent;
+    status = filter_parent(direction, parent);
+    if (!status.ok()) {
+      return status;
+    }
+    if (!prefs.emplace(parent, 0).second) {
+      return wago::libswitchconfig::status{status_code::SYSTEM_CALL_ERROR,
+                                           "TC-Tool: Duplicate filter direction " + direction};
+    }
+    // The kernel echoes the new filter, its preference is needed for a rollback
+    parents.push_back(parent);
+    requests.emplace_back(RTM_NEWTFILTER, static_cast<::std::uint16_t>(create_flags | NLM_F_ECHO),
+                          make_tcmsg(src_ifindex, parent, 0, TC_H_MAKE(0, htons(ETH_P_ALL))));
+    build_mirror_filter(requests.back(), dst_ifindex, switch_type);
+  }
+
+  rtnetlink nl;
+  ::std::vector<wago::libswitchconfig::status> results;
+  status = nl.transact(requests, results, [&prefs](const nlmsghdr& nlh) {
+    auto tcm = static_cast<const tcmsg*>(NLMSG_DATA(&nlh));
+    if (nlh.nlmsg_type == RTM_NEWTFILTER && prefs.count(tcm->tcm_parent) != 0) {
+      prefs[tcm->tcm_parent] = TC_H_MAJ(tcm->tcm_info) >> 16;
+    }
+  });
+  if (status.ok()) {
+    return status;
+  }
+
+  // Do not leave a partial mirror behind, remove the filters which were added
+  ::std::vector<tc_request> rollback;
+  for (::std::size_t i = 0; i < requests.size(); i++) {
+    auto pref = prefs[parents[i]];
+    if (results[i].ok() && pref != 0) {
+      rollback.emplace_back(RTM_DELTFILTER, delete_flags, make_tcmsg(src_ifindex, parents[i], 0, TC_H_MAKE(pref << 16, 0)));
+    }
+  }
+  (void)nl.transact(rollback);
+  return status;
 }
 
 }  // namespace wago::libswitchconfig
@@ -6,6 +6,7 @@
 #include <nlohmann/json_fwd.hpp>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "switch_config_api.hpp"
 
@@ -47,4 +48,10 @@ status tc_delete_ingress_filter(const tc_filter_ref& filter_ref, const ::std::st
 status tc_add_mirror(const ::std::string& src_port_name, const ::std::string& dst_port_name,
                      const ::std::string& direction, switch_type switch_type);
 
+/**
+ * Add the mirror filters for all directions ("ingress", "egress") with a single netlink transaction.
+ */
+status tc_add_mirror(const ::std::string& src_port_name, const ::std::string& dst_port_name,
+                     const ::std::vector<::std::string>& directions, switch_type switch_type);
+
 }  // namespace wago::libswitchconfig
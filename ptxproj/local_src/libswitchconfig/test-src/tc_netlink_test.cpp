@@ -0,0 +1,224 @@
+// Copyright (c) 2023 WAGO GmbH & Co. KG
+// SPDX-License-Identifier: MPL-2.0
+
+#include <fcntl.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <linux/pkt_sched.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "program.hpp"
+#include "rtnetlink.hpp"
+#include "tc.hpp"
+
+namespace wago::libswitchconfig {
+
+namespace {
+
+constexpr auto test_port  = "lo";
+constexpr auto tc_program = "/usr/sbin/tc";
+constexpr int apply_cycles = 100;
+
+bool tc_available() {
+  return ::access(tc_program, X_OK) == 0;
+}
+
+nlohmann::json tc_json(const ::std::string& args) {
+  auto p = program::execute(::std::string{tc_program} + " -json " + args);
+  return p.get_result() == 0 ? nlohmann::json::parse(p.get_stdout()) : nlohmann::json::array();
+}
+
+}  // namespace
+
+// Runs against the kernel inside a private network namespace, the loopback device serves as switch port.
+// The results of the netlink implementation are compared to the output of the tc program where it is installed.
+class tc_netlink_test : public ::testing::Test {
+ protected:
+  static int host_netns;
+
+  static void SetUpTestSuite() {
+    host_netns = ::open("/proc/self/ns/net", O_RDONLY | O_CLOEXEC);
+    if (host_netns >= 0 && ::unshare(CLONE_NEWNET) != 0) {
+      ::close(host_netns);
+      host_netns = -1;
+    }
+  }
+
+  static void TearDownTestSuite() {
+    if (host_netns >= 0) {
+      (void)::setns(host_netns, CLONE_NEWNET);
+      ::close(host_netns);
+      host_netns = -1;
+    }
+  }
+
+  void SetUp() override {
+    if (host_netns < 0) {
+      GTEST_SKIP() << "network namespaces are not available";
+    }
+  }
+
+  void TearDown() override {
+    (void)tc_delete_qdisc_clsact(test_port);
+  }
+};
+
+int tc_netlink_test::host_netns = -1;
+
+TEST_F(tc_netlink_test, add_show_delete_qdisc_clsact) {
+  nlohmann::json qdiscs;
+  ASSERT_TRUE(tc_show_qdisc(test_port, qdiscs).ok());
+  EXPECT_FALSE(tc_has_qdisc_clsact(qdiscs));
+
+  ASSERT_TRUE(tc_add_qdisc_clsact(test_port).ok());
+  ASSERT_TRUE(tc_show_qdisc(test_port, qdiscs).ok());
+  EXPECT_TRUE(tc_has_qdisc_clsact(qdiscs));
+  if (tc_available()) {
+    EXPECT_TRUE(tc_has_qdisc_clsact(tc_json("qdisc show dev lo")));
+  }
+
+  auto status = tc_add_qdisc_clsact(test_port);
+  EXPECT_FALSE(status.ok());
+  EXPECT_EQ(status_code::SYSTEM_CALL_ERROR, status.get_code());
+
+  ASSERT_TRUE(tc_delete_qdisc_clsact(test_port).ok());
+  ASSERT_TRUE(tc_show_qdisc(test_port, qdiscs).ok());
+  EXPECT_FALSE(tc_has_qdisc_clsact(qdiscs));
+  if (tc_available()) {
+    EXPECT_FALSE(tc_has_qdisc_clsact(tc_json("qdisc show dev lo")));
+  }
+}
+
+TEST_F(tc_netlink_test, unknown_port) {
+  nlohmann::json qdiscs;
+  EXPECT_FALSE(tc_show_qdisc("ethX99", qdiscs).ok());
+  EXPECT_FALSE(tc_add_qdisc_clsact("ethX99").ok());
+  EXPECT_FALSE(tc_add_ingress_rate_filter("ethX99", "10", "ff:ff:ff:ff:ff:ff", rate_type::PKTS_RATE).ok());
+}
+
+TEST_F(tc_netlink_test, add_show_delete_mirror_filter) {
+  ASSERT_TRUE(tc_add_qdisc_clsact(test_port).ok());
+
+  auto status = tc_add_mirror(test_port, test_port, ::std::vector<::std::string>{"egress", "ingress"},
+                              switch_type::TI);
+  if (!status.ok()) {
+    GTEST_SKIP() << "matchall/mirred not supported by the kernel: " << status.to_string();
+  }
+
+  nlohmann::json filter;
+  for (auto const& direction : {"ingress", "egress"}) {
+    ASSERT_TRUE((direction == ::std::string{"ingress"} ? tc_show_ingress_filter(test_port, filter)
+                                                       : tc_show_egress_filter(test_port, filter))
+                    .ok());
+    auto ref = get_mirror_filter_ref(filter);
+    ASSERT_TRUE(ref.has_value());
+
+    if (tc_available()) {
+      auto tc_ref = get_mirror_filter_ref(tc_json(::std::string{"filter show dev lo "} + direction));
+      ASSERT_TRUE(tc_ref.has_value());
+      EXPECT_EQ(tc_ref->pref, ref->pref);
+      EXPECT_EQ(tc_ref->handle, ref->handle);
+    }
+
+    status = direction == ::std::string{"ingress"} ? tc_delete_ingress_filter(ref.value(), test_port)
+                                                   : tc_delete_egress_filter(ref.value(), test_port);
+    ASSERT_TRUE(status.ok()) << status.to_string();
+  }
+
+  ASSERT_TRUE(tc_show_ingress_filter(test_port, filter).ok());
+  EXPECT_FALSE(get_mirror_filter_ref(filter).has_value());
+  ASSERT_TRUE(tc_show_egress_filter(test_port, filter).ok());
+  EXPECT_FALSE(get_mirror_filter_ref(filter).has_value());
+}
+
+TEST_F(tc_netlink_test, transact_reports_status_of_each_request) {
+  tcmsg tcm{};
+  tcm.tcm_family  = AF_UNSPEC;
+  tcm.tcm_ifindex = 1;  // lo
+  tcm.tcm_parent  = TC_H_CLSACT;
+  tcm.tcm_handle  = TC_H_MAKE(TC_H_CLSACT, 0);
+  tc_request add_clsact{RTM_NEWQDISC, NLM_F_REQUEST | NLM_F_ACK | NLM_F_EXCL | NLM_F_CREATE, tcm};
+  add_clsact.put_string(TCA_KIND, "clsact");
+
+  rtnetlink nl;
+  ::std::vector<status> results;
+  // The second request fails because the qdisc exists already
+  auto result = nl.transact({add_clsact, add_clsact}, results, nullptr);
+
+  EXPECT_FALSE(result.ok());
+  ASSERT_EQ(2, results.size());
+  EXPECT_TRUE(results[0].ok());
+  EXPECT_FALSE(results[1].ok());
+  EXPECT_EQ(result, results[1]);
+}
+
+TEST_F(tc_netlink_test, failing_mirror_leaves_no_filter) {
+  ASSERT_TRUE(tc_add_qdisc_clsact(test_port).ok());
+
+  // The loopback device can not offload skip_sw filters
+  EXPECT_FALSE(
+      tc_add_mirror(test_port, test_port, ::std::vector<::std::string>{"ingress", "egress"}, switch_type::MARVELL).ok());
+  EXPECT_FALSE(tc_add_mirror(test_port, test_port, ::std::vector<::std::string>{"ingress", "ingress"}, switch_type::TI)
+                   .ok());
+
+  nlohmann::json filter;
+  ASSERT_TRUE(tc_show_ingress_filter(test_port, filter).ok());
+  EXPECT_FALSE(get_mirror_filter_ref(filter).has_value());
+  ASSERT_TRUE(tc_show_egress_filter(test_port, filter).ok());
+  EXPECT_FALSE(get_mirror_filter_ref(filter).has_value());
+}
+
+TEST_F(tc_netlink_test, ratelimit_filter_without_offload_fails) {
+  ASSERT_TRUE(tc_add_qdisc_clsact(test_port).ok());
+
+  // The loopback device can not offload skip_sw filters, the kernel error has to be reported
+  auto status = tc_add_ingress_rate_filter(test_port, "4000", "ff:ff:ff:ff:ff:ff", rate_type::PKTS_RATE);
+  EXPECT_FALSE(status.ok());
+  EXPECT_FALSE(
+      tc_add_ingress_rate_filter(test_port, "100", "01:00:00:00:00:00/01:00:00:00:00:00", rate_type::RATE).ok());
+  EXPECT_FALSE(tc_add_ingress_rate_filter(test_port, "100", "no mac", rate_type::RATE).ok());
+
+  nlohmann::json filter;
+  ASSERT_TRUE(tc_show_ingress_filter(test_port, filter).ok());
+  EXPECT_FALSE(get_ingress_ratelimit_filter_ref(filter, "ff:ff:ff:ff:ff:ff").has_value());
+}
+
+TEST_F(tc_netlink_test, report_apply_time) {
+  auto measure = [](auto&& apply) {
+    auto start = ::std::chrono::steady_clock::now();
+    for (int i = 0; i < apply_cycles; i++) {
+      apply();
+    }
+    return ::std::chrono::duration_cast<::std::chrono::microseconds>(::std::chrono::steady_clock::now() - start).count() /
+           apply_cycles;
+  };
+
+  auto netlink_us = measure([] {
+    nlohmann::json qdiscs;
+    EXPECT_TRUE(tc_show_qdisc(test_port, qdiscs).ok());
+    EXPECT_TRUE(tc_add_qdisc_clsact(test_port).ok());
+    EXPECT_TRUE(tc_delete_qdisc_clsact(test_port).ok());
+  });
+  RecordProperty("netlink_apply_us", static_cast<int>(netlink_us));
+  ::std::cout << "netlink: " << netlink_us << " us per qdisc show/add/delete" << ::std::endl;
+
+  if (tc_available()) {
+    auto tc_us = measure([] {
+      tc_json("qdisc show dev lo");
+      EXPECT_EQ(0, program::execute("/usr/sbin/tc qdisc add dev lo clsact").get_result());
+      EXPECT_EQ(0, program::execute("/usr/sbin/tc qdisc del dev lo clsact").get_result());
+    });
+    RecordProperty("tc_apply_us", static_cast<int>(tc_us));
+    ::std::cout << "tc:      " << tc_us << " us per qdisc show/add/delete" << ::std::endl;
+  }
+}
+
+}  // namespace wago::libswitchconfig
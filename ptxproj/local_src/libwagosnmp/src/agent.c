@@ -20,6 +20,7 @@
 #include <errno.h>
 #include <stdio.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 // clang-format off
 // dont reorder the net-snmp includes, otherwise it will not compile
 #include <net-snmp/net-snmp-config.h>
@@ -27,11 +28,17 @@
 #include <net-snmp/agent/net-snmp-agent-includes.h>
 // clang-format on
 #include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 
 #include "wagosnmp_API.h"
 #include "wagosnmp_internal.h"
 
+/* an existing table whose creator did not finish the header within the waits is replaced */
+#define OID_SHM_INIT_WAITS 100
+#define OID_SHM_INIT_WAIT_US 1000
+#define OID_SHM_RECREATIONS 3
+
 typedef struct stHandlerList tHandlerList;
 
 struct stHandlerList {
@@ -39,17 +46,32 @@ struct stHandlerList {
   tHandlerList *pNext;
 };
 
+/* A mapping of the OID table. A replaced mapping stays valid until the table is closed,
+ * readers which do not lock may still use it. */
+typedef struct stShmMap tShmMap;
+
+struct stShmMap {
+  tOidShm *shm;
+  size_t size;
+  tShmMap *retired;
+};
+
 static tHandlerList *pHandlerListRoot = NULL;
 static pthread_t stThreadID           = 0;
 static mqd_t trap_queue               = -1;
 static sem_t *oidMutex                = NULL;
 static int oidShmFd                   = -1;
-static tOidShm *pOidShm               = NULL;
-static size_t localShmSize            = sizeof(tOidShm);
+static tShmMap *shmMap                = NULL;
+static pthread_mutex_t shmMapMutex    = PTHREAD_MUTEX_INITIALIZER;
+static tOidShm *writeShm              = NULL;
+static const char *oidShmName         = WAGO_SNMP_OID_SHM;
+static const char *oidMutexName       = WAGO_SNMP_OID_MUTEX;
 
 PUBLIC_SYM void deinit_libwagosnmp_AgentEntry(void);
 
 static void _Reset(void);
+static void _WriteBegin(void);
+static void _WriteEnd(void);
 
 /* deinit function for snmpd-plugin. For init function see libwagosnmp.c */
 void deinit_libwagosnmp_AgentEntry(void) {
@@ -132,6 +154,18 @@ static int _OidHandler(netsnmp_mib_handler *handler, netsnmp_handler_registratio
   int ret            = SNMP_ERR_NOERROR;
   tOidObject *object = NULL;
 
+  if (reqinfo->mode == MODE_GET || reqinfo->mode == MODE_GETNEXT) {
+    // reading does not wait for writers of the PLC runtime
+    tOidValue value;
+    if (AGENT_ReadOidValue(requests->requestvb->name, requests->requestvb->name_length, &value) == 0) {
+      snmp_set_var_typed_value(requests->requestvb, (u_char)value.type, value.data, value.len);
+    } else {
+      netsnmp_set_request_error(reqinfo, requests, SNMP_ERR_RESOURCEUNAVAILABLE);
+    }
+    AGENT_FreeOidValue(&value);
+    return ret;
+  }
+
   /*build_oid_string(szOID, requests->requestvb->name, requests->requestvb->name_length);
   pagent_oid = find_agent_oid(szOID);
   */
@@ -139,11 +173,6 @@ static int _OidHandler(netsnmp_mib_handler *handler, netsnmp_handler_registratio
   object = AGENT_GetOidObject(requests->requestvb->name, requests->requestvb->name_length);
   if (object != NULL) {
     switch (reqinfo->mode) {
-      case MODE_GET:
-      case MODE_GETNEXT:
-        snmp_set_var_typed_value(requests->requestvb, object->type, object->buf, object->len);
-
-        break;
       case MODE_SET_RESERVE1:
         // check type
         if (object->type != requests->requestvb->type) {
@@ -172,6 +201,8 @@ static int _OidHandler(netsnmp_mib_handler *handler, netsnmp_handler_registratio
       case MODE_SET_FREE:
         // free set value -> no action
         break;
+      default:
+        break;
     }
   } else {
     // error
@@ -209,7 +240,6 @@ static void _RegisterOIDHandler(oid *anOID, size_t anOID_length) {
 
 static void _RegisterOID(tWagoSnmpMsg *msg) {
   AGENT_CreateShm();
-  AGENT_RemapShm();
   AGENT_MutexLock();
   if (oidShmFd >= 0) {
     tOidObject *pAct = AGENT_GetOidObject(msg->variable.sOID, msg->variable.sOID_length);
@@ -243,7 +273,8 @@ static void *_ServerMain(void) {
     // wait for message (forever) used because we opened fd in O_NONBLOCK mode
     if (0 < poll(&fdrec, 1, -1)) {
       tWagoSnmpMsg stMessage;
-      if (0 < mq_receive(trap_queue, (char *)&stMessage, sizeof(tWagoSnmpMsg), NULL)) {
+      // handle all queued messages, senders of a burst of traps do not wait for each wakeup
+      while (0 < mq_receive(trap_queue, (char *)&stMessage, sizeof(tWagoSnmpMsg), NULL)) {
         switch (stMessage.type) {
           case MSG_TYPE_TRAP_EASY:
             send_easy_trap(6, stMessage.specific_type);
@@ -280,6 +311,10 @@ static mqd_t _OpenServerQueue(const char *name, long int msgsz, long int maxmsg)
     mq_unlink(name);
     ret = mq_open(name, OPEN_SERVER_MODE, CREAT_MODE, &mqAttr);
   }
+  if (ret < 0 && errno == EINVAL && maxmsg > 1) {
+    // queue depth above the limit of /proc/sys/fs/mqueue/msg_max
+    ret = _OpenServerQueue(name, msgsz, 1);
+  }
 
   return ret;
 }
@@ -305,7 +340,7 @@ INTERNAL_SYM void AGENT_InitServerCommunication(unsigned int clientreg, void *cl
   if (stThreadID == 0) {
     _InitExistingShm();
 
-    trap_queue = _OpenServerQueue(TRAP_AGENT_MQ, sizeof(tWagoSnmpMsg), 1);
+    trap_queue = _OpenServerQueue(TRAP_AGENT_MQ, sizeof(tWagoSnmpMsg), WAGO_SNMP_AGENT_MQ_DEPTH);
 
     if ((pthread_create(&stThreadID, NULL, _ServerMain, NULL)) == -1)
       DEBUGMSGTL(("plcsnmp_trap_agent", "error while starting thread\n"));
@@ -318,13 +353,19 @@ INTERNAL_SYM void AGENT_InitServerCommunication(unsigned int clientreg, void *cl
   }
 }
 
+/* names of the OID table and its semaphore, NULL selects the default; call while neither is open */
+INTERNAL_SYM void AGENT_SetOidTableNames(const char *shmName, const char *mutexName) {
+  oidShmName   = (shmName != NULL) ? shmName : WAGO_SNMP_OID_SHM;
+  oidMutexName = (mutexName != NULL) ? mutexName : WAGO_SNMP_OID_MUTEX;
+}
+
 INTERNAL_SYM int AGENT_CreateMutex(void) {
   int ret = 0;
   if (oidMutex == NULL) {
-    oidMutex = sem_open(WAGO_SNMP_OID_MUTEX, O_RDWR | O_CREAT | O_EXCL, 0666, 1);
+    oidMutex = sem_open(oidMutexName, O_RDWR | O_CREAT | O_EXCL, 0666, 1);
     if (oidMutex == SEM_FAILED) {
       if (errno == EEXIST) {
-        oidMutex = sem_open(WAGO_SNMP_OID_MUTEX, O_RDWR);
+        oidMutex = sem_open(oidMutexName, O_RDWR);
       }
       if (oidMutex == SEM_FAILED) {
         ret      = -1;
@@ -338,10 +379,12 @@ INTERNAL_SYM int AGENT_CreateMutex(void) {
 INTERNAL_SYM void AGENT_MutexLock(void) {
   if (AGENT_CreateMutex() >= 0) {
     sem_wait(oidMutex);
+    _WriteBegin();
   }
 }
 INTERNAL_SYM void AGENT_MutexUnlock(void) {
   if (AGENT_CreateMutex() >= 0) {
+    _WriteEnd();
     sem_post(oidMutex);
   }
 }
@@ -356,127 +399,280 @@ INTERNAL_SYM void AGENT_CloseMutex(void) {
 INTERNAL_SYM void AGENT_DestroyMutex(void) {
   if (AGENT_CreateMutex() >= 0) {
     AGENT_CloseMutex();
-    sem_unlink(WAGO_SNMP_OID_MUTEX);
+    sem_unlink(oidMutexName);
+  }
+}
+
+static tShmMap *_GetMap(void) {
+  return __atomic_load_n(&shmMap, __ATOMIC_ACQUIRE);
+}
+
+/* maps size bytes of the table; call with shmMapMutex */
+static int _MapShm(size_t size) {
+  tShmMap *map = malloc(sizeof(tShmMap));
+  if (map == NULL) {
+    return -1;
+  }
+  map->shm = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, oidShmFd, 0);
+  if (map->shm == MAP_FAILED) {
+    perror("AGENT_MapShm: mmap");
+    free(map);
+    return -1;
+  }
+  map->size    = size;
+  map->retired = shmMap;
+  __atomic_store_n(&shmMap, map, __ATOMIC_RELEASE);
+  return 0;
+}
+
+/* the lock holder has the whole table mapped and makes seq odd until it unlocks */
+static void _WriteBegin(void) {
+  tShmMap *map;
+
+  pthread_mutex_lock(&shmMapMutex);
+  map = shmMap;
+  if (map != NULL && map->shm->oidShmSize != map->size) {
+    (void)_MapShm(map->shm->oidShmSize);
+    map = shmMap;
+  }
+  pthread_mutex_unlock(&shmMapMutex);
+
+  if (map != NULL) {
+    writeShm = map->shm;
+    __atomic_store_n(&writeShm->seq, writeShm->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+  }
+}
+
+static void _WriteEnd(void) {
+  if (writeShm != NULL) {
+    __atomic_store_n(&writeShm->seq, writeShm->seq + 1, __ATOMIC_RELEASE);
+    writeShm = NULL;
+  }
+}
+
+static uint32_t _OidHash(const oid *anOID, size_t anOID_len) {
+  uint32_t hash = 2166136261u;
+  size_t i;
+
+  for (i = 0; i < anOID_len; i++) {
+    hash ^= (uint32_t)anOID[i];
+    hash *= 16777619u;
+  }
+  return hash % OID_HASH_BUCKETS;
+}
+
+/* Looks up an OID in the hash chain. Without the lock the table may change meanwhile, so every
+ * offset is checked against the mapping; *stale is set if an object lies beyond it. */
+static tOidObject *_FindOidObject(tShmMap *map, const oid *anOID, size_t anOID_len, int *stale) {
+  tOidShm *shm    = map->shm;
+  uint32_t offset = shm->buckets[_OidHash(anOID, anOID_len)];
+  size_t steps    = shm->oidCount;
+
+  *stale = 0;
+  while (offset != 0 && steps-- > 0) {
+    tOidObject *pAct;
+    if (offset < sizeof(tOidShm) || offset + offsetof(tOidObject, buf) > map->size) {
+      *stale = 1;
+      return NULL;
+    }
+    pAct = (tOidObject *)((uintptr_t)shm + offset);
+    if (pAct->anOID_length <= MAX_OID_LEN &&
+        0 == snmp_oid_compare(anOID, anOID_len, pAct->anOID, pAct->anOID_length)) {
+      return pAct;
+    }
+    offset = pAct->hashNext;
   }
+  return NULL;
+}
+
+static void _LinkOidObject(tOidShm *shm, tOidObject *object) {
+  uint32_t bucket = _OidHash(object->anOID, object->anOID_length);
+
+  object->hashNext     = shm->buckets[bucket];
+  shm->buckets[bucket] = (uint32_t)((uintptr_t)object - (uintptr_t)shm);
 }
 
 INTERNAL_SYM void AGENT_RemapShm(void) {
-  size_t newSize;
-  if (!pOidShm) {
+  pthread_mutex_lock(&shmMapMutex);
+  if (shmMap == NULL) {
     snmp_log(LOG_ERR, "AGENT_RemapShm: shared memory not mapped\n");
-    return;
+  } else if (shmMap->shm->oidShmSize != shmMap->size) {
+    (void)_MapShm(shmMap->shm->oidShmSize);
   }
+  pthread_mutex_unlock(&shmMapMutex);
+}
 
-  newSize = pOidShm->oidShmSize;
-  munmap(pOidShm, localShmSize);
-  pOidShm      = mmap(0, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, oidShmFd, 0);
-  if (pOidShm == MAP_FAILED) {
-    pOidShm = NULL;
-    localShmSize = 0;
-    perror("AGENT_RemapShm: mmap");
-    return;
+enum { SHM_READY, SHM_INITIALIZING, SHM_INCOMPATIBLE };
+
+/* checks the header of an existing table before it is mapped */
+static int _CheckShm(int fd) {
+  const size_t len = offsetof(tOidShm, buckets);
+  struct stat info;
+  tOidShm header;
+
+  if (fstat(fd, &info) != 0) {
+    return SHM_INCOMPATIBLE;
+  }
+  // the creator sets the magic after the rest of the header
+  if ((size_t)info.st_size < sizeof(tOidShm) || pread(fd, &header, len, 0) != (ssize_t)len || header.magic == 0) {
+    return SHM_INITIALIZING;
   }
-  localShmSize = newSize;
+  if (header.magic != OID_SHM_MAGIC || header.version != OID_SHM_VERSION || header.headerSize != sizeof(tOidShm) ||
+      header.oidShmSize < sizeof(tOidShm) || header.oidShmSize > (size_t)info.st_size) {
+    return SHM_INCOMPATIBLE;
+  }
+  return SHM_READY;
 }
 
-INTERNAL_SYM void AGENT_CreateShm(void) {
-
-  if (oidShmFd < 0) {
-    pOidShm = NULL;
-    localShmSize = 0;
+/* removes the name of a stale table unless another process replaced the table meanwhile;
+ * processes still using the stale table keep their mapping */
+static void _UnlinkStaleShm(int fd) {
+  struct stat stale;
+  struct stat named;
+  int namedFd = shm_open(oidShmName, O_RDONLY, 0);
 
-    oidShmFd = shm_open(WAGO_SNMP_OID_SHM, O_RDWR | O_CREAT | O_EXCL, 0666);
-    if (oidShmFd < 0) {
-      if (errno == EEXIST) {
-        oidShmFd = shm_open(WAGO_SNMP_OID_SHM, O_RDWR, 0666);
-        if (oidShmFd < 0) {
-          perror("AGENT_CreateShm: shm_open");
-          return;
-        }
+  if (namedFd >= 0) {
+    if (fstat(fd, &stale) == 0 && fstat(namedFd, &named) == 0 && stale.st_dev == named.st_dev &&
+        stale.st_ino == named.st_ino) {
+      shm_unlink(oidShmName);
+    }
+    close(namedFd);
+  }
+}
 
-        void* pShm = mmap(0, sizeof(tOidShm), PROT_READ | PROT_WRITE, MAP_SHARED, oidShmFd, 0);
-        if (pShm == MAP_FAILED) {
-          perror("AGENT_CreateShm: mmap");
-          return;
-        }
+/* call with shmMapMutex */
+static void _InitShm(void) {
+  if (ftruncate(oidShmFd, sizeof(tOidShm)) < 0) {
+    perror("AGENT_CreateShm: ftruncate");
+  } else if (_MapShm(sizeof(tOidShm)) == 0) {
+    // ftruncate zeroed the hash buckets
+    tOidShm *shm    = shmMap->shm;
+    shm->version    = OID_SHM_VERSION;
+    shm->headerSize = sizeof(tOidShm);
+    shm->oidShmSize = sizeof(tOidShm);
+    shm->oidUsed    = sizeof(tOidShm);
+    shm->oidCount   = 0;
+    __atomic_store_n(&shm->magic, OID_SHM_MAGIC, __ATOMIC_RELEASE);
+  }
+}
 
-        pOidShm      = pShm;
-        AGENT_RemapShm();
-      }
-    } else {
-      if (ftruncate(oidShmFd, sizeof(tOidShm)) < 0) {
-        perror("AGENT_CreateShm: ftruncate");
-        return;
+INTERNAL_SYM void AGENT_CreateShm(void) {
+  int waits       = OID_SHM_INIT_WAITS;
+  int recreations = OID_SHM_RECREATIONS;
+
+  pthread_mutex_lock(&shmMapMutex);
+  while (oidShmFd < 0) {
+    int fd = shm_open(oidShmName, O_RDWR | O_CREAT | O_EXCL, 0666);
+    if (fd >= 0) {
+      oidShmFd = fd;
+      _InitShm();
+      break;
+    }
+    if (errno == EEXIST) {
+      fd = shm_open(oidShmName, O_RDWR, 0666);
+    }
+    if (fd < 0) {
+      // removed right after the creation failed, try again
+      if (errno == ENOENT && recreations-- > 0) {
+        continue;
       }
-      void* pShm = mmap(0, sizeof(tOidShm), PROT_READ | PROT_WRITE, MAP_SHARED, oidShmFd, 0);
-      if (pShm == MAP_FAILED) {
-        perror("AGENT_CreateShm: mmap");
-        return;
+      perror("AGENT_CreateShm: shm_open");
+      break;
+    }
+
+    int state = _CheckShm(fd);
+    if (state == SHM_INITIALIZING && waits-- > 0) {
+      close(fd);
+      usleep(OID_SHM_INIT_WAIT_US);
+      continue;
+    }
+    if (state != SHM_READY) {
+      // left by another library version or by a creator that died during the initialization
+      if (recreations-- > 0) {
+        snmp_log(LOG_WARNING, "AGENT_CreateShm: replacing OID table %s of another layout\n", oidShmName);
+        _UnlinkStaleShm(fd);
+        close(fd);
+        continue;
       }
+      snmp_log(LOG_ERR, "AGENT_CreateShm: OID table %s has another layout\n", oidShmName);
+      close(fd);
+      break;
+    }
 
-      pOidShm             = pShm;
-      pOidShm->oidShmSize = sizeof(tOidShm);
-      localShmSize        = pOidShm->oidShmSize;
-      pOidShm->oidCount   = 0;
+    oidShmFd = fd;
+    if (_MapShm(sizeof(tOidShm)) == 0 && shmMap->shm->oidShmSize != shmMap->size) {
+      (void)_MapShm(shmMap->shm->oidShmSize);
     }
   }
+  pthread_mutex_unlock(&shmMapMutex);
 }
 
 INTERNAL_SYM void AGENT_CloseShm(void) {
+  pthread_mutex_lock(&shmMapMutex);
   if (oidShmFd >= 0) {
-    munmap(pOidShm, pOidShm->oidShmSize);
-    pOidShm = NULL;
+    tShmMap *map = shmMap;
+    __atomic_store_n(&shmMap, NULL, __ATOMIC_RELEASE);
+    while (map != NULL) {
+      tShmMap *retired = map->retired;
+      munmap(map->shm, map->size);
+      free(map);
+      map = retired;
+    }
     close(oidShmFd);
-    oidShmFd     = -1;
-    localShmSize = sizeof(tOidShm);
+    oidShmFd = -1;
   }
+  pthread_mutex_unlock(&shmMapMutex);
 }
 
 INTERNAL_SYM void AGENT_DestroyShm(void) {
   AGENT_CloseShm();
-  shm_unlink(WAGO_SNMP_OID_SHM);
+  shm_unlink(oidShmName);
 }
 
-/* adding size bytes to SHM*/
+/* make room for size more bytes; the table at least doubles, so only a few mappings are replaced */
 INTERNAL_SYM int AGENT_ExtendShm(size_t size) {
   int ret = -1;
-  if (oidShmFd >= 0 && pOidShm) {
-    size_t newSize = size + pOidShm->oidShmSize;
-    if (ftruncate(oidShmFd, (ssize_t)newSize) < 0) {
-      perror("AGENT_ExtendShm: ftruncate");
-      return WAGOSNMP_RETURN_ERROR_SHM;
-    }
 
-    if (munmap(pOidShm, pOidShm->oidShmSize) < 0) {
-      perror("AGENT_ExtendShm: munmap");
-      return WAGOSNMP_RETURN_ERROR_SHM;
-    }
-    pOidShm = NULL;
+  pthread_mutex_lock(&shmMapMutex);
+  if (oidShmFd >= 0 && shmMap) {
+    tOidShm *shm  = shmMap->shm;
+    size_t needed = shm->oidUsed + size;
 
-    void *pNewShm = mmap(0, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, oidShmFd, 0);
-    if (pNewShm == MAP_FAILED) {
-      perror("AGENT_ExtendShm: mmap");
-      return WAGOSNMP_RETURN_ERROR_SHM;
+    ret = 0;
+    if (needed > shm->oidShmSize) {
+      size_t newSize = shm->oidShmSize * 2;
+      if (newSize < needed) {
+        newSize = needed;
+      }
+      if (ftruncate(oidShmFd, (off_t)newSize) < 0) {
+        perror("AGENT_ExtendShm: ftruncate");
+        ret = WAGOSNMP_RETURN_ERROR_SHM;
+      } else {
+        shm->oidShmSize = newSize;
+      }
+    }
+    if (ret == 0 && shm->oidShmSize != shmMap->size && _MapShm(shm->oidShmSize) != 0) {
+      ret = WAGOSNMP_RETURN_ERROR_SHM;
     }
-
-    pOidShm             = pNewShm;
-    pOidShm->oidShmSize = newSize;
-    ret                 = 0;
   }
+  pthread_mutex_unlock(&shmMapMutex);
 
   return ret;
 }
 
 INTERNAL_SYM tOidObject *AGENT_GetNextOidObject(tOidObject *pAct) {
+  tShmMap *map = _GetMap();
+
   if (pAct == NULL) {
-    if (pOidShm && pOidShm->oidCount > 0) {
-      return &pOidShm->oidStart[0];
+    if (map && map->shm->oidCount > 0) {
+      return &map->shm->oidStart[0];
     } else {
       return NULL;
     }
   }
   // if this is the last index
-  if (pOidShm == NULL || pOidShm->oidCount <= (pAct->index + 1)) {
+  if (map == NULL || map->shm->oidCount <= (pAct->index + 1)) {
     return NULL;
   }
 
@@ -489,42 +685,87 @@ INTERNAL_SYM tOidObject *AGENT_GetOidObject(oid *anOID, size_t anOID_len) {
   tOidObject *ret = NULL;
   AGENT_CreateShm();
   if (oidShmFd >= 0) {
-    tOidObject *pAct = AGENT_GetNextOidObject(NULL);
-    while (pAct != NULL) {
-      if (0 == snmp_oid_compare(anOID, anOID_len, pAct->anOID, pAct->anOID_length)) {
-        ret = pAct;
-        break;
-      }
-      pAct = AGENT_GetNextOidObject(pAct);
+    tShmMap *map = _GetMap();
+    int stale;
+    if (map != NULL) {
+      ret = _FindOidObject(map, anOID, anOID_len, &stale);
     }
   }
   return ret;
 }
 
-INTERNAL_SYM tOidObject *AGENT_GetFreeOidObject(size_t size) {
-  tOidObject *pAct;
-  tOidObject *pLast = NULL;
-
-  if (!pOidShm) {
-    return NULL;
+INTERNAL_SYM int AGENT_ReadOidValue(oid *anOID, size_t anOID_len, tOidValue *value) {
+  value->data = value->buf;
+  if (oidShmFd < 0) {
+    AGENT_CreateShm();
   }
 
-  if (AGENT_ExtendShm(size) != 0) {
-    return NULL;
+  while (1) {
+    tShmMap *map = _GetMap();
+    tOidObject *object;
+    uint32_t seq;
+    int stale;
+
+    if (map == NULL) {
+      return -1;
+    }
+    seq = __atomic_load_n(&map->shm->seq, __ATOMIC_ACQUIRE);
+    if ((seq & 1) == 0) {
+      object = _FindOidObject(map, anOID, anOID_len, &stale);
+      if (object != NULL) {
+        size_t bufferLen = object->objLen - sizeof(tOidObject) + OID_BUFFER_LEN;
+        value->readOnly  = object->readOnly;
+        value->type      = object->type;
+        value->len       = object->len;
+        if (value->len > bufferLen || (uintptr_t)object->buf + value->len > (uintptr_t)map->shm + map->size) {
+          // torn read of a changing object, seq tells
+          value->len = 0;
+        }
+        if (value->len > OID_BUFFER_LEN && value->data == value->buf) {
+          value->data = malloc(UINT16_MAX + 1);
+          if (value->data == NULL) {
+            value->data = value->buf;
+            return -1;
+          }
+        }
+        memcpy(value->data, object->buf, value->len);
+      }
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      if (__atomic_load_n(&map->shm->seq, __ATOMIC_RELAXED) == seq) {
+        if (!stale) {
+          return (object != NULL) ? 0 : -1;
+        }
+        // another process added objects beyond our mapping
+        AGENT_RemapShm();
+        continue;
+      }
+    }
+    sched_yield();
   }
+}
 
-  pAct = AGENT_GetNextOidObject(NULL);
-  while (pAct != NULL) {
-    pLast = pAct;
-    pAct  = AGENT_GetNextOidObject(pAct);
+INTERNAL_SYM void AGENT_FreeOidValue(tOidValue *value) {
+  if (value->data != value->buf) {
+    free(value->data);
   }
+  value->data = value->buf;
+}
 
-  pOidShm->oidCount++;
-  pAct = AGENT_GetNextOidObject(pLast);
-  if (pAct != NULL) {
-    pAct->objLen = size;
-    pAct->index  = pOidShm->oidCount - 1;
+INTERNAL_SYM tOidObject *AGENT_GetFreeOidObject(size_t size) {
+  tOidShm *shm;
+  tOidObject *pAct;
+
+  if (AGENT_ExtendShm(size) != 0) {
+    return NULL;
   }
+  shm = _GetMap()->shm;
+
+  pAct = (tOidObject *)((uintptr_t)shm + shm->oidUsed);
+  memset(pAct, 0, size);
+  pAct->objLen = size;
+  pAct->index  = (uint32_t)shm->oidCount;
+  shm->oidUsed += size;
+  shm->oidCount++;
   return pAct;
 }
 
@@ -554,13 +795,18 @@ INTERNAL_SYM tWagoSnmpReturnCode AGENT_CreateNewOidObject(oid *anOID, size_t anO
     CALC_OBJ_SIZE(objectSize, stData->val_len, stData->val.string == stData->buf);
     AGENT_MutexLock();
 
-    pObj = AGENT_GetFreeOidObject(objectSize);
-    if (pObj != NULL) {
-      pObj->readOnly = readOnly;
-      memcpy(pObj->anOID, anOID, anOID_len * sizeof(oid));
-      pObj->anOID_length = anOID_len;
-      AGENT_SetOidObjectValue(pObj, stData);
-      result = WAGOSNMP_RETURN_OK;
+    if (AGENT_GetOidObject(anOID, anOID_len) != NULL) {
+      result = WAGOSNMP_RETURN_ERROR_EXIST;
+    } else {
+      pObj = AGENT_GetFreeOidObject(objectSize);
+      if (pObj != NULL) {
+        pObj->readOnly = readOnly;
+        memcpy(pObj->anOID, anOID, anOID_len * sizeof(oid));
+        pObj->anOID_length = anOID_len;
+        AGENT_SetOidObjectValue(pObj, stData);
+        _LinkOidObject(_GetMap()->shm, pObj);
+        result = WAGOSNMP_RETURN_OK;
+      }
     }
 
     AGENT_MutexUnlock();
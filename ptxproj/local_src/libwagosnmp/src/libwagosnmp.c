@@ -662,7 +662,7 @@ PUBLIC_SYM tWagoSnmpReturnCode libwagosnmp_GetCustomOid(char *sOID, tWagoSnmpTlv
   netsnmp_variable_list *stData = (netsnmp_variable_list *)stTlvData;
   size_t anOID_len              = MAX_OID_LEN;
   oid anOID[MAX_OID_LEN];
-  tOidObject *object = NULL;
+  tOidValue value;
 
   INIT_SNMP_AGENT_ONCE;
   SNMP_MutexLock();
@@ -674,16 +674,14 @@ PUBLIC_SYM tWagoSnmpReturnCode libwagosnmp_GetCustomOid(char *sOID, tWagoSnmpTlv
   SNMP_MutexUnlock();
 
   INTERNAL_ReTwist(stData);
-  AGENT_MutexLock();
-  object = AGENT_GetOidObject(anOID, anOID_len);
-  if (object != NULL) {
-    if (object->type > UINT8_MAX || INTERNAL_SetVarTypedValue(stData, (u_char)object->type, object->buf, object->len)) {
+  if (AGENT_ReadOidValue(anOID, anOID_len, &value) == 0) {
+    if (value.type > UINT8_MAX || INTERNAL_SetVarTypedValue(stData, (u_char)value.type, value.data, value.len)) {
       result = WAGOSNMP_RETURN_ERR_MALLOC;
     } else {
       result = WAGOSNMP_RETURN_OK;
     }
   }
-  AGENT_MutexUnlock();
+  AGENT_FreeOidValue(&value);
   INTERNAL_DeTwist(stData);
   return result;
 }
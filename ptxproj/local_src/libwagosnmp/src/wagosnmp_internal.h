@@ -54,7 +54,14 @@ INTERNAL_SYM extern pthread_once_t snmp_agent_is_initialized;
 #define CREAT_MODE (S_IWUSR | S_IRUSR)
 #define OPEN_SERVER_MODE (O_RDONLY | O_CREAT | O_EXCL | O_NONBLOCK)
 
+#define WAGO_SNMP_AGENT_MQ_DEPTH 10
+
 #define OID_BUFFER_LEN 256
+#define OID_HASH_BUCKETS 1024
+
+/* identifies the layout of tOidShm, a table of another layout is replaced */
+#define OID_SHM_MAGIC 0x574f4944u /* "WOID" */
+#define OID_SHM_VERSION 2u
 
 #define CALC_OBJ_SIZE(x, y, z)                         \
   {                                                    \
@@ -98,6 +105,7 @@ typedef struct {
   uint32_t index;
   size_t objLen;
   uint8_t readOnly;
+  uint32_t hashNext; /* offset of the next object of the hash bucket, 0 ends the chain */
   oid anOID[MAX_OID_LEN];
   size_t anOID_length;
   uint16_t type;
@@ -105,11 +113,28 @@ typedef struct {
   uint8_t buf[OID_BUFFER_LEN];
 } __attribute__((packed)) tOidObject;
 
+/* Writers change the table holding WAGO_SNMP_OID_MUTEX with an odd seq.
+ * Readers do not lock: they copy a value and retry if seq was odd or changed meanwhile. */
 typedef struct {
+  uint32_t magic;      /* OID_SHM_MAGIC, set last by the creator of the table */
+  uint32_t version;    /* OID_SHM_VERSION */
+  uint32_t headerSize; /* sizeof(tOidShm) */
   size_t oidShmSize;
+  size_t oidUsed;
   size_t oidCount;
+  uint32_t seq;
+  uint32_t buckets[OID_HASH_BUCKETS]; /* offset of the first object of a bucket, 0 is empty */
   tOidObject oidStart[];
-} __attribute__((packed)) tOidShm;
+} tOidShm;
+
+/* copy of an OID value, data points to buf or to an allocation for long values */
+typedef struct {
+  uint8_t readOnly;
+  uint16_t type;
+  uint16_t len;
+  uint8_t *data;
+  uint8_t buf[OID_BUFFER_LEN];
+} tOidValue;
 
 int INTERNAL_SnmpInput(int operation, netsnmp_session *session, int reqid, netsnmp_pdu *pdu, void *magic);
 INTERNAL_SYM tWagoSnmpReturnCode INTERNAL_SetAuthPriv(tWagoSnmpTranceiver *trcv, netsnmp_session *session);
@@ -137,6 +162,7 @@ INTERNAL_SYM netsnmp_pdu *INTERNAL_GetTrap2PDU_v2_v3(char sEnterprise[128], tWag
 /* AGENT */
 INTERNAL_SYM void AGENT_InitServerCommunication(unsigned int clientreg, void *clientarg);
 INTERNAL_SYM void AGENT_RemapShm(void);
+INTERNAL_SYM void AGENT_SetOidTableNames(const char *shmName, const char *mutexName);
 INTERNAL_SYM int AGENT_CreateMutex(void);
 INTERNAL_SYM void AGENT_MutexLock(void);
 INTERNAL_SYM void AGENT_MutexUnlock(void);
@@ -149,6 +175,8 @@ INTERNAL_SYM int AGENT_ExtendShm(size_t size);
 
 INTERNAL_SYM tOidObject *AGENT_GetNextOidObject(tOidObject *pAct);
 INTERNAL_SYM tOidObject *AGENT_GetOidObject(oid *anOID, size_t anOID_len);
+INTERNAL_SYM int AGENT_ReadOidValue(oid *anOID, size_t anOID_len, tOidValue *value);
+INTERNAL_SYM void AGENT_FreeOidValue(tOidValue *value);
 INTERNAL_SYM tOidObject *AGENT_GetFreeOidObject(size_t size);
 INTERNAL_SYM void AGENT_SetOidObjectValue(tOidObject *pObj, netsnmp_variable_list *stData);
 INTERNAL_SYM tWagoSnmpReturnCode AGENT_CreateNewOidObject(oid *anOID, size_t anOID_len, netsnmp_variable_list *stData,
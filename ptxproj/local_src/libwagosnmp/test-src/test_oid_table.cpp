@@ -0,0 +1,256 @@
+//------------------------------------------------------------------------------
+// Copyright (c) WAGO GmbH & Co. KG
+//
+// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+// manufacturing, reproduction, use and sales rights pertaining to this
+// subject matter are governed by the license agreement. The recipient of this
+// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file     test_oid_table.cpp
+///
+///  \brief    Shared custom OID table: lookups while the table grows, and a
+///            walking reader against concurrent writers with its latency
+///            percentiles.
+///
+///  \author   WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include <gtest/gtest.h>
+
+#include <net-snmp/net-snmp-config.h>
+#include <net-snmp/net-snmp-features.h>
+#include <net-snmp/net-snmp-includes.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+extern "C" {
+#include "wagosnmp_API.h"
+#include "wagosnmp_internal.h"
+}
+
+//------------------------------------------------------------------------------
+// defines; structure, enumeration and type definitions
+//------------------------------------------------------------------------------
+namespace {
+
+constexpr size_t valueLen = 64;
+
+struct TestOid {
+  oid name[MAX_OID_LEN];
+  size_t len;
+};
+
+//------------------------------------------------------------------------------
+// function implementation
+//------------------------------------------------------------------------------
+TestOid MakeOid(size_t index) {
+  const oid base[] = {1, 3, 6, 1, 4, 1, 13576, 99, 1};
+  TestOid o;
+  std::copy(std::begin(base), std::end(base), o.name);
+  o.name[9]  = index / 1000;
+  o.name[10] = index % 1000;
+  o.len      = 11;
+  return o;
+}
+
+// a value whose bytes all equal fill, a torn read shows mixed bytes
+void SetValue(tWagoSnmpTlv *tlv, uint8_t fill, size_t len) {
+  std::vector<uint8_t> value(len, fill);
+  libwagosnmp_TlvInit(tlv);
+  INTERNAL_SetVarTypedValue(SNMP_TLV(tlv), ASN_OCTET_STR, value.data(), value.size());
+}
+
+bool Register(const TestOid &o, uint8_t fill, size_t len) {
+  tWagoSnmpTlv tlv;
+  SetValue(&tlv, fill, len);
+  INTERNAL_ReTwist(SNMP_TLV(&tlv));
+  bool ok = AGENT_CreateNewOidObject(const_cast<oid *>(o.name), o.len, SNMP_TLV(&tlv), 0) == WAGOSNMP_RETURN_OK;
+  INTERNAL_DeTwist(SNMP_TLV(&tlv));
+  libwagosnmp_TlvDeinit(&tlv);
+  return ok;
+}
+
+void Write(const TestOid &o, uint8_t fill) {
+  tWagoSnmpTlv tlv;
+  SetValue(&tlv, fill, valueLen);
+  INTERNAL_ReTwist(SNMP_TLV(&tlv));
+  AGENT_MutexLock();
+  tOidObject *object = AGENT_GetOidObject(const_cast<oid *>(o.name), o.len);
+  if (object != nullptr) {
+    AGENT_SetOidObjectValue(object, SNMP_TLV(&tlv));
+  }
+  AGENT_MutexUnlock();
+  INTERNAL_DeTwist(SNMP_TLV(&tlv));
+  libwagosnmp_TlvDeinit(&tlv);
+}
+
+bool Consistent(const tOidValue &value, size_t len) {
+  return value.type == ASN_OCTET_STR && value.len == len &&
+         std::all_of(value.data, value.data + len, [&value](uint8_t b) { return b == value.data[0]; });
+}
+
+class OidTable : public ::testing::Test {
+ protected:
+  // a table of its own, the one of a running agent stays untouched
+  void SetUp() override {
+    shmName_   = std::string(WAGO_SNMP_OID_SHM) + "_test_" + std::to_string(getpid());
+    mutexName_ = std::string(WAGO_SNMP_OID_MUTEX) + "_test_" + std::to_string(getpid());
+    AGENT_SetOidTableNames(shmName_.c_str(), mutexName_.c_str());
+    AGENT_DestroyShm();
+    AGENT_DestroyMutex();
+    ASSERT_EQ(0, AGENT_CreateMutex());
+    AGENT_CreateShm();
+  }
+  void TearDown() override {
+    AGENT_DestroyShm();
+    AGENT_DestroyMutex();
+    AGENT_SetOidTableNames(nullptr, nullptr);
+  }
+
+  std::string shmName_;
+  std::string mutexName_;
+};
+
+}  // namespace
+
+TEST_F(OidTable, LookupWhileGrowing) {
+  constexpr size_t count = 2000;
+  for (size_t i = 0; i < count; i++) {
+    ASSERT_TRUE(Register(MakeOid(i), (uint8_t)i, 1 + i % 300));
+  }
+  EXPECT_FALSE(Register(MakeOid(7), 0, 8));
+
+  for (size_t i = 0; i < count; i++) {
+    TestOid o = MakeOid(i);
+    tOidValue value;
+    ASSERT_EQ(0, AGENT_ReadOidValue(o.name, o.len, &value));
+    EXPECT_TRUE(Consistent(value, 1 + i % 300));
+    EXPECT_EQ((uint8_t)i, value.data[0]);
+    AGENT_FreeOidValue(&value);
+  }
+  TestOid missing = MakeOid(count);
+  tOidValue value;
+  EXPECT_EQ(-1, AGENT_ReadOidValue(missing.name, missing.len, &value));
+  AGENT_FreeOidValue(&value);
+}
+
+TEST_F(OidTable, WalkAgainstConcurrentWriters) {
+  constexpr size_t count   = 256;
+  constexpr size_t writers = 2;
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> threads;
+  std::vector<uint64_t> latencies;
+  size_t torn    = 0;
+  size_t missing = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    ASSERT_TRUE(Register(MakeOid(i), 0, valueLen));
+  }
+
+  for (size_t w = 0; w < writers; w++) {
+    threads.emplace_back([&stop, w]() {
+      uint32_t n = (uint32_t)w;
+      while (!stop) {
+        Write(MakeOid(n % count), (uint8_t)n);
+        n += 7;
+      }
+    });
+  }
+  // registering makes the table grow and be mapped again while it is read
+  threads.emplace_back([&stop]() {
+    for (size_t i = count; !stop && i < count + 1000; i++) {
+      Register(MakeOid(i), 0, valueLen);
+      std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+  });
+
+  auto end = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (std::chrono::steady_clock::now() < end) {
+    // an SNMP walk gets one instance after the other
+    for (size_t i = 0; i < count; i++) {
+      TestOid o = MakeOid(i);
+      tOidValue value;
+      auto start = std::chrono::steady_clock::now();
+      int found  = AGENT_ReadOidValue(o.name, o.len, &value);
+      latencies.push_back(
+          (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+              .count());
+      if (found != 0) {
+        missing++;
+      } else if (!Consistent(value, valueLen)) {
+        torn++;
+      }
+      AGENT_FreeOidValue(&value);
+    }
+  }
+  stop = true;
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) { return latencies[(size_t)(p * (double)(latencies.size() - 1))]; };
+  printf("%zu reads: p50 %llu ns, p99 %llu ns, p99.9 %llu ns, max %llu ns\n", latencies.size(),
+         (unsigned long long)percentile(0.5), (unsigned long long)percentile(0.99),
+         (unsigned long long)percentile(0.999), (unsigned long long)latencies.back());
+  EXPECT_EQ(0u, torn);
+  EXPECT_EQ(0u, missing);
+}
+
+TEST_F(OidTable, KeepsTableOfSameLayout) {
+  TestOid o = MakeOid(1);
+  ASSERT_TRUE(Register(o, 5, valueLen));
+  AGENT_CloseShm();
+  AGENT_CreateShm();
+
+  tOidValue value;
+  ASSERT_EQ(0, AGENT_ReadOidValue(o.name, o.len, &value));
+  EXPECT_EQ(5, value.data[0]);
+  AGENT_FreeOidValue(&value);
+}
+
+TEST_F(OidTable, ReplacesTableOfOtherLayout) {
+  AGENT_DestroyShm();
+
+  // header of the former layout: table size and OID count, no magic
+  int fd = shm_open(shmName_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+  ASSERT_LE(0, fd);
+  size_t oldHeader[2] = {sizeof(tOidShm) + 4096, 3};
+  ASSERT_EQ(0, ftruncate(fd, (off_t)oldHeader[0]));
+  ASSERT_EQ((ssize_t)sizeof(oldHeader), pwrite(fd, oldHeader, sizeof(oldHeader), 0));
+  close(fd);
+
+  AGENT_CreateShm();
+  TestOid o = MakeOid(1);
+  ASSERT_TRUE(Register(o, 9, valueLen));
+  tOidValue value;
+  ASSERT_EQ(0, AGENT_ReadOidValue(o.name, o.len, &value));
+  EXPECT_EQ(9, value.data[0]);
+  AGENT_FreeOidValue(&value);
+  EXPECT_EQ(nullptr, AGENT_GetNextOidObject(AGENT_GetNextOidObject(nullptr)));
+
+  fd = shm_open(shmName_.c_str(), O_RDONLY, 0);
+  ASSERT_LE(0, fd);
+  tOidShm header;
+  ASSERT_EQ((ssize_t)offsetof(tOidShm, buckets), pread(fd, &header, offsetof(tOidShm, buckets), 0));
+  close(fd);
+  EXPECT_EQ(OID_SHM_MAGIC, header.magic);
+  EXPECT_EQ(OID_SHM_VERSION, header.version);
+  EXPECT_EQ(sizeof(tOidShm), header.headerSize);
+}
+
+//---- End of source file ------------------------------------------------------
@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include "Status.hpp"
+
+namespace netconf {
+namespace api {
+
+/**
+ * Fetch bridge, interface, IP and DIP switch configuration with one round trip to netconfd.
+ * The configurations are kept in the process wide cache, following Get...() calls are served from it
+ * until netconfd reports a configuration change.
+ * Without the configuration generation of netconfd nothing can be cached, the call returns without a request then.
+ */
+Status PrefetchConfigs();
+
+}
+}
@@ -48,7 +48,7 @@ libnetconf.so_DISABLEDWARNINGS += inline psabi
 libnetconf.so_CXXDISABLEDWARNINGS += $(libnetconf.so_DISABLEDWARNINGS) abi-tag
 libnetconf.so_CDISABLEDWARNINGS += $(libnetconf.so_DISABLEDWARNINGS)
 libnetconf.so_DEFINES +=
-libnetconf.so_LIBS += boost_system boost_filesystem common
+libnetconf.so_LIBS += boost_system boost_filesystem common rt
 libnetconf.so_STATICALLYLINKED += common
 libnetconf.so_PKG_CONFIGS = dbus-1
 libnetconf.so_PREREQUISITES += $(call lib_buildtarget_raw, $(libnetconf.so_LIBS))
@@ -87,7 +87,7 @@ libnetconf.a_DISABLEDWARNINGS += inline psabi
 libnetconf.a_CXXDISABLEDWARNINGS += $(libnetconf.a_DISABLEDWARNINGS) abi-tag
 libnetconf.a_CDISABLEDWARNINGS += $(libnetconf.a_DISABLEDWARNINGS)
 libnetconf.a_DEFINES +=
-libnetconf.a_LIBS += boost_system boost_filesystem common
+libnetconf.a_LIBS += boost_system boost_filesystem common rt
 libnetconf.a_STATICALLYLINKED += common
 libnetconf.a_PKG_CONFIGS = dbus-1
 libnetconf.a_CPPFLAGS += $(call uniq, $(libnetconf.a_INCLUDES))
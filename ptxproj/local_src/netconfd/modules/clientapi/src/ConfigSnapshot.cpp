@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "ConfigSnapshot.hpp"
+#include "NetconfdDbusClient.hpp"
+
+namespace netconf {
+namespace api {
+
+Status PrefetchConfigs() {
+  if (not NetconfdDbusClient::IsCacheAvailable()) {
+    return Status { };
+  }
+  NetconfdDbusClient client;
+  auto snapshot = client.GetConfigSnapshot();
+  for (auto *result : { &snapshot.bridge_config, &snapshot.interface_configs, &snapshot.ip_configs,
+      &snapshot.dip_switch_config }) {
+    if (result->error_.IsNotOk()) {
+      return result->error_;
+    }
+  }
+  return Status { };
+}
+
+}
+}
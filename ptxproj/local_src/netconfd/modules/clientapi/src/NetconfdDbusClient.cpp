@@ -2,7 +2,10 @@
 
 #include "NetconfdDbusClient.hpp"
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <exception>
@@ -12,6 +15,7 @@
 #include <dbus/dbus.h>
 #include <sys/stat.h>
 
+#include "ConfigGeneration.hpp"
 #include "DbusError.hpp"
 #include "Types.hpp"
 #include "SharedSemaphore.hpp"
@@ -32,6 +36,51 @@ class DbusMsgPtr : public ::std::unique_ptr<DBusMessage, decltype(dbus_message_u
   }
 };
 
+namespace {
+
+/*
+ * Configurations are cached per process. An entry is valid as long as the configuration generation netconfd publishes
+ * in shared memory has not changed since the entry was fetched. Without the generation nothing is cached.
+ */
+struct CacheEntry {
+  uint64_t generation;
+  DbusResult result;
+};
+
+::std::mutex cache_mutex;
+::std::map<::std::string, CacheEntry> cache;
+::std::atomic<bool> service_available { false };
+::std::atomic<uint64_t> round_trips { 0 };
+
+const ConfigGeneration& GetConfigGeneration() {
+  static const ConfigGeneration generation { ConfigGeneration::Access::ReadOnly };
+  return generation;
+}
+
+::std::string GetCacheKey(const DbusMsgPtr &msg) {
+  return ::std::string { dbus_message_get_path(msg.get()) } + "/" + dbus_message_get_member(msg.get());
+}
+
+bool LookupCache(const ::std::string &key, uint64_t generation, DbusResult &result) {
+  const ::std::lock_guard<::std::mutex> lock(cache_mutex);
+  auto entry = cache.find(key);
+  if (entry != cache.end() && entry->second.generation == generation) {
+    result = entry->second.result;
+    return true;
+  }
+  return false;
+}
+
+void StoreCache(const ::std::string &key, uint64_t generation, const DbusResult &result) {
+  if (result.error_.IsNotOk()) {
+    return;
+  }
+  const ::std::lock_guard<::std::mutex> lock(cache_mutex);
+  cache[key] = CacheEntry { generation, result };
+}
+
+}  // namespace
+
 class DbusMsgContent {
  public:
   explicit DbusMsgContent(const DbusMsgPtr &msg)
@@ -55,8 +104,12 @@ NetconfdDbusClient::NetconfdDbusClient(int dbus_timeout_millis)
     throw ::std::runtime_error("connection to dbus failed.");
   }
 
-  if (not CheckServiceAvailability(::std::chrono::seconds { 60 })) {
-    throw ::std::runtime_error("netconfd dbus interface not available.");
+  // The connection to the system bus is shared within the process, checking netconfd once is sufficient
+  if (not service_available) {
+    if (not CheckServiceAvailability(::std::chrono::seconds { 60 })) {
+      throw ::std::runtime_error("netconfd dbus interface not available.");
+    }
+    service_available = true;
   }
 }
 
@@ -200,12 +253,12 @@ static ::std::vector<::std::string> GetMessageStrings(const netconf::DbusMsgPtr
 
 DbusResult NetconfdDbusClient::GetBackupParameterCount() {
   auto msg = CreateBackupMessage("getbackupparamcount");
-  return GetStrings(msg);
+  return GetCachedStrings(msg);
 }
 
 DbusResult NetconfdDbusClient::GetBridgeConfig() {
   auto msg = CreateInterfaceConfigMessage("get");
-  return GetStrings(msg);
+  return GetCachedStrings(msg);
 }
 
 DbusResult NetconfdDbusClient::SetBridgeConfig(const ::std::string &json_config) {
@@ -215,7 +268,7 @@ DbusResult NetconfdDbusClient::SetBridgeConfig(const ::std::string &json_config)
 
 DbusResult NetconfdDbusClient::GetIpConfigs() {
   auto msg = CreateIpMessage("getall");
-  return GetStrings(msg);
+  return GetCachedStrings(msg);
 }
 
 DbusResult NetconfdDbusClient::GetCurrentIpConfigs() {
@@ -235,7 +288,7 @@ DbusResult NetconfdDbusClient::SetTemporaryFixedIpAddress() {
 
 DbusResult NetconfdDbusClient::GetDipSwitchConfig() {
   auto msg = CreateIpMessage("getdipswitchconfig");
-  return GetStrings(msg);
+  return GetCachedStrings(msg);
 }
 
 DbusResult NetconfdDbusClient::SetDipSwitchConfig(const ::std::string &config) {
@@ -245,7 +298,7 @@ DbusResult NetconfdDbusClient::SetDipSwitchConfig(const ::std::string &config) {
 
 DbusResult NetconfdDbusClient::GetInterfaceConfigs() {
   auto msg = CreateInterfaceConfigMessage("getinterfaceconfig");
-  return GetStrings(msg);
+  return GetCachedStrings(msg);
 }
 
 DbusResult NetconfdDbusClient::GetInterfaceStatuses() {
@@ -260,7 +313,7 @@ DbusResult NetconfdDbusClient::SetInterfaceConfigs(const ::std::string &config)
 
 DbusResult NetconfdDbusClient::GetDeviceInterfaces() {
   auto msg = CreateInterfaceConfigMessage("getdeviceinterfaces");
-  return GetStrings(msg);
+  return GetCachedStrings(msg);
 }
 
 DbusResult NetconfdDbusClient::AddInterface(const ::std::string &config) {
@@ -307,6 +360,76 @@ DbusResult NetconfdDbusClient::Send(const DbusMsgPtr &msg, const ::std::string &
   return Send(msg);
 }
 
+NetconfdDbusClient::ConfigSnapshot NetconfdDbusClient::GetConfigSnapshot() {
+  auto generation_available = GetConfigGeneration().IsAvailable();
+  auto generation = GetConfigGeneration().Get();
+
+  ConfigSnapshot snapshot;
+  ::std::array<DbusResult*, 4> results { &snapshot.bridge_config, &snapshot.interface_configs, &snapshot.ip_configs,
+      &snapshot.dip_switch_config };
+  ::std::array<DbusMsgPtr, 4> msgs { CreateInterfaceConfigMessage("get"), CreateInterfaceConfigMessage(
+      "getinterfaceconfig"), CreateIpMessage("getall"), CreateIpMessage("getdipswitchconfig") };
+  ::std::array<DBusPendingCall*, 4> pending_calls { };
+  bool pipelined = false;
+
+  for (size_t i = 0; i < msgs.size(); ++i) {
+    if (generation_available && LookupCache(GetCacheKey(msgs.at(i)), generation, *results.at(i))) {
+      continue;
+    }
+    if (dbus_connection_send_with_reply(conn_, msgs.at(i).get(), &pending_calls.at(i), timeout_millis_) == 0
+        || pending_calls.at(i) == nullptr) {
+      pending_calls.at(i) = nullptr;
+      *results.at(i) = GetStrings(msgs.at(i));
+      continue;
+    }
+    pipelined = true;
+  }
+  dbus_connection_flush(conn_);
+  if (pipelined) {
+    ++round_trips;
+  }
+
+  for (size_t i = 0; i < msgs.size(); ++i) {
+    if (pending_calls.at(i) == nullptr) {
+      continue;
+    }
+    dbus_pending_call_block(pending_calls.at(i));
+    auto replymsg = DbusMsgPtr { dbus_pending_call_steal_reply(pending_calls.at(i)) };
+    dbus_pending_call_unref(pending_calls.at(i));
+
+    DbusError error;
+    if (replymsg == nullptr) {
+      dbus_set_error_const(&error, DBUS_ERROR_NO_REPLY, "no reply from netconfd");
+      *results.at(i) = DbusResult { error };
+      continue;
+    }
+    if (dbus_set_error_from_message(&error, replymsg.get()) != 0) {
+      *results.at(i) = DbusResult { error };
+      continue;
+    }
+    auto strings = GetMessageStrings(replymsg);
+    *results.at(i) = DbusResult { strings[0], strings.size() >= 2 ? strings[1] : "" };
+    if (generation_available) {
+      StoreCache(GetCacheKey(msgs.at(i)), generation, *results.at(i));
+    }
+  }
+
+  return snapshot;
+}
+
+void NetconfdDbusClient::InvalidateCache() {
+  const ::std::lock_guard<::std::mutex> lock(cache_mutex);
+  cache.clear();
+}
+
+bool NetconfdDbusClient::IsCacheAvailable() {
+  return GetConfigGeneration().IsAvailable();
+}
+
+uint64_t NetconfdDbusClient::GetRoundTrips() {
+  return round_trips;
+}
+
 DbusResult NetconfdDbusClient::Send(const DbusMsgPtr &msg) {
 
   // WORKAROUND: guard to serialize access to the dbus interface of netconfd to work around an issue of
@@ -316,10 +439,13 @@ DbusResult NetconfdDbusClient::Send(const DbusMsgPtr &msg) {
     const ::std::lock_guard<SharedSemaphore> dbus_access_lock(dbus_access_semaphore_);
 
     DbusError error;
+    ++round_trips;
     auto replymsg = DbusMsgPtr { dbus_connection_send_with_reply_and_block(conn_, msg.get(), timeout_millis_, &error) };
     if (error.IsSet()) {
       return DbusResult{ error };
     }
+    // Do not rely on netconfd to publish the change before our next read
+    InvalidateCache();
     auto strings = GetMessageStrings(replymsg);
     return DbusResult{ strings[0] };
   }
@@ -328,6 +454,7 @@ DbusResult NetconfdDbusClient::Send(const DbusMsgPtr &msg) {
 DbusResult NetconfdDbusClient::GetStrings(const DbusMsgPtr &msg) {
 
   DbusError error;
+  ++round_trips;
   auto replymsg = DbusMsgPtr { dbus_connection_send_with_reply_and_block(conn_, msg.get(), timeout_millis_, &error) };
 
   if (error.IsSet()) {
@@ -338,4 +465,22 @@ DbusResult NetconfdDbusClient::GetStrings(const DbusMsgPtr &msg) {
   return { strings[0], strings.size() >= 2 ? strings[1] : "" };
 }
 
+DbusResult NetconfdDbusClient::GetCachedStrings(const DbusMsgPtr &msg) {
+  const auto &config_generation = GetConfigGeneration();
+  if (not config_generation.IsAvailable()) {
+    return GetStrings(msg);
+  }
+
+  // Take the generation before the request, a change while the request is pending invalidates the new entry
+  auto generation = config_generation.Get();
+  auto key = GetCacheKey(msg);
+  DbusResult result;
+  if (LookupCache(key, generation, result)) {
+    return result;
+  }
+  result = GetStrings(msg);
+  StoreCache(key, generation, result);
+  return result;
+}
+
 }  // namespace netconf
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -58,6 +59,34 @@ namespace netconf
       DbusResult NotifyDynamicIPAction(const ::std::string &event);
       DbusResult ReloadHostConf();
 
+      struct ConfigSnapshot {
+        DbusResult bridge_config;
+        DbusResult interface_configs;
+        DbusResult ip_configs;
+        DbusResult dip_switch_config;
+      };
+
+      /**
+       * Get bridge, interface, IP and DIP switch configuration at once.
+       * The requests are sent in parallel, so the configurations are fetched with the latency of one round trip.
+       */
+      ConfigSnapshot GetConfigSnapshot();
+
+      /**
+       * Drop all configurations cached in this process.
+       */
+      static void InvalidateCache();
+
+      /**
+       * Configurations are only cached if netconfd publishes its configuration generation.
+       */
+      static bool IsCacheAvailable();
+
+      /**
+       * Number of round trips to netconfd this process made so far. Pipelined requests count as one.
+       */
+      static uint64_t GetRoundTrips();
+
     private:
       DBusConnection *conn_;
       int timeout_millis_;
@@ -66,6 +95,7 @@ namespace netconf
       DbusResult Send(const DbusMsgPtr &msg, const ::std::string &content);
       DbusResult Send(const DbusMsgPtr &msg);
       DbusResult GetStrings(const DbusMsgPtr &msg);
+      DbusResult GetCachedStrings(const DbusMsgPtr &msg);
 
 
   };
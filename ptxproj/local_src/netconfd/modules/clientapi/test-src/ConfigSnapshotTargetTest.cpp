@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "CommonTestDependencies.hpp"
+
+#include <iostream>
+
+#include "BridgeConfig.hpp"
+#include "ConfigSnapshot.hpp"
+#include "DipSwitchConfig.hpp"
+#include "IPConfig.hpp"
+#include "InterfaceConfig.hpp"
+#include "NetconfdDbusClient.hpp"
+
+namespace netconf {
+namespace api {
+
+class ConfigSnapshotTest_Target : public testing::Test {
+ public:
+  void SetUp() override {
+    if (not NetconfdDbusClient::IsCacheAvailable()) {
+      GTEST_SKIP() << "netconfd does not publish its configuration generation";
+    }
+    NetconfdDbusClient::InvalidateCache();
+  }
+
+  /*
+   * The reads the TCP/IP page of the WBM triggers for one port: bridge and IP config to resolve the address
+   * (get_eth_config), interface configs for the port settings and the DIP switch for the switch mode.
+   */
+  static void ReadNetworkPage() {
+    BridgeConfig bridge_config;
+    IPConfigs ip_configs;
+    InterfaceConfigs interface_configs;
+    DipSwitchConfig dip_switch_config;
+    EXPECT_TRUE(GetBridgeConfig(bridge_config).IsOk());
+    EXPECT_TRUE(GetIPConfigs(ip_configs).IsOk());
+    EXPECT_TRUE(GetInterfaceConfigs(interface_configs).IsOk());
+    EXPECT_TRUE(GetDipSwitchConfig(dip_switch_config).IsOk());
+  }
+};
+
+TEST_F(ConfigSnapshotTest_Target, PrefetchServesFollowingGetsFromCache) {
+  ASSERT_TRUE(PrefetchConfigs().IsOk());
+  auto after_prefetch = NetconfdDbusClient::GetRoundTrips();
+
+  ReadNetworkPage();
+
+  EXPECT_EQ(after_prefetch, NetconfdDbusClient::GetRoundTrips());
+}
+
+TEST_F(ConfigSnapshotTest_Target, PrefetchTakesOneRoundTrip) {
+  auto start = NetconfdDbusClient::GetRoundTrips();
+
+  ASSERT_TRUE(PrefetchConfigs().IsOk());
+
+  EXPECT_EQ(start + 1, NetconfdDbusClient::GetRoundTrips());
+}
+
+TEST_F(ConfigSnapshotTest_Target, SecondPrefetchIsServedFromCache) {
+  ASSERT_TRUE(PrefetchConfigs().IsOk());
+  auto after_prefetch = NetconfdDbusClient::GetRoundTrips();
+
+  ASSERT_TRUE(PrefetchConfigs().IsOk());
+
+  EXPECT_EQ(after_prefetch, NetconfdDbusClient::GetRoundTrips());
+}
+
+TEST_F(ConfigSnapshotTest_Target, NetworkPageRoundTrips) {
+  auto start = NetconfdDbusClient::GetRoundTrips();
+  ReadNetworkPage();
+  auto without_prefetch = NetconfdDbusClient::GetRoundTrips() - start;
+
+  NetconfdDbusClient::InvalidateCache();
+  start = NetconfdDbusClient::GetRoundTrips();
+  ASSERT_TRUE(PrefetchConfigs().IsOk());
+  ReadNetworkPage();
+  auto with_prefetch = NetconfdDbusClient::GetRoundTrips() - start;
+
+  ::std::cout << "network page round trips: " << without_prefetch << " without prefetch, " << with_prefetch
+              << " with prefetch" << ::std::endl;
+  EXPECT_EQ(4, without_prefetch);
+  EXPECT_EQ(1, with_prefetch);
+}
+
+}  // namespace api
+}  // namespace netconf
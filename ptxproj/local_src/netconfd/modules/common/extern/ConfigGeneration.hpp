@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace netconf {
+
+/**
+ * Generation counter of the netconfd configuration, located in shared memory.
+ * netconfd increments it whenever a configuration changed, clients compare it against the value they cached
+ * their data with. A client that cannot map the counter gets no generation and must not cache.
+ */
+class ConfigGeneration {
+ public:
+  static constexpr auto default_name = "netconfd.generation";
+
+  enum class Access {
+    ReadOnly,
+    ReadWrite
+  };
+
+  explicit ConfigGeneration(Access access, const ::std::string &name = default_name);
+  ~ConfigGeneration();
+
+  ConfigGeneration(const ConfigGeneration&) = delete;
+  ConfigGeneration& operator=(const ConfigGeneration&) = delete;
+  ConfigGeneration(ConfigGeneration&&) = delete;
+  ConfigGeneration& operator=(ConfigGeneration&&) = delete;
+
+  [[nodiscard]] bool IsAvailable() const;
+  [[nodiscard]] uint64_t Get() const;
+  void Increment();
+
+ private:
+  ::std::atomic<uint64_t> *counter_ = nullptr;
+};
+
+}  // namespace netconf
@@ -32,7 +32,7 @@ libcommon.a_DISABLEDWARNINGS += inline psabi
 libcommon.a_CXXDISABLEDWARNINGS += $(libcommon.a_DISABLEDWARNINGS) abi-tag
 libcommon.a_CDISABLEDWARNINGS += $(libcommon.a_DISABLEDWARNINGS)
 libcommon.a_DEFINES +=
-libcommon.a_LIBS += boost_system
+libcommon.a_LIBS += boost_system rt
 libcommon.a_PKG_CONFIGS =
 libcommon.a_CPPFLAGS += $(call uniq, $(libcommon.a_INCLUDES))
 libcommon.a_CPPFLAGS += $(call pkg_config_cppflags,$(libcommon.a_PKG_CONFIGS))
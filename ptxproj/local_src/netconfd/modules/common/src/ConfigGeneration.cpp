@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "ConfigGeneration.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace netconf {
+
+static constexpr mode_t generation_file_permission = 0644;
+
+ConfigGeneration::ConfigGeneration(Access access, const ::std::string &name) {
+  auto writable = access == Access::ReadWrite;
+  auto path = "/" + name;
+
+  int fd = shm_open(path.c_str(), writable ? (O_RDWR | O_CREAT) : O_RDONLY, generation_file_permission);
+  if (fd < 0) {
+    return;
+  }
+
+  if (writable) {
+    // shm_open applies the process' umask => set the mode explicitly to allow readers in other processes
+    struct stat file_info { };
+    if (fchmod(fd, generation_file_permission) != 0 || fstat(fd, &file_info) != 0 ||
+        (file_info.st_size < static_cast<off_t>(sizeof(uint64_t)) && ftruncate(fd, sizeof(uint64_t)) != 0)) {
+      close(fd);
+      return;
+    }
+  }
+
+  void *mapping = mmap(nullptr, sizeof(uint64_t), writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping != MAP_FAILED) {
+    counter_ = static_cast<::std::atomic<uint64_t>*>(mapping);
+  }
+}
+
+ConfigGeneration::~ConfigGeneration() {
+  if (counter_ != nullptr) {
+    munmap(counter_, sizeof(uint64_t));
+  }
+}
+
+bool ConfigGeneration::IsAvailable() const {
+  return counter_ != nullptr;
+}
+
+uint64_t ConfigGeneration::Get() const {
+  return counter_ != nullptr ? counter_->load(::std::memory_order_acquire) : 0;
+}
+
+void ConfigGeneration::Increment() {
+  if (counter_ != nullptr) {
+    counter_->fetch_add(1, ::std::memory_order_acq_rel);
+  }
+}
+
+}  // namespace netconf
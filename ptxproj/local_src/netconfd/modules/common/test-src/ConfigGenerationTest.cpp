@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CommonTestDependencies.hpp"
+#include "ConfigGeneration.hpp"
+
+namespace netconf {
+
+static constexpr auto test_generation_name = "netconfd.generation.test";
+
+class ConfigGenerationTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    shm_unlink((::std::string { "/" } + test_generation_name).c_str());
+  }
+  void TearDown() override {
+    shm_unlink((::std::string { "/" } + test_generation_name).c_str());
+  }
+};
+
+TEST_F(ConfigGenerationTest, ReaderWithoutWriterIsNotAvailable) {
+  ConfigGeneration reader { ConfigGeneration::Access::ReadOnly, test_generation_name };
+
+  EXPECT_FALSE(reader.IsAvailable());
+  EXPECT_EQ(0, reader.Get());
+}
+
+TEST_F(ConfigGenerationTest, ReaderSeesIncrementsOfWriter) {
+  ConfigGeneration writer { ConfigGeneration::Access::ReadWrite, test_generation_name };
+  ConfigGeneration reader { ConfigGeneration::Access::ReadOnly, test_generation_name };
+
+  ASSERT_TRUE(writer.IsAvailable());
+  ASSERT_TRUE(reader.IsAvailable());
+
+  auto start = reader.Get();
+  writer.Increment();
+  EXPECT_EQ(start + 1, reader.Get());
+  writer.Increment();
+  EXPECT_EQ(start + 2, reader.Get());
+}
+
+TEST_F(ConfigGenerationTest, CounterSurvivesWriterRestart) {
+  {
+    ConfigGeneration writer { ConfigGeneration::Access::ReadWrite, test_generation_name };
+    writer.Increment();
+    writer.Increment();
+  }
+  ConfigGeneration writer { ConfigGeneration::Access::ReadWrite, test_generation_name };
+  EXPECT_EQ(2, writer.Get());
+}
+
+TEST_F(ConfigGenerationTest, CounterIsReadableByOthersDespiteUmask) {
+  auto mask = umask(0077);
+  ConfigGeneration writer { ConfigGeneration::Access::ReadWrite, test_generation_name };
+  auto mask_while_created = umask(mask);
+
+  EXPECT_EQ(0077, mask_while_created);
+  int fd = shm_open((::std::string { "/" } + test_generation_name).c_str(), O_RDONLY, 0);
+  ASSERT_LE(0, fd);
+  struct stat file_info { };
+  ASSERT_EQ(0, fstat(fd, &file_info));
+  close(fd);
+  EXPECT_EQ(0644, file_info.st_mode & 0777);
+}
+
+}  // namespace netconf
@@ -126,7 +126,7 @@ $(libnetconfd.a_INCLUDES) \
 
 
 netconfd_tests.elf_STATICALLYLINKED += netconfd common utility gmock_main gmock gtest
-netconfd_tests.elf_LIBS += netconfd common utility gmock_main gmock gtest boost_log boost_thread boost_system boost_filesystem boost_serialization
+netconfd_tests.elf_LIBS += netconfd common utility gmock_main gmock gtest boost_log boost_thread boost_system boost_filesystem boost_serialization rt
 netconfd_tests.elf_PKG_CONFIGS += $(libnetconfd.a_PKG_CONFIGS)
 netconfd_tests.elf_PKG_CONFIG_LIBS += $(libnetconfd.a_PKG_CONFIG_LIBS)
 netconfd_tests.elf_DISABLEDWARNINGS += packed inline
@@ -9,6 +9,7 @@
 #include <sstream>
 
 #include "CommandExecutor.hpp"
+#include "FileEditor.hpp"
 #include "Logger.hpp"
 #include "MacAddress.hpp"
 
@@ -28,21 +29,29 @@ namespace {
     mac_stream << "02:30:DE:" << std::hex << dis(gen) << ":" << dis(gen) << ":" << dis(gen);
     return mac_stream.str();
   }
+
+  /* A cached ini is used only if it has the values that have no fallback from the device. */
+  bool HasTypeLabelValues(const ::std::string& type_label_ini) {
+    try {
+      ptree type_label_values;
+      ::std::istringstream type_label_stringstream(type_label_ini);
+      boost::property_tree::read_ini(type_label_stringstream, type_label_values);
+
+      auto mac = type_label_values.get_optional<::std::string>("MAC");
+      return type_label_values.get_optional<::std::string>("ORDER") && mac && MacAddress::FromString(mac.value()).IsValid();
+    } catch (std::exception&) {
+      return false;
+    }
+  }
 }
 
-DeviceTypeLabel::DeviceTypeLabel(CommandExecutor& command_executer) :
+DeviceTypeLabel::DeviceTypeLabel(CommandExecutor& command_executer, const ::std::string& cache_file_path) :
   command_executer_{command_executer},
   order_number_{"wago-pfc"},
   mac_{MacAddress::FromString(CreateRandomMac())},
   mac_count_{1} {
 
-  ::std::string type_label_ini;
-  Status status = command_executer_.Execute("/etc/config-tools/get_typelabel_value -a", type_label_ini);
-
-
-  if (status.IsNotOk()) {
-    LogError("Failed to extract typelabel values! Taking fallback values."s);
-  }
+  ::std::string type_label_ini = ReadTypeLabelIni(cache_file_path);
 
   try {
     ptree type_label_values;
@@ -82,6 +91,34 @@ DeviceTypeLabel::DeviceTypeLabel(CommandExecutor& command_executer) :
   }
 }
 
+::std::string DeviceTypeLabel::ReadTypeLabelIni(const ::std::string& cache_file_path) const {
+  FileEditor file_editor;
+  ::std::string type_label_ini;
+
+  if (not cache_file_path.empty() && file_editor.Read(cache_file_path, type_label_ini).IsOk()) {
+    if (HasTypeLabelValues(type_label_ini)) {
+      LOG_DEBUG("DeviceTypeLabel: read typelabel values from " + cache_file_path);
+      return type_label_ini;
+    }
+    LogWarning("DeviceTypeLabel: ignoring invalid typelabel cache " + cache_file_path);
+    type_label_ini.clear();
+  }
+
+  Status status = command_executer_.Execute("/etc/config-tools/get_typelabel_value -a", type_label_ini);
+  if (status.IsNotOk()) {
+    LogError("Failed to extract typelabel values! Taking fallback values."s);
+    return type_label_ini;
+  }
+
+  if (not cache_file_path.empty() && HasTypeLabelValues(type_label_ini)) {
+    status = file_editor.WriteAndReplace(cache_file_path, type_label_ini);
+    if (status.IsNotOk()) {
+      LogWarning("DeviceTypeLabel: failed to cache typelabel values in " + cache_file_path);
+    }
+  }
+  return type_label_ini;
+}
+
 ::std::string DeviceTypeLabel::GetOrderNumber() const {
   return order_number_;
 }
@@ -10,7 +10,12 @@ namespace netconf {
 
 class DeviceTypeLabel : public IDeviceTypeLabel {
  public:
-  explicit DeviceTypeLabel(CommandExecutor& command_executer);
+  /*
+   * The type label values are static, they are read once and kept in the cache file (if given) so that a restarted
+   * netconfd does not need to execute get_typelabel_value again. A cache without order number or valid MAC is
+   * replaced by the values of the device.
+   */
+  explicit DeviceTypeLabel(CommandExecutor& command_executer, const ::std::string& cache_file_path = "");
   ~DeviceTypeLabel() override = default;
 
   DeviceTypeLabel(const DeviceTypeLabel&) = delete;
@@ -24,6 +29,7 @@ class DeviceTypeLabel : public IDeviceTypeLabel {
   uint32_t GetMacCount() const override;
 
  private:
+  ::std::string ReadTypeLabelIni(const ::std::string& cache_file_path) const;
 
   CommandExecutor& command_executer_;
 
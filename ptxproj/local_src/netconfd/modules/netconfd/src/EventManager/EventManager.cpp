@@ -6,10 +6,10 @@
 #include <glib.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <chrono>
 #include <string>
-#include <thread>
 
 #include "CommandExecutor.hpp"
 #include "FileOperations.hpp"
@@ -22,7 +22,9 @@ namespace bfs = boost::filesystem;
 using namespace std::literals;
 #define IPV4_CHANGE_DIR "/var/run/ipv4"
 
-static constexpr int wait_for_events_timeout_millis = 500;
+static constexpr auto wait_for_events_timeout = 500ms;
+static constexpr auto max_event_latency       = 2000ms;
+static constexpr auto settle_timeout          = 50ms;
 
 namespace {
 
@@ -32,65 +34,137 @@ namespace {
   return c;
 }
 
+int SetElapsed(void *user) {
+  *reinterpret_cast<bool *>(user) = true;  // NOLINT: Need reinterpret_cast to cast from void*.
+  return 0;
+}
+
+/*
+ * Dispatch the gmainloop for the given time instead of sleeping in it, events arriving meanwhile are handled at once.
+ */
+void IterateMainLoopFor(::std::chrono::milliseconds duration) {
+  bool elapsed = false;
+  g_timeout_add_full(G_PRIORITY_HIGH, static_cast<guint>(duration.count()), &SetElapsed, &elapsed, nullptr);
+  while (!elapsed) {
+    g_main_context_iteration(nullptr, TRUE);
+  }
+}
+
 }  // namespace
 
-EventManager::EventManager() : trigger_event_folder_{false} {
+EventManager::EventManager() : EventManager(IPV4_CHANGE_DIR) {
+}
+
+EventManager::EventManager(::std::string ip_change_dir) : ip_change_dir_{::std::move(ip_change_dir)} {
   static_assert(sizeof(guint) == sizeof(debounce_events_gtimeout_id_));
 }
 
+EventManager::~EventManager() {
+  if (debounce_events_gtimeout_id_ != 0) {
+    g_source_remove(debounce_events_gtimeout_id_);
+  }
+}
+
 void EventManager::ProcessPendingEvents() {
   LOG_DEBUG("EventManager: process pendig events if queued in gmainloop (START");
 
   /*
-  * Pending events were previously queued into the gmain loop as a gtask.
-  * We prefer this task in the processing to ensure that the event folder has been called before a dbus call returned.
-  * g_main_context_iteration processes all tasks currently pending in the gmainloop
+   * Pending events were previously queued into the gmain loop as a gtask.
+   * We prefer this task in the processing to ensure that the event folder has been called before a dbus call returned.
    *
    * Pending tasks (e.g. Netlink address change) are given priority in order to see
-   * whether they lead to an event folder call.
+   * whether they lead to an event folder call. The gmainloop is dispatched until no further event arrived
+   * within the settle timeout, then the merged events are published without waiting for the debounce timeout.
    */
+  auto settle_end = Clock::now() + wait_for_events_timeout;
+  uint64_t events_seen;
+  do {
+    events_seen = events_received_;
+    IterateMainLoopFor(settle_timeout);
+  } while (events_seen != events_received_ && Clock::now() < settle_end);
 
-  // process pending netlink events, or wait in hope to receive any
-  if (g_main_context_iteration(nullptr, FALSE) == 0 || debounce_events_gtimeout_id_ == 0) {
-    ::std::this_thread::sleep_for(::std::chrono::milliseconds(50));
-    g_main_context_iteration(nullptr, FALSE);
+  if (debounce_events_gtimeout_id_ != 0) {
+    g_source_remove(debounce_events_gtimeout_id_);
+    debounce_events_gtimeout_id_ = 0;
+    PublishNetworkChangesToSystem();
   }
 
-  // at least one event received, now we wait for the debounce timeout to elapse
-  while (debounce_events_gtimeout_id_ != 0) {
-    g_main_context_iteration(nullptr, TRUE);
+  LOG_DEBUG("EventManager: process pendig events if queued in gmainloop (FINISH");
+}
+
+bool EventManager::IsEventFolderRequired(const NetworkState &state) {
+  if (event_folder_forced_) {
+    return true;
+  }
+  if (event_folder_interfaces_pending_.empty()) {
+    return false;
   }
 
-  LOG_DEBUG("EventManager: process pendig events if queued in gmainloop (FINISH");
+  // Only the state of ports is part of the snapshot, events of other interfaces are always published.
+  InterfaceConfigs port_configs;
+  if (interface_information_ != nullptr) {
+    port_configs = interface_information_->GetPortConfigs();
+  }
+  for (auto &interface : event_folder_interfaces_pending_) {
+    auto is_port = ::std::any_of(port_configs.begin(), port_configs.end(),
+                                 [&](const InterfaceConfig &config) { return config.interface_ == interface; });
+    if (not is_port) {
+      return true;
+    }
+  }
+  return state != published_state_;
 }
 
 void EventManager::PublishNetworkChangesToSystem() {
   UpdateIpChangeFiles();
-  if (trigger_event_folder_) {
-    CallEventFolderSync();
+  if (event_folder_forced_ || !event_folder_interfaces_pending_.empty()) {
+    auto state = GetNetworkState();
+    if (IsEventFolderRequired(state)) {
+      CallEventFolderSync(state, event_folder_interfaces_pending_);
+      published_state_ = ::std::move(state);
+    } else {
+      LOG_DEBUG("EventManager: skip event folder, network state did not change");
+    }
   }
-  trigger_event_folder_ = false;
+  event_folder_forced_ = false;
+  event_folder_interfaces_pending_.clear();
 }
 
 int EventManager::ProcessEvents(void *user) {
   EventManager *em = reinterpret_cast<EventManager *>(user);  // NOLINT: Need reinterpret_cast to cast from void*.
+  auto now         = Clock::now();
+  auto deadline    = ::std::min(em->last_pending_event_ + wait_for_events_timeout,
+                                em->first_pending_event_ + max_event_latency);
+  if (now < deadline) {
+    em->ScheduleProcessEvents(deadline);
+    return 0;
+  }
   em->debounce_events_gtimeout_id_ = 0;
   em->PublishNetworkChangesToSystem();
   return 0;  // The function added with g_timeout_add is called repeatedly until it returns 0
 }
 
+void EventManager::ScheduleProcessEvents(Clock::time_point deadline) {
+  auto timeout = ::std::chrono::ceil<::std::chrono::milliseconds>(deadline - Clock::now());
+  debounce_events_gtimeout_id_ = g_timeout_add_full(G_PRIORITY_HIGH, static_cast<guint>(::std::max(timeout, 0ms).count()),
+                                                    &EventManager::ProcessEvents, this, nullptr);
+}
+
 void EventManager::DeferProcessEvents() {
   /*
    * Here we are implementing a debouncing mechanism.
    * The event folder call is not executed directly for every event, but only after the timeout has expired.
-   * During this time, events are combined and timeout is reset.
+   * During this time, events are combined and the timeout is extended, but no longer than max_event_latency after the
+   * first event so that a storm of events (e.g. flapping links on many ports) is still published in time.
+   * The running timeout is not replaced on every event, it reschedules itself when it fires too early.
    */
-  if (debounce_events_gtimeout_id_ != 0) {
-    g_source_remove(debounce_events_gtimeout_id_);
+  auto now            = Clock::now();
+  last_pending_event_ = now;
+  events_received_++;
+  if (debounce_events_gtimeout_id_ == 0) {
+    first_pending_event_ = now;
+    ScheduleProcessEvents(now + wait_for_events_timeout);
   }
-
-  debounce_events_gtimeout_id_ =
-      g_timeout_add_full(G_PRIORITY_HIGH, wait_for_events_timeout_millis, &EventManager::ProcessEvents, this, nullptr);
 }
 
 void EventManager::NotifyNetworkChanges(EventLayer event_layer) {
@@ -101,13 +175,17 @@ void EventManager::NotifyNetworkChanges(EventLayer event_layer, ::std::optional<
   switch (event_layer) {
     case EventLayer::EVENT_FOLDER:
       LOG_DEBUG("EventManager: queueing event (EVENT_FOLDER");
-      trigger_event_folder_ = true;
+      if (interface.has_value()) {
+        event_folder_interfaces_pending_.emplace(::std::move(interface.value()));
+      } else {
+        event_folder_forced_ = true;
+      }
       break;
 
       case EventLayer::IP_CHANGE_FILES:
       if (interface.has_value()) {
         LOG_DEBUG("EventManager: queueing event (IP_CHANGE_FILES");
-        ip_interface_update_pending_.emplace(interface.value());
+        ip_interface_update_pending_.emplace(::std::move(interface.value()));
       }
       break;
   }
@@ -121,9 +199,9 @@ void EventManager::RegisterNetworkInformation(IPersistenceProvider &persistence_
   ip_information_        = &ip_information;
   interface_information_ = &interface_information;
 
-  bool dir_exists = bfs::exists(IPV4_CHANGE_DIR) || bfs::create_directory(IPV4_CHANGE_DIR);
+  bool dir_exists = bfs::exists(ip_change_dir_) || bfs::create_directory(ip_change_dir_);
   if (dir_exists) {
-    bfs::permissions(IPV4_CHANGE_DIR,
+    bfs::permissions(ip_change_dir_,
                      bfs::owner_all | bfs::group_read | bfs::group_exe | bfs::others_read | bfs::others_exe);
 
     auto port_devs = netdev_manager.GetNetDevs({DeviceType::Port});
@@ -173,17 +251,23 @@ void EventManager::RegisterNetworkInformation(IPersistenceProvider &persistence_
   return StringToCharVector(JsonConverter().ToJsonString(interface_statuses));
 }
 
-void EventManager::CallEventFolderSync() {
-  auto bridge_config    = GetBridgeConfigAsJson();
-  auto ip_config        = GetIPConfigAsJson();
-  auto interface_config = GetInterfaceConfigAsJson();
-  auto interface_statuses = GetInterfaceStatusesAsJson();
+EventManager::NetworkState EventManager::GetNetworkState() {
+  return NetworkState{GetBridgeConfigAsJson(), GetIPConfigAsJson(), GetInterfaceConfigAsJson(),
+                      GetInterfaceStatusesAsJson()};
+}
+
+void EventManager::CallEventFolderSync(NetworkState &state, const ::std::set<Interface> &changed_interfaces) {
+  ::std::string changed;
+  for (auto &interface : changed_interfaces) {
+    changed.append(changed.empty() ? "" : ",").append(interface.GetName());
+  }
 
   gchar *argv[]         = {"/usr/bin/run-parts", "-a", "config", "/etc/config-tools/events/networking", nullptr};
-  g_setenv("NETCONF_BRIDGE_CONFIG", &bridge_config[0], static_cast<gboolean>(true));
-  g_setenv("NETCONF_IP_CONFIG", &ip_config[0], static_cast<gboolean>(true));
-  g_setenv("NETCONF_INTERFACE_CONFIG", &interface_config[0], static_cast<gboolean>(true));
-  g_setenv("NETCONF_INTERFACE_STATUSES", &interface_statuses[0], static_cast<gboolean>(true));
+  g_setenv("NETCONF_BRIDGE_CONFIG", &state.bridge_config[0], static_cast<gboolean>(true));
+  g_setenv("NETCONF_IP_CONFIG", &state.ip_config[0], static_cast<gboolean>(true));
+  g_setenv("NETCONF_INTERFACE_CONFIG", &state.interface_config[0], static_cast<gboolean>(true));
+  g_setenv("NETCONF_INTERFACE_STATUSES", &state.interface_statuses[0], static_cast<gboolean>(true));
+  g_setenv("NETCONF_CHANGED_INTERFACES", changed.c_str(), static_cast<gboolean>(true));
   gint exit_status = 0;
   GError *error    = nullptr;
   if (g_spawn_sync(nullptr, static_cast<gchar **>(argv), nullptr, G_SPAWN_DEFAULT, nullptr, nullptr, nullptr, nullptr,
@@ -198,7 +282,7 @@ void EventManager::CallEventFolderSync() {
 
 void EventManager::UpdateIpChangeFiles() {
   for (auto &interface : ip_interface_update_pending_) {
-    ::std::string file = IPV4_CHANGE_DIR "/ipconchg-" + interface.GetName();
+    ::std::string file = ip_change_dir_ + "/ipconchg-" + interface.GetName();
 
     TouchFile(file);
     LOG_DEBUG("EventManager: called update ip change file: " + file);
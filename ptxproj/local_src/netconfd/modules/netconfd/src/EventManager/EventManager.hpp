@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <chrono>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "IPersistenceProvider.hpp"
@@ -16,7 +18,8 @@ namespace netconf {
 class EventManager : public IEventManager {
  public:
   EventManager();
-  ~EventManager() override = default;
+  explicit EventManager(::std::string ip_change_dir);
+  ~EventManager() override;
 
   EventManager(const EventManager &) = delete;
   EventManager &operator=(const EventManager &) = delete;
@@ -31,23 +34,59 @@ class EventManager : public IEventManager {
   void RegisterNetworkInformation(IPersistenceProvider &persistence_provider, IIPInformation &ip_information,
                                   IInterfaceInformation &interface_information, INetDevManager &netdev_manager);
 
+ protected:
+  /*
+   * Snapshot of what the event folder scripts get to see. A link event whose interfaces end up in the
+   * state they were published with (e.g. a flapping port) does not call the event folder again.
+   */
+  struct NetworkState {
+    ::std::vector<char> bridge_config;
+    ::std::vector<char> ip_config;
+    ::std::vector<char> interface_config;
+    ::std::vector<char> interface_statuses;
+
+    bool operator==(const NetworkState &other) const {
+      return bridge_config == other.bridge_config && ip_config == other.ip_config &&
+             interface_config == other.interface_config && interface_statuses == other.interface_statuses;
+    }
+    bool operator!=(const NetworkState &other) const {
+      return !(*this == other);
+    }
+  };
+
+  virtual void CallEventFolderSync(NetworkState &state, const ::std::set<Interface> &changed_interfaces);
+
  private:
+  using Clock = ::std::chrono::steady_clock;
+
   IPersistenceProvider* persistence_provider_   = nullptr;
   IIPInformation *ip_information_               = nullptr;
   IInterfaceInformation *interface_information_ = nullptr;
 
-  bool trigger_event_folder_;
+  ::std::string ip_change_dir_;
+
+  /* Pending events, merged per interface until they are published. */
+  bool event_folder_forced_ = false;
+  ::std::set<Interface> event_folder_interfaces_pending_;
   ::std::set<Interface> ip_interface_update_pending_;
+  uint64_t events_received_ = 0;
+
+  NetworkState published_state_;
 
   uint32_t debounce_events_gtimeout_id_ = 0;
+  Clock::time_point first_pending_event_;
+  Clock::time_point last_pending_event_;
 
-  void CallEventFolderSync();
   void UpdateIpChangeFiles();
   void DeferProcessEvents();
+  void ScheduleProcessEvents(Clock::time_point now);
+  bool IsEventFolderRequired(const NetworkState &state);
   void PublishNetworkChangesToSystem();
 
   static int ProcessEvents(void *user);
 
+  NetworkState GetNetworkState();
+
   ::std::vector<char> GetBridgeConfigAsJson();
   ::std::vector<char> GetIPConfigAsJson();
   ::std::vector<char> GetInterfaceConfigAsJson();
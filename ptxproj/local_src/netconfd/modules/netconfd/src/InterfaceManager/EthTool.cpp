@@ -180,17 +180,16 @@ Status EthTool::Update(EthToolSettings &ets) {
   }
   ets.if_link_state_ = static_cast<eth::InterfaceLinkState>(eth_value.data);
 
+  return UpdateLinkSettings(ets);
+}
+
+Status EthTool::UpdateLinkSettings(EthToolSettings &ets) {
   DetermineLinkModeMasksNwords();
   ets.e_.s_.link_mode_masks_nwords = static_cast<__s8>(link_mode_masks_nwords_);
   ets.e_.s_.cmd                    = ETHTOOL_GLINKSETTINGS;
   ifreq_.ifr_data                  = &ets.e_.s_;  // NOLINT(cppcoreguidelines-pro-type-union-access) must access union
 
-  s = EthToolIoctl();
-  if (s.IsNotOk()) {
-    return s;
-  }
-
-  return s;
+  return EthToolIoctl();
 }
 
 bool EthTool::SetRequestHasChanges(const EthToolSettings &getdata, const EthToolSettings &setdata) {
@@ -118,6 +118,7 @@ class EthTool {
   EthToolSettings Create();
 
   Status Update(EthToolSettings &s);
+  Status UpdateLinkSettings(EthToolSettings &s);
   Status Commit(EthToolSettings &s);
 
   bool SupportsLinkSettings() {
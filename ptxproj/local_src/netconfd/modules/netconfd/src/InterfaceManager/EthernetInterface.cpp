@@ -97,6 +97,10 @@ Status EthernetInterface::UpdateConfig() {
   return s;
 }
 
+Status EthernetInterface::UpdateLinkSettings() {
+  return ethtool_.UpdateLinkSettings(ethtool_settings_r_);
+}
+
 ::std::uint32_t EthernetInterface::GetSpeed() const {
   return ethtool_settings_r_.GetSpeed();
 }
@@ -22,6 +22,7 @@ class EthernetInterface : public IEthernetInterface {
   EthernetInterface& operator=(EthernetInterface&& other) = delete;
 
   Status UpdateConfig() override;
+  Status UpdateLinkSettings() override;
   MacAddress GetMac() const override;
   bool GetAutonegSupport() const override;
   bool GetAutonegEnabled() const override;
@@ -21,6 +21,8 @@ class IEthernetInterface {
   IEthernetInterface& operator=(IEthernetInterface &&other) = delete;
 
   virtual Status UpdateConfig() = 0;
+  /* Updates only the ethtool link settings (speed, duplex, autoneg, link modes), not state, link state, MAC and MTU. */
+  virtual Status UpdateLinkSettings() = 0;
   virtual MacAddress GetMac() const = 0;
   virtual bool GetAutonegSupport() const = 0;
   virtual bool GetAutonegEnabled() const = 0;
@@ -90,25 +90,36 @@ static LinkState EthLinkStateToLinkState(eth::InterfaceLinkState state) {
 }
 
 Status InterfaceConfigManager::GetCurrentPortStatuses(InterfaceStatuses& itf_statuses) {
+  /*
+   * State, link state and MAC are taken from the netdevs, which are kept up to date by the netlink link cache.
+   * Only the link settings (speed, duplex) are queried per port, the mac learning of all ports at once.
+   */
+  auto mac_learnings = GetMacLearnings();
   for (auto& [itf, eth_itf] : ethernet_interfaces_) {
     InterfaceStatus itf_status{itf};
 
-    Status s = eth_itf->UpdateConfig();
+    auto netdev = netdev_manager_.GetByInterface(itf);
+    Status s = netdev ? eth_itf->UpdateLinkSettings() : eth_itf->UpdateConfig();
     if(s.IsNotOk()){
       return s;
     }
-    auto state = eth_itf->GetState();
-    itf_status.state_ = EthDeviceStateToInterfaceState(state);
+
+    if (netdev) {
+      auto is_up = (netdev->GetLinkInfo().flags_ & IFF_UP) == IFF_UP;
+      itf_status.state_ = is_up ? InterfaceState::UP : InterfaceState::DOWN;
+      itf_status.link_state_ = (is_up && netdev->IsLinkStateUp()) ? LinkState::UP : LinkState::DOWN;
+      itf_status.mac_ = netdev->GetMac();
+    } else {
+      itf_status.state_ = EthDeviceStateToInterfaceState(eth_itf->GetState());
+      itf_status.link_state_ = EthLinkStateToLinkState(eth_itf->GetLinkState());
+      itf_status.mac_ = eth_itf->GetMac();
+    }
 
     itf_status.duplex_ = static_cast<Duplex>(eth_itf->GetDuplex());
     itf_status.speed_ = static_cast<::std::int32_t>(eth_itf->GetSpeed());
 
-    auto link_state = eth_itf->GetLinkState();
-    itf_status.link_state_ = EthLinkStateToLinkState(link_state);
-
-    itf_status.mac_ = eth_itf->GetMac();
-
-    itf_status.mac_learning_ = GetMacLearning(eth_itf->GetInterfaceIndex());
+    auto learning = mac_learnings.find(eth_itf->GetInterfaceIndex());
+    itf_status.mac_learning_ = (learning != mac_learnings.end()) ? learning->second : MacLearning::UNKNOWN;
 
     itf_statuses.emplace_back(itf_status);
 
@@ -121,7 +132,7 @@ InterfaceInformation InterfaceConfigManager::GetInterfaceInformation(const NetDe
   auto device_type = netdev.GetDeviceType();
   if (device_type == DeviceType::Port && ethernet_interfaces_.count(netdev.GetInterface()) != 0) {
     auto &eif = ethernet_interfaces_.at(netdev.GetInterface());
-    Status s = eif->UpdateConfig();
+    Status s = eif->UpdateLinkSettings();
     if(s.IsOk()){
       return InterfaceInformation{ netdev.GetInterface(), not IsIpAddressable(device_type),
         eif->GetAutonegSupport() ? AutonegotiationSupported::YES : AutonegotiationSupported::NO, ToLinkModes(
@@ -78,7 +78,8 @@ NetDevManager::NetDevManager(::std::shared_ptr<IInterfaceMonitor> interface_moni
     : interface_monitor_{::std::move(interface_monitor)},
       netdev_construction_{nullptr},
       netlink_{netlink},
-      event_manager_{event_manager} {
+      event_manager_{event_manager},
+      config_generation_{ConfigGeneration::Access::ReadWrite} {
 
   netlink_.SetInterfaceUp("eth0");
 
@@ -406,6 +407,10 @@ void NetDevManager::LinkChange(LinkInfo new_link, InterfaceEventAction action) {
   if (netdev && (action == InterfaceEventAction::NEW || action == InterfaceEventAction::DEL || action == InterfaceEventAction::CHANGE)) {
     event_manager_.NotifyNetworkChanges(EventLayer::EVENT_FOLDER, netdev->GetInterface());
   }
+
+  if (netdev && (action == InterfaceEventAction::NEW || action == InterfaceEventAction::DEL)) {
+    config_generation_.Increment();
+  }
 }
 
 void NetDevManager::RegisterForNetDevConstructionEvents(INetDevEvents &netdev_construction) {
@@ -6,6 +6,7 @@
 #include <memory>
 #include <vector>
 
+#include "ConfigGeneration.hpp"
 #include "IDeviceTypeLabel.hpp"
 #include "IEventManager.hpp"
 #include "IInterfaceMonitor.hpp"
@@ -65,6 +66,8 @@ class NetDevManager : public INetDevManager, public IInterfaceEvent {
   INetDevEvents *netdev_construction_;
   INetlinkLink &netlink_;
   IEventManager &event_manager_;
+  // Clients cache the interface list, a netdev added or removed by the kernel invalidates it
+  ConfigGeneration config_generation_;
 };
 
 }  // namespace netconf
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "BridgeManager.hpp"
+#include "ConfigGeneration.hpp"
 #include "DBusHandlerRegistry.h"
 #include "DipSwitch.hpp"
 #include "DynamicIPClientAdministrator.hpp"
@@ -84,6 +85,9 @@ class NetworkConfiguratorImpl {
   IPManager ip_manager_;
   NetworkConfigBrain network_config_brain_;
 
+  // Changes that are not persisted bump the generation here, persisted ones in the persistence provider
+  ConfigGeneration config_generation_ { ConfigGeneration::Access::ReadWrite };
+
   dbus::Server dbus_server_;
   dbus::DBusHandlerRegistry dbus_handler_registry_;
   ::UriEscape uri_escape_;
@@ -93,7 +97,7 @@ NetworkConfiguratorImpl::NetworkConfiguratorImpl(InterprocessCondition &start_co
                                                  StartWithPortstate startWithPortState)
     : interface_monitor_ { static_cast<::std::shared_ptr<IInterfaceMonitor>>(netlink_monitor_.Add<NetlinkLinkCache>()) },
       ip_monitor_ { static_cast<::std::shared_ptr<IIPMonitor>>(netlink_monitor_.Add<NetlinkAddressCache>()) },
-      device_type_label_ { command_executer_ },
+      device_type_label_ { command_executer_, "/var/run/netconfd_typelabel.ini" },
       netdev_manager_ { interface_monitor_, event_manager_, netlink_link_},
       mac_distributor_ { device_type_label_.GetMac(), device_type_label_.GetMacCount(), netdev_manager_ },
       ip_dip_switch_ { DEV_DIP_SWITCH_VALUE },
@@ -191,7 +195,9 @@ NetworkConfiguratorImpl::NetworkConfiguratorImpl(InterprocessCondition &start_co
 
   dbus_handler_registry_.RegisterTempFixIpHandler([this]() -> ::std::string {
     LOG_DEBUG("DBUS Req: SetTemporaryFixIp");
-    return this->network_config_brain_.SetTemporaryFixIp();
+    auto status = this->network_config_brain_.SetTemporaryFixIp();
+    this->config_generation_.Increment();
+    return status;
   });
 
   dbus_handler_registry_.RegisterGetDipSwitchConfigHandler([this](std::string &data) -> std::string {
@@ -210,12 +216,14 @@ NetworkConfiguratorImpl::NetworkConfiguratorImpl(InterprocessCondition &start_co
   dbus_handler_registry_.RegisterDynamicIPEventHandler([this](std::string data) {
     LOG_DEBUG("DBUS Req: ReceiveDynamicIPEvent" + data);
     auto status = this->network_config_brain_.ReceiveDynamicIPEvent(data);
+    this->config_generation_.Increment();
     return status;
   });
 
   dbus_handler_registry_.RegisterReloadHostConfEventHandler([this]() {
     LOG_DEBUG("DBUS Req: RegisterReloadHostConfEventHandler");
     auto status = this->network_config_brain_.ReceiveReloadHostConfEvent();
+    this->config_generation_.Increment();
     return status;
   });
 
@@ -236,6 +244,8 @@ NetworkConfiguratorImpl::NetworkConfiguratorImpl(InterprocessCondition &start_co
   start_condition.Notify();
 
   network_config_brain_.Start(startWithPortState);
+  // Invalidate data cached by clients of a previous netconfd instance
+  config_generation_.Increment();
   LogInfo("NetworkConfigurator ready");
 }
 
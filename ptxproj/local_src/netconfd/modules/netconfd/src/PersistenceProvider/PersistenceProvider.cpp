@@ -10,11 +10,19 @@ PersistenceProvider::PersistenceProvider(const ::std::string &persistence_path,
                                          uint32_t device_port_count)
     : backup_restore_ { file_editor_, 75 },
       restore_legacy_ { file_editor_, device_port_count },
-      persistence_executor_ { persistence_path, file_editor_, backup_restore_, restore_legacy_, dip_switch } {
+      persistence_executor_ { persistence_path, file_editor_, backup_restore_, restore_legacy_, dip_switch },
+      config_generation_ { ConfigGeneration::Access::ReadWrite } {
+}
+
+Status PersistenceProvider::Changed(Status status) {
+  if (status.IsOk()) {
+    config_generation_.Increment();
+  }
+  return status;
 }
 
 Status PersistenceProvider::Write(const BridgeConfig &config) {
-  return persistence_executor_.Write(config);
+  return Changed(persistence_executor_.Write(config));
 }
 
 Status PersistenceProvider::Read(BridgeConfig &config) {
@@ -22,7 +30,7 @@ Status PersistenceProvider::Read(BridgeConfig &config) {
 }
 
 Status PersistenceProvider::Write(const IPConfigs &configs) {
-  return persistence_executor_.Write(configs);
+  return Changed(persistence_executor_.Write(configs));
 }
 
 Status PersistenceProvider::Read(IPConfigs &configs) {
@@ -42,7 +50,7 @@ Status PersistenceProvider::Backup(const std::string &file_path, const std::stri
 Status PersistenceProvider::Restore(const ::std::string &file_path, BridgeConfig &bridge_config, IPConfigs &ip_configs,
                                     InterfaceConfigs &interface_configs, DipSwitchIpConfig &dip_switch_config,
                                     Interfaces &interfaces) {
-  return persistence_executor_.Restore(file_path, bridge_config, ip_configs, interface_configs, dip_switch_config, interfaces);
+  return Changed(persistence_executor_.Restore(file_path, bridge_config, ip_configs, interface_configs, dip_switch_config, interfaces));
 }
 
 uint32_t PersistenceProvider::GetBackupParameterCount() const {
@@ -54,7 +62,7 @@ Status PersistenceProvider::Read(InterfaceConfigs &port_configs) {
 }
 
 Status PersistenceProvider::Write(const InterfaceConfigs &port_configs) {
-  return persistence_executor_.Write(port_configs);
+  return Changed(persistence_executor_.Write(port_configs));
 }
 
 Status PersistenceProvider::Read(DipSwitchIpConfig &config) {
@@ -62,11 +70,11 @@ Status PersistenceProvider::Read(DipSwitchIpConfig &config) {
 }
 
 Status PersistenceProvider::Write(const DipSwitchIpConfig &config) {
-  return persistence_executor_.Write(config);
+  return Changed(persistence_executor_.Write(config));
 }
 
 Status PersistenceProvider::Write(const Interfaces &config) {
-  return persistence_executor_.Write(config);
+  return Changed(persistence_executor_.Write(config));
 }
 void PersistenceProvider::Read(Interfaces &config) {
   persistence_executor_.Read(config);
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ConfigGeneration.hpp"
 #include "FileEditor.hpp"
 #include "BackupRestore.hpp"
 #include "DipSwitch.hpp"
@@ -54,7 +55,9 @@ class PersistenceProvider : public IPersistenceProvider, public IPersistence<Int
   BackupRestore backup_restore_;
   RestoreLegacy restore_legacy_;
   PersistenceExecutor persistence_executor_;
+  ConfigGeneration config_generation_;
 
+  Status Changed(Status status);
 };
 
 } /* namespace netconf */
@@ -19,6 +19,8 @@ class MockIEthernetInterface : public IEthernetInterface {
  public:
   MOCK_METHOD0(UpdateConfig,
       Status());
+  MOCK_METHOD0(UpdateLinkSettings,
+      Status());
   MOCK_CONST_METHOD0(GetMac,
       MacAddress());
   MOCK_CONST_METHOD0(GetAutonegSupport,
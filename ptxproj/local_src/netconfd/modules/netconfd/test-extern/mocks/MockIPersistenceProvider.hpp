@@ -15,10 +15,12 @@ class MockIPersistenceProvider : public IPersistenceProvider {
   ;MOCK_METHOD1(Read, Status(IPConfigs &configs) )
   ;MOCK_METHOD1(Write, Status(const DipSwitchIpConfig &config) )
   ;MOCK_METHOD1(Read, Status(DipSwitchIpConfig &config) )
-  ;MOCK_METHOD2(Read, Status(BridgeConfig &config, IPConfigs &configs) )
+  ;MOCK_METHOD1(Write, Status(const Interfaces &config) )
+  ;MOCK_METHOD1(Read, void(Interfaces &config) )
+  ;MOCK_METHOD3(Read, Status(BridgeConfig &config, IPConfigs &configs, Interfaces &interfaces) )
   ;MOCK_METHOD2(Backup, Status(const std::string &file_path, const std::string &targetversion) )
-  ;MOCK_METHOD5(Restore, Status(const ::std::string &file_path, BridgeConfig &bridge_config, IPConfigs &ip_configs,
-          InterfaceConfigs &interface_configs, DipSwitchIpConfig &dip_switch_config) )
+  ;MOCK_METHOD6(Restore, Status(const ::std::string &file_path, BridgeConfig &bridge_config, IPConfigs &ip_configs,
+          InterfaceConfigs &interface_configs, DipSwitchIpConfig &dip_switch_config, Interfaces &interfaces) )
   ;MOCK_CONST_METHOD0(GetBackupParameterCount, uint32_t() )
   ;
 };
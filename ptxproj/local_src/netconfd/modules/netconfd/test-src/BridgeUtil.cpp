@@ -8,6 +8,10 @@ MacLearning GetMacLearning([[maybe_unused]]::std::uint32_t if_index) {
   return MacLearning::UNKNOWN;
 }
 
+::std::map<::std::uint32_t, MacLearning> GetMacLearnings() {
+  return {};
+}
+
 void SetMacLearning([[maybe_unused]]::std::uint32_t if_index, [[maybe_unused]]MacLearning learning) {
 }
 }
@@ -6,8 +6,11 @@
 ///
 ///  \author   <author> : WAGO GmbH & Co. KG
 //------------------------------------------------------------------------------
+#include <boost/filesystem.hpp>
+
 #include "MockCommandExecutor.hpp"
 #include "DeviceTypeLabel.hpp"
+#include "FileEditor.hpp"
 
 
 using testing::_;
@@ -115,4 +118,58 @@ TEST_F(ADeviceTypeLabelProvider_Host, FailedToReadCorruptTypelabelIniFile) {
   EXPECT_EQ(dtl->GetOrderNumber(), "wago-pfc");
 }
 
+TEST_F(ADeviceTypeLabelProvider_Host, ExecutesTypelabelToolOnceWithCacheFile) {
+  auto cache_file = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  EXPECT_CALL(mock_executor_, Execute(_, _))
+      .WillOnce(DoAll(SetArgReferee<1>(type_label_ini_), Return(Status(StatusCode::OK))));
+
+  auto first = ::std::make_unique<DeviceTypeLabel>(mock_executor_, cache_file);
+  auto second = ::std::make_unique<DeviceTypeLabel>(mock_executor_, cache_file);
+  boost::filesystem::remove(cache_file);
+
+  EXPECT_EQ("750-8215", second->GetOrderNumber());
+  EXPECT_EQ("00:30:DE:11:11:11", second->GetMac().ToString());
+  EXPECT_EQ(5, second->GetMacCount());
+}
+
+TEST_F(ADeviceTypeLabelProvider_Host, DoesNotCacheFallbackValues) {
+  auto cache_file = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  EXPECT_CALL(mock_executor_, Execute(_, _))
+      .WillOnce(Return(Status(StatusCode::SYSTEM_EXECUTE)))
+      .WillOnce(DoAll(SetArgReferee<1>(type_label_ini_), Return(Status(StatusCode::OK))));
+
+  auto first = ::std::make_unique<DeviceTypeLabel>(mock_executor_, cache_file);
+  auto second = ::std::make_unique<DeviceTypeLabel>(mock_executor_, cache_file);
+  boost::filesystem::remove(cache_file);
+
+  EXPECT_EQ("wago-pfc", first->GetOrderNumber());
+  EXPECT_EQ("750-8215", second->GetOrderNumber());
+}
+
+TEST_F(ADeviceTypeLabelProvider_Host, ReplacesInvalidCacheFile) {
+  auto cache_file = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  FileEditor().Write(cache_file, "MAC=00:30:DE:11");
+  EXPECT_CALL(mock_executor_, Execute(_, _))
+      .WillOnce(DoAll(SetArgReferee<1>(type_label_ini_), Return(Status(StatusCode::OK))));
+
+  auto first = ::std::make_unique<DeviceTypeLabel>(mock_executor_, cache_file);
+  auto second = ::std::make_unique<DeviceTypeLabel>(mock_executor_, cache_file);
+  boost::filesystem::remove(cache_file);
+
+  EXPECT_EQ("750-8215", first->GetOrderNumber());
+  EXPECT_EQ("00:30:DE:11:11:11", second->GetMac().ToString());
+}
+
+TEST_F(ADeviceTypeLabelProvider_Host, DoesNotCacheIncompleteValues) {
+  auto cache_file = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  EXPECT_CALL(mock_executor_, Execute(_, _))
+      .Times(2)
+      .WillRepeatedly(DoAll(SetArgReferee<1>(type_label_ini_missing_value_), Return(Status(StatusCode::OK))));
+
+  auto first = ::std::make_unique<DeviceTypeLabel>(mock_executor_, cache_file);
+  auto second = ::std::make_unique<DeviceTypeLabel>(mock_executor_, cache_file);
+
+  EXPECT_FALSE(boost::filesystem::exists(cache_file));
+}
+
 } /* namespace netconf */
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <glib.h>
+
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "EventManager.hpp"
+#include "IIPInformation.hpp"
+#include "IInterfaceInformation.hpp"
+#include "MockINetDevManager.hpp"
+#include "MockIPersistenceProvider.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+namespace netconf {
+
+namespace bfs = boost::filesystem;
+using Clock   = ::std::chrono::steady_clock;
+
+namespace {
+
+class FakeIPInformation : public IIPInformation {
+ public:
+  IPConfigs GetCurrentIPConfigs() const override {
+    return ip_configs_;
+  }
+  IPConfigs ip_configs_;
+};
+
+class FakeInterfaceInformation : public IInterfaceInformation {
+ public:
+  InterfaceConfigs const &GetPortConfigs() override {
+    return port_configs_;
+  }
+  Status GetCurrentPortStatuses(InterfaceStatuses &itf_statuses) override {
+    itf_statuses = port_statuses_;
+    return Status{};
+  }
+  InterfaceInformations GetInterfaceInformations() override {
+    return InterfaceInformations{};
+  }
+  InterfaceConfigs port_configs_;
+  InterfaceStatuses port_statuses_;
+};
+
+class CountingEventManager : public EventManager {
+ public:
+  explicit CountingEventManager(::std::string ip_change_dir) : EventManager(::std::move(ip_change_dir)) {
+  }
+
+  void CallEventFolderSync(NetworkState & /*state*/, const ::std::set<Interface> &changed_interfaces) override {
+    event_folder_calls_++;
+    changed_interfaces_ = changed_interfaces;
+  }
+
+  int event_folder_calls_ = 0;
+  ::std::set<Interface> changed_interfaces_;
+};
+
+struct StormContext {
+  CountingEventManager *event_manager;
+  Interface port;
+  Clock::time_point end;
+};
+
+// a netlink event as dispatched by the NetlinkMonitor from the gmainloop
+int InjectNetlinkEvent(void *user) {
+  auto *storm = static_cast<StormContext *>(user);
+  storm->event_manager->NotifyNetworkChanges(EventLayer::EVENT_FOLDER, storm->port);
+  return Clock::now() < storm->end ? 1 : 0;
+}
+
+double MillisSince(Clock::time_point start) {
+  return ::std::chrono::duration<double, ::std::milli>(Clock::now() - start).count();
+}
+
+}  // namespace
+
+class EventManagerTest : public ::testing::Test {
+ public:
+  static constexpr int port_count = 64;
+
+  bfs::path ip_change_dir_;
+  NiceMock<MockIPersistenceProvider> mock_persistence_provider_;
+  NiceMock<MockINetDevManager> mock_netdev_manager_;
+  FakeIPInformation ip_information_;
+  FakeInterfaceInformation interface_information_;
+  ::std::unique_ptr<CountingEventManager> event_manager_;
+
+  void SetUp() override {
+    ip_change_dir_ = bfs::temp_directory_path() / bfs::unique_path("netconfd-ipv4-%%%%-%%%%");
+    for (int i = 1; i <= port_count; i++) {
+      auto port = Interface::CreatePort("ethX" + ::std::to_string(i));
+      interface_information_.port_configs_.emplace_back(InterfaceConfig::DefaultConfig(port));
+      interface_information_.port_statuses_.emplace_back(port, InterfaceState::UP, Autonegotiation::ON, 100,
+                                                         Duplex::FULL, LinkState::UP);
+    }
+
+    ON_CALL(mock_netdev_manager_, GetNetDevs(_)).WillByDefault(Return(NetDevs{}));
+    event_manager_ = ::std::make_unique<CountingEventManager>(ip_change_dir_.string());
+    event_manager_->RegisterNetworkInformation(mock_persistence_provider_, ip_information_, interface_information_,
+                                               mock_netdev_manager_);
+  }
+
+  void TearDown() override {
+    event_manager_.reset();
+    bfs::remove_all(ip_change_dir_);
+  }
+
+  Interface Port(int i) {
+    return interface_information_.port_configs_.at(static_cast<size_t>(i)).interface_;
+  }
+
+  void FlapPorts(int events_per_port) {
+    for (int e = 0; e < events_per_port; e++) {
+      for (int i = 0; i < port_count; i++) {
+        event_manager_->NotifyNetworkChanges(EventLayer::EVENT_FOLDER, Port(i));
+      }
+    }
+  }
+
+  void PublishLinkUp() {
+    event_manager_->NotifyNetworkChanges(EventLayer::EVENT_FOLDER, Port(0));
+    event_manager_->ProcessPendingEvents();
+    ASSERT_EQ(1, event_manager_->event_folder_calls_);
+  }
+};
+
+TEST_F(EventManagerTest, MergesEventStormIntoOneEventFolderCall) {
+  constexpr int events_per_port = 200;
+  constexpr int bridge_count    = 4;
+
+  auto start = Clock::now();
+  FlapPorts(events_per_port);
+  for (int e = 0; e < events_per_port; e++) {
+    for (int b = 0; b < bridge_count; b++) {
+      event_manager_->NotifyNetworkChanges(EventLayer::IP_CHANGE_FILES,
+                                           Interface::CreateBridge("br" + ::std::to_string(b)));
+    }
+  }
+  auto notify_millis = MillisSince(start);
+
+  start = Clock::now();
+  event_manager_->ProcessPendingEvents();
+  auto process_millis = MillisSince(start);
+
+  printf("%d events: notify %.3f ms, process pending %.3f ms\n", (port_count + bridge_count) * events_per_port,
+         notify_millis, process_millis);
+
+  EXPECT_EQ(1, event_manager_->event_folder_calls_);
+  EXPECT_EQ(static_cast<size_t>(port_count), event_manager_->changed_interfaces_.size());
+  for (int b = 0; b < bridge_count; b++) {
+    EXPECT_TRUE(bfs::exists(ip_change_dir_ / ("ipconchg-br" + ::std::to_string(b))));
+  }
+}
+
+TEST_F(EventManagerTest, LinkFlapWithoutStateChangeDoesNotCallEventFolder) {
+  PublishLinkUp();
+
+  FlapPorts(10);
+  event_manager_->ProcessPendingEvents();
+
+  EXPECT_EQ(1, event_manager_->event_folder_calls_);
+}
+
+TEST_F(EventManagerTest, LinkChangeCallsEventFolderWithChangedInterfaces) {
+  PublishLinkUp();
+
+  interface_information_.port_statuses_.at(3).link_state_ = LinkState::DOWN;
+  event_manager_->NotifyNetworkChanges(EventLayer::EVENT_FOLDER, Port(3));
+  event_manager_->ProcessPendingEvents();
+
+  EXPECT_EQ(2, event_manager_->event_folder_calls_);
+  EXPECT_EQ(::std::set<Interface>{Port(3)}, event_manager_->changed_interfaces_);
+}
+
+TEST_F(EventManagerTest, EventWithoutInterfaceAlwaysCallsEventFolder) {
+  PublishLinkUp();
+
+  event_manager_->NotifyNetworkChanges(EventLayer::EVENT_FOLDER);
+  event_manager_->ProcessPendingEvents();
+
+  EXPECT_EQ(2, event_manager_->event_folder_calls_);
+  EXPECT_TRUE(event_manager_->changed_interfaces_.empty());
+}
+
+TEST_F(EventManagerTest, EventOfOtherInterfaceAlwaysCallsEventFolder) {
+  PublishLinkUp();
+
+  event_manager_->NotifyNetworkChanges(EventLayer::EVENT_FOLDER, Interface::CreateBridge("br0"));
+  event_manager_->ProcessPendingEvents();
+
+  EXPECT_EQ(2, event_manager_->event_folder_calls_);
+}
+
+TEST_F(EventManagerTest, ContinuousStormIsPublishedWithinMaximumLatency) {
+  StormContext storm{event_manager_.get(), Port(0), Clock::now() + ::std::chrono::milliseconds(3000)};
+  auto source = g_timeout_add_full(G_PRIORITY_DEFAULT, 10, &InjectNetlinkEvent, &storm, nullptr);
+
+  auto start = Clock::now();
+  while (event_manager_->event_folder_calls_ == 0 && Clock::now() < storm.end) {
+    g_main_context_iteration(nullptr, TRUE);
+  }
+  auto first_call_millis = MillisSince(start);
+  g_source_remove(source);
+
+  printf("event storm published after %.3f ms\n", first_call_millis);
+  EXPECT_EQ(1, event_manager_->event_folder_calls_);
+  EXPECT_LT(first_call_millis, 2500);
+}
+
+}  // namespace netconf
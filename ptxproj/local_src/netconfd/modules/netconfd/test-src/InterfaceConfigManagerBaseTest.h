@@ -33,6 +33,7 @@ class InterfaceConfigManagerBaseTest {
       upper_.EthernetInterfaceDeleted(this);
     }
     Status UpdateConfig() override { return {}; }
+    Status UpdateLinkSettings() override { return {}; }
     ::std::string const& GetName() const { return name_;}
     MacAddress GetMac() const override { return MacAddress{mac};}
     bool GetAutonegSupport() const override { return true;}
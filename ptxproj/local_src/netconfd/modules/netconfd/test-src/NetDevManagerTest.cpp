@@ -6,6 +6,7 @@
 
 #include "BaseTypes.hpp"
 #include "CommonTestDependencies.hpp"
+#include "ConfigGeneration.hpp"
 #include "DeviceType.hpp"
 #include "LinkInfo.hpp"
 #include "MockIDeviceTypeLabel.hpp"
@@ -438,6 +439,24 @@ TEST_F(NetDevManagerTest, LinkChangeActionDEL) {
   EXPECT_EQ("br0", netdev->GetName());
 }
 
+TEST_F(NetDevManagerTest, LinkChangeActionNEWAndDELIncrementConfigGeneration) {
+  ConfigGeneration generation { ConfigGeneration::Access::ReadOnly };
+  ASSERT_TRUE(generation.IsAvailable());
+  auto new_linkinfo = LinkInfo { 1, "br0", "bridge" };
+
+  auto before_new = generation.Get();
+  netdev_manager_->LinkChange(new_linkinfo, InterfaceEventAction::NEW);
+  EXPECT_LT(before_new, generation.Get());
+
+  auto before_change = generation.Get();
+  netdev_manager_->LinkChange(new_linkinfo, InterfaceEventAction::CHANGE);
+  EXPECT_EQ(before_change, generation.Get());
+
+  auto before_del = generation.Get();
+  netdev_manager_->LinkChange(new_linkinfo, InterfaceEventAction::DEL);
+  EXPECT_LT(before_del, generation.Get());
+}
+
 TEST_F(NetDevManagerTest, NetdevExistsByInterface) {
 
   Links links = { LinkInfo { 1, "ethX1", "ethernet" }, LinkInfo { 2, "ethX2", "ethernet"},
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <map>
 #include <memory>
 
 #include "Status.hpp"
@@ -10,4 +12,9 @@ namespace netconf {
 void SetMacLearning(::std::uint32_t if_index, MacLearning learning);
 MacLearning GetMacLearning(::std::uint32_t if_index);
 
+/**
+ * Mac learning of all bridge ports by interface index, read with a single netlink dump.
+ */
+::std::map<::std::uint32_t, MacLearning> GetMacLearnings();
+
 }  // namespace netconf
@@ -8,6 +8,7 @@
 #include <netlink/types.h>
 
 #include <functional>
+#include <map>
 
 #include "Logger.hpp"
 namespace netconf {
@@ -96,6 +97,14 @@ int NetlinkGetBridgeLinkLearning(::std::uint32_t if_index, bool &learning) {
   return 0;
 }
 
+void CollectBridgeLinkLearning(nl_object *obj, void *user) {
+  auto link     = reinterpret_cast<rtnl_link *>(obj);  // NOLINT: Need reinterpret_cast to cast from nl_object.
+  auto learning = reinterpret_cast<::std::map<::std::uint32_t, MacLearning> *>(user);  // NOLINT: user data
+  auto flags    = rtnl_link_bridge_get_flags(link);
+  (*learning)[static_cast<::std::uint32_t>(rtnl_link_get_ifindex(link))] =
+      (flags & RTNL_BRIDGE_LEARNING) != 0 ? MacLearning::ON : MacLearning::OFF;
+}
+
 }
 
 using namespace std::string_literals;
@@ -112,6 +121,16 @@ MacLearning GetMacLearning(::std::uint32_t if_index) {
   return  learning ? MacLearning::ON : MacLearning::OFF;
 }
 
+::std::map<::std::uint32_t, MacLearning> GetMacLearnings() {
+  ::std::map<::std::uint32_t, MacLearning> learning;
+  auto socket = AllocateNetlinkSocket();
+  auto cache = AllocLinkCache(*socket, AF_BRIDGE);
+  if (cache) {
+    nl_cache_foreach(cache.get(), &CollectBridgeLinkLearning, &learning);
+  }
+  return learning;
+}
+
 void SetMacLearning(::std::uint32_t if_index, MacLearning learning) {
   if(learning != MacLearning::UNKNOWN){
     auto nl_status = NetlinkSetBridgeLinkLearning(if_index, learning == MacLearning::ON);
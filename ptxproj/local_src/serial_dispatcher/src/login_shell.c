@@ -31,6 +31,8 @@
 
 
 
+#define CONSOLE_SIGNATURE "console"
+
 typedef struct stConsoleData {
     char  buffer[2048];
     pid_t child;
@@ -53,7 +55,7 @@ static tDispatchResult collectConsole(struct stService * self,char byte)
 
   if(self->fd == -1)
   {
-      char compare[] = "console";
+      char compare[] = CONSOLE_SIGNATURE;
       if(byte == compare[serviceData->actIndex])
       {
         serviceData->actIndex++;
@@ -77,6 +79,28 @@ static tDispatchResult collectConsole(struct stService * self,char byte)
   return ret;
 }
 
+static tDispatchResult collectBlockConsole(struct stService * self,const char * buffer,size_t len,size_t * consumed)
+{
+  tConsoleData * serviceData = (tConsoleData *)self->serviceData;
+
+  //the login keyword is matched byte by byte
+  if(self->fd == -1)
+  {
+    *consumed = 1;
+    return collectConsole(self, buffer[0]);
+  }
+
+  //a running login shell gets everything which fits into the buffer
+  *consumed = sizeof(serviceData->buffer) - serviceData->actIndex;
+  if(*consumed > len)
+  {
+    *consumed = len;
+  }
+  memcpy(&serviceData->buffer[serviceData->actIndex], buffer, *consumed);
+  serviceData->actIndex += *consumed;
+  return RESULT_BG_SUCCESS;
+}
+
 static int sendConsole(struct stService * self)
 {
   tConsoleData * serviceData = (tConsoleData *)self->serviceData;
@@ -92,6 +116,11 @@ static int sendConsole(struct stService * self)
       execl("/bin/login","login",NULL);
       exit(0);
     }
+    //a running login shell takes every byte
+    if(self->fd != -1)
+    {
+      self->signature = NULL;
+    }
   }
   else
   {
@@ -122,6 +151,7 @@ void stopConsole(struct stService * self)
     waitpid(serviceData->child, &status,0);
     serviceData->child = -1;
     self->fd = -1;
+    self->signature = CONSOLE_SIGNATURE;
     self->reset(self);
   }
 }
@@ -197,6 +227,8 @@ tServiceList * RegisterConsoleService(void)
   list->service = NewService();
   sprintf(list->service->name,"Console");
   list->service->collect = collectConsole;
+  list->service->collectBlock = collectBlockConsole;
+  list->service->signature = CONSOLE_SIGNATURE;
   list->service->fd = -1;
   list->service->handleTimeout = stopConsole;
   list->service->getPollEvents = getPollEventsConsole;
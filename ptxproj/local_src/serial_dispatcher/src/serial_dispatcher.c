@@ -35,6 +35,8 @@
 #include <getopt.h>
 #include <pty.h>
 #include <limits.h>
+#include <fcntl.h>
+#include <stdint.h>
 
 #include "services.h"
 
@@ -48,6 +50,9 @@
 #define LOGBUFFER_SIZE 1024
 #define PRINTBUFFER_SIZE 8192
 
+#define PREFIX_TABLE_DEPTH   8
+#define PREFIX_MAX_SERVICES  32
+
 
 
 typedef struct stBaudrate {
@@ -57,6 +62,14 @@ typedef struct stBaudrate {
 
 tServiceList * serviceRoot = NULL;
 
+//prefix table of the service signatures. prefixTable[pos][byte] has the bit
+//of every service set which still matches if byte is received at position
+//pos of a new package
+static uint32_t prefixTable[PREFIX_TABLE_DEPTH][256];
+static uint32_t prefixCandidates = UINT32_MAX;//services matching the actual package
+static size_t   prefixPos = 0;//position in the actual package
+static const char * prefixSignatures[PREFIX_MAX_SERVICES];//signatures the table was built with
+
 const tBaudrate baudrates[] = {{B230400, 230400},
                                {B115200, 115200},
                                {B57600,  57600},
@@ -105,9 +118,10 @@ void  cerror(const char *msg, int retval)
   return;
 }
 
-#define MAX_LINE    2048
+#define MAX_LINE    16384
 
 #define MAX(a,b)    (((a)>(b))?(a):(b))
+#define MIN(a,b)    (((a)<(b))?(a):(b))
 
 void CloseSerial(int fd, struct termios *termIOs)
 {
@@ -193,12 +207,27 @@ void printBuffer(char * buf, size_t n,char * name, char dir)
   puts(logstr);
 }
 
+//check if a service has opened or closed its fd since the poll set was built
+static int pollFdsChanged(tServiceList * pAct)
+{
+  while(pAct != NULL)
+  {
+    if(pAct->service->fd != pAct->service->polledFd)
+    {
+      return 1;
+    }
+    pAct = pAct->pNext;
+  }
+  return 0;
+}
+
 struct pollfd * updatePollFds(struct pollfd * fds,size_t * anzFds,size_t * fdsSize ,tServiceList * pAct)
 {
   while(pAct != NULL)
   {
     size_t i;
     int found = 1;
+    pAct->service->polledFd = pAct->service->fd;
     for(i = 0; i < *anzFds;i++)
     {
       if(   (pAct->service->fd < 0)
@@ -225,6 +254,80 @@ struct pollfd * updatePollFds(struct pollfd * fds,size_t * anzFds,size_t * fdsSi
   return fds;
 }
 
+//rebuild the prefix table from the actual signatures of the services
+static void BuildPrefixTable(tServiceList * pAct)
+{
+  int bit;
+
+  memset(prefixTable, 0, sizeof(prefixTable));
+  memset(prefixSignatures, 0, sizeof(prefixSignatures));
+  for(bit = 0; (pAct != NULL) && (bit < PREFIX_MAX_SERVICES); bit++)
+  {
+    const char * signature = pAct->service->signature;
+    size_t       len = (signature != NULL) ? strlen(signature) : 0;
+    size_t       pos;
+    int          byte;
+
+    prefixSignatures[bit] = signature;
+
+    for(pos = 0; pos < PREFIX_TABLE_DEPTH; pos++)
+    {
+      if(pos < len)
+      {
+        prefixTable[pos][(unsigned char)signature[pos]] |= (1u << bit);
+      }
+      else
+      {
+        for(byte = 0; byte < 256; byte++)
+        {
+          prefixTable[pos][byte] |= (1u << bit);
+        }
+      }
+    }
+    pAct = pAct->pNext;
+  }
+}
+
+//rebuild the prefix table if a service changed its signature, e.g. the console
+//takes every byte as soon as the login shell runs
+static void UpdatePrefixTable(tServiceList * services)
+{
+  tServiceList * pAct = services;
+  int            bit;
+
+  for(bit = 0; (pAct != NULL) && (bit < PREFIX_MAX_SERVICES); bit++)
+  {
+    if(pAct->service->signature != prefixSignatures[bit])
+    {
+      BuildPrefixTable(services);
+      return;
+    }
+    pAct = pAct->pNext;
+  }
+}
+
+//invalidate all services whose signature does not match the received byte,
+//so their collect handlers are not called for foreign packages
+static void MatchPrefix(char byte, tServiceList * pAct)
+{
+  int bit;
+
+  if(prefixPos >= PREFIX_TABLE_DEPTH)
+  {
+    return;
+  }
+  prefixCandidates &= prefixTable[prefixPos][(unsigned char)byte];
+  prefixPos++;
+  for(bit = 0; (pAct != NULL) && (bit < PREFIX_MAX_SERVICES); bit++)
+  {
+    if(!(prefixCandidates & (1u << bit)))
+    {
+      pAct->service->valid = RESULT_INVALID;
+    }
+    pAct = pAct->pNext;
+  }
+}
+
 void resetTimeout(time_t timeout, struct timespec * tsAbs)
 {
   clock_gettime(CLOCK_MONOTONIC,tsAbs);
@@ -309,6 +412,8 @@ int PollAll(struct pollfd *fds, nfds_t anzFds,tServiceList * services,struct tim
 
 void resetAll(tServiceList * pAct)
 {
+  prefixCandidates = UINT32_MAX;
+  prefixPos = 0;
   while(pAct != NULL)
   {
     pAct->service->valid = RESULT_VALID;
@@ -426,6 +531,148 @@ int CollectAndSend(char byte,tServiceList * services)
   return ret;
 }
 
+//returns the service if it is the only valid one and able to collect blocks
+static tService * GetSelectedService(tServiceList * pAct)
+{
+  tService * selected = NULL;
+  while(pAct != NULL)
+  {
+    if(pAct->service->valid != RESULT_INVALID)
+    {
+      if(selected != NULL)
+      {
+        return NULL;
+      }
+      selected = pAct->service;
+    }
+    pAct = pAct->pNext;
+  }
+  if(selected != NULL && selected->collectBlock == NULL)
+  {
+    selected = NULL;
+  }
+  return selected;
+}
+
+//block variant of CollectAndSend for the only valid service
+static int CollectBlockAndSend(tService * selected, const char * buffer, size_t len,
+                               size_t * consumed, tServiceList * services)
+{
+  int ret = 0;
+  tDispatchResult result;
+
+  *consumed = 1;
+  result = selected->collectBlock(selected, buffer, len, consumed);
+  selected->valid = result;
+  if(   (result == RESULT_PRIO_SUCCESS)
+     || (result == RESULT_BG_SUCCESS))
+  {
+    ret = 1;
+    selected->send(selected);
+    if(result == RESULT_PRIO_SUCCESS)
+    {
+      resetBackgrounds(services);
+    }
+    resetTimeout(selected->timeout, &(selected->tsAbs));
+  }
+
+  return ret;
+}
+
+static void CollectBuffer(const char * buffer, size_t len, tServiceList * services)
+{
+  size_t pos = 0;
+  while(pos < len)
+  {
+    size_t     consumed = 1;
+    int        sent;
+    tService * selected = GetSelectedService(services);
+
+    if(selected != NULL)
+    {
+      sent = CollectBlockAndSend(selected, &buffer[pos], len - pos, &consumed, services);
+    }
+    else
+    {
+      MatchPrefix(buffer[pos], services);
+      sent = CollectAndSend(buffer[pos],services);
+    }
+    if(sent)
+    {
+      //the following bytes of the buffer are matched with the new signatures
+      UpdatePrefixTable(services);
+      resetAll(services);
+    }
+    pos += consumed;
+  }
+}
+
+//forward data of a service to the tty. splice is used to avoid copying the
+//data through the user space. if one of the fds does not support it we fall
+//back to read and write
+static int ForwardToTty(int fd, int fdTty, char * buffer, size_t szBuffer)
+{
+  static int pipeFds[2] = {-1, -1};
+  static int useSplice = 1;
+  ssize_t    bytes;
+
+  if(useSplice && !debug && pipeFds[0] < 0)
+  {
+    if(0 > pipe2(pipeFds, O_CLOEXEC))
+    {
+      useSplice = 0;
+    }
+  }
+  if(useSplice && !debug)
+  {
+    bytes = splice(fd, NULL, pipeFds[1], NULL, szBuffer, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if(bytes > 0)
+    {
+      ssize_t pending = bytes;
+      while(pending > 0)
+      {
+        ssize_t written = splice(pipeFds[0], NULL, fdTty, NULL, pending, SPLICE_F_MOVE);
+        if(written <= 0)
+        {
+          //tty does not support splice, drain the pipe by hand
+          useSplice = 0;
+          while(pending > 0)
+          {
+            ssize_t chunk = read(pipeFds[0], buffer, MIN((size_t)pending, szBuffer));
+            if(chunk <= 0)
+            {
+              break;
+            }
+            write(fdTty, buffer, chunk);
+            pending -= chunk;
+          }
+          break;
+        }
+        pending -= written;
+      }
+      return bytes;
+    }
+    if(bytes == 0 || (errno != EINVAL && errno != ENOSYS))
+    {
+      return bytes;
+    }
+    useSplice = 0;
+  }
+
+  bytes = read(fd, buffer, szBuffer);
+  if(debug)
+  {
+    char name[32];
+    sprintf(name, "%d",fd);
+    printBuffer(buffer, bytes, name, DATA_OUT);
+  }
+  if(bytes > 0)
+  {
+    write(fdTty, buffer,bytes);
+  }
+  return bytes;
+}
+
 int CheckValids(tServiceList * pAct)
 {
   int ret = 0;
@@ -446,18 +693,27 @@ static void Dispatch(int fdTty, tServiceList * services)
   struct pollfd * fds = NULL;
   size_t         fdsSize = 1;
   size_t         anzFds  = 1;
+  char           buffer[MAX_LINE];
 
   fds = realloc(fds,fdsSize * sizeof (struct pollfd));
+  fds[0].fd = fdTty;
+  fds[0].events = POLLIN;
+  fds = updatePollFds(fds,&anzFds,&fdsSize ,services);
+  BuildPrefixTable(services);
 
   resetAll(services);
   while(1)
   {
     int polled;
     struct timespec neededTime;
-    fds[0].fd = fdTty;
-    fds[0].events = POLLIN;
-    anzFds=1;
-    fds = updatePollFds(fds,&anzFds,&fdsSize ,services);
+    //rebuild the poll set only if a service opened or closed its fd
+    if(pollFdsChanged(services))
+    {
+      anzFds=1;
+      fds = updatePollFds(fds,&anzFds,&fdsSize ,services);
+    }
+    //signatures change together with the fds, e.g. on timeouts and poll events
+    UpdatePrefixTable(services);
     polled = PollAll(fds,anzFds,services,&neededTime);
     if(neededTime.tv_sec > 0)
     {
@@ -475,7 +731,6 @@ static void Dispatch(int fdTty, tServiceList * services)
     {
       int i;
       int bytes;
-      char buffer[MAX_LINE];
 
       //read service FDs
       for(i = anzFds-1; i > 0;i--)
@@ -490,17 +745,7 @@ static void Dispatch(int fdTty, tServiceList * services)
         }
         else if(fds[i].revents & POLLIN)
         {
-          bytes = read(fds[i].fd, buffer, MAX_LINE);
-          if(debug)
-          {
-            char name[32];
-            sprintf(name, "%d",fds[i].fd);
-            printBuffer(buffer, bytes, name, DATA_OUT);
-          }
-          if(bytes > 0)
-          {
-            write(fdTty, buffer,bytes);
-          }
+          ForwardToTty(fds[i].fd, fdTty, buffer, MAX_LINE);
           updateTimeouts(fds[i].fd,services);
         }
 
@@ -508,18 +753,14 @@ static void Dispatch(int fdTty, tServiceList * services)
 
       if(fds[0].revents & POLLIN)
       {
-        int i;
         bytes = read(fds[0].fd, buffer, MAX_LINE);
         if(debug)
         {
           printBuffer(buffer, bytes, "read", DATA_IN);
         }
-        for(i=0;i<bytes;i++)
+        if(bytes > 0)
         {
-          if(CollectAndSend(buffer[i],services))
-          {
-            resetAll(services);
-          }
+          CollectBuffer(buffer, bytes, services);
         }
       }
       if(!CheckValids(services))
@@ -663,6 +904,9 @@ tService * NewService(void)
   tService * ret = malloc(sizeof(tService));
 
   ret->collect = NULL;
+  ret->collectBlock = NULL;
+  ret->polledFd = -1;
+  ret->signature = NULL;
   ret->handleTimeout = NULL;
   ret->getPollEvents = NULL;
   ret->handleEvent = NULL;
@@ -56,6 +56,13 @@ typedef enum {
  * 2: package is complete ready for sending
  */
 typedef tDispatchResult(*tCollectHandler)(struct stService * self,char byte);
+/*
+ * optional block variant of the collect handler. It is used when the service
+ * is the only one which is still valid. The handler takes as much bytes of the
+ * buffer as belong to the actual package and writes the number of taken bytes
+ * to consumed (at least 1).
+ */
+typedef tDispatchResult(*tCollectBlockHandler)(struct stService * self,const char * buffer,size_t len,size_t * consumed);
 typedef int(*tSendHandler)(struct stService * self);
 typedef void(*tTimeoutHandler)(struct stService * self);
 typedef void(*tResetHandler)(struct stService * self);
@@ -71,7 +78,10 @@ struct stService
     time_t            timeout;//timout for service in seconds
     //time_t            timeoutRest;//time remaining for timeout
     struct timespec   tsAbs;
+    int               polledFd;//fd the poll set was built with
+    const char      * signature;//bytes every package starts with (NULL for any), may only change together with fd
     tCollectHandler   collect;
+    tCollectBlockHandler collectBlock;
     tSendHandler      send;
     tTimeoutHandler   handleTimeout;
     tResetHandler     reset;
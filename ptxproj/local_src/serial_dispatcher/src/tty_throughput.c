@@ -0,0 +1,294 @@
+/*
+ *
+ *  tty_throughput - throughput benchmark for the ttydispatcherd
+ *  Copyright (C) 2025  WAGO GmbH & Co. KG
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/*
+ * The benchmark starts the ttydispatcherd with the WAGO service on the slave
+ * side of a pty pair and takes the place of the WAGO protocol server on
+ * 127.0.0.1:6625. It measures both directions:
+ *
+ *  tty -> tcp  WAGO telegrams written to the pty master until they arrived
+ *              at the server (collect and send path)
+ *  tcp -> tty  data sent by the server until it arrived at the pty master
+ *              (forwarding path)
+ *
+ * Build it with "make tty_throughput" in the src directory.
+ */
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <getopt.h>
+#include <pty.h>
+#include <fcntl.h>
+
+#include "services.h"
+
+#define WAGO_PORT            6625
+#define MAX_TELEGRAM_LENGTH  200
+#define IO_BUFFER_SIZE       16384
+#define POLL_TIMEOUT_MS      5000
+
+#define OPTIONS              "hd:b:n:s:"
+
+static double Elapsed(const struct timespec * start)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void PrintResult(const char * name, size_t bytes, double seconds)
+{
+  printf("%-10s %10zu bytes %8.3f s %10.1f KiB/s\n",
+         name, bytes, seconds, (double)bytes / 1024.0 / seconds);
+}
+
+static int OpenServer(void)
+{
+  struct sockaddr_in saddr;
+  int                on = 1;
+  int                fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+  if(fd < 0)
+  {
+    perror("socket");
+    return -1;
+  }
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  memset(&saddr, 0, sizeof(saddr));
+  saddr.sin_family = AF_INET;
+  saddr.sin_port = htons(WAGO_PORT);
+  saddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if(   (0 > bind(fd, (struct sockaddr *)&saddr, sizeof(saddr)))
+     || (0 > listen(fd, 1)))
+  {
+    perror("bind 127.0.0.1:6625");
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+static pid_t StartDispatcher(const char * dispatcher, const char * device, const char * baud)
+{
+  pid_t child = fork();
+
+  if(child == 0)
+  {
+    execl(dispatcher, dispatcher, "-d", device, "-b", baud, "-w", NULL);
+    perror(dispatcher);
+    exit(EXIT_FAILURE);
+  }
+  return child;
+}
+
+//write telegrams to the tty until all of them arrived at the server
+static int RunTtyToTcp(int fdMaster, int fdServer, int * fdConn, size_t telegrams, size_t size)
+{
+  char            telegram[MAX_TELEGRAM_LENGTH];
+  char            buffer[IO_BUFFER_SIZE];
+  size_t          total = telegrams * size;
+  size_t          sent = 0;
+  size_t          received = 0;
+  size_t          i;
+  struct timespec start;
+
+  telegram[0] = (char)0xFD;
+  telegram[1] = 0x02;
+  telegram[2] = (char)size;
+  for(i = 3; i < size; i++)
+  {
+    telegram[i] = (char)i;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  while(received < total)
+  {
+    struct pollfd fds[2];
+    ssize_t       bytes;
+
+    fds[0].fd = fdMaster;
+    fds[0].events = (sent < total) ? POLLOUT : 0;
+    fds[1].fd = (*fdConn < 0) ? fdServer : *fdConn;
+    fds[1].events = POLLIN;
+    if(0 >= poll(fds, 2, POLL_TIMEOUT_MS))
+    {
+      fprintf(stderr, "tty -> tcp: timeout after %zu of %zu bytes\n", received, total);
+      return -1;
+    }
+    if(fds[0].revents & POLLOUT)
+    {
+      size_t offset = sent % size;
+      bytes = write(fdMaster, &telegram[offset], size - offset);
+      if(bytes > 0)
+      {
+        sent += (size_t)bytes;
+      }
+    }
+    if(fds[1].revents & POLLIN)
+    {
+      if(*fdConn < 0)
+      {
+        *fdConn = accept(fdServer, NULL, NULL);
+        continue;
+      }
+      bytes = read(*fdConn, buffer, sizeof(buffer));
+      if(bytes <= 0)
+      {
+        fprintf(stderr, "tty -> tcp: connection closed\n");
+        return -1;
+      }
+      received += (size_t)bytes;
+    }
+  }
+  PrintResult("tty -> tcp", total, Elapsed(&start));
+  return 0;
+}
+
+//send data from the server until all of it arrived at the tty
+static int RunTcpToTty(int fdMaster, int fdConn, size_t total)
+{
+  char            out[IO_BUFFER_SIZE];
+  char            in[IO_BUFFER_SIZE];
+  size_t          sent = 0;
+  size_t          received = 0;
+  struct timespec start;
+
+  memset(out, 0x55, sizeof(out));
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  while(received < total)
+  {
+    struct pollfd fds[2];
+    ssize_t       bytes;
+
+    fds[0].fd = fdConn;
+    fds[0].events = (sent < total) ? POLLOUT : 0;
+    fds[1].fd = fdMaster;
+    fds[1].events = POLLIN;
+    if(0 >= poll(fds, 2, POLL_TIMEOUT_MS))
+    {
+      fprintf(stderr, "tcp -> tty: timeout after %zu of %zu bytes\n", received, total);
+      return -1;
+    }
+    if(fds[0].revents & POLLOUT)
+    {
+      size_t chunk = total - sent;
+      bytes = write(fdConn, out, (chunk < sizeof(out)) ? chunk : sizeof(out));
+      if(bytes > 0)
+      {
+        sent += (size_t)bytes;
+      }
+    }
+    if(fds[1].revents & POLLIN)
+    {
+      bytes = read(fdMaster, in, sizeof(in));
+      if(bytes > 0)
+      {
+        received += (size_t)bytes;
+      }
+    }
+  }
+  PrintResult("tcp -> tty", total, Elapsed(&start));
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  const char * dispatcher = "./ttydispatcherd";
+  const char * baud = "230400";
+  size_t       telegrams = 10000;
+  size_t       size = MAX_TELEGRAM_LENGTH;
+  int          fdMaster, fdSlave, fdServer;
+  int          fdConn = -1;
+  int          c, status;
+  int          ret = EXIT_FAILURE;
+  char         ptyName[1024];
+  pid_t        child;
+
+  while ((c = getopt(argc, argv, OPTIONS)) != EOF)
+  {
+    switch (c) {
+      case 'd':
+        dispatcher = optarg;
+        break;
+      case 'b':
+        baud = optarg;
+        break;
+      case 'n':
+        telegrams = strtoul(optarg, NULL, 0);
+        break;
+      case 's':
+        size = strtoul(optarg, NULL, 0);
+        break;
+      case 'h':
+      default:
+        fprintf(stderr,
+        "usage: %s [-d <ttydispatcherd>] [-b <baud>] [-n <telegrams>] [-s <size>]\n"
+        "-d <path>   dispatcher binary (default: ./ttydispatcherd)\n"
+        "-b <baud>   baudrate passed to the dispatcher (default: 230400)\n"
+        "-n <count>  number of WAGO telegrams (default: 10000)\n"
+        "-s <size>   telegram size 4..200 (default: 200)\n",
+        argv[0]);
+        exit(c == 'h' ? 0 : 2);
+    }
+  }
+  if(size < 4 || size > MAX_TELEGRAM_LENGTH)
+  {
+    fprintf(stderr, "invalid telegram size %zu\n", size);
+    exit(2);
+  }
+
+  if(0 > openpty(&fdMaster, &fdSlave, ptyName, NULL, NULL))
+  {
+    perror("openpty");
+    exit(EXIT_FAILURE);
+  }
+  fcntl(fdMaster, F_SETFL, fcntl(fdMaster, F_GETFL) | O_NONBLOCK);
+  fdServer = OpenServer();
+  if(fdServer < 0)
+  {
+    exit(EXIT_FAILURE);
+  }
+
+  child = StartDispatcher(dispatcher, ptyName, baud);
+  //the dispatcher flushes the tty when it configures it
+  usleep(500000);
+
+  printf("%zu telegrams of %zu bytes, %s baud\n", telegrams, size, baud);
+  if(   (0 == RunTtyToTcp(fdMaster, fdServer, &fdConn, telegrams, size))
+     && (0 == RunTcpToTty(fdMaster, fdConn, telegrams * size)))
+  {
+    ret = EXIT_SUCCESS;
+  }
+
+  kill(child, SIGTERM);
+  waitpid(child, &status, 0);
+  if(fdConn >= 0)
+  {
+    close(fdConn);
+  }
+  close(fdServer);
+  close(fdSlave);
+  close(fdMaster);
+  return ret;
+}
+
+//---- End of source file ------------------------------------------------------
@@ -29,9 +29,10 @@
 #define DEFAULT_PORT      6625
 #define DEFAULT_HOST      "127.0.0.1"
 #define DEFAULT_TIMEOUT   600
+#define WAGO_SIGNATURE    "\xFD\x02"
 
 typedef struct stWAGOData {
-    char  buffer[136];
+    char  buffer[MAX_TELEGRAM_LENGTH];
     int   actIndex;
     short fullSize;
     int   state;
@@ -118,6 +119,32 @@ static tDispatchResult collectWAGO(struct stService * self,char byte)
   return ret;
 }
 
+static tDispatchResult collectBlockWAGO(struct stService * self,const char * buffer,size_t len,size_t * consumed)
+{
+  tWAGOData * serviceData = (tWAGOData *)self->serviceData;
+  size_t missing;
+
+  //the header and the last byte of a telegram are parsed byte by byte
+  if(   (serviceData->state != STATE_COLLECT)
+     || (serviceData->actIndex + 1 >= serviceData->fullSize))
+  {
+    *consumed = 1;
+    return collectWAGO(self, buffer[0]);
+  }
+
+  //take the rest of the telegram at once
+  missing = serviceData->fullSize - serviceData->actIndex;
+  *consumed = (len < missing) ? len : missing;
+  memcpy(&serviceData->buffer[serviceData->actIndex], buffer, *consumed);
+  serviceData->actIndex += *consumed;
+  if(serviceData->actIndex >= serviceData->fullSize)
+  {
+    serviceData->state = STATE_START;
+    return RESULT_PRIO_SUCCESS;
+  }
+  return RESULT_VALID;
+}
+
 static int initSocket(struct sockaddr_in *saddr,
                       const char *cmd_host,
                       int cmd_port)
@@ -242,6 +269,8 @@ tServiceList * RegisterWAGOService(void)
   list->service = NewService();
   sprintf(list->service->name,"WAGO");
   list->service->collect = collectWAGO;
+  list->service->collectBlock = collectBlockWAGO;
+  list->service->signature = WAGO_SIGNATURE;
   list->service->fd = -1;
   list->service->handleTimeout = handleTimeoutWAGO;
   list->service->getPollEvents = getPollEventsWAGO;
@@ -46,6 +46,8 @@ typedef void(*log_tEventHandler)(com_tConnection*, com_tComMessage*, log_tEventI
 #define LOG_DIAG_PATH     "/wago/diagnose"
 #define LOG_GET_INFO      "getInfo"
 
+#define LOG_EVENT_MAX_ARGS 8
+
 
 #define DIAGNOSTIG_API 2
 //#define openlog    diag_ConnectToLog
@@ -80,6 +82,47 @@ void log_EVENT_LogIdParam(    log_tEventId           id,
                               bool               set,
                               int                first_arg_type, ...);
 
+/// Behaviour of log_EVENT_LogIdParam when the queue of the asynchronous sender is full.
+typedef enum
+{
+  LOG_EVENT_QUEUE_DROP,   ///< drop the event, it is counted in log_tEventAsyncStats.dropped
+  LOG_EVENT_QUEUE_BLOCK   ///< wait until the sender has made room
+} log_tEventQueuePolicy;
+
+typedef struct
+{
+  uint32_t              queueLength; ///< events, rounded up to a power of two; 0: 1024
+  uint32_t              maxBatch;    ///< events sent per flush of the connection; 0: 64
+  log_tEventQueuePolicy policy;
+} log_tEventAsyncConfig;
+
+typedef struct
+{
+  uint64_t queued;   ///< events accepted by the queue
+  uint64_t sent;     ///< events sent on the bus
+  uint64_t dropped;  ///< events dropped because the queue was full
+  uint64_t batches;  ///< flushes of the connection
+} log_tEventAsyncStats;
+
+/// Switches log_EVENT_LogIdParam to asynchronous emission: events are copied
+/// into a bounded lock-free queue and sent in batches by a background thread,
+/// so the caller does not wait for the D-Bus write. At most LOG_EVENT_MAX_ARGS
+/// parameters of an event are sent. Without this call, events are sent
+/// synchronously. Call after log_EVENT_Init.
+/// \return 0 on success, -1 if already enabled or on error
+int log_EVENT_EnableAsync(const log_tEventAsyncConfig * config);
+
+/// Sends the queued events, stops the background thread and returns to
+/// synchronous emission. Must not be called concurrently with log_EVENT_LogIdParam.
+void log_EVENT_DisableAsync(void);
+
+/// Waits until all events queued before the call are sent. Returns at once
+/// in synchronous mode.
+void log_EVENT_Flush(void);
+
+/// Counters of the asynchronous sender, all zero in synchronous mode.
+void log_EVENT_GetAsyncStats(log_tEventAsyncStats * stats);
+
 /*void log_EVENT_LogDev(        int priority,
                               const char         format, ...);*/
 #define log_EVENT_LogDev    syslog
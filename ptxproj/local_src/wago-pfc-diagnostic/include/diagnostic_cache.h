@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+/// Copyright (c) WAGO GmbH & Co. KG
+///
+/// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+/// manufacturing, reproduction, use, and sales rights pertaining to this
+/// subject matter are governed by the license agreement. The recipient of this
+/// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///
+///  \file     diagnostic_cache.h
+///
+///  \brief    Binary table compiled from a diagnostic XML description. It holds
+///            the texts and LED descriptions of all events, is mapped into memory
+///            and used without any parsing. A table whose XML source changed is
+///            compiled again; if that is not possible, the XML is used.
+///
+///  \author   WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+#ifndef DIAGNOSTIC_CACHE_H_
+#define DIAGNOSTIC_CACHE_H_
+
+#include <stdint.h>
+#include "diagnostic_xml.h"
+
+#define DIAGNOSTIC_CACHE_DIR      "/var/cache/diagnostic"
+#define DIAGNOSTIC_CACHE_MAGIC    "WDIAGIDX"
+#define DIAGNOSTIC_CACHE_VERSION  1
+
+/* the XML source the table was compiled from; a table is stale if it differs */
+typedef struct {
+    uint64_t size;
+    int64_t  mtimeSec;
+    int64_t  mtimeNsec;
+    uint64_t inode;
+}tDiagCacheSource;
+
+typedef struct {
+    char             magic[8];
+    uint32_t         version;
+    uint32_t         headerSize;
+    tDiagCacheSource source;
+    uint32_t         eventCount;
+    uint32_t         textCount;
+    uint32_t         ledCount;
+    uint32_t         stringsSize;
+    uint32_t         eventsOffset;
+    uint32_t         textsOffset;
+    uint32_t         ledsOffset;
+    uint32_t         stringsOffset;
+}tDiagCacheHeader;
+
+/* sorted by (id & DIAG_ID_MASK), events with equal id in document order */
+typedef struct {
+    uint32_t id;
+    uint32_t firstText;
+    uint32_t textCount;
+}tDiagCacheEvent;
+
+/* offsets into the string pool, 0 is the empty string and means "none" */
+typedef struct {
+    uint32_t lan;
+    uint32_t string;
+    uint32_t reset;
+}tDiagCacheText;
+
+/* LED description of an event, in document order */
+typedef struct {
+    uint32_t       id;
+    uint32_t       name;
+    int32_t        state;
+    uint32_t       flags;
+    tLedVariables  vars;
+    tLedVariables  args;
+}tDiagCacheLed;
+
+tDiagCache * DIAGCACHE_Open(const char * xmlPath);
+void DIAGCACHE_Close(tDiagCache * cache);
+int DIAGCACHE_Compile(const char * xmlPath, const char * cachePath);
+void DIAGCACHE_GetCachePath(const char * xmlPath, char * cachePath, size_t size);
+
+const char * DIAGCACHE_GetString(tDiagCache * cache, uint32_t id, const char * lan);
+const char * DIAGCACHE_GetResetString(tDiagCache * cache, uint32_t id, const char * lan);
+uint32_t DIAGCACHE_GetEventCount(tDiagCache * cache);
+uint32_t DIAGCACHE_GetEventId(tDiagCache * cache, uint32_t index);
+uint32_t DIAGCACHE_GetLedCount(tDiagCache * cache);
+const tDiagCacheLed * DIAGCACHE_GetLed(tDiagCache * cache, uint32_t index);
+const char * DIAGCACHE_GetName(tDiagCache * cache, const tDiagCacheLed * led);
+
+#endif /* DIAGNOSTIC_CACHE_H_ */
+//---- End of source file ------------------------------------------------------
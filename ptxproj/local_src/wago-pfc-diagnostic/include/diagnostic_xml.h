@@ -41,6 +41,9 @@
 
 #define LED_FILE_FLAG_REREAD          0x01
 
+/* event id without the persistence flags */
+#define DIAG_ID_MASK                  0x3FFFFFFF
+
 #define DIAGNOSTIC_XML_DOCUMENT         "/etc/specific/diagnostic.xml"
 #define DIAGNOSTIC_XML_DOCUMENT_CUSTOM  "/tmp/cstdiagnostic.xml"
 
@@ -121,9 +124,12 @@ typedef struct stLedDefaults
     struct stLedDefaults * pNext;
 }tLedDefaults;
 
+typedef struct stDiagCache tDiagCache;
+
 typedef struct {
   xmlDocPtr      doc;
   xmlNodePtr     node;
+  tDiagCache   * cache;
   //tLedNames    * names;
   //tLedDefaults * defaults;
 }tDiagXml;
@@ -169,6 +175,7 @@ typedef struct stLedStates {
 extern tLedStates ledStates[];
 
 tDiagXml * ParseDoc(char *docname);
+tDiagXml * ParseDocXml(char *docname);
 void ParseLedDoc(char *docname, tLedBehavior * doc);
 void FreeDiagXml(tDiagXml * del);
 const char * GetStringOfId(uint32_t id, tDiagXml * xmlDoc, const char * lan);
@@ -183,5 +190,6 @@ int UpdateLedEventList(tLedBehavior * ledBehavior, tLedFiles * ledFiles, tLedEve
 void InitLedInfo(tLedInfo * ledInfo);
 void VarCopy(tLedVariables * dest,tLedVariables * src,tLedStateClass  state);
 void GetSizeOfState(tLedStateClass state, size_t * szVar);
+int ReadLedOfEvent(xmlNodePtr node, tLedInfo * info, tLedVariables * args, uint8_t * flags);
 
 #endif /* DIAGNOSTIG_XML_H_ */
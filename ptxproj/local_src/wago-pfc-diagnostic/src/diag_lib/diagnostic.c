@@ -22,12 +22,15 @@
 #include <dbus/dbus-glib-lowlevel.h>
 #include <sys/time.h>
 #include <syslog.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
 #include <stdarg.h>
 #include <string.h>
 #include <stdlib.h>
 
 #define LOG_ID_NAME_FORMAT    "ID%.8X"
-#define LOG_ID_NAME_PREALLOC  "ID00000000"
 
 typedef struct {
     log_tEventId      id;
@@ -61,19 +64,421 @@ void log_EVENT_LogId(         log_tEventId           id,
   log_EVENT_LogIdParam(id,set,LOG_TYPE_INVALID);
 }
 
+typedef struct {
+    int type;
+    union {
+      uint8_t  byte;
+      int16_t  int16;
+      uint16_t uint16;
+      int32_t  int32;
+      uint32_t uint32;
+    } value;
+}tEventArg;
+
+typedef struct {
+    log_tEventId   id;
+    com_tComBool   set;
+    struct timeval tv;
+    uint32_t       argCount;
+    tEventArg      args[LOG_EVENT_MAX_ARGS];
+}tEventRecord;
+
+/* bounded multi producer, single consumer queue; the sequence of a cell tells
+ * whether it is free for the producer at a position or filled for the sender */
+typedef struct {
+    uint64_t     sequence;
+    tEventRecord record;
+}tEventCell;
+
+typedef struct {
+    tEventCell            * cells;
+    uint64_t                mask;
+    uint32_t                maxBatch;
+    tEventRecord          * batch;
+    log_tEventQueuePolicy   policy;
+    pthread_t               thread;
+    bool                    stop;
+    /* set by the sender before it sleeps on wakeup */
+    int                     senderIdle;
+    sem_t                   wakeup;
+    pthread_mutex_t         flushLock;
+    pthread_cond_t          flushDone;
+    int                     flushWaiters;
+    uint64_t                enqueuePos  __attribute__((aligned(64)));
+    uint64_t                dequeuePos  __attribute__((aligned(64)));
+    /* position up to which events are sent and flushed */
+    uint64_t                sentPos;
+    log_tEventAsyncStats    stats;
+}tEventQueue;
+
+static tEventQueue * asyncQueue = NULL;
+
+static DBusConnection * _GetConnection(void)
+{
+  return (DBusConnection*)com_GEN_GetDBusVar((com_tConnection*) &diagnosticConnection,
+                                             DBUSVAR_CONNECTION);
+}
+
+static DBusMessage * _NewEventSignal(log_tEventId id, const struct timeval * tv,
+                                     com_tComBool set, DBusMessageIter * iter)
+{
+  char strId[16];
+  DBusMessage *message;
+
+  sprintf(strId, LOG_ID_NAME_FORMAT, id);
+  message = dbus_message_new_signal(LOG_PATH,LOG_INTERFACE, strId);
+  if(message == NULL)
+  {
+    return NULL;
+  }
+
+  dbus_message_iter_init_append (message, iter);
+
+  dbus_message_iter_append_basic (iter, COM_TYPE_TIME_T, &(tv->tv_sec));
+  dbus_message_iter_append_basic (iter, COM_TYPE_TIME_T, &(tv->tv_usec));
+  dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &(programName));
+  dbus_message_iter_append_basic (iter, DBUS_TYPE_BOOLEAN, &(set));
+  return message;
+}
+
+static void _SendEvents(tEventQueue * queue, const tEventRecord * records, uint32_t count)
+{
+  DBusConnection * connection = _GetConnection();
+  uint32_t i;
+  uint32_t j;
+
+  for(i = 0; i < count; i++)
+  {
+    DBusMessageIter iter;
+    const tEventRecord * record = &records[i];
+    DBusMessage * message = _NewEventSignal(record->id, &record->tv, record->set, &iter);
+    if(message == NULL)
+    {
+      continue;
+    }
+    for(j = 0; j < record->argCount; j++)
+    {
+      dbus_message_iter_append_basic (&iter, record->args[j].type, &record->args[j].value);
+    }
+    dbus_connection_send(connection, message, NULL);
+    dbus_message_unref(message);
+  }
+  /* one write for the whole batch instead of one per event */
+  dbus_connection_flush(connection);
+  __atomic_add_fetch(&queue->stats.sent, count, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&queue->stats.batches, 1, __ATOMIC_RELAXED);
+}
+
+static bool _Enqueue(tEventQueue * queue, const tEventRecord * record)
+{
+  uint64_t pos = __atomic_load_n(&queue->enqueuePos, __ATOMIC_RELAXED);
+  tEventCell * cell;
+
+  for(;;)
+  {
+    cell = &queue->cells[pos & queue->mask];
+    uint64_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+    int64_t diff = (int64_t)(sequence - pos);
+    if(diff == 0)
+    {
+      if(__atomic_compare_exchange_n(&queue->enqueuePos, &pos, pos + 1, true,
+                                     __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      {
+        break;
+      }
+    }
+    else if(diff < 0)
+    {
+      return false;
+    }
+    else
+    {
+      pos = __atomic_load_n(&queue->enqueuePos, __ATOMIC_RELAXED);
+    }
+  }
+
+  cell->record = *record;
+  __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+static bool _Dequeue(tEventQueue * queue, tEventRecord * record)
+{
+  uint64_t pos = queue->dequeuePos;
+  tEventCell * cell = &queue->cells[pos & queue->mask];
+
+  if(__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) != pos + 1)
+  {
+    return false;
+  }
+  *record = cell->record;
+  __atomic_store_n(&cell->sequence, pos + queue->mask + 1, __ATOMIC_RELEASE);
+  queue->dequeuePos = pos + 1;
+  return true;
+}
+
+static void _WakeSender(tEventQueue * queue)
+{
+  if(__atomic_exchange_n(&queue->senderIdle, 0, __ATOMIC_SEQ_CST))
+  {
+    sem_post(&queue->wakeup);
+  }
+}
+
+static void * _SenderThread(void * arg)
+{
+  tEventQueue * queue = arg;
+  tEventRecord * batch = queue->batch;
+  uint64_t reportedDrops = 0;
+
+  pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+
+  for(;;)
+  {
+    uint32_t count = 0;
+    while(count < queue->maxBatch && _Dequeue(queue, &batch[count]))
+    {
+      count++;
+    }
+
+    if(count > 0)
+    {
+      _SendEvents(queue, batch, count);
+      __atomic_store_n(&queue->sentPos, queue->dequeuePos, __ATOMIC_SEQ_CST);
+      if(__atomic_load_n(&queue->flushWaiters, __ATOMIC_SEQ_CST) > 0)
+      {
+        pthread_mutex_lock(&queue->flushLock);
+        pthread_cond_broadcast(&queue->flushDone);
+        pthread_mutex_unlock(&queue->flushLock);
+      }
+      continue;
+    }
+
+    uint64_t dropped = __atomic_load_n(&queue->stats.dropped, __ATOMIC_RELAXED);
+    if(dropped != reportedDrops)
+    {
+      syslog(LOG_WARNING, "%llu diagnostic events dropped, event queue full",
+             (unsigned long long)(dropped - reportedDrops));
+      reportedDrops = dropped;
+    }
+
+    if(__atomic_load_n(&queue->stop, __ATOMIC_ACQUIRE))
+    {
+      break;
+    }
+
+    /* announce the sleep, then look again so that no wakeup is lost */
+    __atomic_store_n(&queue->senderIdle, 1, __ATOMIC_SEQ_CST);
+    uint64_t pos = queue->dequeuePos;
+    if(__atomic_load_n(&queue->cells[pos & queue->mask].sequence, __ATOMIC_SEQ_CST) == pos + 1
+       || __atomic_load_n(&queue->stop, __ATOMIC_SEQ_CST))
+    {
+      __atomic_store_n(&queue->senderIdle, 0, __ATOMIC_RELAXED);
+      continue;
+    }
+    while(sem_wait(&queue->wakeup) != 0 && errno == EINTR);
+  }
+
+  return NULL;
+}
+
+static void _FlushAtExit(void)
+{
+  log_EVENT_Flush();
+}
+
+/* the sender thread does not exist in a forked child; its events belong to the parent */
+static void _ResetAfterFork(void)
+{
+  asyncQueue = NULL;
+}
+
+int log_EVENT_EnableAsync(const log_tEventAsyncConfig * config)
+{
+  static bool handlersRegistered = false;
+  uint32_t length = 1024;
+  uint64_t i;
+  tEventQueue * queue;
+
+  if(asyncQueue != NULL || libInitDone == false)
+  {
+    return -1;
+  }
+
+  queue = calloc(1, sizeof(*queue));
+  if(queue == NULL)
+  {
+    return -1;
+  }
+  if(config != NULL && config->queueLength > 0)
+  {
+    length = 2;
+    while(length < config->queueLength && length < (1U << 31))
+    {
+      length <<= 1;
+    }
+  }
+  queue->mask     = length - 1;
+  queue->maxBatch = (config != NULL && config->maxBatch > 0) ? config->maxBatch : 64;
+  queue->policy   = (config != NULL) ? config->policy : LOG_EVENT_QUEUE_DROP;
+  queue->cells    = malloc(length * sizeof(*queue->cells));
+  queue->batch    = malloc(queue->maxBatch * sizeof(*queue->batch));
+  if(queue->cells == NULL || queue->batch == NULL)
+  {
+    free(queue->cells);
+    free(queue->batch);
+    free(queue);
+    return -1;
+  }
+  for(i = 0; i < length; i++)
+  {
+    queue->cells[i].sequence = i;
+  }
+  sem_init(&queue->wakeup, 0, 0);
+  pthread_mutex_init(&queue->flushLock, NULL);
+  pthread_cond_init(&queue->flushDone, NULL);
+
+  if(pthread_create(&queue->thread, NULL, _SenderThread, queue) != 0)
+  {
+    sem_destroy(&queue->wakeup);
+    free(queue->cells);
+    free(queue->batch);
+    free(queue);
+    return -1;
+  }
+  pthread_setname_np(queue->thread, "diag_events");
+
+  if(handlersRegistered == false)
+  {
+    handlersRegistered = true;
+    atexit(_FlushAtExit);
+    pthread_atfork(NULL, NULL, _ResetAfterFork);
+  }
+  __atomic_store_n(&asyncQueue, queue, __ATOMIC_RELEASE);
+  return 0;
+}
+
+void log_EVENT_DisableAsync(void)
+{
+  tEventQueue * queue = asyncQueue;
+
+  if(queue == NULL)
+  {
+    return;
+  }
+  __atomic_store_n(&asyncQueue, NULL, __ATOMIC_RELEASE);
+  __atomic_store_n(&queue->stop, true, __ATOMIC_SEQ_CST);
+  _WakeSender(queue);
+  pthread_join(queue->thread, NULL);
+
+  sem_destroy(&queue->wakeup);
+  pthread_mutex_destroy(&queue->flushLock);
+  pthread_cond_destroy(&queue->flushDone);
+  free(queue->cells);
+  free(queue->batch);
+  free(queue);
+}
+
+void log_EVENT_Flush(void)
+{
+  tEventQueue * queue = __atomic_load_n(&asyncQueue, __ATOMIC_ACQUIRE);
+  uint64_t target;
+
+  if(queue == NULL)
+  {
+    return;
+  }
+  target = __atomic_load_n(&queue->enqueuePos, __ATOMIC_ACQUIRE);
+
+  __atomic_add_fetch(&queue->flushWaiters, 1, __ATOMIC_SEQ_CST);
+  _WakeSender(queue);
+  pthread_mutex_lock(&queue->flushLock);
+  while(__atomic_load_n(&queue->sentPos, __ATOMIC_SEQ_CST) < target)
+  {
+    pthread_cond_wait(&queue->flushDone, &queue->flushLock);
+  }
+  pthread_mutex_unlock(&queue->flushLock);
+  __atomic_sub_fetch(&queue->flushWaiters, 1, __ATOMIC_SEQ_CST);
+}
+
+void log_EVENT_GetAsyncStats(log_tEventAsyncStats * stats)
+{
+  tEventQueue * queue = __atomic_load_n(&asyncQueue, __ATOMIC_ACQUIRE);
+
+  memset(stats, 0, sizeof(*stats));
+  if(queue != NULL)
+  {
+    stats->queued  = __atomic_load_n(&queue->stats.queued, __ATOMIC_RELAXED);
+    stats->sent    = __atomic_load_n(&queue->stats.sent, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&queue->stats.dropped, __ATOMIC_RELAXED);
+    stats->batches = __atomic_load_n(&queue->stats.batches, __ATOMIC_RELAXED);
+  }
+}
+
+static void _QueueEvent(tEventQueue * queue, tEventRecord * record,
+                        int first_arg_type, va_list var_args)
+{
+  int type = first_arg_type;
+
+  record->argCount = 0;
+  while (type != LOG_TYPE_INVALID && record->argCount < LOG_EVENT_MAX_ARGS)
+  {
+    tEventArg * arg = &record->args[record->argCount];
+    arg->type = type;
+    if(type == LOG_TYPE_INT32)
+    {
+      arg->value.int32 = *va_arg(var_args, int32_t*);
+    }
+    else if(type == LOG_TYPE_UINT16)
+    {
+      arg->value.uint16 = *va_arg(var_args, uint16_t*);
+    }
+    else if(type == LOG_TYPE_UINT32)
+    {
+      arg->value.uint32 = *va_arg(var_args, uint32_t*);
+    }
+    else if(type == LOG_TYPE_INT16)
+    {
+      arg->value.int16 = *va_arg(var_args, int16_t*);
+    }
+    else if(type == LOG_TYPE_BYTE)
+    {
+      arg->value.byte = *va_arg(var_args, uint8_t*);
+    }
+    else
+    {
+      break;
+    }
+    record->argCount++;
+    type = va_arg (var_args, int);
+  }
+
+  while(_Enqueue(queue, record) == false)
+  {
+    if(queue->policy == LOG_EVENT_QUEUE_DROP)
+    {
+      __atomic_add_fetch(&queue->stats.dropped, 1, __ATOMIC_RELAXED);
+      _WakeSender(queue);
+      return;
+    }
+    _WakeSender(queue);
+    sched_yield();
+  }
+  __atomic_add_fetch(&queue->stats.queued, 1, __ATOMIC_RELAXED);
+  _WakeSender(queue);
+}
+
 void log_EVENT_LogIdParam(    log_tEventId           id,
                                    bool          set,
                                    int           first_arg_type, ...)
 {
   struct timeval tv;
-  static char strId[16] = LOG_ID_NAME_PREALLOC;
-  static uint32_t lastId = 0;
-  static const char * pId = strId ;
   com_tComBool dbSet = TRUE;
   DBusMessage *message;
   DBusMessageIter iter;
   int type;
   va_list var_args;
+  tEventQueue * queue = __atomic_load_n(&asyncQueue, __ATOMIC_ACQUIRE);
 
   gettimeofday(&tv, NULL);
   if(set == false)
@@ -81,21 +486,24 @@ void log_EVENT_LogIdParam(    log_tEventId           id,
     dbSet = FALSE;
   }
 
-  if(id != lastId)
+  if(queue != NULL)
   {
-    sprintf(strId, LOG_ID_NAME_FORMAT, id);
-    lastId = id;
+    tEventRecord record;
+    record.id  = id;
+    record.set = dbSet;
+    record.tv  = tv;
+    va_start (var_args, first_arg_type);
+    _QueueEvent(queue, &record, first_arg_type, var_args);
+    va_end(var_args);
+    return;
   }
-  message = dbus_message_new_signal(LOG_PATH,LOG_INTERFACE, pId);
-
-
 
-  dbus_message_iter_init_append (message, &iter);
+  message = _NewEventSignal(id, &tv, dbSet, &iter);
+  if(message == NULL)
+  {
+    return;
+  }
 
-  dbus_message_iter_append_basic (&iter, COM_TYPE_TIME_T, &(tv.tv_sec));
-  dbus_message_iter_append_basic (&iter, COM_TYPE_TIME_T, &(tv.tv_usec));
-  dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &(programName));
-  dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &(dbSet));
   if(first_arg_type != LOG_TYPE_INVALID)
   {
     va_start (var_args, first_arg_type);
@@ -136,12 +544,8 @@ void log_EVENT_LogIdParam(    log_tEventId           id,
     va_end(var_args);
   }
   (void)com_GEN_BlockThreadCancelling();
-  dbus_connection_send(
-      (DBusConnection*)com_GEN_GetDBusVar((com_tConnection*) &diagnosticConnection,
-                                          DBUSVAR_CONNECTION),
-      message, NULL);
-  dbus_connection_flush((DBusConnection*)com_GEN_GetDBusVar((com_tConnection*) &diagnosticConnection,
-                                                            DBUSVAR_CONNECTION));
+  dbus_connection_send(_GetConnection(), message, NULL);
+  dbus_connection_flush(_GetConnection());
   (void)com_GEN_UnblockThreadCancelling();
   dbus_message_unref(message);
 }
@@ -0,0 +1,672 @@
+//------------------------------------------------------------------------------
+/// Copyright (c) WAGO GmbH & Co. KG
+///
+/// PROPRIETARY RIGHTS are involved in the subject matter of this material. All
+/// manufacturing, reproduction, use, and sales rights pertaining to this
+/// subject matter are governed by the license agreement. The recipient of this
+/// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///
+///  \file     diagnostic_cache.c
+///
+///  \brief    Compiles a diagnostic XML description into a binary table and
+///            looks up texts and LED descriptions of event ids in it.
+///
+///  \author   WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <glib.h>
+#include "diagnostic_cache.h"
+
+#define DIAG_ID_SAVE_PERS 0x80000000
+#define DIAG_ID_SAVE_NO   0x40000000
+
+#define CACHE_ALIGN(x) (((x) + 7U) & ~7U)
+
+struct stDiagCache {
+    void                   * map;
+    size_t                   size;
+    const tDiagCacheHeader * header;
+    const tDiagCacheEvent  * events;
+    const tDiagCacheText   * texts;
+    const tDiagCacheLed    * leds;
+    const char             * strings;
+};
+
+/* event of the compiler, with its position in the document for a stable sort */
+typedef struct {
+    tDiagCacheEvent event;
+    uint32_t        order;
+}tCompileEvent;
+
+typedef struct {
+    GString    * strings;
+    GHashTable * interned;
+    GArray     * events;
+    GArray     * texts;
+    GArray     * leds;
+}tCompiler;
+
+static void _SetSource(tDiagCacheSource * source, const struct stat * st)
+{
+  memset(source, 0, sizeof(*source));
+  source->size      = (uint64_t)st->st_size;
+  source->mtimeSec  = (int64_t)st->st_mtim.tv_sec;
+  source->mtimeNsec = (int64_t)st->st_mtim.tv_nsec;
+  source->inode     = (uint64_t)st->st_ino;
+}
+
+void DIAGCACHE_GetCachePath(const char * xmlPath, char * cachePath, size_t size)
+{
+  char * p;
+
+  snprintf(cachePath, size, DIAGNOSTIC_CACHE_DIR "/%s.idx", xmlPath);
+  /* the whole source path becomes one file name */
+  for(p = cachePath + strlen(DIAGNOSTIC_CACHE_DIR) + 1; *p != 0; p++)
+  {
+    if(*p == '/')
+    {
+      *p = '_';
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// compiler
+//------------------------------------------------------------------------------
+static uint32_t _Intern(tCompiler * compiler, const char * str)
+{
+  gpointer offset;
+
+  if(str == NULL || *str == 0)
+  {
+    return 0;
+  }
+  if(g_hash_table_lookup_extended(compiler->interned, str, NULL, &offset))
+  {
+    return GPOINTER_TO_UINT(offset);
+  }
+  offset = GUINT_TO_POINTER(compiler->strings->len);
+  g_string_append_len(compiler->strings, str, (gssize)strlen(str) + 1);
+  g_hash_table_insert(compiler->interned, g_strdup(str), offset);
+  return GPOINTER_TO_UINT(offset);
+}
+
+static tDiagCacheText * _GetText(tCompiler * compiler, uint32_t firstText, uint32_t lan)
+{
+  guint i;
+
+  for(i = firstText; i < compiler->texts->len; i++)
+  {
+    tDiagCacheText * text = &g_array_index(compiler->texts, tDiagCacheText, i);
+    if(text->lan == lan)
+    {
+      return text;
+    }
+  }
+  {
+    tDiagCacheText text = { .lan = lan, .string = 0, .reset = 0 };
+    g_array_append_val(compiler->texts, text);
+  }
+  return &g_array_index(compiler->texts, tDiagCacheText, compiler->texts->len - 1);
+}
+
+/* first <string> and first <rststr> of an event, like GetStringOfId and GetResetStringOfId */
+static void _CompileTexts(tCompiler * compiler, xmlDocPtr doc, xmlNodePtr node, tDiagCacheEvent * event)
+{
+  bool haveString = false;
+  bool haveReset  = false;
+
+  event->firstText = compiler->texts->len;
+  for(node = xmlFirstElementChild(node); node != NULL; node = xmlNextElementSibling(node))
+  {
+    bool reset;
+    xmlNodePtr lanNode;
+
+    if(!haveString && !xmlStrcmp(node->name, (const xmlChar *)"string"))
+    {
+      haveString = true;
+      reset = false;
+    }
+    else if(!haveReset && !xmlStrcmp(node->name, (const xmlChar *)"rststr"))
+    {
+      haveReset = true;
+      reset = true;
+    }
+    else
+    {
+      continue;
+    }
+
+    for(lanNode = node->xmlChildrenNode; lanNode != NULL; lanNode = lanNode->next)
+    {
+      tDiagCacheText * text;
+      xmlChar * str;
+
+      if(lanNode->type != XML_ELEMENT_NODE)
+      {
+        continue;
+      }
+      text = _GetText(compiler, event->firstText, _Intern(compiler, (const char *)lanNode->name));
+      if((reset ? text->reset : text->string) != 0)
+      {
+        continue;
+      }
+      str = xmlNodeListGetString(doc, lanNode->xmlChildrenNode, 1);
+      if(str != NULL)
+      {
+        if(reset)
+        {
+          text->reset = _Intern(compiler, (const char *)str);
+        }
+        else
+        {
+          text->string = _Intern(compiler, (const char *)str);
+        }
+        xmlFree(str);
+      }
+    }
+  }
+  event->textCount = compiler->texts->len - event->firstText;
+}
+
+static void _CompileLeds(tCompiler * compiler, xmlNodePtr node, uint32_t id)
+{
+  for(node = xmlFirstElementChild(node); node != NULL; node = xmlNextElementSibling(node))
+  {
+    xmlChar * name;
+    tLedInfo info;
+    tLedVariables args;
+    uint8_t flags;
+
+    if(xmlStrcmp(node->name, (const xmlChar *)"led"))
+    {
+      continue;
+    }
+    name = xmlGetProp(node, (xmlChar*)"name");
+    if(name == NULL)
+    {
+      continue;
+    }
+    if(!ReadLedOfEvent(node, &info, &args, &flags))
+    {
+      tDiagCacheLed led;
+      memset(&led, 0, sizeof(led));
+      led.id    = id;
+      led.name  = _Intern(compiler, (const char *)name);
+      led.state = (int32_t)info.state;
+      led.flags = flags;
+      VarCopy(&led.vars, &info.vars, info.state);
+      VarCopy(&led.args, &args, info.state);
+      g_array_append_val(compiler->leds, led);
+    }
+    xmlFree(name);
+  }
+}
+
+static void _CompileEvent(tCompiler * compiler, xmlDocPtr doc, xmlNodePtr node, uint32_t range)
+{
+  xmlChar * idStr = xmlGetProp(node, (xmlChar*)"id");
+  xmlChar * persistentStr;
+  tCompileEvent event;
+
+  if(idStr == NULL)
+  {
+    return;
+  }
+  memset(&event, 0, sizeof(event));
+  event.event.id = range | strtol((char*)idStr+1, NULL, 16);
+  xmlFree(idStr);
+
+  persistentStr = xmlGetProp(node, (xmlChar*)"persistent");
+  if(persistentStr != NULL)
+  {
+    if ((!xmlStrcmp(persistentStr, (const xmlChar *)"yes")))
+    {
+      event.event.id |= DIAG_ID_SAVE_PERS;
+    }
+    else if ((!xmlStrcmp(persistentStr, (const xmlChar *)"none")))
+    {
+      event.event.id |= DIAG_ID_SAVE_NO;
+    }
+    xmlFree(persistentStr);
+  }
+
+  _CompileTexts(compiler, doc, node, &event.event);
+  _CompileLeds(compiler, node, event.event.id);
+  event.order = compiler->events->len;
+  g_array_append_val(compiler->events, event);
+}
+
+static gint _CompareEvents(gconstpointer a, gconstpointer b)
+{
+  const tCompileEvent * ea = a;
+  const tCompileEvent * eb = b;
+  uint32_t ida = ea->event.id & DIAG_ID_MASK;
+  uint32_t idb = eb->event.id & DIAG_ID_MASK;
+
+  if(ida != idb)
+  {
+    return (ida < idb) ? -1 : 1;
+  }
+  return (ea->order < eb->order) ? -1 : (ea->order > eb->order);
+}
+
+static int _WriteAll(int fd, const void * data, size_t size)
+{
+  const char * p = data;
+
+  while(size > 0)
+  {
+    ssize_t written = write(fd, p, size);
+    if(written < 0)
+    {
+      if(errno == EINTR)
+      {
+        continue;
+      }
+      return -1;
+    }
+    p += written;
+    size -= (size_t)written;
+  }
+  return 0;
+}
+
+static int _WriteSection(int fd, uint32_t * pos, const void * data, size_t size)
+{
+  static const char padding[8];
+  uint32_t aligned = CACHE_ALIGN(*pos);
+
+  if(_WriteAll(fd, padding, aligned - *pos) || _WriteAll(fd, data, size))
+  {
+    return -1;
+  }
+  *pos = aligned + (uint32_t)size;
+  return 0;
+}
+
+static int _WriteCache(tCompiler * compiler, const struct stat * st, const char * cachePath)
+{
+  tDiagCacheHeader header;
+  tDiagCacheEvent * events;
+  char tmpPath[4096];
+  uint32_t pos;
+  guint i;
+  int fd;
+  int ret = -1;
+
+  events = malloc((compiler->events->len + 1) * sizeof(*events));
+  if(events == NULL)
+  {
+    return -1;
+  }
+  for(i = 0; i < compiler->events->len; i++)
+  {
+    events[i] = g_array_index(compiler->events, tCompileEvent, i).event;
+  }
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, DIAGNOSTIC_CACHE_MAGIC, sizeof(header.magic));
+  header.version     = DIAGNOSTIC_CACHE_VERSION;
+  header.headerSize  = sizeof(header);
+  _SetSource(&header.source, st);
+  header.eventCount  = compiler->events->len;
+  header.textCount   = compiler->texts->len;
+  header.ledCount    = compiler->leds->len;
+  header.stringsSize = compiler->strings->len;
+
+  pos = sizeof(header);
+  header.eventsOffset  = CACHE_ALIGN(pos);
+  pos = header.eventsOffset + header.eventCount * sizeof(tDiagCacheEvent);
+  header.textsOffset   = CACHE_ALIGN(pos);
+  pos = header.textsOffset + header.textCount * sizeof(tDiagCacheText);
+  header.ledsOffset    = CACHE_ALIGN(pos);
+  pos = header.ledsOffset + header.ledCount * sizeof(tDiagCacheLed);
+  header.stringsOffset = CACHE_ALIGN(pos);
+
+  /* written next to the table and renamed, readers never see a partial file */
+  snprintf(tmpPath, sizeof(tmpPath), "%s.XXXXXX", cachePath);
+  fd = mkstemp(tmpPath);
+  if(fd < 0)
+  {
+    free(events);
+    return -1;
+  }
+  pos = 0;
+  if(   !_WriteSection(fd, &pos, &header, sizeof(header))
+     && !_WriteSection(fd, &pos, events, header.eventCount * sizeof(tDiagCacheEvent))
+     && !_WriteSection(fd, &pos, compiler->texts->data, header.textCount * sizeof(tDiagCacheText))
+     && !_WriteSection(fd, &pos, compiler->leds->data, header.ledCount * sizeof(tDiagCacheLed))
+     && !_WriteSection(fd, &pos, compiler->strings->str, header.stringsSize)
+     && !fchmod(fd, 0644))
+  {
+    ret = 0;
+  }
+  if(close(fd) || ret || rename(tmpPath, cachePath))
+  {
+    unlink(tmpPath);
+    ret = -1;
+  }
+  free(events);
+  return ret;
+}
+
+int DIAGCACHE_Compile(const char * xmlPath, const char * cachePath)
+{
+  tCompiler compiler;
+  struct stat st;
+  xmlDocPtr doc;
+  xmlNodePtr root;
+  xmlNodePtr classNode;
+  int ret;
+
+  /* taken before parsing: a change while parsing makes the table stale */
+  if(stat(xmlPath, &st))
+  {
+    return -1;
+  }
+  doc = xmlParseFile(xmlPath);
+  if(doc == NULL)
+  {
+    return -1;
+  }
+  root = xmlDocGetRootElement(doc);
+  if(root == NULL || xmlStrcmp(root->name, (const xmlChar *) "diagnostic"))
+  {
+    xmlFreeDoc(doc);
+    return -1;
+  }
+
+  compiler.strings  = g_string_new_len("", 1);
+  compiler.interned = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  compiler.events   = g_array_new(FALSE, FALSE, sizeof(tCompileEvent));
+  compiler.texts    = g_array_new(FALSE, FALSE, sizeof(tDiagCacheText));
+  compiler.leds     = g_array_new(FALSE, FALSE, sizeof(tDiagCacheLed));
+
+  for(classNode = xmlFirstElementChild(root); classNode != NULL; classNode = xmlNextElementSibling(classNode))
+  {
+    xmlChar * rangeStr;
+    xmlNodePtr eventNode;
+    uint32_t range;
+
+    if(xmlStrcmp(classNode->name, (const xmlChar *)"eventclass"))
+    {
+      continue;
+    }
+    rangeStr = xmlGetProp(classNode, (xmlChar*)"class_range");
+    if(rangeStr == NULL)
+    {
+      continue;
+    }
+    range = strtol((char*)rangeStr+1, NULL, 16) << 16;
+    xmlFree(rangeStr);
+
+    for(eventNode = xmlFirstElementChild(classNode); eventNode != NULL; eventNode = xmlNextElementSibling(eventNode))
+    {
+      if(!xmlStrcmp(eventNode->name, (const xmlChar *)"event"))
+      {
+        _CompileEvent(&compiler, doc, eventNode, range);
+      }
+    }
+  }
+  xmlFreeDoc(doc);
+
+  g_array_sort(compiler.events, _CompareEvents);
+  ret = _WriteCache(&compiler, &st, cachePath);
+
+  g_string_free(compiler.strings, TRUE);
+  g_hash_table_destroy(compiler.interned);
+  g_array_free(compiler.events, TRUE);
+  g_array_free(compiler.texts, TRUE);
+  g_array_free(compiler.leds, TRUE);
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+// loader
+//------------------------------------------------------------------------------
+static bool _SectionValid(const tDiagCache * cache, uint32_t offset, uint32_t count, size_t size)
+{
+  return    (offset % 8 == 0)
+         && (offset <= cache->size)
+         && ((uint64_t)count * size <= cache->size - offset);
+}
+
+static bool _TableValid(const tDiagCache * cache, const struct stat * source)
+{
+  const tDiagCacheHeader * header = cache->header;
+  tDiagCacheSource expected;
+  uint32_t i;
+
+  _SetSource(&expected, source);
+  if(   cache->size < sizeof(*header)
+     || memcmp(header->magic, DIAGNOSTIC_CACHE_MAGIC, sizeof(header->magic))
+     || header->version != DIAGNOSTIC_CACHE_VERSION
+     || header->headerSize != sizeof(*header)
+     || memcmp(&header->source, &expected, sizeof(expected))
+     || !_SectionValid(cache, header->eventsOffset, header->eventCount, sizeof(tDiagCacheEvent))
+     || !_SectionValid(cache, header->textsOffset, header->textCount, sizeof(tDiagCacheText))
+     || !_SectionValid(cache, header->ledsOffset, header->ledCount, sizeof(tDiagCacheLed))
+     || !_SectionValid(cache, header->stringsOffset, header->stringsSize, 1)
+     || header->stringsSize == 0
+     || cache->strings[header->stringsSize - 1] != 0)
+  {
+    return false;
+  }
+
+  /* all references stay inside the table, lookups need no further checks */
+  for(i = 0; i < header->eventCount; i++)
+  {
+    if(   cache->events[i].firstText > header->textCount
+       || cache->events[i].textCount > header->textCount - cache->events[i].firstText)
+    {
+      return false;
+    }
+  }
+  for(i = 0; i < header->textCount; i++)
+  {
+    if(   cache->texts[i].lan >= header->stringsSize
+       || cache->texts[i].string >= header->stringsSize
+       || cache->texts[i].reset >= header->stringsSize)
+    {
+      return false;
+    }
+  }
+  for(i = 0; i < header->ledCount; i++)
+  {
+    if(cache->leds[i].name >= header->stringsSize)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static tDiagCache * _Map(const char * cachePath, const struct stat * source)
+{
+  tDiagCache * cache;
+  struct stat st;
+  int fd = open(cachePath, O_RDONLY | O_CLOEXEC);
+
+  if(fd < 0)
+  {
+    return NULL;
+  }
+  if(fstat(fd, &st) || st.st_size < (off_t)sizeof(tDiagCacheHeader))
+  {
+    close(fd);
+    return NULL;
+  }
+  cache = calloc(1, sizeof(*cache));
+  if(cache == NULL)
+  {
+    close(fd);
+    return NULL;
+  }
+  cache->size = (size_t)st.st_size;
+  cache->map = mmap(NULL, cache->size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(cache->map == MAP_FAILED)
+  {
+    free(cache);
+    return NULL;
+  }
+
+  cache->header  = cache->map;
+  cache->events  = (const tDiagCacheEvent *)((const char *)cache->map + cache->header->eventsOffset);
+  cache->texts   = (const tDiagCacheText *)((const char *)cache->map + cache->header->textsOffset);
+  cache->leds    = (const tDiagCacheLed *)((const char *)cache->map + cache->header->ledsOffset);
+  cache->strings = (const char *)cache->map + cache->header->stringsOffset;
+  if(!_TableValid(cache, source))
+  {
+    DIAGCACHE_Close(cache);
+    return NULL;
+  }
+  return cache;
+}
+
+tDiagCache * DIAGCACHE_Open(const char * xmlPath)
+{
+  char cachePath[4096];
+  tDiagCache * cache;
+  struct stat st;
+
+  if(stat(xmlPath, &st))
+  {
+    return NULL;
+  }
+  DIAGCACHE_GetCachePath(xmlPath, cachePath, sizeof(cachePath));
+
+  cache = _Map(cachePath, &st);
+  if(cache == NULL)
+  {
+    /* missing or stale: compile it; the caller falls back to the XML if that fails */
+    (void)mkdir(DIAGNOSTIC_CACHE_DIR, 0755);
+    if(!DIAGCACHE_Compile(xmlPath, cachePath))
+    {
+      cache = _Map(cachePath, &st);
+    }
+  }
+  return cache;
+}
+
+void DIAGCACHE_Close(tDiagCache * cache)
+{
+  if(cache != NULL)
+  {
+    munmap(cache->map, cache->size);
+    free(cache);
+  }
+}
+
+//------------------------------------------------------------------------------
+// lookup
+//------------------------------------------------------------------------------
+static const tDiagCacheEvent * _FindEvent(tDiagCache * cache, uint32_t id)
+{
+  uint32_t key = id & DIAG_ID_MASK;
+  uint32_t lo = 0;
+  uint32_t hi = cache->header->eventCount;
+
+  /* first event of the id, like the document walk of GetStringOfId */
+  while(lo < hi)
+  {
+    uint32_t mid = lo + (hi - lo) / 2;
+    if((cache->events[mid].id & DIAG_ID_MASK) < key)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  if(lo < cache->header->eventCount && (cache->events[lo].id & DIAG_ID_MASK) == key)
+  {
+    return &cache->events[lo];
+  }
+  return NULL;
+}
+
+static const char * _GetEventText(tDiagCache * cache, uint32_t id, const char * lan, bool reset)
+{
+  const tDiagCacheEvent * event = _FindEvent(cache, id);
+  uint32_t match = 0;
+  uint32_t fallback = 0;
+  uint32_t i;
+
+  if(event == NULL)
+  {
+    return NULL;
+  }
+  if(lan == NULL)
+  {
+    lan = diagnostic_xml_default_lan;
+  }
+  for(i = event->firstText; i < event->firstText + event->textCount; i++)
+  {
+    const tDiagCacheText * text = &cache->texts[i];
+    uint32_t offset = reset ? text->reset : text->string;
+    const char * textLan = cache->strings + text->lan;
+
+    if(!strcmp(textLan, lan))
+    {
+      match = offset;
+    }
+    if(!strcmp(textLan, diagnostic_xml_default_lan))
+    {
+      fallback = offset;
+    }
+  }
+  if(match == 0)
+  {
+    match = fallback;
+  }
+  return (match != 0) ? cache->strings + match : NULL;
+}
+
+const char * DIAGCACHE_GetString(tDiagCache * cache, uint32_t id, const char * lan)
+{
+  return _GetEventText(cache, id, lan, false);
+}
+
+const char * DIAGCACHE_GetResetString(tDiagCache * cache, uint32_t id, const char * lan)
+{
+  return _GetEventText(cache, id, lan, true);
+}
+
+uint32_t DIAGCACHE_GetEventCount(tDiagCache * cache)
+{
+  return cache->header->eventCount;
+}
+
+uint32_t DIAGCACHE_GetEventId(tDiagCache * cache, uint32_t index)
+{
+  return cache->events[index].id;
+}
+
+uint32_t DIAGCACHE_GetLedCount(tDiagCache * cache)
+{
+  return cache->header->ledCount;
+}
+
+const tDiagCacheLed * DIAGCACHE_GetLed(tDiagCache * cache, uint32_t index)
+{
+  return &cache->leds[index];
+}
+
+const char * DIAGCACHE_GetName(tDiagCache * cache, const tDiagCacheLed * led)
+{
+  return cache->strings + led->name;
+}
+//---- End of source file ------------------------------------------------------
@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include <sys/stat.h>
 #include "diagnostic_xml.h"
+#include "diagnostic_cache.h"
 #include <libxml/xmlmemory.h>
 #include <libxml/parser.h>
 #include <libxml/tree.h>
@@ -23,6 +24,8 @@
 
 const char diagnostic_xml_default_lan[] = "en";
 tLedFiles * pActualFile = NULL;
+/* id -> element of the event list while a file is read into it */
+static GHashTable * ledIndex = NULL;
 
 #define DIAG_ID_SAVE_PERS 0x80000000
 #define DIAG_ID_SAVE_NO   0x40000000
@@ -84,7 +87,14 @@ void FreeDiagXml(tDiagXml * del)
 {
   if(del != NULL)
   {
-    xmlFreeDoc(del->doc);
+    if(del->cache != NULL)
+    {
+      DIAGCACHE_Close(del->cache);
+    }
+    if(del->doc != NULL)
+    {
+      xmlFreeDoc(del->doc);
+    }
     free(del);
   }
 }
@@ -231,6 +241,35 @@ int GetRoot(tDiagXml * doc)
 }
 
 tDiagXml * ParseDoc(char *docname)
+{
+  tDiagXml * ret = NULL;
+  tDiagCache * cache;
+
+  if(access(docname, F_OK))
+  {
+    return NULL;
+  }
+
+  cache = DIAGCACHE_Open(docname);
+  if(cache == NULL)
+  {
+    return ParseDocXml(docname);
+  }
+
+  ret = malloc(sizeof(tDiagXml));
+  if(ret == NULL)
+  {
+    DIAGCACHE_Close(cache);
+    return NULL;
+  }
+  ret->doc   = NULL;
+  ret->node  = NULL;
+  ret->cache = cache;
+
+  return ret;
+}
+
+tDiagXml * ParseDocXml(char *docname)
 {
 
   tDiagXml * ret = NULL;
@@ -248,6 +287,7 @@ tDiagXml * ParseDoc(char *docname)
 
   ret->doc      = NULL;
   ret->node     = NULL;
+  ret->cache    = NULL;
 
   ret->doc = xmlParseFile(docname);
 
@@ -575,6 +615,10 @@ const char * GetStringOfId(uint32_t id, tDiagXml * xmlDoc, const char * lan)
   {
     return NULL;
   }
+  if(xmlDoc->cache != NULL)
+  {
+    return DIAGCACHE_GetString(xmlDoc->cache, id, lan);
+  }
   ok = _GoToEvent(id, xmlDoc);
   if(!ok)
   {
@@ -602,6 +646,10 @@ const char * GetResetStringOfId(uint32_t id, tDiagXml * xmlDoc, const char * lan
   int ok = 0;
   char * lanPtr = (char*)lan;
 
+  if(xmlDoc->cache != NULL)
+  {
+    return DIAGCACHE_GetResetString(xmlDoc->cache, id, lan);
+  }
   ok = _GoToEvent(id, xmlDoc);
 
   if(!ok)
@@ -953,13 +1001,20 @@ static tLedEventList * _GetLedElement(tLedEventList ** pledList,uint32_t id)
   tLedEventList * pAct = *pledList;
   tLedEventList * res = NULL;
 
-  while(pAct != NULL)
+  if(ledIndex != NULL)
   {
-    if(pAct->info.idInfo.id == id)
+    pAct = g_hash_table_lookup(ledIndex, GUINT_TO_POINTER(id));
+  }
+  else
+  {
+    while(pAct != NULL)
     {
-      break;
+      if(pAct->info.idInfo.id == id)
+      {
+        break;
+      }
+      pAct = pAct->pNext;
     }
-    pAct = pAct->pNext;
   }
   res = pAct;
 
@@ -974,6 +1029,10 @@ static tLedEventList * _GetLedElement(tLedEventList ** pledList,uint32_t id)
     res->pNext = *pledList;
     res->info.flags = LED_FLAG_EVENT_NEW;
     *pledList = res;
+    if(ledIndex != NULL)
+    {
+      g_hash_table_insert(ledIndex, GUINT_TO_POINTER(id), res);
+    }
   }
 
   return res;
@@ -1033,101 +1092,118 @@ void VarCopy(tLedVariables * dest,tLedVariables * src,tLedStateClass  state)
 }
 
 
-static void _EventListReadLed(uint32_t id, tLedBehavior * ledBehavior, xmlNodePtr node, tLedEventList ** pledList)
+/* reads state, default behaviour and arguments of a <led> element of an event */
+int ReadLedOfEvent(xmlNodePtr node, tLedInfo * info, tLedVariables * args, uint8_t * flags)
 {
-  xmlChar * ledName    = xmlGetProp(node, (xmlChar*)"name");
   xmlChar * ledState   = xmlGetProp(node, (xmlChar*)"state");
   xmlChar * ledDefault = xmlGetProp(node, (xmlChar*)"default");
-  int ledNr = -1;
-  tLedInfo   info;
-  tLedVariables args;
-  uint8_t         flags = 0;
-  tLedNames * ledEventName = NULL;
-
-  InitLedInfo(&info);
-
-  //testcode
-  if(ledName != NULL && ledNr == -1)
-  {
-    tLedNames * ledNames = ledBehavior->names;
-    while(ledNames != NULL)
-    {
-      if ((!xmlStrcmp(ledName, (const xmlChar *)ledNames->ledName)))
-      {
-        ledNr = ledNames->ledNr;
-        ledEventName = ledNames;
-        break;
-      }
-      else if(ledNames->alias != NULL)
-      {
-        tLedAlias * alias = ledNames->alias;
-        do{
-          if ((!xmlStrcmp(ledName, (const xmlChar *)alias->alias)))
-          {
-            ledNr = ledNames->ledNr;
-            ledEventName = ledNames;
-            break;
-          }
-          alias = alias->pNext;
-        }while(alias != NULL);
-      }
-      ledNames = ledNames->pNext;
-    }
-    //free(ledName);
-  }
 
+  InitLedInfo(info);
+  memset(args, 0, sizeof(*args));
+  *flags = 0;
 
   if(ledState != NULL)
   {
-    GetLedStateAndColorFromString((char*)ledState,&info);
+    GetLedStateAndColorFromString((char*)ledState,info);
     xmlFree(ledState);
   }
 
   if(ledDefault != NULL)
   {
-    flags |= LED_FLAG_SET_TO_DEFAULT;
+    *flags |= LED_FLAG_SET_TO_DEFAULT;
     if ((!xmlStrcmp(ledDefault, (const xmlChar*) "only")))
     {
-      flags |= LED_FLAG_DEFAULT_NOT_ADOPT;
+      *flags |= LED_FLAG_DEFAULT_NOT_ADOPT;
     }
     xmlFree(ledDefault);
   }
 
-  if((   (info.state == LED_STATE_STATIC)
-      || (info.state == LED_STATE_BLINK)
-      || (info.state == LED_STATE_FLASH)
-      || (info.state == LED_STATE_750_ERR)
-      || (info.state == LED_STATE_CAN))
-      && (ledNr != -1)
-     )
+  if(   (info->state != LED_STATE_STATIC)
+     && (info->state != LED_STATE_BLINK)
+     && (info->state != LED_STATE_FLASH)
+     && (info->state != LED_STATE_750_ERR)
+     && (info->state != LED_STATE_CAN))
   {
-    tLedEventList * newEvent = NULL;
-    if(_ReadLedArguments(info.state, node, &info,&args))
-    {
-      return;
-    }
-    if(ledEventName == NULL)
+    return -1;
+  }
+
+  if(_ReadLedArguments(info->state, node, info, args))
+  {
+    return -1;
+  }
+  return 0;
+}
+
+static void _EventListAddLed(uint32_t id, tLedBehavior * ledBehavior, const char * ledName,
+                             tLedInfo * info, tLedVariables * args, uint8_t flags,
+                             tLedEventList ** pledList)
+{
+  int ledNr = -1;
+  tLedNames * ledEventName = NULL;
+  tLedNames * ledNames = ledBehavior->names;
+  tLedEventList * newEvent = NULL;
+
+  while(ledNames != NULL)
+  {
+    if ((!xmlStrcmp((const xmlChar *)ledName, (const xmlChar *)ledNames->ledName)))
     {
-      return;
+      ledNr = ledNames->ledNr;
+      ledEventName = ledNames;
+      break;
     }
-    newEvent = _GetLedElement(pledList,id);
-    if(newEvent == NULL)
+    else if(ledNames->alias != NULL)
     {
-      return;
+      tLedAlias * alias = ledNames->alias;
+      do{
+        if ((!xmlStrcmp((const xmlChar *)ledName, (const xmlChar *)alias->alias)))
+        {
+          ledNr = ledNames->ledNr;
+          ledEventName = ledNames;
+          break;
+        }
+        alias = alias->pNext;
+      }while(alias != NULL);
     }
-    newEvent->info.idInfo.id    = id;
-    newEvent->ledNr = ledNr;
-    newEvent->ledName = strdup((char*)ledEventName->ledName);
-    xmlFree(ledName);
-    newEvent->alias = _CopyAlias(ledEventName->alias);
-    newEvent->info.state = info.state;
-    VarCopy(&(newEvent->info.vars),&(info.vars),info.state);
-    VarCopy(&(newEvent->args),&(args),info.state);
-    newEvent->info.flags &= LED_FLAG_EVENT_NEW;
-    newEvent->info.flags |= flags | LED_FLAG_EVENT_MODIFIED;
-    newEvent->file = pActualFile;
+    ledNames = ledNames->pNext;
+  }
+
+  if(ledNr == -1 || ledEventName == NULL)
+  {
+    return;
+  }
+  newEvent = _GetLedElement(pledList,id);
+  if(newEvent == NULL)
+  {
+    return;
+  }
+  newEvent->info.idInfo.id    = id;
+  newEvent->ledNr = ledNr;
+  newEvent->ledName = strdup((char*)ledEventName->ledName);
+  newEvent->alias = _CopyAlias(ledEventName->alias);
+  newEvent->info.state = info->state;
+  VarCopy(&(newEvent->info.vars),&(info->vars),info->state);
+  VarCopy(&(newEvent->args),args,info->state);
+  newEvent->info.flags &= LED_FLAG_EVENT_NEW;
+  newEvent->info.flags |= flags | LED_FLAG_EVENT_MODIFIED;
+  newEvent->file = pActualFile;
+}
+
+static void _EventListReadLed(uint32_t id, tLedBehavior * ledBehavior, xmlNodePtr node, tLedEventList ** pledList)
+{
+  xmlChar * ledName = xmlGetProp(node, (xmlChar*)"name");
+  tLedInfo info;
+  tLedVariables args;
+  uint8_t flags;
 
+  if(ledName == NULL)
+  {
+    return;
+  }
+  if(!ReadLedOfEvent(node, &info, &args, &flags))
+  {
+    _EventListAddLed(id, ledBehavior, (const char*)ledName, &info, &args, flags, pledList);
   }
+  xmlFree(ledName);
 }
 
 static void _EventListReadEvent(uint32_t range, tLedBehavior * ledBehavior,xmlNodePtr node,tLedEventList ** pledList)
@@ -1184,7 +1260,7 @@ static void _EventListReadClass(tLedBehavior * ledBehavior,xmlNodePtr node, tLed
    }
 }
 
-static void _ReadFileForList(tLedBehavior * ledBehavior,const char * filename, tLedEventList ** pledList)
+static void _ReadXmlForList(tLedBehavior * ledBehavior,const char * filename, tLedEventList ** pledList)
 {
   xmlTextReaderPtr reader;
   int (*pXmlReadFct)(xmlTextReaderPtr reader) = xmlTextReaderRead;
@@ -1223,6 +1299,56 @@ static void _ReadFileForList(tLedBehavior * ledBehavior,const char * filename, t
   }
 }
 
+static void _ReadCacheForList(tLedBehavior * ledBehavior, tDiagCache * cache, tLedEventList ** pledList)
+{
+  uint32_t count = DIAGCACHE_GetLedCount(cache);
+  uint32_t i;
+
+  for(i = 0; i < count; i++)
+  {
+    const tDiagCacheLed * led = DIAGCACHE_GetLed(cache, i);
+    tLedInfo info;
+    tLedVariables args;
+
+    InitLedInfo(&info);
+    info.state = (tLedStateClass)led->state;
+    info.vars  = led->vars;
+    args       = led->args;
+    _EventListAddLed(led->id, ledBehavior, DIAGCACHE_GetName(cache, led), &info, &args,
+                     (uint8_t)led->flags, pledList);
+  }
+}
+
+static void _ReadFileForList(tLedBehavior * ledBehavior,const char * filename, tLedEventList ** pledList)
+{
+  tDiagCache * cache = DIAGCACHE_Open(filename);
+  tLedEventList * pAct;
+
+  ledIndex = g_hash_table_new(g_direct_hash, g_direct_equal);
+  /* the first element of an id wins, like in the list search */
+  for(pAct = *pledList; pAct != NULL; pAct = pAct->pNext)
+  {
+    gpointer key = GUINT_TO_POINTER(pAct->info.idInfo.id);
+    if(g_hash_table_lookup(ledIndex, key) == NULL)
+    {
+      g_hash_table_insert(ledIndex, key, pAct);
+    }
+  }
+
+  if(cache != NULL)
+  {
+    _ReadCacheForList(ledBehavior, cache, pledList);
+    DIAGCACHE_Close(cache);
+  }
+  else
+  {
+    _ReadXmlForList(ledBehavior, filename, pledList);
+  }
+
+  g_hash_table_destroy(ledIndex);
+  ledIndex = NULL;
+}
+
 int CreateLedEventList(tLedBehavior * ledBehavior, tLedFiles * ledFiles, tLedEventList ** ledEvents)
 {
   assert(ledBehavior);
@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------
+/// Copyright (c) WAGO GmbH & Co. KG
+///
+/// PROPRIETARY RIGHTS are involved in the subject matter of this material.
+/// All manufacturing, reproduction, use and sales rights pertaining to this
+/// subject matter are governed by the license agreement. The recipient of this
+/// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///
+///  \file     cachebench.c
+///
+///  \brief    Load time and text lookups per second of a diagnostic XML file,
+///            parsed and through the compiled table. All texts of both are
+///            compared first.
+///
+///            usage: diagcachebench [xml file [lookups]]
+///
+///  \author   WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "diagnostic_xml.h"
+#include "diagnostic_cache.h"
+
+static const char * lans[] = { "en", "de", "xx" };
+
+static double _Now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int _Compare(const char * a, const char * b)
+{
+  if(a == NULL || b == NULL)
+  {
+    return a != b;
+  }
+  return strcmp(a, b);
+}
+
+static uint32_t _CheckTexts(tDiagXml * xml, tDiagXml * cached)
+{
+  uint32_t errors = 0;
+  uint32_t i;
+  size_t l;
+
+  for(i = 0; i < DIAGCACHE_GetEventCount(cached->cache); i++)
+  {
+    uint32_t id = DIAGCACHE_GetEventId(cached->cache, i);
+    for(l = 0; l < sizeof(lans) / sizeof(lans[0]); l++)
+    {
+      const char * str = GetStringOfId(id, xml, lans[l]);
+      const char * rst = GetResetStringOfId(id, xml, lans[l]);
+      if(   _Compare(str, GetStringOfId(id, cached, lans[l]))
+         || _Compare(rst, GetResetStringOfId(id, cached, lans[l])))
+      {
+        printf("texts of 0x%08X (%s) differ\n", id, lans[l]);
+        errors++;
+      }
+      xmlFree((void*)str);
+      xmlFree((void*)rst);
+    }
+  }
+  return errors;
+}
+
+static double _Lookup(tDiagXml * doc, uint32_t * ids, uint32_t idCount, uint32_t count)
+{
+  double start = _Now();
+  uint32_t i;
+
+  for(i = 0; i < count; i++)
+  {
+    const char * str = GetStringOfId(ids[i % idCount], doc, lans[i & 1]);
+    if(doc->cache == NULL)
+    {
+      xmlFree((void*)str);
+    }
+  }
+  return _Now() - start;
+}
+
+int main(int argc, char * argv[])
+{
+  char * xmlPath = (argc > 1) ? argv[1] : "/etc/specific/diagnostic.xml";
+  uint32_t count = (argc > 2) ? (uint32_t)atoi(argv[2]) : 100000;
+  char cachePath[4096];
+  tDiagXml * xml;
+  tDiagXml * cached;
+  uint32_t * ids;
+  uint32_t idCount;
+  uint32_t i;
+  double start;
+  double parse;
+  double compile;
+  double open;
+
+  DIAGCACHE_GetCachePath(xmlPath, cachePath, sizeof(cachePath));
+  start = _Now();
+  xml = ParseDocXml(xmlPath);
+  parse = _Now() - start;
+  if(xml == NULL)
+  {
+    printf("cannot parse %s\n", xmlPath);
+    return EXIT_FAILURE;
+  }
+
+  unlink(cachePath);
+  start = _Now();
+  cached = ParseDoc(xmlPath);
+  compile = _Now() - start;
+  FreeDiagXml(cached);
+  start = _Now();
+  cached = ParseDoc(xmlPath);
+  open = _Now() - start;
+  if(cached == NULL || cached->cache == NULL)
+  {
+    printf("cannot compile %s to %s\n", xmlPath, cachePath);
+    return EXIT_FAILURE;
+  }
+
+  idCount = DIAGCACHE_GetEventCount(cached->cache);
+  if(idCount == 0)
+  {
+    printf("no events in %s\n", xmlPath);
+    return EXIT_FAILURE;
+  }
+  ids = malloc(idCount * sizeof(*ids));
+  for(i = 0; i < idCount; i++)
+  {
+    ids[i] = DIAGCACHE_GetEventId(cached->cache, (i * 7919U) % idCount);
+  }
+  if(_CheckTexts(xml, cached) != 0)
+  {
+    return EXIT_FAILURE;
+  }
+
+  printf("%u events, %u LEDs\n", idCount, DIAGCACHE_GetLedCount(cached->cache));
+  printf("load  xml %8.3f ms, compile %8.3f ms, table %8.3f ms\n",
+         parse * 1e3, compile * 1e3, open * 1e3);
+  printf("GetStringOfId xml %10.0f/s, table %10.0f/s\n",
+         count / _Lookup(xml, ids, idCount, count),
+         count / _Lookup(cached, ids, idCount, count));
+
+  free(ids);
+  FreeDiagXml(xml);
+  FreeDiagXml(cached);
+  return EXIT_SUCCESS;
+}
+//---- End of source file ------------------------------------------------------
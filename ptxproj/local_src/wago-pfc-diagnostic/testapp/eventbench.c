@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+/// Copyright (c) WAGO GmbH & Co. KG
+///
+/// PROPRIETARY RIGHTS are involved in the subject matter of this material.
+/// All manufacturing, reproduction, use and sales rights pertaining to this
+/// subject matter are governed by the license agreement. The recipient of this
+/// software implicitly accepts the terms of the license.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///
+///  \file     eventbench.c
+///
+///  \brief    Events per second of log_EVENT_LogIdParam in a tight loop, sent
+///            synchronously and through the asynchronous sender.
+///
+///            usage: diageventbench [events [queue length]]
+///
+///  \author   WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <diagnostic/diagnostic_API.h>
+
+#define BENCH_EVENT_ID 0x000C0001
+
+static double _Now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void _Emit(uint32_t count)
+{
+  uint32_t i;
+  for(i = 0; i < count; i++)
+  {
+    int32_t value = (int32_t)i;
+    log_EVENT_LogIdParam(BENCH_EVENT_ID, (i & 1) != 0, LOG_TYPE_INT32, &value, LOG_TYPE_INVALID);
+  }
+}
+
+static void _Report(const char * name, uint32_t count, double emitted, double sent)
+{
+  printf("%-14s %10.0f events/s emitting, %10.0f events/s sent\n",
+         name, count / emitted, count / sent);
+}
+
+int main(int argc, char * argv[])
+{
+  uint32_t count = (argc > 1) ? (uint32_t)atoi(argv[1]) : 100000;
+  log_tEventAsyncConfig config = { 0, 0, LOG_EVENT_QUEUE_BLOCK };
+  log_tEventAsyncStats stats;
+  double start;
+  double emitted;
+
+  config.queueLength = (argc > 2) ? (uint32_t)atoi(argv[2]) : 0;
+  log_EVENT_Init("diageventbench");
+
+  start = _Now();
+  _Emit(count);
+  emitted = _Now() - start;
+  _Report("synchronous", count, emitted, emitted);
+
+  if(log_EVENT_EnableAsync(&config) != 0)
+  {
+    printf("log_EVENT_EnableAsync failed\n");
+    return EXIT_FAILURE;
+  }
+  start = _Now();
+  _Emit(count);
+  emitted = _Now() - start;
+  log_EVENT_Flush();
+  _Report("asynchronous", count, emitted, _Now() - start);
+
+  log_EVENT_GetAsyncStats(&stats);
+  printf("queued %llu, sent %llu, dropped %llu, %llu batches\n",
+         (unsigned long long)stats.queued, (unsigned long long)stats.sent,
+         (unsigned long long)stats.dropped, (unsigned long long)stats.batches);
+  log_EVENT_DisableAsync();
+
+  return EXIT_SUCCESS;
+}
+//---- End of source file ------------------------------------------------------
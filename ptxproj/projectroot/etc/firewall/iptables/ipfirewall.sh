@@ -37,6 +37,9 @@ FW_DYN_DIR="/var/run/firewall/iptables"
 FW_DYN_DIR_DEFAULT="$FW_DYN_DIR/default"
 FW_DYN_DIR_ENABLED="$FW_DYN_DIR/enabled"
 FW_DYN_SCRIPTS="/etc/config-tools/events/firewall/iptables"
+# service and general rules as last applied by the config-tool, see forget_applied_rules
+FW_SRV_APPLIED_DIR="/var/run/firewall/services"
+FW_IP_RULES_APPLIED="/var/run/firewall/ipcmn.rls"
 
 print_help()
 {
@@ -151,12 +154,20 @@ set_dynamic_enabled()
     [[ -d "$FW_DYN_DIR_ENABLED" ]] && find "${FW_DYN_DIR_ENABLED}" -type f | sort -u | xargs cat | "${FW_IPR}" --wait -n
 }
 
+# Whenever the tables are restored completely the service and general rules
+# applied before are gone, the config-tool has to apply them completely again.
+forget_applied_rules()
+{
+    rm -f "$FW_SRV_APPLIED_DIR"/*.rls "$FW_IP_RULES_APPLIED"
+}
+
 set_firewall()
 {
     local FW_IP_RULES_TEMP
     FW_IP_RULES_TEMP="$(mktemp -p /tmp ipcmn.rls.XXXXXX)"
 
     if [[ "--apply" != $1 ]] ; then
+        forget_applied_rules
         $FW_IPR --wait <"$FW_IP_RULES_BASE"
     fi
 
@@ -182,7 +193,12 @@ set_firewall()
         fi
     fi
 
-    if ! $FW_IPR --wait -n >/dev/null 2>&1 <"$FW_IP_RULES"; then
+    # the config-tool restores only the chains changed since its last call
+    if [[ "--apply" == $1 ]] ; then
+        if ! /etc/config-tools/firewall iptables --apply-rules "$FW_IP_RULES" >/dev/null 2>&1; then
+            eblog "err" "Failed do set-up network-layer firewall!"
+        fi
+    elif ! $FW_IPR --wait -n >/dev/null 2>&1 <"$FW_IP_RULES"; then
         eblog "err" "Failed do set-up network-layer firewall!"
     fi
 
@@ -213,6 +229,7 @@ clean_firewall()
         exit 1
     fi
 
+    forget_applied_rules
     $FW_IPR --wait <"$FW_IP_RULES_AA"
 
     # TODO: execute NAT transformations
@@ -11,6 +11,9 @@ define("USERLEVEL_GUEST", 0);
 define("USERLEVEL_USER",  2);
 define("USERLEVEL_ADMIN", 3);
 
+// client of config_tool_server, only installed if the server is
+define("CONFIGTOOL_CLIENT", "/usr/bin/config_tool_client");
+
 function MockConfigtool($callString, &$dummy, &$status)
 {
   $status       = 0;
@@ -206,6 +209,26 @@ function ConfigtoolNameInvalid($name)
   return $nameInvalid;
 }
 
+function ConfigtoolIsResident($name)
+{
+  // read-only config tools which config_tool_server runs in-process,
+  // the same list is allowed for the client in /etc/sudoers.d/config_tool_client
+  $residentConfigtools = array(
+    'get_clock_data',
+    'get_coupler_details',
+    'get_device_data',
+    'get_dns_server',
+    'get_filesystem_data',
+    'get_possible_runtimes',
+    'get_rts3scfg_value',
+    'get_run_stop_switch_value',
+    'get_typelabel_value',
+    'get_user'
+  );
+
+  return in_array($name, $residentConfigtools) && file_exists(CONFIGTOOL_CLIENT);
+}
+
 function CallConfigtool($configtoolObj, &$resultObj, $username = "")
 {
   $status       = SUCCESS;
@@ -239,13 +262,22 @@ function CallConfigtool($configtoolObj, &$resultObj, $username = "")
 
   else
   {
+    // create string to call configtool by linux shell - first directory and configtool name
+    $toolString = "/etc/config-tools/".$configtoolObj["name"];
+    
     if(isset($configtoolObj["sudo"]) && $configtoolObj["sudo"])
     {
       $callString = "sudo ";
+      
+      // the server runs as root, so only calls by sudo can be passed to it - output and
+      // exit status are the same, but the tool is not started as a new process
+      if(ConfigtoolIsResident($configtoolObj["name"]))
+      {
+        $toolString = CONFIGTOOL_CLIENT." ".$configtoolObj["name"];
+      }
     }
     
-    // create string to call configtool by linux shell - first directory and configtool name
-    $callString = $callString."/etc/config-tools/".$configtoolObj["name"];
+    $callString = $callString.$toolString;
     
     // now all configtool parameters, one after the other
     $paramNo = 0;
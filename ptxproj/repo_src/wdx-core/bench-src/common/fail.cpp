@@ -0,0 +1,58 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Failure handler for the benchmarks: A failed assertion is logged
+///            and aborts the benchmark run in debug builds.
+//------------------------------------------------------------------------------
+#include <wc/compiler.h>
+#include <wc/assertion.h>
+#include <wc/log.h>
+
+#include <cassert>
+#include <string>
+
+GNUC_DIAGNOSTIC_PUSH
+GNUC_DIAGNOSTIC_IGNORE("-Wsuggest-attribute=noreturn")
+void wc_Fail(char const * const reason,
+             char const * const file,
+             char const * const function,
+             int  const         line)
+{
+    std::string problem = reason;
+    problem += " [";
+    problem += "from ";
+    problem += file;
+    problem += " in function ";
+    problem += function;
+    problem += ", line ";
+    problem += std::to_string(line);
+    problem += "]";
+
+    wc_log(fatal, problem);
+    assert(false);
+}
+GNUC_DIAGNOSTIC_POP
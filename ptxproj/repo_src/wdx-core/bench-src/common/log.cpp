@@ -0,0 +1,47 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Log output for the benchmarks: Only errors are printed, so the
+///            benchmark output is not flooded.
+//------------------------------------------------------------------------------
+#include <wc/log.h>
+
+#include <cstdio>
+
+void wc_log_output(log_level_t  const log_level,
+                   char const * const message) noexcept
+{
+    if(log_level <= log_level_t::error)
+    {
+        fprintf(stderr, "ERROR: %s\n", message);
+    }
+}
+
+log_level_t wc_get_log_level() noexcept
+{
+    return log_level_t::error;
+}
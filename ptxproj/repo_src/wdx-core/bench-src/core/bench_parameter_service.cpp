@@ -0,0 +1,242 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Benchmarks of the parameter service core operations on a
+///            synthetic device model of configurable size.
+//------------------------------------------------------------------------------
+#include "synthetic_device.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace wago::wdx;
+using wago::wdx::bench::synthetic_device;
+using wago::wdx::bench::synthetic_service;
+using wago::wdx::bench::synthetic_dynamic_service;
+
+namespace {
+
+constexpr size_t page_limit = 100;
+
+void model_sizes(benchmark::internal::Benchmark *b)
+{
+    b->Arg(100)->Arg(1000)->Arg(5000);
+}
+
+// Dynamic instances and the latency of a provider call in µs, without and with IPC-like latency
+void dynamic_sizes(benchmark::internal::Benchmark *b)
+{
+    b->Args({100, 0})->Args({2000, 0})->Args({2000, 1000});
+}
+
+// Registering the providers and the device loads and resolves the whole model
+void BM_model_load(benchmark::State &state)
+{
+    auto const parameter_count = static_cast<uint32_t>(state.range(0));
+    for (auto _ : state)
+    {
+        synthetic_service service(parameter_count, parameter_count / 10);
+        benchmark::DoNotOptimize(service.core.get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_get_parameters(benchmark::State &state)
+{
+    auto const parameter_count = static_cast<uint32_t>(state.range(0));
+    synthetic_service service(parameter_count);
+    auto const ids = service.device.get_parameter_ids();
+    for (auto _ : state)
+    {
+        auto responses = service.core->get_parameters(ids).get();
+        benchmark::DoNotOptimize(responses.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ids.size()));
+}
+
+void BM_get_single_parameter(benchmark::State &state)
+{
+    auto const parameter_count = static_cast<uint32_t>(state.range(0));
+    synthetic_service service(parameter_count);
+    std::vector<parameter_instance_id> const ids = { parameter_instance_id(synthetic_device::first_parameter_id + parameter_count - 1) };
+    for (auto _ : state)
+    {
+        auto responses = service.core->get_parameters(ids).get();
+        benchmark::DoNotOptimize(responses.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_set_parameter_values(benchmark::State &state)
+{
+    auto const parameter_count = static_cast<uint32_t>(state.range(0));
+    synthetic_service service(parameter_count);
+    std::vector<value_request> requests;
+    for (auto const &id : service.device.get_parameter_ids())
+    {
+        requests.emplace_back(id, parameter_value::create_uint32(id.id + 1));
+    }
+    for (auto _ : state)
+    {
+        auto responses = service.core->set_parameter_values(requests).get();
+        benchmark::DoNotOptimize(responses.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(requests.size()));
+}
+
+void BM_get_all_parameters(benchmark::State &state)
+{
+    auto const parameter_count = static_cast<uint32_t>(state.range(0));
+    synthetic_service service(parameter_count, parameter_count / 10);
+    size_t count = 0;
+    for (auto _ : state)
+    {
+        auto response = service.core->get_all_parameters(parameter_filter::any, 0, SIZE_MAX).get();
+        count = response.param_responses.size();
+        benchmark::DoNotOptimize(response.param_responses.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// Latency of a full page at the end of the parameters, the worst case for a client paging through all of them
+void BM_get_all_parameters_last_page(benchmark::State &state)
+{
+    auto const parameter_count = static_cast<uint32_t>(state.range(0));
+    synthetic_service service(parameter_count, parameter_count / 10);
+    auto const total = service.core->get_all_parameters(parameter_filter::any, 0, SIZE_MAX).get().param_responses.size();
+    auto const offset = total > page_limit ? total - page_limit : 0;
+    size_t count = 0;
+    for (auto _ : state)
+    {
+        auto response = service.core->get_all_parameters(parameter_filter::any, offset, page_limit).get();
+        count = response.param_responses.size();
+        benchmark::DoNotOptimize(response.param_responses.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+void BM_get_all_parameters_at_cursor(benchmark::State &state)
+{
+    auto const parameter_count = static_cast<uint32_t>(state.range(0));
+    synthetic_service service(parameter_count, parameter_count / 10);
+    size_t count = 0;
+    for (auto _ : state)
+    {
+        count = 0;
+        std::string cursor;
+        do
+        {
+            auto response = service.core->get_all_parameters_at_cursor(parameter_filter::any, cursor, page_limit).get();
+            count += response.param_responses.size();
+            cursor = response.next_cursor;
+        }
+        while (!cursor.empty());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// Unknown instantiations: asked first, then the values of the instances
+void BM_get_all_dynamic_parameters_first_read(benchmark::State &state)
+{
+    synthetic_dynamic_service service(static_cast<uint32_t>(state.range(0)), std::chrono::microseconds(state.range(1)));
+    size_t calls = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        service.core->unregister_parameter_provider(&service.device);
+        service.core->register_parameter_provider(&service.device).get();
+        auto const calls_before = service.device.get_calls;
+        state.ResumeTiming();
+        auto response = service.core->get_all_parameters(parameter_filter::any, 0, SIZE_MAX).get();
+        benchmark::DoNotOptimize(response.param_responses.data());
+        calls += service.device.get_calls - calls_before;
+    }
+    state.counters["provider_calls"] = benchmark::Counter(static_cast<double>(calls), benchmark::Counter::kAvgIterations);
+}
+
+// Known instantiations: read along with the values
+void BM_get_all_dynamic_parameters(benchmark::State &state)
+{
+    synthetic_dynamic_service service(static_cast<uint32_t>(state.range(0)), std::chrono::microseconds(state.range(1)));
+    service.core->get_all_parameters(parameter_filter::any, 0, SIZE_MAX).get();
+    auto const calls_before = service.device.get_calls;
+    for (auto _ : state)
+    {
+        auto response = service.core->get_all_parameters(parameter_filter::any, 0, SIZE_MAX).get();
+        benchmark::DoNotOptimize(response.param_responses.data());
+    }
+    state.counters["provider_calls"] = benchmark::Counter(static_cast<double>(service.device.get_calls - calls_before),
+                                                          benchmark::Counter::kAvgIterations);
+}
+
+// The parameters of one instance in the middle
+void BM_get_dynamic_instance_parameters(benchmark::State &state)
+{
+    synthetic_dynamic_service service(static_cast<uint32_t>(state.range(0)), std::chrono::microseconds(state.range(1)));
+    service.core->get_all_parameters(parameter_filter::any, 0, SIZE_MAX).get();
+    auto const filter = parameter_filter::only_subpath("Dynamics/" + std::to_string(state.range(0) / 2));
+    auto const calls_before = service.device.get_calls;
+    for (auto _ : state)
+    {
+        auto response = service.core->get_all_parameters(filter, 0, SIZE_MAX).get();
+        benchmark::DoNotOptimize(response.param_responses.data());
+    }
+    state.counters["provider_calls"] = benchmark::Counter(static_cast<double>(service.device.get_calls - calls_before),
+                                                          benchmark::Counter::kAvgIterations);
+}
+
+void BM_get_values_for_monitoring_list(benchmark::State &state)
+{
+    auto const parameter_count = static_cast<uint32_t>(state.range(0));
+    synthetic_service service(parameter_count);
+    auto const ids = service.device.get_parameter_ids();
+    auto const list = service.core->create_monitoring_list(ids, 600).get();
+    for (auto _ : state)
+    {
+        auto response = service.core->get_values_for_monitoring_list(list.monitoring_list.id).get();
+        benchmark::DoNotOptimize(response.parameter_values.data());
+    }
+    service.core->delete_monitoring_list(list.monitoring_list.id).get();
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ids.size()));
+}
+
+}
+
+BENCHMARK(BM_model_load)->Apply(model_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_get_parameters)->Apply(model_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_get_single_parameter)->Apply(model_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_set_parameter_values)->Apply(model_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_get_all_parameters)->Apply(model_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_get_all_parameters_last_page)->Apply(model_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_get_all_parameters_at_cursor)->Apply(model_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_get_all_dynamic_parameters_first_read)->Apply(dynamic_sizes)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_get_all_dynamic_parameters)->Apply(dynamic_sizes)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_get_dynamic_instance_parameters)->Apply(dynamic_sizes)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_get_values_for_monitoring_list)->Apply(model_sizes)->Unit(benchmark::kMicrosecond);
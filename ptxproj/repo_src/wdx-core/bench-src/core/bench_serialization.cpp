@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Benchmarks of the parameter value and IPC serialization.
+//------------------------------------------------------------------------------
+#include "wago/wdx/parameter_value.hpp"
+#include "wago/wdx/responses.hpp"
+#include "wda_ipc/ipc.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace wago::wdx;
+using wago::wda_ipc::serialization_method;
+
+namespace {
+
+std::vector<value_response> create_value_responses(size_t const count)
+{
+    std::vector<value_response> responses;
+    for (size_t i = 0; i < count; ++i)
+    {
+        responses.emplace_back(i % 2 == 0 ? parameter_value::create_uint32(static_cast<uint32_t>(i))
+                                          : parameter_value::create_string("Value " + std::to_string(i)));
+    }
+    return responses;
+}
+
+void BM_parameter_value_get_json(benchmark::State &state)
+{
+    auto const values = create_value_responses(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        for (auto const &value : values)
+        {
+            auto json = value.value->get_json();
+            benchmark::DoNotOptimize(json.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_parameter_value_create_with_json(benchmark::State &state)
+{
+    auto const values = create_value_responses(static_cast<size_t>(state.range(0)));
+    std::vector<std::pair<parameter_value_types, std::string>> jsons;
+    for (auto const &value : values)
+    {
+        jsons.emplace_back(value.value->get_type(), value.value->get_json());
+    }
+    for (auto _ : state)
+    {
+        for (auto const &json : jsons)
+        {
+            auto value = parameter_value::create_with_json(json.first, parameter_value_rank::scalar, json.second);
+            benchmark::DoNotOptimize(value.get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ipc_to_bytes(benchmark::State &state, serialization_method method)
+{
+    auto const responses = create_value_responses(static_cast<size_t>(state.range(0)));
+    size_t size = 0;
+    for (auto _ : state)
+    {
+        auto bytes = wago::wda_ipc::to_bytes(responses, method);
+        size = bytes.size();
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+void BM_ipc_from_bytes(benchmark::State &state, serialization_method method)
+{
+    auto const bytes = wago::wda_ipc::to_bytes(create_value_responses(static_cast<size_t>(state.range(0))), method);
+    for (auto _ : state)
+    {
+        auto responses = wago::wda_ipc::from_bytes<std::vector<value_response>>(bytes, method);
+        benchmark::DoNotOptimize(responses.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes.size()));
+}
+
+}
+
+BENCHMARK(BM_parameter_value_get_json)->Arg(1000);
+BENCHMARK(BM_parameter_value_create_with_json)->Arg(1000);
+BENCHMARK_CAPTURE(BM_ipc_to_bytes,   json,   serialization_method::JSON)  ->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(BM_ipc_to_bytes,   binary, serialization_method::BINARY)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(BM_ipc_from_bytes, json,   serialization_method::JSON)  ->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(BM_ipc_from_bytes, binary, serialization_method::BINARY)->Arg(100)->Arg(1000);
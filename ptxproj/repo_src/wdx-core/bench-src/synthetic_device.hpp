@@ -0,0 +1,298 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Synthetic device model of configurable size with an in-process
+///            parameter provider, used by the benchmarks.
+//------------------------------------------------------------------------------
+#ifndef BENCH_SRC_SYNTHETIC_DEVICE_HPP_
+#define BENCH_SRC_SYNTHETIC_DEVICE_HPP_
+
+#include "wago/wdx/base_parameter_provider.hpp"
+#include "wago/wdx/permissions_i.hpp"
+#include "model_provider_i.hpp"
+#include "device_description_provider_i.hpp"
+#include "parameter_service_core.hpp"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace wago {
+namespace wdx {
+namespace bench {
+
+/// Model, device description and parameter provider of a synthetic device:
+/// `parameter_count` writeable UInt32 parameters plus a class with `channel_count`
+/// fixed instances of `channel_parameters` parameters each.
+class synthetic_device : public model_provider_i, public device_description_provider_i, public base_parameter_provider
+{
+public:
+    static constexpr parameter_id_t first_parameter_id = 100000;
+    static constexpr parameter_id_t first_channel_id   =  90000;
+    static constexpr parameter_id_t channel_base_id    =  89999;
+    static constexpr uint32_t       channel_parameters =      4;
+
+    explicit synthetic_device(uint32_t parameter_count, uint32_t channel_count = 0)
+    : parameter_count_m(parameter_count)
+    , channel_count_m(channel_count)
+    { }
+
+    /// IDs of all (static and channel) parameters, in the order of the model.
+    std::vector<parameter_instance_id> get_parameter_ids() const
+    {
+        std::vector<parameter_instance_id> ids;
+        for (uint32_t i = 0; i < parameter_count_m; ++i)
+        {
+            ids.emplace_back(first_parameter_id + i);
+        }
+        for (uint32_t c = 1; c <= channel_count_m; ++c)
+        {
+            for (uint32_t i = 0; i < channel_parameters; ++i)
+            {
+                ids.emplace_back(first_channel_id + i, c);
+            }
+        }
+        return ids;
+    }
+
+    wago::future<wdm_response> get_model_information() override
+    {
+        std::string wdm = R"({ "WDMMVersion": "1.0.0", "Name": "WAGO",
+                               "Features": [ { "ID": "SyntheticFeature", "Classes": ["SyntheticChannel"], "Parameters": [)";
+        for (uint32_t i = 0; i < parameter_count_m; ++i)
+        {
+            wdm += (i > 0 ? "," : "");
+            wdm += R"({ "ID": )" + std::to_string(first_parameter_id + i)
+                 + R"(, "Path": "Synthetic/Param)" + std::to_string(i) + R"(", "Type": "UInt32", "Writeable": true })";
+        }
+        wdm += R"(] } ], "Classes": [ { "ID": "SyntheticChannel", "BasePath": "Channels", "BaseID": )"
+             + std::to_string(channel_base_id) + R"(, "Parameters": [)";
+        for (uint32_t i = 0; i < channel_parameters; ++i)
+        {
+            wdm += (i > 0 ? "," : "");
+            wdm += R"({ "ID": )" + std::to_string(first_channel_id + i)
+                 + R"(, "Path": "Value)" + std::to_string(i) + R"(", "Type": "String" })";
+        }
+        wdm += "] } ] }";
+        return wago::resolved_future(wdm_response(std::move(wdm)));
+    }
+
+    device_selector_response get_provided_devices() override
+    {
+        return device_selector_response({device_selector::any});
+    }
+
+    wago::future<wdd_response> get_device_information(std::string, std::string) override
+    {
+        std::string wdd = R"({ "WDMMVersion": "1.0.0", "ModelReference": "WAGO", "Features": ["SyntheticFeature"])";
+        if (channel_count_m > 0)
+        {
+            wdd += R"(, "Instantiations": [ { "Class": "SyntheticChannel", "Instances": [)";
+            for (uint32_t c = 1; c <= channel_count_m; ++c)
+            {
+                wdd += (c > 1 ? "," : "");
+                wdd += R"({ "ID": )" + std::to_string(c) + " }";
+            }
+            wdd += "] } ]";
+        }
+        wdd += " }";
+        return wago::resolved_future(wdd_response::from_pure_wdd(std::move(wdd)));
+    }
+
+    parameter_selector_response get_provided_parameters() override
+    {
+        return parameter_selector_response({parameter_selector::all_of_feature("SyntheticFeature")});
+    }
+
+    wago::future<std::vector<value_response>> get_parameter_values(std::vector<parameter_instance_id> parameter_ids) override
+    {
+        std::vector<value_response> result(parameter_ids.size());
+        for (size_t idx = 0; idx < parameter_ids.size(); ++idx)
+        {
+            auto const &id = parameter_ids[idx];
+            if (id.id >= first_parameter_id)
+            {
+                auto const value = values_m.find(id.id);
+                result[idx].set_value(parameter_value::create_uint32(value == values_m.end() ? id.id : value->second));
+            }
+            else
+            {
+                result[idx].set_value(parameter_value::create_string("Channel " + std::to_string(id.instance_id)));
+            }
+        }
+        return wago::resolved_future(std::move(result));
+    }
+
+    wago::future<std::vector<set_parameter_response>> set_parameter_values(std::vector<value_request> value_requests) override
+    {
+        std::vector<set_parameter_response> result(value_requests.size());
+        for (size_t idx = 0; idx < value_requests.size(); ++idx)
+        {
+            values_m[value_requests[idx].param_id.id] = value_requests[idx].value->get_uint32();
+            result[idx].set_success();
+        }
+        return wago::resolved_future(std::move(result));
+    }
+
+private:
+    uint32_t                           parameter_count_m;
+    uint32_t                           channel_count_m;
+    std::map<parameter_id_t, uint32_t> values_m;
+};
+
+/// Model, device description and parameter provider of a device with a dynamic
+/// class: `instance_count` instances of `instance_parameters` parameters each,
+/// their instantiations provided as value. Each provider call takes
+/// `call_latency`, e.g. for a provider behind IPC.
+class synthetic_dynamic_device : public model_provider_i, public device_description_provider_i, public base_parameter_provider
+{
+public:
+    static constexpr parameter_id_t instance_base_id    = 80000;
+    static constexpr parameter_id_t first_instance_id   = 80001;
+    static constexpr uint32_t       instance_parameters =     2;
+
+    explicit synthetic_dynamic_device(uint32_t instance_count, std::chrono::microseconds call_latency = std::chrono::microseconds(0))
+    : instance_count_m(instance_count)
+    , call_latency_m(call_latency)
+    { }
+
+    size_t get_calls = 0;
+
+    wago::future<wdm_response> get_model_information() override
+    {
+        std::string wdm = R"({ "WDMMVersion": "1.0.0", "Name": "WAGO",
+                               "Features": [ { "ID": "SyntheticDynamicFeature", "Classes": ["SyntheticDynamic"] } ],
+                               "Classes": [ { "ID": "SyntheticDynamic", "BasePath": "Dynamics", "Dynamic": true, "BaseID": )"
+                         + std::to_string(instance_base_id) + R"(, "Parameters": [)";
+        for (uint32_t i = 0; i < instance_parameters; ++i)
+        {
+            wdm += (i > 0 ? "," : "");
+            wdm += R"({ "ID": )" + std::to_string(first_instance_id + i)
+                 + R"(, "Path": "Value)" + std::to_string(i) + R"(", "Type": "String" })";
+        }
+        wdm += "] } ] }";
+        return wago::resolved_future(wdm_response(std::move(wdm)));
+    }
+
+    device_selector_response get_provided_devices() override
+    {
+        return device_selector_response({device_selector::any});
+    }
+
+    wago::future<wdd_response> get_device_information(std::string, std::string) override
+    {
+        std::string wdd = R"({ "WDMMVersion": "1.0.0", "ModelReference": "WAGO", "Features": ["SyntheticDynamicFeature"] })";
+        return wago::resolved_future(wdd_response::from_pure_wdd(std::move(wdd)));
+    }
+
+    parameter_selector_response get_provided_parameters() override
+    {
+        return parameter_selector_response({parameter_selector::all_of_feature("SyntheticDynamicFeature")});
+    }
+
+    wago::future<std::vector<value_response>> get_parameter_values(std::vector<parameter_instance_id> parameter_ids) override
+    {
+        get_calls++;
+        std::this_thread::sleep_for(call_latency_m);
+        std::vector<value_response> result(parameter_ids.size());
+        for (size_t idx = 0; idx < parameter_ids.size(); ++idx)
+        {
+            auto const &id = parameter_ids[idx];
+            if (id.id == instance_base_id)
+            {
+                std::vector<class_instantiation> instantiations;
+                for (uint32_t i = 1; i <= instance_count_m; ++i)
+                {
+                    instantiations.emplace_back(i, "SyntheticDynamic");
+                }
+                result[idx].set_value(parameter_value::create_instantiations(instantiations));
+            }
+            else
+            {
+                result[idx].set_value(parameter_value::create_string("Instance " + std::to_string(id.instance_id)));
+            }
+        }
+        return wago::resolved_future(std::move(result));
+    }
+
+private:
+    uint32_t                  instance_count_m;
+    std::chrono::microseconds call_latency_m;
+};
+
+/// Permissions granting everything, the benchmarks call the core directly.
+class all_permissions : public permissions_i
+{
+public:
+    user_permissions get_user_permissions(std::string const &user_name) noexcept override
+    {
+        return user_permissions(user_name, {}, {});
+    }
+
+    std::string get_permission_name(std::string const &feature, types const) const noexcept override
+    {
+        return feature;
+    }
+};
+
+/// A parameter service core with one registered device of `device_type`.
+template <class device_type>
+struct device_service
+{
+    device_type                             device;
+    std::unique_ptr<parameter_service_core> core;
+
+    template <class... device_args>
+    explicit device_service(device_args... args)
+    : device(args...)
+    , core(std::make_unique<parameter_service_core>(std::make_unique<all_permissions>()))
+    {
+        core->register_model_provider(&device).get();
+        core->register_device_description_provider(&device).get();
+        core->register_parameter_provider(&device).get();
+        core->register_device(register_device_request{device_id::headstation, "0768-3301", "01.00.00"}).get();
+    }
+
+    ~device_service()
+    {
+        core->unregister_parameter_provider(&device);
+        core->unregister_device_description_provider(&device);
+        core->unregister_model_provider(&device);
+    }
+};
+
+using synthetic_service         = device_service<synthetic_device>;
+using synthetic_dynamic_service = device_service<synthetic_dynamic_device>;
+
+} // Namespace bench
+} // Namespace wdx
+} // Namespace wago
+
+#endif // BENCH_SRC_SYNTHETIC_DEVICE_HPP_
@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Benchmarks of bytes and CPU time per definitions page:
+///            Serialization without cache, lazy compression of cached
+///            documents and revalidation with If-None-Match (304).
+//------------------------------------------------------------------------------
+#include "synthetic_device.hpp"
+#include "rest/json_api.hpp"
+#include "rest/collection_document.hpp"
+#include "rest/definition_cache.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace wago::wdx;
+using namespace wago::wdx::wda::rest;
+using wago::wdx::bench::synthetic_service;
+
+namespace {
+
+std::string serialize_definitions_page(parameter_service_core &core, uint32_t const page_limit)
+{
+    auto core_response = core.get_all_parameter_definitions(parameter_filter::any, 0, page_limit).get();
+    std::vector<parameter_definition_data> definitions;
+    definitions.reserve(core_response.param_responses.size());
+    for(auto const &param_response : core_response.param_responses)
+    {
+        definitions.emplace_back(param_response);
+    }
+    parameter_definition_collection_document const document("/wda/parameter-definitions", "", {{ "doc", "/wda/doc" }},
+                                                            std::move(definitions), 0, page_limit, core_response.total_entries);
+    std::string result;
+    json_api().serialize(result, document);
+    return result;
+}
+
+void BM_definitions_page_serialize(benchmark::State &state)
+{
+    auto const page_limit = static_cast<uint32_t>(state.range(0));
+    synthetic_service service(page_limit);
+    size_t size = 0;
+    for (auto _ : state)
+    {
+        auto page = serialize_definitions_page(*service.core, page_limit);
+        size = page.size();
+        benchmark::DoNotOptimize(page.data());
+    }
+    state.counters["bytes_per_page"] = static_cast<double>(size);
+}
+
+void BM_definitions_page_encode(benchmark::State &state)
+{
+    auto const page_limit = static_cast<uint32_t>(state.range(0));
+    auto const encoding   = static_cast<definition_cache::content_encoding>(state.range(1));
+    synthetic_service service(page_limit);
+    auto const page = serialize_definitions_page(*service.core, page_limit);
+    size_t size = 0;
+    for (auto _ : state)
+    {
+        auto encoded = definition_cache::encode(page, encoding);
+        size = encoded.size();
+        benchmark::DoNotOptimize(encoded.data());
+    }
+    state.counters["bytes_per_page"] = static_cast<double>(size);
+    state.counters["ratio"]          = static_cast<double>(size) / static_cast<double>(page.size());
+}
+
+void BM_definitions_page_not_modified(benchmark::State &state)
+{
+    auto const page_limit = static_cast<uint32_t>(state.range(0));
+    synthetic_service service(page_limit);
+    auto const etag = '"' + service.core->get_model_hash().get().model_hash + "-0\"";
+    for (auto _ : state)
+    {
+        auto model_hash = service.core->get_model_hash().get();
+        bool matches = definition_cache::matches_etag(etag, '"' + model_hash.model_hash + "-0\"");
+        benchmark::DoNotOptimize(matches);
+    }
+    state.counters["bytes_per_page"] = 0;
+}
+
+}
+
+BENCHMARK(BM_definitions_page_serialize)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_definitions_page_encode)
+    ->Args({100,  static_cast<int64_t>(definition_cache::content_encoding::gzip)})
+    ->Args({1000, static_cast<int64_t>(definition_cache::content_encoding::gzip)})
+    ->Args({1000, static_cast<int64_t>(definition_cache::content_encoding::deflate)})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_definitions_page_not_modified)->Arg(1000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Benchmarks of the REST-API serialization.
+//------------------------------------------------------------------------------
+#include "synthetic_device.hpp"
+#include "rest/json_api.hpp"
+#include "rest/collection_document.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace wago::wdx;
+using namespace wago::wdx::wda::rest;
+using wago::wdx::bench::synthetic_service;
+
+namespace {
+
+void BM_json_api_serialize_parameters(benchmark::State &state)
+{
+    auto const parameter_count = static_cast<uint32_t>(state.range(0));
+    synthetic_service service(parameter_count);
+    auto const responses = service.core->get_parameters(service.device.get_parameter_ids()).get();
+    json_api serializer;
+    size_t size = 0;
+    for (auto _ : state)
+    {
+        auto data = responses;
+        parameter_collection_document const document("/wda/parameters", "", {}, std::move(data), 0, parameter_count, parameter_count);
+        std::string result;
+        serializer.serialize(result, document);
+        size = result.size();
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+}
+
+BENCHMARK(BM_json_api_serialize_parameters)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
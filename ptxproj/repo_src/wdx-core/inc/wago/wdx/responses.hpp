@@ -318,6 +318,20 @@ struct parameter_response_list_response : public response
     using response::response;
 };
 
+/**
+This response holds one page of a cursor based paging through a list of parameter responses.
+Problems are reported with the following `status_codes`:
+- INVALID_VALUE (the cursor is malformed or does not point to a position in the list anymore)
+*/
+struct parameter_response_cursor_response : public response
+{
+    std::vector<parameter_response> param_responses;
+    /** Opaque cursor to continue with the next page. Empty if there are no more entries. */
+    std::string next_cursor;
+
+    using response::response;
+};
+
 /**
 This response describes the result of setting a parameter value.
 Problems are reported with the following `status_codes`:
@@ -714,6 +728,19 @@ struct enum_definition_response : response {
     using response::response;
 };
 
+/**
+Identifies the state of the loaded model, the registered devices and their parameter providers.
+As long as `model_hash` stays the same, definitions (parameter, method, feature and enum definitions) do not change,
+except for definitions of instances of dynamically instantiated classes, which are read from the parameter providers.
+ */
+struct model_hash_response : response {
+    /** Opaque hash of the model state. */
+    std::string model_hash;
+    /** True, if any device has parameters with dynamic instantiations. */
+    bool has_dynamic_instantiations = false;
+    using response::response;
+};
+
 }
 }
 #endif // INC_WAGO_WDX_RESPONSES_HPP_
@@ -19,6 +19,8 @@
 
 #include <wc/log.h>
 
+#include <sstream>
+
 
 namespace wago {
 namespace wdx {
@@ -224,6 +226,16 @@ wago::future<std::vector<parameter_response>> authorized::get_parameter_definiti
     return service_m->get_parameters_internal(instances, std::move(result), true);
 }
 
+wago::future<parameter_response_cursor_response> authorized::get_all_parameters_at_cursor(parameter_filter filter, std::string cursor, size_t paging_limit)
+{
+    parameter_filter filter_by_permissions;
+    if (!create_parameter_filter_for_permissions(permissions_m, permissions_i::types::readonly, filter_by_permissions)) 
+    {
+        return resolved_future(parameter_response_cursor_response(status_codes::success));
+    }
+    return service_m->get_all_parameters_at_cursor(filter | filter_by_permissions, std::move(cursor), paging_limit);
+}
+
 wago::future<parameter_response_list_response> authorized::get_all_parameter_definitions(parameter_filter filter, size_t paging_offset, size_t paging_limit)
 {
     parameter_filter filter_by_permissions;
@@ -325,6 +337,40 @@ wago::future<std::vector<enum_definition_response>> authorized::get_all_enum_def
     return service_m->get_all_enum_definitions();
 }
 
+wago::future<model_hash_response> authorized::get_model_hash()
+{
+    // definitions are filtered by read permissions, method definitions by write permissions
+    // (all for some users), so the hash has to be specific for them
+    std::string permissions = permissions_m.user_name + ':';
+    for(auto const &feature : permissions_m.read_permissions)
+    {
+        permissions += feature + ',';
+    }
+    permissions += ':';
+    for(auto const &feature : permissions_m.write_permissions)
+    {
+        permissions += feature + ',';
+    }
+    std::stringstream permissions_hash;
+    permissions_hash << std::hex << std::hash<std::string>()(permissions);
+
+    auto response_future_ptr = std::make_shared<future<model_hash_response>>(service_m->get_model_hash());
+    auto chained_promise     = std::make_shared<promise<model_hash_response>>(wago::promise<model_hash_response>::create_with_dismiss_notifier([future = response_future_ptr](){
+        future->dismiss();
+    }));
+    response_future_ptr->set_exception_notifier(std::bind(&wago::promise<model_hash_response>::set_exception, chained_promise, std::placeholders::_1));
+    response_future_ptr->set_notifier([promise          = chained_promise,
+                                       permissions_hash = permissions_hash.str()](model_hash_response response){
+        if(response.is_success())
+        {
+            response.model_hash += '-' + permissions_hash;
+        }
+        promise->set_value(std::move(response));
+    });
+
+    return chained_promise->get_future();
+}
+
 wago::future<delete_monitoring_list_response> authorized::delete_monitoring_list(monitoring_list_id_t id)
 {
     return service_m->delete_monitoring_list(id);
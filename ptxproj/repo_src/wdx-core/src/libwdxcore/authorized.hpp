@@ -54,6 +54,7 @@ public:
     wago::future<std::vector<set_parameter_response>> set_parameter_values_by_path_connection_aware(std::vector<value_path_request> value_path_requests, bool defer_wda_web_connection_changes) override;
     wago::future<std::vector<parameter_response>> get_parameter_definitions(std::vector<parameter_instance_id> ids) override;
     wago::future<std::vector<parameter_response>> get_parameter_definitions_by_path(std::vector<parameter_instance_path> paths) override;
+    wago::future<parameter_response_cursor_response> get_all_parameters_at_cursor(parameter_filter filter, std::string cursor, size_t paging_limit) override;
     wago::future<parameter_response_list_response> get_all_parameter_definitions(parameter_filter filter, size_t paging_offset, size_t paging_limit) override;
     wago::future<parameter_response_list_response> get_all_method_definitions(parameter_filter filter, size_t paging_offset, size_t paging_limit) override;
     wago::future<std::vector<feature_list_response>> get_features(std::vector<device_path_t> device_paths) override;
@@ -66,6 +67,7 @@ public:
     wago::future<monitoring_lists_response> get_all_monitoring_lists() override;
     wago::future<enum_definition_response> get_enum_definition(name_t enum_name) override;
     wago::future<std::vector<enum_definition_response>> get_all_enum_definitions() override;
+    wago::future<model_hash_response> get_model_hash() override;
     wago::future<delete_monitoring_list_response> delete_monitoring_list(monitoring_list_id_t id) override;
 
     // file api
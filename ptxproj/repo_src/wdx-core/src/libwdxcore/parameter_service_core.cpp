@@ -38,6 +38,7 @@
 #include <ctime>
 #include <unordered_set>
 #include <functional>
+#include <sstream>
 
 using namespace std;
 using wago::wdx::method_argument_definition;
@@ -92,6 +93,31 @@ bool check_for_instances_extra_values(device_model                   const &mode
 
 void append_included_features(std::set<std::string> &features, device_model &model);
 
+bool matches_filter(parameter_filter const &filter, parameter_instance* const &inst);
+
+bool is_dynamic_instantiations(parameter_instance const &inst);
+
+uint64_t combine_hash(uint64_t hash, string const &value);
+
+// position of the last parameter_instance on a page of get_all_parameters_at_cursor
+struct static_cursor
+{
+    size_t                device_collection = 0;
+    size_t                slot              = 0;
+    size_t                index             = 0;
+    parameter_instance_id id;
+};
+
+constexpr char const g_static_cursor_kind  = 's';
+constexpr char const g_dynamic_cursor_kind = 'd';
+constexpr char const g_offset_cursor_kind  = 'o';
+
+string build_cursor(static_cursor const &position);
+
+string build_cursor(char kind, size_t offset);
+
+bool parse_cursor(string const &cursor, char &kind, static_cursor &position, size_t &offset);
+
 }
 
 //*************************************************************************
@@ -173,6 +199,8 @@ status_codes parameter_service_core::add_provider(parameter_provider_i* provider
             }
 
             std::lock_guard<std::mutex> guard(m_param_mutex);
+            m_dynamic_instantiations.clear();
+            change_model_hash("provide " + std::to_string(response.selected_parameters.size()));
             for (auto& coll : m_device_collections)
             {
                 for(auto& device : coll)
@@ -197,6 +225,8 @@ status_codes parameter_service_core::add_provider(parameter_provider_i* provider
 
 void parameter_service_core::unprovide(const parameter_provider_i* provider)
 {
+    m_dynamic_instantiations.clear();
+    change_model_hash("unprovide");
     bool no_match = true;
     for (auto& dc : m_device_collections)
     {
@@ -361,6 +391,7 @@ void parameter_service_core::load_model(string& wdm_artifact)
 {
     device_model_loader dl;
     dl.load(wdm_artifact, *m_model);
+    change_model_hash(wdm_artifact);
     for (auto& coll : m_device_collections)
     {
         for(auto& device : coll)
@@ -1043,6 +1074,44 @@ future<vector<enum_definition_response>> parameter_service_core::get_all_enum_de
     return resolved_future(std::move(r));
 }
 
+future<model_hash_response> parameter_service_core::get_model_hash()
+{
+    lock_guard<std::mutex> guard(m_param_mutex);
+    if(!m_model_dynamic_instantiations_known)
+    {
+        m_model_dynamic_instantiations = false;
+        for(auto const &coll : m_device_collections)
+        {
+            for(auto const &device : coll)
+            {
+                if(device == nullptr)
+                {
+                    continue;
+                }
+                auto const &instances = device->parameter_instances.get_all();
+                m_model_dynamic_instantiations = m_model_dynamic_instantiations
+                                              || std::any_of(instances.begin(), instances.end(), [](auto const &inst) {
+                                                     return is_dynamic_instantiations(*inst);
+                                                 });
+            }
+        }
+        m_model_dynamic_instantiations_known = true;
+    }
+
+    model_hash_response r(status_codes::success);
+    std::stringstream hash;
+    hash << std::hex << m_model_hash;
+    r.model_hash = hash.str();
+    r.has_dynamic_instantiations = m_model_dynamic_instantiations;
+    return resolved_future(std::move(r));
+}
+
+void parameter_service_core::change_model_hash(string const &change)
+{
+    m_model_hash = combine_hash(m_model_hash, change);
+    m_model_dynamic_instantiations_known = false;
+}
+
 future<method_invocation_named_response> parameter_service_core::invoke_method(parameter_instance_id method_id,
                                                                   map<string, shared_ptr<parameter_value>> in_args)
 {
@@ -1279,6 +1348,10 @@ future<vector<set_parameter_response>> parameter_service_core::set_parameter_val
 
         auto const *instance = (*instances)[idx];
 
+        if (instance->definition->value_type == parameter_value_types::instantiations)
+        {
+            m_dynamic_instantiations.erase(instance->id); // read again on next get_all_parameters
+        }
         if (instance->definition->overrideables.inactive)
         {
             res.status = status_codes::ignored;
@@ -1513,7 +1586,8 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
                                                                                         size_t                                 paging_limit,
                                                                                         bool                                   first_phase,
                                                                                         std::vector<parameter_response> const &dyn_instantiation_responses,
-                                                                                        bool                                   only_definitions)
+                                                                                        bool                                   only_definitions,
+                                                                                        bool                                   only_dynamic)
 {
     // either _only_methods or _without_methods is expected to be set by (internal) caller
     WC_ASSERT(filter._only_methods || filter._without_methods);
@@ -1522,8 +1596,11 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
     path subpath(filter._only_subpath);
     bool apply_paging = paging_offset > 0 || paging_limit != SIZE_MAX;
     bool ask_dynamic_instances = false;
+    bool use_known_instantiations = false;
+    std::vector<parameter_response> known_instantiations;
     std::vector<provider_read_portion> provider_portions;
     std::vector<parameter_response> responses;
+    std::vector<parameter_response> definition_responses;
     size_t entries_count = 0;
 
     {
@@ -1550,85 +1627,9 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
             }
         }
 
-        auto filter_fn = [filter, this](parameter_instance* const& inst)
+        auto filter_fn = [&filter](parameter_instance* const& inst)
         {
-            if(inst->id.instance_id == DYNAMIC_PLACEHOLDER_INSTANCE_ID)
-            {
-                return false;
-            }
-            if(filter._without_methods && inst->definition->value_type == parameter_value_types::method)
-            {
-                return false;
-            }
-            if(filter._only_methods && inst->definition->value_type != parameter_value_types::method)
-            {
-                return false;
-            }
-            if(filter._without_file_ids && inst->definition->value_type == parameter_value_types::file_id)
-            {
-                return false;
-            }
-            if(filter._only_file_ids && inst->definition->value_type != parameter_value_types::file_id)
-            {
-                return false;
-            }
-            if(filter._without_beta && inst->definition->is_beta)
-            {
-                return false;
-            }
-            if(filter._only_beta && !inst->definition->is_beta)
-            {
-                return false;
-            }
-            if(filter._without_deprecated && inst->definition->is_deprecated)
-            {
-                return false;
-            }
-            if(filter._only_deprecated && !inst->definition->is_deprecated)
-            {
-                return false;
-            }
-            if(filter._without_usersettings && (inst->definition->user_setting && !inst->definition->overrideables.inactive))
-            {
-                return false;
-            }
-            if(filter._only_usersettings && (!inst->definition->user_setting || inst->definition->overrideables.inactive))
-            {
-                return false;
-            }
-            if(filter._without_writeable && (inst->definition->writeable && !inst->definition->overrideables.inactive))
-            {
-                return false;
-            }
-            if(filter._only_writeable && (!inst->definition->writeable || inst->definition->overrideables.inactive))
-            {
-                return false;
-            }
-            if(!filter._only_features.empty())
-            {
-                // feature of instance currently looked at
-                auto& instance_feature = inst->definition->feature_def;
-                if(instance_feature.expired())
-                {
-                    wc_log(log_level_t::warning, "Parameter definition '" + inst->definition->path + "' (id=" + std::to_string(inst->definition->id) + ") belongs to no feature");
-                    return false;
-                }
-
-                // check if instance feature is contained in feature list of filter
-                auto instance_feature_name = instance_feature.lock()->name;
-                auto instance_feature_found_in_filter = 
-                    filter._only_features.end() != std::find_if(
-                        filter._only_features.begin(), filter._only_features.end(), 
-                        [instance_feature_name](auto const &filter_feature_name) {
-                            return device_model::names_equal(instance_feature_name, filter_feature_name);
-                        });
-
-                if(!instance_feature_found_in_filter)
-                {
-                    return false;
-                }
-            }
-            return true;
+            return matches_filter(filter, inst);
         };
 
         auto second_phase_filter_fn = [&filter_path, &subpath, &filter_fn](parameter_instance* const& inst) {
@@ -1646,20 +1647,28 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
         };
 
         // Apply filter and gather dynamic_instantiation_params
+        // (only_dynamic drops all other parameter_instances: paging starts with the dynamic stuff then)
         auto dynamic_instantiation_params = make_shared<vector<parameter_instance*>>();
-        instances->erase(std::remove_if(instances->begin(), instances->end(), [filter_fn, dynamic_instantiation_params, this](auto& inst) {
-            if(inst->definition->value_type == parameter_value_types::instantiations && !inst->fixed_value)
+        instances->erase(std::remove_if(instances->begin(), instances->end(), [filter_fn, dynamic_instantiation_params, only_dynamic](auto& inst) {
+            if(is_dynamic_instantiations(*inst))
             {
                 dynamic_instantiation_params->push_back(inst);
                 return true;
             }
-            return !filter_fn(inst);
+            return only_dynamic || !filter_fn(inst);
         }), instances->end());
 
         bool found_dyn_instantiations = !dynamic_instantiation_params->empty();
         auto first_dyn_instantiations_idx = instances->size();
 
-        if(first_phase)
+        // if the dyn_instantiations are known from an earlier read, the first phase is skipped:
+        // the instantiations parameters are read again together with the paging window to validate them
+        use_known_instantiations = first_phase && found_dyn_instantiations
+                                && get_known_dynamic_instantiations(*dynamic_instantiation_params, known_instantiations);
+        bool second_phase = !first_phase || use_known_instantiations;
+        auto const &instantiation_responses = use_known_instantiations ? known_instantiations : dyn_instantiation_responses;
+
+        if(!second_phase)
         {
             append(*instances, *dynamic_instantiation_params); // now all the dynamic stuff is at the end
         }
@@ -1669,7 +1678,7 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
 
             // generate the parameter_instances corresponding to the dyn_instantiations
             // this is also the reason we later have to use the original dyn_instantiations in the response, because they are consistent with the rest
-            for(auto const &di : dyn_instantiation_responses)
+            for(auto const &di : instantiation_responses)
             {
                 if(di.status != status_codes::success || !di.value)
                 {
@@ -1702,7 +1711,7 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
         // paging
         if(apply_paging)
         {
-            if((!found_dyn_instantiations || !first_phase) && (paging_offset >= entries_count))
+            if((!found_dyn_instantiations || second_phase) && (paging_offset >= entries_count))
             {
                 parameter_response_list_response resp(status_codes::success);
                 resp.total_entries = entries_count;
@@ -1710,7 +1719,7 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
             }
             auto max_to_get = min(paging_limit, entries_count);
             auto lastIdxExclusive = min(paging_offset + max_to_get, entries_count);
-            ask_dynamic_instances = first_phase && found_dyn_instantiations && first_dyn_instantiations_idx < lastIdxExclusive;
+            ask_dynamic_instances = !second_phase && found_dyn_instantiations && first_dyn_instantiations_idx < lastIdxExclusive;
             if(!ask_dynamic_instances)
             {
                 instances_to_ask = make_shared<vector<parameter_instance*>>(instances->begin() + paging_offset, instances->begin() + lastIdxExclusive);
@@ -1718,7 +1727,7 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
         }
         else
         {
-            ask_dynamic_instances = first_phase && found_dyn_instantiations;
+            ask_dynamic_instances = !second_phase && found_dyn_instantiations;
         }
 
         if(ask_dynamic_instances)
@@ -1726,6 +1735,23 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
             responses.resize(dynamic_instantiation_params->size());
             prepare_get_parameters(provider_portions, dynamic_instantiation_params, responses);
         }
+        else if(use_known_instantiations)
+        {
+            // the instantiations parameters are read last, after the values of the paging window (if any)
+            auto instances_to_read = make_shared<vector<parameter_instance*>>();
+            if(only_definitions)
+            {
+                definition_responses.resize(instances_to_ask->size());
+                prepare_get_parameters(provider_portions, instances_to_ask, definition_responses, true);
+            }
+            else
+            {
+                append(*instances_to_read, *instances_to_ask);
+            }
+            append(*instances_to_read, *dynamic_instantiation_params);
+            responses.resize(instances_to_read->size());
+            prepare_get_parameters(provider_portions, instances_to_read, responses);
+        }
         else
         {
             responses.resize(instances_to_ask->size());
@@ -1741,30 +1767,50 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
         f.set_exception_notifier([this, p](std::exception_ptr eptr) {
             p->set_exception(std::move(eptr));
         });
-        f.set_notifier([this, p, filter, paging_offset, paging_limit, only_definitions](auto &&dyn_instantiations) {
-            auto second = this->get_all_parameters_internal(filter, paging_offset, paging_limit, false, std::move(dyn_instantiations), only_definitions);
-            second.set_exception_notifier([this, p](std::exception_ptr eptr) {
-                p->set_exception(std::move(eptr));
-            });
-            second.set_notifier([p, dyn_instantiations](auto &&resp) {
-                // replace new instantiations values with old values for consistency
-                for(auto& dyn_inst : dyn_instantiations)
+        f.set_notifier([this, p, filter, paging_offset, paging_limit, only_definitions, only_dynamic](auto &&dyn_instantiations) {
+            this->update_known_dynamic_instantiations(dyn_instantiations);
+            this->get_all_parameters_with_instantiations(p, filter, paging_offset, paging_limit, std::move(dyn_instantiations), only_definitions, only_dynamic);
+        });
+    }
+    else if(use_known_instantiations)
+    {
+        auto f = get_parameters_internal(provider_portions, std::move(responses));
+        f.set_exception_notifier([this, p](std::exception_ptr eptr) {
+            p->set_exception(std::move(eptr));
+        });
+        f.set_notifier([this, p, filter, paging_offset, paging_limit, only_definitions, only_dynamic, entries_count,
+                        instantiations_count = known_instantiations.size(),
+                        definition_responses = std::move(definition_responses)](auto &&r) mutable {
+            auto first_instantiation = r.begin() + static_cast<std::ptrdiff_t>(r.size() - instantiations_count);
+            vector<parameter_response> dyn_instantiations(std::make_move_iterator(first_instantiation), std::make_move_iterator(r.end()));
+            r.erase(first_instantiation, r.end());
+            if(!this->update_known_dynamic_instantiations(dyn_instantiations))
+            {
+                bool const read_failed = std::any_of(dyn_instantiations.begin(), dyn_instantiations.end(), [](auto const &di) {
+                    return di.status != status_codes::success;
+                });
+                if(read_failed)
                 {
-                    if(dyn_inst.status != status_codes::success)
-                    {
-                        continue;
-                    }
-                    for(auto& r : resp.param_responses)
-                    {
-                        if(r.id.id == dyn_inst.id.id)
-                        {
-                            r.value = dyn_inst.value;
-                            break;
-                        }
-                    }
+                    // maybe caused by another parameter of the same call: ask for the instantiations on their own
+                    auto again = this->get_all_parameters_internal(filter, paging_offset, paging_limit, true, {}, only_definitions, only_dynamic);
+                    again.set_exception_notifier([p](std::exception_ptr eptr) {
+                        p->set_exception(std::move(eptr));
+                    });
+                    again.set_notifier([p](auto &&resp) {
+                        p->set_value(std::move(resp));
+                    });
                 }
-                p->set_value(std::move(resp));
-            });
+                else
+                {
+                    // instantiations have changed since they were read last: start over with the ones just read
+                    this->get_all_parameters_with_instantiations(p, filter, paging_offset, paging_limit, std::move(dyn_instantiations), only_definitions, only_dynamic);
+                }
+                return;
+            }
+            parameter_response_list_response resp(status_codes::success);
+            resp.param_responses = only_definitions ? std::move(definition_responses) : std::move(r);
+            resp.total_entries = entries_count;
+            p->set_value(std::move(resp));
         });
     }
     else if(only_definitions)
@@ -1790,6 +1836,91 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
     return p->get_future();
 }
 
+void parameter_service_core::get_all_parameters_with_instantiations(shared_ptr<promise<parameter_response_list_response>> const &p,
+                                                                   parameter_filter                                      const &filter,
+                                                                   size_t                                                       paging_offset,
+                                                                   size_t                                                       paging_limit,
+                                                                   vector<parameter_response>                                   dyn_instantiations,
+                                                                   bool                                                         only_definitions,
+                                                                   bool                                                         only_dynamic)
+{
+    auto second = this->get_all_parameters_internal(filter, paging_offset, paging_limit, false, dyn_instantiations, only_definitions, only_dynamic);
+    second.set_exception_notifier([this, p](std::exception_ptr eptr) {
+        p->set_exception(std::move(eptr));
+    });
+    second.set_notifier([p, dyn_instantiations](auto &&resp) {
+        // replace new instantiations values with old values for consistency
+        for(auto& dyn_inst : dyn_instantiations)
+        {
+            if(dyn_inst.status != status_codes::success)
+            {
+                continue;
+            }
+            for(auto& r : resp.param_responses)
+            {
+                if(r.id.id == dyn_inst.id.id)
+                {
+                    r.value = dyn_inst.value;
+                    break;
+                }
+            }
+        }
+        p->set_value(std::move(resp));
+    });
+}
+
+bool parameter_service_core::get_known_dynamic_instantiations(vector<parameter_instance*> const &instantiation_params,
+                                                             vector<parameter_response>        &known) const
+{
+    known.clear();
+    known.reserve(instantiation_params.size());
+    for(auto const *inst : instantiation_params)
+    {
+        auto const it = m_dynamic_instantiations.find(inst->id);
+        if(it == m_dynamic_instantiations.end())
+        {
+            known.clear();
+            return false;
+        }
+        known.push_back(it->second);
+    }
+    return true;
+}
+
+bool parameter_service_core::update_known_dynamic_instantiations(vector<parameter_response> const &read)
+{
+    lock_guard<std::mutex> guard(m_param_mutex);
+    bool unchanged = true;
+    for(auto const &r : read)
+    {
+        auto const it = m_dynamic_instantiations.find(r.id);
+        if(r.status != status_codes::success)
+        {
+            // only successfully read instantiations are known
+            if(it != m_dynamic_instantiations.end())
+            {
+                unchanged = false;
+                m_dynamic_instantiations.erase(it);
+            }
+            continue;
+        }
+        if(it == m_dynamic_instantiations.end())
+        {
+            unchanged = false;
+            m_dynamic_instantiations.emplace(r.id, r);
+            continue;
+        }
+        auto &known = it->second;
+        bool const same_value = (known.value == r.value) || (known.value && r.value && (*known.value == *r.value));
+        if(!same_value)
+        {
+            unchanged = false;
+            known = r;
+        }
+    }
+    return unchanged;
+}
+
 std::shared_ptr<monitoring_list_collection::monitoring_list> parameter_service_core::get_monitoring_list_internal(monitoring_list_id_t id, status_codes &status)
 {
     return m_monitoring_lists.get_monitoring_list(id, status); // parasoft-suppress CERT_C-CON43-a "Mutex is used by caller."
@@ -1808,18 +1939,168 @@ future<parameter_response_list_response> parameter_service_core::get_all_paramet
     //    discard the new values for dynamic class_instantiations (of Step 6) and replace them with the old responses (of Step 5).
     // NOTE: Before the paging window reaches the dynamic stuff, the total_entries number is not accurate.
     // Otherwise, we would need to always ask the parameter_providers for their dynamic instantiations.
+    // Once the dynamic class_instantiations are known from Step 5, the next call skips Steps 3-5 and starts with Step 6,
+    // reading the dynamic instantiation parameter_instances along with the paging window. Only if they differ from
+    // the known ones (or were written meanwhile), Step 6 is repeated with the new class_instantiations.
 
-    return get_all_parameters_internal(parameter_filter::without_methods() | filter, paging_offset, paging_limit, true, {}, false);
+    return get_all_parameters_internal(parameter_filter::without_methods() | filter, paging_offset, paging_limit, true, {}, false, false);
+}
+
+future<parameter_response_cursor_response> parameter_service_core::get_all_parameters_at_cursor(parameter_filter filter, std::string cursor, size_t paging_limit)
+{
+    // Strategy:
+    // The parameter_instances are paged through in a stable order: the static ones device by device, each device
+    // in the order of its parameter_instance_collection, followed by the dynamic stuff as in get_all_parameters.
+    // 1. A cursor into the static part holds the position of the last parameter_instance of the previous page,
+    //    so the next page is gathered from there on instead of filtering all parameter_instances in front of it again.
+    // 2. The dynamic stuff depends on the dynamic class_instantiations, so it is paged by offset (see get_all_parameters).
+    // 3. The parameter_instances under a subpath are gathered from the path tree, cursors for these are offsets as well.
+    filter = parameter_filter::without_methods() | filter;
+    char          kind = filter._only_subpath.empty() ? g_static_cursor_kind : g_offset_cursor_kind;
+    static_cursor position;
+    size_t        offset = 0;
+    bool const    resume = !cursor.empty();
+    if(resume && (!parse_cursor(cursor, kind, position, offset) || (filter._only_subpath.empty() == (kind == g_offset_cursor_kind))))
+    {
+        return resolved_future(parameter_response_cursor_response(status_codes::invalid_value, "Invalid paging cursor."));
+    }
+    if(paging_limit == 0)
+    {
+        return resolved_future(parameter_response_cursor_response(status_codes::success));
+    }
+    if(kind != g_static_cursor_kind)
+    {
+        return get_all_parameters_at_offset_cursor(filter, kind, offset, paging_limit);
+    }
+
+    auto page = make_shared<vector<parameter_instance*>>();
+    std::vector<provider_read_portion> provider_portions;
+    std::vector<parameter_response> responses;
+    std::string next_cursor;
+    {
+        lock_guard<std::mutex> guard(m_param_mutex);
+
+        size_t coll  = position.device_collection;
+        size_t slot  = position.slot;
+        size_t index = position.index;
+        if(resume)
+        {
+            // the parameter_instances of a device are only appended to, so the position is still valid
+            // as long as it holds the same parameter_instance
+            shared_ptr<device> dev = (coll < m_device_collections.size()) && (slot < m_device_collections[coll].size())
+                                   ? m_device_collections[coll][slot] : nullptr;
+            if(   !dev
+               || (index >= dev->parameter_instances.get_all().size())
+               || (dev->parameter_instances.get_all()[index]->id != position.id))
+            {
+                return resolved_future(parameter_response_cursor_response(status_codes::invalid_value, "Paging cursor is outdated."));
+            }
+            ++index;
+        }
+
+        bool more = false;
+        for(; (coll < m_device_collections.size()) && !more; ++coll, slot = 0)
+        {
+            auto const &devices = m_device_collections[coll];
+            for(; (slot < devices.size()) && !more; ++slot, index = 0)
+            {
+                auto const &dev = devices[slot];
+                if(!dev || !is_match(dev, filter._device))
+                {
+                    continue;
+                }
+                auto const &instances = dev->parameter_instances.get_all();
+                for(; index < instances.size(); ++index)
+                {
+                    auto *inst = instances[index];
+                    if(is_dynamic_instantiations(*inst) || !matches_filter(filter, inst))
+                    {
+                        continue;
+                    }
+                    if(page->size() == paging_limit)
+                    {
+                        more = true;
+                        break;
+                    }
+                    page->push_back(inst);
+                    position = { coll, slot, index, inst->id };
+                }
+            }
+        }
+
+        if(more)
+        {
+            next_cursor = build_cursor(position);
+        }
+        else
+        {
+            // static part is done: continue with the dynamic stuff, if any
+            auto has_dynamic_instantiations = [&filter, this](shared_ptr<device> const &dev) {
+                if(!dev || !is_match(dev, filter._device))
+                {
+                    return false;
+                }
+                auto const &instances = dev->parameter_instances.get_all();
+                return std::any_of(instances.begin(), instances.end(), [](auto const *inst) { return is_dynamic_instantiations(*inst); });
+            };
+            for(auto const &devices : m_device_collections)
+            {
+                if(next_cursor.empty() && std::any_of(devices.begin(), devices.end(), has_dynamic_instantiations))
+                {
+                    next_cursor = build_cursor(g_dynamic_cursor_kind, 0);
+                }
+            }
+        }
+
+        responses.resize(page->size());
+        prepare_get_parameters(provider_portions, page, responses);
+    }
+
+    auto p = make_shared<promise<parameter_response_cursor_response>>();
+    auto f = get_parameters_internal(provider_portions, std::move(responses));
+    f.set_exception_notifier([p](std::exception_ptr eptr) {
+        p->set_exception(std::move(eptr));
+    });
+    f.set_notifier([p, next_cursor](auto &&r) {
+        parameter_response_cursor_response resp(status_codes::success);
+        resp.param_responses = std::move(r);
+        resp.next_cursor = next_cursor;
+        p->set_value(std::move(resp));
+    });
+    return p->get_future();
+}
+
+future<parameter_response_cursor_response> parameter_service_core::get_all_parameters_at_offset_cursor(parameter_filter const &filter,
+                                                                                                   char                    cursor_kind,
+                                                                                                   size_t                  paging_offset,
+                                                                                                   size_t                  paging_limit)
+{
+    auto p = make_shared<promise<parameter_response_cursor_response>>();
+    auto f = get_all_parameters_internal(filter, paging_offset, paging_limit, true, {}, false, cursor_kind == g_dynamic_cursor_kind);
+    f.set_exception_notifier([p](std::exception_ptr eptr) {
+        p->set_exception(std::move(eptr));
+    });
+    f.set_notifier([p, cursor_kind, paging_offset, paging_limit](auto &&r) {
+        parameter_response_cursor_response resp(r.status, r.message);
+        resp.param_responses = std::move(r.param_responses);
+        // total_entries is accurate as soon as the paging window reaches the end
+        if(r.total_entries > paging_offset && (r.total_entries - paging_offset) > paging_limit)
+        {
+            resp.next_cursor = build_cursor(cursor_kind, paging_offset + paging_limit);
+        }
+        p->set_value(std::move(resp));
+    });
+    return p->get_future();
 }
 
 future<parameter_response_list_response> parameter_service_core::get_all_parameter_definitions(parameter_filter filter, size_t paging_offset, size_t paging_limit)
 {
-    return get_all_parameters_internal(parameter_filter::without_methods() | filter, paging_offset, paging_limit, true, {}, true);
+    return get_all_parameters_internal(parameter_filter::without_methods() | filter, paging_offset, paging_limit, true, {}, true, false);
 }
 
 future<parameter_response_list_response> parameter_service_core::get_all_method_definitions(parameter_filter filter, size_t paging_offset, size_t paging_limit)
 {
-    return get_all_parameters_internal(parameter_filter::only_methods() | filter, paging_offset, paging_limit, true, {}, true);
+    return get_all_parameters_internal(parameter_filter::only_methods() | filter, paging_offset, paging_limit, true, {}, true, false);
 }
 
 future<monitoring_list_response> parameter_service_core::create_monitoring_list(std::vector<parameter_instance_id> ids, uint16_t timeout_seconds)
@@ -1954,6 +2235,8 @@ wago::future<vector<response>> parameter_service_core::register_devices(vector<r
                 lock_guard<std::mutex> guard(m_param_mutex);
 
                 this->m_device_collections[device_id.device_collection_id][device_id.slot] = dev;
+                m_dynamic_instantiations.clear();
+                change_model_hash("register " + wda_ipc::to_string(device_id) + " " + request.order_number + " " + request.firmware_version);
 
                 // special parameters in the WAGO-Model. Set them if available.
                 // TODO: Replace magic numbers
@@ -1999,6 +2282,8 @@ wago::future<std::vector<response>> parameter_service_core::unregister_devices(s
         if(dev != nullptr)
         {
             this->m_device_collections[id.device_collection_id][id.slot] = nullptr;
+            m_dynamic_instantiations.clear();
+            change_model_hash("unregister " + wda_ipc::to_string(id));
             result[idx].status = status_codes::success;
             wc_log(log_level_t::info, "Unloaded device " + wda_ipc::to_string(id));
         }
@@ -2026,6 +2311,8 @@ wago::future<response> parameter_service_core::unregister_all_devices(device_col
     {
         this->m_device_collections[device_collection][idx] = nullptr;
     }
+    m_dynamic_instantiations.clear();
+    change_model_hash("unregister all " + std::to_string(device_collection));
 
     result.status = status_codes::success;
     wc_log(log_level_t::info, "Unloaded devices for collection " + std::to_string(device_collection));
@@ -2520,6 +2807,7 @@ void parameter_service_core::load_matched_device_informations(std::shared_ptr<de
                 }
                 if(!wdd_content.empty())
                 {
+                        change_model_hash(wdd_content);
                         device->add_wdd(std::move(wdd_content), *m_model);
                 }
                 m_providers.for_each([this, device](auto prov, auto& data)
@@ -2548,6 +2836,10 @@ void parameter_service_core::load_matched_device_informations(std::shared_ptr<de
         device_description description;
         description.features = response.extension_features;
         device->add_description(description, *m_model);
+        for(auto const &feature : response.extension_features)
+        {
+            change_model_hash("extend " + wda_ipc::to_string(device->id) + " " + feature);
+        }
     }
     // TODO: prepare for retraction of information provided by device_extension_provider_i
 
@@ -3230,4 +3522,156 @@ void append_included_features(std::set<std::string> &features, device_model &mod
     }
 }
 
+bool matches_filter(parameter_filter const &filter, parameter_instance* const &inst)
+{
+    if(inst->id.instance_id == DYNAMIC_PLACEHOLDER_INSTANCE_ID)
+    {
+        return false;
+    }
+    if(filter._without_methods && inst->definition->value_type == parameter_value_types::method)
+    {
+        return false;
+    }
+    if(filter._only_methods && inst->definition->value_type != parameter_value_types::method)
+    {
+        return false;
+    }
+    if(filter._without_file_ids && inst->definition->value_type == parameter_value_types::file_id)
+    {
+        return false;
+    }
+    if(filter._only_file_ids && inst->definition->value_type != parameter_value_types::file_id)
+    {
+        return false;
+    }
+    if(filter._without_beta && inst->definition->is_beta)
+    {
+        return false;
+    }
+    if(filter._only_beta && !inst->definition->is_beta)
+    {
+        return false;
+    }
+    if(filter._without_deprecated && inst->definition->is_deprecated)
+    {
+        return false;
+    }
+    if(filter._only_deprecated && !inst->definition->is_deprecated)
+    {
+        return false;
+    }
+    if(filter._without_usersettings && (inst->definition->user_setting && !inst->definition->overrideables.inactive))
+    {
+        return false;
+    }
+    if(filter._only_usersettings && (!inst->definition->user_setting || inst->definition->overrideables.inactive))
+    {
+        return false;
+    }
+    if(filter._without_writeable && (inst->definition->writeable && !inst->definition->overrideables.inactive))
+    {
+        return false;
+    }
+    if(filter._only_writeable && (!inst->definition->writeable || inst->definition->overrideables.inactive))
+    {
+        return false;
+    }
+    if(!filter._only_features.empty())
+    {
+        // feature of instance currently looked at
+        auto& instance_feature = inst->definition->feature_def;
+        if(instance_feature.expired())
+        {
+            wc_log(log_level_t::warning, "Parameter definition '" + inst->definition->path + "' (id=" + std::to_string(inst->definition->id) + ") belongs to no feature");
+            return false;
+        }
+
+        // check if instance feature is contained in feature list of filter
+        auto instance_feature_name = instance_feature.lock()->name;
+        auto instance_feature_found_in_filter = 
+            filter._only_features.end() != std::find_if(
+                filter._only_features.begin(), filter._only_features.end(), 
+                [instance_feature_name](auto const &filter_feature_name) {
+                    return device_model::names_equal(instance_feature_name, filter_feature_name);
+                });
+
+        if(!instance_feature_found_in_filter)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool is_dynamic_instantiations(parameter_instance const &inst)
+{
+    return inst.definition->value_type == parameter_value_types::instantiations && !inst.fixed_value;
+}
+
+uint64_t combine_hash(uint64_t hash, string const &value)
+{
+    // boost::hash_combine, widened to 64 bit
+    return hash ^ (std::hash<string>()(value) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+}
+
+string build_cursor(static_cursor const &position)
+{
+    return string(1, g_static_cursor_kind) + '.' + std::to_string(position.device_collection)
+                                           + '.' + std::to_string(position.slot)
+                                           + '.' + std::to_string(position.index)
+                                           + '.' + std::to_string(position.id.id)
+                                           + '.' + std::to_string(position.id.instance_id);
+}
+
+string build_cursor(char kind, size_t offset)
+{
+    return string(1, kind) + '.' + std::to_string(offset);
+}
+
+bool parse_cursor(string const &cursor, char &kind, static_cursor &position, size_t &offset)
+{
+    vector<unsigned long long> numbers;
+    if(cursor.size() < 3 || cursor[1] != '.')
+    {
+        return false;
+    }
+    for(size_t pos = 2; pos <= cursor.size(); )
+    {
+        auto const end = std::min(cursor.find('.', pos), cursor.size());
+        auto const part = cursor.substr(pos, end - pos);
+        if(part.empty() || part.find_first_not_of("0123456789") != string::npos)
+        {
+            return false;
+        }
+        try
+        {
+            numbers.push_back(std::stoull(part));
+        }
+        catch(std::out_of_range const &)
+        {
+            return false;
+        }
+        pos = end + 1;
+    }
+
+    kind = cursor[0];
+    if(kind == g_static_cursor_kind && numbers.size() == 5)
+    {
+        position.device_collection = numbers[0];
+        position.slot              = numbers[1];
+        position.index             = numbers[2];
+        position.id                = parameter_instance_id(static_cast<parameter_id_t>(numbers[3]),
+                                                           static_cast<instance_id_t>(numbers[4]),
+                                                           device_id(static_cast<slot_index_t>(numbers[1]),
+                                                                     static_cast<device_collection_id_t>(numbers[0])));
+        return true;
+    }
+    if((kind == g_dynamic_cursor_kind || kind == g_offset_cursor_kind) && numbers.size() == 1)
+    {
+        offset = numbers[0];
+        return true;
+    }
+    return false;
+}
+
 }}}
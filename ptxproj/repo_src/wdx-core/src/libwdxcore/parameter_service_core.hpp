@@ -14,6 +14,7 @@
 #define SRC_LIBWDXCORE_PARAMETER_SERVICE_CORE_HPP_
 
 #include <unordered_map>
+#include <map>
 #include <memory>
 #include <queue>
 #include <iostream>
@@ -67,6 +68,7 @@ public:
     future<device_collection_response> get_subdevices_by_collection_name(std::string device_collection_name) override;
 
     future<parameter_response_list_response> get_all_parameters(parameter_filter filter, size_t paging_offset, size_t paging_limit) override;
+    future<parameter_response_cursor_response> get_all_parameters_at_cursor(parameter_filter filter, std::string cursor, size_t paging_limit) override;
     future<parameter_response_list_response> get_all_parameter_definitions(parameter_filter filter, size_t paging_offset = 0, size_t paging_limit = SIZE_MAX) override;
     future<parameter_response_list_response> get_all_method_definitions(parameter_filter filter, size_t paging_offset = 0, size_t paging_limit = SIZE_MAX) override;
 
@@ -90,6 +92,7 @@ public:
     future<feature_response> get_feature_definition(device_path_t device, name_t feature_name) override;
     future<enum_definition_response> get_enum_definition(name_t enum_name) override;
     future<std::vector<enum_definition_response>> get_all_enum_definitions() override;
+    future<model_hash_response> get_model_hash() override;
 
     // *********************************************
     // IParameterServiceBackend Methods
@@ -210,6 +213,12 @@ private:
     std::shared_ptr<device_model> m_model;
     void load_model(std::string& wdm_artifact);
 
+    // hash over all changes the definitions depend on, has_dynamic_instantiations is determined on demand
+    uint64_t m_model_hash = 0;
+    bool     m_model_dynamic_instantiations_known = false;
+    bool     m_model_dynamic_instantiations = false;
+    void change_model_hash(std::string const &change);
+
     // registering
     bool is_match(std::shared_ptr<device> const &device,
                   device_selector         const &selector);
@@ -300,7 +309,25 @@ private:
                                                                          size_t                                 paging_limit,
                                                                          bool                                   first_phase,
                                                                          std::vector<parameter_response> const &dyn_instantiation_responses,
-                                                                         bool                                   only_definitions);
+                                                                         bool                                   only_definitions,
+                                                                         bool                                   only_dynamic);
+    void get_all_parameters_with_instantiations(std::shared_ptr<promise<parameter_response_list_response>> const &p,
+                                                parameter_filter                                           const &filter,
+                                                size_t                                                            paging_offset,
+                                                size_t                                                            paging_limit,
+                                                std::vector<parameter_response>                                   dyn_instantiations,
+                                                bool                                                              only_definitions,
+                                                bool                                                              only_dynamic);
+    future<parameter_response_cursor_response> get_all_parameters_at_offset_cursor(parameter_filter const &filter,
+                                                                                   char                    cursor_kind,
+                                                                                   size_t                  paging_offset,
+                                                                                   size_t                  paging_limit);
+
+    // dynamic class instantiations as last read from the parameter_providers, by instantiations parameter
+    std::map<parameter_instance_id, parameter_response> m_dynamic_instantiations;
+    bool get_known_dynamic_instantiations(std::vector<parameter_instance*> const &instantiation_params,
+                                          std::vector<parameter_response>        &known) const;
+    bool update_known_dynamic_instantiations(std::vector<parameter_response> const &read);
 
     std::shared_ptr<monitoring_list_collection::monitoring_list>  get_monitoring_list_internal(monitoring_list_id_t id,
                                                                                                status_codes &status) override;
@@ -68,6 +68,15 @@ public:
     */
     virtual wago::future<std::vector<parameter_response>> get_parameter_definitions_by_path(std::vector<parameter_instance_path> paths) = 0;
 
+    /**
+    Same as `get_all_parameters` from the `parameter_service_frontend_i`, but pages through the parameters with a cursor
+    instead of an offset: Starting with an empty `cursor`, each response contains up to `paging_limit` parameters and the
+    `next_cursor` to continue with. The next page is continued at the position of the cursor, so only the requested
+    page is gathered and read from the parameter providers.
+    Cursors are opaque and only valid for the same filter.
+    */
+    virtual wago::future<parameter_response_cursor_response> get_all_parameters_at_cursor(parameter_filter filter, std::string cursor, size_t paging_limit) = 0;
+
     virtual wago::future<parameter_response_list_response> get_all_parameter_definitions(parameter_filter filter, size_t paging_offset = 0, size_t paging_limit = SIZE_MAX) = 0;
 
     virtual wago::future<parameter_response_list_response> get_all_method_definitions(parameter_filter filter, size_t paging_offset = 0, size_t paging_limit = SIZE_MAX) = 0;
@@ -124,6 +133,12 @@ public:
      */
     virtual wago::future<std::vector<enum_definition_response>> get_all_enum_definitions() = 0;
 
+    /**
+    Gets the hash of the current model state. It changes whenever definitions may change, e.g. on loaded models,
+    device descriptions or (un)registered devices and parameter providers. The hash is specific to the permissions of the caller.
+     */
+    virtual wago::future<model_hash_response> get_model_hash() = 0;
+
     /**
     Deletes the monitor list for given ID.
     */
@@ -13,11 +13,220 @@
 #include "serial_parameter_provider.hpp"
 #include "utils/provider_job.hpp"
 
+#include <wc/assertion.h>
+
 namespace wago {
 namespace wdx {
 
-serial_parameter_provider::serial_parameter_provider(parameter_provider_i* wrapped_provider_)
+/// Job reading the values of several pending `get_parameter_values` calls with one call of the provider.
+class read_batch_job final : public job_i {
+    WC_DISBALE_CLASS_COPY_AND_ASSIGN(read_batch_job)
+public:
+    using responses_type = std::vector<value_response>;
+    using promise_type   = wago::promise<responses_type>;
+
+    read_batch_job(parameter_provider_i *provider_, size_t limit_)
+    : provider(provider_)
+    , limit(limit_)
+    {}
+
+    ~read_batch_job() noexcept override
+    {
+        cancel();
+    }
+
+    /// Adds the read of `parameter_ids` to this batch, unless the batch has already been started or would exceed its limit.
+    bool try_add(std::vector<parameter_instance_id> &parameter_ids, std::shared_ptr<promise_type> const &promise)
+    {
+        std::lock_guard<std::mutex> lock(reads_mutex);
+        if(started || (count + parameter_ids.size() > limit))
+        {
+            return false;
+        }
+        count += parameter_ids.size();
+        reads.push_back({ std::move(parameter_ids), promise });
+        return true;
+    }
+
+    void start(std::function<void()> on_complete) noexcept override
+    {
+        try
+        {
+            std::vector<parameter_instance_id> parameter_ids;
+            {
+                std::lock_guard<std::mutex> lock(reads_mutex);
+                started = true;
+                parameter_ids.reserve(count);
+                for(auto const &read : reads)
+                {
+                    parameter_ids.insert(parameter_ids.end(), read.parameter_ids.begin(), read.parameter_ids.end());
+                }
+            }
+            pending_future = std::make_unique<wago::future<responses_type>>(provider->get_parameter_values(std::move(parameter_ids)));
+            pending_future->set_notifier([this, on_complete](auto &&result){
+                split_responses(std::move(result), on_complete);
+            });
+            pending_future->set_exception_notifier([this, on_complete](auto &&ex) {
+                fail(ex, on_complete);
+            });
+        }
+        catch(...)
+        {
+            // Neither set_notifier nor set_exception_notifier should throw
+            WC_FAIL("Unexpected exception caught in read_batch_job::start");
+            set_exception(std::current_exception());
+            on_complete();
+        }
+    }
+
+    void cancel() noexcept override
+    {
+        bool canceled = false;
+        if(pending_future && !pending_future->ready())
+        {
+            dismiss(*pending_future);
+            canceled = true;
+        }
+        for(auto &single_future : single_futures)
+        {
+            if(!single_future->ready())
+            {
+                dismiss(*single_future);
+                canceled = true;
+            }
+        }
+        if(canceled)
+        {
+            set_exception(std::make_exception_ptr(parameter_exception("Serial wrapper has been cleaned up before the response has been received.")));
+        }
+    }
+
+private:
+    struct read
+    {
+        std::vector<parameter_instance_id> parameter_ids;
+        std::shared_ptr<promise_type>      promise;
+    };
+
+    static void dismiss(wago::future<responses_type> &future)
+    {
+        future.set_notifier([](auto&&){});
+        future.set_exception_notifier([](auto&&){});
+        future.dismiss();
+    }
+
+    void split_responses(responses_type &&responses, std::function<void()> const &on_complete) noexcept
+    {
+        if(reads.size() == 1)
+        {
+            set_value(reads.front(), std::move(responses));
+            on_complete();
+            return;
+        }
+        if(responses.size() != count)
+        {
+            fail(std::make_exception_ptr(parameter_exception("Provider returned " + std::to_string(responses.size()) +
+                                                             " value responses for " + std::to_string(count) + " parameters.")),
+                 on_complete);
+            return;
+        }
+        auto next_response = responses.begin();
+        for(auto &read : reads)
+        {
+            auto const end_of_read = next_response + static_cast<responses_type::difference_type>(read.parameter_ids.size());
+            set_value(read, responses_type(std::make_move_iterator(next_response), std::make_move_iterator(end_of_read)));
+            next_response = end_of_read;
+        }
+        on_complete();
+    }
+
+    /// A failed batch does not fail all of its callers: each read is repeated on its own,
+    /// as it would have been without batching.
+    void fail(std::exception_ptr ex, std::function<void()> const &on_complete) noexcept
+    {
+        if(reads.size() == 1)
+        {
+            set_exception(reads.front(), ex);
+            on_complete();
+            return;
+        }
+        single_futures.reserve(reads.size());
+        read_single(0, on_complete);
+    }
+
+    void read_single(size_t index, std::function<void()> const &on_complete) noexcept
+    {
+        if(index == reads.size())
+        {
+            on_complete();
+            return;
+        }
+        try
+        {
+            // Each read keeps its own future: a provider responding right away completes
+            // the following reads before the notifiers of this one are set.
+            single_futures.push_back(std::make_unique<wago::future<responses_type>>(provider->get_parameter_values(reads[index].parameter_ids)));
+            auto &single_future = *single_futures.back();
+            single_future.set_notifier([this, index, on_complete](auto &&result){
+                set_value(reads[index], std::move(result));
+                read_single(index + 1, on_complete);
+            });
+            single_future.set_exception_notifier([this, index, on_complete](auto &&ex) {
+                set_exception(reads[index], ex);
+                read_single(index + 1, on_complete);
+            });
+        }
+        catch(...)
+        {
+            // Neither set_notifier nor set_exception_notifier should throw
+            WC_FAIL("Unexpected exception caught in read_batch_job::read_single");
+            set_exception(reads[index], std::current_exception());
+            read_single(index + 1, on_complete);
+        }
+    }
+
+    static void set_value(read &read, responses_type &&responses) noexcept
+    {
+        try
+        {
+            read.promise->set_value(std::move(responses));
+        }
+        catch(...) {} // parasoft-suppress CERT_CPP-ERR56-b "There actually is nothing to-do when the promise already is satisfied."
+    }
+
+    static void set_exception(read &read, std::exception_ptr ex) noexcept
+    {
+        try
+        {
+            if(read.promise->execute())
+            {
+                read.promise->set_exception(ex);
+            }
+        }
+        catch(...) {} // parasoft-suppress CERT_CPP-ERR56-b "There actually is nothing to-do when the promise already is satisfied."
+    }
+
+    void set_exception(std::exception_ptr ex) noexcept
+    {
+        for(auto &read : reads)
+        {
+            set_exception(read, ex);
+        }
+    }
+
+    parameter_provider_i                            *provider;
+    size_t                                    const  limit;
+    std::mutex                                       reads_mutex;
+    bool                                             started = false;
+    size_t                                           count   = 0;
+    std::vector<read>                                reads;
+    std::unique_ptr<wago::future<responses_type>>    pending_future;
+    std::vector<std::unique_ptr<wago::future<responses_type>>> single_futures;
+};
+
+serial_parameter_provider::serial_parameter_provider(parameter_provider_i* wrapped_provider_, size_t read_batch_limit_)
 : wrapped_provider(wrapped_provider_)
+, read_batch_limit(read_batch_limit_)
 {}
 
 serial_parameter_provider::~serial_parameter_provider() noexcept = default;
@@ -37,11 +246,31 @@ wago::future<std::vector<value_response>> serial_parameter_provider::get_paramet
 {
     auto promise = std::make_shared<wago::promise<std::vector<value_response>>>();
 
+    if(parameter_ids.size() <= read_batch_limit)
+    {
+        std::shared_ptr<read_batch_job> batch;
+        {
+            std::lock_guard<std::mutex> read_batch_lock(read_batch_mutex);
+            auto pending_batch = pending_read_batch.lock();
+            if((pending_batch != nullptr) && pending_batch->try_add(parameter_ids, promise))
+            {
+                return promise->get_future();
+            }
+            batch = std::make_shared<read_batch_job>(wrapped_provider, read_batch_limit);
+            batch->try_add(parameter_ids, promise);
+            pending_read_batch = batch;
+        }
+        // enqueue without lock, the job may start and complete right away
+        queue.enqueue_job(batch, job_priority::interactive);
+
+        return promise->get_future();
+    }
+
     using get_job = provider_job<std::vector<value_response>>;
     auto job = std::make_shared<get_job>(promise, [provider=wrapped_provider, parameter_ids=std::move(parameter_ids)] () {
         return provider->get_parameter_values(std::move(parameter_ids));
     });
-    queue.enqueue_job(job);
+    queue.enqueue_job(job, job_priority::interactive);
  
     return promise->get_future();
 }
@@ -62,7 +291,7 @@ wago::future<std::vector<set_parameter_response>> serial_parameter_provider::set
     auto job = std::make_shared<set_job>(promise, [provider=wrapped_provider, value_requests=std::move(value_requests), defer_wda_web_connection_changes] () {
         return provider->set_parameter_values_connection_aware(std::move(value_requests), defer_wda_web_connection_changes);
     });
-    queue.enqueue_job(job);
+    queue.enqueue_job(job, job_priority::write);
  
     return promise->get_future();
 }
@@ -77,7 +306,7 @@ wago::future<method_invocation_response> serial_parameter_provider::invoke_metho
     auto job = std::make_shared<invoke_job>(promise, [provider=wrapped_provider, method_id=std::move(method_id), in_args=std::move(in_args)] () {
         return provider->invoke_method(std::move(method_id), std::move(in_args));
     });
-    queue.enqueue_job(job);
+    queue.enqueue_job(job, job_priority::long_running);
  
     return promise->get_future();
 }
@@ -90,7 +319,7 @@ wago::future<file_id_response> serial_parameter_provider::create_parameter_uploa
     auto job = std::make_shared<upload_id_job>(promise, [provider=wrapped_provider, context] () {
         return provider->create_parameter_upload_id(context);
     });
-    queue.enqueue_job(job);
+    queue.enqueue_job(job, job_priority::background);
  
     return promise->get_future();
 }
@@ -103,7 +332,7 @@ wago::future<response> serial_parameter_provider::remove_parameter_upload_id(fil
     auto job = std::make_shared<remove_upload_id_job>(promise, [provider=wrapped_provider, id=std::move(id), context] () {
         return provider->remove_parameter_upload_id(std::move(id), context);
     });
-    queue.enqueue_job(job);
+    queue.enqueue_job(job, job_priority::background);
  
     return promise->get_future();
 }
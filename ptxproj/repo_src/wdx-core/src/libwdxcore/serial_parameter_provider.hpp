@@ -17,18 +17,29 @@
 #include "utils/job_queue.hpp"
 #include "wago/wdx/parameter_provider_i.hpp"
 
+#include <mutex>
+
 namespace wago {
 namespace wdx {
 
+class read_batch_job;
+
 /**
 Wraps a `parameter_provider_i`-Implementation so that its methods are not called in parallel.
+Pending calls are served by priority: reads before writes, writes before method invocations
+and upload ID handling last (see `job_queue` for the aging of pending calls).
+Small reads, which are pending at the same time, are combined into one call of the wrapped provider
+with up to `read_batch_limit` parameters. A `read_batch_limit` of 0 disables the batching.
+If the combined call fails, the combined reads are repeated one by one, so that they fail independently.
  */
 class serial_parameter_provider : public parameter_provider_i
 {
 public:
+    static constexpr size_t default_read_batch_limit = 64;
+
     serial_parameter_provider(serial_parameter_provider const &) noexcept = default;
     serial_parameter_provider &operator=(serial_parameter_provider const &) noexcept = default;
-    serial_parameter_provider(parameter_provider_i* wrapped_provider);
+    serial_parameter_provider(parameter_provider_i* wrapped_provider, size_t read_batch_limit = default_read_batch_limit);
     ~serial_parameter_provider() noexcept override;
 
     std::string display_name() override;
@@ -41,8 +52,11 @@ public:
     wago::future<response> remove_parameter_upload_id(file_id id, parameter_id_t context) override;
 
 private:
-    parameter_provider_i* wrapped_provider;
-    job_queue queue;
+    parameter_provider_i*         wrapped_provider;
+    size_t                        read_batch_limit;
+    std::mutex                    read_batch_mutex;
+    std::weak_ptr<read_batch_job> pending_read_batch;
+    job_queue                     queue;
 };
 
 }
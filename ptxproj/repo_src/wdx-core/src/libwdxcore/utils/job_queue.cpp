@@ -21,6 +21,10 @@ namespace {
 void do_if_not_destroyed(shared_marker exit_marker, shared_mutex exit_mutex, std::function<void()> task);
 }
 
+job_queue::job_queue(unsigned aging_limit)
+: aging_limit_m(aging_limit)
+{ }
+
 job_queue::~job_queue() noexcept
 {
     *exit_marker_m = true;
@@ -40,13 +44,13 @@ job_queue::~job_queue() noexcept
     }
 }
 
-void job_queue::enqueue_job(std::shared_ptr<job_i> job)
+void job_queue::enqueue_job(std::shared_ptr<job_i> job, job_priority priority)
 {
     bool needs_start = false;
     {
         std::lock_guard<std::mutex> jobs_lock_guard(jobs_mutex_m);
-        needs_start = jobs_m.empty();
-        jobs_m.push(std::move(job));
+        needs_start = (running_job_m == nullptr) && !has_pending_jobs();
+        jobs_m[static_cast<size_t>(priority)].push_back(std::move(job));
     }
     if (needs_start)
     {
@@ -57,11 +61,20 @@ void job_queue::enqueue_job(std::shared_ptr<job_i> job)
 void job_queue::cancel_jobs()
 {
     std::lock_guard<std::mutex> jobs_lock_guard(jobs_mutex_m);
-    while(!jobs_m.empty())
+    if(running_job_m != nullptr)
+    {
+        running_job_m->cancel();
+        running_job_m.reset();
+    }
+    for(auto &jobs : jobs_m)
     {
-        jobs_m.front()->cancel();
-        jobs_m.pop();
+        while(!jobs.empty())
+        {
+            jobs.front()->cancel();
+            jobs.pop_front();
+        }
     }
+    overtaken_m.fill(0);
 }
 
 
@@ -74,9 +87,10 @@ void job_queue::start_jobs(shared_marker exit_marker, shared_mutex exit_mutex)
         [this, &next_job]() 
         {
             std::lock_guard<std::mutex> jobs_lock_guard(jobs_mutex_m);
-            if(!jobs_m.empty())
+            if(running_job_m == nullptr)
             {
-                next_job = jobs_m.front();
+                next_job      = take_next_job();
+                running_job_m = next_job;
             }
         }
     );
@@ -92,11 +106,11 @@ void job_queue::start_jobs(shared_marker exit_marker, shared_mutex exit_mutex)
                 {
                     // remove the job that just finished
                     std::lock_guard<std::mutex> jobs_lock_guard(jobs_mutex_m);
-                    if(!jobs_m.empty() && jobs_m.front().get() == current_job_ptr)
+                    if(running_job_m.get() == current_job_ptr)
                     {
-                        jobs_m.pop();
-                    }                
-                    next_job_available = !jobs_m.empty();
+                        running_job_m.reset();
+                    }
+                    next_job_available = (running_job_m == nullptr) && has_pending_jobs();
                 }
             );
 
@@ -109,6 +123,57 @@ void job_queue::start_jobs(shared_marker exit_marker, shared_mutex exit_mutex)
     }
 }
 
+std::shared_ptr<job_i> job_queue::take_next_job()
+{
+    // the pending job of highest priority, unless a job of lower priority
+    // has been overtaken too often
+    size_t next = priority_count;
+    for(size_t priority = 0; priority < priority_count; ++priority)
+    {
+        if(jobs_m[priority].empty())
+        {
+            continue;
+        }
+        if(next == priority_count)
+        {
+            next = priority;
+        }
+        else if(overtaken_m[priority] >= aging_limit_m)
+        {
+            next = priority;
+            break;
+        }
+    }
+    if(next == priority_count)
+    {
+        return nullptr;
+    }
+
+    for(size_t priority = next + 1; priority < priority_count; ++priority)
+    {
+        if(!jobs_m[priority].empty())
+        {
+            overtaken_m[priority]++;
+        }
+    }
+    overtaken_m[next] = 0;
+    auto job = std::move(jobs_m[next].front());
+    jobs_m[next].pop_front();
+    return job;
+}
+
+bool job_queue::has_pending_jobs() const
+{
+    for(auto const &jobs : jobs_m)
+    {
+        if(!jobs.empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 namespace
 {
     void do_if_not_destroyed(shared_marker exit_marker, shared_mutex exit_mutex, std::function<void()> task)
@@ -13,7 +13,9 @@
 #ifndef SRC_LIBWDXCORE_UTILS_JOB_QUEUE_HPP_
 #define SRC_LIBWDXCORE_UTILS_JOB_QUEUE_HPP_
 
-#include <queue>
+#include <array>
+#include <cstdint>
+#include <deque>
 #include <mutex>
 #include <memory>
 #include <atomic>
@@ -36,21 +38,46 @@ public:
     virtual void cancel() noexcept = 0;
 };
 
+/// Priority classes of jobs, in order of precedence.
+enum class job_priority : uint8_t
+{
+    interactive,  ///< Short reads a client is waiting for (e.g. monitoring lists)
+    write,        ///< Writes, the default for jobs without explicit priority
+    long_running, ///< Potentially long running jobs (e.g. method invocations)
+    background    ///< Jobs nobody is actively waiting for
+};
+
 /// A queue for serial execution of asyncronous tasks. Tasks managed by the
 /// queue will be processed sequentially one after another.
+///
+/// Pending jobs are started by priority and in order of their enqueueing
+/// within the same priority. To prevent starvation, a pending job is started
+/// next, once it has been overtaken by jobs of higher priority `aging_limit`
+/// times.
 class job_queue final {
     WC_DISBALE_CLASS_COPY_AND_ASSIGN(job_queue)
 
+public:
+    static constexpr unsigned default_aging_limit = 4;
+
 private:
-    std::mutex                         jobs_mutex_m;
-    std::queue<std::shared_ptr<job_i>> jobs_m;
+    static constexpr size_t priority_count = static_cast<size_t>(job_priority::background) + 1;
+
+    unsigned                                                 const aging_limit_m;
+    std::mutex                                                     jobs_mutex_m;
+    std::shared_ptr<job_i>                                         running_job_m;
+    std::array<std::deque<std::shared_ptr<job_i>>, priority_count> jobs_m;
+    std::array<unsigned, priority_count>                           overtaken_m = {};
 
     shared_marker exit_marker_m = std::make_shared<std::atomic<bool>>(false);
     shared_mutex  exit_mutex_m  = std::make_shared<std::mutex>();
 public:
 
     /// New, empty queue
-    job_queue() = default;
+    ///
+    /// \param aging_limit Number of times a pending job may be overtaken by
+    ///                    jobs of higher priority before it is started next.
+    explicit job_queue(unsigned aging_limit = default_aging_limit);
 
     /// Destroys the queue. Upon destruction, pending and the potential running
     /// job will be canceled by calling their `cancel` method.
@@ -60,12 +87,13 @@ public:
     /// possible.
     /// 
     /// Either it starts just right away, or it gets enqueued to start
-    /// after the preceeding job has been completed (called its completion
-    /// handler). In the latter case, a job will not start, when the queue's 
+    /// after the running job has been completed (called its completion
+    /// handler) and no job of higher priority is pending. In the latter case, a job will not start, when the queue's 
     /// `cancel_jobs` method has been called or the queue itself got destructed.
     ///
-    /// \param job The job to be added to the queue.
-    void enqueue_job(std::shared_ptr<job_i> job);
+    /// \param job      The job to be added to the queue.
+    /// \param priority The priority class of the job.
+    void enqueue_job(std::shared_ptr<job_i> job, job_priority priority = job_priority::write);
 
     /// \brief Cancels all pending and a potentially started job by clearing the
     /// queue and by calling the `cancel` method of all jobs.
@@ -73,6 +101,8 @@ public:
 
 private:
     void start_jobs(shared_marker exit_marker, shared_mutex exit_mutex);
+    std::shared_ptr<job_i> take_next_job();
+    bool has_pending_jobs() const;
 };
 
 }
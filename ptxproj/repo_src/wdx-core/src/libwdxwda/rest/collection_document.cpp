@@ -44,6 +44,11 @@ static string const create_pagination_link_url(string   const &base_url,
                                                unsigned const  limit_value,
                                                unsigned const  offset_value);
 
+static string const create_pagination_link_url(string   const &base_url,
+                                               string   const &query_without_pagination,
+                                               unsigned const  limit_value,
+                                               string   const &cursor_value);
+
 //------------------------------------------------------------------------------
 // function implementation
 //------------------------------------------------------------------------------
@@ -67,6 +72,17 @@ static string const create_pagination_link_url(string   const &base_url,
     return link;
 }
 
+static string const create_pagination_link_url(string   const &base_url,
+                                               string   const &query_without_pagination,
+                                               unsigned const  limit_value,
+                                               string   const &cursor_value)
+{
+    string link = base_url + (query_without_pagination.empty() ? "" : query_without_pagination);
+    append_query_parameter_to_url(link, page_limit_query_key, std::to_string(limit_value));
+    append_query_parameter_to_url(link, page_cursor_query_key, cursor_value);
+    return link;
+}
+
 template<class wrapped_type>
 static vector<basic_resource<wrapped_type>> resources_from_wrapped_types(vector<wrapped_type> const &wrapped_objects)
 {
@@ -105,6 +121,7 @@ collection_document<T>::collection_document(map<string, string> const  &meta,
 , page_offset_m(0)
 , page_limit_m(0)
 , page_element_max_m(0)
+, cursor_paging_m(false)
 {
     // Dont create links and self link in this case. 
     // Constructor is meant to be used for responses that do not contain
@@ -133,6 +150,7 @@ collection_document<T>::collection_document(string              const  &base_pat
 , page_offset_m(page_offset)
 , page_limit_m(page_limit)
 , page_element_max_m(page_element_max)
+, cursor_paging_m(false)
 {
     create_filtered_query();
     // May include applied default parameters (e.g. pagination) in meta area like done on
@@ -152,6 +170,41 @@ collection_document<T>::collection_document(string               const  &base_pa
 : collection_document(base_path, query, meta, resources_from_wrapped_types(data), page_offset, page_limit, page_element_max)
 { }
 
+template <class T>
+collection_document<T>::collection_document(string              const  &base_path,
+                                            string              const  &query,
+                                            map<string, string> const  &meta,
+                                            vector<T>           const &&data,
+                                            string              const  &page_cursor,
+                                            unsigned            const   page_limit,
+                                            string              const  &next_page_cursor)
+: base_path_m(base_path)
+, query_m(query)
+, data_m(data)
+, meta_m(meta)
+, page_offset_m(0)
+, page_limit_m(page_limit)
+, page_element_max_m(0)
+, cursor_paging_m(true)
+, page_cursor_m(page_cursor)
+, next_page_cursor_m(next_page_cursor)
+{
+    create_filtered_query();
+    create_links();
+    create_errors();
+}
+
+template <class T>
+collection_document<T>::collection_document(string               const  &base_path,
+                                            string               const  &query,
+                                            map<string, string>  const  &meta,
+                                            vector<wrapped_type> const &&data,
+                                            string               const  &page_cursor,
+                                            unsigned             const   page_limit,
+                                            string               const  &next_page_cursor)
+: collection_document(base_path, query, meta, resources_from_wrapped_types(data), page_cursor, page_limit, next_page_cursor)
+{ }
+
 template <class T>
 vector<T> const collection_document<T>::get_data() const
 {
@@ -228,7 +281,19 @@ void collection_document<T>::create_filtered_query()
 template <class T>
 void collection_document<T>::create_links()
 {
-    if(links_m.empty())
+    if(links_m.empty() && cursor_paging_m)
+    {
+        // Position of the last page and previous pages are not known by cursor
+        links_m.insert( { self_link_name,       get_self_link()       } );
+        links_m.insert( { first_page_link_name, get_first_page_link() } );
+
+        string const next_page_link = get_next_page_link();
+        if(!next_page_link.empty())
+        {
+            links_m.insert( { next_page_link_name, next_page_link } );
+        }
+    }
+    else if(links_m.empty())
     {
         links_m.insert( { self_link_name,       get_self_link()       } );
         links_m.insert( { first_page_link_name, get_first_page_link() } );
@@ -251,6 +316,10 @@ template <class T>
 string const collection_document<T>::get_self_link() const
 {
     // Include each (query) parameter, even applied default values as suggested in https://stackoverflow.com/a/37454140
+    if(cursor_paging_m)
+    {
+        return create_pagination_link_url(base_path_m, query_without_pagination_m, page_limit_m, page_cursor_m);
+    }
     return create_pagination_link_url(base_path_m, query_without_pagination_m, page_limit_m, page_offset_m);
 }
 
@@ -258,6 +327,14 @@ template <class T>
 string const collection_document<T>::get_next_page_link() const
 {
     string next_link; // empty by default
+    if(cursor_paging_m)
+    {
+        if(!next_page_cursor_m.empty())
+        {
+            next_link = create_pagination_link_url(base_path_m, query_without_pagination_m, page_limit_m, next_page_cursor_m);
+        }
+        return next_link;
+    }
     unsigned const next_page_offset = page_offset_m + page_limit_m;
     if(page_element_max_m > next_page_offset)
     {
@@ -296,6 +373,10 @@ string const collection_document<T>::get_last_page_link() const
 template <class T>
 string const collection_document<T>::get_first_page_link() const
 {
+    if(cursor_paging_m)
+    {
+        return create_pagination_link_url(base_path_m, query_without_pagination_m, page_limit_m, string());
+    }
     return create_pagination_link_url(base_path_m, query_without_pagination_m, page_limit_m, 0);
 }
 
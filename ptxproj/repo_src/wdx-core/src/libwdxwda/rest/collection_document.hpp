@@ -60,6 +60,9 @@ private:
     unsigned            page_offset_m;
     unsigned            page_limit_m;
     unsigned            page_element_max_m;
+    bool                cursor_paging_m;
+    string              page_cursor_m;
+    string              next_page_cursor_m;
 
 public:
     /// This constructor is meant to be used for responses that do not contain
@@ -92,6 +95,28 @@ public:
                         unsigned             const   page_limit,
                         unsigned             const   page_element_max);
 
+    /// This constructor is meant to be used for responses that contain
+    /// link information and cursor based pagination (e.g. responses to GET requests).
+    /// An empty `next_page_cursor` marks the last page.
+    collection_document(string              const  &base_path,
+                        string              const  &query,
+                        map<string, string> const  &meta,
+                        vector<T>           const &&data,
+                        string              const  &page_cursor,
+                        unsigned            const   page_limit,
+                        string              const  &next_page_cursor);
+
+    /// This constructor is meant to be used for responses that contain
+    /// link information and cursor based pagination (e.g. responses to GET requests).
+    /// An empty `next_page_cursor` marks the last page.
+    collection_document(string               const  &base_path,
+                        string               const  &query,
+                        map<string, string>  const  &meta,
+                        vector<wrapped_type> const &&data,
+                        string               const  &page_cursor,
+                        unsigned             const   page_limit,
+                        string               const  &next_page_cursor);
+
     vector<T>           const   get_data()   const;
     bool                        has_links()  const;
     map<string, string> const & get_links()  const;
@@ -0,0 +1,484 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// This file is part of project wdx-core.
+//
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Implementation of the cache for serialized definition documents.
+///
+///  \author   PEn: WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include "definition_cache.hpp"
+#include "wago/wdx/wda/http/response_i.hpp"
+#include "http/head_response.hpp"
+
+#include <wc/assertion.h>
+#include <wc/log.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+// defines; structure, enumeration and type definitions
+//------------------------------------------------------------------------------
+namespace wago {
+namespace wdx {
+namespace wda {
+namespace rest {
+
+using http::http_status_code;
+
+namespace {
+
+constexpr char const etag_header[]             = "ETag";
+constexpr char const if_none_match_header[]    = "If-None-Match";
+constexpr char const accept_encoding_header[]  = "Accept-Encoding";
+constexpr char const content_encoding_header[] = "Content-Encoding";
+constexpr char const vary_header[]             = "Vary";
+
+constexpr char const * const encoding_names[] = { "identity", "gzip", "deflate" };
+
+/// Response with an already serialized (and maybe compressed) document.
+class document_response : public response_i
+{
+private:
+    map<string, string>                response_header_m;
+    string                             content_type_m;
+    string                             content_length_m;
+    std::shared_ptr<std::string const> content_m;
+
+public:
+    document_response(string                                   const &etag,
+                      string                                   const &content_type,
+                      std::shared_ptr<std::string const>       const &content,
+                      definition_cache::content_encoding       const  encoding)
+    : content_type_m(content_type)
+    , content_length_m(std::to_string(content->size()))
+    , content_m(content)
+    {
+        response_header_m.emplace(etag_header, etag);
+        response_header_m.emplace(vary_header, accept_encoding_header);
+        if(!content_m->empty())
+        {
+            WC_ASSERT(!content_type_m.empty());
+            response_header_m.emplace("Content-Type", content_type_m);
+            response_header_m.emplace("Content-Length", content_length_m);
+        }
+        if(encoding != definition_cache::content_encoding::identity)
+        {
+            response_header_m.emplace(content_encoding_header, encoding_names[static_cast<size_t>(encoding)]);
+        }
+    }
+    ~document_response() noexcept override = default;
+
+    http_status_code get_status_code() const override
+    {
+        return http_status_code::ok;
+    }
+
+    map<string, string> const & get_response_header() const override
+    {
+        return response_header_m;
+    }
+
+    string const & get_content_type() const override
+    {
+        return content_type_m;
+    }
+
+    string const & get_content_length() const override
+    {
+        return content_length_m;
+    }
+
+    bool has_content() const override
+    {
+        return !content_m->empty();
+    }
+
+    string get_content() const override
+    {
+        return *content_m;
+    }
+};
+
+//------------------------------------------------------------------------------
+// internal function prototypes
+//------------------------------------------------------------------------------
+string trim_copy(string const &text);
+
+string build_tag(string  const &model_hash,
+                 request const &req);
+
+string quote_tag(string                             const &tag,
+                 definition_cache::content_encoding const  encoding);
+
+void forward_response(future<unique_ptr<response_i>>                     &&pending_response,
+                      std::shared_ptr<promise<unique_ptr<response_i>>>      resp_promise);
+
+unique_ptr<response_i> not_modified(string const &etag);
+
+} // Anonymous namespace for internal functions
+
+//------------------------------------------------------------------------------
+// class implementation
+//------------------------------------------------------------------------------
+definition_cache::definition_cache(size_t const max_cache_size)
+: max_cache_size_m(max_cache_size)
+, cache_size_m(0)
+{ }
+
+definition_cache::~definition_cache() noexcept = default;
+
+operation_handler_t definition_cache::cached(operation_handler_t handler,
+                                             bool                depends_on_instances)
+{
+    auto cache = shared_from_this();
+    return [cache, handler, depends_on_instances](operation_i *operation, std::shared_ptr<request> req) {
+        if(req->get_method() != http_method::get)
+        {
+            return handler(operation, req);
+        }
+
+        auto resp_promise = std::make_shared<promise<unique_ptr<response_i>>>();
+        auto pending_hash = operation->get_service_frontend().get_model_hash();
+        pending_hash.set_notifier([cache, handler, depends_on_instances, operation, req, resp_promise](wdx::model_hash_response &&hash) {
+            try
+            {
+                if(!hash.is_success() || (depends_on_instances && hash.has_dynamic_instantiations))
+                {
+                    forward_response(handler(operation, req), resp_promise);
+                    return;
+                }
+
+                auto   const encoding      = negotiate_encoding(req->get_http_header(accept_encoding_header));
+                string const tag           = build_tag(hash.model_hash, *req);
+                string const etag          = quote_tag(tag, encoding);
+                string const if_none_match = req->get_http_header(if_none_match_header);
+                if(matches_etag(if_none_match, etag))
+                {
+                    resp_promise->set_value(not_modified(etag));
+                    return;
+                }
+
+                // "*" matches any current representation, so only a resource which exists is not modified
+                bool const matches_any = matches_any_etag(if_none_match);
+                string                             content_type;
+                std::shared_ptr<std::string const> content;
+                if(cache->find(tag, encoding, content_type, content))
+                {
+                    resp_promise->set_value(matches_any ? not_modified(etag)
+                                                        : std::make_unique<document_response>(etag, content_type, content, encoding));
+                    return;
+                }
+
+                auto pending_response = handler(operation, req);
+                pending_response.set_notifier([cache, tag, etag, encoding, matches_any, resp_promise](unique_ptr<response_i> &&resp) {
+                    try
+                    {
+                        if((resp->get_status_code() == http_status_code::ok) && resp->has_content())
+                        {
+                            string                             content_type = resp->get_content_type();
+                            std::shared_ptr<std::string const> content;
+                            cache->store(tag, content_type, resp->get_content());
+                            if(!cache->find(tag, encoding, content_type, content))
+                            {
+                                // too large to be cached
+                                content = std::make_shared<std::string const>(encode(resp->get_content(), encoding));
+                            }
+                            resp = matches_any ? not_modified(etag)
+                                               : std::make_unique<document_response>(etag, content_type, content, encoding);
+                        }
+                        resp_promise->set_value(std::move(resp));
+                    }
+                    catch(...)
+                    {
+                        resp_promise->set_exception(std::current_exception());
+                    }
+                });
+                pending_response.set_exception_notifier([resp_promise](std::exception_ptr e) {
+                    resp_promise->set_exception(e);
+                });
+            }
+            catch(...)
+            {
+                resp_promise->set_exception(std::current_exception());
+            }
+        });
+        pending_hash.set_exception_notifier([resp_promise](std::exception_ptr e) {
+            resp_promise->set_exception(e);
+        });
+        return resp_promise->get_future();
+    };
+}
+
+void definition_cache::store(string const &etag,
+                             string const &content_type,
+                             string        content)
+{
+    std::lock_guard<std::mutex> lock(mutex_m);
+    if((content.size() > max_cache_size_m) || (documents_m.count(etag) > 0))
+    {
+        return;
+    }
+    evict(content.size());
+    document cached_document = { content_type, {}, content.size() };
+    cached_document.contents[static_cast<size_t>(content_encoding::identity)] = std::make_shared<std::string const>(std::move(content));
+    cache_size_m += cached_document.size;
+    documents_m.emplace(etag, std::move(cached_document));
+    insertion_order_m.push_back(etag);
+}
+
+bool definition_cache::find(string                             const &etag,
+                            content_encoding                   const  encoding,
+                            string                                   &content_type,
+                            std::shared_ptr<std::string const>       &content)
+{
+    auto const index = static_cast<size_t>(encoding);
+    std::shared_ptr<std::string const> identity;
+    {
+        std::lock_guard<std::mutex> lock(mutex_m);
+        auto const cached_document = documents_m.find(etag);
+        if(cached_document == documents_m.end())
+        {
+            return false;
+        }
+        content_type = cached_document->second.content_type;
+        content      = cached_document->second.contents[index];
+        if(content != nullptr)
+        {
+            return true;
+        }
+        identity = cached_document->second.contents[static_cast<size_t>(content_encoding::identity)];
+    }
+
+    // compress without holding the lock, a concurrent request may do the same
+    content = std::make_shared<std::string const>(encode(*identity, encoding));
+
+    std::lock_guard<std::mutex> lock(mutex_m);
+    evict(content->size());
+    auto const cached_document = documents_m.find(etag);
+    if((cached_document != documents_m.end()) && (cached_document->second.contents[index] == nullptr))
+    {
+        cached_document->second.contents[index] = content;
+        cached_document->second.size           += content->size();
+        cache_size_m                           += content->size();
+    }
+    return true;
+}
+
+void definition_cache::evict(size_t const required_size)
+{
+    while((cache_size_m + required_size > max_cache_size_m) && !insertion_order_m.empty())
+    {
+        auto const oldest = documents_m.find(insertion_order_m.front());
+        WC_ASSERT(oldest != documents_m.end());
+        cache_size_m -= oldest->second.size;
+        documents_m.erase(oldest);
+        insertion_order_m.pop_front();
+    }
+}
+
+definition_cache::content_encoding definition_cache::negotiate_encoding(string const &accept_encoding)
+{
+    // quality values by encoding, -1 if not mentioned
+    double gzip_quality    = -1;
+    double deflate_quality = -1;
+    double any_quality     = -1;
+
+    std::stringstream codings(accept_encoding);
+    string coding;
+    while(std::getline(codings, coding, ','))
+    {
+        double quality = 1;
+        auto const parameters = coding.find(';');
+        if(parameters != string::npos)
+        {
+            string const parameter = trim_copy(coding.substr(parameters + 1));
+            if((parameter.size() > 2) && (parameter[0] == 'q') && (parameter[1] == '='))
+            {
+                quality = std::strtod(parameter.c_str() + 2, nullptr);
+            }
+            coding.erase(parameters);
+        }
+        coding = trim_copy(coding);
+        std::transform(coding.begin(), coding.end(), coding.begin(), [](unsigned char c) {
+            return static_cast<char>(::tolower(c));
+        });
+
+        if((coding == "gzip") || (coding == "x-gzip"))
+        {
+            gzip_quality = quality;
+        }
+        else if(coding == "deflate")
+        {
+            deflate_quality = quality;
+        }
+        else if(coding == "*")
+        {
+            any_quality = quality;
+        }
+    }
+    if(gzip_quality < 0)
+    {
+        gzip_quality = any_quality;
+    }
+    if(deflate_quality < 0)
+    {
+        deflate_quality = any_quality;
+    }
+
+    if((gzip_quality > 0) && (gzip_quality >= deflate_quality))
+    {
+        return content_encoding::gzip;
+    }
+    if(deflate_quality > 0)
+    {
+        return content_encoding::deflate;
+    }
+    return content_encoding::identity;
+}
+
+bool definition_cache::matches_etag(string const &if_none_match,
+                                    string const &etag)
+{
+    std::stringstream tags(if_none_match);
+    string tag;
+    while(std::getline(tags, tag, ','))
+    {
+        tag = trim_copy(tag);
+        // If-None-Match uses the weak comparison
+        if(tag.compare(0, 2, "W/") == 0)
+        {
+            tag.erase(0, 2);
+        }
+        if(tag == etag)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool definition_cache::matches_any_etag(string const &if_none_match)
+{
+    std::stringstream tags(if_none_match);
+    string tag;
+    while(std::getline(tags, tag, ','))
+    {
+        if(trim_copy(tag) == "*")
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+string definition_cache::encode(string           const &content,
+                                content_encoding const  encoding)
+{
+    if(encoding == content_encoding::identity)
+    {
+        return content;
+    }
+
+    // gzip wraps the deflate stream with a gzip header, deflate in HTTP means the zlib format
+    int const window_bits = (encoding == content_encoding::gzip) ? (MAX_WBITS + 16) : MAX_WBITS;
+    z_stream stream = {};
+    if(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        throw std::runtime_error("Failed to initialize compression.");
+    }
+    string result(deflateBound(&stream, static_cast<uLong>(content.size())), '\0');
+    stream.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(content.data()));
+    stream.avail_in  = static_cast<uInt>(content.size());
+    stream.next_out  = reinterpret_cast<Bytef *>(&result[0]);
+    stream.avail_out = static_cast<uInt>(result.size());
+    int const status = deflate(&stream, Z_FINISH);
+    result.resize(stream.total_out);
+    deflateEnd(&stream);
+    if(status != Z_STREAM_END)
+    {
+        throw std::runtime_error("Failed to compress content.");
+    }
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// internal function implementation
+//------------------------------------------------------------------------------
+namespace {
+
+string trim_copy(string const &text)
+{
+    auto const first = text.find_first_not_of(" \t");
+    if(first == string::npos)
+    {
+        return "";
+    }
+    auto const last = text.find_last_not_of(" \t");
+    return text.substr(first, last - first + 1);
+}
+
+string build_tag(string  const &model_hash,
+                 request const &req)
+{
+    // documents contain links built from path and query, the serializer depends on the accepted types
+    auto   const uri = req.get_request_uri();
+    string const key = uri.get_path() + '?' + uri.get_query() + '\n' + req.get_serializer().get_content_type();
+
+    std::stringstream tag;
+    tag << model_hash << '-' << std::hex << std::hash<string>()(key);
+    return tag.str();
+}
+
+string quote_tag(string                             const &tag,
+                 definition_cache::content_encoding const  encoding)
+{
+    // representations with different content codings need different strong entity tags
+    return '"' + tag + ((encoding == definition_cache::content_encoding::identity)
+                        ? "" : (string("-") + encoding_names[static_cast<size_t>(encoding)])) + '"';
+}
+
+void forward_response(future<unique_ptr<response_i>>                     &&pending_response,
+                      std::shared_ptr<promise<unique_ptr<response_i>>>      resp_promise)
+{
+    pending_response.set_notifier([resp_promise](unique_ptr<response_i> &&resp) {
+        resp_promise->set_value(std::move(resp));
+    });
+    pending_response.set_exception_notifier([resp_promise](std::exception_ptr e) {
+        resp_promise->set_exception(e);
+    });
+}
+
+unique_ptr<response_i> not_modified(string const &etag)
+{
+    return std::make_unique<http::head_response>(http_status_code::not_modified,
+                                                 map<string, string>({{ etag_header, etag },
+                                                                      { vary_header, accept_encoding_header }}));
+}
+
+} // Anonymous namespace for internal functions
+
+} // Namespace rest
+} // Namespace wda
+} // Namespace wdx
+} // Namespace wago
+
+
+//---- End of source file ------------------------------------------------------
@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// This file is part of project wdx-core.
+//
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Cache for serialized definition documents with conditional GET.
+///
+///  \author   PEn: WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+#ifndef SRC_LIBWDXWDA_REST_DEFINITION_CACHE_HPP_
+#define SRC_LIBWDXWDA_REST_DEFINITION_CACHE_HPP_
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include "operation.hpp"
+
+#include <wc/structuring.h>
+
+#include <array>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+//------------------------------------------------------------------------------
+// defines; structure, enumeration and type definitions
+//------------------------------------------------------------------------------
+namespace wago {
+namespace wdx {
+namespace wda {
+namespace rest {
+
+/// Definitions (parameter, method, feature and enum definitions) only change with the model state.
+/// Responses on definition routes are tagged with a strong ETag derived from the model hash of the core,
+/// so requests with a matching If-None-Match header are answered with 304 (Not Modified) without
+/// serialization. Other requests are served from a cache of the serialized documents, which are
+/// compressed lazily with gzip or deflate, if the client accepts it.
+class definition_cache : public std::enable_shared_from_this<definition_cache>
+{
+public:
+    enum class content_encoding : uint8_t
+    {
+        identity = 0,
+        gzip,
+        deflate
+    };
+
+    /// Default limit for the size of all cached documents (in all encodings).
+    static constexpr size_t const default_max_cache_size = 2 * 1024 * 1024;
+
+private:
+    struct document
+    {
+        std::string                                        content_type;
+        std::array<std::shared_ptr<std::string const>, 3>  contents;
+        size_t                                             size;
+    };
+
+    size_t                          const max_cache_size_m;
+    std::mutex                            mutex_m;
+    std::map<std::string, document>       documents_m;
+    std::deque<std::string>               insertion_order_m;
+    size_t                                cache_size_m;
+
+private:
+    WC_DISBALE_CLASS_COPY_AND_ASSIGN(definition_cache)
+
+    void store(std::string const &etag,
+               std::string const &content_type,
+               std::string        content);
+    bool find(std::string                        const &etag,
+              content_encoding                   const  encoding,
+              std::string                              &content_type,
+              std::shared_ptr<std::string const>       &content);
+    void evict(size_t const required_size);
+
+public:
+    explicit definition_cache(size_t const max_cache_size = default_max_cache_size);
+    ~definition_cache() noexcept;
+
+    /// Wraps the handler of a definition route.
+    /// \param handler              Handler to serialize the definitions if they are not cached.
+    /// \param depends_on_instances True, if the definitions depend on the parameter instances of the devices:
+    ///                             Definitions for instances of dynamically instantiated classes are read from
+    ///                             the parameter providers, so those are neither tagged nor cached while the
+    ///                             model has dynamic instantiations.
+    /// \return Handler to be registered for the route instead.
+    operation_handler_t cached(operation_handler_t handler,
+                               bool                depends_on_instances);
+
+    /// Negotiates the content encoding of a response by an Accept-Encoding header (gzip preferred).
+    static content_encoding negotiate_encoding(std::string const &accept_encoding);
+
+    /// Checks the entity tags of an If-None-Match header against an entity tag, "*" is not considered.
+    static bool matches_etag(std::string const &if_none_match,
+                             std::string const &etag);
+
+    /// Checks whether an If-None-Match header is "*", which matches any existing representation.
+    static bool matches_any_etag(std::string const &if_none_match);
+
+    /// Compresses content with gzip or deflate (zlib format), identity is returned as is.
+    static std::string encode(std::string      const &content,
+                              content_encoding const  encoding);
+};
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// variables' and constants' definitions
+//------------------------------------------------------------------------------
+
+
+} // Namespace rest
+} // Namespace wda
+} // Namespace wdx
+} // Namespace wago
+
+
+#endif // SRC_LIBWDXWDA_REST_DEFINITION_CACHE_HPP_
+//---- End of source file ------------------------------------------------------
@@ -75,6 +75,7 @@ static constexpr char const         query_separator                       = '&';
 static constexpr char const         page_common_start_base[]              = PAGINATION_PARAMETER_COMMON;
 static constexpr char const         page_limit_query_key[]                = PAGINATION_PARAMETER_COMMON "limit]";
 static constexpr char const         page_offset_query_key[]               = PAGINATION_PARAMETER_COMMON "offset]";
+static constexpr char const         page_cursor_query_key[]               = PAGINATION_PARAMETER_COMMON "cursor]";
 static constexpr char const         self_link_name[]                      = "self";
 static constexpr char const         first_page_link_name[]                = "first";
 static constexpr char const         last_page_link_name[]                 = "last";
@@ -108,8 +109,8 @@ static constexpr char const json_api_content_type_part2[]                 = JSON
 static constexpr char const json_api_content_type[]                       = JSON_API_CONTENT_TYPE_PART1 "/" JSON_API_CONTENT_TYPE_PART2;
 
 
-static constexpr char const cors_allowed_headers[] = "Accept, Authorization, Content-Length, Content-Type, Wago-Wdx-No-Auth-Popup";
-static constexpr char const cors_exposed_headers[] = "Content-Length, Content-Type, Www-Authenticate, Wago-Wdx-Auth-Token, Wago-Wdx-Auth-Token-Expiration, Wago-Wdx-Auth-Token-Type";
+static constexpr char const cors_allowed_headers[] = "Accept, Authorization, Content-Length, Content-Type, If-None-Match, Wago-Wdx-No-Auth-Popup";
+static constexpr char const cors_exposed_headers[] = "Content-Length, Content-Type, ETag, Www-Authenticate, Wago-Wdx-Auth-Token, Wago-Wdx-Auth-Token-Expiration, Wago-Wdx-Auth-Token-Type";
 
 
 } // Namespace rest
@@ -45,6 +45,15 @@ std::unique_ptr<response_i> create_parameters_response(std::vector<wdx::paramete
                                                        unsigned                             const  page_offset,
                                                        unsigned                             const  page_element_max);
 
+std::unique_ptr<response_i> create_parameters_response(wdx::parameter_response_cursor_response     core_response,
+                                                       serializer_i                         const &serializer,
+                                                       bool                                 const  errors_as_attributes,
+                                                       std::string                          const  request_path,
+                                                       std::string                          const  request_query,
+                                                       std::string                          const  request_doc_link,
+                                                       unsigned                             const  page_limit,
+                                                       std::string                          const  page_cursor);
+
 void set_parameters_deferred(operation_i                          *operation,
                              frontend_i                           &core_frontend,
                              std::vector<wdx::value_path_request>  deferred_parameter_requests);
@@ -63,6 +72,8 @@ future<unique_ptr<response_i>> operation::get_parameters(operation_i *operation,
     unsigned page_limit;
     unsigned page_offset;
     req->get_pagination_parameters(page_limit, page_offset);
+    std::string page_cursor;
+    bool const cursor_paging = req->get_pagination_cursor(page_cursor);
 
     // Get filters like that for BETA parameters from query 
     // And always filter out methods
@@ -78,6 +89,31 @@ future<unique_ptr<response_i>> operation::get_parameters(operation_i *operation,
                                 req->get_filter_queries()
                           );
 
+    if(cursor_paging)
+    {
+        auto core_response_handler = [
+            &serializer=req->get_serializer(),
+            base_path=req->get_request_uri().get_path(),
+            query=req->get_request_uri().get_query(),
+            doc_link=req->get_doc_link(),
+            errors_as_attributes=req->get_errors_as_data_attributes_parameter(),
+            page_limit,
+            page_cursor
+        ] (wdx::parameter_response_cursor_response &&core_response) {
+            // Create document
+            return create_parameters_response(std::move(core_response),
+                                              serializer,
+                                              errors_as_attributes,
+                                              base_path, query, doc_link,
+                                              page_limit, page_cursor);
+        };
+
+        return CALL_CORE_FRONTEND(operation->get_service_frontend(),
+                                  get_all_parameters_at_cursor,
+                                  std::move(core_response_handler),
+                                  parameter_filter, page_cursor, static_cast<size_t>(page_limit));
+    }
+
     auto core_response_handler = [
         &serializer=req->get_serializer(),
         base_path=req->get_request_uri().get_path(),
@@ -554,6 +590,36 @@ std::unique_ptr<response_i> create_parameters_response(std::vector<wdx::paramete
 
 
 
+std::unique_ptr<response_i> create_parameters_response(wdx::parameter_response_cursor_response     core_response,
+                                                       serializer_i                         const &serializer,
+                                                       bool                                 const  errors_as_attributes,
+                                                       std::string                          const  request_path,
+                                                       std::string                          const  request_query,
+                                                       std::string                          const  request_doc_link,
+                                                       unsigned                             const  page_limit,
+                                                       std::string                          const  page_cursor)
+{
+    if(core_response.has_error())
+    {
+        throw http_exception("Invalid pagination parameter in query: " + core_response.get_message(), http_status_code::bad_request);
+    }
+    parameter_collection_document document(request_path, request_query, {{ "doc", request_doc_link }}, std::move(core_response.param_responses), page_cursor, page_limit, core_response.next_cursor);
+
+    if(!errors_as_attributes && document.has_errors())
+    {
+        // throw an http exception
+        vector<shared_ptr<data_error>> shared_error_ptrs;
+        for(auto const &err : document.get_errors())
+        {
+            shared_error_ptrs.push_back(std::make_shared<data_error>(err));
+        }
+        throw data_exception("Failed to read parameter values", shared_error_ptrs);
+    }
+
+    // Create document
+    return std::make_unique<response<parameter_collection_document>>(http_status_code::ok, serializer, std::move(document));
+}
+
 void set_parameters_deferred(operation_i                          *operation,
                              frontend_i                           &core_frontend,
                              std::vector<wdx::value_path_request>  deferred_parameter_requests)
@@ -246,6 +246,22 @@ void request::get_pagination_parameters(unsigned &page_limit,
     }
 }
 
+bool request::get_pagination_cursor(string &page_cursor) const
+{
+    if(!has_query_parameter(page_cursor_query_key))
+    {
+        return false;
+    }
+    if(has_query_parameter(page_offset_query_key))
+    {
+        http_status_code const http_code = http_status_code::bad_request;
+        throw http_exception(std::string("Invalid pagination parameter in query: \"") + page_cursor_query_key +
+                             "\" cannot be combined with \"" + page_offset_query_key + "\"", http_code);
+    }
+    page_cursor = get_query_parameter(page_cursor_query_key);
+    return true;
+}
+
 bool request::get_errors_as_data_attributes_parameter() const
 {
     return has_query_parameter(parameter_errors_as_data_attributes) &&
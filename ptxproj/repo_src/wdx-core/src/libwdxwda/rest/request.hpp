@@ -94,6 +94,11 @@ public:
     void get_pagination_parameters(unsigned &page_limit,
                                    unsigned &page_offset) const;
 
+    /// Get URL query parameter for cursor based pagination: /a/path?page[cursor]=...
+    /// \param page_cursor Will be set to the cursor, if found (an empty cursor requests the first page)
+    /// \return True, if cursor based pagination is requested
+    bool get_pagination_cursor(string &page_cursor) const;
+
     bool get_errors_as_data_attributes_parameter() const;
 
     bool get_deferred_parameters_as_errors() const;
@@ -59,6 +59,7 @@ rest_frontend::rest_frontend(string
 , core_frontend_m(frontend)
 , router_m(service_identity, service_base)
 , run_manager_m(new run_object_manager())
+, definition_cache_m(std::make_shared<definition_cache>())
 {
     constexpr char const marker                = http::parameter_marker;
     string const param_device_id               = marker      + string(path_param_device_id)               + marker;
@@ -109,7 +110,7 @@ rest_frontend::rest_frontend(string
                        build_doc_link(doc_link_base, "getDevice"));
     router_m.add_route(http_method::get,
                        string(device_endpoint) + "/" + param_device_id + "/features",
-                       &operation::get_features_of_device,
+                       definition_cache_m->cached(&operation::get_features_of_device, false),
                        build_doc_link(doc_link_base, "getFeatureList"));
     router_m.add_redirect(string(device_endpoint) + "/" + param_device_id + "/features/" + param_feature_name,
                        &operation::redirect_feature);
@@ -147,29 +148,29 @@ rest_frontend::rest_frontend(string
     // Method definition related: "/method-definitions/..."
     router_m.add_route(http_method::get,
                        string(method_definition_endpoint),
-                       &operation::get_all_method_definitions,
+                       definition_cache_m->cached(&operation::get_all_method_definitions, true),
                        build_doc_link(doc_link_base, "getMethodDefinitions"));
     router_m.add_route(http_method::get,
                        string(method_definition_endpoint) + "/" + param_method_definition_id,
-                       &operation::get_method_definition,
+                       definition_cache_m->cached(&operation::get_method_definition, true),
                        build_doc_link(doc_link_base, "getMethodDefinition"));
     router_m.add_route(http_method::get,
                        string(method_definition_endpoint) + "/" + param_method_definition_id + "/inargs",
-                       &operation::get_all_method_inarg_definitions,
+                       definition_cache_m->cached(&operation::get_all_method_inarg_definitions, true),
                        build_doc_link(doc_link_base, "getMethodInArgDefinitions"));
     router_m.add_route(http_method::get,
                        string(method_definition_endpoint) + "/" + param_method_definition_id + "/inargs/" + param_method_inarg_name,
-                       &operation::get_method_inarg_definition,
+                       definition_cache_m->cached(&operation::get_method_inarg_definition, true),
                        build_doc_link(doc_link_base, "getMethodInArgDefinition"));
     router_m.add_redirect(string(method_definition_endpoint) + "/" + param_method_definition_id + "/inargs/" + param_method_inarg_name + "/enum",
                        &operation::redirect_method_inarg_enum);
     router_m.add_route(http_method::get,
                        string(method_definition_endpoint) + "/" + param_method_definition_id + "/outargs",
-                       &operation::get_all_method_outarg_definitions,
+                       definition_cache_m->cached(&operation::get_all_method_outarg_definitions, true),
                        build_doc_link(doc_link_base, "getMethodOutArgDefinitions"));
     router_m.add_route(http_method::get,
                        string(method_definition_endpoint) + "/" + param_method_definition_id + "/outargs/" + param_method_outarg_name,
-                       &operation::get_method_outarg_definition,
+                       definition_cache_m->cached(&operation::get_method_outarg_definition, true),
                        build_doc_link(doc_link_base, "getMethodOutArgDefinition"));
     router_m.add_redirect(string(method_definition_endpoint) + "/" + param_method_definition_id + "/outargs/" + param_method_outarg_name + "/enum",
                        &operation::redirect_method_outarg_enum);
@@ -203,11 +204,11 @@ rest_frontend::rest_frontend(string
     // Parameter definition related: "/parameter-definitions/..."
     router_m.add_route(http_method::get,
                        string(parameter_definition_endpoint),
-                       &operation::get_all_parameter_definitions,
+                       definition_cache_m->cached(&operation::get_all_parameter_definitions, true),
                        build_doc_link(doc_link_base, "getParameterDefinitions"));
     router_m.add_route(http_method::get,
                        string(parameter_definition_endpoint) + "/" + param_parameter_definition_id,
-                       &operation::get_parameter_definition,
+                       definition_cache_m->cached(&operation::get_parameter_definition, true),
                        build_doc_link(doc_link_base, "getParameterDefinitionByID"));
     router_m.add_redirect(string(parameter_definition_endpoint) + "/" + param_parameter_definition_id + "/enum",
                        &operation::redirect_parameter_enum);
@@ -247,33 +248,33 @@ rest_frontend::rest_frontend(string
     // Feature related
     router_m.add_route(http_method::get,
                        string(feature_endpoint),
-                       &operation::get_all_features,
+                       definition_cache_m->cached(&operation::get_all_features, false),
                        build_doc_link(doc_link_base, "getFeatures"));
     router_m.add_route(http_method::get,
                        string(feature_endpoint) + "/" + param_feature_id,
-                       &operation::get_feature,
+                       definition_cache_m->cached(&operation::get_feature, false),
                        build_doc_link(doc_link_base, "getFeature"));
     router_m.add_route(http_method::get,
                        string(feature_endpoint) + "/" + param_feature_id + "/includedfeatures",
-                       &operation::get_included_features,
+                       definition_cache_m->cached(&operation::get_included_features, false),
                        build_doc_link(doc_link_base, "getIncludedFeature"));
     router_m.add_route(http_method::get,
                        string(feature_endpoint) + "/" + param_feature_id + "/containedparameters",
-                       &operation::get_contained_parameters_of_feature,
+                       definition_cache_m->cached(&operation::get_contained_parameters_of_feature, true),
                        build_doc_link(doc_link_base, "getContainedParametersOfFeature"));
     router_m.add_route(http_method::get,
                        string(feature_endpoint) + "/" + param_feature_id + "/containedmethods",
-                       &operation::get_contained_methods_of_feature,
+                       definition_cache_m->cached(&operation::get_contained_methods_of_feature, true),
                        build_doc_link(doc_link_base, "getContainedMethodsOfFeature"));
 
     // Enum definition related
     router_m.add_route(http_method::get,
                        string(enum_definition_endpoint),
-                       &operation::get_all_enum_definitions,
+                       definition_cache_m->cached(&operation::get_all_enum_definitions, false),
                        build_doc_link(doc_link_base, "getEnumDefinitions"));
     router_m.add_route(http_method::get,
                        string(enum_definition_endpoint) + "/" + param_enum_id,
-                       &operation::get_enum_definition,
+                       definition_cache_m->cached(&operation::get_enum_definition, false),
                        build_doc_link(doc_link_base, "getEnumDefinition"));
 
     WC_DEBUG_LOG("Route configuration done");
@@ -23,6 +23,7 @@
 #include "router.hpp"
 #include "auth_settings_i.hpp"
 #include "run_object_manager.hpp"
+#include "definition_cache.hpp"
 #include "auth/authenticated_request_handler_i.hpp"
 #include "wago/wdx/unauthorized.hpp"
 
@@ -51,6 +52,7 @@ private:
     unauthorized<wdx::parameter_service_frontend_extended_i> const  core_frontend_m;
     router                                                          router_m;
     shared_ptr<run_object_manager>                                  run_manager_m;
+    shared_ptr<definition_cache>                                    definition_cache_m;
 
 private:
     WC_DISBALE_CLASS_COPY_AND_ASSIGN(rest_frontend)
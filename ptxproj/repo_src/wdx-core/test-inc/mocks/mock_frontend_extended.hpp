@@ -67,12 +67,14 @@ using wago::wdx::set_parameter_response;
 using wago::wdx::parameter_filter;
 using wago::wdx::device_id;
 using wago::wdx::parameter_response_list_response;
+using wago::wdx::parameter_response_cursor_response;
 using wago::wdx::monitoring_list_id_t;
 using wago::wdx::monitoring_list_response;
 using wago::wdx::monitoring_lists_response;
 using wago::wdx::monitoring_list_values_response;
 using wago::wdx::delete_monitoring_list_response;
 using wago::wdx::enum_definition_response;
+using wago::wdx::model_hash_response;
 using std::string;
 using std::vector;
 using std::map;
@@ -110,9 +112,11 @@ public:
     MOCK_METHOD0(get_all_monitoring_lists, future<monitoring_lists_response> ());
     MOCK_METHOD1(delete_monitoring_list, future<delete_monitoring_list_response> (monitoring_list_id_t id));
     MOCK_METHOD3(get_all_parameters, future<parameter_response_list_response> (parameter_filter filter, size_t paging_offset, size_t paging_limit));
+    MOCK_METHOD3(get_all_parameters_at_cursor, future<parameter_response_cursor_response> (parameter_filter filter, std::string cursor, size_t paging_limit));
     MOCK_METHOD2(set_parameter_values_by_path_connection_aware, future<vector<set_parameter_response>> (vector<value_path_request>valuePathRequests, bool defer_wda_web_connection_changes));
     MOCK_METHOD0(get_all_enum_definitions, future<vector<enum_definition_response>> ());
     MOCK_METHOD1(get_enum_definition, future<enum_definition_response> (std::string enum_name));
+    MOCK_METHOD0(get_model_hash, future<model_hash_response> ());
     MOCK_METHOD0(get_features_of_all_devices, future<std::vector<wago::wdx::feature_list_response>> ());
     MOCK_METHOD2(get_feature_definition, future<wago::wdx::feature_response> (device_path_t device, std::string feature_name));
     MOCK_METHOD3(get_all_parameter_definitions, wago::future<parameter_response_list_response>(parameter_filter filter, size_t paging_offset, size_t paging_limit));
@@ -164,10 +168,14 @@ public:
             .Times(0);
         EXPECT_CALL(*this, get_all_parameters(::testing::_, ::testing::_, ::testing::_))
             .Times(0);
+        EXPECT_CALL(*this, get_all_parameters_at_cursor(::testing::_, ::testing::_, ::testing::_))
+            .Times(0);
         EXPECT_CALL(*this, get_all_enum_definitions())
             .Times(0);
         EXPECT_CALL(*this, get_enum_definition(::testing::_))
             .Times(0);
+        EXPECT_CALL(*this, get_model_hash())
+            .Times(0);
         EXPECT_CALL(*this, get_features_of_all_devices())
             .Times(0);
         EXPECT_CALL(*this, get_feature_definition(::testing::_, ::testing::_))
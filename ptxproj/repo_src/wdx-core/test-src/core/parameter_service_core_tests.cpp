@@ -1013,6 +1013,70 @@ TEST_F(parameter_service_test_fixture, get_all_parameters) {
     }
 }
 
+TEST_F(parameter_service_test_fixture, get_all_parameters_at_cursor) {
+    // not treating warnings as errors for the following part, because we expect there to be warnings
+    current_log_mode = lax;
+    auto const page_through = [this](parameter_filter const &filter, size_t page_limit) {
+        vector<parameter_instance_id> ids;
+        std::string cursor;
+        do
+        {
+            auto r = service->get_all_parameters_at_cursor(filter, cursor, page_limit).get();
+            EXPECT_EQ(r.status, status_codes::success);
+            EXPECT_LE(r.param_responses.size(), page_limit);
+            for(auto const &p : r.param_responses)
+            {
+                EXPECT_FALSE(p.definition->value_type == parameter_value_types::method);
+                ids.push_back(p.id);
+            }
+            cursor = r.next_cursor;
+        } while(!cursor.empty() && ids.size() < 10000);
+        return ids;
+    };
+    auto const all_ids = [this](parameter_filter const &filter) {
+        vector<parameter_instance_id> ids;
+        for(auto const &p : service->get_all_parameters(filter).get().param_responses)
+        {
+            ids.push_back(p.id);
+        }
+        return ids;
+    };
+    for(auto const &filter : { parameter_filter::any,
+                               parameter_filter::only_usersettings(),
+                               parameter_filter(device_selector::headstation()),
+                               parameter_filter::only_subpath("Identity") })
+    {
+        auto const expected = all_ids(filter);
+        EXPECT_FALSE(expected.empty());
+        EXPECT_EQ(page_through(filter, 1), expected);
+        EXPECT_EQ(page_through(filter, 7), expected);
+        EXPECT_EQ(page_through(filter, SIZE_MAX), expected);
+    }
+    {
+        auto r = service->get_all_parameters_at_cursor(parameter_filter::any, "", 0).get();
+        EXPECT_EQ(r.status, status_codes::success);
+        EXPECT_TRUE(r.param_responses.empty());
+        EXPECT_TRUE(r.next_cursor.empty());
+    }
+    {
+        auto r = service->get_all_parameters_at_cursor(parameter_filter::any, "", 1).get();
+        EXPECT_EQ(r.status, status_codes::success);
+        ASSERT_FALSE(r.next_cursor.empty());
+
+        // cursor of another filter
+        EXPECT_EQ(service->get_all_parameters_at_cursor(parameter_filter::only_subpath("Identity"), r.next_cursor, 1).get().status, status_codes::invalid_value);
+
+        // cursor no longer pointing to the same parameter
+        auto outdated = r.next_cursor;
+        outdated.back() = (outdated.back() == '9') ? '8' : static_cast<char>(outdated.back() + 1);
+        EXPECT_EQ(service->get_all_parameters_at_cursor(parameter_filter::any, outdated, 1).get().status, status_codes::invalid_value);
+    }
+    for(auto const &cursor : { "x", "s.", "s.0.0", "s.0.0.0.a.0", "d.-1", "d.1.2", "o.99999999999999999999999" })
+    {
+        EXPECT_EQ(service->get_all_parameters_at_cursor(parameter_filter::any, cursor, 1).get().status, status_codes::invalid_value) << cursor;
+    }
+}
+
 TEST_F(parameter_service_test_fixture, representation)
 {
     {
@@ -1900,6 +1964,177 @@ TEST_F(fragments_test_fixture, dynamic_providers) {
     }
 }
 
+TEST_F(fragments_test_fixture, dynamic_instantiations_read_once) {
+    many_dynamics_provider dp(3);
+    EXPECT_EQ(service->register_model_provider(&dp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_device_description_provider(&dp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_parameter_provider(&dp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_device(register_device_request{device_id(0,0), "0763-1508", "01.00.00"}).get().status, status_codes::success);
+
+    // unknown instantiations: asked first, then the values
+    {
+        auto r = service->get_all_parameters(parameter_filter::any).get();
+        EXPECT_EQ(r.status, status_codes::success);
+        EXPECT_EQ(r.total_entries, 8);
+        EXPECT_EQ(r.total_entries, r.param_responses.size());
+        EXPECT_EQ(dp.get_calls, 2);
+    }
+    // known instantiations: values and instantiations in one call
+    {
+        auto r = service->get_all_parameters(parameter_filter::any).get();
+        EXPECT_EQ(r.status, status_codes::success);
+        EXPECT_EQ(r.total_entries, 8);
+        EXPECT_EQ(r.total_entries, r.param_responses.size());
+        EXPECT_EQ(dp.get_calls, 3);
+        for(auto& p : r.param_responses) {
+            EXPECT_EQ(p.status, status_codes::success);
+            if(p.path.parameter_path == "Dynamics/3/ClassParam1") {
+                EXPECT_EQ(p.value->get_string(), "Hoho3");
+            }
+        }
+    }
+    {
+        auto r = service->get_all_parameters(parameter_filter::any, 7, 1).get();
+        EXPECT_EQ(r.status, status_codes::success);
+        EXPECT_EQ(r.total_entries, 8);
+        EXPECT_EQ(r.param_responses.size(), 1);
+        EXPECT_EQ(dp.get_calls, 4);
+    }
+    {
+        auto r = service->get_all_parameter_definitions(parameter_filter::any).get();
+        EXPECT_EQ(r.status, status_codes::success);
+        EXPECT_EQ(r.total_entries, 8);
+        EXPECT_EQ(dp.get_calls, 5);
+    }
+    // changed instantiations: values are read again for the new instantiations
+    dp.instance_count = 4;
+    {
+        auto r = service->get_all_parameters(parameter_filter::any).get();
+        EXPECT_EQ(r.status, status_codes::success);
+        EXPECT_EQ(r.total_entries, 10);
+        EXPECT_EQ(r.total_entries, r.param_responses.size());
+        EXPECT_EQ(dp.get_calls, 7);
+        bool found = false;
+        for(auto& p : r.param_responses) {
+            if(p.path.parameter_path == "Dynamics") {
+                EXPECT_EQ(p.value->get_instantiations().size(), 4);
+            }
+            else if(p.path.parameter_path == "Dynamics/4/ClassParam0") {
+                EXPECT_EQ(p.value->get_string(), "Haha4");
+                found = true;
+            }
+        }
+        EXPECT_TRUE(found);
+    }
+    {
+        auto r = service->get_all_parameters(parameter_filter::any).get();
+        EXPECT_EQ(r.total_entries, 10);
+        EXPECT_EQ(dp.get_calls, 8);
+    }
+    // re-registered provider: instantiations are asked first again
+    service->unregister_parameter_provider(&dp);
+    EXPECT_EQ(service->register_parameter_provider(&dp).get().status, status_codes::success);
+    {
+        auto r = service->get_all_parameters(parameter_filter::any).get();
+        EXPECT_EQ(r.total_entries, 10);
+        EXPECT_EQ(dp.get_calls, 10);
+    }
+}
+
+TEST_F(fragments_test_fixture, model_hash) {
+    auto const empty = service->get_model_hash().get();
+    EXPECT_EQ(empty.status, status_codes::success);
+    EXPECT_FALSE(empty.model_hash.empty());
+    EXPECT_FALSE(empty.has_dynamic_instantiations);
+
+    many_dynamics_provider dp(3);
+    EXPECT_EQ(service->register_model_provider(&dp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_device_description_provider(&dp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_parameter_provider(&dp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_device(register_device_request{device_id(0,0), "0763-1508", "01.00.00"}).get().status, status_codes::success);
+    auto const registered = service->get_model_hash().get();
+    EXPECT_NE(registered.model_hash, empty.model_hash);
+    EXPECT_TRUE(registered.has_dynamic_instantiations);
+
+    // reading values and definitions does not change the model
+    service->get_all_parameters(parameter_filter::any).get();
+    service->get_all_parameter_definitions(parameter_filter::any).get();
+    EXPECT_EQ(service->get_model_hash().get().model_hash, registered.model_hash);
+
+    service->unregister_parameter_provider(&dp);
+    auto const unprovided = service->get_model_hash().get();
+    EXPECT_NE(unprovided.model_hash, registered.model_hash);
+
+    EXPECT_EQ(service->unregister_devices({device_id(0,0)}).get().at(0).status, status_codes::success);
+    auto const unregistered = service->get_model_hash().get();
+    EXPECT_NE(unregistered.model_hash, unprovided.model_hash);
+    EXPECT_FALSE(unregistered.has_dynamic_instantiations);
+}
+
+TEST_F(fragments_test_fixture, dynamic_instantiations_many_instances_read_once) {
+    uint32_t const instance_count = 200;
+    size_t   const reads          = 3;
+    many_dynamics_provider dp(instance_count);
+    EXPECT_EQ(service->register_model_provider(&dp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_device_description_provider(&dp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_parameter_provider(&dp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_device(register_device_request{device_id(0,0), "0763-1508", "01.00.00"}).get().status, status_codes::success);
+
+    auto r = service->get_all_parameters(parameter_filter::any).get();
+    EXPECT_EQ(r.total_entries, 2 + 2 * instance_count);
+    EXPECT_EQ(dp.get_calls, 2);
+
+    for(size_t i = 0; i < reads; ++i)
+    {
+        r = service->get_all_parameters(parameter_filter::any).get();
+        EXPECT_EQ(r.total_entries, 2 + 2 * instance_count);
+    }
+    EXPECT_EQ(dp.get_calls, 2 + reads);
+
+    // one instance: its values only, the known instantiations are not read again
+    for(size_t i = 0; i < reads; ++i)
+    {
+        r = service->get_all_parameters(parameter_filter::only_subpath("Dynamics/100")).get();
+        EXPECT_EQ(r.total_entries, 2);
+    }
+    EXPECT_EQ(dp.get_calls, 2 + 2 * reads);
+}
+
+TEST_F(fragments_test_fixture, cursor_paging_fixed_instances) {
+    uint32_t const parameter_count = 500;
+    size_t   const page_limit      = 50;
+    many_parameters_provider mp(parameter_count / many_parameters_provider::class_parameters);
+    EXPECT_EQ(service->register_model_provider(&mp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_device_description_provider(&mp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_parameter_provider(&mp).get().status, status_codes::success);
+    EXPECT_EQ(service->register_device(register_device_request{device_id(0,0), "0763-1508", "01.00.00"}).get().status, status_codes::success);
+
+    // all pages: every parameter exactly once
+    size_t   pages = 0;
+    vector<bool> seen(parameter_count);
+    std::string cursor;
+    do
+    {
+        auto r = service->get_all_parameters_at_cursor(parameter_filter::any, cursor, page_limit).get();
+        ASSERT_EQ(r.status, status_codes::success);
+        ASSERT_LE(r.param_responses.size(), page_limit);
+        for(auto const &p : r.param_responses)
+        {
+            if(p.definition->value_type == parameter_value_types::instantiations)
+            {
+                continue;
+            }
+            ASSERT_FALSE(seen.at(p.value->get_uint32()));
+            seen.at(p.value->get_uint32()) = true;
+        }
+        cursor = r.next_cursor;
+        ++pages;
+    } while(!cursor.empty());
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), true), parameter_count);
+    EXPECT_EQ(pages, parameter_count / page_limit + 1); // + the instantiations parameter
+    EXPECT_EQ(mp.get_calls, pages - 1); // fixed instantiations are not read
+}
+
 TEST_F(fragments_test_fixture, delayed_providers) {
     delayed_provider dp;
     current_log_mode = lax;
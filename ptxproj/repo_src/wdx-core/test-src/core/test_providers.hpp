@@ -644,6 +644,127 @@ class dynamic_provider : public model_provider_i, public device_description_prov
     }
 };
 
+class many_dynamics_provider : public dynamic_provider
+{
+public:
+    explicit many_dynamics_provider(uint32_t instances)
+    : instance_count(instances)
+    { }
+
+    uint32_t instance_count;
+    size_t get_calls = 0;
+    size_t instantiations_reads = 0;
+
+    wago::future<std::vector<value_response>> get_parameter_values(std::vector<parameter_instance_id> parameterIDs) override
+    {
+        get_calls++;
+        std::vector<value_response> result(parameterIDs.size());
+
+        for (size_t idx = 0, e = parameterIDs.size(); idx < e; ++idx)
+        {
+            auto& id = parameterIDs[idx];
+            if (id.id == 15016)
+            {
+                instantiations_reads++;
+                std::vector<class_instantiation> instantiations;
+                for (uint32_t i = 1; i <= instance_count; ++i)
+                {
+                    instantiations.push_back(class_instantiation(i, "DynamicSpecialClass"));
+                }
+                result[idx].set_value(parameter_value::create_instantiations(instantiations));
+            }
+            else if (id.id == 15015)
+            {
+                result[idx].set_value(parameter_value::create_string("Huhu"));
+            }
+            else if (id.id == 20003)
+            {
+                result[idx].set_value(parameter_value::create_string("Haha" + std::to_string(id.instance_id)));
+            }
+            else if (id.id == 20002)
+            {
+                result[idx].set_value(parameter_value::create_string("Hoho" + std::to_string(id.instance_id)));
+            }
+        }
+        return wago::resolved_future(std::move(result));
+    }
+};
+
+class many_parameters_provider : public model_provider_i, public device_description_provider_i, public base_parameter_provider
+{
+public:
+    // parameters of a class with fixed instantiations
+    explicit many_parameters_provider(uint32_t instances)
+    : instance_count(instances)
+    { }
+
+    static constexpr uint32_t class_parameters = 10;
+    uint32_t instance_count;
+    size_t get_calls = 0;
+
+    wago::future<wdm_response> get_model_information() override
+    {
+        std::string wdm = R"(
+        {
+            "WDMMVersion": "1.0.0",
+            "Name": "WAGO",
+            "Features": [
+                {
+                    "ID": "ManyFeature",
+                    "Classes": ["ManyClass"]
+                }
+            ],
+            "Classes": [
+                {
+                    "ID": "ManyClass",
+                    "BasePath": "Many",
+                    "BaseID": 29999,
+                    "Parameters": [)";
+        for (uint32_t i = 0; i < class_parameters; ++i)
+        {
+            wdm += (i > 0 ? "," : "");
+            wdm += R"({ "ID": )" + std::to_string(first_id + i) + R"(, "Path": "Param)" + std::to_string(i) + R"(", "Type": "UInt32" })";
+        }
+        wdm += "] } ] }";
+        return wago::resolved_future(wdm_response(std::move(wdm)));
+    }
+    device_selector_response get_provided_devices() override
+    {
+        return device_selector_response({device_selector::any});
+    }
+    wago::future<wdd_response> get_device_information(std::string order_number, std::string firmware_version) override
+    {
+        std::string wdd = R"({ "WDMMVersion": "1.0.0", "ModelReference": "WAGO", "Features": ["ManyFeature"],
+                              "Instantiations": [ { "Class": "ManyClass", "Instances": [)";
+        for (uint32_t i = 1; i <= instance_count; ++i)
+        {
+            wdd += (i > 1 ? "," : "");
+            wdd += R"({ "ID": )" + std::to_string(i) + " }";
+        }
+        wdd += "] } ] }";
+        return wago::resolved_future(wdd_response::from_pure_wdd(std::move(wdd)));
+    }
+    parameter_selector_response get_provided_parameters() override
+    {
+        return parameter_selector_response({parameter_selector::all_of_feature("ManyFeature")});
+    }
+
+    wago::future<std::vector<value_response>> get_parameter_values(std::vector<parameter_instance_id> parameterIDs) override
+    {
+        get_calls++;
+        std::vector<value_response> result(parameterIDs.size());
+        for (size_t idx = 0, e = parameterIDs.size(); idx < e; ++idx)
+        {
+            auto const &id = parameterIDs[idx];
+            result[idx].set_value(parameter_value::create_uint32((id.instance_id - 1) * class_parameters + (id.id - first_id)));
+        }
+        return wago::resolved_future(std::move(result));
+    }
+
+private:
+    static constexpr uint32_t first_id = 30000;
+};
+
 class autarc_parameter_provider : public base_parameter_provider, public model_provider_i, public device_description_provider_i
 {
     wago::future<wdm_response> get_model_information() override
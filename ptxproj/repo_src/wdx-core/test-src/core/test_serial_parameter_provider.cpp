@@ -0,0 +1,347 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Test serial parameter provider: priorities of pending calls and
+///            batching of pending reads.
+///
+///  \author   PEn: WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include "serial_parameter_provider.hpp"
+#include "wago/wdx/base_parameter_provider.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace wago::wdx;
+using std::chrono::milliseconds;
+
+namespace {
+
+/// Provider answering every call from its own thread after a configurable latency.
+class latency_parameter_provider : public base_parameter_provider
+{
+public:
+    milliseconds get_latency    = milliseconds(1);
+    milliseconds set_latency    = milliseconds(1);
+    milliseconds invoke_latency = milliseconds(1);
+    parameter_id_t failing_id   = 0;        // a read of this ID fails as a whole
+    size_t         max_responses = SIZE_MAX; // a read of more parameters gets only this many responses
+
+    ~latency_parameter_provider() override
+    {
+        join_workers();
+    }
+
+    parameter_selector_response get_provided_parameters() override
+    {
+        return parameter_selector_response({});
+    }
+
+    wago::future<std::vector<value_response>> get_parameter_values(std::vector<parameter_instance_id> parameter_ids) override
+    {
+        record("get " + std::to_string(parameter_ids.size()));
+        std::vector<value_response> responses;
+        for(auto const &id : parameter_ids)
+        {
+            if(id.id == failing_id)
+            {
+                return fail_after<std::vector<value_response>>(get_latency);
+            }
+            if(responses.size() < max_responses)
+            {
+                responses.emplace_back(parameter_value::create_uint32(id.id));
+            }
+        }
+        return complete_after(get_latency, std::move(responses));
+    }
+
+    wago::future<std::vector<set_parameter_response>> set_parameter_values(std::vector<value_request> value_requests) override
+    {
+        record("set");
+        std::vector<set_parameter_response> responses(value_requests.size());
+        for(auto &response : responses)
+        {
+            response.set_success();
+        }
+        return complete_after(set_latency, std::move(responses));
+    }
+
+    wago::future<method_invocation_response> invoke_method(parameter_instance_id method_id, std::vector<std::shared_ptr<parameter_value>>) override
+    {
+        record("invoke " + std::to_string(method_id.id));
+        return complete_after(invoke_latency, method_invocation_response(std::vector<std::shared_ptr<parameter_value>>()));
+    }
+
+    std::vector<std::string> get_calls()
+    {
+        std::lock_guard<std::mutex> lock(mutex_m);
+        return calls_m;
+    }
+
+    void join_workers()
+    {
+        std::vector<std::thread> workers;
+        do
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_m);
+                workers = std::move(workers_m);
+                workers_m.clear();
+            }
+            for(auto &worker : workers)
+            {
+                worker.join();
+            }
+        }
+        while(!workers.empty());
+    }
+
+private:
+    void record(std::string const &call)
+    {
+        std::lock_guard<std::mutex> lock(mutex_m);
+        calls_m.push_back(call);
+    }
+
+    template <class T>
+    wago::future<T> complete_after(milliseconds const latency, T &&result)
+    {
+        auto promise = std::make_shared<wago::promise<T>>();
+        auto future  = promise->get_future();
+        std::lock_guard<std::mutex> lock(mutex_m);
+        workers_m.emplace_back([promise, latency, result=std::move(result)]() mutable {
+            std::this_thread::sleep_for(latency);
+            promise->set_value(std::move(result));
+        });
+        return future;
+    }
+
+    template <class T>
+    wago::future<T> fail_after(milliseconds const latency)
+    {
+        auto promise = std::make_shared<wago::promise<T>>();
+        auto future  = promise->get_future();
+        std::lock_guard<std::mutex> lock(mutex_m);
+        workers_m.emplace_back([promise, latency]() {
+            std::this_thread::sleep_for(latency);
+            promise->set_exception(std::make_exception_ptr(std::runtime_error("provider failed")));
+        });
+        return future;
+    }
+
+    std::mutex               mutex_m;
+    std::vector<std::string> calls_m;
+    std::vector<std::thread> workers_m;
+};
+
+std::vector<parameter_instance_id> ids(parameter_id_t first, size_t count)
+{
+    std::vector<parameter_instance_id> result;
+    for(size_t i = 0; i < count; ++i)
+    {
+        result.emplace_back(first + static_cast<parameter_id_t>(i));
+    }
+    return result;
+}
+
+}
+
+class serial_parameter_provider_fixture : public ::testing::Test
+{
+public:
+    latency_parameter_provider provider;
+
+    void TearDown() override
+    {
+        provider.join_workers();
+    }
+};
+
+TEST_F(serial_parameter_provider_fixture, pending_reads_overtake_writes_and_methods)
+{
+    provider.invoke_latency = milliseconds(50);
+    serial_parameter_provider serial(&provider);
+
+    auto running_method = serial.invoke_method(parameter_instance_id(1), {});
+    auto method         = serial.invoke_method(parameter_instance_id(2), {});
+    auto write          = serial.set_parameter_values({ value_request(parameter_instance_id(3), parameter_value::create_uint32(3)) });
+    auto read           = serial.get_parameter_values(ids(4, 1));
+
+    // the read completes while the method invoked after it is still pending
+    std::promise<std::vector<std::string>> calls_at_read;
+    std::vector<value_response>            read_values;
+    read.set_notifier([this, &calls_at_read, &read_values](std::vector<value_response> &&values) {
+        read_values = std::move(values);
+        calls_at_read.set_value(provider.get_calls());
+    });
+    auto const calls_when_read = calls_at_read.get_future().get();
+    method.get();
+    write.get();
+    running_method.get();
+
+    ASSERT_EQ(1, read_values.size());
+    EXPECT_EQ(4, read_values.at(0).value->get_uint32());
+    EXPECT_EQ(std::vector<std::string>({ "invoke 1", "get 1" }), calls_when_read);
+    EXPECT_EQ(std::vector<std::string>({ "invoke 1", "get 1", "set", "invoke 2" }), provider.get_calls());
+}
+
+TEST_F(serial_parameter_provider_fixture, pending_reads_are_batched)
+{
+    provider.invoke_latency = milliseconds(20);
+    serial_parameter_provider serial(&provider);
+
+    auto running_method = serial.invoke_method(parameter_instance_id(1), {});
+    std::vector<wago::future<std::vector<value_response>>> reads;
+    for(parameter_id_t first = 100; first < 110; first += 2)
+    {
+        reads.push_back(serial.get_parameter_values(ids(first, 2)));
+    }
+
+    parameter_id_t expected_id = 100;
+    for(auto &read : reads)
+    {
+        auto const values = read.get();
+        ASSERT_EQ(2, values.size());
+        EXPECT_EQ(expected_id++, values.at(0).value->get_uint32());
+        EXPECT_EQ(expected_id++, values.at(1).value->get_uint32());
+    }
+    running_method.get();
+    EXPECT_EQ(std::vector<std::string>({ "invoke 1", "get 10" }), provider.get_calls());
+}
+
+TEST_F(serial_parameter_provider_fixture, failed_batch_is_read_one_by_one)
+{
+    provider.invoke_latency = milliseconds(20);
+    provider.failing_id     = 202;
+    serial_parameter_provider serial(&provider);
+
+    auto running_method = serial.invoke_method(parameter_instance_id(1), {});
+    auto read_1 = serial.get_parameter_values(ids(100, 2));
+    auto read_2 = serial.get_parameter_values(ids(201, 2));
+    auto read_3 = serial.get_parameter_values(ids(300, 2));
+
+    EXPECT_EQ(100, read_1.get().at(0).value->get_uint32());
+    EXPECT_ANY_THROW(read_2.get());
+    EXPECT_EQ(300, read_3.get().at(0).value->get_uint32());
+    running_method.get();
+    EXPECT_EQ(std::vector<std::string>({ "invoke 1", "get 6", "get 2", "get 2", "get 2" }), provider.get_calls());
+}
+
+TEST_F(serial_parameter_provider_fixture, batch_with_missing_responses_is_read_one_by_one)
+{
+    provider.invoke_latency = milliseconds(20);
+    provider.max_responses  = 5;
+    serial_parameter_provider serial(&provider);
+
+    auto running_method = serial.invoke_method(parameter_instance_id(1), {});
+    auto read_1 = serial.get_parameter_values(ids(100, 3));
+    auto read_2 = serial.get_parameter_values(ids(200, 3));
+
+    auto const values_1 = read_1.get();
+    auto const values_2 = read_2.get();
+    ASSERT_EQ(3, values_1.size());
+    ASSERT_EQ(3, values_2.size());
+    EXPECT_EQ(102, values_1.at(2).value->get_uint32());
+    EXPECT_EQ(202, values_2.at(2).value->get_uint32());
+    running_method.get();
+    EXPECT_EQ(std::vector<std::string>({ "invoke 1", "get 6", "get 3", "get 3" }), provider.get_calls());
+}
+
+TEST_F(serial_parameter_provider_fixture, failed_single_read_is_not_repeated)
+{
+    provider.invoke_latency = milliseconds(20);
+    provider.failing_id     = 100;
+    serial_parameter_provider serial(&provider);
+
+    auto running_method = serial.invoke_method(parameter_instance_id(1), {});
+    auto read           = serial.get_parameter_values(ids(100, 2));
+
+    EXPECT_ANY_THROW(read.get());
+    running_method.get();
+    EXPECT_EQ(std::vector<std::string>({ "invoke 1", "get 2" }), provider.get_calls());
+}
+
+TEST_F(serial_parameter_provider_fixture, read_batch_is_limited)
+{
+    provider.invoke_latency = milliseconds(20);
+    serial_parameter_provider serial(&provider, 4);
+
+    auto running_method = serial.invoke_method(parameter_instance_id(1), {});
+    auto read_1 = serial.get_parameter_values(ids(100, 3));
+    auto read_2 = serial.get_parameter_values(ids(200, 2));
+    auto read_3 = serial.get_parameter_values(ids(300, 2));
+    auto read_4 = serial.get_parameter_values(ids(400, 5));
+
+    EXPECT_EQ(3, read_1.get().size());
+    EXPECT_EQ(2, read_2.get().size());
+    EXPECT_EQ(2, read_3.get().size());
+    EXPECT_EQ(5, read_4.get().size());
+    running_method.get();
+    EXPECT_EQ(std::vector<std::string>({ "invoke 1", "get 3", "get 4", "get 5" }), provider.get_calls());
+}
+
+TEST_F(serial_parameter_provider_fixture, read_batching_disabled)
+{
+    provider.invoke_latency = milliseconds(20);
+    serial_parameter_provider serial(&provider, 0);
+
+    auto running_method = serial.invoke_method(parameter_instance_id(1), {});
+    auto read_1 = serial.get_parameter_values(ids(100, 1));
+    auto read_2 = serial.get_parameter_values(ids(200, 1));
+
+    EXPECT_EQ(100, read_1.get().at(0).value->get_uint32());
+    EXPECT_EQ(200, read_2.get().at(0).value->get_uint32());
+    running_method.get();
+    EXPECT_EQ(std::vector<std::string>({ "invoke 1", "get 1", "get 1" }), provider.get_calls());
+}
+
+TEST_F(serial_parameter_provider_fixture, pending_batch_is_canceled_on_destruction)
+{
+    provider.invoke_latency = milliseconds(20);
+    auto serial = std::make_unique<serial_parameter_provider>(&provider);
+
+    auto running_method = serial->invoke_method(parameter_instance_id(1), {});
+    auto read           = serial->get_parameter_values(ids(100, 2));
+    serial.reset();
+
+    EXPECT_ANY_THROW(read.get());
+    EXPECT_ANY_THROW(running_method.get());
+    EXPECT_EQ(std::vector<std::string>({ "invoke 1" }), provider.get_calls());
+}
@@ -39,6 +39,8 @@
 #include <atomic>
 #include <thread>
 #include <chrono>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -294,3 +296,109 @@ TEST_F(job_queue_test_fixture, enqueue_job_from_different_thread_after_last_job_
     EXPECT_TRUE( start_marker_2);
     EXPECT_FALSE(cancel_marker_2);
 }
+
+class deferred_job : public wago::wdx::job_i
+{
+public:
+    deferred_job(std::vector<std::string> &started, std::string const &name)
+    : started_m(started)
+    , name_m(name)
+    { }
+
+    void start(completion_handler on_complete) noexcept override
+    {
+        on_complete_m = on_complete;
+        started_m.push_back(name_m);
+    }
+
+    void cancel() noexcept override
+    { }
+
+    void complete()
+    {
+        ASSERT_TRUE(on_complete_m);
+        on_complete_m();
+    }
+
+private:
+    std::vector<std::string> &started_m;
+    std::string         const name_m;
+    completion_handler        on_complete_m;
+};
+
+TEST_F(job_queue_test_fixture, pending_jobs_start_by_priority)
+{
+    using wago::wdx::job_priority;
+    std::vector<std::string> started;
+    auto running     = std::make_shared<deferred_job>(started, "running");
+    auto background  = std::make_shared<deferred_job>(started, "background");
+    auto method      = std::make_shared<deferred_job>(started, "method");
+    auto write_1     = std::make_shared<deferred_job>(started, "write_1");
+    auto write_2     = std::make_shared<deferred_job>(started, "write_2");
+    auto interactive = std::make_shared<deferred_job>(started, "interactive");
+
+    test_queue->enqueue_job(running, job_priority::long_running);
+    test_queue->enqueue_job(background, job_priority::background);
+    test_queue->enqueue_job(method, job_priority::long_running);
+    test_queue->enqueue_job(write_1, job_priority::write);
+    test_queue->enqueue_job(write_2);
+    test_queue->enqueue_job(interactive, job_priority::interactive);
+    EXPECT_EQ(std::vector<std::string>({ "running" }), started);
+
+    running->complete();
+    interactive->complete();
+    write_1->complete();
+    write_2->complete();
+    method->complete();
+    background->complete();
+    EXPECT_EQ(std::vector<std::string>({ "running", "interactive", "write_1", "write_2", "method", "background" }), started);
+}
+
+TEST_F(job_queue_test_fixture, overtaken_job_starts_after_aging_limit)
+{
+    using wago::wdx::job_priority;
+    unsigned const aging_limit = 2;
+    test_queue = std::make_unique<wago::wdx::job_queue>(aging_limit);
+    std::vector<std::string> started;
+    auto running    = std::make_shared<deferred_job>(started, "running");
+    auto background = std::make_shared<deferred_job>(started, "background");
+
+    test_queue->enqueue_job(running, job_priority::interactive);
+    test_queue->enqueue_job(background, job_priority::background);
+
+    // a steady flow of interactive jobs overtakes the background job only up to the aging limit
+    std::shared_ptr<deferred_job> current = running;
+    for(unsigned i = 0; i <= aging_limit; ++i)
+    {
+        auto next = std::make_shared<deferred_job>(started, "interactive_" + std::to_string(i));
+        test_queue->enqueue_job(next, job_priority::interactive);
+        current->complete();
+        current = next;
+    }
+    EXPECT_EQ(std::vector<std::string>({ "running", "interactive_0", "interactive_1", "background" }), started);
+
+    background->complete();
+    EXPECT_EQ(std::vector<std::string>({ "running", "interactive_0", "interactive_1", "background", "interactive_2" }), started);
+}
+
+TEST_F(job_queue_test_fixture, cancel_pending_jobs_of_all_priorities)
+{
+    using wago::wdx::job_priority;
+    std::atomic_bool start_marker_1( false);
+    std::atomic_bool cancel_marker_1(false);
+    std::atomic_bool start_marker_2( false);
+    std::atomic_bool cancel_marker_2(false);
+    std::vector<std::string> started;
+    auto running = std::make_shared<deferred_job>(started, "running");
+
+    test_queue->enqueue_job(running);
+    test_queue->enqueue_job(std::make_shared<test_job>(start_marker_1, cancel_marker_1), job_priority::interactive);
+    test_queue->enqueue_job(std::make_shared<test_job>(start_marker_2, cancel_marker_2), job_priority::background);
+    test_queue->cancel_jobs();
+    running->complete();
+
+    EXPECT_FALSE(start_marker_1);
+    EXPECT_TRUE( cancel_marker_1);
+    EXPECT_FALSE(start_marker_2);
+    EXPECT_TRUE( cancel_marker_2);
+}
@@ -0,0 +1,355 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Test of conditional GET and compressed responses for definitions.
+///
+///  \author   PEn: WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include "rest/definition_cache.hpp"
+#include "rest/rest_frontend.hpp"
+#include "mocks/mock_service_identity.hpp"
+#include "mocks/mock_settings_store.hpp"
+#include "mocks/mock_request.hpp"
+#include "mocks/mock_permissions.hpp"
+#include "wago/wdx/unauthorized.hpp"
+#include "parameter_service_core.hpp"
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+//------------------------------------------------------------------------------
+// defines; structure, enumeration and type definitions
+//------------------------------------------------------------------------------
+using wago::wdx::wda::rest::rest_frontend;
+using wago::wdx::wda::rest::definition_cache;
+using wago::wdx::wda::http::http_status_code;
+using wago::wdx::parameter_service_frontend_extended_i;
+using wago::wdx::parameter_service_i;
+using wago::wdx::parameter_service_core;
+using wago::wdx::register_device_request;
+using wago::wdx::device_id;
+using wago::wdx::unauthorized;
+using wago::wdx::user_permissions;
+using std::string;
+using std::map;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+namespace {
+string inflate_content(string const &content);
+}
+
+//------------------------------------------------------------------------------
+// variables' and constants' definitions
+//------------------------------------------------------------------------------
+static constexpr char const service_base[]        = "/test-url";
+static constexpr char const doc_base[]            = "/test-doc";
+static constexpr char const user_name[]           = "root";
+static constexpr char const enum_definitions[]    = "/test-url/enum-definitions";
+static constexpr char const feature_definitions[] = "/test-url/features";
+static constexpr char const method_definitions[]  = "/test-url/method-definitions";
+
+//------------------------------------------------------------------------------
+// fixture definition
+//------------------------------------------------------------------------------
+class definition_cache_fixture : public ::testing::Test
+{
+protected:
+    struct captured_response
+    {
+        http_status_code    status_code = http_status_code::internal_server_error;
+        map<string, string> header;
+        string              content;
+    };
+
+    mock_service_identity                 service_identity_mock;
+    mock_permissions                     *permissions_mock;
+    std::shared_ptr<mock_settings_store>  test_settings_store;
+    std::shared_ptr<parameter_service_i>  test_core;
+    std::unique_ptr<rest_frontend>        frontend;
+
+protected:
+    definition_cache_fixture() = default;
+    ~definition_cache_fixture() override = default;
+
+    void SetUp() override
+    {
+        auto permissions_mock_ptr = std::make_unique<mock_permissions>();
+        permissions_mock = permissions_mock_ptr.get();
+        test_core = std::make_unique<parameter_service_core>(std::move(permissions_mock_ptr));
+        test_settings_store = std::make_shared<mock_settings_store>();
+
+        service_identity_mock.set_default_expectations();
+        EXPECT_CALL(service_identity_mock, get_name())
+            .Times(AnyNumber())
+            .WillRepeatedly(Return("mocked_service"));
+        EXPECT_CALL(service_identity_mock, get_version_string())
+            .Times(AnyNumber())
+            .WillRepeatedly(Return("0.1.2"));
+        test_settings_store->set_default_expectations();
+        EXPECT_CALL(*test_settings_store, get_setting(::testing::StrEq(settings_store_i::run_result_timeout)))
+            .Times(AnyNumber())
+            .WillRepeatedly(Return("60"));
+        permissions_mock->set_default_expectations();
+        EXPECT_CALL(*permissions_mock, get_user_permissions(::testing::StrEq(user_name)))
+            .Times(AnyNumber())
+            .WillRepeatedly(Return(user_permissions(user_name, {}, {})));
+
+        frontend = std::make_unique<rest_frontend>(service_base, doc_base, service_identity_mock, test_settings_store,
+                                                   unauthorized<parameter_service_frontend_extended_i>(test_core));
+    }
+
+    captured_response get(string const &request_uri, map<string, string> const &request_header = {})
+    {
+        auto request_mock = std::make_unique<mock_request>();
+        request_mock->set_default_expectations();
+        EXPECT_CALL(*request_mock, get_request_uri())
+            .Times(AnyNumber())
+            .WillRepeatedly(Return(request_uri));
+        EXPECT_CALL(*request_mock, get_content_type())
+            .Times(AnyNumber())
+            .WillRepeatedly(Return(""));
+        EXPECT_CALL(*request_mock, has_query_parameter(::testing::_))
+            .Times(AnyNumber())
+            .WillRepeatedly(Return(false));
+        EXPECT_CALL(*request_mock, has_http_header(::testing::_))
+            .Times(AnyNumber())
+            .WillRepeatedly(Invoke([request_header](string const &name) { return request_header.count(name) > 0; }));
+        EXPECT_CALL(*request_mock, get_http_header(::testing::_))
+            .Times(AnyNumber())
+            .WillRepeatedly(Invoke([request_header](string const &name) {
+                return request_header.count(name) > 0 ? request_header.at(name) : string();
+            }));
+        EXPECT_CALL(*request_mock, add_response_header(::testing::_, ::testing::_))
+            .Times(AnyNumber());
+        EXPECT_CALL(*request_mock, is_responded())
+            .Times(AnyNumber())
+            .WillRepeatedly(Return(false));
+        EXPECT_CALL(*request_mock, finish())
+            .Times(Exactly(1));
+
+        captured_response captured;
+        EXPECT_CALL(*request_mock, respond_mock(::testing::_))
+            .Times(Exactly(1))
+            .WillOnce(Invoke([&captured](response_i const &response) {
+                captured.status_code = response.get_status_code();
+                captured.header      = response.get_response_header();
+                captured.content     = response.get_content();
+            }));
+
+        frontend->handle(std::move(request_mock), {user_name});
+        return captured;
+    }
+};
+
+//------------------------------------------------------------------------------
+// test implementation
+//------------------------------------------------------------------------------
+TEST(definition_cache, negotiate_encoding)
+{
+    EXPECT_EQ(definition_cache::content_encoding::identity, definition_cache::negotiate_encoding(""));
+    EXPECT_EQ(definition_cache::content_encoding::identity, definition_cache::negotiate_encoding("br, identity"));
+    EXPECT_EQ(definition_cache::content_encoding::gzip,     definition_cache::negotiate_encoding("gzip, deflate, br"));
+    EXPECT_EQ(definition_cache::content_encoding::gzip,     definition_cache::negotiate_encoding("*"));
+    EXPECT_EQ(definition_cache::content_encoding::deflate,  definition_cache::negotiate_encoding("Deflate"));
+    EXPECT_EQ(definition_cache::content_encoding::deflate,  definition_cache::negotiate_encoding("gzip;q=0.5, deflate"));
+    EXPECT_EQ(definition_cache::content_encoding::identity, definition_cache::negotiate_encoding("gzip;q=0, deflate; q=0"));
+    EXPECT_EQ(definition_cache::content_encoding::deflate,  definition_cache::negotiate_encoding("gzip;q=0, *"));
+}
+
+TEST(definition_cache, matches_etag)
+{
+    EXPECT_TRUE(definition_cache::matches_etag("\"a-1\"", "\"a-1\""));
+    EXPECT_TRUE(definition_cache::matches_etag("\"b-2\", W/\"a-1\"", "\"a-1\""));
+    EXPECT_FALSE(definition_cache::matches_etag("*", "\"a-1\""));
+    EXPECT_FALSE(definition_cache::matches_etag("", "\"a-1\""));
+    EXPECT_FALSE(definition_cache::matches_etag("\"a-1-gzip\"", "\"a-1\""));
+    EXPECT_FALSE(definition_cache::matches_etag("a-1", "\"a-1\""));
+}
+
+TEST(definition_cache, matches_any_etag)
+{
+    EXPECT_TRUE(definition_cache::matches_any_etag("*"));
+    EXPECT_TRUE(definition_cache::matches_any_etag(" * "));
+    EXPECT_FALSE(definition_cache::matches_any_etag(""));
+    EXPECT_FALSE(definition_cache::matches_any_etag("\"a-1\""));
+}
+
+TEST(definition_cache, encode)
+{
+    string const content(10000, 'x');
+    EXPECT_EQ(content, definition_cache::encode(content, definition_cache::content_encoding::identity));
+
+    auto const gzip_content = definition_cache::encode(content, definition_cache::content_encoding::gzip);
+    ASSERT_GT(gzip_content.size(), 2);
+    EXPECT_LT(gzip_content.size(), content.size() / 10);
+    EXPECT_EQ('\x1f', gzip_content[0]);
+    EXPECT_EQ('\x8b', gzip_content[1]);
+    EXPECT_EQ(content, inflate_content(gzip_content));
+
+    auto const deflate_content = definition_cache::encode(content, definition_cache::content_encoding::deflate);
+    EXPECT_LT(deflate_content.size(), content.size() / 10);
+    EXPECT_EQ(content, inflate_content(deflate_content));
+}
+
+TEST_F(definition_cache_fixture, strong_etag)
+{
+    auto const first = get(enum_definitions);
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::ok), static_cast<unsigned>(first.status_code));
+    ASSERT_EQ(1, first.header.count("ETag"));
+    auto const &etag = first.header.at("ETag");
+    EXPECT_EQ('"', etag.front());
+    EXPECT_EQ('"', etag.back());
+    EXPECT_EQ("Accept-Encoding", first.header.at("Vary"));
+    EXPECT_EQ(0, first.header.count("Content-Encoding"));
+    EXPECT_EQ(std::to_string(first.content.size()), first.header.at("Content-Length"));
+
+    auto const second = get(enum_definitions);
+    EXPECT_EQ(etag, second.header.at("ETag"));
+    EXPECT_EQ(first.content, second.content);
+
+    // other resources are tagged differently
+    auto const features = get(feature_definitions);
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::ok), static_cast<unsigned>(features.status_code));
+    EXPECT_NE(etag, features.header.at("ETag"));
+}
+
+TEST_F(definition_cache_fixture, not_modified)
+{
+    auto const first = get(enum_definitions);
+    auto const etag  = first.header.at("ETag");
+
+    auto const conditional = get(enum_definitions, {{"If-None-Match", "\"outdated\", " + etag}});
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::not_modified), static_cast<unsigned>(conditional.status_code));
+    EXPECT_EQ(etag, conditional.header.at("ETag"));
+    EXPECT_TRUE(conditional.content.empty());
+
+    auto const outdated = get(enum_definitions, {{"If-None-Match", "\"outdated\""}});
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::ok), static_cast<unsigned>(outdated.status_code));
+    EXPECT_EQ(first.content, outdated.content);
+}
+
+TEST_F(definition_cache_fixture, not_modified_any)
+{
+    // resolved by the handler first, then from the cache
+    auto const first = get(enum_definitions, {{"If-None-Match", "*"}});
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::not_modified), static_cast<unsigned>(first.status_code));
+    EXPECT_TRUE(first.content.empty());
+    auto const second = get(enum_definitions, {{"If-None-Match", "*"}});
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::not_modified), static_cast<unsigned>(second.status_code));
+    EXPECT_EQ(first.header.at("ETag"), second.header.at("ETag"));
+
+    // a resource which does not exist is not matched
+    auto const missing = get(string(enum_definitions) + "/unknown", {{"If-None-Match", "*"}});
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::not_found), static_cast<unsigned>(missing.status_code));
+}
+
+TEST_F(definition_cache_fixture, model_change_changes_etag)
+{
+    auto const first = get(feature_definitions);
+    auto const etag  = first.header.at("ETag");
+
+    ASSERT_EQ(wago::wdx::status_codes::success,
+              test_core->register_device(register_device_request{device_id::headstation, "0768-3301", "01.02.03"}).get().status);
+
+    auto const changed = get(feature_definitions, {{"If-None-Match", etag}});
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::ok), static_cast<unsigned>(changed.status_code));
+    EXPECT_NE(etag, changed.header.at("ETag"));
+}
+
+TEST_F(definition_cache_fixture, permission_change_changes_etag)
+{
+    auto const first = get(method_definitions);
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::ok), static_cast<unsigned>(first.status_code));
+    auto const etag  = first.header.at("ETag");
+
+    // method definitions are filtered by write permissions
+    EXPECT_CALL(*permissions_mock, get_user_permissions(::testing::StrEq(user_name)))
+        .Times(AnyNumber())
+        .WillRepeatedly(Return(user_permissions(user_name, {}, {"SomeFeature"})));
+    auto const write_changed = get(method_definitions, {{"If-None-Match", etag}});
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::ok), static_cast<unsigned>(write_changed.status_code));
+    EXPECT_NE(etag, write_changed.header.at("ETag"));
+
+    EXPECT_CALL(*permissions_mock, get_user_permissions(::testing::StrEq(user_name)))
+        .Times(AnyNumber())
+        .WillRepeatedly(Return(user_permissions(user_name, {"SomeFeature"}, {"SomeFeature"})));
+    auto const read_changed = get(method_definitions, {{"If-None-Match", write_changed.header.at("ETag")}});
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::ok), static_cast<unsigned>(read_changed.status_code));
+    EXPECT_NE(write_changed.header.at("ETag"), read_changed.header.at("ETag"));
+}
+
+TEST_F(definition_cache_fixture, compressed)
+{
+    auto const identity = get(enum_definitions);
+
+    auto const gzip = get(enum_definitions, {{"Accept-Encoding", "gzip, deflate, br"}});
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::ok), static_cast<unsigned>(gzip.status_code));
+    EXPECT_EQ("gzip", gzip.header.at("Content-Encoding"));
+    EXPECT_EQ(std::to_string(gzip.content.size()), gzip.header.at("Content-Length"));
+    EXPECT_EQ(identity.content, inflate_content(gzip.content));
+    EXPECT_NE(identity.header.at("ETag"), gzip.header.at("ETag"));
+
+    auto const deflate = get(enum_definitions, {{"Accept-Encoding", "deflate"}});
+    EXPECT_EQ("deflate", deflate.header.at("Content-Encoding"));
+    EXPECT_EQ(identity.content, inflate_content(deflate.content));
+
+    // the compressed representation is revalidated by its own entity tag
+    auto const conditional = get(enum_definitions, {{"Accept-Encoding", "gzip"}, {"If-None-Match", gzip.header.at("ETag")}});
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::not_modified), static_cast<unsigned>(conditional.status_code));
+    auto const other_encoding = get(enum_definitions, {{"If-None-Match", gzip.header.at("ETag")}});
+    EXPECT_EQ(static_cast<unsigned>(http_status_code::ok), static_cast<unsigned>(other_encoding.status_code));
+}
+
+//------------------------------------------------------------------------------
+// internal function implementation
+//------------------------------------------------------------------------------
+namespace {
+string inflate_content(string const &content)
+{
+    z_stream stream = {};
+    // detect gzip and zlib format
+    EXPECT_EQ(Z_OK, inflateInit2(&stream, MAX_WBITS + 32));
+    string result(64 * 1024, '\0');
+    stream.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(content.data()));
+    stream.avail_in  = static_cast<uInt>(content.size());
+    stream.next_out  = reinterpret_cast<Bytef *>(&result[0]);
+    stream.avail_out = static_cast<uInt>(result.size());
+    EXPECT_EQ(Z_STREAM_END, inflate(&stream, Z_FINISH));
+    result.resize(stream.total_out);
+    inflateEnd(&stream);
+    return result;
+}
+}
+
+
+//---- End of source file ------------------------------------------------------
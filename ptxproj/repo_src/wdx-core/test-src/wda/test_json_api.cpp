@@ -273,6 +273,46 @@ TEST(json_api, serialize_empty_collection_with_page_offset)
                                   << "Actual JSON:   " << actual.dump();
 }
 
+TEST(json_api, serialize_empty_collection_with_page_cursor)
+{
+    json_api                  serializer;
+    string              const base_path   = "/base/path";
+    unsigned            const page_limit  = 6;
+    string              const page_cursor = "s.0.0.12.3.0";
+    string              const next_cursor = "s.0.0.20.5.0";
+    string              const query       = "?first-param=3x3&page[cursor]=" + page_cursor;
+    map<string, string> const meta        = {};
+
+    device_collection_document const collection(base_path, query, meta, vector<device_response>(0), page_cursor, page_limit, next_cursor);
+
+    string result;
+    serializer.serialize(result, collection);
+    string const paging_query = "?first-param=3x3&" + std::string(page_limit_query_key)  + "=" + std::to_string(page_limit) + "&" +
+                                                      std::string(page_cursor_query_key) + "=";
+    auto expect = json::object({
+        { "jsonapi", {
+            { "version", "1.0" }
+        } },
+        { "meta", {
+            { "version", REST_API_VERSION }
+        } },
+        { "links", {
+            { self_link_name,       base_path + paging_query + page_cursor },
+            { first_page_link_name, base_path + paging_query },
+            { next_page_link_name,  base_path + paging_query + next_cursor }
+        }},
+        { "data", json::array({}) }
+    });
+    auto actual = json::parse(result);
+    EXPECT_TRUE(expect == actual) << "Expected JSON: " << expect.dump() << std::endl
+                                  << "Actual JSON:   " << actual.dump();
+
+    device_collection_document const last_page(base_path, query, meta, vector<device_response>(0), page_cursor, page_limit, "");
+    EXPECT_EQ(0, last_page.get_links().count(next_page_link_name));
+    EXPECT_EQ(0, last_page.get_links().count(last_page_link_name));
+    EXPECT_EQ(0, last_page.get_links().count(previous_page_link_name));
+}
+
 TEST(json_api, serialize_collection)
 {
     json_api                      serializer;
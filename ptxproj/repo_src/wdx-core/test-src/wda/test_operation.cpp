@@ -1071,6 +1071,119 @@ TEST_F(operation_fixture, operation_execution_get_parameter_bad_id)
     test_operation.handle(handler, std::move(rest_request));
 }
 
+TEST_F(operation_fixture, operation_execution_get_parameters_at_cursor)
+{
+    request_path     = "/wda/parameters";
+    query_parameters = { { "page[cursor]", "s.0.1.2" }, { "page[limit]", "1" } };
+    request_uri      = request_path + "?page[cursor]=s.0.1.2&page[limit]=1";
+
+    request rest_request(std::move(request_mock_to_move), json_api_serializer, json_api_serializer, {});
+    operation test_operation(service_identity_mock, std::move(core_frontend_mock_ptr), {}, run_manager_mock_ptr);
+    operation_handler_t handler = &operation::get_parameters;
+
+    parameter_response the_parameter;
+    the_parameter.definition = std::make_shared<wdmm::parameter_definition>();
+    the_parameter.value = parameter_value::create(true);
+    the_parameter.path = wago::wda_ipc::from_string<parameter_instance_path>("0-0-a-path");
+    parameter_response_cursor_response core_response(status_codes::success);
+    core_response.param_responses = { the_parameter };
+    core_response.next_cursor     = "s.0.1.3";
+    EXPECT_CALL(core_frontend_mock, get_all_parameters_at_cursor(::testing::_, ::testing::StrEq("s.0.1.2"), 1))
+        .Times(Exactly(1))
+        .WillRepeatedly(Return(ByMove(resolved_future(std::move(core_response)))));
+
+    EXPECT_CALL(request_mock, respond_mock(::testing::_))
+        .Times(Exactly(1))
+        .WillRepeatedly(WithArgs<0>(Invoke([](response_i const &response) {
+            EXPECT_HTTP_EQ(http_status_code::ok, response.get_status_code()) << response.get_content().c_str();
+            auto const content = nlohmann::json::parse(response.get_content());
+            auto const &links  = content.at("links");
+            EXPECT_EQ(1, content.at("data").size());
+            EXPECT_THAT(links.at("self").get<std::string>(), testing::HasSubstr("page[cursor]=s.0.1.2"));
+            EXPECT_THAT(links.at("next").get<std::string>(), testing::HasSubstr("page[cursor]=s.0.1.3"));
+            EXPECT_THAT(links.at("next").get<std::string>(), testing::HasSubstr("page[limit]=1"));
+            EXPECT_THAT(links.at("next").get<std::string>(), testing::Not(testing::HasSubstr("page[offset]")));
+            EXPECT_EQ(0, links.count("prev"));
+            EXPECT_EQ(0, links.count("last"));
+        })));
+
+    test_operation.handle(handler, std::move(rest_request));
+}
+
+TEST_F(operation_fixture, operation_execution_get_parameters_at_last_cursor)
+{
+    request_path     = "/wda/parameters";
+    query_parameters = { { "page[cursor]", "s.0.1.3" } };
+    request_uri      = request_path + "?page[cursor]=s.0.1.3";
+
+    request rest_request(std::move(request_mock_to_move), json_api_serializer, json_api_serializer, {});
+    operation test_operation(service_identity_mock, std::move(core_frontend_mock_ptr), {}, run_manager_mock_ptr);
+    operation_handler_t handler = &operation::get_parameters;
+
+    EXPECT_CALL(core_frontend_mock, get_all_parameters_at_cursor(::testing::_, ::testing::StrEq("s.0.1.3"), ::testing::_))
+        .Times(Exactly(1))
+        .WillRepeatedly(Return(ByMove(resolved_future(parameter_response_cursor_response(status_codes::success)))));
+
+    EXPECT_CALL(request_mock, respond_mock(::testing::_))
+        .Times(Exactly(1))
+        .WillRepeatedly(WithArgs<0>(Invoke([](response_i const &response) {
+            EXPECT_HTTP_EQ(http_status_code::ok, response.get_status_code()) << response.get_content().c_str();
+            auto const content = nlohmann::json::parse(response.get_content());
+            EXPECT_EQ(0, content.at("links").count("next"));
+        })));
+
+    test_operation.handle(handler, std::move(rest_request));
+}
+
+TEST_F(operation_fixture, operation_execution_get_parameters_at_outdated_cursor)
+{
+    request_path     = "/wda/parameters";
+    query_parameters = { { "page[cursor]", "s.0.1.2" } };
+    request_uri      = request_path + "?page[cursor]=s.0.1.2";
+
+    request rest_request(std::move(request_mock_to_move), json_api_serializer, json_api_serializer, {});
+    operation test_operation(service_identity_mock, std::move(core_frontend_mock_ptr), {}, run_manager_mock_ptr);
+    operation_handler_t handler = &operation::get_parameters;
+
+    EXPECT_CALL(core_frontend_mock, get_all_parameters_at_cursor(::testing::_, ::testing::_, ::testing::_))
+        .Times(Exactly(1))
+        .WillRepeatedly(Return(ByMove(resolved_future(parameter_response_cursor_response(status_codes::invalid_value, "Paging cursor is outdated.")))));
+
+    EXPECT_CALL(request_mock, respond_mock(::testing::_))
+        .Times(Exactly(1))
+        .WillRepeatedly(WithArgs<0>(Invoke([](response_i const &response) {
+            EXPECT_HTTP_EQ(http_status_code::bad_request, response.get_status_code()) << response.get_content().c_str();
+            EXPECT_THAT(response.get_content(), testing::HasSubstr("Paging cursor is outdated."));
+        })));
+
+    test_operation.handle(handler, std::move(rest_request));
+}
+
+TEST_F(operation_fixture, operation_execution_get_parameters_cursor_with_offset)
+{
+    request_path     = "/wda/parameters";
+    query_parameters = { { "page[cursor]", "s.0.1.2" }, { "page[offset]", "10" } };
+    request_uri      = request_path + "?page[cursor]=s.0.1.2&page[offset]=10";
+
+    request rest_request(std::move(request_mock_to_move), json_api_serializer, json_api_serializer, {});
+    operation test_operation(service_identity_mock, std::move(core_frontend_mock_ptr), {}, run_manager_mock_ptr);
+    operation_handler_t handler = &operation::get_parameters;
+
+    EXPECT_CALL(core_frontend_mock, get_all_parameters_at_cursor(::testing::_, ::testing::_, ::testing::_))
+        .Times(Exactly(0));
+    EXPECT_CALL(core_frontend_mock, get_all_parameters(::testing::_, ::testing::_, ::testing::_))
+        .Times(Exactly(0));
+
+    EXPECT_CALL(request_mock, respond_mock(::testing::_))
+        .Times(Exactly(1))
+        .WillRepeatedly(WithArgs<0>(Invoke([](response_i const &response) {
+            EXPECT_HTTP_EQ(http_status_code::bad_request, response.get_status_code()) << response.get_content().c_str();
+            EXPECT_THAT(response.get_content(), testing::HasSubstr("cannot be combined with"));
+        })));
+
+    test_operation.handle(handler, std::move(rest_request));
+}
+
 namespace {
 void check_get_single_method_response(response_i const &response)
 {
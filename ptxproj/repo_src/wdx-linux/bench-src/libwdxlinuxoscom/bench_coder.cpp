@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Benchmarks of encoding and decoding IPC messages per message type.
+//------------------------------------------------------------------------------
+#include "common/coder.hpp"
+#include "common/ipc_status.hpp"
+#include "common/method_id.hpp"
+#include "backend/backend_methods.hpp"
+#include "file_api/file_api_methods.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace wago::wdx;
+using namespace wago::wdx::linuxos::com;
+
+namespace {
+
+constexpr uint32_t const call_id         = 4711;
+constexpr size_t   const parameter_count = 100;
+constexpr size_t   const file_chunk_size = 64 * 1024;
+
+std::vector<parameter_instance_id> create_ids()
+{
+    std::vector<parameter_instance_id> ids;
+    for(size_t i = 0; i < parameter_count; ++i)
+    {
+        ids.emplace_back(static_cast<wdmm::parameter_id_t>(i + 1));
+    }
+    return ids;
+}
+
+// Messages as sent by proxies (method ID, call ID, arguments) and stubs (call ID, status, return value)
+
+struct dismiss_message
+{
+    std::tuple<method_id_type, uint32_t> values { dismiss_call_id, call_id };
+};
+
+struct error_message
+{
+    std::tuple<uint32_t, ipc_status, std::string> values { call_id, ipc_status::unexpected_exception, "Exception caught in handle call: provider failed" };
+};
+
+struct get_parameter_values_request
+{
+    std::tuple<method_id_type, uint32_t, std::vector<parameter_instance_id>> values { parameter_provider_method_id::get_parameter_values, call_id, create_ids() };
+};
+
+struct get_parameter_values_response
+{
+    std::tuple<uint32_t, ipc_status, std::vector<value_response>> values;
+
+    get_parameter_values_response()
+    {
+        std::get<0>(values) = call_id;
+        std::get<1>(values) = ipc_status::success;
+        for(size_t i = 0; i < parameter_count; ++i)
+        {
+            std::get<2>(values).emplace_back(parameter_value::create_uint32(static_cast<uint32_t>(i)));
+        }
+    }
+};
+
+struct set_parameter_values_request
+{
+    std::tuple<method_id_type, uint32_t, std::vector<value_request>> values;
+
+    set_parameter_values_request()
+    {
+        std::get<0>(values) = parameter_provider_method_id::set_parameter_values;
+        std::get<1>(values) = call_id;
+        for(auto const &id : create_ids())
+        {
+            std::get<2>(values).emplace_back(id, parameter_value::create_string("value"));
+        }
+    }
+};
+
+struct file_read_response_message
+{
+    std::tuple<uint32_t, ipc_status, file_read_response> values { call_id, ipc_status::success, file_read_response(bytes_t(file_chunk_size, 0x55)) };
+};
+
+struct file_write_request
+{
+    std::tuple<method_id_type, uint32_t, file_id, uint64_t, bytes_t> values { file_api_method_id::file_write, call_id, "file-id", 0, bytes_t(file_chunk_size, 0x55) };
+};
+
+template<typename Message>
+void BM_coder_encode(benchmark::State &state)
+{
+    Message const message;
+    size_t size = 0;
+    for (auto _ : state)
+    {
+        std::vector<uint8_t> encoded;
+        std::apply([&encoded](auto const & ... values) { coder::encode(encoded, values...); }, message.values);
+        size = encoded.size();
+        benchmark::DoNotOptimize(encoded.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    state.counters["bytes_per_message"] = static_cast<double>(size);
+}
+
+template<typename Message>
+void BM_coder_decode(benchmark::State &state)
+{
+    Message const message;
+    std::vector<uint8_t> encoded;
+    std::apply([&encoded](auto const & ... values) { coder::encode(encoded, values...); }, message.values);
+    for (auto _ : state)
+    {
+        decltype(message.values) decoded;
+        data_input_stream stream(encoded);
+        std::apply([&stream](auto & ... values) { coder::decode(stream, values...); }, decoded);
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(encoded.size()));
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_coder_encode, dismiss_message);
+BENCHMARK_TEMPLATE(BM_coder_decode, dismiss_message);
+BENCHMARK_TEMPLATE(BM_coder_encode, error_message);
+BENCHMARK_TEMPLATE(BM_coder_decode, error_message);
+BENCHMARK_TEMPLATE(BM_coder_encode, get_parameter_values_request)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_coder_decode, get_parameter_values_request)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_coder_encode, get_parameter_values_response)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_coder_decode, get_parameter_values_response)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_coder_encode, set_parameter_values_request)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_coder_decode, set_parameter_values_request)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_coder_encode, file_read_response_message)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_coder_decode, file_read_response_message)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_coder_encode, file_write_request)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_coder_decode, file_write_request)->Unit(benchmark::kMicrosecond);
@@ -345,8 +345,7 @@ ReturnType abstract_proxy<I>::call_unsafe(method_id_type method_id, ArgumentType
 
     // encode and send
     std::vector<uint8_t> message;
-    data_stream message_stream(message);
-    coder::encode(message_stream, method_id, call_id, args...);
+    coder::encode(message, method_id, call_id, args...);
     auto promise = prepare_receive<ReturnType>(method_id, call_id);
     WC_TRACE_SET_MARKER(wc_trace_channels::all, "Com proxy: encoding done, send request message");
     WC_ASSERT(message.size() <= sender_i::max_send_data);
@@ -402,8 +401,7 @@ void abstract_proxy<I>::dismiss_call(uint32_t call_id)
 
     // Try to dismiss remote by sending a dismiss message
     std::vector<uint8_t> dismiss_message;
-    data_stream dismiss_message_stream(dismiss_message);
-    coder::encode(dismiss_message_stream, dismiss_call_id, call_id);
+    coder::encode(dismiss_message, dismiss_call_id, call_id);
     WC_ASSERT(dismiss_message.size() <= sender_i::max_send_data);
     get_sender().send(*this, std::move(dismiss_message), [](std::string error_message){
         if(!error_message.empty())
@@ -227,8 +227,7 @@ private:
     {
         WC_TRACE_SET_MARKER(wc_trace_channels::all, "Com stub: got interface result, encode return message");
         std::vector<uint8_t> message;
-        data_stream message_stream(message);
-        coder::encode(message_stream, call_id, status, value);
+        coder::encode(message, call_id, status, value);
         WC_TRACE_SET_MARKER(wc_trace_channels::all, "Com stub: encoding done, send return message");
         if(channel_m != wc_trace_channels::invalid) { wc_trace_stop_channel(channel_m); }
         WC_DEBUG_LOG(("[" + get_connection_name() + " Stub " + std::to_string(get_id()) + "] " + WC_ARRAY_TO_PTR(__func__) + "() {callid=" + std::to_string(call_id) + " interface=" + typeid(Interface).name() + "}").c_str());
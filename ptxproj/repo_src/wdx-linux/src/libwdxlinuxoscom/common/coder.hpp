@@ -31,6 +31,12 @@
 #include <wc/structuring.h>
 #include <wc/log.h>
 
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 //------------------------------------------------------------------------------
 // defines; structure, enumeration and type definitions
 //------------------------------------------------------------------------------
@@ -45,7 +51,14 @@ public:
     using wdx::linuxos::com::exception::exception;
 };
 
-/// Holds static functions to encode and decode types for IPC 
+/// Holds static functions to encode and decode types for IPC.
+///
+/// Encoding is done in two passes specialized at compile time for the types to encode:
+/// The first pass determines the exact encoded size of all values (the size of scalar
+/// types is a compile time constant, core types are serialized once and kept for the
+/// second pass), the second pass writes the values into the buffer, which is grown only once.
+/// Decoding reads directly from the buffer of the input stream and checks the announced
+/// sizes against the remaining bytes before any allocation.
 struct coder final
 {
 public:
@@ -53,14 +66,18 @@ public:
     coder() = delete;
 
     /// Encode values.
-    /// \param os     The output stream to put the encoded bytes into
+    /// \param buffer The buffer to append the encoded bytes to
     /// \param values Values to encode
     template <class ... Ts>
-    static void encode(data_ostream &os, Ts const & ... values)
+    static void encode(std::vector<uint8_t> &buffer, Ts const & ... values)
     {
         try
         {
-            encode_internal(os, values...);
+            encoding_plan plan;
+            size_t const expected_size = buffer.size() + measure_internal(plan, values...);
+            buffer.reserve(expected_size);
+            write_internal(plan, buffer, values...);
+            WC_ASSERT(buffer.size() == expected_size);
         }
         catch (coder_exception const&)
         {
@@ -74,6 +91,18 @@ public:
         }
     }
 
+    /// Encode values.
+    /// \param os     The output stream to put the encoded bytes into
+    /// \param values Values to encode
+    template <class ... Ts>
+    static void encode(data_ostream &os, Ts const & ... values)
+    {
+        std::vector<uint8_t> buffer;
+        encode(buffer, values...);
+        WC_ASSERT(buffer.size() <= static_cast<uint64_t>(std::numeric_limits<std::streamsize>::max()));
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+
     /// Decode values.
     /// \param is     The input stream to get the decodable bytes from
     /// \param values Values to decode
@@ -82,7 +111,8 @@ public:
     {
         try
         {
-            decode_internal(is, values...);
+            WC_ASSERT(is.rdbuf() != nullptr);
+            decode_internal(*is.rdbuf(), values...);
         }
         catch (coder_exception const&)
         {
@@ -95,8 +125,21 @@ public:
             throw wdx::linuxos::com::coder_exception(error_message);
         }
     }
-    
+
+    /// Encoded size of values with a size known at compile time (scalar types only).
+    template <class ... Ts>
+    static constexpr size_t fixed_size = (size_t(0) + ... + sizeof(Ts));
+
 private:
+    using data_buffer = std::basic_streambuf<uint8_t>;
+
+    /// Core types serialized while measuring, to be written in the second pass.
+    struct encoding_plan
+    {
+        std::vector<wdx::bytes_t> core_values;
+        size_t                    next_core_value = 0;
+    };
+
     // Use own serialization for scalar and string types
     // Performance improvement: Use own serialization for uint8 vectors used for file content
     template<class T>
@@ -107,262 +150,304 @@ private:
             (!std::is_same<T, std::vector<std::string>>::value)
         , int>;
 
-    inline static void encode_internal(data_ostream &) { /* noop */ }
-    inline static void decode_internal(data_istream &) { /* noop */ }
+    [[noreturn]] static void throw_truncated()
+    {
+        std::string error_message = "Unexpected end of message while decoding values";
+        WC_FAIL(error_message.c_str());
+        throw coder_exception(error_message);
+    }
+
+    /// Check, that at least `size` bytes are left to read before allocating memory for them.
+    static void check_available(data_buffer &in, uint64_t const size)
+    {
+        std::streamsize const available = in.in_avail();
+        if((available < 0) || (size > static_cast<uint64_t>(available)))
+        {
+            throw_truncated();
+        }
+    }
+
+    static void read_bytes(data_buffer &in, uint8_t *data, size_t const size)
+    {
+        WC_ASSERT(size <= static_cast<uint64_t>(std::numeric_limits<std::streamsize>::max()));
+        if(in.sgetn(data, static_cast<std::streamsize>(size)) != static_cast<std::streamsize>(size))
+        {
+            throw_truncated();
+        }
+    }
+
+    static void write_bytes(std::vector<uint8_t> &out, void const *data, size_t const size)
+    {
+        // Capacity is reserved already, so appending does not reallocate
+        WC_ASSERT(out.capacity() - out.size() >= size);
+        auto const * const begin = static_cast<uint8_t const *>(data);
+        out.insert(out.end(), begin, begin + size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    inline static constexpr size_t measure_internal(encoding_plan &) { return 0; }
+    inline static void write_internal(encoding_plan &, std::vector<uint8_t> &) { /* noop */ }
+    inline static void decode_internal(data_buffer &) { /* noop */ }
+
+    /// Measure two or more values at once.
+    /// \param plan   The plan to keep serialized core values in
+    /// \param first  A value to measure
+    /// \param second Another value to measure
+    /// \param rest   Even more values to measure
+    /// \return Encoded size of all values
+    template <class T, class Tn, class ... Ts>
+    static size_t measure_internal(encoding_plan &plan, T const &first, Tn const &second, Ts const & ... rest)
+    {
+        size_t const first_size = measure_internal(plan, first);
+        return first_size + measure_internal(plan, second, rest...);
+    }
 
     /// Encode two or more values at once.
-    /// \param os     The output stream to put the encoded bytes into
+    /// \param plan   The plan measured for the values
+    /// \param out    The buffer with reserved capacity to append the encoded bytes to
     /// \param first  A value to encode
     /// \param second Another value to encode
     /// \param rest   Even more values to encode
     template <class T, class Tn, class ... Ts>
-    static void encode_internal(data_ostream &os, T const &first, Tn const &second, Ts const & ... rest)
+    static void write_internal(encoding_plan &plan, std::vector<uint8_t> &out, T const &first, Tn const &second, Ts const & ... rest)
     {
-        encode_internal(os, first);
-        encode_internal(os, second, rest...);
+        write_internal(plan, out, first);
+        write_internal(plan, out, second, rest...);
     }
 
     /// Decode two or more values at once.
-    /// \param is     The input stream to get the decodable bytes from
+    /// \param in     The buffer to get the decodable bytes from
     /// \param first  A value to decode
     /// \param second Another value to decode
     /// \param rest   Even more values to decode
     template <class T, class Tn, class ... Ts>
-    static void decode_internal(data_istream &is, T &first, Tn &second, Ts & ... rest)
+    static void decode_internal(data_buffer &in, T &first, Tn &second, Ts & ... rest)
     {
-        decode_internal(is, first);
-        decode_internal(is, second, rest...);
+        decode_internal(in, first);
+        decode_internal(in, second, rest...);
     }
 
-    /// Encode an empty value.
-    /// \param os    The output stream to put the encoded bytes into
-    /// \param value A value to encode
-    static void encode_internal(data_ostream &os, no_return const &)
+    /// Empty values are not encoded at all.
+    static constexpr size_t measure_internal(encoding_plan &, no_return const &)
     {
-        encode_internal(os);
+        return 0;
     }
 
-    /// Decode an empty value.
-    /// \param is    The input stream to get the decodable bytes from
-    /// \param value A value to decode
-    static void decode_internal(data_istream &is, no_return &)
+    static void write_internal(encoding_plan &, std::vector<uint8_t> &, no_return const &)
+    { /* noop */ }
+
+    static void decode_internal(data_buffer &, no_return &)
+    { /* noop */ }
+
+    /// Strings are encoded with a 32 bit length, followed by the characters.
+    static size_t measure_internal(encoding_plan &, std::string const &value)
     {
-        decode_internal(is);
+        WC_ASSERT(value.length() <= UINT32_MAX);
+        return sizeof(uint32_t) + value.length();
     }
 
-    /// Encode a string value.
-    /// \param os    The output stream to put the encoded bytes into
-    /// \param value A value to encode
-    static void encode_internal(data_ostream &os, std::string const &value)
+    static void write_internal(encoding_plan &plan, std::vector<uint8_t> &out, std::string const &value)
     {
-        size_t const string_length = value.length();
-        encode_internal<uint32_t>(os, string_length);
-        WC_ASSERT(string_length <= static_cast<uint64_t>(std::numeric_limits<std::streamsize>::max()));
-        os.write(reinterpret_cast<uint8_t const *>(value.data()), static_cast<std::streamsize>(string_length)); // parasoft-suppress CERT_C-EXP39-b-3 "Coder works with uint8_t while string works on char."
+        write_internal(plan, out, static_cast<uint32_t>(value.length()));
+        write_bytes(out, value.data(), value.length());
     }
 
-    /// Decode a string value.
-    /// \param is    The input stream to get the decodable bytes from
-    /// \param value A value to decode
-    static void decode_internal(data_istream &is, std::string &value)
+    static void decode_internal(data_buffer &in, std::string &value)
     {
         uint32_t string_length;
-        decode_internal(is, string_length);
-        uint32_t chars_to_read = string_length;
-        value = "";
-        uint8_t buffer[4096];
-        uint32_t buffer_size = sizeof(buffer);
-        uint32_t chunk_size  = 0;
-        do
+        decode_internal(in, string_length);
+        check_available(in, string_length);
+        value.resize(string_length);
+        if(string_length > 0)
         {
-            chunk_size = std::min(buffer_size, chars_to_read);
-            WC_ASSERT(chunk_size <= static_cast<uint64_t>(std::numeric_limits<std::streamsize>::max()));
-            if(is.read(WC_ARRAY_TO_PTR(buffer), static_cast<std::streamsize>(chunk_size)))
-            {
-                value.append(reinterpret_cast<char *>(buffer), chunk_size);
-            }
-            chars_to_read -= chunk_size;
+            read_bytes(in, reinterpret_cast<uint8_t *>(&value[0]), string_length); // parasoft-suppress CERT_C-EXP39-b-3 "Coder works with uint8_t while string works on char."
         }
-        while(chars_to_read > 0);
-        WC_ASSERT(value.c_str()[value.length()] == '\0'); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        WC_ASSERT(string_length == value.length());
     }
 
-    /// Encode a scalar value.
-    /// \param os    The output stream to put the encoded bytes into
-    /// \param value A value to encode
+    /// Scalars are encoded with their native representation.
+    template<typename T,
+             std::enable_if_t<std::is_scalar<T>::value, int> = 0>
+    static constexpr size_t measure_internal(encoding_plan &, T const &)
+    {
+        return sizeof(T);
+    }
+
     template<typename T,
              std::enable_if_t<std::is_scalar<T>::value, int> = 0>
-    static void encode_internal(data_ostream &os, T const &value)
+    static void write_internal(encoding_plan &, std::vector<uint8_t> &out, T const &value)
     {
-        os.write(reinterpret_cast<uint8_t const *>(&value), sizeof(value));
+        write_bytes(out, &value, sizeof(value));
     }
 
-    /// Decode a scalar value.
-    /// \param is    The input stream to get the decodable bytes from
-    /// \param value A value to decode
     template<typename T,
              std::enable_if_t<std::is_scalar<T>::value, int> = 0>
-    static void decode_internal(data_istream &is, T &value)
+    static void decode_internal(data_buffer &in, T &value)
+    {
+        read_bytes(in, reinterpret_cast<uint8_t *>(&value), sizeof(value));
+    }
+
+    /// Vectors are encoded with a 64 bit element count, followed by the elements.
+    template<typename T,
+             std::enable_if_t<!std::is_scalar<T>::value, int> = 0>
+    static size_t measure_internal(encoding_plan &plan, std::vector<T> const &value)
     {
-        if(!is.read(reinterpret_cast<uint8_t *>(&value), sizeof(value)))
+        size_t size = sizeof(uint64_t);
+        for (T const & element : value)
         {
-            std::string error_message = "Unexpected error while decoding values";
-            WC_FAIL(error_message.c_str());
-            throw coder_exception(error_message);
+            size += measure_internal(plan, element);
         }
+        return size;
     }
 
-    /// Encode a vector of values
-    /// \param os    The output stream to put the encoded bytes into
-    /// \param value A value to encode
     template<typename T,
              std::enable_if_t<!std::is_scalar<T>::value, int> = 0>
-    static void encode_internal(data_ostream &os, std::vector<T> const &value)
+    static void write_internal(encoding_plan &plan, std::vector<uint8_t> &out, std::vector<T> const &value)
     {
         WC_STATIC_ASSERT(sizeof(value.size()) <= sizeof(uint64_t));
-        uint64_t const size = value.size();
-        encode_internal(os, size);
+        write_internal(plan, out, static_cast<uint64_t>(value.size()));
         for (T const & element : value)
         {
-            encode_internal(os, element);
+            write_internal(plan, out, element);
         }
     }
 
-    /// Decode a vector of values.
-    /// \param is    The input stream to get the decodable bytes from
-    /// \param value A value to decode
     template<typename T,
              std::enable_if_t<!std::is_scalar<T>::value, int> = 0>
-    static void decode_internal(data_istream &is, std::vector<T> &value)
+    static void decode_internal(data_buffer &in, std::vector<T> &value)
     {
         uint64_t size;
-        decode_internal(is, size);
+        decode_internal(in, size);
+        // Each element takes at least one byte
+        check_available(in, size);
         value = std::vector<T>(static_cast<size_t>(size));
         for (T & element : value)
         {
-            decode_internal(is, element);
+            decode_internal(in, element);
         }
     }
 
-    /// Encode a vector of scalar values
-    /// \param os    The output stream to put the encoded bytes into
-    /// \param value A value to encode
+    /// Vectors of scalars are encoded as one block.
+    /// Performance improvement: Use direct data access for values to boost up file transfer case
+    template<typename T,
+             std::enable_if_t<std::is_scalar<T>::value, int> = 0>
+    static size_t measure_internal(encoding_plan &, std::vector<T> const &value)
+    {
+        return sizeof(uint64_t) + (sizeof(T) * value.size());
+    }
+
     template<typename T,
              std::enable_if_t<std::is_scalar<T>::value, int> = 0>
-    static void encode_internal(data_ostream &os, std::vector<T> const &value)
+    static void write_internal(encoding_plan &plan, std::vector<uint8_t> &out, std::vector<T> const &value)
     {
         WC_STATIC_ASSERT(sizeof(value.size()) <= sizeof(uint64_t));
-        uint64_t const size = value.size();
-        encode_internal(os, size);
-        auto const data_size = sizeof(T) * value.size();
-        WC_ASSERT(data_size <= static_cast<uint64_t>(std::numeric_limits<std::streamsize>::max()));
-        // Performance improvement: Use direct data access for values to boost up file transfer case
-        os.write(reinterpret_cast<uint8_t const *>(value.data()), static_cast<std::streamsize>(data_size));
+        write_internal(plan, out, static_cast<uint64_t>(value.size()));
+        write_bytes(out, value.data(), sizeof(T) * value.size());
     }
 
-    /// Decode a vector of scalar values.
-    /// \param is    The input stream to get the decodable bytes from
-    /// \param value A value to decode
     template<typename T,
              std::enable_if_t<std::is_scalar<T>::value, int> = 0>
-    static void decode_internal(data_istream &is, std::vector<T> &value)
+    static void decode_internal(data_buffer &in, std::vector<T> &value)
     {
         uint64_t size;
-        decode_internal(is, size);
-        value = std::vector<T>(static_cast<size_t>(size));
-        auto const data_size = sizeof(T) * size;
-        WC_ASSERT(data_size <= static_cast<uint64_t>(std::numeric_limits<std::streamsize>::max()));
-        // Performance improvement: Use direct data access for values to boost up file transfer case
-        is.read(reinterpret_cast<uint8_t *>(value.data()), static_cast<std::streamsize>(data_size));
+        decode_internal(in, size);
+        check_available(in, size);
+        check_available(in, sizeof(T) * size);
+        value.resize(static_cast<size_t>(size));
+        read_bytes(in, reinterpret_cast<uint8_t *>(value.data()), sizeof(T) * value.size());
     }
 
-    /// Encode a map.
-    /// \param os    The output stream to put the encoded bytes into
-    /// \param value A value to encode
+    /// Maps are encoded with a 32 bit element count, followed by key and value of each element.
     template<typename K,
              typename V>
-    static void encode_internal(data_ostream &os, std::map<K,V> const &value)
+    static size_t measure_internal(encoding_plan &plan, std::map<K,V> const &value)
     {
         WC_ASSERT(value.size() <= UINT32_MAX);
-        encode_internal(os, static_cast<uint32_t>(value.size()));
+        size_t size = sizeof(uint32_t);
         for(auto const &element : value)
         {
-            encode_internal(os, element.first);
-            encode_internal(os, element.second);
+            size += measure_internal(plan, element.first);
+            size += measure_internal(plan, element.second);
         }
+        return size;
     }
 
-    /// Decode a map.
-    /// \param is    The input stream to get the decodable bytes from
-    /// \param value A value to decode
     template<typename K,
              typename V>
-    static void decode_internal(data_istream &is, std::map<K,V> &value)
+    static void write_internal(encoding_plan &plan, std::vector<uint8_t> &out, std::map<K,V> const &value)
+    {
+        write_internal(plan, out, static_cast<uint32_t>(value.size()));
+        for(auto const &element : value)
+        {
+            write_internal(plan, out, element.first);
+            write_internal(plan, out, element.second);
+        }
+    }
+
+    template<typename K,
+             typename V>
+    static void decode_internal(data_buffer &in, std::map<K,V> &value)
     {
         uint32_t size;
-        decode_internal(is, size);
+        decode_internal(in, size);
+        check_available(in, size);
         value = std::map<K,V>();
         for(size_t i = 0; i < size; ++i)
         {
             K element_key;
             V element_value;
-            decode_internal(is, element_key);
-            decode_internal(is, element_value);
-            value[element_key] = element_value;
+            decode_internal(in, element_key);
+            decode_internal(in, element_value);
+            value[std::move(element_key)] = std::move(element_value);
         }
     }
 
-    /// Encode a value hold by a unique pointer.
-    /// \param os    The output stream to put the encoded bytes into
-    /// \param value A value to encode
+    /// Values hold by a unique pointer are encoded as the value itself.
+    template<typename T>
+    static size_t measure_internal(encoding_plan &plan, std::unique_ptr<T> const &value)
+    {
+        return measure_internal(plan, *value.get());
+    }
+
     template<typename T>
-    static void encode_internal(data_ostream &os, std::unique_ptr<T> const &value)
+    static void write_internal(encoding_plan &plan, std::vector<uint8_t> &out, std::unique_ptr<T> const &value)
     {
-        encode_internal(os, *value.get());
+        write_internal(plan, out, *value.get());
     }
 
-    /// Decode a value hold by a unique pointer.
-    /// \param is    The input stream to get the decodable bytes from
-    /// \param value A value to decode
     template<typename T>
-    static void decode_internal(data_istream &is, std::unique_ptr<T> &value)
+    static void decode_internal(data_buffer &in, std::unique_ptr<T> &value)
     {
         value = std::make_unique<T>();
-        decode_internal(is, *value.get());
+        decode_internal(in, *value.get());
+    }
+
+    /// File responses are encoded by status and data.
+    /// \note Performance improvement for file transfer case
+    static size_t measure_internal(encoding_plan &plan, wdx::file_read_response const &value)
+    {
+        return measure_internal(plan, value.status) + measure_internal(plan, value.data);
     }
 
-    /// Encode a file response value.
-    /// \note        Performance improvement for file transfer case
-    /// \param os    The output stream to put the encoded bytes into
-    /// \param value A file response value to encode
-    static void encode_internal(data_ostream &os, wdx::file_read_response const &value)
+    static void write_internal(encoding_plan &plan, std::vector<uint8_t> &out, wdx::file_read_response const &value)
     {
-        encode_internal(os, value.status);
-        encode_internal(os, value.data);
+        write_internal(plan, out, value.status);
+        write_internal(plan, out, value.data);
     }
 
-    /// Decode a file response value.
-    /// \note        Performance improvement for file transfer case
-    /// \param is    The input stream to get the decodable bytes from
-    /// \param value A file response value to decode
-    static void decode_internal(data_istream &is, wdx::file_read_response &value)
+    static void decode_internal(data_buffer &in, wdx::file_read_response &value)
     {
-        decode_internal(is, value.status);
-        decode_internal(is, value.data);
+        decode_internal(in, value.status);
+        decode_internal(in, value.data);
     }
 
-    /// Encode a value by using WDA specific IPC conversion functions.
-    /// \param os    The output stream to put the encoded bytes into
-    /// \param value A value to encode
+    /// Core types are encoded by WDA specific IPC conversion functions as byte vector.
+    /// They are serialized once while measuring and written from the plan.
     template<typename T, 
              use_wda_serialization<T> = 0>
-    static void encode_internal(data_ostream &os, T const &value)
+    static size_t measure_internal(encoding_plan &plan, T const &value)
     {
-        wdx::bytes_t bytes;
         try
         {
-            bytes = wda_ipc::to_bytes(value);
+            plan.core_values.push_back(wda_ipc::to_bytes(value));
         }
         catch(...)
         {
@@ -370,18 +455,23 @@ private:
             WC_FAIL(error_message.c_str());
             throw wdx::linuxos::com::coder_exception(error_message);
         }
-        encode_internal(os, bytes);
+        return measure_internal(plan, plan.core_values.back());
+    }
+
+    template<typename T, 
+             use_wda_serialization<T> = 0>
+    static void write_internal(encoding_plan &plan, std::vector<uint8_t> &out, T const &)
+    {
+        WC_ASSERT(plan.next_core_value < plan.core_values.size());
+        write_internal(plan, out, plan.core_values[plan.next_core_value++]);
     }
 
-    /// Decode a value by using WDA specific IPC conversion functions.
-    /// \param is    The input stream to get the decodable bytes from
-    /// \param value A value to decode
     template<typename T,
              use_wda_serialization<T> = 0>
-    static void decode_internal(data_istream &is, T &value)
+    static void decode_internal(data_buffer &in, T &value)
     {
         std::vector<uint8_t> bytes_value;
-        decode_internal(is, bytes_value);
+        decode_internal(in, bytes_value);
         try
         {
             value = wda_ipc::from_bytes<T>(bytes_value);
@@ -390,7 +480,7 @@ private:
         {
             std::string error_message = std::string("Unexpected error while decoding core type ") + typeid(T).name() + ": " + e.what();
             WC_FAIL(error_message.c_str());
-            WC_DEBUG_LOG(("bytes_value=" + std::string(reinterpret_cast<char*>(bytes_value.data()))).c_str());
+            WC_DEBUG_LOG(("bytes_value=" + std::string(bytes_value.begin(), bytes_value.end())).c_str());
             throw wdx::linuxos::com::coder_exception(error_message);
         }
     }
@@ -97,11 +97,11 @@ void manager::send(managed_object const  &sender,
                    send_handler           handler)
 {
     WC_ASSERT(message.size() <= sender_i::max_send_data);
-    message_data message_stream_buffer;
-    data_stream message_stream(message_stream_buffer);
-    coder::encode(message_stream, sender.get_id());
-    message_stream.write(message.data(), static_cast<ssize_t>(message.size())); // FIXME: this causes a copy of the bytes
-    adapter_m->send(std::move(message_stream_buffer), handler);
+    message_data message_buffer;
+    message_buffer.reserve(coder::fixed_size<managed_object_id> + message.size());
+    coder::encode(message_buffer, sender.get_id());
+    message_buffer.insert(message_buffer.end(), message.begin(), message.end()); // FIXME: this causes a copy of the bytes
+    adapter_m->send(std::move(message_buffer), handler);
 }
 
 void manager::receive(message_data message)
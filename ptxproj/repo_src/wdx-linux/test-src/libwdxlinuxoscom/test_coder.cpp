@@ -0,0 +1,394 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2025 WAGO GmbH & Co. KG
+//
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+///  \file
+///
+///  \brief    Test IPC coder: Round trips and compatibility with the stream based encoding.
+///
+///  \author   PEn: WAGO GmbH & Co. KG
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// include files
+//------------------------------------------------------------------------------
+#include "common/coder.hpp"
+#include "common/method_id.hpp"
+#include "common/ipc_status.hpp"
+
+#include <wago/wdx/test/fail.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+//------------------------------------------------------------------------------
+// defines; structure, enumeration and type definitions
+//------------------------------------------------------------------------------
+using wago::wdx::linuxos::com::coder;
+using wago::wdx::linuxos::com::coder_exception;
+using wago::wdx::linuxos::com::data_stream;
+using wago::wdx::linuxos::com::data_input_stream;
+using wago::wdx::linuxos::com::no_return;
+using wago::wdx::linuxos::com::ipc_status;
+using wago::wdx::linuxos::com::method_id_type;
+using wago::wdx::linuxos::com::dismiss_call_id;
+using wago::wdx::parameter_instance_id;
+using wago::wdx::value_request;
+using wago::wdx::value_response;
+using wago::wdx::parameter_value;
+using wago::wdx::file_read_response;
+using wago::wdx::status_codes;
+using wago::wda_ipc::to_bytes;
+using bytes = std::vector<uint8_t>;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+namespace {
+
+// Reference encoding, as written by the former stream based coder
+template<typename T>
+void append_scalar(bytes &message, T const value)
+{
+    uint8_t raw[sizeof(T)];
+    std::memcpy(raw, &value, sizeof(T));
+    message.insert(message.end(), raw, raw + sizeof(T));
+}
+
+void append_string(bytes &message, std::string const &value)
+{
+    append_scalar(message, static_cast<uint32_t>(value.size()));
+    message.insert(message.end(), value.begin(), value.end());
+}
+
+void append_bytes(bytes &message, bytes const &value)
+{
+    append_scalar(message, static_cast<uint64_t>(value.size()));
+    message.insert(message.end(), value.begin(), value.end());
+}
+
+template<typename T>
+bytes encode_to_buffer(T const &value)
+{
+    bytes message;
+    coder::encode(message, value);
+    return message;
+}
+
+template<typename T>
+bytes encode_to_stream(T const &value)
+{
+    bytes message;
+    data_stream stream(message);
+    coder::encode(stream, value);
+    return message;
+}
+
+template<typename T>
+T decode_from(bytes const &message)
+{
+    T value;
+    data_input_stream stream(message);
+    coder::decode(stream, value);
+    EXPECT_EQ(std::char_traits<uint8_t>::eof(), stream.rdbuf()->sgetc()) << "Message not decoded completely";
+    return value;
+}
+
+}
+
+//------------------------------------------------------------------------------
+// test implementation
+//------------------------------------------------------------------------------
+TEST(coder, fixed_size)
+{
+    static_assert(coder::fixed_size<>                                     == 0,  "");
+    static_assert(coder::fixed_size<method_id_type, uint32_t>             == 8,  "");
+    static_assert(coder::fixed_size<uint32_t, ipc_status, uint64_t>       == 12 + sizeof(ipc_status), "");
+}
+
+TEST(coder, call_message)
+{
+    method_id_type const method_id = 42;
+    uint32_t       const call_id   = 4711;
+    std::string    const text      = "some text";
+
+    bytes expected;
+    append_scalar(expected, method_id);
+    append_scalar(expected, call_id);
+    append_string(expected, text);
+
+    bytes message;
+    coder::encode(message, method_id, call_id, text);
+    EXPECT_EQ(expected, message);
+
+    method_id_type decoded_method_id;
+    uint32_t       decoded_call_id;
+    std::string    decoded_text;
+    data_input_stream stream(message);
+    coder::decode(stream, decoded_method_id, decoded_call_id, decoded_text);
+    EXPECT_EQ(method_id, decoded_method_id);
+    EXPECT_EQ(call_id,   decoded_call_id);
+    EXPECT_EQ(text,      decoded_text);
+}
+
+TEST(coder, dismiss_message)
+{
+    uint32_t const call_id = 17;
+
+    bytes expected;
+    append_scalar(expected, dismiss_call_id);
+    append_scalar(expected, call_id);
+
+    bytes message;
+    coder::encode(message, dismiss_call_id, call_id);
+    EXPECT_EQ(expected, message);
+    EXPECT_EQ((coder::fixed_size<method_id_type, uint32_t>), message.size());
+}
+
+TEST(coder, return_message_without_value)
+{
+    uint32_t const call_id = 3;
+
+    bytes expected;
+    append_scalar(expected, call_id);
+    append_scalar(expected, ipc_status::success);
+
+    bytes message;
+    coder::encode(message, call_id, ipc_status::success, no_return());
+    EXPECT_EQ(expected, message);
+}
+
+TEST(coder, encode_appends)
+{
+    bytes message = { 0xAA, 0xBB };
+    coder::encode(message, uint16_t(0x1234));
+
+    bytes expected = { 0xAA, 0xBB };
+    append_scalar(expected, uint16_t(0x1234));
+    EXPECT_EQ(expected, message);
+}
+
+TEST(coder, string)
+{
+    for(std::string const &value : { std::string(), std::string("a"), std::string(10000, 'x') })
+    {
+        bytes expected;
+        append_string(expected, value);
+        EXPECT_EQ(expected, encode_to_buffer(value));
+        EXPECT_EQ(expected, encode_to_stream(value));
+        EXPECT_EQ(value, decode_from<std::string>(expected));
+    }
+}
+
+TEST(coder, string_vector)
+{
+    std::vector<std::string> const value = { "first", "", "third" };
+
+    bytes expected;
+    append_scalar(expected, static_cast<uint64_t>(value.size()));
+    for(auto const &element : value)
+    {
+        append_string(expected, element);
+    }
+    EXPECT_EQ(expected, encode_to_buffer(value));
+    EXPECT_EQ(value, decode_from<std::vector<std::string>>(expected));
+}
+
+TEST(coder, scalar_vector)
+{
+    std::vector<uint32_t> const value = { 1, 2, 0xFFFFFFFF };
+
+    bytes expected;
+    append_scalar(expected, static_cast<uint64_t>(value.size()));
+    for(auto const element : value)
+    {
+        append_scalar(expected, element);
+    }
+    EXPECT_EQ(expected, encode_to_buffer(value));
+    EXPECT_EQ(value, decode_from<std::vector<uint32_t>>(expected));
+}
+
+TEST(coder, string_map)
+{
+    std::map<std::string, std::string> const value = { { "key1", "value1" }, { "key2", "" } };
+
+    bytes expected;
+    append_scalar(expected, static_cast<uint32_t>(value.size()));
+    for(auto const &element : value)
+    {
+        append_string(expected, element.first);
+        append_string(expected, element.second);
+    }
+    EXPECT_EQ(expected, encode_to_buffer(value));
+    EXPECT_EQ(value, (decode_from<std::map<std::string, std::string>>(expected)));
+}
+
+TEST(coder, core_type)
+{
+    parameter_instance_id const value(4711, 2);
+
+    bytes expected;
+    append_bytes(expected, to_bytes(value));
+    EXPECT_EQ(expected, encode_to_buffer(value));
+    EXPECT_EQ(expected, encode_to_stream(value));
+    EXPECT_EQ(value, decode_from<parameter_instance_id>(expected));
+}
+
+TEST(coder, core_type_vector)
+{
+    std::vector<value_request> value;
+    value.emplace_back(parameter_instance_id(1), parameter_value::create_uint32(42));
+    value.emplace_back(parameter_instance_id(2), parameter_value::create_string("text"));
+
+    bytes expected;
+    append_scalar(expected, static_cast<uint64_t>(value.size()));
+    for(auto const &element : value)
+    {
+        append_bytes(expected, to_bytes(element));
+    }
+    EXPECT_EQ(expected, encode_to_buffer(value));
+
+    auto const decoded = decode_from<std::vector<value_request>>(expected);
+    ASSERT_EQ(value.size(), decoded.size());
+    for(size_t i = 0; i < value.size(); ++i)
+    {
+        EXPECT_EQ(value.at(i).param_id, decoded.at(i).param_id);
+        EXPECT_EQ(*value.at(i).value,   *decoded.at(i).value);
+    }
+}
+
+TEST(coder, file_read_response)
+{
+    file_read_response const value(bytes({ 1, 2, 3, 4, 5 }));
+
+    bytes expected;
+    append_scalar(expected, value.status);
+    append_bytes(expected, value.data);
+    EXPECT_EQ(expected, encode_to_buffer(value));
+
+    auto const decoded = decode_from<file_read_response>(expected);
+    EXPECT_EQ(value.status, decoded.status);
+    EXPECT_EQ(value.data,   decoded.data);
+}
+
+TEST(coder, unique_ptr)
+{
+    auto const value = std::make_unique<std::string>("pointed");
+
+    bytes expected;
+    append_string(expected, *value);
+    EXPECT_EQ(expected, encode_to_buffer(value));
+
+    auto const decoded = decode_from<std::unique_ptr<std::string>>(expected);
+    ASSERT_NE(nullptr, decoded.get());
+    EXPECT_EQ(*value, *decoded);
+}
+
+TEST(coder, return_message_with_core_values)
+{
+    uint32_t const call_id = 99;
+    std::vector<value_response> value;
+    value.emplace_back(parameter_value::create_boolean(true));
+    value.emplace_back(status_codes::unknown_parameter_id);
+
+    bytes expected;
+    append_scalar(expected, call_id);
+    append_scalar(expected, ipc_status::success);
+    append_scalar(expected, static_cast<uint64_t>(value.size()));
+    for(auto const &element : value)
+    {
+        append_bytes(expected, to_bytes(element));
+    }
+
+    bytes message;
+    coder::encode(message, call_id, ipc_status::success, value);
+    EXPECT_EQ(expected, message);
+
+    uint32_t                    decoded_call_id;
+    ipc_status                  decoded_status;
+    std::vector<value_response> decoded_value;
+    data_input_stream stream(message);
+    coder::decode(stream, decoded_call_id, decoded_status, decoded_value);
+    EXPECT_EQ(call_id, decoded_call_id);
+    EXPECT_EQ(ipc_status::success, decoded_status);
+    ASSERT_EQ(value.size(), decoded_value.size());
+    EXPECT_EQ(value.at(0).status, decoded_value.at(0).status);
+    EXPECT_EQ(value.at(1).status, decoded_value.at(1).status);
+}
+
+TEST(coder, decode_truncated_scalar)
+{
+    bytes const message = { 0x01, 0x02 };
+    data_input_stream stream(message);
+    uint32_t value;
+    wago::wdx::test::add_expected_fail();
+    EXPECT_THROW(coder::decode(stream, value), coder_exception);
+    wago::wdx::test::check_fail_count();
+}
+
+TEST(coder, decode_truncated_string)
+{
+    bytes message;
+    append_string(message, "truncated");
+    message.pop_back();
+    data_input_stream stream(message);
+    std::string value;
+    wago::wdx::test::add_expected_fail();
+    EXPECT_THROW(coder::decode(stream, value), coder_exception);
+    wago::wdx::test::check_fail_count();
+}
+
+TEST(coder, decode_oversized_vector)
+{
+    // announced size must not be allocated without the bytes present
+    bytes message;
+    append_scalar(message, UINT64_MAX / 2);
+    append_scalar(message, uint32_t(0));
+    data_input_stream stream(message);
+    std::vector<uint32_t> value;
+    wago::wdx::test::add_expected_fail();
+    EXPECT_THROW(coder::decode(stream, value), coder_exception);
+    wago::wdx::test::check_fail_count();
+}
+
+TEST(coder, decode_continues_stream)
+{
+    bytes message;
+    coder::encode(message, uint32_t(1), std::string("two"));
+    coder::encode(message, uint64_t(3));
+
+    data_input_stream stream(message);
+    uint32_t    first;
+    std::string second;
+    uint64_t    third;
+    coder::decode(stream, first, second);
+    coder::decode(stream, third);
+    EXPECT_EQ(1,     first);
+    EXPECT_EQ("two", second);
+    EXPECT_EQ(3,     third);
+}
+
+
+//---- End of source file ------------------------------------------------------